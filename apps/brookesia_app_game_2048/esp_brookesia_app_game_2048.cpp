@@ -7,7 +7,9 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <cstring>
 #include <unistd.h>
+#include "services/executor/esp_brookesia_service_executor.hpp"
 #ifdef ESP_UTILS_LOG_TAG
 #   undef ESP_UTILS_LOG_TAG
 #endif
@@ -38,10 +40,15 @@
 
 #define ANIM_PERIOD             200
 
+// Time the solver searches for a hint, and for each move of the autoplay
+#define SOLVER_HINT_BUDGET_MS       (300)
+#define SOLVER_AUTOPLAY_BUDGET_MS   (100)
+
 #define randint_between(min, max)       (rand() % (max - min) + min)
 #define rand_1_2()                      (randint_between(1, 2))
 
 using namespace std;
+using esp_brookesia::services::Executor;
 
 LV_IMG_DECLARE(img_app_2048);
 
@@ -83,10 +90,8 @@ bool Game2048::init()
     ESP_UTILS_CHECK_FALSE_RETURN(_width > 0, false, "Invalid width(%d)", _width);
     ESP_UTILS_CHECK_FALSE_RETURN(_height > 0, false, "Invalid height(%d)", _height);
 
+    _board = 0;
     for (int i = 0; i < 16; i++) {
-        _cells_weight[i / 4][i % 4].weight = 0;
-        _cells_weight[i / 4][i % 4].x = 1 << (i / 4);
-        _cells_weight[i / 4][i % 4].y = 1 << (i % 4);
         _foreground_cells[i / 4][i % 4] = NULL;
         _remove_ready_cells[i / 4][i % 4] = NULL;
     }
@@ -114,17 +119,22 @@ bool Game2048::run()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(Game2048Board::initTables(), false, "Init board tables failed");
+
     srand(time(nullptr));
 
     /* Set screen background color to match grid */
     lv_obj_set_style_bg_color(lv_scr_act(), GRID_BG_COLOR, 0);
 
     /* Setup title */
-    lv_obj_t *title = lv_label_create(lv_scr_act());
-    lv_obj_set_style_text_font(title, BOARD_TITLE_FONT, 0);
-    lv_obj_set_style_text_color(title, BOARD_TITLE_COLOR, 0);
-    lv_label_set_text(title, "2048");
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 15);
+    _title_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(_title_label, BOARD_TITLE_FONT, 0);
+    lv_obj_set_style_text_color(_title_label, BOARD_TITLE_COLOR, 0);
+    lv_label_set_text(_title_label, "2048");
+    lv_obj_align(_title_label, LV_ALIGN_TOP_MID, 0, 15);
+    // The title shows the hint or the play symbol of the autoplay, a click on it toggles the autoplay
+    lv_obj_add_flag(_title_label, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_title_label, autoplay_event_cb, LV_EVENT_CLICKED, this);
 
     /* Setup score displays and button in same row */
     lv_obj_t *cur = lv_obj_create(lv_scr_act());
@@ -233,6 +243,7 @@ bool Game2048::run()
     lv_obj_set_style_bg_opa(_foreground_grid, LV_OPA_TRANSP, 0);
     lv_obj_set_style_text_font(_foreground_grid, GRID_FONT, 0);
     lv_obj_add_flag(_foreground_grid, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_foreground_grid, hint_event_cb, LV_EVENT_LONG_PRESSED, this);
 
     /* Add motion detect module */
     auto gesture = getSystem()->manager.getGesture();
@@ -263,6 +274,9 @@ bool Game2048::close()
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     _is_closing = true;
+    // Drop the result of any search in progress
+    _is_autoplay = false;
+    _solver_generation++;
 
     // Since this function is usually called through gesture callback function,
     // we should avoid calling it during lvgl task traversal
@@ -293,7 +307,12 @@ void Game2048::debugCells()
 #if ENABLE_CELL_DEBUG
     debugCells(_foreground_cells);
     debugCells(_background_cells);
-    debugCells(_cells_weight);
+
+    int weights[4][4];
+    for (int i = 0; i < 16; i++) {
+        weights[i / 4][i % 4] = Game2048Board::getWeight(_board, i / 4, i % 4);
+    }
+    debugCells(weights);
 #endif
 }
 
@@ -316,21 +335,6 @@ void Game2048::debugCells(lv_obj_t *cell[4][4])
 #endif
 }
 
-void Game2048::debugCells(cell_weight_t cell[4][4])
-{
-#if ENABLE_CELL_DEBUG
-    for (int i = 0; i < 4; i++) {
-        ESP_UTILS_LOGD(
-            "\t(%d,%d,%d)\t(%d,%d,%d)\t(%d,%d,%d)\t(%d,%d,%d)",
-            cell[i][0].x, cell[i][0].y, cell[i][0].weight,
-            cell[i][1].x, cell[i][1].y, cell[i][1].weight,
-            cell[i][2].x, cell[i][2].y, cell[i][2].weight,
-            cell[i][3].x, cell[i][3].y, cell[i][3].weight
-        );
-    }
-#endif
-}
-
 void Game2048::debugCells(lv_obj_t *cell[4])
 {
 #if ENABLE_CELL_DEBUG
@@ -348,10 +352,8 @@ void Game2048::cleanForegroundCells()
         lv_obj_del(child);
         child = lv_obj_get_child(_foreground_grid, 0);
     }
+    _board = 0;
     for (int i = 0; i < 16; i++) {
-        _cells_weight[i / 4][i % 4].weight = 0;
-        _cells_weight[i / 4][i % 4].x = 1 << (i / 4);
-        _cells_weight[i / 4][i % 4].y = 1 << (i % 4);
         _foreground_cells[i / 4][i % 4] = NULL;
     }
 }
@@ -360,6 +362,11 @@ void Game2048::newGame()
 {
     _weight_max = 0;
     _current_score = 0;
+    // The solver may still be searching the previous game
+    _solver_generation++;
+    _is_autoplay = false;
+    _hint_direction = Game2048Board::Direction::Max;
+    updateTitle();
     updateCurrentScore(_current_score);
     cleanForegroundCells();
     generateForegroundCell();
@@ -396,7 +403,7 @@ void Game2048::generateForegroundCell()
 
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
-            if (_cells_weight[i][j].weight == 0) {
+            if (Game2048Board::getWeight(_board, i, j) == 0) {
                 zero_amount++;
             }
         }
@@ -409,15 +416,16 @@ void Game2048::generateForegroundCell()
 
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
-            if ((_cells_weight[i][j].weight == 0) &&
+            if ((Game2048Board::getWeight(_board, i, j) == 0) &&
                     (zero_index++ == target)) {
                 target_i = i;
                 target_j = j;
-                _cells_weight[i][j].weight = target_weight;
             }
         }
     }
 
+    _board = Game2048Board::setWeight(_board, target_i, target_j, target_weight);
+
     /* Add a new object of cell */
     lv_obj_t *cell = lv_obj_create(_foreground_grid);
     _foreground_cells[target_i][target_j] = cell;
@@ -514,7 +522,7 @@ void Game2048::updateCellValue()
     for (int i = 0; i < 16; i++) {
         if (_foreground_cells[i / 4][i % 4] != NULL) {
             lv_obj_t *label = lv_obj_get_child(_foreground_cells[i / 4][i % 4], 0);
-            int value = 1 << _cells_weight[i / 4][i % 4].weight;
+            int value = 1 << Game2048Board::getWeight(_board, i / 4, i % 4);
             lv_label_set_text_fmt(label, "%d", value);
         }
     }
@@ -534,8 +542,9 @@ void Game2048::updateCellsStyle()
 {
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
-            if (_foreground_cells[i][j] != NULL && _cells_weight[i][j].weight > 0) {
-                int color_index = _cells_weight[i][j].weight - 1;
+            int weight = Game2048Board::getWeight(_board, i, j);
+            if (_foreground_cells[i][j] != NULL && weight > 0) {
+                int color_index = weight - 1;
                 if (color_index >= 0 && color_index < 11) {
                     lv_obj_set_style_bg_color(
                         _foreground_cells[i][j],
@@ -553,391 +562,249 @@ int Game2048::maxWeight()
     return _weight_max;
 }
 
-int Game2048::moveLeft()
+/**
+ * @brief Get the cell of the `index`th tile of a line, counted from the side the tiles move to
+ */
+static void get_line_cell(Game2048Board::Direction direction, int line, int index, int &row, int &column)
 {
-    int target_cells[4][4];
-    int score = -1;
-
-    for (int i = 0; i < 16; i++) {
-        target_cells[i / 4][i % 4] = i % 4;
+    switch (direction) {
+    case Game2048Board::Direction::Left:
+        row = line;
+        column = index;
+        break;
+    case Game2048Board::Direction::Right:
+        row = line;
+        column = 3 - index;
+        break;
+    case Game2048Board::Direction::Up:
+        row = index;
+        column = line;
+        break;
+    default:
+        row = 3 - index;
+        column = line;
+        break;
     }
+}
 
-    debugCells(_cells_weight);
-    debugCells(target_cells);
+int Game2048::move(Game2048Board::Direction direction)
+{
+    uint32_t score = 0;
+    Game2048Board::Bitboard moved = Game2048Board::move(_board, direction, &score);
 
-    for (int i = 0; i < 4; i++) {
-        for (int j = 1; j < 4; j++) {
-            if (_cells_weight[i][j].weight != 0) {
-                int merge_flag = false;
-                int cur_j = j;
-                while (cur_j != 0) {
-                    if ((_cells_weight[i][cur_j - 1].weight == _cells_weight[i][cur_j].weight) &&
-                            (!merge_flag)) {
-                        merge_flag = true;
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[i][cur_j].y & (1 << k);
-                            if (target_flag) {
-                                target_cells[i][k] = cur_j - 1;
-                            }
-                        }
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[i][cur_j - 1].y & (1 << k);
-                            if (target_flag) {
-                                addRemoveReadyCell(_foreground_cells[i][k]);
-                            }
-                        }
-
-                        _cells_weight[i][cur_j - 1].y += _cells_weight[i][cur_j].y;
-                        _cells_weight[i][cur_j - 1].weight++;
-                        _cells_weight[i][cur_j].weight = 0;
-                        _weight_max = (_cells_weight[i][cur_j - 1].weight > _weight_max) ?
-                                      _cells_weight[i][cur_j - 1].weight : _weight_max;
-
-                        score = (score < 0) ? 0 : score;
-                        score += 1 << _cells_weight[i][cur_j - 1].weight;
-                    } else if (_cells_weight[i][cur_j - 1].weight == 0) {
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[i][cur_j].y & (1 << k);
-                            if (target_flag) {
-                                target_cells[i][k] = cur_j - 1;
-                            }
-                        }
-
-                        score = (score < 0) ? 0 : score;
-                        _cells_weight[i][cur_j - 1] = _cells_weight[i][cur_j];
-                        _cells_weight[i][cur_j].weight = 0;
-                    } else {
-                        break;
-                    }
-                    cur_j--;
-                }
-            }
-        }
+    if (moved == _board) {
+        return -1;
     }
 
-    debugCells(_cells_weight);
-    debugCells(target_cells);
-    debugCells(_remove_ready_cells);
-    debugCells(_foreground_cells);
+    debugCells();
 
-    for (int i = 0; i < 4; i++) {
-        for (int j = 1; j < 4; j++) {
-            int target_j = target_cells[i][j];
-            if ((_foreground_cells[i][j] != NULL) && (j != target_j)) {
-                // printf(NULL, "i,j: %d,%d", i, j);
-                int target_x = lv_obj_get_x(_background_cells[i][target_j]);
-                startAnimationX(_foreground_cells[i][j], target_x, ANIM_PERIOD);
-                _foreground_cells[i][target_j] = _foreground_cells[i][j];
-                _foreground_cells[i][j] = NULL;
+    // The board is moved by the tables, each line is only traced again to animate its tiles
+    lv_obj_t *moved_cells[4][4] = {};
+    for (int line = 0; line < 4; line++) {
+        int weights[4];
+        int targets[4];
+        int row = 0;
+        int column = 0;
+        for (int k = 0; k < 4; k++) {
+            get_line_cell(direction, line, k, row, column);
+            weights[k] = Game2048Board::getWeight(_board, row, column);
+        }
+        Game2048Board::traceLine(weights, targets);
+
+        for (int k = 0; k < 4; k++) {
+            int target_row = 0;
+            int target_column = 0;
+            get_line_cell(direction, line, k, row, column);
+            lv_obj_t *cell = _foreground_cells[row][column];
+            if ((targets[k] < 0) || (cell == NULL)) {
+                continue;
+            }
+            get_line_cell(direction, line, targets[k], target_row, target_column);
+            // The tile merged into is removed when the animations finish
+            addRemoveReadyCell(moved_cells[target_row][target_column]);
+            moved_cells[target_row][target_column] = cell;
+            if (targets[k] == k) {
+                continue;
+            }
+            if (row == target_row) {
+                startAnimationX(cell, lv_obj_get_x(_background_cells[target_row][target_column]), ANIM_PERIOD);
+            } else {
+                startAnimationY(cell, lv_obj_get_y(_background_cells[target_row][target_column]), ANIM_PERIOD);
             }
         }
     }
+    memcpy(_foreground_cells, moved_cells, sizeof(_foreground_cells));
+    _board = moved;
+    _weight_max = Game2048Board::getMaxWeight(_board);
 
+    debugCells(_remove_ready_cells);
     debugCells(_foreground_cells);
 
-    // Reset x,y of weight
-    for (int i = 0; i < 16; i++) {
-        _cells_weight[i / 4][i % 4].x = 1 << (i / 4);
-        _cells_weight[i / 4][i % 4].y = 1 << (i % 4);
-    }
-
     return score;
 }
 
-int Game2048::moveRight()
+int Game2048::moveLeft()
 {
-    int target_cells[4][4];
-    int score = -1;
+    return move(Game2048Board::Direction::Left);
+}
 
-    for (int i = 0; i < 16; i++) {
-        target_cells[i / 4][i % 4] = i % 4;
-    }
+int Game2048::moveRight()
+{
+    return move(Game2048Board::Direction::Right);
+}
 
-    debugCells(_cells_weight);
-    debugCells(target_cells);
+int Game2048::moveUp()
+{
+    return move(Game2048Board::Direction::Up);
+}
 
-    for (int i = 0; i < 4; i++) {
-        for (int j = 2; j >= 0; j--) {
-            if (_cells_weight[i][j].weight != 0) {
-                int merge_flag = false;
-                int cur_j = j;
-                while (cur_j != 3) {
-                    if ((_cells_weight[i][cur_j + 1].weight == _cells_weight[i][cur_j].weight) &&
-                            (!merge_flag)) {
-                        merge_flag = true;
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[i][cur_j].y & (1 << k);
-                            if (target_flag) {
-                                target_cells[i][k] = cur_j + 1;
-                            }
-                        }
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[i][cur_j + 1].y & (1 << k);
-                            if (target_flag) {
-                                addRemoveReadyCell(_foreground_cells[i][k]);
-                            }
-                        }
-
-                        _cells_weight[i][cur_j + 1].y += _cells_weight[i][cur_j].y;
-                        _cells_weight[i][cur_j + 1].weight++;
-                        _cells_weight[i][cur_j].weight = 0;
-                        _weight_max = (_cells_weight[i][cur_j + 1].weight > _weight_max) ?
-                                      _cells_weight[i][cur_j + 1].weight : _weight_max;
-
-                        score = (score < 0) ? 0 : score;
-                        score += 1 << _cells_weight[i][cur_j + 1].weight;
-                    } else if (_cells_weight[i][cur_j + 1].weight == 0) {
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[i][cur_j].y & (1 << k);
-                            if (target_flag) {
-                                target_cells[i][k] = cur_j + 1;
-                            }
-                        }
-
-                        score = (score < 0) ? 0 : score;
-                        _cells_weight[i][cur_j + 1] = _cells_weight[i][cur_j];
-                        _cells_weight[i][cur_j].weight = 0;
-                    } else {
-                        break;
-                    }
-                    cur_j++;
-                }
-            }
-        }
-    }
+int Game2048::moveDown()
+{
+    return move(Game2048Board::Direction::Down);
+}
 
-    debugCells(_cells_weight);
-    debugCells(target_cells);
-    debugCells(_remove_ready_cells);
-    debugCells(_foreground_cells);
+bool Game2048::isGameOver()
+{
+    return Game2048Board::isGameOver(_board);
+}
 
-    for (int i = 0; i < 4; i++) {
-        for (int j = 2; j >= 0; j--) {
-            int target_j = target_cells[i][j];
-            if ((_foreground_cells[i][j] != NULL) && (j != target_j)) {
-                // printf(NULL, "i,j: %d,%d", i, j);
-                int target_x = lv_obj_get_x(_background_cells[i][target_j]);
-                startAnimationX(_foreground_cells[i][j], target_x, ANIM_PERIOD);
-                _foreground_cells[i][target_j] = _foreground_cells[i][j];
-                _foreground_cells[i][j] = NULL;
-            }
-        }
+void Game2048::requestHint()
+{
+    if (_is_autoplay) {
+        return;
     }
+    requestSolve();
+}
 
-    debugCells(_foreground_cells);
-
-    // Reset x,y of weight
-    for (int i = 0; i < 16; i++) {
-        _cells_weight[i / 4][i % 4].x = 1 << (i / 4);
-        _cells_weight[i / 4][i % 4].y = 1 << (i % 4);
+void Game2048::setAutoplay(bool enable)
+{
+    _is_autoplay = enable;
+    _hint_direction = Game2048Board::Direction::Max;
+    updateTitle();
+    if (_is_autoplay && !_anim_running_flag) {
+        requestSolve();
     }
-
-    return score;
 }
 
-int Game2048::moveUp()
+void Game2048::processMove(Game2048Board::Direction direction)
 {
-    int target_cells[4][4];
-    int score = -1;
+    int score = move(direction);
 
-    for (int i = 0; i < 16; i++) {
-        target_cells[i / 4][i % 4] = i / 4;
-    }
-
-    debugCells(_cells_weight);
-    debugCells(target_cells);
-
-    for (int j = 0; j < 4; j++) {
-        for (int i = 1; i < 4; i++) {
-            if (_cells_weight[i][j].weight != 0) {
-                int merge_flag = false;
-                int cur_i = i;
-                while (cur_i != 0) {
-                    if ((_cells_weight[cur_i - 1][j].weight == _cells_weight[cur_i][j].weight) &&
-                            (!merge_flag)) {
-                        merge_flag = true;
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[cur_i][j].x & (1 << k);
-                            if (target_flag) {
-                                target_cells[k][j] = cur_i - 1;
-                            }
-                        }
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[cur_i - 1][j].x & (1 << k);
-                            if (target_flag) {
-                                addRemoveReadyCell(_foreground_cells[k][j]);
-                            }
-                        }
-
-                        _cells_weight[cur_i - 1][j].x += _cells_weight[cur_i][j].x;
-                        _cells_weight[cur_i - 1][j].weight++;
-                        _cells_weight[cur_i][j].weight = 0;
-                        _weight_max = (_cells_weight[cur_i - 1][j].weight > _weight_max) ?
-                                      _cells_weight[cur_i - 1][j].weight : _weight_max;
-
-                        score = (score < 0) ? 0 : score;
-                        score += 1 << _cells_weight[cur_i - 1][j].weight;
-                    } else if (_cells_weight[cur_i - 1][j].weight == 0) {
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[cur_i][j].x & (1 << k);
-                            if (target_flag) {
-                                target_cells[k][j] = cur_i - 1;
-                            }
-                        }
-
-                        score = (score < 0) ? 0 : score;
-                        _cells_weight[cur_i - 1][j] = _cells_weight[cur_i][j];
-                        _cells_weight[cur_i][j].weight = 0;
-                    } else {
-                        break;
-                    }
-                    cur_i--;
-                }
-            }
+    printf("score: %d\n", score);
+
+    _hint_direction = Game2048Board::Direction::Max;
+    updateTitle();
+    if (score >= 0) {
+        _generate_cell_flag = true;
+        _current_score += score;
+        updateCurrentScore(_current_score);
+        if (_current_score > _best_score) {
+            _best_score = _current_score;
+            updateBestScore(_best_score);
         }
     }
+    if (maxWeight() == 11) {
+        printf("Congratualation! You win!\n");
+        newGame();
+    }
+    if (isGameOver()) {
+        printf("Game Over\n");
+    }
+}
 
-    debugCells(_cells_weight);
-    debugCells(target_cells);
-    debugCells(_remove_ready_cells);
-    debugCells(_foreground_cells);
-
-    for (int j = 0; j < 4; j++) {
-        for (int i = 1; i < 4; i++) {
-            int target_i = target_cells[i][j];
-            if ((_foreground_cells[i][j] != NULL) && (i != target_i)) {
-                // printf(NULL, "i,j: %d,%d", i, j);
-                int target_y = lv_obj_get_y(_background_cells[target_i][j]);
-                startAnimationY(_foreground_cells[i][j], target_y, ANIM_PERIOD);
-                _foreground_cells[target_i][j] = _foreground_cells[i][j];
-                _foreground_cells[i][j] = NULL;
-            }
-        }
+void Game2048::requestSolve()
+{
+    // Only one search at a time, the autoplay asks again for the board it gets
+    if (_is_solving) {
+        return;
     }
 
-    debugCells(_foreground_cells);
+    uint32_t generation = _solver_generation;
+    Game2048Board::Bitboard board = _board;
+    uint32_t budget_ms = _is_autoplay ? SOLVER_AUTOPLAY_BUDGET_MS : SOLVER_HINT_BUDGET_MS;
+    _is_solving = true;
+    bool ret = Executor::requestInstance().post([this, generation, board, budget_ms]() {
+        Game2048Solver solver;
+        Game2048Solver::Result result = solver.searchFor(board, budget_ms);
+        ESP_UTILS_LOGD(
+            "Solved: direction(%d), depth(%d), nodes(%d)", static_cast<int>(result.direction), result.depth,
+            static_cast<int>(result.nodes)
+        );
 
-    // Reset x,y of weight
-    for (int i = 0; i < 16; i++) {
-        _cells_weight[i / 4][i % 4].x = 1 << (i / 4);
-        _cells_weight[i / 4][i % 4].y = 1 << (i % 4);
+        getCore()->lockLv();
+        processSolverResult(generation, board, result);
+        getCore()->unlockLv();
+    }, Executor::Priority::Low, "game_2048_solver");
+    if (!ret) {
+        ESP_UTILS_LOGE("Post solver failed");
+        _is_solving = false;
     }
-
-    return score;
 }
 
-int Game2048::moveDown()
+void Game2048::processSolverResult(
+    uint32_t generation, Game2048Board::Bitboard board, const Game2048Solver::Result &result
+)
 {
-    int target_cells[4][4];
-    int score = -1;
+    _is_solving = false;
 
-    for (int i = 0; i < 16; i++) {
-        target_cells[i / 4][i % 4] = i / 4;
-    }
-
-    debugCells(_cells_weight);
-    debugCells(target_cells);
-
-    for (int j = 0; j < 4; j++) {
-        for (int i = 2; i >= 0; i--) {
-            if (_cells_weight[i][j].weight != 0) {
-                int merge_flag = false;
-                int cur_i = i;
-                while (cur_i != 3) {
-                    if ((_cells_weight[cur_i + 1][j].weight == _cells_weight[cur_i][j].weight) &&
-                            (!merge_flag)) {
-                        merge_flag = true;
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[cur_i][j].x & (1 << k);
-                            if (target_flag) {
-                                target_cells[k][j] = cur_i + 1;
-                            }
-                        }
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[cur_i + 1][j].x & (1 << k);
-                            if (target_flag) {
-                                addRemoveReadyCell(_foreground_cells[k][j]);
-                            }
-                        }
-
-                        _cells_weight[cur_i + 1][j].x += _cells_weight[cur_i][j].x;
-                        _cells_weight[cur_i + 1][j].weight++;
-                        _cells_weight[cur_i][j].weight = 0;
-                        _weight_max = (_cells_weight[cur_i + 1][j].weight > _weight_max) ?
-                                      _cells_weight[cur_i + 1][j].weight : _weight_max;
-
-                        score = (score < 0) ? 0 : score;
-                        score += 1 << _cells_weight[cur_i + 1][j].weight;
-                    } else if (_cells_weight[cur_i + 1][j].weight == 0) {
-
-                        for (int k = 0; k < 4; k++) {
-                            int target_flag = _cells_weight[cur_i][j].x & (1 << k);
-                            if (target_flag) {
-                                target_cells[k][j] = cur_i + 1;
-                            }
-                        }
-
-                        score = (score < 0) ? 0 : score;
-                        _cells_weight[cur_i + 1][j] = _cells_weight[cur_i][j];
-                        _cells_weight[cur_i][j].weight = 0;
-                    } else {
-                        break;
-                    }
-                    cur_i++;
-                }
-            }
-        }
+    // The app is closed or the game is restarted
+    if (generation != _solver_generation) {
+        return;
     }
-
-    debugCells(_cells_weight);
-    debugCells(target_cells);
-    debugCells(_remove_ready_cells);
-    debugCells(_foreground_cells);
-
-    for (int j = 0; j < 4; j++) {
-        for (int i = 2; i >= 0; i--) {
-            int target_i = target_cells[i][j];
-            if ((_foreground_cells[i][j] != NULL) && (i != target_i)) {
-                // printf(NULL, "i,j: %d,%d", i, j);
-                int target_y = lv_obj_get_y(_background_cells[target_i][j]);
-                startAnimationY(_foreground_cells[i][j], target_y, ANIM_PERIOD);
-                _foreground_cells[target_i][j] = _foreground_cells[i][j];
-                _foreground_cells[i][j] = NULL;
-            }
+    // The board is moved while searching
+    if (board != _board) {
+        if (_is_autoplay && !_anim_running_flag) {
+            requestSolve();
         }
+        return;
     }
-
-    debugCells(_foreground_cells);
-
-    // Reset x,y of weight
-    for (int i = 0; i < 16; i++) {
-        _cells_weight[i / 4][i % 4].x = 1 << (i / 4);
-        _cells_weight[i / 4][i % 4].y = 1 << (i % 4);
+    if (result.direction == Game2048Board::Direction::Max) {
+        _is_autoplay = false;
+        updateTitle();
+        return;
     }
 
-    return score;
+    if (!_is_autoplay) {
+        _hint_direction = result.direction;
+        updateTitle();
+    } else if (!_anim_running_flag) {
+        // The next search is requested once the animations finish
+        processMove(result.direction);
+    }
 }
 
-bool Game2048::isGameOver()
+void Game2048::updateTitle()
 {
-    for (int i = 0; i < 4; i++) {
-        for (int j = 1; j < 4; j++) {
-            if ((_cells_weight[i][j].weight == _cells_weight[i][j - 1].weight) ||
-                    (_cells_weight[j][i].weight == _cells_weight[j - 1][i].weight) ||
-                    (_cells_weight[i][j].weight == 0)) {
-                return false;
-            }
-        }
+    if (_title_label == nullptr) {
+        return;
     }
 
-    return true;
+    const char *symbol = nullptr;
+    if (_is_autoplay) {
+        symbol = LV_SYMBOL_PLAY;
+    } else {
+        switch (_hint_direction) {
+        case Game2048Board::Direction::Left:
+            symbol = LV_SYMBOL_LEFT;
+            break;
+        case Game2048Board::Direction::Right:
+            symbol = LV_SYMBOL_RIGHT;
+            break;
+        case Game2048Board::Direction::Up:
+            symbol = LV_SYMBOL_UP;
+            break;
+        case Game2048Board::Direction::Down:
+            symbol = LV_SYMBOL_DOWN;
+            break;
+        default:
+            break;
+        }
+    }
+    if (symbol == nullptr) {
+        lv_label_set_text(_title_label, "2048");
+    } else {
+        lv_label_set_text_fmt(_title_label, "2048 %s", symbol);
+    }
 }
 
 void Game2048::new_game_event_cb(lv_event_t *e)
@@ -947,9 +814,22 @@ void Game2048::new_game_event_cb(lv_event_t *e)
     app->newGame();
 }
 
+void Game2048::autoplay_event_cb(lv_event_t *e)
+{
+    Game2048 *app = (Game2048 *)lv_event_get_user_data(e);
+
+    app->setAutoplay(!app->_is_autoplay);
+}
+
+void Game2048::hint_event_cb(lv_event_t *e)
+{
+    Game2048 *app = (Game2048 *)lv_event_get_user_data(e);
+
+    app->requestHint();
+}
+
 void Game2048::motion_event_cb(lv_event_t *e)
 {
-    int score;
     speaker::GestureInfo *type = (speaker::GestureInfo *)lv_event_get_param(e);
     Game2048 *app = (Game2048 *)lv_event_get_user_data(e);
 
@@ -959,45 +839,29 @@ void Game2048::motion_event_cb(lv_event_t *e)
     }
 
     if (!app->_anim_running_flag) {
+        Game2048Board::Direction direction = Game2048Board::Direction::Max;
         switch (type->direction) {
         case speaker::GESTURE_DIR_UP:
-            // printf(NULL, "up");
-            score = app->moveUp();
+            direction = Game2048Board::Direction::Up;
             break;
         case speaker::GESTURE_DIR_DOWN:
-            // printf(NULL, "down");
-            score = app->moveDown();
+            direction = Game2048Board::Direction::Down;
             break;
         case speaker::GESTURE_DIR_LEFT:
-            // printf(NULL, "left");
-            score = app->moveLeft();
+            direction = Game2048Board::Direction::Left;
             break;
         case speaker::GESTURE_DIR_RIGHT:
-            // printf(NULL, "right");
-            score = app->moveRight();
+            direction = Game2048Board::Direction::Right;
             break;
         default:
             return;
         }
 
-        printf("score: %d\n", score);
-
-        if (score >= 0) {
-            app->_generate_cell_flag = true;
-            app->_current_score += score;
-            app->updateCurrentScore(app->_current_score);
-            if (app->_current_score > app->_best_score) {
-                app->_best_score = app->_current_score;
-                app->updateBestScore(app->_best_score);
-            }
-        }
-        if (app->maxWeight() == 11) {
-            printf("Congratualation! You win!\n");
-            app->newGame();
-        }
-        if (app->isGameOver()) {
-            printf("Game Over\n");
+        // Playing by hand stops the autoplay
+        if (app->_is_autoplay) {
+            app->setAutoplay(false);
         }
+        app->processMove(direction);
     }
 }
 
@@ -1014,6 +878,9 @@ void Game2048::anim_finish_cb(lv_anim_t *a)
     }
     if (app->_anim_running_flag) {
         app->_anim_running_flag = false;
+        if (app->_is_autoplay && !app->_is_closing) {
+            app->requestSolve();
+        }
     }
 }
 
@@ -7,15 +7,11 @@
 
 #include "lvgl.h"
 #include "esp_brookesia.hpp"
+#include "esp_brookesia_app_game_2048_board.hpp"
+#include "esp_brookesia_app_game_2048_solver.hpp"
 
 namespace esp_brookesia::speaker_apps {
 
-typedef struct {
-    int x; // Index of row
-    int y; // Index of column
-    int weight;
-} cell_weight_t;
-
 class Game2048: public speaker::App {
 public:
     Game2048(int width, int height);
@@ -31,7 +27,6 @@ public:
     void debugCells();
     void debugCells(int cell[4][4]);
     void debugCells(lv_obj_t *cell[4][4]);
-    void debugCells(cell_weight_t cell[4][4]);
     void debugCells(lv_obj_t *cell[4]);
     void cleanForegroundCells();
     void generateForegroundCell();
@@ -43,18 +38,27 @@ public:
     void updateBestScore(int score);
     void updateCellsStyle();
     int maxWeight();
+    int move(Game2048Board::Direction direction);
     int moveLeft();
     int moveRight();
     int moveUp();
     int moveDown();
     bool isGameOver();
+    void requestHint();
+    void setAutoplay(bool enable);
 
 private:
     lv_obj_t *addBackgroundCell(lv_obj_t *parent);
     void startAnimationX(lv_obj_t *target, int x, int time);
     void startAnimationY(lv_obj_t *target, int y, int time);
+    void processMove(Game2048Board::Direction direction);
+    void requestSolve();
+    void processSolverResult(uint32_t generation, Game2048Board::Bitboard board, const Game2048Solver::Result &result);
+    void updateTitle();
 
     static void new_game_event_cb(lv_event_t *e);
+    static void autoplay_event_cb(lv_event_t *e);
+    static void hint_event_cb(lv_event_t *e);
     static void motion_event_cb(lv_event_t *e);
     static void anim_finish_cb(lv_anim_t *a);
 
@@ -66,8 +70,14 @@ private:
     bool _is_closing = false;
     bool _anim_running_flag = false;
     bool _generate_cell_flag = false;
+    // The solver runs on the executor, its results are dropped once the game they were searched for is gone
+    bool _is_autoplay = false;
+    bool _is_solving = false;
+    uint32_t _solver_generation = 0;
+    Game2048Board::Direction _hint_direction = Game2048Board::Direction::Max;
 
-    cell_weight_t _cells_weight[4][4] = {};
+    Game2048Board::Bitboard _board = 0;
+    lv_obj_t *_title_label = nullptr;
     lv_obj_t *_cur_score_label = nullptr;
     lv_obj_t *_best_score_label = nullptr;
     lv_obj_t *_background_cells[4][4] = {};
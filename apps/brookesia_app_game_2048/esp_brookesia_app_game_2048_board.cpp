@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:App:2048:Board"
+#include "esp_lib_utils.h"
+#include "esp_brookesia_app_game_2048_board.hpp"
+
+#define ROW_NUM         (1 << 16)
+
+namespace esp_brookesia::speaker_apps {
+
+// Row moved to the left, and the score of the move divided by 4 (the smallest merge gives 4, the largest row 65536)
+static std::unique_ptr<uint16_t[]> row_left_table;
+static std::unique_ptr<uint16_t[]> row_score_table;
+
+static uint16_t reverse_row(uint16_t row)
+{
+    return (row >> 12) | ((row >> 4) & 0x00F0) | ((row << 4) & 0x0F00) | (row << 12);
+}
+
+bool Game2048Board::initTables()
+{
+    static std::once_flag once_flag;
+    std::call_once(once_flag, []() {
+        std::unique_ptr<uint16_t[]> left(new (std::nothrow) uint16_t[ROW_NUM]);
+        std::unique_ptr<uint16_t[]> score(new (std::nothrow) uint16_t[ROW_NUM]);
+        ESP_UTILS_CHECK_FALSE_EXIT((left != nullptr) && (score != nullptr), "Allocate row tables failed");
+
+        int weights[SIZE];
+        int moved[SIZE];
+        int targets[SIZE];
+        for (uint32_t row = 0; row < ROW_NUM; row++) {
+            for (int i = 0; i < SIZE; i++) {
+                weights[i] = (row >> (i * 4)) & 0xF;
+            }
+            score[row] = moveLine(weights, moved, targets) / 4;
+            left[row] = moved[0] | (moved[1] << 4) | (moved[2] << 8) | (moved[3] << 12);
+        }
+        row_left_table = std::move(left);
+        row_score_table = std::move(score);
+    });
+
+    return (row_left_table != nullptr);
+}
+
+Game2048Board::Bitboard Game2048Board::move(Bitboard board, Direction direction, uint32_t *score)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(initTables(), board, "Init tables failed");
+
+    switch (direction) {
+    case Direction::Left:
+        return moveRows(board, false, score);
+    case Direction::Right:
+        return moveRows(board, true, score);
+    // The columns are moved as the rows of the transposed board
+    case Direction::Up:
+        return transpose(moveRows(transpose(board), false, score));
+    case Direction::Down:
+        return transpose(moveRows(transpose(board), true, score));
+    default:
+        break;
+    }
+
+    return board;
+}
+
+void Game2048Board::traceLine(const int weights[SIZE], int targets[SIZE])
+{
+    int moved[SIZE];
+
+    moveLine(weights, moved, targets);
+}
+
+int Game2048Board::getEmptyCount(Bitboard board)
+{
+    // Fold the bits of each nibble into its lowest bit, which is set for the tiles
+    board |= (board >> 2) & 0x3333333333333333ULL;
+    board |= (board >> 1);
+
+    return SIZE * SIZE - __builtin_popcountll(board & 0x1111111111111111ULL);
+}
+
+int Game2048Board::getMaxWeight(Bitboard board)
+{
+    int weight_max = 0;
+
+    for (; board != 0; board >>= 4) {
+        weight_max = std::max(weight_max, static_cast<int>(board & 0xF));
+    }
+
+    return weight_max;
+}
+
+bool Game2048Board::isGameOver(Bitboard board)
+{
+    for (int i = 0; i < static_cast<int>(Direction::Max); i++) {
+        if (move(board, static_cast<Direction>(i)) != board) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Game2048Board::Bitboard Game2048Board::transpose(Bitboard board)
+{
+    // Swap the nibbles across the diagonal of each 2x2 block, then the 2x2 blocks across the diagonal of the board
+    Bitboard a1 = board & 0xF0F00F0FF0F00F0FULL;
+    Bitboard a2 = board & 0x0000F0F00000F0F0ULL;
+    Bitboard a3 = board & 0x0F0F00000F0F0000ULL;
+    Bitboard a = a1 | (a2 << 12) | (a3 >> 12);
+    Bitboard b1 = a & 0xFF00FF0000FF00FFULL;
+    Bitboard b2 = a & 0x00FF00FF00000000ULL;
+    Bitboard b3 = a & 0x00000000FF00FF00ULL;
+
+    return b1 | (b2 >> 24) | (b3 << 24);
+}
+
+uint32_t Game2048Board::moveLine(const int weights[SIZE], int moved[SIZE], int targets[SIZE])
+{
+    uint32_t score = 0;
+    int moved_num = 0;
+
+    for (int i = 0; i < SIZE; i++) {
+        moved[i] = 0;
+    }
+    for (int i = 0; i < SIZE; i++) {
+        if (weights[i] == 0) {
+            targets[i] = -1;
+            continue;
+        }
+        // Like the cell by cell moves of the app before the bitboard, a sliding tile merges into the tile it meets if
+        // they have the same weight, even if that one was merged by the same move (2,2,4 gives 8). The largest tiles
+        // are not merged since they fill the nibble
+        if ((moved_num > 0) && (moved[moved_num - 1] == weights[i]) && (weights[i] < WEIGHT_MAX)) {
+            moved[moved_num - 1]++;
+            score += 1U << moved[moved_num - 1];
+            targets[i] = moved_num - 1;
+        } else {
+            moved[moved_num] = weights[i];
+            targets[i] = moved_num++;
+        }
+    }
+
+    return score;
+}
+
+Game2048Board::Bitboard Game2048Board::moveRows(Bitboard board, bool is_reversed, uint32_t *score)
+{
+    Bitboard result = 0;
+    uint32_t score_div_4 = 0;
+
+    for (int i = 0; i < SIZE; i++) {
+        uint16_t row = (board >> (i * 16)) & 0xFFFF;
+        if (is_reversed) {
+            row = reverse_row(row);
+        }
+        uint16_t moved = row_left_table[row];
+        score_div_4 += row_score_table[row];
+        if (is_reversed) {
+            moved = reverse_row(moved);
+        }
+        result |= static_cast<Bitboard>(moved) << (i * 16);
+    }
+    if (score != nullptr) {
+        *score = score_div_4 * 4;
+    }
+
+    return result;
+}
+
+} // namespace esp_brookesia::speaker_apps
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace esp_brookesia::speaker_apps {
+
+/**
+ * @brief Board of 2048 packed in 64 bits, moved with tables of all the rows. It doesn't use LVGL, so the game can be
+ *        played by the solver and checked on the host
+ *
+ * Each cell is a nibble holding the weight of its tile, the value of the tile is `1 << weight` and an empty cell is 0.
+ * Row `i` is the 16 bits from bit `16 * i`, and column `j` is the nibble `j` of its row.
+ */
+class Game2048Board {
+public:
+    using Bitboard = uint64_t;
+
+    enum class Direction : uint8_t {
+        Left = 0,
+        Right,
+        Up,
+        Down,
+        Max,
+    };
+
+    static constexpr int SIZE = 4;
+    static constexpr int WEIGHT_MAX = 15;
+
+    /**
+     * @brief Build the tables of the rows (256 KB), called automatically by the first move
+     */
+    static bool initTables();
+
+    /**
+     * @brief Move the tiles, a sliding tile is merged into the tile of the same weight it meets, even a merged one
+     *
+     * @param board     Board to move
+     * @param direction Direction of the move
+     * @param score     Optional output of the sum of the values of the merged tiles
+     *
+     * @return Board after the move, the same board if nothing moves
+     */
+    static Bitboard move(Bitboard board, Direction direction, uint32_t *score = nullptr);
+
+    /**
+     * @brief Find where the tiles of a line end up, for the animations of the UI
+     *
+     * @param weights Weights of the line, from the side the tiles move to
+     * @param targets Output of the index where each tile ends up, -1 for an empty cell. The tiles with the same target
+     *                are merged
+     */
+    static void traceLine(const int weights[SIZE], int targets[SIZE]);
+
+    static int getWeight(Bitboard board, int row, int column)
+    {
+        return static_cast<int>((board >> getShift(row, column)) & 0xF);
+    }
+    static Bitboard setWeight(Bitboard board, int row, int column, int weight)
+    {
+        return (board & ~(static_cast<Bitboard>(0xF) << getShift(row, column))) |
+               (static_cast<Bitboard>(weight & 0xF) << getShift(row, column));
+    }
+    static int getEmptyCount(Bitboard board);
+    static int getMaxWeight(Bitboard board);
+    static bool isGameOver(Bitboard board);
+    static Bitboard transpose(Bitboard board);
+
+private:
+    static int getShift(int row, int column)
+    {
+        return (row * SIZE + column) * 4;
+    }
+    static uint32_t moveLine(const int weights[SIZE], int moved[SIZE], int targets[SIZE]);
+    static Bitboard moveRows(Bitboard board, bool is_reversed, uint32_t *score);
+};
+
+} // namespace esp_brookesia::speaker_apps
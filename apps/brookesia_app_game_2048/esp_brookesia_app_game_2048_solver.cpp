@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <new>
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:App:2048:Solver"
+#include "esp_lib_utils.h"
+#include "esp_brookesia_app_game_2048_solver.hpp"
+
+#define ROW_NUM                     (1 << 16)
+// Weights of the heuristic of a row
+#define HEURISTIC_LOST_PENALTY      (200000.0f)
+#define HEURISTIC_EMPTY_WEIGHT      (270.0f)
+#define HEURISTIC_MERGES_WEIGHT     (700.0f)
+#define HEURISTIC_MONO_POWER        (4.0f)
+#define HEURISTIC_MONO_WEIGHT       (47.0f)
+#define HEURISTIC_SUM_POWER         (3.5f)
+#define HEURISTIC_SUM_WEIGHT        (11.0f)
+// The clock is only read every so many boards
+#define DEADLINE_CHECK_NODES        (1024)
+// Only the boards with this many moves left are worth remembering
+#define CACHE_DEPTH_MIN             (2)
+
+namespace esp_brookesia::speaker_apps {
+
+using Board = Game2048Board;
+
+static std::unique_ptr<float[]> row_heuristic_table;
+
+Game2048Solver::Game2048Solver():
+    Game2048Solver(DEFAULT_CONFIG)
+{
+}
+
+Game2048Solver::Game2048Solver(const Config &config):
+    _config(config)
+{
+}
+
+bool Game2048Solver::initTables()
+{
+    static std::once_flag once_flag;
+    std::call_once(once_flag, []() {
+        std::unique_ptr<float[]> heuristic(new (std::nothrow) float[ROW_NUM]);
+        ESP_UTILS_CHECK_NULL_EXIT(heuristic, "Allocate heuristic table failed");
+
+        for (uint32_t row = 0; row < ROW_NUM; row++) {
+            int line[Board::SIZE];
+            float sum = 0;
+            int empty = 0;
+            int merges = 0;
+            int previous = 0;
+            int counter = 0;
+            for (int i = 0; i < Board::SIZE; i++) {
+                line[i] = (row >> (i * 4)) & 0xF;
+                sum += std::pow(static_cast<float>(line[i]), HEURISTIC_SUM_POWER);
+                if (line[i] == 0) {
+                    empty++;
+                    continue;
+                }
+                if (previous == line[i]) {
+                    counter++;
+                } else if (counter > 0) {
+                    merges += 1 + counter;
+                    counter = 0;
+                }
+                previous = line[i];
+            }
+            if (counter > 0) {
+                merges += 1 + counter;
+            }
+
+            float mono_left = 0;
+            float mono_right = 0;
+            for (int i = 1; i < Board::SIZE; i++) {
+                float power_previous = std::pow(static_cast<float>(line[i - 1]), HEURISTIC_MONO_POWER);
+                float power = std::pow(static_cast<float>(line[i]), HEURISTIC_MONO_POWER);
+                if (line[i - 1] > line[i]) {
+                    mono_left += power_previous - power;
+                } else {
+                    mono_right += power - power_previous;
+                }
+            }
+
+            heuristic[row] = HEURISTIC_LOST_PENALTY + HEURISTIC_EMPTY_WEIGHT * empty +
+                             HEURISTIC_MERGES_WEIGHT * merges - HEURISTIC_MONO_WEIGHT * std::min(mono_left, mono_right) -
+                             HEURISTIC_SUM_WEIGHT * sum;
+        }
+        row_heuristic_table = std::move(heuristic);
+    });
+
+    return (row_heuristic_table != nullptr) && Board::initTables();
+}
+
+Game2048Solver::Result Game2048Solver::search(Bitboard board, int depth)
+{
+    _has_deadline = false;
+
+    return searchDepth(board, depth);
+}
+
+Game2048Solver::Result Game2048Solver::searchFor(Bitboard board, uint32_t budget_ms)
+{
+    Result result = {Direction::Max, 0, 0, 0};
+    uint32_t nodes = 0;
+
+    _has_deadline = true;
+    _deadline = Clock::now() + std::chrono::milliseconds(budget_ms);
+    for (int depth = 1; depth <= _config.depth_max; depth++) {
+        Result depth_result = searchDepth(board, depth);
+        nodes += depth_result.nodes;
+        if (_is_aborted) {
+            break;
+        }
+        result = depth_result;
+        if (result.direction == Direction::Max) {
+            break;
+        }
+    }
+    result.nodes = nodes;
+
+    return result;
+}
+
+float Game2048Solver::evaluate(Bitboard board)
+{
+    Bitboard transposed = Board::transpose(board);
+    float value = 0;
+
+    for (int i = 0; i < Board::SIZE; i++) {
+        value += row_heuristic_table[(board >> (i * 16)) & 0xFFFF];
+        value += row_heuristic_table[(transposed >> (i * 16)) & 0xFFFF];
+    }
+
+    return value;
+}
+
+Game2048Solver::Result Game2048Solver::searchDepth(Bitboard board, int depth)
+{
+    Result result = {Direction::Max, depth, 0, 0};
+
+    ESP_UTILS_CHECK_FALSE_RETURN(initTables(), result, "Init tables failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(depth > 0, result, "Invalid depth(%d)", depth);
+
+    _nodes = 0;
+    _is_aborted = false;
+    _cache.clear();
+    for (int i = 0; i < static_cast<int>(Direction::Max); i++) {
+        Bitboard moved = Board::move(board, static_cast<Direction>(i));
+        _nodes++;
+        if (moved == board) {
+            continue;
+        }
+        float value = searchSpawn(moved, depth - 1, 1.0f);
+        if (_is_aborted) {
+            break;
+        }
+        if ((result.direction == Direction::Max) || (value > result.value)) {
+            result.direction = static_cast<Direction>(i);
+            result.value = value;
+        }
+    }
+    result.nodes = _nodes;
+    // The boards of an aborted search are not worth more than the ones of a shallower search
+    _cache.clear();
+
+    return result;
+}
+
+float Game2048Solver::searchMove(Bitboard board, int depth, float probability)
+{
+    float best = 0;
+
+    for (int i = 0; i < static_cast<int>(Direction::Max); i++) {
+        Bitboard moved = Board::move(board, static_cast<Direction>(i));
+        _nodes++;
+        if (_has_deadline && ((_nodes % DEADLINE_CHECK_NODES) == 0) && (Clock::now() >= _deadline)) {
+            _is_aborted = true;
+        }
+        if (_is_aborted) {
+            return 0;
+        }
+        if (moved != board) {
+            best = std::max(best, searchSpawn(moved, depth, probability));
+        }
+    }
+
+    // A lost board is worth nothing
+    return best;
+}
+
+float Game2048Solver::searchSpawn(Bitboard board, int depth, float probability)
+{
+    if ((depth == 0) || (probability < _config.probability_min)) {
+        return evaluate(board);
+    }
+    if (depth >= CACHE_DEPTH_MIN) {
+        auto it = _cache.find(board);
+        if ((it != _cache.end()) && (it->second.depth >= depth)) {
+            return it->second.value;
+        }
+    }
+
+    // Every empty cell is as likely to get the new tile
+    int empty = Board::getEmptyCount(board);
+    float probability_4 = _config.spawn_4_percent / 100.0f;
+    float probability_cell = probability / empty;
+    float value = 0;
+    for (int i = 0; i < Board::SIZE * Board::SIZE; i++) {
+        int row = i / Board::SIZE;
+        int column = i % Board::SIZE;
+        if (Board::getWeight(board, row, column) != 0) {
+            continue;
+        }
+        value += (1 - probability_4) *
+                 searchMove(Board::setWeight(board, row, column, 1), depth - 1, probability_cell * (1 - probability_4));
+        if (probability_4 > 0) {
+            value += probability_4 *
+                     searchMove(Board::setWeight(board, row, column, 2), depth - 1, probability_cell * probability_4);
+        }
+        if (_is_aborted) {
+            return 0;
+        }
+    }
+    value /= empty;
+
+    if ((depth >= CACHE_DEPTH_MIN) && (_cache.size() < _config.cache_size_max)) {
+        _cache[board] = {depth, value};
+    }
+
+    return value;
+}
+
+} // namespace esp_brookesia::speaker_apps
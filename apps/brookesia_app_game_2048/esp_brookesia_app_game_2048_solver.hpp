@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include "esp_brookesia_app_game_2048_board.hpp"
+
+namespace esp_brookesia::speaker_apps {
+
+/**
+ * @brief Depth limited expectimax on the bitboard, for the hints and the autoplay of the game. A solver searches one
+ *        board at a time, but each thread can use its own
+ */
+class Game2048Solver {
+public:
+    using Bitboard = Game2048Board::Bitboard;
+    using Direction = Game2048Board::Direction;
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        int depth_max;              // Moves searched ahead at most
+        float probability_min;      // Spawns less likely than this are not searched further
+        int spawn_4_percent;        // Chance of a new tile being a 4 instead of a 2
+        uint32_t cache_size_max;    // Boards remembered by a search
+    };
+
+    struct Result {
+        Direction direction;        // Best move, `Direction::Max` if the game is over
+        int depth;                  // Deepest search completed
+        float value;                // Expected heuristic value of the best move
+        uint32_t nodes;             // Boards moved by the search
+    };
+
+    // The game only spawns 2
+    static constexpr Config DEFAULT_CONFIG = {
+        .depth_max = 8,
+        .probability_min = 0.0001f,
+        .spawn_4_percent = 0,
+        .cache_size_max = 8192,
+    };
+
+    Game2048Solver();
+    explicit Game2048Solver(const Config &config);
+
+    /**
+     * @brief Build the table of the heuristic of the rows (256 KB) and the ones of the board, called automatically by
+     *        the first search
+     */
+    static bool initTables();
+
+    /**
+     * @brief Search all the moves `depth` moves ahead
+     */
+    Result search(Bitboard board, int depth);
+
+    /**
+     * @brief Search deeper and deeper until the budget runs out, and return the deepest search completed
+     */
+    Result searchFor(Bitboard board, uint32_t budget_ms);
+
+    /**
+     * @brief Heuristic value of a board: empty cells, merges and monotonic rows and columns are good, large tiles
+     *        scattered are bad
+     */
+    static float evaluate(Bitboard board);
+
+private:
+    struct CacheEntry {
+        int depth;
+        float value;
+    };
+
+    Result searchDepth(Bitboard board, int depth);
+    float searchMove(Bitboard board, int depth, float probability);
+    float searchSpawn(Bitboard board, int depth, float probability);
+
+    Config _config;
+    uint32_t _nodes = 0;
+    bool _is_aborted = false;
+    bool _has_deadline = false;
+    Clock::time_point _deadline;
+    std::unordered_map<Bitboard, CacheEntry> _cache;
+};
+
+} // namespace esp_brookesia::speaker_apps
@@ -0,0 +1,276 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <random>
+#include <vector>
+#include "esp_log.h"
+#include "esp_brookesia_app_game_2048_board.hpp"
+#include "esp_brookesia_app_game_2048_solver.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::speaker_apps::Game2048Board;
+using esp_brookesia::speaker_apps::Game2048Solver;
+using Bitboard = Game2048Board::Bitboard;
+using Direction = Game2048Board::Direction;
+
+#define HOST_GAME_2048_RANDOM_BOARDS    (20000)
+#define HOST_GAME_2048_BENCH_MOVES      (2000000)
+// Budget of a move of the autoplay of the app
+#define HOST_GAME_2048_SOLVER_BUDGET_MS (100)
+#define HOST_GAME_2048_SOLVER_BOARDS    (5)
+#define HOST_GAME_2048_AUTOPLAY_DEPTH   (2)
+#define HOST_GAME_2048_AUTOPLAY_MOVES   (400)
+
+static const char *TAG = "host_game_2048";
+
+/* Move of the board cell by cell, like the app did before the bitboard */
+static bool host_game_2048_move_cells(int cells[4][4], Direction direction, uint32_t *score)
+{
+    bool is_moved = false;
+
+    for (int line = 0; line < 4; line++) {
+        int *line_cells[4];
+        for (int k = 0; k < 4; k++) {
+            switch (direction) {
+            case Direction::Left:
+                line_cells[k] = &cells[line][k];
+                break;
+            case Direction::Right:
+                line_cells[k] = &cells[line][3 - k];
+                break;
+            case Direction::Up:
+                line_cells[k] = &cells[k][line];
+                break;
+            default:
+                line_cells[k] = &cells[3 - k][line];
+                break;
+            }
+        }
+        // Each tile slides on its own and merges at most once, into the tile it meets even if that one just merged
+        for (int k = 1; k < 4; k++) {
+            bool is_merged = false;
+            for (int cur = k; (cur > 0) && (*line_cells[cur] != 0); cur--) {
+                int &next = *line_cells[cur - 1];
+                int &tile = *line_cells[cur];
+                if (!is_merged && (next == tile) && (tile < Game2048Board::WEIGHT_MAX)) {
+                    next++;
+                    *score += 1U << next;
+                    is_merged = true;
+                } else if (next == 0) {
+                    next = tile;
+                } else {
+                    break;
+                }
+                tile = 0;
+                is_moved = true;
+            }
+        }
+    }
+
+    return is_moved;
+}
+
+static void host_game_2048_to_cells(Bitboard board, int cells[4][4])
+{
+    for (int i = 0; i < 16; i++) {
+        cells[i / 4][i % 4] = Game2048Board::getWeight(board, i / 4, i % 4);
+    }
+}
+
+static Bitboard host_game_2048_from_cells(const int cells[4][4])
+{
+    Bitboard board = 0;
+    for (int i = 0; i < 16; i++) {
+        board = Game2048Board::setWeight(board, i / 4, i % 4, cells[i / 4][i % 4]);
+    }
+
+    return board;
+}
+
+/* Boards with many tiles of the same weight, so most moves merge */
+static std::vector<Bitboard> host_game_2048_random_boards(int num, unsigned seed)
+{
+    std::mt19937 random(seed);
+    std::vector<Bitboard> boards;
+    for (int i = 0; i < num; i++) {
+        Bitboard board = 0;
+        int weight_max = 1 + random() % Game2048Board::WEIGHT_MAX;
+        for (int j = 0; j < 16; j++) {
+            int weight = ((random() % 10) < 4) ? 0 : static_cast<int>(random() % (weight_max + 1));
+            board = Game2048Board::setWeight(board, j / 4, j % 4, weight);
+        }
+        boards.push_back(board);
+    }
+
+    return boards;
+}
+
+/* The bitboard moves as the board moved cell by cell, and the tiles traced for the UI end up on the moved board */
+static bool host_game_2048_check_moves()
+{
+    auto boards = host_game_2048_random_boards(HOST_GAME_2048_RANDOM_BOARDS, 1);
+    for (auto board : boards) {
+        HOST_CHECK(Game2048Board::transpose(Game2048Board::transpose(board)) == board);
+        for (int d = 0; d < static_cast<int>(Direction::Max); d++) {
+            auto direction = static_cast<Direction>(d);
+            int cells[4][4];
+            uint32_t expected_score = 0;
+            host_game_2048_to_cells(board, cells);
+            bool is_moved = host_game_2048_move_cells(cells, direction, &expected_score);
+
+            uint32_t score = 0;
+            Bitboard moved = Game2048Board::move(board, direction, &score);
+            HOST_CHECK(moved == host_game_2048_from_cells(cells));
+            HOST_CHECK(score == expected_score);
+            HOST_CHECK((moved != board) == is_moved);
+
+            if (direction != Direction::Left) {
+                continue;
+            }
+            for (int row = 0; row < 4; row++) {
+                int weights[4];
+                int targets[4];
+                // The values of the tiles arriving at a cell add up to the value of the tile left there
+                uint32_t arrived[4] = {};
+                for (int k = 0; k < 4; k++) {
+                    weights[k] = Game2048Board::getWeight(board, row, k);
+                }
+                Game2048Board::traceLine(weights, targets);
+                for (int k = 0; k < 4; k++) {
+                    if (weights[k] == 0) {
+                        HOST_CHECK(targets[k] == -1);
+                        continue;
+                    }
+                    HOST_CHECK((targets[k] >= 0) && (targets[k] <= k));
+                    arrived[targets[k]] += 1U << weights[k];
+                }
+                for (int k = 0; k < 4; k++) {
+                    int weight = Game2048Board::getWeight(moved, row, k);
+                    HOST_CHECK(arrived[k] == ((weight == 0) ? 0 : (1U << weight)));
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool host_game_2048_check_game_over()
+{
+    const int over[4][4] = {{1, 2, 1, 2}, {2, 1, 2, 1}, {1, 2, 1, 2}, {2, 1, 2, 1}};
+    int merge_column[4][4] = {{1, 2, 1, 2}, {2, 1, 2, 1}, {1, 2, 1, 2}, {2, 1, 2, 1}};
+    merge_column[3][3] = 2;
+    int empty[4][4] = {{1, 2, 1, 2}, {2, 1, 2, 1}, {1, 2, 1, 2}, {2, 1, 2, 1}};
+    empty[2][1] = 0;
+
+    HOST_CHECK(Game2048Board::isGameOver(host_game_2048_from_cells(over)));
+    HOST_CHECK(!Game2048Board::isGameOver(host_game_2048_from_cells(merge_column)));
+    HOST_CHECK(!Game2048Board::isGameOver(host_game_2048_from_cells(empty)));
+    HOST_CHECK(Game2048Board::getEmptyCount(host_game_2048_from_cells(empty)) == 1);
+    HOST_CHECK(Game2048Board::getEmptyCount(0) == 16);
+    HOST_CHECK(Game2048Board::getMaxWeight(host_game_2048_from_cells(over)) == 2);
+
+    return true;
+}
+
+static bool host_game_2048_check_moves_per_second()
+{
+    auto boards = host_game_2048_random_boards(1024, 2);
+    using Clock = std::chrono::steady_clock;
+
+    // The results are summed so the moves are not optimized out
+    Bitboard sum = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < HOST_GAME_2048_BENCH_MOVES; i++) {
+        sum += Game2048Board::move(boards[i % boards.size()], static_cast<Direction>(i % 4));
+    }
+    float bitboard_s = std::chrono::duration<float>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int i = 0; i < HOST_GAME_2048_BENCH_MOVES; i++) {
+        int cells[4][4];
+        uint32_t score = 0;
+        host_game_2048_to_cells(boards[i % boards.size()], cells);
+        host_game_2048_move_cells(cells, static_cast<Direction>(i % 4), &score);
+        sum += cells[i % 4][(i / 4) % 4];
+    }
+    float cells_s = std::chrono::duration<float>(Clock::now() - start).count();
+
+    ESP_LOGI(
+        TAG, "Moves: bitboard %.2f M/s, cell by cell %.2f M/s (%u)", HOST_GAME_2048_BENCH_MOVES / bitboard_s / 1e6f,
+        HOST_GAME_2048_BENCH_MOVES / cells_s / 1e6f, static_cast<unsigned>(sum & 0x1)
+    );
+
+    return true;
+}
+
+/* The solver picks a move of the board within the budget, and plays far better than by chance */
+static bool host_game_2048_check_solver()
+{
+    std::mt19937 random(3);
+    auto spawn = [&random](Bitboard board) {
+        int empty = Game2048Board::getEmptyCount(board);
+        int target = random() % empty;
+        for (int i = 0; i < 16; i++) {
+            if ((Game2048Board::getWeight(board, i / 4, i % 4) == 0) && (target-- == 0)) {
+                // Like the app, which only spawns 2
+                return Game2048Board::setWeight(board, i / 4, i % 4, 1);
+            }
+        }
+        return board;
+    };
+
+    Game2048Solver solver;
+    Bitboard board = spawn(spawn(0));
+    int moves = 0;
+    for (; moves < HOST_GAME_2048_AUTOPLAY_MOVES; moves++) {
+        auto result = solver.search(board, HOST_GAME_2048_AUTOPLAY_DEPTH);
+        if (result.direction == Direction::Max) {
+            break;
+        }
+        Bitboard moved = Game2048Board::move(board, result.direction);
+        HOST_CHECK(moved != board);
+        board = spawn(moved);
+
+        // The search in the budget is measured on a few boards of the game
+        if ((moves % (HOST_GAME_2048_AUTOPLAY_MOVES / HOST_GAME_2048_SOLVER_BOARDS)) == 0) {
+            auto start = std::chrono::steady_clock::now();
+            auto budget_result = solver.searchFor(board, HOST_GAME_2048_SOLVER_BUDGET_MS);
+            auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::steady_clock::now() - start
+                              ).count();
+            ESP_LOGI(
+                TAG, "Solver(move %d, %d empty): depth %d in %dms, %u boards in %dms", moves,
+                Game2048Board::getEmptyCount(board), budget_result.depth, HOST_GAME_2048_SOLVER_BUDGET_MS,
+                static_cast<unsigned>(budget_result.nodes), static_cast<int>(elapsed_ms)
+            );
+            HOST_CHECK(budget_result.depth >= 2);
+            HOST_CHECK(elapsed_ms < 2 * HOST_GAME_2048_SOLVER_BUDGET_MS);
+            HOST_CHECK(
+                (budget_result.direction == Direction::Max) ||
+                (Game2048Board::move(board, budget_result.direction) != board)
+            );
+        }
+    }
+    ESP_LOGI(
+        TAG, "Autoplay(depth %d): tile %d after %d moves", HOST_GAME_2048_AUTOPLAY_DEPTH,
+        1 << Game2048Board::getMaxWeight(board), moves
+    );
+    // With only 2 spawned, the tiles add up to less than 1024 after these moves
+    HOST_CHECK(Game2048Board::getMaxWeight(board) >= 8);
+
+    return true;
+}
+
+// Check the bitboard of the 2048 game against moves done cell by cell, and benchmark its moves per second and the depth
+// the solver reaches in the budget of a move of the autoplay
+HOST_CHECK_REGISTER(
+    game_2048, "2048",
+    {"moves", host_game_2048_check_moves},
+    {"game_over", host_game_2048_check_game_over},
+    {"moves_per_second", host_game_2048_check_moves_per_second},
+    {"solver", host_game_2048_check_solver}
+);
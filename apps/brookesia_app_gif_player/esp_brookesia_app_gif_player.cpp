@@ -3,7 +3,9 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <cstdio>
 #include "lvgl.h"
+#include "esp_heap_caps.h"
 #include "esp_brookesia.hpp"
 #ifdef ESP_UTILS_LOG_TAG
 #   undef ESP_UTILS_LOG_TAG
@@ -12,6 +14,17 @@
 #include "esp_lib_utils.h"
 #include "esp_brookesia_app_gif_player.hpp"
 
+// 帧缓存在后台任务中解码GIF，LVGL任务只显示解码好的帧；为0时使用lv_gif在LVGL任务中解码
+#define GIF_PLAYER_USE_FRAME_CACHE          (LV_COLOR_DEPTH == 16)
+// 解码帧的PSRAM预算，所有帧都放得下时只解码一次，否则只提前解码几帧
+#define GIF_PLAYER_CACHE_BUDGET             (4 * 1024 * 1024)
+#define GIF_PLAYER_CACHE_TASK_PRIORITY      (5)
+#define GIF_PLAYER_CACHE_TASK_STACK         (8 * 1024)
+// 与GIF显示区域相同的背景色 (0x202020)
+#define GIF_PLAYER_BACKGROUND_RGB565        (0x2104)
+// 下一帧还未解码完成时的重试间隔
+#define GIF_PLAYER_FRAME_RETRY_MS           (5)
+
 using namespace std;
 using namespace esp_brookesia::gui;
 
@@ -20,6 +33,12 @@ LV_IMG_DECLARE(esp_brookesia_app_icon_gif_player_112_112);
 
 namespace esp_brookesia::apps {
 
+// 扫描GIF文件的存储目录
+static const char *const GIF_PLAYER_SCAN_DIRS[] = {
+    "/spiffs/gifs",
+    "/sdcard/gifs",
+};
+
 GifPlayer *GifPlayer::_instance = nullptr;
 
 GifPlayer *GifPlayer::requestInstance(bool use_status_bar, bool use_navigation_bar)
@@ -42,9 +61,12 @@ GifPlayer::GifPlayer(bool use_status_bar, bool use_navigation_bar):
     _status_label(nullptr),
     _is_playing(false),
     _is_paused(false),
-    _loop_enabled(true)
+    _loop_enabled(true),
+    _frame_timer(nullptr),
+    _gif_data(nullptr)
 {
     memset(_current_gif_path, 0, sizeof(_current_gif_path));
+    memset(&_frame_dsc, 0, sizeof(_frame_dsc));
 }
 
 GifPlayer::~GifPlayer()
@@ -84,6 +106,7 @@ bool GifPlayer::close(void)
 
     // 停止播放
     stopGif();
+    _release_gif_file();
 
     return true;
 }
@@ -97,6 +120,19 @@ bool GifPlayer::init(void)
     _is_paused = false;
     _loop_enabled = true;
 
+#if GIF_PLAYER_USE_FRAME_CACHE
+    ESP_UTILS_CHECK_FALSE_RETURN(_frame_cache.begin(GifFrameCache::Config{
+        .budget = GIF_PLAYER_CACHE_BUDGET,
+        .swap_bytes = LV_COLOR_16_SWAP,
+        .background = GIF_PLAYER_BACKGROUND_RGB565,
+        .task_priority = GIF_PLAYER_CACHE_TASK_PRIORITY,
+        .task_stack = GIF_PLAYER_CACHE_TASK_STACK,
+        .task_affinity = -1,
+        .task_stack_in_ext = false,
+        .buffer_in_ext = true,
+    }), false, "启动帧缓存失败");
+#endif
+
     return true;
 }
 
@@ -105,6 +141,9 @@ bool GifPlayer::deinit(void)
     ESP_UTILS_LOGD("销毁GIF播放器");
 
     // 清理资源
+#if GIF_PLAYER_USE_FRAME_CACHE
+    _frame_cache.del();
+#endif
     _instance = nullptr;
 
     return true;
@@ -132,7 +171,11 @@ void GifPlayer::_create_ui(void)
     lv_obj_set_style_radius(_gif_container, 8, 0);
 
     // 创建GIF图像对象
+#if GIF_PLAYER_USE_FRAME_CACHE
+    _gif_img = lv_img_create(_gif_container);
+#else
     _gif_img = lv_gif_create(_gif_container);
+#endif
     lv_obj_center(_gif_img);
 
     // 创建状态标签
@@ -206,18 +249,17 @@ void GifPlayer::_scan_gif_files(void)
     // 清空现有列表
     lv_obj_clean(_file_list);
 
-    // 模拟添加一些GIF文件（实际项目中应该扫描文件系统）
-    const char *sample_gifs[] = {
-        "/spiffs/gifs/sample1.gif",
-        "/spiffs/gifs/sample2.gif", 
-        "/spiffs/gifs/animation.gif",
-        "/sdcard/gifs/demo.gif"
-    };
+    // 扫描存储目录，未挂载的存储会被跳过
+    _playlist.clear();
+    for (const char *dir : GIF_PLAYER_SCAN_DIRS) {
+        _playlist.scan(dir);
+    }
 
-    for (int i = 0; i < sizeof(sample_gifs) / sizeof(sample_gifs[0]); i++) {
-        lv_obj_t *btn = lv_list_add_btn(_file_list, LV_SYMBOL_FILE, sample_gifs[i]);
+    // 按钮的路径在下次扫描前一直有效
+    for (const auto &path : _playlist.getPaths()) {
+        lv_obj_t *btn = lv_list_add_btn(_file_list, LV_SYMBOL_FILE, path.c_str());
         lv_obj_add_event_cb(btn, _file_list_event_cb, LV_EVENT_CLICKED, this);
-        lv_obj_set_user_data(btn, (void*)sample_gifs[i]);
+        lv_obj_set_user_data(btn, (void*)path.c_str());
     }
 
     // 添加提示信息
@@ -261,7 +303,11 @@ void GifPlayer::stopGif(void)
 
     if (_gif_img && _is_playing) {
         // 停止GIF动画
+#if GIF_PLAYER_USE_FRAME_CACHE
+        lv_timer_pause(_frame_timer);
+#else
         lv_gif_stop(_gif_img);
+#endif
         _is_playing = false;
         _is_paused = false;
         
@@ -281,12 +327,20 @@ void GifPlayer::togglePause(void)
 
     if (_is_paused) {
         // 恢复播放
+#if GIF_PLAYER_USE_FRAME_CACHE
+        lv_timer_resume(_frame_timer);
+#else
         lv_gif_restart(_gif_img);
+#endif
         _is_paused = false;
         lv_label_set_text(_status_label, "正在播放");
     } else {
         // 暂停播放
+#if GIF_PLAYER_USE_FRAME_CACHE
+        lv_timer_pause(_frame_timer);
+#else
         lv_gif_stop(_gif_img);
+#endif
         _is_paused = true;
         lv_label_set_text(_status_label, "已暂停");
     }
@@ -306,6 +360,44 @@ bool GifPlayer::_load_gif_file(const char *path)
 {
     ESP_UTILS_LOGD("加载GIF文件: %s", path);
 
+#if GIF_PLAYER_USE_FRAME_CACHE
+    _release_gif_file();
+
+    // 整个文件读入PSRAM，由帧缓存的任务解码
+    FILE *file = fopen(path, "rb");
+    long size = -1;
+    if (file != nullptr) {
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0) {
+            _gif_data = static_cast<uint8_t *>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        }
+        if ((_gif_data != nullptr) && (fread(_gif_data, 1, size, file) != static_cast<size_t>(size))) {
+            _release_gif_file();
+        }
+        fclose(file);
+    }
+    if ((_gif_data == nullptr) || !_frame_cache.setSource(_gif_data, size)) {
+        _release_gif_file();
+        lv_label_set_text_fmt(_status_label, "错误: 无法加载 %s", path);
+        return false;
+    }
+
+    _frame_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    _frame_dsc.header.w = _frame_cache.getWidth();
+    _frame_dsc.header.h = _frame_cache.getHeight();
+    _frame_dsc.data_size = _frame_dsc.header.w * _frame_dsc.header.h * LV_COLOR_SIZE / 8;
+    _frame_dsc.data = nullptr;
+    if (_frame_timer == nullptr) {
+        _frame_timer = lv_timer_create(_frame_timer_cb, GIF_PLAYER_FRAME_RETRY_MS, this);
+    } else {
+        lv_timer_set_period(_frame_timer, GIF_PLAYER_FRAME_RETRY_MS);
+        lv_timer_resume(_frame_timer);
+    }
+
+    return true;
+#else
     // 实际项目中，这里应该从文件系统加载GIF文件
     // 由于演示目的，我们使用预编译的资源
     
@@ -316,6 +408,21 @@ bool GifPlayer::_load_gif_file(const char *path)
     lv_label_set_text_fmt(_status_label, "错误: 无法加载 %s", path);
     
     return false; // 演示中返回false，实际实现中应该返回真实状态
+#endif
+}
+
+void GifPlayer::_release_gif_file(void)
+{
+#if GIF_PLAYER_USE_FRAME_CACHE
+    if (_frame_timer != nullptr) {
+        lv_timer_del(_frame_timer);
+        _frame_timer = nullptr;
+    }
+    // 先停止解码，再释放文件数据
+    _frame_cache.setSource(nullptr, 0);
+    heap_caps_free(_gif_data);
+    _gif_data = nullptr;
+#endif
 }
 
 void GifPlayer::_update_button_state(void)
@@ -375,4 +482,30 @@ void GifPlayer::_file_list_event_cb(lv_event_t *e)
     }
 }
 
+void GifPlayer::_frame_timer_cb(lv_timer_t *timer)
+{
+    GifPlayer *app = (GifPlayer*)timer->user_data;
+    GifFrameCache::Frame frame = {};
+
+    if (!app->_frame_cache.takeNextFrame(frame)) {
+        // 下一帧还未解码完成，稍后重试
+        lv_timer_set_period(timer, GIF_PLAYER_FRAME_RETRY_MS);
+        return;
+    }
+
+    // 上一帧的缓冲区可能被解码覆盖，图像只引用新的一帧
+    app->_frame_dsc.data = reinterpret_cast<const uint8_t *>(frame.data);
+    lv_img_cache_invalidate_src(&app->_frame_dsc);
+    lv_img_set_src(app->_gif_img, &app->_frame_dsc);
+    lv_obj_invalidate(app->_gif_img);
+    lv_timer_set_period(timer, frame.delay_ms);
+
+    // 不循环时停在最后一帧
+    if (!app->_loop_enabled && (frame.index == app->_frame_cache.getFrameNum() - 1)) {
+        lv_timer_pause(timer);
+        app->_is_playing = false;
+        app->_update_button_state();
+    }
+}
+
 } // namespace esp_brookesia::apps
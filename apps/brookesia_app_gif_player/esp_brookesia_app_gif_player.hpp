@@ -6,6 +6,8 @@
 #pragma once
 
 #include "systems/phone/esp_brookesia_phone_app.hpp"
+#include "esp_brookesia_app_gif_player_cache.hpp"
+#include "esp_brookesia_app_gif_player_playlist.hpp"
 
 namespace esp_brookesia::apps {
 
@@ -131,10 +133,18 @@ private:
     bool _loop_enabled;           // 是否循环播放
     char _current_gif_path[256];  // 当前GIF文件路径
 
+    // 帧缓存播放
+    GifFrameCache _frame_cache;   // 后台解码的帧缓存
+    GifPlaylist _playlist;        // 扫描存储目录得到的播放列表
+    lv_timer_t *_frame_timer;     // 按帧延时显示下一帧的定时器
+    lv_img_dsc_t _frame_dsc;      // 当前帧的图像描述
+    uint8_t *_gif_data;           // 当前GIF文件的数据
+
     // 回调函数
     static void _play_btn_event_cb(lv_event_t *e);
     static void _loop_btn_event_cb(lv_event_t *e);
     static void _file_list_event_cb(lv_event_t *e);
+    static void _frame_timer_cb(lv_timer_t *timer);
 
     // 内部方法
     void _create_ui(void);
@@ -143,6 +153,7 @@ private:
     void _update_button_state(void);
     void _scan_gif_files(void);
     bool _load_gif_file(const char *path);
+    void _release_gif_file(void);
 };
 
 } // namespace esp_brookesia::apps
@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "esp_heap_caps.h"
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:GifPlayer:Cache"
+#include "esp_lib_utils.h"
+#include "esp_brookesia_app_gif_player_cache.hpp"
+
+#define CACHE_THREAD_NAME           "gif_cache"
+#define CACHE_SLOT_NUM_MIN          (2)
+
+namespace esp_brookesia::apps {
+
+GifFrameCache::~GifFrameCache()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_is_begun && !del()) {
+        ESP_UTILS_LOGE("Delete failed");
+    }
+}
+
+bool GifFrameCache::begin(const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_begun, false, "Already begun");
+
+    _config = config;
+    _thread_need_exit = false;
+    {
+        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+            .name = CACHE_THREAD_NAME,
+            .core_id = config.task_affinity,
+            .priority = static_cast<size_t>(config.task_priority),
+            .stack_size = static_cast<size_t>(config.task_stack),
+            .stack_in_ext = config.task_stack_in_ext,
+        });
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            _thread = boost::thread([this] { run(); }), false, "Create thread failed"
+        );
+    }
+    _is_begun = true;
+
+    return true;
+}
+
+bool GifFrameCache::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    {
+        std::lock_guard lock(_mutex);
+        _thread_need_exit = true;
+        _cv.notify_all();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    freeBuffers();
+    _is_begun = false;
+
+    return true;
+}
+
+bool GifFrameCache::setSource(const void *data, size_t length)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::unique_lock lock(_mutex);
+    // The frame being decoded writes the buffers
+    _cv.wait(lock, [this] {
+        return !_is_decoding;
+    });
+    freeBuffers();
+    if (data == nullptr) {
+        return true;
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _decoder.begin(data, length, _config.swap_bytes, _config.background), false, "Invalid GIF data"
+    );
+    int frame_num = _decoder.getFrameNum();
+    size_t frame_pixels = static_cast<size_t>(_decoder.getWidth()) * _decoder.getHeight();
+    int slot_num = std::max(static_cast<int>(_config.budget / (frame_pixels * sizeof(uint16_t))), CACHE_SLOT_NUM_MIN);
+    bool is_resident = (slot_num >= frame_num);
+    if (is_resident) {
+        slot_num = frame_num;
+    }
+
+    uint32_t caps = (_config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    _canvas = static_cast<uint16_t *>(heap_caps_malloc(frame_pixels * sizeof(uint16_t), caps));
+    ESP_UTILS_CHECK_NULL_RETURN(_canvas, false, "Allocate canvas failed");
+    _slot_buffer = static_cast<uint16_t *>(heap_caps_malloc(frame_pixels * slot_num * sizeof(uint16_t), caps));
+    if (_slot_buffer == nullptr) {
+        ESP_UTILS_LOGE("Allocate %d frames failed", slot_num);
+        freeBuffers();
+        return false;
+    }
+    _slots.assign(slot_num, Slot{0, 0});
+    _frame_pixels = frame_pixels;
+    _frame_num = frame_num;
+    _is_resident = is_resident;
+    ESP_UTILS_LOGI(
+        "Source(%dx%d, %d frames): %s, %d frames cached", _decoder.getWidth(), _decoder.getHeight(), frame_num,
+        is_resident ? "resident" : "streamed", slot_num
+    );
+    _cv.notify_all();
+
+    return true;
+}
+
+bool GifFrameCache::takeNextFrame(Frame &frame)
+{
+    std::lock_guard lock(_mutex);
+
+    if (_frame_num == 0) {
+        return false;
+    }
+
+    // The resident frames are decoded in order during the first loop, and kept after
+    uint32_t sequence = _taken_num;
+    int slot = _is_resident ? static_cast<int>(sequence % _frame_num) : static_cast<int>(sequence % _slots.size());
+    bool is_decoded = _is_resident ? (static_cast<uint32_t>(slot) < _decoded_num) : (sequence < _decoded_num);
+    if (!is_decoded) {
+        _stats.underruns++;
+        return false;
+    }
+    if (_is_resident && (sequence >= static_cast<uint32_t>(_frame_num))) {
+        _stats.reused++;
+    }
+
+    frame.data = _slot_buffer + slot * _frame_pixels;
+    frame.index = _slots[slot].index;
+    frame.delay_ms = _slots[slot].delay_ms;
+    _taken_num++;
+    _cv.notify_all();
+
+    return true;
+}
+
+void GifFrameCache::getStats(Stats &stats)
+{
+    std::lock_guard lock(_mutex);
+    stats = _stats;
+}
+
+void GifFrameCache::run()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_lock lock(_mutex);
+    while (!_thread_need_exit) {
+        if (!canDecode()) {
+            _cv.wait(lock);
+            continue;
+        }
+
+        // The slot of the next frame is not shown, so it is written without the lock
+        uint32_t sequence = _decoded_num;
+        int slot = static_cast<int>(sequence % _slots.size());
+        uint16_t *data = _slot_buffer + slot * _frame_pixels;
+        _is_decoding = true;
+        lock.unlock();
+
+        auto start_time = Clock::now();
+        int index = 0;
+        if (!_decoder.decodeNext(_canvas, index)) {
+            // The frame is still shown with what could be decoded
+            ESP_UTILS_LOGE("Decode frame(%d) failed", index);
+        }
+        memcpy(data, _canvas, _frame_pixels * sizeof(uint16_t));
+        auto decode_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_time).count();
+
+        lock.lock();
+        _is_decoding = false;
+        _slots[slot] = {index, _decoder.getFrameDelay(index)};
+        _decoded_num++;
+        _stats.decoded++;
+        _stats.decode_us += decode_us;
+        _cv.notify_all();
+    }
+}
+
+bool GifFrameCache::canDecode() const
+{
+    if (_frame_num == 0) {
+        return false;
+    }
+    if (_is_resident) {
+        return _decoded_num < static_cast<uint32_t>(_frame_num);
+    }
+
+    // The frame taken last is still shown
+    uint32_t shown_num = (_taken_num > 0) ? (_taken_num - 1) : 0;
+
+    return _decoded_num < shown_num + _slots.size();
+}
+
+void GifFrameCache::freeBuffers()
+{
+    heap_caps_free(_canvas);
+    _canvas = nullptr;
+    heap_caps_free(_slot_buffer);
+    _slot_buffer = nullptr;
+    _slots.clear();
+    _frame_pixels = 0;
+    _frame_num = 0;
+    _is_resident = false;
+    _decoded_num = 0;
+    _taken_num = 0;
+}
+
+} // namespace esp_brookesia::apps
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "boost/thread.hpp"
+#include "esp_brookesia_app_gif_player_decoder.hpp"
+
+namespace esp_brookesia::apps {
+
+/**
+ * @brief Cache of the decoded frames of a GIF, filled by a task of its own so the LVGL task only shows them
+ *
+ * When all the frames fit in the budget, they are decoded once and shown again at every loop. Otherwise the budget is
+ * a ring of frames decoded ahead of the one shown, which are decoded again at every loop.
+ */
+class GifFrameCache {
+public:
+    struct Config {
+        size_t budget;              // Bytes of the decoded frames, at least 2 frames are used whatever the budget
+        bool swap_bytes;
+        uint16_t background;
+        int task_priority;
+        int task_stack;
+        int task_affinity;
+        bool task_stack_in_ext;
+        bool buffer_in_ext;
+    };
+
+    struct Frame {
+        const uint16_t *data;
+        int index;
+        uint32_t delay_ms;
+    };
+
+    struct Stats {
+        uint32_t decoded;           // Frames decoded
+        uint32_t reused;            // Frames shown again from the cache, without decoding them
+        uint32_t underruns;         // Frames asked before being decoded
+        uint64_t decode_us;         // Time spent decoding
+    };
+
+    GifFrameCache() = default;
+    ~GifFrameCache();
+
+    GifFrameCache(const GifFrameCache &) = delete;
+    GifFrameCache &operator=(const GifFrameCache &) = delete;
+
+    bool begin(const Config &config);
+    bool del();
+
+    /**
+     * @brief Set the GIF to decode, or none with `nullptr`. The frames of the previous one are dropped
+     *
+     * @param data    File data, which must stay valid until another GIF is set
+     * @param length  File length
+     */
+    bool setSource(const void *data, size_t length);
+
+    /**
+     * @brief Take the next frame to show if it is decoded, without waiting. The frame taken before can be decoded
+     *        over, so it must not be shown anymore
+     */
+    bool takeNextFrame(Frame &frame);
+
+    bool isResident() const
+    {
+        return _is_resident;
+    }
+
+    int getWidth() const
+    {
+        return _decoder.getWidth();
+    }
+
+    int getHeight() const
+    {
+        return _decoder.getHeight();
+    }
+
+    int getFrameNum() const
+    {
+        return _frame_num;
+    }
+
+    void getStats(Stats &stats);
+
+private:
+    struct Slot {
+        int index;
+        uint32_t delay_ms;
+    };
+
+    void run();
+    bool canDecode() const;
+    void freeBuffers();
+
+    bool _is_begun = false;
+    Config _config = {};
+    GifDecoder _decoder;
+    uint16_t *_canvas = nullptr;
+    uint16_t *_slot_buffer = nullptr;
+    std::vector<Slot> _slots;
+    size_t _frame_pixels = 0;
+    int _frame_num = 0;
+    bool _is_resident = false;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _is_decoding = false;
+    uint32_t _decoded_num = 0;      // Frames decoded since the source was set
+    uint32_t _taken_num = 0;        // Frames taken since the source was set
+    Stats _stats = {};
+
+    std::atomic<bool> _thread_need_exit = false;
+    boost::thread _thread;
+};
+
+} // namespace esp_brookesia::apps
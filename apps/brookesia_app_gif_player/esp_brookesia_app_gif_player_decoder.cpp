@@ -0,0 +1,360 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:GifPlayer:Decoder"
+#include "esp_lib_utils.h"
+#include "esp_brookesia_app_gif_player_decoder.hpp"
+
+#define HEADER_SIZE                 (13)
+#define IMAGE_DESCRIPTOR_SIZE       (9)
+#define BLOCK_EXTENSION             (0x21)
+#define BLOCK_IMAGE                 (0x2C)
+#define BLOCK_TRAILER               (0x3B)
+#define EXTENSION_GRAPHIC_CONTROL   (0xF9)
+
+namespace esp_brookesia::apps {
+
+static uint16_t read_u16(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static uint16_t to_rgb565(uint8_t r, uint8_t g, uint8_t b, bool swap_bytes)
+{
+    uint16_t color = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+
+    return swap_bytes ? static_cast<uint16_t>((color >> 8) | (color << 8)) : color;
+}
+
+bool GifDecoder::begin(const void *data, size_t length, bool swap_bytes, uint16_t background)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+    ESP_UTILS_CHECK_FALSE_RETURN(length >= HEADER_SIZE, false, "Invalid length(%d)", static_cast<int>(length));
+
+    _data = static_cast<const uint8_t *>(data);
+    _length = length;
+    _frames.clear();
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (memcmp(_data, "GIF87a", 6) == 0) || (memcmp(_data, "GIF89a", 6) == 0), false, "Invalid signature"
+    );
+
+    _swap_bytes = swap_bytes;
+    _background = swap_bytes ? static_cast<uint16_t>((background >> 8) | (background << 8)) : background;
+    _width = read_u16(_data + 6);
+    _height = read_u16(_data + 8);
+    ESP_UTILS_CHECK_FALSE_RETURN((_width > 0) && (_height > 0), false, "Invalid size(%dx%d)", _width, _height);
+
+    uint8_t flags = _data[10];
+    _global_color_num = (flags & 0x80) ? (2 << (flags & 0x07)) : 0;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        static_cast<size_t>(HEADER_SIZE + _global_color_num * 3) <= _length, false, "Invalid global palette"
+    );
+    memset(_global_palette, 0, sizeof(_global_palette));
+    loadPalette(HEADER_SIZE, _global_color_num, _global_palette);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(indexFrames(), false, "Index frames failed");
+    rewind();
+
+    return true;
+}
+
+void GifDecoder::rewind()
+{
+    _next_frame = 0;
+    _need_clear = true;
+    _last_disposal = DISPOSAL_NONE;
+}
+
+bool GifDecoder::decodeNext(uint16_t *canvas, int &index)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(canvas, false, "Invalid canvas");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_frames.empty(), false, "No frame");
+
+    if (_next_frame >= getFrameNum()) {
+        rewind();
+    }
+    if (_need_clear) {
+        std::fill(canvas, canvas + _width * _height, _background);
+        _need_clear = false;
+    } else {
+        disposeFrame(canvas);
+    }
+
+    index = _next_frame++;
+    ESP_UTILS_CHECK_FALSE_RETURN(decodeImage(_frames[index], canvas), false, "Decode frame(%d) failed", index);
+
+    return true;
+}
+
+uint32_t GifDecoder::getFrameDelay(int index) const
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (index >= 0) && (index < getFrameNum()), FRAME_DELAY_DEFAULT_MS, "Invalid index(%d)", index
+    );
+
+    return _frames[index].delay_ms;
+}
+
+bool GifDecoder::indexFrames()
+{
+    size_t offset = HEADER_SIZE + _global_color_num * 3;
+    Frame frame = {0, FRAME_DELAY_DEFAULT_MS, DISPOSAL_NONE, -1};
+
+    while (offset < _length) {
+        uint8_t block = _data[offset++];
+        if (block == BLOCK_TRAILER) {
+            break;
+        }
+        if (block == BLOCK_EXTENSION) {
+            ESP_UTILS_CHECK_FALSE_RETURN(offset < _length, false, "Truncated extension");
+            uint8_t label = _data[offset++];
+            // The graphic control extension applies to the next image
+            if ((label == EXTENSION_GRAPHIC_CONTROL) && (offset + 5 <= _length) && (_data[offset] >= 4)) {
+                uint8_t flags = _data[offset + 1];
+                uint16_t delay_cs = read_u16(_data + offset + 2);
+                uint8_t disposal = (flags >> 2) & 0x07;
+                frame.delay_ms = (delay_cs > 1) ? delay_cs * 10 : FRAME_DELAY_DEFAULT_MS;
+                frame.disposal = (disposal <= DISPOSAL_PREVIOUS) ? static_cast<Disposal>(disposal) : DISPOSAL_NONE;
+                frame.transparent_index = (flags & 0x01) ? _data[offset + 4] : -1;
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(skipSubBlocks(offset), false, "Truncated extension");
+            continue;
+        }
+        if (block != BLOCK_IMAGE) {
+            ESP_UTILS_LOGW("Unknown block(0x%02x) at %d, stop", block, static_cast<int>(offset - 1));
+            break;
+        }
+
+        ESP_UTILS_CHECK_FALSE_RETURN(offset + IMAGE_DESCRIPTOR_SIZE < _length, false, "Truncated image");
+        uint8_t flags = _data[offset + 8];
+        int local_color_num = (flags & 0x80) ? (2 << (flags & 0x07)) : 0;
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (local_color_num > 0) || (_global_color_num > 0), false, "No palette for frame(%d)", getFrameNum()
+        );
+        frame.offset = offset;
+        offset += IMAGE_DESCRIPTOR_SIZE + local_color_num * 3 + 1;
+        if (!skipSubBlocks(offset)) {
+            // Keep the frames before a truncated one
+            ESP_UTILS_LOGW("Truncated image data of frame(%d)", getFrameNum());
+            break;
+        }
+        _frames.push_back(frame);
+        frame = {0, FRAME_DELAY_DEFAULT_MS, DISPOSAL_NONE, -1};
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(!_frames.empty(), false, "No frame");
+
+    return true;
+}
+
+bool GifDecoder::skipSubBlocks(size_t &offset) const
+{
+    while (offset < _length) {
+        uint8_t size = _data[offset++];
+        if (size == 0) {
+            return true;
+        }
+        offset += size;
+    }
+
+    return false;
+}
+
+void GifDecoder::loadPalette(size_t offset, int color_num, uint16_t palette[PALETTE_COLOR_MAX]) const
+{
+    const uint8_t *colors = _data + offset;
+
+    for (int i = 0; i < color_num; i++) {
+        palette[i] = to_rgb565(colors[i * 3], colors[i * 3 + 1], colors[i * 3 + 2], _swap_bytes);
+    }
+}
+
+void GifDecoder::disposeFrame(uint16_t *canvas)
+{
+    const Rect &rect = _last_rect;
+
+    if (_last_disposal == DISPOSAL_BACKGROUND) {
+        for (int y = rect.y; y < rect.y + rect.height; y++) {
+            std::fill_n(canvas + y * _width + rect.x, rect.width, _background);
+        }
+    } else if (_last_disposal == DISPOSAL_PREVIOUS) {
+        for (int y = 0; y < rect.height; y++) {
+            memcpy(
+                canvas + (rect.y + y) * _width + rect.x, _previous.data() + y * rect.width,
+                rect.width * sizeof(uint16_t)
+            );
+        }
+    }
+    _last_disposal = DISPOSAL_NONE;
+}
+
+bool GifDecoder::decodeImage(const Frame &frame, uint16_t *canvas)
+{
+    const uint8_t *descriptor = _data + frame.offset;
+    int frame_x = read_u16(descriptor);
+    int frame_y = read_u16(descriptor + 2);
+    int frame_width = read_u16(descriptor + 4);
+    int frame_height = read_u16(descriptor + 6);
+    uint8_t flags = descriptor[8];
+    bool is_interlaced = flags & 0x40;
+    int local_color_num = (flags & 0x80) ? (2 << (flags & 0x07)) : 0;
+    const uint16_t *palette = _global_palette;
+    if (local_color_num > 0) {
+        memset(_local_palette, 0, sizeof(_local_palette));
+        loadPalette(frame.offset + IMAGE_DESCRIPTOR_SIZE, local_color_num, _local_palette);
+        palette = _local_palette;
+    }
+
+    // Only the part of the frame on the canvas is drawn, and disposed after
+    _last_rect.x = std::min(frame_x, _width);
+    _last_rect.y = std::min(frame_y, _height);
+    _last_rect.width = std::min(frame_width, _width - _last_rect.x);
+    _last_rect.height = std::min(frame_height, _height - _last_rect.y);
+    _last_disposal = frame.disposal;
+    if (_last_disposal == DISPOSAL_PREVIOUS) {
+        _previous.resize(_last_rect.width * _last_rect.height);
+        for (int y = 0; y < _last_rect.height; y++) {
+            memcpy(
+                _previous.data() + y * _last_rect.width, canvas + (_last_rect.y + y) * _width + _last_rect.x,
+                _last_rect.width * sizeof(uint16_t)
+            );
+        }
+    }
+
+    size_t offset = frame.offset + IMAGE_DESCRIPTOR_SIZE + local_color_num * 3;
+    int min_code_size = _data[offset++];
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (min_code_size >= 1) && (min_code_size < LZW_CODE_BITS_MAX), false, "Invalid code size(%d)", min_code_size
+    );
+
+    // Reader of the codes, whose bits are split in sub-blocks
+    size_t block_remain = 0;
+    uint32_t bits = 0;
+    int bit_num = 0;
+    auto read_code = [&](int code_size) -> int {
+        while (bit_num < code_size)
+        {
+            if (block_remain == 0) {
+                if ((offset >= _length) || (_data[offset] == 0)) {
+                    return -1;
+                }
+                block_remain = _data[offset++];
+            }
+            if (offset >= _length) {
+                return -1;
+            }
+            bits |= static_cast<uint32_t>(_data[offset++]) << bit_num;
+            bit_num += 8;
+            block_remain--;
+        }
+        int code = bits & ((1 << code_size) - 1);
+        bits >>= code_size;
+        bit_num -= code_size;
+        return code;
+    };
+
+    // Writer of the pixels, whose rows may be interlaced
+    static const int interlace_start[] = {0, 4, 2, 1};
+    static const int interlace_step[] = {8, 8, 4, 2};
+    int pass = 0;
+    int row = 0;
+    int column = 0;
+    int pixel_remain = frame_width * frame_height;
+    uint16_t *canvas_row = (row < _last_rect.height) ? (canvas + (_last_rect.y + row) * _width + _last_rect.x) : nullptr;
+    int transparent_index = frame.transparent_index;
+    auto write_pixel = [&](uint8_t index) {
+        if ((canvas_row != nullptr) && (column < _last_rect.width) && (index != transparent_index)) {
+            canvas_row[column] = palette[index];
+        }
+        pixel_remain--;
+        if (++column < frame_width) {
+            return;
+        }
+        column = 0;
+        if (is_interlaced) {
+            row += interlace_step[pass];
+            while ((row >= frame_height) && (pass < 3)) {
+                pass++;
+                row = interlace_start[pass];
+            }
+        } else {
+            row++;
+        }
+        canvas_row = (row < _last_rect.height) ? (canvas + (_last_rect.y + row) * _width + _last_rect.x) : nullptr;
+    };
+
+    int clear_code = 1 << min_code_size;
+    int end_code = clear_code + 1;
+    int code_size = min_code_size + 1;
+    int next_code = clear_code + 2;
+    int old_code = -1;
+    for (int i = 0; i < clear_code; i++) {
+        _suffix[i] = i;
+        _first[i] = i;
+    }
+    while (pixel_remain > 0) {
+        int code = read_code(code_size);
+        if ((code < 0) || (code == end_code)) {
+            break;
+        }
+        if (code == clear_code) {
+            code_size = min_code_size + 1;
+            next_code = clear_code + 2;
+            old_code = -1;
+            continue;
+        }
+        if (old_code < 0) {
+            if (code > clear_code) {
+                ESP_UTILS_LOGW("Invalid first code(%d)", code);
+                break;
+            }
+            write_pixel(code);
+            old_code = code;
+            continue;
+        }
+        if (code > next_code) {
+            ESP_UTILS_LOGW("Invalid code(%d), next(%d)", code, next_code);
+            break;
+        }
+
+        // The string of the code is unwound on the stack from its last pixel
+        int stack_size = 0;
+        int string_code = code;
+        if (code == next_code) {
+            _stack[stack_size++] = _first[old_code];
+            string_code = old_code;
+        }
+        while (string_code >= clear_code) {
+            _stack[stack_size++] = _suffix[string_code];
+            string_code = _prefix[string_code];
+        }
+        _stack[stack_size++] = string_code;
+
+        if (next_code < (1 << LZW_CODE_BITS_MAX)) {
+            _prefix[next_code] = old_code;
+            _suffix[next_code] = string_code;
+            _first[next_code] = _first[old_code];
+            next_code++;
+            if ((next_code == (1 << code_size)) && (code_size < LZW_CODE_BITS_MAX)) {
+                code_size++;
+            }
+        }
+        while ((stack_size > 0) && (pixel_remain > 0)) {
+            write_pixel(_stack[--stack_size]);
+        }
+        old_code = code;
+    }
+    if (pixel_remain > 0) {
+        ESP_UTILS_LOGD("Frame ended with %d pixels missing", pixel_remain);
+    }
+
+    return true;
+}
+
+} // namespace esp_brookesia::apps
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esp_brookesia::apps {
+
+/**
+ * @brief Decoder of the GIF files, which doesn't need LVGL so the frames can be decoded out of the LVGL task
+ *
+ * The frames are composed in order into a RGB565 canvas of the whole animation, with their transparency and disposal
+ * methods, so the canvas must be kept between the calls. The file is indexed once by `begin()`, which only walks the
+ * blocks of the file without decoding them.
+ */
+class GifDecoder {
+public:
+    static constexpr int LZW_CODE_BITS_MAX = 12;
+    static constexpr int PALETTE_COLOR_MAX = 256;
+    // Delay of the frames without one, or with one too short to be honored by the browsers
+    static constexpr uint32_t FRAME_DELAY_DEFAULT_MS = 100;
+
+    enum Disposal : uint8_t {
+        DISPOSAL_NONE = 0,
+        DISPOSAL_KEEP,
+        DISPOSAL_BACKGROUND,
+        DISPOSAL_PREVIOUS,
+    };
+
+    /**
+     * @brief Check the header of the file, index its frames, and reset the decoding
+     *
+     * @param data        File data, which must stay valid while decoding
+     * @param length      File length
+     * @param swap_bytes  Swap the bytes of the output RGB565 pixels
+     * @param background  RGB565 color of the canvas before the first frame, and of the areas disposed to the
+     *                    background, not swapped
+     */
+    bool begin(const void *data, size_t length, bool swap_bytes, uint16_t background = 0);
+
+    /**
+     * @brief Start again from the first frame, the canvas is cleared by its next decoding
+     */
+    void rewind();
+
+    /**
+     * @brief Decode the next frame into the canvas, and start again after the last one
+     *
+     * @param canvas  Buffer of `getWidth() * getHeight()` pixels, kept between the calls
+     * @param index   Index of the decoded frame
+     */
+    bool decodeNext(uint16_t *canvas, int &index);
+
+    int getWidth() const
+    {
+        return _width;
+    }
+
+    int getHeight() const
+    {
+        return _height;
+    }
+
+    int getFrameNum() const
+    {
+        return static_cast<int>(_frames.size());
+    }
+
+    uint32_t getFrameDelay(int index) const;
+
+private:
+    struct Frame {
+        uint32_t offset;            // Offset of the image descriptor
+        uint32_t delay_ms;
+        Disposal disposal;
+        int16_t transparent_index;  // -1 without transparency
+    };
+
+    struct Rect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    bool indexFrames();
+    bool skipSubBlocks(size_t &offset) const;
+    void loadPalette(size_t offset, int color_num, uint16_t palette[PALETTE_COLOR_MAX]) const;
+    void disposeFrame(uint16_t *canvas);
+    bool decodeImage(const Frame &frame, uint16_t *canvas);
+
+    const uint8_t *_data = nullptr;
+    size_t _length = 0;
+    bool _swap_bytes = false;
+    uint16_t _background = 0;
+    int _width = 0;
+    int _height = 0;
+    int _global_color_num = 0;
+    std::vector<Frame> _frames;
+    uint16_t _global_palette[PALETTE_COLOR_MAX] = {};
+    uint16_t _local_palette[PALETTE_COLOR_MAX] = {};
+
+    // State of the composition, between the frames
+    int _next_frame = 0;
+    bool _need_clear = true;
+    Disposal _last_disposal = DISPOSAL_NONE;
+    Rect _last_rect = {};
+    std::vector<uint16_t> _previous;    // Area under the last frame, only for `DISPOSAL_PREVIOUS`
+
+    // Tables of the LZW codes
+    uint16_t _prefix[1 << LZW_CODE_BITS_MAX] = {};
+    uint8_t _suffix[1 << LZW_CODE_BITS_MAX] = {};
+    uint8_t _first[1 << LZW_CODE_BITS_MAX] = {};
+    uint8_t _stack[1 << LZW_CODE_BITS_MAX] = {};
+};
+
+} // namespace esp_brookesia::apps
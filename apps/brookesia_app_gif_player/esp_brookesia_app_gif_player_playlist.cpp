@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <strings.h>
+#include <sys/stat.h>
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:GifPlayer:Playlist"
+#include "esp_lib_utils.h"
+#include "esp_brookesia_app_gif_player_playlist.hpp"
+
+#define GIF_EXTENSION       ".gif"
+
+namespace esp_brookesia::apps {
+
+bool GifPlaylist::scan(const char *dir)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(dir, false, "Invalid dir");
+
+    DIR *handle = opendir(dir);
+    if (handle == nullptr) {
+        ESP_UTILS_LOGD("Open dir(%s) failed", dir);
+        return false;
+    }
+
+    std::vector<std::string> paths;
+    size_t extension_len = strlen(GIF_EXTENSION);
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(handle)) != nullptr) {
+        size_t name_len = strlen(entry->d_name);
+        if ((name_len <= extension_len) ||
+                (strcasecmp(entry->d_name + name_len - extension_len, GIF_EXTENSION) != 0)) {
+            continue;
+        }
+        std::string path = std::string(dir) + "/" + entry->d_name;
+        // The type of the entries is unknown on some file systems
+        struct stat info;
+        if ((stat(path.c_str(), &info) != 0) || !S_ISREG(info.st_mode)) {
+            continue;
+        }
+        paths.push_back(std::move(path));
+    }
+    closedir(handle);
+
+    std::sort(paths.begin(), paths.end());
+    ESP_UTILS_LOGD("Found %d GIF files in dir(%s)", static_cast<int>(paths.size()), dir);
+    _paths.insert(_paths.end(), paths.begin(), paths.end());
+
+    return true;
+}
+
+} // namespace esp_brookesia::apps
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace esp_brookesia::apps {
+
+/**
+ * @brief Playlist of the GIF files found in the storage directories
+ */
+class GifPlaylist {
+public:
+    /**
+     * @brief Add the GIF files of a directory, sorted by name. The sub-directories are not scanned
+     *
+     * @return false if the directory can't be opened, like a storage which is not mounted
+     */
+    bool scan(const char *dir);
+
+    void clear()
+    {
+        _paths.clear();
+    }
+
+    const std::vector<std::string> &getPaths() const
+    {
+        return _paths;
+    }
+
+private:
+    std::vector<std::string> _paths;
+};
+
+} // namespace esp_brookesia::apps
@@ -0,0 +1,530 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "esp_log.h"
+#include "esp_brookesia_app_gif_player_cache.hpp"
+#include "esp_brookesia_app_gif_player_decoder.hpp"
+#include "esp_brookesia_app_gif_player_playlist.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::apps::GifDecoder;
+using esp_brookesia::apps::GifFrameCache;
+using esp_brookesia::apps::GifPlaylist;
+
+#define HOST_GIF_BACKGROUND         (0x18E3)
+// Animation of the benchmark, full frames like most GIFs found online
+#define HOST_GIF_BENCH_SIZE         (240)
+#define HOST_GIF_BENCH_FRAME_NUM    (24)
+#define HOST_GIF_BENCH_DELAY_CS     (4)
+#define HOST_GIF_LOOP_NUM           (3)
+// Budget of the frames streamed ahead
+#define HOST_GIF_STREAM_FRAME_NUM   (4)
+#define HOST_GIF_TAKE_TIMEOUT_MS    (2000)
+
+static const char *TAG = "host_gif_player";
+
+struct HostGifFrame {
+    int x;
+    int y;
+    int width;
+    int height;
+    int delay_cs;
+    int disposal;
+    int transparent_index;          // -1 without transparency
+    bool is_interlaced;
+    std::vector<uint32_t> local_palette;
+    std::vector<uint8_t> indexes;
+};
+
+struct HostGif {
+    int width;
+    int height;
+    std::vector<uint32_t> palette;
+    std::vector<HostGifFrame> frames;
+};
+
+static int host_gif_palette_bits(size_t color_num)
+{
+    int bits = 1;
+    while ((1U << bits) < color_num) {
+        bits++;
+    }
+
+    return bits;
+}
+
+static void host_gif_put_u16(std::vector<uint8_t> &out, int value)
+{
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void host_gif_put_palette(std::vector<uint8_t> &out, const std::vector<uint32_t> &palette, int bits)
+{
+    for (int i = 0; i < (1 << bits); i++) {
+        uint32_t color = (i < static_cast<int>(palette.size())) ? palette[i] : 0;
+        out.push_back((color >> 16) & 0xFF);
+        out.push_back((color >> 8) & 0xFF);
+        out.push_back(color & 0xFF);
+    }
+}
+
+/* LZW with a dictionary of up to 4096 codes, cleared when it is full */
+static void host_gif_put_lzw(std::vector<uint8_t> &out, const std::vector<uint8_t> &indexes, int min_code_size)
+{
+    std::vector<uint8_t> bytes;
+    uint32_t bits = 0;
+    int bit_num = 0;
+    int code_size = min_code_size + 1;
+    auto put_code = [&](int code) {
+        bits |= static_cast<uint32_t>(code) << bit_num;
+        bit_num += code_size;
+        while (bit_num >= 8) {
+            bytes.push_back(bits & 0xFF);
+            bits >>= 8;
+            bit_num -= 8;
+        }
+    };
+
+    int clear_code = 1 << min_code_size;
+    int next_code = clear_code + 2;
+    std::unordered_map<uint32_t, int> dictionary;
+    put_code(clear_code);
+    int prefix = indexes[0];
+    for (size_t i = 1; i < indexes.size(); i++) {
+        uint32_t key = (static_cast<uint32_t>(prefix) << 8) | indexes[i];
+        auto it = dictionary.find(key);
+        if (it != dictionary.end()) {
+            prefix = it->second;
+            continue;
+        }
+        put_code(prefix);
+        if (next_code < (1 << GifDecoder::LZW_CODE_BITS_MAX)) {
+            dictionary[key] = next_code++;
+            if ((next_code > (1 << code_size)) && (code_size < GifDecoder::LZW_CODE_BITS_MAX)) {
+                code_size++;
+            }
+        } else {
+            put_code(clear_code);
+            dictionary.clear();
+            next_code = clear_code + 2;
+            code_size = min_code_size + 1;
+        }
+        prefix = indexes[i];
+    }
+    put_code(prefix);
+    put_code(clear_code + 1);
+    if (bit_num > 0) {
+        bytes.push_back(bits & 0xFF);
+    }
+
+    out.push_back(min_code_size);
+    for (size_t i = 0; i < bytes.size(); i += 255) {
+        size_t size = std::min<size_t>(255, bytes.size() - i);
+        out.push_back(size);
+        out.insert(out.end(), bytes.begin() + i, bytes.begin() + i + size);
+    }
+    out.push_back(0);
+}
+
+static std::vector<uint8_t> host_gif_encode(const HostGif &gif)
+{
+    std::vector<uint8_t> out = {'G', 'I', 'F', '8', '9', 'a'};
+    int global_bits = host_gif_palette_bits(gif.palette.size());
+
+    host_gif_put_u16(out, gif.width);
+    host_gif_put_u16(out, gif.height);
+    out.push_back(0x80 | (global_bits - 1));
+    out.push_back(0);
+    out.push_back(0);
+    host_gif_put_palette(out, gif.palette, global_bits);
+
+    for (auto &frame : gif.frames) {
+        out.insert(out.end(), {0x21, 0xF9, 0x04});
+        out.push_back((frame.disposal << 2) | ((frame.transparent_index >= 0) ? 0x01 : 0x00));
+        host_gif_put_u16(out, frame.delay_cs);
+        out.push_back((frame.transparent_index >= 0) ? frame.transparent_index : 0);
+        out.push_back(0);
+
+        out.push_back(0x2C);
+        host_gif_put_u16(out, frame.x);
+        host_gif_put_u16(out, frame.y);
+        host_gif_put_u16(out, frame.width);
+        host_gif_put_u16(out, frame.height);
+        int bits = global_bits;
+        uint8_t flags = frame.is_interlaced ? 0x40 : 0x00;
+        if (!frame.local_palette.empty()) {
+            bits = host_gif_palette_bits(frame.local_palette.size());
+            flags |= 0x80 | (bits - 1);
+        }
+        out.push_back(flags);
+        if (!frame.local_palette.empty()) {
+            host_gif_put_palette(out, frame.local_palette, bits);
+        }
+
+        // The pixels are given in display order, the interlaced rows are encoded by pass
+        std::vector<uint8_t> indexes;
+        if (frame.is_interlaced) {
+            const int starts[] = {0, 4, 2, 1};
+            const int steps[] = {8, 8, 4, 2};
+            for (int pass = 0; pass < 4; pass++) {
+                for (int y = starts[pass]; y < frame.height; y += steps[pass]) {
+                    indexes.insert(
+                        indexes.end(), frame.indexes.begin() + y * frame.width,
+                        frame.indexes.begin() + (y + 1) * frame.width
+                    );
+                }
+            }
+        } else {
+            indexes = frame.indexes;
+        }
+        host_gif_put_lzw(out, indexes, std::max(bits, 2));
+    }
+    out.push_back(0x3B);
+
+    return out;
+}
+
+static uint16_t host_gif_rgb565(uint32_t color)
+{
+    return ((color >> 8) & 0xF800) | ((color >> 5) & 0x07E0) | ((color >> 3) & 0x001F);
+}
+
+/* Compose the frames as a browser, to compare with the decoder */
+static std::vector<std::vector<uint16_t>> host_gif_render(const HostGif &gif)
+{
+    std::vector<std::vector<uint16_t>> renders;
+    std::vector<uint16_t> canvas(gif.width * gif.height, HOST_GIF_BACKGROUND);
+
+    for (auto &frame : gif.frames) {
+        auto &palette = frame.local_palette.empty() ? gif.palette : frame.local_palette;
+        std::vector<uint16_t> before = canvas;
+        for (int y = 0; y < frame.height; y++) {
+            for (int x = 0; x < frame.width; x++) {
+                int index = frame.indexes[y * frame.width + x];
+                int canvas_x = frame.x + x;
+                int canvas_y = frame.y + y;
+                if ((canvas_x >= gif.width) || (canvas_y >= gif.height) || (index == frame.transparent_index)) {
+                    continue;
+                }
+                canvas[canvas_y * gif.width + canvas_x] = host_gif_rgb565(palette[index]);
+            }
+        }
+        renders.push_back(canvas);
+
+        if (frame.disposal == GifDecoder::DISPOSAL_PREVIOUS) {
+            canvas = before;
+        } else if (frame.disposal == GifDecoder::DISPOSAL_BACKGROUND) {
+            for (int y = frame.y; y < std::min(frame.y + frame.height, gif.height); y++) {
+                for (int x = frame.x; x < std::min(frame.x + frame.width, gif.width); x++) {
+                    canvas[y * gif.width + x] = HOST_GIF_BACKGROUND;
+                }
+            }
+        }
+    }
+
+    return renders;
+}
+
+static std::vector<uint32_t> host_gif_random_palette(std::mt19937 &random, int color_num)
+{
+    std::vector<uint32_t> palette;
+    for (int i = 0; i < color_num; i++) {
+        palette.push_back(random() & 0xFFFFFF);
+    }
+
+    return palette;
+}
+
+static HostGifFrame host_gif_random_frame(std::mt19937 &random, int x, int y, int width, int height, int color_num)
+{
+    HostGifFrame frame = {x, y, width, height, 5, GifDecoder::DISPOSAL_KEEP, -1, false, {}, {}};
+
+    // Runs of colors, so the codes of the dictionary are used
+    for (int i = 0; i < width * height; i++) {
+        frame.indexes.push_back(((random() % 4) == 0) ? (random() % color_num) :
+                                (frame.indexes.empty() ? 0 : frame.indexes.back()));
+    }
+
+    return frame;
+}
+
+/* Frames with every disposal, transparency, interlacing, a local palette, and one out of the canvas */
+static HostGif host_gif_make_features()
+{
+    std::mt19937 random(1);
+    HostGif gif = {37, 23, host_gif_random_palette(random, 4), {}};
+
+    gif.frames.push_back(host_gif_random_frame(random, 0, 0, 37, 23, 4));
+    auto frame = host_gif_random_frame(random, 5, 3, 20, 10, 8);
+    frame.transparent_index = 2;
+    frame.disposal = GifDecoder::DISPOSAL_BACKGROUND;
+    frame.is_interlaced = true;
+    frame.local_palette = host_gif_random_palette(random, 8);
+    gif.frames.push_back(frame);
+    frame = host_gif_random_frame(random, 30, 15, 10, 10, 4);
+    frame.disposal = GifDecoder::DISPOSAL_PREVIOUS;
+    gif.frames.push_back(frame);
+    frame = host_gif_random_frame(random, 0, 0, 37, 23, 4);
+    frame.transparent_index = 0;
+    frame.delay_cs = 0;
+    frame.disposal = GifDecoder::DISPOSAL_NONE;
+    gif.frames.push_back(frame);
+    // Enough noise to fill the dictionary
+    frame = host_gif_random_frame(random, 0, 0, 37, 23, 4);
+    frame.local_palette = host_gif_random_palette(random, 256);
+    for (auto &index : frame.indexes) {
+        index = random() % 256;
+    }
+    gif.frames.push_back(frame);
+
+    return gif;
+}
+
+static HostGif host_gif_make_bench()
+{
+    std::mt19937 random(2);
+    HostGif gif = {HOST_GIF_BENCH_SIZE, HOST_GIF_BENCH_SIZE, host_gif_random_palette(random, 64), {}};
+
+    for (int t = 0; t < HOST_GIF_BENCH_FRAME_NUM; t++) {
+        HostGifFrame frame = {
+            0, 0, HOST_GIF_BENCH_SIZE, HOST_GIF_BENCH_SIZE, HOST_GIF_BENCH_DELAY_CS, GifDecoder::DISPOSAL_KEEP, -1,
+            false, {}, {}
+        };
+        for (int y = 0; y < HOST_GIF_BENCH_SIZE; y++) {
+            for (int x = 0; x < HOST_GIF_BENCH_SIZE; x++) {
+                int dx = x - HOST_GIF_BENCH_SIZE / 2;
+                int dy = y - HOST_GIF_BENCH_SIZE / 2;
+                int ring = ((dx * dx + dy * dy) / 256 + t) & 0x1F;
+                frame.indexes.push_back(((ring < 16) ? ring : (((x + t * 4) ^ y) >> 3)) & 0x3F);
+            }
+        }
+        gif.frames.push_back(std::move(frame));
+    }
+
+    return gif;
+}
+
+static bool host_gif_check_decode()
+{
+    HostGif gif = host_gif_make_features();
+    std::vector<uint8_t> data = host_gif_encode(gif);
+    auto renders = host_gif_render(gif);
+
+    GifDecoder decoder;
+    HOST_CHECK(decoder.begin(data.data(), data.size(), false, HOST_GIF_BACKGROUND));
+    HOST_CHECK((decoder.getWidth() == gif.width) && (decoder.getHeight() == gif.height));
+    HOST_CHECK(decoder.getFrameNum() == static_cast<int>(gif.frames.size()));
+    HOST_CHECK(decoder.getFrameDelay(0) == 50);
+    HOST_CHECK(decoder.getFrameDelay(3) == GifDecoder::FRAME_DELAY_DEFAULT_MS);
+
+    std::vector<uint16_t> canvas(gif.width * gif.height);
+    for (int i = 0; i < 2 * decoder.getFrameNum(); i++) {
+        int index = -1;
+        HOST_CHECK(decoder.decodeNext(canvas.data(), index));
+        HOST_CHECK(index == i % decoder.getFrameNum());
+        HOST_CHECK(canvas == renders[index]);
+    }
+
+    // The bytes are swapped for the displays which need it
+    HOST_CHECK(decoder.begin(data.data(), data.size(), true, HOST_GIF_BACKGROUND));
+    int index = -1;
+    HOST_CHECK(decoder.decodeNext(canvas.data(), index));
+    HOST_CHECK(canvas[5] == static_cast<uint16_t>((renders[0][5] >> 8) | (renders[0][5] << 8)));
+
+    // Truncated files keep their complete frames, others are refused
+    HOST_CHECK(decoder.begin(data.data(), data.size() - 40, false, HOST_GIF_BACKGROUND));
+    HOST_CHECK(decoder.getFrameNum() == static_cast<int>(gif.frames.size()) - 1);
+    HOST_CHECK(!decoder.begin(data.data(), 20, false, HOST_GIF_BACKGROUND));
+    data[0] = 'X';
+    HOST_CHECK(!decoder.begin(data.data(), data.size(), false, HOST_GIF_BACKGROUND));
+
+    return true;
+}
+
+static bool host_gif_check_decode_time()
+{
+    HostGif gif = host_gif_make_bench();
+    std::vector<uint8_t> data = host_gif_encode(gif);
+    auto renders = host_gif_render(gif);
+
+    GifDecoder decoder;
+    HOST_CHECK(decoder.begin(data.data(), data.size(), false, HOST_GIF_BACKGROUND));
+    std::vector<uint16_t> canvas(gif.width * gif.height);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < HOST_GIF_LOOP_NUM * decoder.getFrameNum(); i++) {
+        int index = -1;
+        HOST_CHECK(decoder.decodeNext(canvas.data(), index));
+        HOST_CHECK(canvas == renders[index]);
+    }
+    auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start
+                      ).count();
+
+    int frame_us = static_cast<int>(elapsed_us / (HOST_GIF_LOOP_NUM * decoder.getFrameNum()));
+    int loop_ms = decoder.getFrameNum() * HOST_GIF_BENCH_DELAY_CS * 10;
+    ESP_LOGI(
+        TAG, "Decode(%dx%d, %d bytes): %d us per frame, %.1f%% of a loop of %d ms decoding every frame",
+        gif.width, gif.height, static_cast<int>(data.size()), frame_us,
+        100.0f * frame_us * decoder.getFrameNum() / (loop_ms * 1000.0f), loop_ms
+    );
+
+    return true;
+}
+
+/* Play the animation without waiting the delays, and return the time spent decoding after the first loop */
+static bool host_gif_play(
+    GifFrameCache &cache, const std::vector<std::vector<uint16_t>> &renders, uint64_t &steady_decode_us
+)
+{
+    int frame_num = cache.getFrameNum();
+    GifFrameCache::Stats stats = {};
+
+    for (int i = 0; i < HOST_GIF_LOOP_NUM * frame_num; i++) {
+        if (i == frame_num) {
+            cache.getStats(stats);
+        }
+        GifFrameCache::Frame frame = {};
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(HOST_GIF_TAKE_TIMEOUT_MS);
+        while (!cache.takeNextFrame(frame)) {
+            HOST_CHECK(std::chrono::steady_clock::now() < deadline);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        HOST_CHECK(frame.index == i % frame_num);
+        HOST_CHECK(frame.delay_ms == HOST_GIF_BENCH_DELAY_CS * 10);
+        HOST_CHECK(memcmp(frame.data, renders[frame.index].data(), renders[frame.index].size() * 2) == 0);
+    }
+    uint64_t first_loop_us = stats.decode_us;
+    cache.getStats(stats);
+    steady_decode_us = stats.decode_us - first_loop_us;
+
+    return true;
+}
+
+static bool host_gif_check_cache()
+{
+    HostGif gif = host_gif_make_bench();
+    std::vector<uint8_t> data = host_gif_encode(gif);
+    auto renders = host_gif_render(gif);
+    size_t frame_size = gif.width * gif.height * sizeof(uint16_t);
+    int loop_ms = HOST_GIF_BENCH_FRAME_NUM * HOST_GIF_BENCH_DELAY_CS * 10;
+
+    GifFrameCache cache;
+    GifFrameCache::Config config = {
+        .budget = frame_size * HOST_GIF_BENCH_FRAME_NUM,
+        .swap_bytes = false,
+        .background = HOST_GIF_BACKGROUND,
+        .task_priority = 1,
+        .task_stack = 8 * 1024,
+        .task_affinity = -1,
+        .task_stack_in_ext = false,
+        .buffer_in_ext = false,
+    };
+    HOST_CHECK(cache.begin(config));
+
+    // All the frames fit, they are only decoded during the first loop
+    HOST_CHECK(cache.setSource(data.data(), data.size()));
+    HOST_CHECK(cache.isResident());
+    uint64_t steady_decode_us = 0;
+    HOST_CHECK(host_gif_play(cache, renders, steady_decode_us));
+    GifFrameCache::Stats stats = {};
+    cache.getStats(stats);
+    HOST_CHECK(stats.decoded == HOST_GIF_BENCH_FRAME_NUM);
+    HOST_CHECK(stats.reused == (HOST_GIF_LOOP_NUM - 1) * HOST_GIF_BENCH_FRAME_NUM);
+    HOST_CHECK(steady_decode_us == 0);
+    ESP_LOGI(
+        TAG, "Cache(resident, %d KB): %d frames decoded for %d shown, %.1f%% of a loop decoding after the first one",
+        static_cast<int>(config.budget / 1024), static_cast<int>(stats.decoded),
+        HOST_GIF_LOOP_NUM * HOST_GIF_BENCH_FRAME_NUM,
+        100.0f * steady_decode_us / ((HOST_GIF_LOOP_NUM - 1) * loop_ms * 1000.0f)
+    );
+
+    // Only a few frames fit, they are decoded ahead of the one shown
+    HOST_CHECK(cache.setSource(nullptr, 0));
+    HOST_CHECK(cache.del());
+    config.budget = frame_size * HOST_GIF_STREAM_FRAME_NUM;
+    HOST_CHECK(cache.begin(config));
+    HOST_CHECK(cache.setSource(data.data(), data.size()));
+    HOST_CHECK(!cache.isResident());
+    GifFrameCache::Stats stats_before = {};
+    cache.getStats(stats_before);
+    HOST_CHECK(host_gif_play(cache, renders, steady_decode_us));
+    cache.getStats(stats);
+    uint32_t decoded = stats.decoded - stats_before.decoded;
+    HOST_CHECK(decoded >= HOST_GIF_LOOP_NUM * HOST_GIF_BENCH_FRAME_NUM);
+    HOST_CHECK(decoded < HOST_GIF_LOOP_NUM * HOST_GIF_BENCH_FRAME_NUM + HOST_GIF_STREAM_FRAME_NUM);
+    ESP_LOGI(
+        TAG, "Cache(streamed, %d KB): %d frames decoded for %d shown, %.1f%% of a loop decoding after the first one",
+        static_cast<int>(config.budget / 1024), static_cast<int>(decoded), HOST_GIF_LOOP_NUM * HOST_GIF_BENCH_FRAME_NUM,
+        100.0f * steady_decode_us / ((HOST_GIF_LOOP_NUM - 1) * loop_ms * 1000.0f)
+    );
+
+    // Another source starts from its first frame
+    HOST_CHECK(cache.setSource(data.data(), data.size()));
+    GifFrameCache::Frame frame = {};
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(HOST_GIF_TAKE_TIMEOUT_MS);
+    while (!cache.takeNextFrame(frame)) {
+        HOST_CHECK(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    HOST_CHECK(frame.index == 0);
+    HOST_CHECK(cache.del());
+
+    return true;
+}
+
+static bool host_gif_check_playlist()
+{
+    char dir[] = "/tmp/host_gif_XXXXXX";
+    HOST_CHECK(mkdtemp(dir) != nullptr);
+    std::string root = dir;
+    for (const char *name : {"b.gif", "A.GIF", "c.txt", "e.gifx", ".gif"}) {
+        FILE *file = fopen((root + "/" + name).c_str(), "w");
+        HOST_CHECK(file != nullptr);
+        fclose(file);
+    }
+    HOST_CHECK(mkdir((root + "/d.gif").c_str(), 0755) == 0);
+
+    GifPlaylist playlist;
+    bool is_scanned = playlist.scan(dir);
+    bool is_missing_scanned = playlist.scan((root + "/missing").c_str());
+    auto paths = playlist.getPaths();
+
+    for (const char *name : {"b.gif", "A.GIF", "c.txt", "e.gifx", ".gif"}) {
+        unlink((root + "/" + name).c_str());
+    }
+    rmdir((root + "/d.gif").c_str());
+    rmdir(dir);
+
+    HOST_CHECK(is_scanned);
+    HOST_CHECK(!is_missing_scanned);
+    HOST_CHECK(paths == std::vector<std::string>({root + "/A.GIF", root + "/b.gif"}));
+    playlist.clear();
+    HOST_CHECK(playlist.getPaths().empty());
+
+    return true;
+}
+
+// Check the GIF decoder and the frame cache of the GIF player app on GIFs encoded by the test, and benchmark the
+// decoding time per frame and the decoding time per loop once the frames are cached or streamed
+HOST_CHECK_REGISTER(
+    gif_player, "GIF",
+    {"decode", host_gif_check_decode},
+    {"decode_time", host_gif_check_decode_time},
+    {"cache", host_gif_check_cache},
+    {"playlist", host_gif_check_playlist}
+);
@@ -6,16 +6,16 @@
 #include <iterator>
 #include <thread>
 #include <unistd.h>
+#include "services/executor/esp_brookesia_service_executor.hpp"
 #include "private/esp_brookesia_app_settings_utils.hpp"
 #include "esp_brookesia_app_settings.hpp"
 
-#define MANAGER_THREAD_NAME                     "manager_run"
-#define MANAGER_THREAD_STACK_SIZE_BIG           (12 * 1024)
-#define MANAGER_THREAD_STACK_CAPS_EXT           (true)
+#define CLOSE_RETRY_INTERVAL_MS                 (10)
 
 using namespace std;
 using namespace esp_brookesia::speaker;
 using namespace esp_brookesia::ai_framework;
+using esp_brookesia::services::Executor;
 
 namespace esp_brookesia::speaker_apps {
 
@@ -124,19 +124,12 @@ bool Settings::run()
 
     ESP_UTILS_CHECK_FALSE_RETURN(ui.begin(), false, "UI begin failed");
 
-    {
-        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
-            .name = MANAGER_THREAD_NAME,
-            .stack_size = MANAGER_THREAD_STACK_SIZE_BIG,
-            .stack_in_ext = MANAGER_THREAD_STACK_CAPS_EXT,
-        });
-        boost::thread([this]() {
-            getCore()->lockLv();
-            ESP_UTILS_CHECK_FALSE_EXIT(manager.processRun(), "Manager process run failed");
-            getCore()->unlockLv();
-            _is_starting = false;
-        }).detach();
-    }
+    ESP_UTILS_CHECK_FALSE_RETURN(Executor::requestInstance().post([this]() {
+        getCore()->lockLv();
+        ESP_UTILS_CHECK_FALSE_EXIT(manager.processRun(), "Manager process run failed");
+        getCore()->unlockLv();
+        _is_starting = false;
+    }, Executor::Priority::Normal, "settings_run"), false, "Post manager run failed");
 
     return true;
 }
@@ -158,18 +151,25 @@ bool Settings::close()
 
     _is_stopping = true;
 
-    boost::thread([this]() {
-        while (isStarting()) {
-            boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    ESP_UTILS_CHECK_FALSE_RETURN(postClose(), false, "Post manager close failed");
+
+    return true;
+}
+
+bool Settings::postClose()
+{
+    // Wait for the run job to finish without holding a worker
+    return Executor::requestInstance().postDelayed([this]() {
+        if (isStarting()) {
+            ESP_UTILS_CHECK_FALSE_EXIT(postClose(), "Post manager close failed");
+            return;
         }
         getCore()->lockLv();
         ESP_UTILS_CHECK_FALSE_EXIT(manager.processClose(), "Manager process close failed");
         ESP_UTILS_CHECK_FALSE_EXIT(ui.del(), "UI delete failed");
         _is_stopping = false;
         getCore()->unlockLv();
-    }).detach();
-
-    return true;
+    }, isStarting() ? CLOSE_RETRY_INTERVAL_MS : 0, Executor::Priority::Normal, "settings_close");
 }
 
 bool Settings::init()
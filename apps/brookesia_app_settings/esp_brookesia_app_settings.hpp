@@ -57,6 +57,7 @@ private:
 
     bool calibrateStylesheet(const ESP_Brookesia_StyleSize_t &screen_size, SettingsStylesheetData &sheetstyle) override;
     bool calibrateScreenSize(ESP_Brookesia_StyleSize_t &size) override;
+    bool postClose();
 
     const SettingsStylesheetData _default_stylesheet_dark = {};
 
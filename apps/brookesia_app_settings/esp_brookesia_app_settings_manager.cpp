@@ -21,12 +21,14 @@
 #include "esp_flash.h"
 #include "esp_system.h"
 #include "services/storage_nvs/esp_brookesia_service_storage_nvs.hpp"
+#include "services/executor/esp_brookesia_service_executor.hpp"
 #include "app_sntp.h"
 #include "private/esp_brookesia_app_settings_utils.hpp"
 #include "assets/esp_brookesia_app_settings_assets.h"
 #include "esp_brookesia_app_settings_manager.hpp"
 
 using StorageNVS = esp_brookesia::services::StorageNVS;
+using Executor = esp_brookesia::services::Executor;
 
 #define WLAN_OPERATION_THREAD_NAME              "wlan_operation"
 #define WLAN_OPERATION_THREAD_STACK_SIZE        (6 * 1024)
@@ -36,10 +38,6 @@ using StorageNVS = esp_brookesia::services::StorageNVS;
 #define WLAN_UI_THREAD_STACK_SIZE               (8 * 1024)
 #define WLAN_UI_THREAD_STACK_CAPS_EXT           (true)
 
-#define WLAN_CONNECT_THREAD_NAME                "wlan_connect"
-#define WLAN_CONNECT_THREAD_STACK_SIZE          (6 * 1024)
-#define WLAN_CONNECT_THREAD_STACK_CAPS_EXT      (true)
-
 #define WLAN_TIME_SYNC_THREAD_NAME              "wlan_time_sync"
 #define WLAN_TIME_SYNC_THREAD_STACK_SIZE        (6 * 1024)
 #define WLAN_TIME_SYNC_THREAD_STACK_CAPS_EXT    (true)
@@ -82,12 +80,14 @@ using StorageNVS = esp_brookesia::services::StorageNVS;
 #define WLAN_SCAN_CONNECT_AP_DELAY_MS   (100)
 #define WLAN_DISCONNECT_HIDE_TIME_MS    (3000)
 #define WLAN_INIT_WAIT_TIMEOUT_MS       (5000)
+#define WLAN_STATE_POLL_INTERVAL_MS     (100)
 #define WLAN_START_WAIT_TIMEOUT_MS      (1000)
 #define WLAN_STOP_WAIT_TIMEOUT_MS       (1000)
 #define WLAN_CONNECT_WAIT_TIMEOUT_MS    (5000)
 #define WLAN_DISCONNECT_WAIT_TIMEOUT_MS (5000)
 #define WLAN_SCAN_START_WAIT_TIMEOUT_MS (5000)
 #define WLAN_SCAN_STOP_WAIT_TIMEOUT_MS  (1000)
+#define WLAN_SCAN_TIMER_SLACK_MS        (1000)  // The periodic scan may share a wakeup with the other UI refreshes
 
 using namespace esp_brookesia::speaker;
 using namespace esp_brookesia::services;
@@ -163,6 +163,39 @@ SettingsManager::~SettingsManager()
 
 bool SettingsManager::processInit()
 {
+    StorageNVS::Value wlan_ssid;
+    std::string wlan_ssid_str = WLAN_DEFAULT_SSID;
+    if (!StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, wlan_ssid)) {
+        ESP_UTILS_LOGW("WLAN SSID not found in NVS, set to default value(%s)", wlan_ssid_str.c_str());
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, wlan_ssid_str, !wlan_ssid_str.empty()),
+            false, "Failed to set WLAN SSID"
+        );
+    }
+
+    StorageNVS::Value wlan_password;
+    std::string wlan_password_str = WLAN_DEFAULT_PWD;
+    if (!StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, wlan_password)) {
+        ESP_UTILS_LOGW("WLAN password not found in NVS, set to default value(%s)", wlan_password_str.c_str());
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, wlan_password_str,
+                    !wlan_password_str.empty()), false, "Failed to set WLAN password"
+        );
+    }
+
+    // Keep the saved network in memory, the scans look it up for every AP. It is loaded before the WLAN is initialized
+    // since the WLAN task reads it without lock
+    if (std::holds_alternative<std::string>(wlan_ssid)) {
+        wlan_ssid_str = std::get<std::string>(wlan_ssid);
+    }
+    if (std::holds_alternative<std::string>(wlan_password)) {
+        wlan_password_str = std::get<std::string>(wlan_password);
+    }
+    _wlan_saved_networks.clear();
+    if (!wlan_ssid_str.empty()) {
+        _wlan_saved_networks.emplace(wlan_ssid_str, wlan_password_str);
+    }
+
     ESP_UTILS_CHECK_FALSE_RETURN(initWlan(), false, "Init WLAN failed");
 
     StorageNVS::Value wlan_sw_flag;
@@ -188,32 +221,7 @@ bool SettingsManager::processInit()
     );
     // Force WLAN operation later since the Wlan init may take some time
     target_operation = wlan_sw_flag_int ? WlanOperation::START : WlanOperation::STOP;
-    boost::thread([this, target_operation]() {
-        // std::this_thread::sleep_for(boost::chrono::milliseconds(WLAN_INIT_WAIT_TIMEOUT_MS));
-        if (!forceWlanOperation(target_operation, 0)) {
-            ESP_UTILS_LOGE("Force WLAN operation(%d) failed", static_cast<int>(target_operation));
-        }
-    }).detach();
-
-    StorageNVS::Value wlan_ssid;
-    std::string wlan_ssid_str = WLAN_DEFAULT_SSID;
-    if (!StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, wlan_ssid)) {
-        ESP_UTILS_LOGW("WLAN SSID not found in NVS, set to default value(%s)", wlan_ssid_str.c_str());
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, wlan_ssid_str, !wlan_ssid_str.empty()),
-            false, "Failed to set WLAN SSID"
-        );
-    }
-
-    StorageNVS::Value wlan_password;
-    std::string wlan_password_str = WLAN_DEFAULT_PWD;
-    if (!StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, wlan_password)) {
-        ESP_UTILS_LOGW("WLAN password not found in NVS, set to default value(%s)", wlan_password_str.c_str());
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, wlan_password_str,
-                    !wlan_password_str.empty()), false, "Failed to set WLAN password"
-        );
-    }
+    postForceWlanOperation(target_operation);
 
     return true;
 }
@@ -744,9 +752,7 @@ bool SettingsManager::updateUI_ScreenWlanConnected(bool use_current, WlanGeneraS
                 ui.screen_wlan.updateConnectedState(SettingsUI_ScreenWlan::ConnectState::DISCONNECT), false,
                 "Update WLAN connect state failed"
             );
-            boost::thread([this]() {
-                boost::this_thread::sleep_for(boost::chrono::milliseconds(WLAN_DISCONNECT_HIDE_TIME_MS));
-
+            Executor::requestInstance().postDelayed([this]() {
                 if (_is_ui_initialized && !this->checkIsWlanGeneralState(WlanGeneraState::_CONNECT)) {
                     app.getCore()->lockLv();
                     if (!ui.screen_wlan.setConnectedVisible(false)) {
@@ -754,7 +760,7 @@ bool SettingsManager::updateUI_ScreenWlanConnected(bool use_current, WlanGeneraS
                     }
                     app.getCore()->unlockLv();
                 }
-            }).detach();
+            }, WLAN_DISCONNECT_HIDE_TIME_MS, Executor::Priority::Normal, "settings_wlan_hide");
         } else {
             ESP_UTILS_LOGD("Hide WLAN connect");
             ESP_UTILS_CHECK_FALSE_RETURN(
@@ -1355,8 +1361,12 @@ bool SettingsManager::initWlan()
         _wlan_ui_thread = boost::thread(onWlanUI_Thread, this);
     }
 
-    _wlan_update_timer = ESP_BROOKESIA_LV_TIMER(onWlanScanTimer, data.wlan.scan_interval_ms, this);
-    ESP_UTILS_CHECK_NULL_RETURN(_wlan_update_timer, false, "Create WLAN update timer failed");
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        _wlan_update_timer = std::make_unique<gui::LvTickSubscriber>(
+            onWlanScanTimer, data.wlan.scan_interval_ms, WLAN_SCAN_TIMER_SLACK_MS, this
+        ), false, "Create WLAN update timer failed"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_wlan_update_timer->isValid(), false, "Invalid WLAN update timer");
 
     ESP_UTILS_CHECK_FALSE_RETURN(
         forceWlanOperation(WlanOperation::INIT, 0), false, "Force WLAN operation init failed"
@@ -1393,20 +1403,17 @@ bool SettingsManager::toggleWlanScanTimer(bool is_start, bool is_once)
     ESP_UTILS_LOGD("Toggle UI screen WLAN scan timer(%s)", is_start ? "start" : "stop");
 
     if (is_start) {
-        lv_timer_resume(_wlan_update_timer.get());
-        lv_timer_ready(_wlan_update_timer.get());
+        ESP_UTILS_CHECK_FALSE_RETURN(_wlan_update_timer->trigger(), false, "Trigger WLAN scan timer failed");
     } else {
-        lv_timer_pause(_wlan_update_timer.get());
-        lv_timer_reset(_wlan_update_timer.get());
+        ESP_UTILS_CHECK_FALSE_RETURN(_wlan_update_timer->pause(), false, "Pause WLAN scan timer failed");
     }
     _wlan_scan_timer_once = is_once;
 
     return true;
 }
 
-bool SettingsManager::processOnWlanScanTimer(lv_timer_t *t)
+bool SettingsManager::processOnWlanScanTimer()
 {
-    ESP_UTILS_CHECK_NULL_RETURN(t, false, "Invalid timer");
     ESP_UTILS_LOGD("On WLAN update timer");
 
     if (_wlan_scan_timer_once) {
@@ -1583,6 +1590,77 @@ bool SettingsManager::forceWlanOperation(WlanOperation operation, int timeout_ms
     return true;
 }
 
+void SettingsManager::postForceWlanOperation(
+    WlanOperation operation, uint32_t delay_ms, int wait_ms, WlanOperation wait_operation
+)
+{
+    Executor::requestInstance().postDelayed([this, operation, wait_ms, wait_operation]() {
+        // Starting needs the WLAN initialized, which may take seconds. Queue the initialization and check again later,
+        // rather than waiting for it on the worker
+        if ((operation == WlanOperation::START) && !checkIsWlanGeneralState(WlanGeneraState::INIT)) {
+            if (wait_operation != WlanOperation::INIT) {
+                ESP_UTILS_CHECK_FALSE_EXIT(
+                    triggerWlanOperation(WlanOperation::INIT, 0), "Trigger WLAN operation init failed"
+                );
+            }
+            postWlanOperationPoll(operation, wait_ms, wait_operation, WlanOperation::INIT, WLAN_INIT_WAIT_TIMEOUT_MS);
+            return;
+        }
+
+        // Connecting needs the scan stopped and the current connection dropped first. Same as above, queue each step
+        // and poll its state from later jobs, so the single low priority worker is never held for seconds
+        if (operation == WlanOperation::CONNECT) {
+            if (checkIsWlanScanState(WlanScanState::_SCAN_START)) {
+                if (wait_operation != WlanOperation::SCAN_STOP) {
+                    ESP_UTILS_CHECK_FALSE_EXIT(
+                        triggerWlanOperation(WlanOperation::SCAN_STOP, 0), "Trigger WLAN operation scan stop failed"
+                    );
+                }
+                postWlanOperationPoll(
+                    operation, wait_ms, wait_operation, WlanOperation::SCAN_STOP, WLAN_SCAN_STOP_WAIT_TIMEOUT_MS
+                );
+                return;
+            }
+            if (checkIsWlanGeneralState(WlanGeneraState::_CONNECT)) {
+                if (wait_operation != WlanOperation::DISCONNECT) {
+                    ESP_UTILS_LOGD("Connection already established, force disconnect first");
+                    // Record this state to skip the upcoming disconnection event
+                    _is_wlan_force_connecting = true;
+                    ESP_UTILS_CHECK_FALSE_EXIT(
+                        triggerWlanOperation(WlanOperation::DISCONNECT, 0), "Trigger WLAN operation disconnect failed"
+                    );
+                }
+                postWlanOperationPoll(
+                    operation, wait_ms, wait_operation, WlanOperation::DISCONNECT, WLAN_DISCONNECT_WAIT_TIMEOUT_MS
+                );
+                return;
+            }
+            ESP_UTILS_CHECK_FALSE_EXIT(
+                triggerWlanOperation(WlanOperation::CONNECT, 0), "Trigger WLAN operation connect failed"
+            );
+            return;
+        }
+
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            forceWlanOperation(operation, 0), "Force WLAN operation(%s) failed", getWlanOperationStr(operation)
+        );
+    }, delay_ms, Executor::Priority::Low, "settings_wlan_operation");
+}
+
+void SettingsManager::postWlanOperationPoll(
+    WlanOperation operation, int wait_ms, WlanOperation wait_operation, WlanOperation step_operation, int timeout_ms
+)
+{
+    // The wait time only counts for the step being polled, a new step starts from zero
+    int step_wait_ms = (wait_operation == step_operation) ? wait_ms : 0;
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        step_wait_ms < timeout_ms, "Wait for WLAN operation(%s) timeout", getWlanOperationStr(step_operation)
+    );
+    postForceWlanOperation(
+        operation, WLAN_STATE_POLL_INTERVAL_MS, step_wait_ms + WLAN_STATE_POLL_INTERVAL_MS, step_operation
+    );
+}
+
 bool SettingsManager::tryWlanOperation(WlanOperation operation, int timeout_ms)
 {
     ESP_UTILS_LOGD(
@@ -2090,6 +2168,8 @@ bool SettingsManager::processOnWlanUI_Thread()
 
         ESP_UTILS_LOGD("Get AP count: %d", std::min(number, ap_count));
 
+        std::unordered_set<std::string> scanned_ssids;
+
         for (uint16_t i = 0; (i < ap_count) && (i < number); i++) {
 #if WLAN_SCAN_ENABLE_DEBUG_LOG
             printf("SSID: \t\t%s\n", ap_info[i].ssid);
@@ -2098,70 +2178,46 @@ bool SettingsManager::processOnWlanUI_Thread()
             printf("Locked: %s\n", psk_flag ? "yes" : "no");
             printf("Signal Level: %d\n\n", static_cast<int>(signal_level));
 #endif
+            // Hidden APs can't be listed, and the same SSID is only listed once, with its strongest AP
+            std::string ssid((const char *)ap_info[i].ssid);
+            if (ssid.empty() || !scanned_ssids.insert(ssid).second) {
+                continue;
+            }
             if (checkIsWlanGeneralState(WlanGeneraState::_CONNECT)) {
                 // Skip connected AP
-                if (strcmp((const char *)ap_info[i].ssid, _wlan_connected_info.first.ssid.c_str()) == 0) {
+                if (ssid == _wlan_connected_info.first.ssid) {
                     ESP_UTILS_LOGD("Skip connecting or connected AP(%s)", _wlan_connected_info.first.ssid.c_str());
                     continue;
                 }
             } else if (checkIsWlanGeneralState(WlanGeneraState::_START)) {
-                // Check if default AP is in scan list
-                StorageNVS::Value default_connect_ssid;
-                StorageNVS::Value default_connect_pwd;
-                ESP_UTILS_CHECK_FALSE_RETURN(
-                    StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, default_connect_ssid), false,
-                    "Get default connect SSID failed"
-                );
-                ESP_UTILS_CHECK_FALSE_RETURN(
-                    StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, default_connect_pwd), false,
-                    "Get default connect PWD failed"
-                );
-                ESP_UTILS_CHECK_FALSE_RETURN(
-                    std::holds_alternative<std::string>(default_connect_ssid), false, "Invalid default connect SSID type"
-                );
-                ESP_UTILS_CHECK_FALSE_RETURN(
-                    std::holds_alternative<std::string>(default_connect_pwd), false, "Invalid default connect PWD type"
-                );
-                auto &default_connect_ssid_str = std::get<std::string>(default_connect_ssid);
-                auto &default_connect_pwd_str = std::get<std::string>(default_connect_pwd);
-
-                if ((default_connect_ssid_str.size() > 0) &&
-                        strcmp((const char *)ap_info[i].ssid, default_connect_ssid_str.c_str()) == 0) {
-                    ESP_UTILS_LOGD("Connect to default AP(%s)", default_connect_ssid_str.c_str());
+                // Check if a saved AP is in scan list
+                auto saved_network = _wlan_saved_networks.find(ssid);
+                if (saved_network != _wlan_saved_networks.end()) {
+                    ESP_UTILS_LOGD("Connect to default AP(%s)", ssid.c_str());
                     _wlan_connecting_info.first = getWlanDataFromApInfo(ap_info[i]);
-                    _wlan_connecting_info.second = default_connect_pwd_str;
-
-                    // Create a thread to connect to default AP, avoid blocking UI
-                    {
-                        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
-                            .name = WLAN_CONNECT_THREAD_NAME,
-                            .stack_size = WLAN_CONNECT_THREAD_STACK_SIZE,
-                            .stack_in_ext = WLAN_CONNECT_THREAD_STACK_CAPS_EXT,
-                        });
-                        boost::thread([this]() {
-                            boost::this_thread::sleep_for(boost::chrono::milliseconds(WLAN_SCAN_CONNECT_AP_DELAY_MS));
-                            ESP_UTILS_LOGI("Connect to default AP(%s)", _wlan_connecting_info.first.ssid.c_str());
-                            ESP_UTILS_CHECK_FALSE_EXIT(
-                                forceWlanOperation(WlanOperation::CONNECT, 0), "Force WLAN operation connect failed"
-                            );
-                            if (_is_ui_initialized) {
-                                app.getCore()->lockLv();
-                                // Update connecting WLAN data
-                                if (!checkIsWlanGeneralState(WlanGeneraState::CONNECTED)) {
-                                    if (!updateUI_ScreenWlanConnected(true, WlanGeneraState::CONNECTING)) {
-                                        ESP_UTILS_LOGE("Update UI screen WLAN connected failed");
-                                    }
+                    _wlan_connecting_info.second = saved_network->second;
+
+                    // Connect to default AP later, avoid blocking UI
+                    Executor::requestInstance().postDelayed([this]() {
+                        ESP_UTILS_LOGI("Connect to default AP(%s)", _wlan_connecting_info.first.ssid.c_str());
+                        postForceWlanOperation(WlanOperation::CONNECT);
+                        if (_is_ui_initialized) {
+                            app.getCore()->lockLv();
+                            // Update connecting WLAN data
+                            if (!checkIsWlanGeneralState(WlanGeneraState::CONNECTED)) {
+                                if (!updateUI_ScreenWlanConnected(true, WlanGeneraState::CONNECTING)) {
+                                    ESP_UTILS_LOGE("Update UI screen WLAN connected failed");
                                 }
-                                // Update available WLAN data
-                                if (!checkIsWlanGeneralState(WlanGeneraState::CONNECTED)) {
-                                    if (!updateUI_ScreenWlanAvailable(true, WlanGeneraState::CONNECTING)) {
-                                        ESP_UTILS_LOGE("Update UI screen WLAN available failed");
-                                    }
+                            }
+                            // Update available WLAN data
+                            if (!checkIsWlanGeneralState(WlanGeneraState::CONNECTED)) {
+                                if (!updateUI_ScreenWlanAvailable(true, WlanGeneraState::CONNECTING)) {
+                                    ESP_UTILS_LOGE("Update UI screen WLAN available failed");
                                 }
-                                app.getCore()->unlockLv();
                             }
-                        }).detach();
-                    }
+                            app.getCore()->unlockLv();
+                        }
+                    }, WLAN_SCAN_CONNECT_AP_DELAY_MS, Executor::Priority::Low, "settings_wlan_default_ap");
                 }
             }
             psk_flag = (ap_info[i].authmode != WIFI_AUTH_OPEN);
@@ -2172,33 +2228,16 @@ bool SettingsManager::processOnWlanUI_Thread()
             } else {
                 signal_level = SettingsUI_ScreenWlan::SignalLevel::GOOD;
             }
-            temp_available_data.push_back(
-                SettingsUI_ScreenWlan::WlanData{std::string((char *)ap_info[i].ssid), psk_flag, signal_level}
-            );
+            temp_available_data.push_back(SettingsUI_ScreenWlan::WlanData{ssid, psk_flag, signal_level});
         }
         break;
     }
     case WIFI_EVENT_STA_CONNECTED: {
-        StorageNVS::Value last_ssid;
-        StorageNVS::Value last_pwd;
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, last_ssid), false, "Get last SSID failed"
-        );
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            StorageNVS::requestInstance().getLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, last_pwd), false, "Get last PWD failed"
-        );
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            std::holds_alternative<std::string>(last_ssid), false, "Invalid last SSID type"
-        );
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            std::holds_alternative<std::string>(last_pwd), false, "Invalid last PWD type"
-        );
-        auto &last_ssid_str = std::get<std::string>(last_ssid);
-        auto &last_pwd_str = std::get<std::string>(last_pwd);
-
         std::string current_ssid((char *)_wlan_config.sta.ssid);
         std::string current_pwd((char *)_wlan_config.sta.password);
-        if ((last_ssid_str != current_ssid) || (last_pwd_str != current_pwd)) {
+        auto saved_network = _wlan_saved_networks.find(current_ssid);
+        if ((_wlan_saved_networks.size() != 1) || (saved_network == _wlan_saved_networks.end()) ||
+                (saved_network->second != current_pwd)) {
             ESP_UTILS_CHECK_FALSE_RETURN(
                 StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_SSID, current_ssid), false,
                 "Set last SSID failed"
@@ -2207,6 +2246,9 @@ bool SettingsManager::processOnWlanUI_Thread()
                 StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_PASSWORD, current_pwd), false,
                 "Set last PWD failed"
             );
+            // Only the last connected network is saved
+            _wlan_saved_networks.clear();
+            _wlan_saved_networks.emplace(current_ssid, current_pwd);
         }
         break;
     }
@@ -2369,13 +2411,13 @@ const char *SettingsManager::getWlanOperationStr(WlanOperation operation)
     return _wlan_operation_str.at(operation).c_str();
 }
 
-void SettingsManager::onWlanScanTimer(lv_timer_t *t)
+void SettingsManager::onWlanScanTimer(void *user_data)
 {
-    ESP_UTILS_CHECK_NULL_EXIT(t, "Invalid timer");
     ESP_UTILS_LOGD("On WLAN scan timer");
 
-    SettingsManager *manager = (SettingsManager *)t->user_data;
-    ESP_UTILS_CHECK_FALSE_EXIT(manager->processOnWlanScanTimer(t), "Process on WLAN update timer failed");
+    SettingsManager *manager = static_cast<SettingsManager *>(user_data);
+    ESP_UTILS_CHECK_NULL_EXIT(manager, "Invalid manager");
+    ESP_UTILS_CHECK_FALSE_EXIT(manager->processOnWlanScanTimer(), "Process on WLAN update timer failed");
 }
 
 void SettingsManager::onWlanOperationThread(SettingsManager *manager)
@@ -2477,11 +2519,7 @@ bool SettingsManager::processOnUI_ScreenWlanVerificationKeyboardConfirmEvent(std
 
     _wlan_connecting_info.second = pwd;
     ESP_UTILS_LOGI("Connecting to Wlan %s (pwd: %s)", ssid.data(), pwd.data());
-    boost::thread([this]() {
-        ESP_UTILS_CHECK_FALSE_EXIT(
-            forceWlanOperation(WlanOperation::CONNECT, 0), "Force WLAN operation connect failed"
-        );
-    }).detach();
+    postForceWlanOperation(WlanOperation::CONNECT);
 
     return true;
 }
@@ -2520,16 +2558,13 @@ bool SettingsManager::processOnUI_ScreenWlanControlSwitchChangeEvent(lv_event_t
         updateUI_ScreenWlanAvailable(true, target_state), false, "Update UI screen WLAN available failed"
     );
 
-    boost::thread([this, wlan_sw_flag]() {
-        ESP_UTILS_CHECK_FALSE_EXIT(
-            forceWlanOperation(wlan_sw_flag ? WlanOperation::START : WlanOperation::STOP, WLAN_START_WAIT_TIMEOUT_MS),
-        );
-
+    postForceWlanOperation(wlan_sw_flag ? WlanOperation::START : WlanOperation::STOP);
+    Executor::requestInstance().post([wlan_sw_flag]() {
         ESP_UTILS_CHECK_FALSE_EXIT(
             StorageNVS::requestInstance().setLocalParam(SETTINGS_NVS_KEY_WLAN_SWITCH, static_cast<int>(wlan_sw_flag)),
             "Set WLAN switch flag failed"
         );
-    }).detach();
+    }, Executor::Priority::Low, "settings_wlan_switch");
 
     return true;
 }
@@ -2541,13 +2576,15 @@ bool SettingsManager::processOnUI_ScreenWlanAvailableCellClickEvent(const ESP_Br
     SettingsUI_WidgetCell *cell = (SettingsUI_WidgetCell *)data.object;
     ESP_UTILS_CHECK_NULL_RETURN(cell, false, "Invalid cell");
 
-    int cell_index = ui.screen_wlan.getCellContainer(
-                         static_cast<int>(SettingsUI_ScreenWlanContainerIndex::AVAILABLE)
-                     ) ->getCellIndex(cell);
-    ESP_UTILS_CHECK_FALSE_RETURN(cell_index >= 0, false, "Get cell index failed");
-    ESP_UTILS_LOGD("Cell index: %d", cell_index);
+    // Only the rows around the viewport have a cell, so the index of the cell is not the one of the data
+    int data_index = ui.screen_wlan.getAvailableDataIndex(cell);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (data_index >= 0) && (data_index < static_cast<int>(_ui_wlan_available_data.size())), false,
+        "Get data index failed"
+    );
+    ESP_UTILS_LOGD("Data index: %d", data_index);
 
-    _wlan_connecting_info.first = _ui_wlan_available_data[cell_index];
+    _wlan_connecting_info.first = _ui_wlan_available_data[data_index];
     ESP_UTILS_LOGD("Connect to Wlan %s", _wlan_connecting_info.first.ssid.c_str());
 
     if (_wlan_connecting_info.first.is_locked) {
@@ -2588,9 +2625,7 @@ bool SettingsManager::processOnUI_ScreenWlanAvailableCellClickEvent(const ESP_Br
         );
         // Force connect to WLAN
         _wlan_connecting_info.second = "";
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            forceWlanOperation(WlanOperation::CONNECT, 0), false, "Force WLAN operation connect failed"
-        );
+        postForceWlanOperation(WlanOperation::CONNECT);
     }
 
     return true;
@@ -2699,9 +2734,7 @@ bool SettingsManager::processOnWlanEventHandler(int event_id, void *event_data)
     _wlan_event_cv.notify_all();
 
     if (_is_wlan_retry_connecting) {
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            forceWlanOperation(WlanOperation::CONNECT, 0), false, "Force WLAN operation connect failed"
-        );
+        postForceWlanOperation(WlanOperation::CONNECT);
     }
 
 end:
@@ -14,6 +14,8 @@
 #include <queue>
 #include <mutex>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <thread>
 #include "esp_wifi.h"
 #include "boost/signals2.hpp"
@@ -216,10 +218,16 @@ private:
     bool deinitWlan();
     bool processCloseWlan();
     bool toggleWlanScanTimer(bool is_start, bool is_once = false);
-    bool processOnWlanScanTimer(lv_timer_t *t);
+    bool processOnWlanScanTimer();
     bool triggerWlanOperation(WlanOperation operation, int timeout_ms = 0);
 
     bool forceWlanOperation(WlanOperation operation, int timeout_ms = 0);
+    void postForceWlanOperation(
+        WlanOperation operation, uint32_t delay_ms = 0, int wait_ms = 0, WlanOperation wait_operation = WlanOperation::NONE
+    );
+    void postWlanOperationPoll(
+        WlanOperation operation, int wait_ms, WlanOperation wait_operation, WlanOperation step_operation, int timeout_ms
+    );
     bool tryWlanOperation(WlanOperation operation, int timeout_ms = 0);
     bool doWlanOperationInit();
     bool doWlanOperationDeinit();
@@ -245,7 +253,7 @@ private:
     static const char *getWlanGeneralStateStr(WlanGeneraState state);
     static const char *getWlanScanStateStr(WlanScanState state);
     static const char *getWlanOperationStr(WlanOperation operation);
-    static void onWlanScanTimer(lv_timer_t *t);
+    static void onWlanScanTimer(void *user_data);
     static void onWlanOperationThread(SettingsManager *manager);
     static void onWlanUI_Thread(SettingsManager *manager);
 
@@ -284,9 +292,11 @@ private:
     std::condition_variable _wlan_event_cv;
     bool _is_wlan_event_updated = false;
     bool _wlan_scan_timer_once = false;
-    ESP_Brookesia_LvTimer_t _wlan_update_timer = nullptr;
+    gui::LvTickSubscriberUniquePtr _wlan_update_timer;
     std::pair<SettingsUI_ScreenWlan::WlanData, std::string> _wlan_connecting_info = {};
     std::pair<SettingsUI_ScreenWlan::WlanData, std::string> _wlan_connected_info = {};
+    // SSID -> password, loaded from NVS once, then only used by the WLAN UI thread
+    std::unordered_map<std::string, std::string> _wlan_saved_networks;
     static const std::unordered_map<WlanGeneraState, std::string> _wlan_general_state_str;
     static const std::unordered_map<WlanScanState, std::string> _wlan_scan_state_str;
     static const std::unordered_map<WlanOperation, std::string> _wlan_operation_str;
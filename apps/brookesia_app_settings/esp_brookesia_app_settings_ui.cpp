@@ -34,6 +34,7 @@ bool SettingsUI::begin()
     ESP_UTILS_LOGD("Begin(@0x%p)", this);
     ESP_UTILS_CHECK_FALSE_RETURN(app.checkInitialized(), false, "Core app not initialized");
 
+    gui::LvArenaScope arena_scope(_arena);
     ESP_UTILS_CHECK_FALSE_RETURN(screen_settings.begin(), false, "Screen settings begin failed");
     ESP_UTILS_CHECK_FALSE_RETURN(screen_wlan.begin(), false, "Screen wlan begin failed");
     ESP_UTILS_CHECK_FALSE_RETURN(
@@ -59,6 +60,8 @@ bool SettingsUI::del()
 
     _is_initialized = false;
 
+    // Delete the widget trees in one shot, the pointers released by the screens below have nothing left to delete
+    _arena.close();
     ESP_UTILS_CHECK_FALSE_RETURN(screen_settings.del(), false, "Screen settings delete failed");
     ESP_UTILS_CHECK_FALSE_RETURN(screen_wlan.del(), false, "Screen wlan delete failed");
     ESP_UTILS_CHECK_FALSE_RETURN(screen_wlan_verification.del(), false, "Screen wlan connect delete failed");
@@ -57,6 +57,9 @@ public:
     SettingsUI_ScreenSound screen_sound;
     SettingsUI_ScreenDisplay screen_display;
 
+    // The widget trees of all the screens, made in `begin()` and deleted together in `del()`. The cell containers and
+    // cells keep the arena they were made in, so the cells and icons they add later from the manager go to it too
+    gui::LvArena _arena;
     std::atomic<bool> _is_initialized = false;
 };
 
@@ -0,0 +1,425 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "esp_log.h"
+#include "lvgl.h"
+#include "cell_list_diff.hpp"
+#include "host_device.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::speaker_apps::SettingsUI_WidgetCellListDiff;
+using esp_brookesia::speaker_apps::SettingsUI_WidgetCellListWindow;
+
+#define HOST_WLAN_LIST_WIDTH        (240)
+#define HOST_WLAN_LIST_HEIGHT       (240)
+#define HOST_WLAN_LIST_ROW_HEIGHT   (40)
+// Same as the settings app
+#define HOST_WLAN_LIST_MARGIN_ROWS  (2)
+#define HOST_WLAN_LIST_AP_NUM       (80)
+#define HOST_WLAN_LIST_SCAN_AP_MAX  (64)
+#define HOST_WLAN_LIST_SCAN_NUM     (50)
+#define HOST_WLAN_LIST_SCROLL_STEP  (7)
+
+static const char *TAG = "host_wlan_list";
+
+struct HostWlanRow {
+    std::string ssid;
+    bool is_locked;
+    int signal_level;
+};
+
+/* Scans of APs coming and going, the jitter of their RSSI reorders them */
+class HostWlanScanner {
+public:
+    explicit HostWlanScanner(unsigned seed): _random(seed)
+    {
+        for (int i = 0; i < HOST_WLAN_LIST_AP_NUM; i++) {
+            _aps.push_back({"AP_" + std::to_string(i), (i % 3) != 0, -30 - static_cast<int>(_random() % 60)});
+        }
+    }
+
+    std::vector<HostWlanRow> scan()
+    {
+        std::vector<std::pair<int, const Ap *>> found;
+        for (auto &ap : _aps) {
+            if ((_random() % 10) == 0) {
+                continue;
+            }
+            found.emplace_back(ap.rssi + static_cast<int>(_random() % 13) - 6, &ap);
+        }
+        // Sorted by RSSI like the records of the driver, and cut at the same maximum
+        std::stable_sort(found.begin(), found.end(), [](const auto & lhs, const auto & rhs) {
+            return lhs.first > rhs.first;
+        });
+        found.resize(std::min<size_t>(found.size(), HOST_WLAN_LIST_SCAN_AP_MAX));
+
+        std::vector<HostWlanRow> rows;
+        for (auto &[rssi, ap] : found) {
+            // Same levels as the settings app
+            rows.push_back({ap->ssid, ap->is_locked, (rssi <= -70) ? 1 : ((rssi <= -50) ? 2 : 3)});
+        }
+
+        return rows;
+    }
+
+private:
+    struct Ap {
+        std::string ssid;
+        bool is_locked;
+        int rssi;
+    };
+
+    std::mt19937 _random;
+    std::vector<Ap> _aps;
+};
+
+/* Rows of the list as objects of LVGL, like the cells of the settings app: a main object with two labels */
+class HostWlanList {
+public:
+    struct Stats {
+        int created_objects;
+        int rewritten_rows;
+        int64_t update_us;
+    };
+
+    explicit HostWlanList(lv_obj_t *parent): _container(lv_obj_create(parent))
+    {
+    }
+
+    ~HostWlanList()
+    {
+        lv_obj_delete(_container);
+    }
+
+    /* Previous update of the settings app: a cell for every row, matched by position and all written */
+    void updatePositional(const std::vector<HostWlanRow> &rows)
+    {
+        auto start = std::chrono::steady_clock::now();
+        int cell_number = lv_obj_get_child_count(_container);
+        int data_number = rows.size();
+        for (int i = 0; (i < cell_number) || (i < data_number); i++) {
+            if (i >= cell_number) {
+                createRow();
+            } else if (i >= data_number) {
+                lv_obj_delete(lv_obj_get_child(_container, data_number));
+                continue;
+            }
+            writeRow(lv_obj_get_child(_container, i), rows[i]);
+        }
+        _rows = rows;
+        _shown = rows;
+        _first = 0;
+        _stats.update_us += elapsedUs(start);
+    }
+
+    /* Update of the settings app: only the rows around the viewport have a cell, matched by SSID */
+    void updateWindowed(const std::vector<HostWlanRow> &rows)
+    {
+        auto start = std::chrono::steady_clock::now();
+        _rows = rows;
+        updateWindow(true);
+        _stats.update_us += elapsedUs(start);
+    }
+
+    void scroll(int scroll_offset)
+    {
+        auto start = std::chrono::steady_clock::now();
+        _scroll_offset = scroll_offset;
+        updateWindow(false);
+        _stats.update_us += elapsedUs(start);
+    }
+
+    /* The cells show the rows of the window, in order */
+    bool checkShown() const
+    {
+        int count = lv_obj_get_child_count(_container);
+        HOST_CHECK(count == static_cast<int>(_shown.size()));
+        HOST_CHECK(_first + count <= static_cast<int>(_rows.size()));
+        for (int i = 0; i < count; i++) {
+            lv_obj_t *row = lv_obj_get_child(_container, i);
+            auto &expected = _rows[_first + i];
+            HOST_CHECK(expected.ssid == lv_label_get_text(lv_obj_get_child(row, 0)));
+            HOST_CHECK(getSignalText(expected) == lv_label_get_text(lv_obj_get_child(row, 1)));
+        }
+
+        return true;
+    }
+
+    int getShownCount() const
+    {
+        return _shown.size();
+    }
+
+    const Stats &getStats() const
+    {
+        return _stats;
+    }
+
+private:
+    void updateWindow(bool is_data_changed)
+    {
+        int data_number = _rows.size();
+        auto window = SettingsUI_WidgetCellListWindow::get(
+                          data_number, HOST_WLAN_LIST_ROW_HEIGHT, _scroll_offset, HOST_WLAN_LIST_HEIGHT,
+                          HOST_WLAN_LIST_MARGIN_ROWS
+                      );
+        if (!is_data_changed && (window.first == _first) && (window.count == static_cast<int>(_shown.size()))) {
+            return;
+        }
+
+        auto first_it = _rows.begin() + window.first;
+        auto diff = SettingsUI_WidgetCellListDiff::make(
+                        _shown, first_it, first_it + window.count,
+        [](const HostWlanRow & row) {
+            return row.ssid;
+        },
+        [](const HostWlanRow & lhs, const HostWlanRow & rhs) {
+            return (lhs.is_locked == rhs.is_locked) && (lhs.signal_level == rhs.signal_level);
+        }
+                    );
+        std::vector<lv_obj_t *> cells;
+        for (auto &target : diff.targets) {
+            cells.push_back(
+                (target.cell == SettingsUI_WidgetCellListDiff::NEW_CELL) ? createRow() :
+                lv_obj_get_child(_container, target.cell)
+            );
+        }
+        for (auto index : diff.deleted_cells) {
+            lv_obj_delete(lv_obj_get_child(_container, index));
+        }
+        for (int i = 0; i < window.count; i++) {
+            lv_obj_move_to_index(cells[i], i);
+            if (diff.targets[i].is_content_changed) {
+                writeRow(cells[i], first_it[i]);
+            }
+        }
+        _shown.assign(first_it, first_it + window.count);
+        _first = window.first;
+        lv_obj_set_style_pad_top(_container, window.first * HOST_WLAN_LIST_ROW_HEIGHT, 0);
+        lv_obj_set_style_pad_bottom(
+            _container, (data_number - window.first - window.count) * HOST_WLAN_LIST_ROW_HEIGHT, 0
+        );
+    }
+
+    lv_obj_t *createRow()
+    {
+        lv_obj_t *row = lv_obj_create(_container);
+        lv_obj_set_size(row, HOST_WLAN_LIST_WIDTH, HOST_WLAN_LIST_ROW_HEIGHT);
+        lv_label_create(row);
+        lv_label_create(row);
+        _stats.created_objects += 3;
+
+        return row;
+    }
+
+    void writeRow(lv_obj_t *row, const HostWlanRow &data)
+    {
+        lv_label_set_text(lv_obj_get_child(row, 0), data.ssid.c_str());
+        lv_label_set_text(lv_obj_get_child(row, 1), getSignalText(data).c_str());
+        _stats.rewritten_rows++;
+    }
+
+    static std::string getSignalText(const HostWlanRow &data)
+    {
+        return std::to_string(data.signal_level) + (data.is_locked ? "L" : "");
+    }
+
+    static int64_t elapsedUs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    lv_obj_t *_container;
+    std::vector<HostWlanRow> _rows;
+    std::vector<HostWlanRow> _shown;
+    int _first = 0;
+    int _scroll_offset = 0;
+    Stats _stats = {};
+};
+
+static bool host_wlan_list_check_diff_case(
+    const std::vector<std::string> &shown, const std::vector<std::string> &rows,
+    const std::vector<int> &target_cells, int kept, int recycled, int created, const std::vector<int> &deleted
+)
+{
+    auto diff = SettingsUI_WidgetCellListDiff::make(
+                    shown, rows.begin(), rows.end(),
+    [](const std::string & row) {
+        return row;
+    },
+    [](const std::string &, const std::string &) {
+        return true;
+    }
+                );
+    HOST_CHECK(diff.targets.size() == target_cells.size());
+    for (size_t i = 0; i < target_cells.size(); i++) {
+        HOST_CHECK(diff.targets[i].cell == target_cells[i]);
+    }
+    HOST_CHECK(diff.kept_cells == kept);
+    HOST_CHECK(diff.recycled_cells == recycled);
+    HOST_CHECK(diff.created_cells == created);
+    HOST_CHECK(diff.deleted_cells == deleted);
+
+    return true;
+}
+
+/* Cells keep their row when it moves, the others are recycled before any is created or deleted */
+static bool host_wlan_list_check_diff()
+{
+    constexpr int NEW_CELL = SettingsUI_WidgetCellListDiff::NEW_CELL;
+
+    // Reordered rows and a new one
+    HOST_CHECK(host_wlan_list_check_diff_case({"A", "B", "C"}, {"B", "A", "D"}, {1, 0, 2}, 2, 1, 0, {}));
+    // Duplicated SSIDs are matched in order
+    HOST_CHECK(host_wlan_list_check_diff_case(
+                             {"A", "B"}, {"C", "A", "A", "D"}, {1, 0, NEW_CELL, NEW_CELL}, 1, 1, 2, {}
+                         ));
+    // Shorter list
+    HOST_CHECK(host_wlan_list_check_diff_case({"A", "B", "C"}, {"B"}, {1}, 1, 0, 0, {2, 0}));
+    HOST_CHECK(host_wlan_list_check_diff_case({"A"}, {}, {}, 0, 0, 0, {0}));
+
+    // Only the rows which look different are written
+    std::vector<HostWlanRow> shown = {{"A", false, 1}, {"B", true, 2}};
+    std::vector<HostWlanRow> rows = {{"B", true, 2}, {"A", false, 3}};
+    auto diff = SettingsUI_WidgetCellListDiff::make(
+                    shown, rows.begin(), rows.end(),
+    [](const HostWlanRow & row) {
+        return row.ssid;
+    },
+    [](const HostWlanRow & lhs, const HostWlanRow & rhs) {
+        return (lhs.is_locked == rhs.is_locked) && (lhs.signal_level == rhs.signal_level);
+    }
+                );
+    HOST_CHECK(!diff.targets[0].is_content_changed);
+    HOST_CHECK(diff.targets[1].is_content_changed);
+
+    return true;
+}
+
+/* The window covers the viewport and the margins, and stays in the list at both ends */
+static bool host_wlan_list_check_window()
+{
+    const int row_height = HOST_WLAN_LIST_ROW_HEIGHT;
+    const int view_height = HOST_WLAN_LIST_HEIGHT;
+    const int margin = HOST_WLAN_LIST_MARGIN_ROWS;
+    const int count = view_height / row_height + 1 + 2 * margin;
+
+    auto window = SettingsUI_WidgetCellListWindow::get(0, row_height, 0, view_height, margin);
+    HOST_CHECK((window.first == 0) && (window.count == 0));
+    window = SettingsUI_WidgetCellListWindow::get(5, row_height, 0, view_height, margin);
+    HOST_CHECK((window.first == 0) && (window.count == 5));
+    // The list starts below the top of the viewport
+    window = SettingsUI_WidgetCellListWindow::get(100, row_height, -50, view_height, margin);
+    HOST_CHECK((window.first == 0) && (window.count == count));
+    window = SettingsUI_WidgetCellListWindow::get(100, row_height, 50 * row_height + 10, view_height, margin);
+    HOST_CHECK((window.first == 50 - margin) && (window.count == count));
+    // Scrolled past the end
+    window = SettingsUI_WidgetCellListWindow::get(100, row_height, 200 * row_height, view_height, margin);
+    HOST_CHECK((window.first == 100 - count) && (window.count == count));
+    // Every row in the viewport has a cell
+    for (int offset = 0; offset < 100 * row_height; offset += HOST_WLAN_LIST_SCROLL_STEP) {
+        window = SettingsUI_WidgetCellListWindow::get(100, row_height, offset, view_height, margin);
+        int last_visible = std::min(99, (offset + view_height - 1) / row_height);
+        HOST_CHECK(window.first <= offset / row_height);
+        HOST_CHECK(window.first + window.count > last_visible);
+    }
+
+    return true;
+}
+
+/* Replay the same scans on both updates, while the list is scrolled now and then */
+static bool host_wlan_list_check_scan_replay()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_WLAN_LIST_WIDTH, HOST_WLAN_LIST_HEIGHT));
+
+    {
+        HostWlanScanner scanner(1);
+        HostWlanList positional(lv_screen_active());
+        HostWlanList windowed(lv_screen_active());
+        int rows_number = 0;
+        for (int i = 0; i < HOST_WLAN_LIST_SCAN_NUM; i++) {
+            auto rows = scanner.scan();
+            rows_number += rows.size();
+            positional.updatePositional(rows);
+            windowed.scroll((i % 8) * 3 * HOST_WLAN_LIST_ROW_HEIGHT);
+            windowed.updateWindowed(rows);
+            HOST_CHECK(positional.checkShown());
+            HOST_CHECK(windowed.checkShown());
+            HOST_CHECK(windowed.getShownCount() < static_cast<int>(rows.size()));
+            device.run(HostDevice::STEP_MS);
+        }
+
+        auto &positional_stats = positional.getStats();
+        auto &windowed_stats = windowed.getStats();
+        ESP_LOGI(
+            TAG, "Scans(%d, %d APs each): by position %d objects, %d rows written, %d us; windowed %d objects, "
+            "%d rows written, %d us", HOST_WLAN_LIST_SCAN_NUM, rows_number / HOST_WLAN_LIST_SCAN_NUM,
+            positional_stats.created_objects, positional_stats.rewritten_rows,
+            static_cast<int>(positional_stats.update_us), windowed_stats.created_objects,
+            windowed_stats.rewritten_rows, static_cast<int>(windowed_stats.update_us)
+        );
+        HOST_CHECK(windowed_stats.created_objects < positional_stats.created_objects);
+        HOST_CHECK(windowed_stats.rewritten_rows < positional_stats.rewritten_rows);
+    }
+    device.del();
+
+    return true;
+}
+
+/* Scrolling a long list down and up only recycles the cells */
+static bool host_wlan_list_check_scroll()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_WLAN_LIST_WIDTH, HOST_WLAN_LIST_HEIGHT));
+
+    {
+        HostWlanScanner scanner(2);
+        auto rows = scanner.scan();
+        HostWlanList windowed(lv_screen_active());
+        windowed.updateWindowed(rows);
+        HOST_CHECK(windowed.checkShown());
+        int created_objects = windowed.getStats().created_objects;
+        int rewritten_rows = windowed.getStats().rewritten_rows;
+
+        int end = rows.size() * HOST_WLAN_LIST_ROW_HEIGHT;
+        for (int offset = 0; offset <= end; offset += HOST_WLAN_LIST_SCROLL_STEP) {
+            windowed.scroll(offset);
+            HOST_CHECK(windowed.checkShown());
+        }
+        for (int offset = end; offset >= 0; offset -= HOST_WLAN_LIST_SCROLL_STEP) {
+            windowed.scroll(offset);
+            HOST_CHECK(windowed.checkShown());
+        }
+        ESP_LOGI(
+            TAG, "Scroll(%d APs): %d objects, %d rows written down and up", static_cast<int>(rows.size()),
+            windowed.getStats().created_objects, windowed.getStats().rewritten_rows - rewritten_rows
+        );
+        HOST_CHECK(windowed.getStats().created_objects == created_objects);
+        // Each row out of the first window is written once going down, and again going up
+        HOST_CHECK(
+            windowed.getStats().rewritten_rows - rewritten_rows <= 2 * static_cast<int>(rows.size())
+        );
+    }
+    device.del();
+
+    return true;
+}
+
+// Check the keyed diff and the window of the WLAN list of the settings app on synthetic scans: only the rows around the
+// viewport are materialized, scrolling doesn't create any object, and the objects created and rows written are compared
+// with the update of every row by position
+HOST_CHECK_REGISTER(
+    wlan_list, "WLAN list",
+    {"diff", host_wlan_list_check_diff},
+    {"window", host_wlan_list_check_window},
+    {"scan_replay", host_wlan_list_check_scan_replay},
+    {"scroll", host_wlan_list_check_scroll}
+);
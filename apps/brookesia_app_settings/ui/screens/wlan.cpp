@@ -5,6 +5,7 @@
  */
 #include "private/esp_brookesia_app_settings_utils.hpp"
 #include "../../assets/esp_brookesia_app_settings_assets.h"
+#include "../widgets/cell_list_diff.hpp"
 #include "wlan.hpp"
 
 using namespace std;
@@ -12,6 +13,9 @@ using namespace esp_brookesia::speaker;
 
 namespace esp_brookesia::speaker_apps {
 
+// Rows materialized out of the viewport on each side
+#define AVAILABLE_WINDOW_MARGIN_ROWS    (2)
+
 #define CELL_ELEMENT_CONF_SW() \
     { \
         SettingsUI_WidgetCellElement::MAIN \
@@ -75,6 +79,9 @@ bool SettingsUI_ScreenWlan::begin()
 
     _cell_container_map = CELL_CONTAINER_MAP();
     ESP_UTILS_CHECK_FALSE_GOTO(processCellContainerMapInit(), err, "Process cell container map init failed");
+    lv_obj_add_event_cb(
+        getObject(SettingsUI_ScreenBaseObject::CONTENT_OBJECT), onContentScrollEventCallback, LV_EVENT_SCROLL, this
+    );
 
     // Update UI
     ESP_UTILS_CHECK_FALSE_GOTO(processDataUpdate(), err, "Process data update failed");
@@ -103,6 +110,9 @@ bool SettingsUI_ScreenWlan::del()
     }
 
     _cell_container_map.clear();
+    _available_data.clear();
+    _available_shown.clear();
+    _available_first = 0;
 
     return ret;
 }
@@ -114,6 +124,7 @@ bool SettingsUI_ScreenWlan::processDataUpdate()
 
     ESP_UTILS_CHECK_FALSE_RETURN(SettingsUI_ScreenBase::processDataUpdate(), false, "Process base data update failed");
     ESP_UTILS_CHECK_FALSE_RETURN(processCellContainerMapUpdate(), false, "Process cell container map update failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(updateAvailableWindow(false), false, "Update available window failed");
 
     return true;
 }
@@ -236,54 +247,13 @@ bool SettingsUI_ScreenWlan::updateAvailableData(
     const std::vector<WlanData> &wlan_data, ESP_Brookesia_CoreEvent::Handler event_handler, void *user_data
 )
 {
-    auto cell_container = getCellContainer(static_cast<int>(SettingsUI_ScreenWlanContainerIndex::AVAILABLE));
-    ESP_UTILS_CHECK_NULL_RETURN(cell_container, false, "Get cell container failed");
-
-    int cell_number = cell_container->getCellCount();
-    int data_number = wlan_data.size();
-    bool ret = true;
-    SettingsUI_WidgetCell *cell = nullptr;
+    _available_data = wlan_data;
+    _available_event_handler = event_handler;
+    _available_event_user_data = user_data;
 
-    // Update cells number, create or remove cell
-    for (int i = 0; (i < cell_number) || (i < data_number); i++) {
-        if (i >= cell_number) {
-            cell = cell_container->addCell(
-                       cell_number, SettingsUI_WidgetCellElement::LEFT_MAIN_LABEL | SettingsUI_WidgetCellElement::RIGHT_ICONS
-                   );
-            ESP_UTILS_CHECK_FALSE_GOTO(ret = (cell != nullptr), end, "Add cell(%d) failed", cell_number);
+    ESP_UTILS_CHECK_FALSE_RETURN(updateAvailableWindow(true), false, "Update available window failed");
 
-            ESP_UTILS_CHECK_FALSE_GOTO(
-                ret = app.getCore()->getCoreEvent()->registerEvent(
-                          cell->getEventObject(), event_handler, cell->getClickEventID(), user_data
-                      ), end, "Register cell(%d) click event failed", cell_number
-            );
-        } else if (i >= data_number) {
-            ESP_UTILS_CHECK_FALSE_GOTO(
-                ret = cell_container->delCellByIndex(cell_container->getCellCount() - 1), end,
-                "Remove cell(%d) failed", i
-            );
-        } else {
-            cell = cell_container->getCellByIndex(i);
-            ESP_UTILS_CHECK_NULL_GOTO(cell, end, "Get cell(%d) failed", i);
-        }
-
-        // Update cells data
-        if (i < data_number) {
-            ESP_UTILS_CHECK_FALSE_GOTO(
-                ret = updateCellWlanData(cell, wlan_data[i]), end, "Update WLAN available cell(%d) failed", i
-            );
-            ESP_UTILS_CHECK_FALSE_GOTO(
-                ret = cell->setSplitLineVisible(i < (data_number - 1)), end, "Set split line visible failed"
-            );
-        }
-    }
-
-end:
-    if (!ret) {
-        ESP_UTILS_CHECK_FALSE_RETURN(cleanAvailable(), false, "Clean WLAN available failed");
-    }
-
-    return ret;
+    return true;
 }
 
 bool SettingsUI_ScreenWlan::updateCellWlanData(SettingsUI_WidgetCell *cell, const WlanData &wlan_data)
@@ -328,6 +298,10 @@ bool SettingsUI_ScreenWlan::cleanAvailable()
     auto cell_container = getCellContainer(static_cast<int>(SettingsUI_ScreenWlanContainerIndex::AVAILABLE));
     ESP_UTILS_CHECK_NULL_RETURN(cell_container, false, "Get cell container failed");
     ESP_UTILS_CHECK_FALSE_RETURN(cell_container->cleanCells(), false, "Clean cells failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(cell_container->setExtraPadding(0, 0), false, "Set extra padding failed");
+    _available_data.clear();
+    _available_shown.clear();
+    _available_first = 0;
 
     return true;
 }
@@ -339,6 +313,8 @@ bool SettingsUI_ScreenWlan::setAvaliableClickable(bool clickable)
 
     ESP_UTILS_LOGD("Set available clickable(%d)", clickable);
 
+    _available_clickable = clickable;
+
     for (size_t i = 0; i < cell_container->getCellCount(); i++) {
         SettingsUI_WidgetCell *cell = cell_container->getCellByIndex(i);
         ESP_UTILS_CHECK_NULL_RETURN(cell, false, "Get cell failed");
@@ -349,6 +325,17 @@ bool SettingsUI_ScreenWlan::setAvaliableClickable(bool clickable)
     return true;
 }
 
+int SettingsUI_ScreenWlan::getAvailableDataIndex(SettingsUI_WidgetCell *cell) const
+{
+    auto cell_container = getCellContainer(static_cast<int>(SettingsUI_ScreenWlanContainerIndex::AVAILABLE));
+    ESP_UTILS_CHECK_NULL_RETURN(cell_container, -1, "Get cell container failed");
+
+    int cell_index = cell_container->getCellIndex(cell);
+    ESP_UTILS_CHECK_FALSE_RETURN(cell_index >= 0, -1, "Get cell index failed");
+
+    return _available_first + cell_index;
+}
+
 bool SettingsUI_ScreenWlan::processCellContainerMapInit()
 {
     ESP_UTILS_LOGD("Process cell container map init");
@@ -394,4 +381,118 @@ bool SettingsUI_ScreenWlan::processCellContainerMapUpdate()
     return true;
 }
 
+bool SettingsUI_ScreenWlan::updateAvailableWindow(bool is_data_changed)
+{
+    auto cell_container = getCellContainer(static_cast<int>(SettingsUI_ScreenWlanContainerIndex::AVAILABLE));
+    ESP_UTILS_CHECK_NULL_RETURN(cell_container, false, "Get cell container failed");
+    lv_obj_t *content_object = getObject(SettingsUI_ScreenBaseObject::CONTENT_OBJECT);
+    ESP_UTILS_CHECK_NULL_RETURN(content_object, false, "Get content object failed");
+    lv_obj_t *container_object = cell_container->getContainerObject();
+    ESP_UTILS_CHECK_NULL_RETURN(container_object, false, "Get container object failed");
+
+    // The first row is right below the top padding of the container, which scrolls with the content
+    lv_obj_update_layout(content_object);
+    lv_area_t content_area = {};
+    lv_area_t container_area = {};
+    lv_obj_get_coords(content_object, &content_area);
+    lv_obj_get_coords(container_object, &container_area);
+    int row_height = cell_container->data.cell.main.size.height + lv_obj_get_style_pad_row(container_object, 0);
+    int scroll_offset = content_area.y1 - (container_area.y1 + cell_container->data.container.top_pad);
+    int data_number = _available_data.size();
+    auto window = SettingsUI_WidgetCellListWindow::get(
+                      data_number, row_height, scroll_offset, lv_area_get_height(&content_area),
+                      AVAILABLE_WINDOW_MARGIN_ROWS
+                  );
+    if (!is_data_changed && (window.first == _available_first) &&
+            (window.count == static_cast<int>(_available_shown.size()))) {
+        return true;
+    }
+    ESP_UTILS_LOGD("Update available window(%d,%d)", window.first, window.count);
+
+    auto first_it = _available_data.begin() + window.first;
+    auto diff = SettingsUI_WidgetCellListDiff::make(
+                    _available_shown, first_it, first_it + window.count,
+    [](const WlanData & wlan_data) {
+        return wlan_data.ssid;
+    },
+    [](const WlanData & lhs, const WlanData & rhs) {
+        return (lhs.is_locked == rhs.is_locked) && (lhs.signal_level == rhs.signal_level);
+    }
+                );
+    std::vector<SettingsUI_WidgetCell *> cells;
+    SettingsUI_WidgetCell *cell = nullptr;
+
+    // Pick the cell of every row before moving any, the created ones are appended to the container
+    for (auto &target : diff.targets) {
+        if (target.cell == SettingsUI_WidgetCellListDiff::NEW_CELL) {
+            cell = cell_container->addCell(
+                       cell_container->getCellCount(),
+                       SettingsUI_WidgetCellElement::LEFT_MAIN_LABEL | SettingsUI_WidgetCellElement::RIGHT_ICONS
+                   );
+            ESP_UTILS_CHECK_NULL_GOTO(cell, err, "Add cell failed");
+            ESP_UTILS_CHECK_FALSE_GOTO(
+                app.getCore()->getCoreEvent()->registerEvent(
+                    cell->getEventObject(), _available_event_handler, cell->getClickEventID(),
+                    _available_event_user_data
+                ), err, "Register cell click event failed"
+            );
+        } else {
+            cell = cell_container->getCellByIndex(target.cell);
+            ESP_UTILS_CHECK_NULL_GOTO(cell, err, "Get cell(%d) failed", target.cell);
+        }
+        cells.push_back(cell);
+    }
+    for (auto index : diff.deleted_cells) {
+        ESP_UTILS_CHECK_FALSE_GOTO(cell_container->delCellByIndex(index), err, "Delete cell(%d) failed", index);
+    }
+
+    // Then put the cells in the order of the rows, and only rewrite the ones showing another row
+    for (int i = 0; i < window.count; i++) {
+        int cell_index = cell_container->getCellIndex(cells[i]);
+        ESP_UTILS_CHECK_FALSE_GOTO(cell_container->moveCell(cell_index, i), err, "Move cell(%d) failed", cell_index);
+
+        if (diff.targets[i].is_content_changed) {
+            ESP_UTILS_CHECK_FALSE_GOTO(
+                updateCellWlanData(cells[i], first_it[i]), err, "Update WLAN available cell(%d) failed", i
+            );
+            ESP_UTILS_CHECK_FALSE_GOTO(
+                cells[i]->updateClickable(_available_clickable), err, "Update clickable failed"
+            );
+        }
+        ESP_UTILS_CHECK_FALSE_GOTO(
+            cells[i]->setSplitLineVisible((window.first + i) < (data_number - 1)), err,
+            "Set split line visible failed"
+        );
+    }
+    ESP_UTILS_LOGD(
+        "Available cells: kept(%d), recycled(%d), created(%d), deleted(%d)", diff.kept_cells, diff.recycled_cells,
+        diff.created_cells, static_cast<int>(diff.deleted_cells.size())
+    );
+
+    _available_shown.assign(first_it, first_it + window.count);
+    _available_first = window.first;
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        cell_container->setExtraPadding(
+            window.first * row_height, (data_number - window.first - window.count) * row_height
+        ), err, "Set extra padding failed"
+    );
+
+    return true;
+
+err:
+    ESP_UTILS_CHECK_FALSE_RETURN(cleanAvailable(), false, "Clean WLAN available failed");
+
+    return false;
+}
+
+void SettingsUI_ScreenWlan::onContentScrollEventCallback(lv_event_t *e)
+{
+    ESP_UTILS_CHECK_NULL_EXIT(e, "Invalid event");
+
+    SettingsUI_ScreenWlan *screen = static_cast<SettingsUI_ScreenWlan *>(lv_event_get_user_data(e));
+    ESP_UTILS_CHECK_NULL_EXIT(screen, "Get screen failed");
+
+    ESP_UTILS_CHECK_FALSE_EXIT(screen->updateAvailableWindow(false), "Update available window failed");
+}
+
 } // namespace esp_brookesia::speaker
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include "esp_brookesia.hpp"
 #include "base.hpp"
 #include "../widgets/cell_container.hpp"
@@ -79,6 +80,7 @@ public:
     );
     bool cleanAvailable();
     bool setAvaliableClickable(bool clickable);
+    int getAvailableDataIndex(SettingsUI_WidgetCell *cell) const;
 
     const SettingsUI_ScreenWlanData &data;
 
@@ -89,6 +91,17 @@ private:
     bool processCellContainerMapInit();
     bool processCellContainerMapUpdate();
     bool updateCellWlanData(SettingsUI_WidgetCell *cell, const WlanData &wlan_data);
+    bool updateAvailableWindow(bool is_data_changed);
+
+    static void onContentScrollEventCallback(lv_event_t *e);
+
+    // Only the available APs around the viewport have a cell, the others are replaced by the padding of the container
+    std::vector<WlanData> _available_data;
+    std::vector<WlanData> _available_shown;
+    int _available_first = 0;
+    bool _available_clickable = true;
+    ESP_Brookesia_CoreEvent::Handler _available_event_handler = nullptr;
+    void *_available_event_user_data = nullptr;
 };
 
 } // namespace esp_brookesia::speaker
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <optional>
 #include "private/esp_brookesia_app_settings_utils.hpp"
 #include <src/widgets/label/lv_label.h>
 #include <src/widgets/textarea/lv_textarea.h>
@@ -40,6 +41,8 @@ bool SettingsUI_WidgetCell::begin(lv_obj_t *parent)
     ESP_UTILS_CHECK_FALSE_RETURN((parent != nullptr) && lv_obj_is_valid(parent), false, "Invalid parent object");
     ESP_UTILS_CHECK_FALSE_RETURN(!checkInitialized(), false, "Already initialized");
 
+    _arena = gui::LvArena::getCurrent();
+
     ESP_Brookesia_LvObj_t main_object = nullptr;
     ESP_Brookesia_LvObj_t left_area_object = nullptr;
     ESP_Brookesia_LvObj_t left_icon_object = nullptr;
@@ -608,6 +611,12 @@ bool SettingsUI_WidgetCell::updateRightIcons(
     lv_obj_t *right_icons_object = getElementObject(SettingsUI_WidgetCellElement::RIGHT_ICONS);
     ESP_UTILS_CHECK_NULL_RETURN(right_icons_object, false, "Invalid right icons object");
 
+    // The icons may be added long after `begin()`, outside of the scope of the arena
+    std::optional<gui::LvArenaScope> arena_scope;
+    if (_arena != nullptr) {
+        arena_scope.emplace(*_arena);
+    }
+
     lv_style_t *container_style = _core_app.getCore()->getCoreHome().getCoreContainerStyle();
     int update_count = right_icons.size();
     int current_count = _right_icon_object_images.size();
@@ -839,6 +848,8 @@ bool SettingsUI_WidgetCellContainer::begin(lv_obj_t *parent)
     ESP_UTILS_CHECK_FALSE_RETURN((parent != nullptr) && lv_obj_is_valid(parent), false, "Invalid parent object");
     ESP_UTILS_CHECK_FALSE_RETURN(!checkInitialized(), false, "Already initialized");
 
+    _arena = gui::LvArena::getCurrent();
+
     ESP_Brookesia_LvObj_t main_object = nullptr;
     ESP_Brookesia_LvObj_t container_object = nullptr;
     ESP_Brookesia_LvObj_t title_label = nullptr;
@@ -906,8 +917,8 @@ bool SettingsUI_WidgetCellContainer::processDataUpdate()
     lv_obj_set_style_radius(_container_object.get(), data.container.radius, 0);
     lv_obj_set_style_bg_color(_container_object.get(), lv_color_hex(data.container.background_color.color), 0);
     lv_obj_set_style_bg_opa(_container_object.get(), data.container.background_color.opacity, 0);
-    lv_obj_set_style_pad_top(_container_object.get(), data.container.top_pad, 0);
-    lv_obj_set_style_pad_bottom(_container_object.get(), data.container.bottom_pad, 0);
+    lv_obj_set_style_pad_top(_container_object.get(), data.container.top_pad + _extra_pad_top, 0);
+    lv_obj_set_style_pad_bottom(_container_object.get(), data.container.bottom_pad + _extra_pad_bottom, 0);
     lv_obj_set_style_pad_left(_container_object.get(), data.container.left_pad, 0);
     lv_obj_set_style_pad_right(_container_object.get(), data.container.right_pad, 0);
     // Title
@@ -928,6 +939,12 @@ SettingsUI_WidgetCell *SettingsUI_WidgetCellContainer::addCell(int key, Settings
     ESP_UTILS_LOGD("Add cell(%d,%d)", key, (int)elements);
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), nullptr, "Not initialized");
 
+    // The cells may be added long after `begin()`, on another task and outside of the scope of the arena
+    std::optional<gui::LvArenaScope> arena_scope;
+    if (_arena != nullptr) {
+        arena_scope.emplace(*_arena);
+    }
+
     unique_ptr<SettingsUI_WidgetCell> cell = make_unique<SettingsUI_WidgetCell>(_core_app, data.cell, elements);
     ESP_UTILS_CHECK_NULL_RETURN(cell, nullptr, "Create cell object failed");
 
@@ -1001,6 +1018,46 @@ bool SettingsUI_WidgetCellContainer::delCellByIndex(size_t index)
     return true;
 }
 
+bool SettingsUI_WidgetCellContainer::moveCell(size_t from_index, size_t to_index)
+{
+    ESP_UTILS_LOGD("Move cell(%d->%d)", (int)from_index, (int)to_index);
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (from_index < _cells.size()) && (to_index < _cells.size()), false, "Index out of range"
+    );
+
+    if (from_index == to_index) {
+        return true;
+    }
+
+    auto from = next(_cells.begin(), from_index);
+    lv_obj_t *main_object = from->second->getElementObject(SettingsUI_WidgetCellElement::MAIN);
+    ESP_UTILS_CHECK_NULL_RETURN(main_object, false, "Invalid cell main object");
+
+    // The cells are the only children of the container, in the same order
+    _cells.splice(next(_cells.begin(), (to_index > from_index) ? (to_index + 1) : to_index), _cells, from);
+    lv_obj_move_to_index(main_object, to_index);
+    _last_cell = _cells.back().second.get();
+
+    return true;
+}
+
+bool SettingsUI_WidgetCellContainer::setExtraPadding(int top, int bottom)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN((top >= 0) && (bottom >= 0), false, "Invalid padding");
+
+    if ((top == _extra_pad_top) && (bottom == _extra_pad_bottom)) {
+        return true;
+    }
+    _extra_pad_top = top;
+    _extra_pad_bottom = bottom;
+    lv_obj_set_style_pad_top(_container_object.get(), data.container.top_pad + _extra_pad_top, 0);
+    lv_obj_set_style_pad_bottom(_container_object.get(), data.container.bottom_pad + _extra_pad_bottom, 0);
+
+    return true;
+}
+
 bool SettingsUI_WidgetCellContainer::updateConf(const SettingsUI_WidgetCellContainerConf &conf)
 {
     ESP_UTILS_LOGD("Update conf");
@@ -190,6 +190,8 @@ private:
     SettingsUI_WidgetCellElement _elements;
     std::map<SettingsUI_WidgetCellElement, ESP_Brookesia_LvObj_t> _elements_map;
     std::vector<std::pair<ESP_Brookesia_LvObj_t, ESP_Brookesia_LvObj_t>> _right_icon_object_images;
+    // Arena the cell was made in, the icons added later are made in it too
+    gui::LvArena *_arena = nullptr;
 };
 
 struct SettingsUI_WidgetCellContainerData {
@@ -232,7 +234,12 @@ public:
     bool cleanCells();
     bool delCellByKey(int key);
     bool delCellByIndex(size_t index);
+    bool moveCell(size_t from_index, size_t to_index);
     bool updateConf(const SettingsUI_WidgetCellContainerConf &conf);
+    /**
+     * @brief Add some space above and below the cells, in place of the rows of a long list which are not materialized
+     */
+    bool setExtraPadding(int top, int bottom);
 
     bool checkInitialized() const
     {
@@ -242,6 +249,10 @@ public:
     {
         return _main_object.get();
     }
+    lv_obj_t *getContainerObject() const
+    {
+        return _container_object.get();
+    }
     size_t getCellCount() const
     {
         return _cells.size();
@@ -261,8 +272,12 @@ private:
     ESP_Brookesia_LvObj_t _container_object;
     ESP_Brookesia_LvObj_t _title_label;
     SettingsUI_WidgetCellContainerConf _conf;
+    int _extra_pad_top = 0;
+    int _extra_pad_bottom = 0;
     SettingsUI_WidgetCell *_last_cell;
     std::list<std::pair<int, std::unique_ptr<SettingsUI_WidgetCell>>> _cells;
+    // Arena the container was made in, the cells added later are made in it too
+    gui::LvArena *_arena = nullptr;
 };
 
 } // namespace esp_brookesia::speaker_apps
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace esp_brookesia::speaker_apps {
+
+/**
+ * @brief Rows of a long list which are materialized as cells: the ones in the viewport, plus a margin on both sides
+ */
+struct SettingsUI_WidgetCellListWindow {
+    int first;
+    int count;
+
+    /**
+     * @param row_num       Number of rows of the list
+     * @param row_height    Height of a row, including the gap between the rows
+     * @param scroll_offset Height of the list scrolled above the top of the viewport, negative if the list starts below
+     * @param view_height   Height of the viewport
+     * @param margin_rows   Rows materialized out of the viewport on each side, so a short scroll doesn't show them late
+     */
+    static SettingsUI_WidgetCellListWindow get(
+        int row_num, int row_height, int scroll_offset, int view_height, int margin_rows
+    )
+    {
+        if ((row_num <= 0) || (row_height <= 0)) {
+            return {0, 0};
+        }
+
+        int count = std::min(row_num, (view_height + row_height - 1) / row_height + 1 + 2 * margin_rows);
+        int first = std::max(scroll_offset, 0) / row_height - margin_rows;
+
+        return {std::clamp(first, 0, row_num - count), count};
+    }
+};
+
+/**
+ * @brief Keyed diff between the rows shown by the cells of a list and the rows to show. The cells keeping their row are
+ *        only moved, the cells whose row is gone are recycled for the new rows, and only the missing cells are created.
+ *        It doesn't use LVGL, so it can be checked on the host
+ */
+struct SettingsUI_WidgetCellListDiff {
+    static constexpr int NEW_CELL = -1;
+
+    struct Target {
+        int cell;                       /*!< Index of the cell showing the row, `NEW_CELL` to create one */
+        bool is_content_changed;        /*!< The cell must be updated with the row */
+    };
+
+    std::vector<Target> targets;        /*!< One per row to show, in order */
+    std::vector<int> deleted_cells;     /*!< Cells neither kept nor recycled, in decreasing order */
+    int kept_cells = 0;
+    int recycled_cells = 0;
+    int created_cells = 0;
+
+    /**
+     * @param shown     Rows shown by the cells, in the order of the cells
+     * @param first     First row to show
+     * @param last      End of the rows to show
+     * @param key_of    Key of a row, the rows with the same key are matched in order
+     * @param is_same   Whether two rows with the same key look the same
+     */
+    template <typename Row, typename Iterator, typename KeyOf, typename IsSame>
+    static SettingsUI_WidgetCellListDiff make(
+        const std::vector<Row> &shown, Iterator first, Iterator last, KeyOf key_of, IsSame is_same
+    )
+    {
+        using Key = std::decay_t<decltype(key_of(shown.front()))>;
+
+        SettingsUI_WidgetCellListDiff diff;
+        std::unordered_map<Key, std::vector<int>> shown_cells;
+        for (int i = static_cast<int>(shown.size()) - 1; i >= 0; i--) {
+            shown_cells[key_of(shown[i])].push_back(i);
+        }
+
+        // Keep the cells already showing a row
+        std::vector<bool> is_used(shown.size(), false);
+        for (auto it = first; it != last; ++it) {
+            auto found = shown_cells.find(key_of(*it));
+            if ((found == shown_cells.end()) || found->second.empty()) {
+                diff.targets.push_back({NEW_CELL, true});
+                continue;
+            }
+            int cell = found->second.back();
+            found->second.pop_back();
+            is_used[cell] = true;
+            diff.targets.push_back({cell, !is_same(shown[cell], *it)});
+            diff.kept_cells++;
+        }
+
+        // Then give the other cells to the new rows, and delete the ones left
+        int free_cell = 0;
+        for (auto &target : diff.targets) {
+            if (target.cell != NEW_CELL) {
+                continue;
+            }
+            while ((free_cell < static_cast<int>(shown.size())) && is_used[free_cell]) {
+                free_cell++;
+            }
+            if (free_cell < static_cast<int>(shown.size())) {
+                target.cell = free_cell;
+                is_used[free_cell] = true;
+                diff.recycled_cells++;
+            } else {
+                diff.created_cells++;
+            }
+        }
+        for (int i = static_cast<int>(shown.size()) - 1; i >= 0; i--) {
+            if (!is_used[i]) {
+                diff.deleted_cells.push_back(i);
+            }
+        }
+
+        return diff;
+    }
+};
+
+} // namespace esp_brookesia::speaker_apps
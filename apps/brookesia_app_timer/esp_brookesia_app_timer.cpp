@@ -19,6 +19,9 @@
 using namespace std;
 using namespace esp_brookesia::speaker_apps;
 
+#define TIMER_CLOCK_PERIOD_MS   (1000)
+#define TIMER_CLOCK_SLACK_MS    (100)
+
 LV_IMG_DECLARE(img_app_timer);
 
 
@@ -62,11 +65,7 @@ Timer::~Timer()
 {
 
 
-    if (_clock_timer) {
-        esp_timer_stop(_clock_timer);
-        esp_timer_delete(_clock_timer);
-        _clock_timer = nullptr;
-    }
+    _clock_timer = nullptr;
 
     if (_toast_timer) {
         esp_timer_stop(_toast_timer);
@@ -123,15 +122,31 @@ bool Timer::back(void)
     return true;
 }
 
+bool Timer::pause(void)
+{
+    if (_clock_timer != nullptr) {
+        _clock_timer->pause();
+    }
+    toggleClockScene(false);
+    return true;
+}
+
+bool Timer::resume(void)
+{
+    if (_clock_timer != nullptr) {
+        _clock_timer->resume();
+        toggleClockScene(true);
+        updateTimeDisplay();
+    }
+    return true;
+}
+
 bool Timer::close(void)
 {
     _is_stopping = true;
 
-    if (_clock_timer) {
-        esp_timer_stop(_clock_timer);
-        esp_timer_delete(_clock_timer);
-        _clock_timer = nullptr;
-    }
+    _clock_timer = nullptr;
+    toggleClockScene(false);
 
     // No need to manually clean screens due to enable_recycle_resource
     main_container = nullptr;
@@ -142,39 +157,33 @@ bool Timer::close(void)
 
 
 
-void Timer::createTimerWithCallback(esp_timer_handle_t *timer, esp_timer_cb_t callback, const char *name)
-{
-    if (!*timer) {
-        esp_timer_create_args_t timer_args = {};
-        timer_args.callback = callback;
-        timer_args.arg = this;
-        timer_args.name = name;
-
-        esp_err_t ret = esp_timer_create(&timer_args, timer);
-        if (ret != ESP_OK) {
-            ESP_UTILS_LOGE("Timer create failed (%s): %s", name, esp_err_to_name(ret));
-        }
-    }
-}
-
 void Timer::setupClockControls()
 {
-    createTimerWithCallback(&_clock_timer, clock_tick_callback, "clock_tick");
-    manageClockTimer();
+    // Refresh the clock for both digital and analog screens, along with the other periodic refreshes
+    ESP_UTILS_CHECK_EXCEPTION_EXIT(
+        _clock_timer = std::make_unique<gui::LvTickSubscriber>(
+            clock_tick_callback, TIMER_CLOCK_PERIOD_MS, TIMER_CLOCK_SLACK_MS, this
+        ), "Create clock timer failed"
+    );
+    ESP_UTILS_CHECK_FALSE_EXIT(_clock_timer->isValid(), "Invalid clock timer");
+    toggleClockScene(true);
 }
 
-void Timer::manageClockTimer()
+void Timer::toggleClockScene(bool enter)
 {
-    if (!_clock_timer || _is_stopping) {
+    // Only the clock changes on the watch faces, the display doesn't need to refresh more than a few times a second
+    if (_is_clock_scene_entered == enter) {
         return;
     }
-
-    // Start clock timer for both digital and analog screens
-    esp_timer_start_periodic(_clock_timer, 1000000);
+    auto &governor = gui::LvFrameGovernor::getInstance();
+    if (enter) {
+        governor.enterScene(gui::LvFrameGovernor::Scene::Clock);
+    } else {
+        governor.exitScene(gui::LvFrameGovernor::Scene::Clock);
+    }
+    _is_clock_scene_entered = enter;
 }
 
-
-
 const char *const *Timer::getMonthNames()
 {
     static const char *const month_names[] = {
@@ -384,12 +393,7 @@ void Timer::clock_tick_callback(void *arg)
         return;
     }
 
-    // Update clock display for both digital and analog screens
-    lv_async_call([](void *user_data) {
-        Timer *t = static_cast<Timer *>(user_data);
-        if (t && !t->_is_stopping) {
-            t->updateTimeDisplay();
-        }
-    }, timer);
+    // Called from the LVGL task, the display can be updated right away
+    timer->updateTimeDisplay();
 }
 } // namespace esp_brookesia::apps::speaker
@@ -52,6 +52,8 @@ public:
     bool close(void) override;
     bool init(void) override;
     bool deinit(void) override;
+    bool pause(void) override;
+    bool resume(void) override;
 
     using speaker::App::startRecordResource;
     using speaker::App::endRecordResource;
@@ -69,14 +71,13 @@ private:
     static void toast_timer_callback(void *arg);
 
     void setupClockControls();
-    void manageClockTimer();
+    void toggleClockScene(bool enter);
     void updateTimeDisplay();
     void updateDateDisplay();
     void updateAnalogClock();
     void switchScreen();
     void showToast(const char *message, uint32_t duration_ms = 3000);
     void hideToast();
-    void createTimerWithCallback(esp_timer_handle_t *timer, esp_timer_cb_t callback, const char *name);
     const char *const *getMonthNames();
     const char *const *getWeekdayNames();
 
@@ -93,7 +94,8 @@ private:
     std::atomic<bool> _is_stopping = false;
     static Timer *_instance;
 
-    esp_timer_handle_t _clock_timer = nullptr;
+    gui::LvTickSubscriberUniquePtr _clock_timer;
+    bool _is_clock_scene_entered = false;
     esp_timer_handle_t _toast_timer = nullptr;
 
     lv_obj_t *_toast_container = nullptr;
@@ -0,0 +1,388 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "agent_telemetry.h"
+
+#if ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY
+
+#define TELEMETRY_TURN_NUM          (ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM)
+#define TELEMETRY_BINARY_VERSION    (1)
+#define TELEMETRY_BINARY_HEAD_SIZE  (6)
+#define TELEMETRY_BINARY_TURN_SIZE  (4 + 8 + 4 * AGENT_TELEMETRY_STAGE_MAX)
+#define TELEMETRY_HEX_LINE_BYTES    (48)
+/* A JSON line of a turn with every field at its widest: 10 digits for the id, 20 characters for each int64_t */
+#define TELEMETRY_JSON_LINE_SIZE    \
+    (sizeof("{\"turn\":,\"base_us\":,\"us\":[]}") + 10 + 20 + 21 * AGENT_TELEMETRY_STAGE_MAX)
+#define TELEMETRY_OFFSET_NONE       (UINT32_MAX)
+
+static const char *TAG = "AGENT_TELEMETRY";
+
+typedef struct {
+    agent_telemetry_turn_t turns[TELEMETRY_TURN_NUM];
+    size_t                 head;    /* Index of the turn in progress */
+    size_t                 count;
+    uint32_t               next_id;
+    portMUX_TYPE           lock;
+} agent_telemetry_t;
+
+static agent_telemetry_t telemetry = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+/* Intervals reported by `agent_telemetry_dump()` */
+static const agent_telemetry_stage_t report_intervals[][2] = {
+    { AGENT_TELEMETRY_STAGE_WAKE_WORD, AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK },      /* End to end */
+    { AGENT_TELEMETRY_STAGE_VAD_END, AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK },        /* Network + server */
+    { AGENT_TELEMETRY_STAGE_LAST_UPLINK, AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK },    /* Server */
+    { AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK, AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK }, /* Local pipeline */
+    { AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK, AGENT_TELEMETRY_STAGE_SUBTITLE },
+};
+
+static agent_telemetry_turn_t *open_turn_locked(void)
+{
+    if (telemetry.count > 0) {
+        telemetry.head = (telemetry.head + 1) % TELEMETRY_TURN_NUM;
+    }
+    if (telemetry.count < TELEMETRY_TURN_NUM) {
+        telemetry.count++;
+    }
+
+    agent_telemetry_turn_t *turn = &telemetry.turns[telemetry.head];
+    memset(turn, 0, sizeof(*turn));
+    turn->id = telemetry.next_id++;
+
+    return turn;
+}
+
+static int64_t base_timestamp(const agent_telemetry_turn_t *turn)
+{
+    for (int i = 0; i < AGENT_TELEMETRY_STAGE_MAX; i++) {
+        if (turn->stage_us[i] != 0) {
+            return turn->stage_us[i];
+        }
+    }
+    return 0;
+}
+
+static void log_turn_summary(const agent_telemetry_turn_t *turn)
+{
+    const int64_t *t = turn->stage_us;
+#define INTERVAL_MS(from, to) (((t[from] != 0) && (t[to] != 0)) ? (int)((t[to] - t[from]) / 1000) : -1)
+    ESP_LOGI(
+        TAG, "turn %u: wake->playback %dms, vad->downlink %dms, uplink->downlink %dms, downlink->playback %dms",
+        (unsigned)turn->id,
+        INTERVAL_MS(AGENT_TELEMETRY_STAGE_WAKE_WORD, AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK),
+        INTERVAL_MS(AGENT_TELEMETRY_STAGE_VAD_END, AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK),
+        INTERVAL_MS(AGENT_TELEMETRY_STAGE_LAST_UPLINK, AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK),
+        INTERVAL_MS(AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK, AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK)
+    );
+#undef INTERVAL_MS
+}
+
+void agent_telemetry_mark(agent_telemetry_stage_t stage)
+{
+    agent_telemetry_mark_at(stage, esp_timer_get_time());
+}
+
+void agent_telemetry_mark_at(agent_telemetry_stage_t stage, int64_t timestamp)
+{
+    if ((stage < 0) || (stage >= AGENT_TELEMETRY_STAGE_MAX) || (timestamp == 0)) {
+        return;
+    }
+
+    bool is_completed = false;
+    agent_telemetry_turn_t completed_turn;
+
+    portENTER_CRITICAL(&telemetry.lock);
+    agent_telemetry_turn_t *turn = (telemetry.count > 0) ? &telemetry.turns[telemetry.head] : NULL;
+    switch (stage) {
+    case AGENT_TELEMETRY_STAGE_WAKE_WORD:
+        turn = open_turn_locked();
+        turn->stage_us[stage] = timestamp;
+        break;
+    case AGENT_TELEMETRY_STAGE_VAD_END:
+        // A follow-up utterance without wake word starts a new turn once the previous one got a reply
+        if ((turn == NULL) || (turn->stage_us[AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK] != 0) ||
+                (turn->stage_us[AGENT_TELEMETRY_STAGE_COMPLETED] != 0)) {
+            turn = open_turn_locked();
+        }
+        turn->stage_us[stage] = timestamp;
+        break;
+    case AGENT_TELEMETRY_STAGE_LAST_UPLINK:
+        if ((turn != NULL) && (turn->stage_us[AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK] == 0)) {
+            turn->stage_us[stage] = timestamp;
+        }
+        break;
+    default:
+        if ((turn != NULL) && (turn->stage_us[stage] == 0)) {
+            turn->stage_us[stage] = timestamp;
+            if (stage == AGENT_TELEMETRY_STAGE_COMPLETED) {
+                is_completed = true;
+                completed_turn = *turn;
+            }
+        }
+        break;
+    }
+    portEXIT_CRITICAL(&telemetry.lock);
+
+    if (is_completed && ESP_BROOKESIA_AGENT_TELEMETRY_LOG_EACH_TURN) {
+        log_turn_summary(&completed_turn);
+    }
+}
+
+void agent_telemetry_reset(void)
+{
+    portENTER_CRITICAL(&telemetry.lock);
+    telemetry.head = 0;
+    telemetry.count = 0;
+    portEXIT_CRITICAL(&telemetry.lock);
+}
+
+size_t agent_telemetry_get_turn_count(void)
+{
+    portENTER_CRITICAL(&telemetry.lock);
+    size_t count = telemetry.count;
+    portEXIT_CRITICAL(&telemetry.lock);
+
+    return count;
+}
+
+esp_err_t agent_telemetry_get_turn(size_t index, agent_telemetry_turn_t *turn)
+{
+    if (turn == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL(&telemetry.lock);
+    if (index >= telemetry.count) {
+        ret = ESP_ERR_NOT_FOUND;
+    } else {
+        *turn = telemetry.turns[(telemetry.head + TELEMETRY_TURN_NUM - index) % TELEMETRY_TURN_NUM];
+    }
+    portEXIT_CRITICAL(&telemetry.lock);
+
+    return ret;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, size_t count, int pct)
+{
+    // Nearest-rank method
+    size_t rank = (pct * count + 99) / 100;
+    return sorted[(rank > 0) ? (rank - 1) : 0];
+}
+
+esp_err_t agent_telemetry_get_stats(agent_telemetry_stage_t from, agent_telemetry_stage_t to,
+                                    agent_telemetry_stats_t *stats)
+{
+    if ((stats == NULL) || (from < 0) || (from >= AGENT_TELEMETRY_STAGE_MAX) || (to < 0) ||
+            (to >= AGENT_TELEMETRY_STAGE_MAX)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t samples[TELEMETRY_TURN_NUM];
+    size_t count = 0;
+
+    portENTER_CRITICAL(&telemetry.lock);
+    for (size_t i = 0; i < telemetry.count; i++) {
+        const int64_t *t = telemetry.turns[i].stage_us;
+        if ((t[from] != 0) && (t[to] != 0) && (t[to] >= t[from])) {
+            samples[count++] = (uint32_t)(t[to] - t[from]);
+        }
+    }
+    portEXIT_CRITICAL(&telemetry.lock);
+
+    memset(stats, 0, sizeof(*stats));
+    if (count == 0) {
+        return ESP_OK;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), compare_u32);
+    stats->count = count;
+    stats->min_us = samples[0];
+    stats->p50_us = percentile(samples, count, 50);
+    stats->p90_us = percentile(samples, count, 90);
+    stats->p99_us = percentile(samples, count, 99);
+    stats->max_us = samples[count - 1];
+
+    return ESP_OK;
+}
+
+static uint8_t *put_le(uint8_t *p, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(value >> (8 * i));
+    }
+    return p;
+}
+
+esp_err_t agent_telemetry_export_binary(uint8_t *buffer, size_t size, size_t *length)
+{
+    if (length == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    agent_telemetry_turn_t turns[TELEMETRY_TURN_NUM];
+    size_t count = 0;
+
+    portENTER_CRITICAL(&telemetry.lock);
+    count = telemetry.count;
+    for (size_t i = 0; i < count; i++) {
+        // Oldest first
+        turns[i] = telemetry.turns[(telemetry.head + TELEMETRY_TURN_NUM - (count - 1 - i)) % TELEMETRY_TURN_NUM];
+    }
+    portEXIT_CRITICAL(&telemetry.lock);
+
+    size_t required = TELEMETRY_BINARY_HEAD_SIZE + count * TELEMETRY_BINARY_TURN_SIZE;
+    *length = required;
+    if (buffer == NULL) {
+        return ESP_OK;
+    }
+    if (size < required) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t *p = buffer;
+    *p++ = 'A';
+    *p++ = 'T';
+    *p++ = TELEMETRY_BINARY_VERSION;
+    *p++ = AGENT_TELEMETRY_STAGE_MAX;
+    p = put_le(p, count, 2);
+    for (size_t i = 0; i < count; i++) {
+        int64_t base = base_timestamp(&turns[i]);
+        p = put_le(p, turns[i].id, 4);
+        p = put_le(p, (uint64_t)base, 8);
+        for (int s = 0; s < AGENT_TELEMETRY_STAGE_MAX; s++) {
+            int64_t t = turns[i].stage_us[s];
+            uint32_t offset = (t != 0) ? (uint32_t)(t - base) : TELEMETRY_OFFSET_NONE;
+            p = put_le(p, offset, 4);
+        }
+    }
+
+    return ESP_OK;
+}
+
+static void dump_json(void)
+{
+    agent_telemetry_turn_t turn;
+    char line[TELEMETRY_JSON_LINE_SIZE];
+
+    for (size_t i = agent_telemetry_get_turn_count(); i > 0; i--) {
+        if (agent_telemetry_get_turn(i - 1, &turn) != ESP_OK) {
+            continue;
+        }
+        int64_t base = base_timestamp(&turn);
+        int len = snprintf(line, sizeof(line), "{\"turn\":%u,\"base_us\":%lld,\"us\":[", (unsigned)turn.id,
+                           (long long)base);
+        for (int s = 0; (s < AGENT_TELEMETRY_STAGE_MAX) && (len >= 0) && (len < (int)sizeof(line)); s++) {
+            int64_t t = turn.stage_us[s];
+            int n = snprintf(line + len, sizeof(line) - len, "%s%lld", (s == 0) ? "" : ",",
+                             (t != 0) ? (long long)(t - base) : -1LL);
+            len = (n < 0) ? n : (len + n);
+        }
+        if ((len >= 0) && (len < (int)sizeof(line))) {
+            int n = snprintf(line + len, sizeof(line) - len, "]}");
+            len = (n < 0) ? n : (len + n);
+        }
+        /* A cut line is not valid JSON, drop the turn rather than print it */
+        if ((len < 0) || (len >= (int)sizeof(line))) {
+            ESP_LOGE(TAG, "Turn(%u) does not fit in a JSON line(%d), skipped", (unsigned)turn.id, (int)sizeof(line));
+            continue;
+        }
+        ESP_LOGI(TAG, "%s", line);
+    }
+
+    for (size_t i = 0; i < sizeof(report_intervals) / sizeof(report_intervals[0]); i++) {
+        agent_telemetry_stats_t stats;
+        agent_telemetry_get_stats(report_intervals[i][0], report_intervals[i][1], &stats);
+        ESP_LOGI(
+            TAG, "{\"from\":\"%s\",\"to\":\"%s\",\"n\":%u,\"min\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u}",
+            agent_telemetry_stage_to_str(report_intervals[i][0]), agent_telemetry_stage_to_str(report_intervals[i][1]),
+            stats.count, (unsigned)stats.min_us, (unsigned)stats.p50_us, (unsigned)stats.p90_us,
+            (unsigned)stats.p99_us, (unsigned)stats.max_us
+        );
+    }
+}
+
+static void dump_binary(void)
+{
+    size_t length = 0;
+    agent_telemetry_export_binary(NULL, 0, &length);
+
+    uint8_t *buffer = malloc(length);
+    if (buffer == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate export buffer(%d)", (int)length);
+        return;
+    }
+    // The ring may have grown in between, in which case the export simply fails and is reported
+    if (agent_telemetry_export_binary(buffer, length, &length) != ESP_OK) {
+        ESP_LOGW(TAG, "Telemetry changed during export, try again");
+        free(buffer);
+        return;
+    }
+
+    char hex[TELEMETRY_HEX_LINE_BYTES * 2 + 1];
+    for (size_t offset = 0; offset < length; offset += TELEMETRY_HEX_LINE_BYTES) {
+        size_t n = ((length - offset) < TELEMETRY_HEX_LINE_BYTES) ? (length - offset) : TELEMETRY_HEX_LINE_BYTES;
+        for (size_t i = 0; i < n; i++) {
+            sprintf(hex + 2 * i, "%02x", buffer[offset + i]);
+        }
+        ESP_LOGI(TAG, "AT:%04x:%s", (unsigned)offset, hex);
+    }
+    free(buffer);
+}
+
+void agent_telemetry_dump(agent_telemetry_format_t format)
+{
+    switch (format) {
+    case AGENT_TELEMETRY_FORMAT_JSON:
+        dump_json();
+        break;
+    case AGENT_TELEMETRY_FORMAT_BINARY:
+        dump_binary();
+        break;
+    default:
+        ESP_LOGE(TAG, "Invalid format(%d)", format);
+        break;
+    }
+}
+
+const char *agent_telemetry_stage_to_str(agent_telemetry_stage_t stage)
+{
+    switch (stage) {
+    case AGENT_TELEMETRY_STAGE_WAKE_WORD:
+        return "wake_word";
+    case AGENT_TELEMETRY_STAGE_VAD_END:
+        return "vad_end";
+    case AGENT_TELEMETRY_STAGE_LAST_UPLINK:
+        return "last_uplink";
+    case AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK:
+        return "first_downlink";
+    case AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK:
+        return "first_playback";
+    case AGENT_TELEMETRY_STAGE_SUBTITLE:
+        return "subtitle";
+    case AGENT_TELEMETRY_STAGE_COMPLETED:
+        return "completed";
+    default:
+        return "unknown";
+    }
+}
+
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY */
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_brookesia_ai_framework_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Stages of a conversation turn, in the order they normally happen
+ */
+typedef enum {
+    AGENT_TELEMETRY_STAGE_WAKE_WORD = 0,    /*!< Wake word detected by the AFE */
+    AGENT_TELEMETRY_STAGE_VAD_END,          /*!< End of user speech reported by the VAD */
+    AGENT_TELEMETRY_STAGE_LAST_UPLINK,      /*!< Last uplink audio packet sent to the server */
+    AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK,   /*!< First downlink audio or `CHAT_CUSTOMER_DATA` packet received */
+    AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK,   /*!< First decoded sample written to the codec */
+    AGENT_TELEMETRY_STAGE_SUBTITLE,         /*!< First subtitle event received */
+    AGENT_TELEMETRY_STAGE_COMPLETED,        /*!< Server reported the chat as completed */
+    AGENT_TELEMETRY_STAGE_MAX,
+} agent_telemetry_stage_t;
+
+/**
+ * @brief  Export formats supported by `agent_telemetry_dump()`
+ */
+typedef enum {
+    AGENT_TELEMETRY_FORMAT_JSON = 0,    /*!< One JSON object per turn plus one for the aggregated statistics */
+    AGENT_TELEMETRY_FORMAT_BINARY,      /*!< Hex encoded output of `agent_telemetry_export_binary()` */
+} agent_telemetry_format_t;
+
+/**
+ * @brief  Timeline of one conversation turn
+ *
+ * @note  Timestamps are `esp_timer_get_time()` values in microseconds, `0` means the stage was not reached
+ */
+typedef struct {
+    uint32_t id;                                    /*!< Monotonically increasing turn id */
+    int64_t  stage_us[AGENT_TELEMETRY_STAGE_MAX];   /*!< Timestamp of each stage */
+} agent_telemetry_turn_t;
+
+/**
+ * @brief  Aggregated statistics of the interval between two stages over the recorded turns
+ */
+typedef struct {
+    uint16_t count;     /*!< Number of turns where both stages were reached */
+    uint32_t min_us;
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} agent_telemetry_stats_t;
+
+#if ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY
+
+/**
+ * @brief  Record a stage of the current turn at the current time
+ *
+ * @note  `AGENT_TELEMETRY_STAGE_WAKE_WORD` always opens a new turn, `AGENT_TELEMETRY_STAGE_VAD_END` opens a new turn
+ *        when the current one already got a reply. "First" stages only keep their earliest timestamp, while
+ *        `AGENT_TELEMETRY_STAGE_LAST_UPLINK` keeps the latest one. Safe to call from any task.
+ *
+ * @param[in]  stage  Stage to record
+ */
+void agent_telemetry_mark(agent_telemetry_stage_t stage);
+
+/**
+ * @brief  Same as `agent_telemetry_mark()` but with an explicit timestamp, mainly for replaying traces in tests
+ *
+ * @param[in]  stage      Stage to record
+ * @param[in]  timestamp  Monotonic timestamp in microseconds, must be non-zero
+ */
+void agent_telemetry_mark_at(agent_telemetry_stage_t stage, int64_t timestamp);
+
+/**
+ * @brief  Drop all recorded turns
+ */
+void agent_telemetry_reset(void);
+
+/**
+ * @brief  Get the number of turns currently held in the ring (including the one in progress)
+ *
+ * @return  Number of turns
+ */
+size_t agent_telemetry_get_turn_count(void);
+
+/**
+ * @brief  Get a recorded turn
+ *
+ * @param[in]   index  Index counted from the most recent turn, `0` is the latest one
+ * @param[out]  turn   Copy of the turn
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_INVALID_ARG    If `turn` is NULL
+ *       - ESP_ERR_NOT_FOUND      If `index` is out of range
+ */
+esp_err_t agent_telemetry_get_turn(size_t index, agent_telemetry_turn_t *turn);
+
+/**
+ * @brief  Compute the statistics of the interval `from` -> `to` over all recorded turns
+ *
+ * @param[in]   from   Start stage
+ * @param[in]   to     End stage
+ * @param[out]  stats  Aggregated statistics, `count` is 0 when no turn reached both stages
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_INVALID_ARG    If the stages are invalid or `stats` is NULL
+ */
+esp_err_t agent_telemetry_get_stats(agent_telemetry_stage_t from, agent_telemetry_stage_t to,
+                                    agent_telemetry_stats_t *stats);
+
+/**
+ * @brief  Serialize all recorded turns into a compact binary blob
+ *
+ * @note  Layout (little endian): `"AT"`, version(u8), stage number(u8), turn number(u16), then for each turn its
+ *        id(u32), base timestamp(u64) and one u32 offset per stage relative to the base (`UINT32_MAX` = missing)
+ *
+ * @param[out]  buffer  Destination buffer, can be NULL to only query the required size
+ * @param[in]   size    Size of `buffer`
+ * @param[out]  length  Number of bytes written, or required when `buffer` is NULL
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_INVALID_ARG    If `length` is NULL
+ *       - ESP_ERR_INVALID_SIZE   If `buffer` is too small
+ */
+esp_err_t agent_telemetry_export_binary(uint8_t *buffer, size_t size, size_t *length);
+
+/**
+ * @brief  Print all recorded turns and the aggregated statistics over the log channel
+ *
+ * @param[in]  format  Output format
+ */
+void agent_telemetry_dump(agent_telemetry_format_t format);
+
+/**
+ * @brief  Get the name of a stage
+ *
+ * @param[in]  stage  Stage
+ *
+ * @return  Stage name, never NULL
+ */
+const char *agent_telemetry_stage_to_str(agent_telemetry_stage_t stage);
+
+#else
+
+static inline void agent_telemetry_mark(agent_telemetry_stage_t stage)
+{
+    (void)stage;
+}
+
+static inline void agent_telemetry_mark_at(agent_telemetry_stage_t stage, int64_t timestamp)
+{
+    (void)stage;
+    (void)timestamp;
+}
+
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY */
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -0,0 +1,290 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "audio_jitter_buffer.h"
+
+/* Weights of the lateness estimator, it follows a late packet quickly and forgets it slowly */
+#define LATE_ATTACK_SHIFT   (1)
+#define LATE_DECAY_SHIFT    (5)
+
+typedef enum {
+    JB_STATE_BUFFERING = 0,
+    JB_STATE_PLAYING,
+} jb_state_t;
+
+struct audio_jitter_buffer {
+    audio_jitter_buffer_cfg_t cfg;
+    uint8_t  *storage;          /* `packet_num` slots for the queue plus one for the last played packet */
+    uint16_t *lens;
+    uint16_t  head;
+    uint16_t  count;
+    uint16_t  last_len;
+    jb_state_t state;
+    uint8_t   conceal_run;
+    bool      starving;
+    bool      spurt_active;
+    bool      buffering_started;
+    bool      end_marked;
+    uint32_t  spurt_index;
+    int64_t   min_transit_us;
+    int64_t   last_arrival_us;
+    int64_t   starve_since_us;
+    int64_t   buffering_since_us;
+    int64_t   late_est_us;
+    int64_t   latency_sum_us;
+    uint32_t  latency_num;
+    audio_jitter_buffer_stats_t stats;
+};
+
+static inline uint8_t *slot_at(audio_jitter_buffer_handle_t jb, uint16_t slot)
+{
+    return jb->storage + (size_t)slot * jb->cfg.packet_size;
+}
+
+static inline uint8_t *last_slot(audio_jitter_buffer_handle_t jb)
+{
+    return slot_at(jb, jb->cfg.packet_num);
+}
+
+static int64_t get_target_delay_us(audio_jitter_buffer_handle_t jb)
+{
+    int64_t target = jb->late_est_us + jb->late_est_us / 2;
+    int64_t min = (int64_t)jb->cfg.min_delay_ms * 1000;
+    int64_t max = (int64_t)jb->cfg.max_delay_ms * 1000;
+    if (target < min) {
+        target = min;
+    }
+    if (target > max) {
+        target = max;
+    }
+    return target;
+}
+
+static void update_lateness(audio_jitter_buffer_handle_t jb, int64_t now_us)
+{
+    int64_t frame_us = (int64_t)jb->cfg.frame_ms * 1000;
+    bool new_spurt = !jb->spurt_active || ((now_us - jb->last_arrival_us) > (int64_t)jb->cfg.max_delay_ms * 1000);
+
+    if (jb->starving && !new_spurt) {
+        jb->stats.underruns++;
+    }
+    jb->starving = false;
+
+    /* Packets of a talk spurt are produced at the frame rate, so `arrival - index * frame` is the transit time up to a
+     * constant. How much it exceeds the smallest transit seen in the spurt is the delay needed to play that packet in
+     * time. Packets arriving in a burst only lower the minimum and never raise the estimate. */
+    if (new_spurt) {
+        jb->spurt_active = true;
+        jb->spurt_index = 0;
+        jb->min_transit_us = now_us;
+    }
+    int64_t transit = now_us - (int64_t)jb->spurt_index * frame_us;
+    if (transit < jb->min_transit_us) {
+        jb->min_transit_us = transit;
+    }
+    int64_t late = transit - jb->min_transit_us;
+    if (late > jb->late_est_us) {
+        jb->late_est_us += (late - jb->late_est_us) >> LATE_ATTACK_SHIFT;
+    } else {
+        jb->late_est_us -= (jb->late_est_us - late) >> LATE_DECAY_SHIFT;
+    }
+    jb->spurt_index++;
+    jb->last_arrival_us = now_us;
+}
+
+esp_err_t audio_jitter_buffer_create(const audio_jitter_buffer_cfg_t *cfg, audio_jitter_buffer_handle_t *handle)
+{
+    if ((cfg == NULL) || (handle == NULL) || (cfg->packet_num == 0) || (cfg->packet_size == 0) ||
+            (cfg->frame_ms == 0) || (cfg->min_delay_ms > cfg->max_delay_ms)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    audio_jitter_buffer_handle_t jb = calloc(1, sizeof(struct audio_jitter_buffer));
+    if (jb == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    jb->cfg = *cfg;
+    jb->storage = malloc(((size_t)cfg->packet_num + 1) * cfg->packet_size);
+    jb->lens = calloc(cfg->packet_num, sizeof(uint16_t));
+    if ((jb->storage == NULL) || (jb->lens == NULL)) {
+        audio_jitter_buffer_destroy(jb);
+        return ESP_ERR_NO_MEM;
+    }
+    *handle = jb;
+
+    return ESP_OK;
+}
+
+void audio_jitter_buffer_destroy(audio_jitter_buffer_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    free(handle->storage);
+    free(handle->lens);
+    free(handle);
+}
+
+esp_err_t audio_jitter_buffer_push(audio_jitter_buffer_handle_t handle, const uint8_t *data, size_t len,
+                                   int64_t now_us)
+{
+    if ((handle == NULL) || (data == NULL) || (len == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (len > handle->cfg.packet_size) {
+        handle->stats.dropped++;
+        handle->stats.oversized++;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    handle->stats.received++;
+    handle->end_marked = false;
+    update_lateness(handle, now_us);
+
+    if (handle->count == handle->cfg.packet_num) {
+        /* Keep the latency bounded, the oldest packet is the least useful one */
+        handle->head = (handle->head + 1) % handle->cfg.packet_num;
+        handle->count--;
+        handle->stats.dropped++;
+    }
+    uint16_t slot = (handle->head + handle->count) % handle->cfg.packet_num;
+    memcpy(slot_at(handle, slot), data, len);
+    handle->lens[slot] = (uint16_t)len;
+    handle->count++;
+
+    if ((handle->state == JB_STATE_BUFFERING) && !handle->buffering_started) {
+        handle->buffering_started = true;
+        handle->buffering_since_us = now_us;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t audio_jitter_buffer_pull(audio_jitter_buffer_handle_t handle, uint8_t *buffer, size_t size, int64_t now_us,
+                                   size_t *len, audio_jitter_buffer_pull_result_t *result)
+{
+    if ((handle == NULL) || (buffer == NULL) || (len == NULL) || (result == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *len = 0;
+    *result = AUDIO_JITTER_BUFFER_PULL_WAIT;
+
+    if (handle->state == JB_STATE_BUFFERING) {
+        if (handle->count == 0) {
+            return ESP_OK;
+        }
+        int64_t target = get_target_delay_us(handle);
+        /* Audio queued behind the packet about to be played */
+        int64_t buffered = (int64_t)(handle->count - 1) * handle->cfg.frame_ms * 1000;
+        if ((buffered < target) && ((now_us - handle->buffering_since_us) < target)) {
+            return ESP_OK;
+        }
+        int64_t latency = now_us - handle->buffering_since_us;
+        handle->latency_sum_us += latency;
+        handle->latency_num++;
+        if ((uint32_t)(latency / 1000) > handle->stats.max_added_latency_ms) {
+            handle->stats.max_added_latency_ms = (uint32_t)(latency / 1000);
+        }
+        handle->buffering_started = false;
+        handle->state = JB_STATE_PLAYING;
+    }
+
+    if (handle->count > 0) {
+        uint16_t slot = handle->head;
+        uint16_t packet_len = handle->lens[slot];
+        handle->head = (handle->head + 1) % handle->cfg.packet_num;
+        handle->count--;
+        if (packet_len > size) {
+            handle->stats.dropped++;
+            handle->stats.oversized++;
+            return ESP_ERR_INVALID_SIZE;
+        }
+        memcpy(buffer, slot_at(handle, slot), packet_len);
+        memcpy(last_slot(handle), buffer, packet_len);
+        handle->last_len = packet_len;
+        handle->conceal_run = 0;
+        handle->stats.played++;
+        *len = packet_len;
+        *result = AUDIO_JITTER_BUFFER_PULL_PACKET;
+        return ESP_OK;
+    }
+
+    /* The sender said the talk spurt is over, repeating its last packet would only add an echo at the end */
+    if (handle->end_marked) {
+        handle->last_len = 0;
+        handle->conceal_run = 0;
+        handle->spurt_active = false;
+        handle->state = JB_STATE_BUFFERING;
+        return ESP_OK;
+    }
+
+    /* Ran dry while playing, either a network gap or the end of the talk spurt. Which one it was is only known when
+     * (and if) the next packet arrives, see `update_lateness()` */
+    if (!handle->starving) {
+        handle->starving = true;
+        handle->starve_since_us = now_us;
+    }
+    if ((handle->conceal_run < handle->cfg.max_conceal_num) && (handle->last_len > 0) &&
+            (handle->last_len <= size)) {
+        memcpy(buffer, last_slot(handle), handle->last_len);
+        handle->conceal_run++;
+        handle->stats.concealed++;
+        *len = handle->last_len;
+        *result = AUDIO_JITTER_BUFFER_PULL_CONCEALED;
+        return ESP_OK;
+    }
+    handle->conceal_run = 0;
+    handle->state = JB_STATE_BUFFERING;
+
+    return ESP_OK;
+}
+
+void audio_jitter_buffer_flush(audio_jitter_buffer_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    handle->stats.dropped += handle->count;
+    handle->head = 0;
+    handle->count = 0;
+    handle->last_len = 0;
+    handle->state = JB_STATE_BUFFERING;
+    handle->conceal_run = 0;
+    handle->starving = false;
+    handle->spurt_active = false;
+    handle->buffering_started = false;
+    handle->end_marked = false;
+}
+
+void audio_jitter_buffer_mark_end(audio_jitter_buffer_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    handle->end_marked = true;
+}
+
+size_t audio_jitter_buffer_get_buffered_num(audio_jitter_buffer_handle_t handle)
+{
+    return (handle == NULL) ? 0 : handle->count;
+}
+
+esp_err_t audio_jitter_buffer_get_stats(audio_jitter_buffer_handle_t handle, audio_jitter_buffer_stats_t *stats)
+{
+    if ((handle == NULL) || (stats == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = handle->stats;
+    stats->jitter_ms = (uint32_t)(handle->late_est_us / 1000);
+    stats->target_delay_ms = (uint32_t)(get_target_delay_us(handle) / 1000);
+    stats->avg_added_latency_ms = (handle->latency_num == 0) ? 0 :
+                                  (uint32_t)(handle->latency_sum_us / handle->latency_num / 1000);
+
+    return ESP_OK;
+}
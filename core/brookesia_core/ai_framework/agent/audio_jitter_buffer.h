@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_brookesia_ai_framework_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Handle of an adaptive jitter buffer
+ *
+ * @note  The buffer holds whole encoded packets and never looks into their content. It has no clock and no lock of its
+ *        own: every call takes the current monotonic time, and the caller is responsible for serializing the calls.
+ *        This keeps the playout logic deterministic so it can be driven by recorded arrival traces on the host.
+ */
+typedef struct audio_jitter_buffer *audio_jitter_buffer_handle_t;
+
+/**
+ * @brief  Configuration of the jitter buffer
+ */
+typedef struct {
+    uint16_t packet_num;        /*!< Maximum number of buffered packets, the oldest one is dropped on overflow */
+    uint16_t packet_size;       /*!< Maximum size of one packet in bytes */
+    uint16_t frame_ms;          /*!< Nominal playback duration of one packet */
+    uint16_t min_delay_ms;      /*!< Lower bound of the adaptive playout delay */
+    uint16_t max_delay_ms;      /*!< Upper bound of the adaptive playout delay, also the longest gap that is still
+                                     considered part of the same talk spurt */
+    uint8_t  max_conceal_num;   /*!< Maximum number of packets concealed in a row before rebuffering */
+} audio_jitter_buffer_cfg_t;
+
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+/**
+ * @brief  Default configuration taken from menuconfig
+ */
+#define AUDIO_JITTER_BUFFER_DEFAULT_CONFIG() {                                     \
+    .packet_num = ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_NUM,                    \
+    .packet_size = ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_SIZE,                  \
+    .frame_ms = ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS,                        \
+    .min_delay_ms = ESP_BROOKESIA_AGENT_JITTER_BUFFER_MIN_DELAY_MS,                \
+    .max_delay_ms = ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_DELAY_MS,                \
+    .max_conceal_num = ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM,          \
+}
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
+
+/**
+ * @brief  Result of `audio_jitter_buffer_pull()`
+ */
+typedef enum {
+    AUDIO_JITTER_BUFFER_PULL_WAIT = 0,  /*!< Nothing to play yet, the buffer is filling up to its target delay */
+    AUDIO_JITTER_BUFFER_PULL_PACKET,    /*!< A received packet was returned */
+    AUDIO_JITTER_BUFFER_PULL_CONCEALED, /*!< The buffer ran dry, the last packet was returned again to cover the gap */
+} audio_jitter_buffer_pull_result_t;
+
+/**
+ * @brief  Statistics of the jitter buffer
+ */
+typedef struct {
+    uint32_t received;              /*!< Packets pushed */
+    uint32_t played;                /*!< Received packets pulled */
+    uint32_t concealed;             /*!< Concealment packets pulled */
+    uint32_t dropped;               /*!< Packets dropped because of overflow, oversize or flush */
+    uint32_t oversized;             /*!< Packets dropped because they didn't fit, also counted in `dropped` */
+    uint32_t underruns;             /*!< Gaps inside a talk spurt where the buffer ran dry */
+    uint32_t jitter_ms;             /*!< Current lateness estimate */
+    uint32_t target_delay_ms;       /*!< Current target playout delay */
+    uint32_t avg_added_latency_ms;  /*!< Average wait between the first packet of a (re)buffering phase and its
+                                         playout */
+    uint32_t max_added_latency_ms;  /*!< Maximum of the above */
+} audio_jitter_buffer_stats_t;
+
+/**
+ * @brief  Create a jitter buffer
+ *
+ * @param[in]   cfg     Configuration
+ * @param[out]  handle  Created handle
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_INVALID_ARG    If an argument or the configuration is invalid
+ *       - ESP_ERR_NO_MEM         If the packet storage can't be allocated
+ */
+esp_err_t audio_jitter_buffer_create(const audio_jitter_buffer_cfg_t *cfg, audio_jitter_buffer_handle_t *handle);
+
+/**
+ * @brief  Destroy a jitter buffer
+ *
+ * @param[in]  handle  Handle, can be NULL
+ */
+void audio_jitter_buffer_destroy(audio_jitter_buffer_handle_t handle);
+
+/**
+ * @brief  Push a received packet
+ *
+ * @param[in]  handle  Handle
+ * @param[in]  data    Packet data
+ * @param[in]  len     Packet length
+ * @param[in]  now_us  Arrival time in microseconds
+ *
+ * @return
+ *       - ESP_OK                 On success, an older packet may have been dropped to make room
+ *       - ESP_ERR_INVALID_ARG    If an argument is invalid
+ *       - ESP_ERR_INVALID_SIZE   If the packet is larger than `packet_size`, it is dropped and counted in
+ *                                `oversized`
+ */
+esp_err_t audio_jitter_buffer_push(audio_jitter_buffer_handle_t handle, const uint8_t *data, size_t len,
+                                   int64_t now_us);
+
+/**
+ * @brief  Pull the next packet to play
+ *
+ * @param[in]   handle  Handle
+ * @param[out]  buffer  Destination buffer, should be at least `packet_size` bytes
+ * @param[in]   size    Size of `buffer`
+ * @param[in]   now_us  Current time in microseconds
+ * @param[out]  len     Length of the returned packet, 0 when the result is `AUDIO_JITTER_BUFFER_PULL_WAIT`
+ * @param[out]  result  What was returned
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_INVALID_ARG    If an argument is invalid
+ *       - ESP_ERR_INVALID_SIZE   If `buffer` is too small for the next packet, the packet is dropped and counted
+ *                                in `oversized`
+ */
+esp_err_t audio_jitter_buffer_pull(audio_jitter_buffer_handle_t handle, uint8_t *buffer, size_t size, int64_t now_us,
+                                   size_t *len, audio_jitter_buffer_pull_result_t *result);
+
+/**
+ * @brief  Drop every buffered packet and go back to the buffering state, used when the conversation is interrupted
+ *
+ * @note  The jitter estimate is kept, so the next talk spurt starts with the learned delay
+ *
+ * @param[in]  handle  Handle
+ */
+void audio_jitter_buffer_flush(audio_jitter_buffer_handle_t handle);
+
+/**
+ * @brief  Mark the end of the current talk spurt, once the buffered packets are played the buffer goes back to
+ *         buffering instead of concealing a gap that will never be filled
+ *
+ * @note  The mark is cleared by the next push
+ *
+ * @param[in]  handle  Handle
+ */
+void audio_jitter_buffer_mark_end(audio_jitter_buffer_handle_t handle);
+
+/**
+ * @brief  Get the number of buffered packets
+ *
+ * @param[in]  handle  Handle
+ *
+ * @return  Number of packets
+ */
+size_t audio_jitter_buffer_get_buffered_num(audio_jitter_buffer_handle_t handle);
+
+/**
+ * @brief  Get the statistics
+ *
+ * @param[in]   handle  Handle
+ * @param[out]  stats   Statistics
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_INVALID_ARG    If an argument is invalid
+ */
+esp_err_t audio_jitter_buffer_get_stats(audio_jitter_buffer_handle_t handle, audio_jitter_buffer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -9,13 +9,14 @@
 #include <math.h>
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "esp_gmf_element.h"
 #include "esp_gmf_pool.h"
 #include "esp_gmf_io.h"
 #include "esp_gmf_pipeline.h"
-#include "esp_gmf_ringbuffer.h"
 #include "esp_gmf_pool.h"
 #include "esp_gmf_rate_cvt.h"
 #include "esp_g711_enc.h"
@@ -26,8 +27,14 @@
 #include "esp_gmf_setup_peripheral.h"
 #include "esp_codec_dev.h"
 #include "esp_gmf_fifo.h"
-
+/* The SPSC ring buffer only ships with the gmf_core copies of the products, the registry release has the locked one */
+#if __has_include("esp_gmf_spsc_ringbuffer.h")
+#include "esp_gmf_spsc_ringbuffer.h"
+#define RECORDER_USE_SPSC_RB    (1)
+#else
 #include "esp_gmf_ringbuffer.h"
+#define RECORDER_USE_SPSC_RB    (0)
+#endif  /* __has_include("esp_gmf_spsc_ringbuffer.h") */
 
 #ifndef CONFIG_KEY_PRESS_DIALOG_MODE
 #include "esp_vad.h"
@@ -35,11 +42,14 @@
 #include "esp_gmf_afe_manager.h"
 #include "esp_gmf_afe.h"
 #endif  /* CONFIG_KEY_PRESS_DIALOG_MODE */
+#include "agent_telemetry.h"
+#include "audio_jitter_buffer.h"
 #include "audio_processor.h"
 
-#define VAD_ENABLE       (true)
-#define VCMD_ENABLE      (false)
-#define DEFAULT_FIFO_NUM (5)
+#define VAD_ENABLE              (true)
+#define VCMD_ENABLE             (false)
+#define DEFAULT_FIFO_NUM        (5)
+#define DEFAULT_FIFO_BLOCK_SIZE (1024)  // Preallocated for each FIFO node, a larger frame grows the node buffer once
 
 #define DEFAULT_PLAYBACK_VOLUME (70)
 
@@ -52,6 +62,10 @@
 
 #define AFE_WAKEUP_END_MS       (30000)
 
+#define JITTER_BUFFER_POLL_MS   (10)
+#define PLAYBACK_GAIN_UNITY     (256)
+#define PLAYBACK_GAIN_QUEUE_LEN (8)
+
 static char *TAG = "AUDIO_PROCESSOR";
 
 typedef struct {
@@ -73,9 +87,28 @@ typedef struct {
 } audio_recordert_t;
 
 typedef struct {
-    esp_asp_handle_t          player;
-    esp_gmf_fifo_handle_t     fifo;
-    enum audio_player_state_e state;
+    esp_asp_handle_t              player;
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+    audio_jitter_buffer_handle_t  jitter_buffer;
+    SemaphoreHandle_t             jitter_lock;
+    SemaphoreHandle_t             jitter_data_sem;
+    /* Q8 gains of the pulled packets not decoded yet, lowered while the jitter buffer conceals a gap. Taken under
+     * `jitter_lock`, `gain_pull` is the gain of the last pulled packet */
+    uint16_t                      gain_queue[PLAYBACK_GAIN_QUEUE_LEN];
+    uint8_t                       gain_queue_head;
+    uint8_t                       gain_queue_num;
+    int                           gain_pull;
+    /* Ramp of the decoded packet being written, from `gain` to `gain_to` over the samples of one packet */
+    int                           gain;
+    int                           gain_to;
+    int                           gain_left;    /* Samples of the packet not written yet */
+    volatile int                  sample_rate;
+    volatile int                  channels;
+    volatile int                  bits;
+#else
+    esp_gmf_fifo_handle_t         fifo;
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
+    enum audio_player_state_e     state;
 } audio_playback_t;
 
 typedef struct {
@@ -86,7 +119,12 @@ typedef struct {
 
 #define AUDIO_BUFFER_SIZE   1024 * sizeof(int16_t)
 #define GAUSSIAN_SIGMA      1.0  // Gaussian filter standard deviation
+/* Encoded audio from the recorder pipeline task to the reader task, so it is a single producer/consumer buffer */
+#if RECORDER_USE_SPSC_RB
+static esp_gmf_spsc_rb_handle_t out_rb = NULL;
+#else
 static esp_gmf_rb_handle_t out_rb = NULL;
+#endif  /* RECORDER_USE_SPSC_RB */
 float *gaussian_weights;
 
 static audio_manager_t   audio_manager;
@@ -163,7 +201,11 @@ static esp_err_t recorder_pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
 
 static int recorder_outport_acquire_write(void *handle, esp_gmf_data_bus_block_t *blk, int wanted_size, int block_ticks)
 {
+#if RECORDER_USE_SPSC_RB
+    // The encoder writes to the port buffer, which is copied to `out_rb` on release
+#else
     esp_gmf_rb_acquire_write(out_rb, blk, wanted_size, block_ticks);
+#endif  /* RECORDER_USE_SPSC_RB */
     return wanted_size;
 }
 
@@ -175,7 +217,11 @@ static int recorder_outport_release_write(void *handle, esp_gmf_data_bus_block_t
     } else {
         printf("||||| release write, valid_size: %d\n", blk->valid_size);
     }
+#if RECORDER_USE_SPSC_RB
+    esp_gmf_spsc_rb_write(out_rb, blk->buf, blk->valid_size, portMAX_DELAY);
+#else
     esp_gmf_rb_release_write(out_rb, blk, portMAX_DELAY);
+#endif  /* RECORDER_USE_SPSC_RB */
     return ret;
 }
 
@@ -202,6 +248,7 @@ static void esp_gmf_afe_event_cb(esp_gmf_obj_handle_t obj, esp_gmf_afe_evt_t *ev
         esp_gmf_afe_vcmd_detection_begin(obj);
 #endif  /* CONFIG_LANGUAGE_WAKEUP_MODE */
         esp_gmf_afe_wakeup_info_t *info = event->event_data;
+        agent_telemetry_mark(AGENT_TELEMETRY_STAGE_WAKE_WORD);
         ESP_LOGI(TAG, "WAKEUP_START [%d : %d]", info->wake_word_index, info->wakenet_model_index);
         break;
     }
@@ -224,6 +271,7 @@ static void esp_gmf_afe_event_cb(esp_gmf_obj_handle_t obj, esp_gmf_afe_evt_t *ev
 #ifndef CONFIG_LANGUAGE_WAKEUP_MODE
         esp_gmf_afe_vcmd_detection_cancel(obj);
 #endif  /* CONFIG_LANGUAGE_WAKEUP_MODE */
+        agent_telemetry_mark(AGENT_TELEMETRY_STAGE_VAD_END);
         ESP_LOGI(TAG, "VAD_END");
         break;
     }
@@ -243,7 +291,11 @@ static void esp_gmf_afe_event_cb(esp_gmf_obj_handle_t obj, esp_gmf_afe_evt_t *ev
 
 esp_err_t audio_recorder_open(recorder_event_callback_t cb, void *ctx)
 {
+#if RECORDER_USE_SPSC_RB
+    esp_gmf_spsc_rb_create(1, 1024 * 3, &out_rb);
+#else
     esp_gmf_rb_create(1, 1024 * 3, &out_rb);
+#endif  /* RECORDER_USE_SPSC_RB */
 #if CONFIG_KEY_PRESS_DIALOG_MODE
     (void)cb;
     (void)ctx;
@@ -299,6 +351,10 @@ esp_err_t audio_recorder_open(recorder_event_callback_t cb, void *ctx)
                                    2048,
                                    100);
     esp_gmf_pipeline_reg_el_port(audio_recorder.pipe, "ai_afe", ESP_GMF_IO_DIR_READER, import);
+    // Take the port payloads from one preallocated pool, so the running recorder does not allocate
+    if (esp_gmf_pipeline_setup_payload_pool(audio_recorder.pipe, 0) != ESP_GMF_ERR_OK) {
+        ESP_LOGW(TAG, "Recorder payload pool setup failed, allocate the payloads on demand");
+    }
 
     esp_gmf_obj_handle_t rate_cvt = NULL;
     esp_gmf_pipeline_get_el_by_name(audio_recorder.pipe, "rate_cvt", &rate_cvt);
@@ -323,6 +379,9 @@ esp_err_t audio_recorder_open(recorder_event_callback_t cb, void *ctx)
     esp_gmf_task_init(&cfg, &audio_recorder.task);
     esp_gmf_pipeline_bind_task(audio_recorder.pipe, audio_recorder.task);
     esp_gmf_pipeline_loading_jobs(audio_recorder.pipe);
+#if ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS > 0
+    esp_gmf_pipeline_set_prof_log(audio_recorder.pipe, ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS);
+#endif  /* ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS > 0 */
     esp_gmf_pipeline_set_event(audio_recorder.pipe, recorder_pipeline_event, NULL);
     esp_gmf_pipeline_run(audio_recorder.pipe);
 
@@ -360,6 +419,10 @@ esp_err_t audio_recorder_read_data(uint8_t *data, int data_size)
 #if CONFIG_KEY_PRESS_DIALOG_MODE
     esp_codec_dev_read(audio_manager.rec_dev, data, data_size);
     return data_size;
+#else
+#if RECORDER_USE_SPSC_RB
+    // Wakes up once the whole `data_size` is there, and copies straight out of the ring buffer
+    return esp_gmf_spsc_rb_read(out_rb, data, data_size, portMAX_DELAY);
 #else
     esp_gmf_data_bus_block_t blk;
     blk.buf = malloc(data_size);
@@ -372,9 +435,148 @@ esp_err_t audio_recorder_read_data(uint8_t *data, int data_size)
     esp_gmf_rb_release_read(out_rb, &blk, portMAX_DELAY);
     free(blk.buf);
     return blk.valid_size;
+#endif  /* RECORDER_USE_SPSC_RB */
 #endif  /* CONFIG_KEY_PRESS_DIALOG_MODE */
 }
 
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+esp_err_t audio_playback_feed_data(uint8_t *data, int data_size)
+{
+    xSemaphoreTake(audio_playback.jitter_lock, portMAX_DELAY);
+    esp_err_t err = audio_jitter_buffer_push(audio_playback.jitter_buffer, data, data_size, esp_timer_get_time());
+    xSemaphoreGive(audio_playback.jitter_lock);
+    if (err == ESP_ERR_INVALID_SIZE) {
+        // Counted in the `oversized` statistics of the jitter buffer
+        ESP_LOGD(TAG, "Jitter buffer dropped an oversized packet, size: %d", data_size);
+        return err;
+    } else if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Jitter buffer push failed (0x%x), size: %d", err, data_size);
+        return err;
+    }
+    xSemaphoreGive(audio_playback.jitter_data_sem);
+    return ESP_OK;
+}
+
+esp_err_t audio_playback_flush(void)
+{
+    audio_jitter_buffer_stats_t stats = {0};
+    xSemaphoreTake(audio_playback.jitter_lock, portMAX_DELAY);
+    audio_jitter_buffer_flush(audio_playback.jitter_buffer);
+    audio_jitter_buffer_get_stats(audio_playback.jitter_buffer, &stats);
+    audio_playback.gain_queue_num = 0;
+    audio_playback.gain_pull = PLAYBACK_GAIN_UNITY;
+    xSemaphoreGive(audio_playback.jitter_lock);
+    ESP_LOGD(TAG, "Jitter buffer flushed, played: %d, concealed: %d, dropped: %d, oversized: %d, underruns: %d, "
+             "target: %dms", (int)stats.played, (int)stats.concealed, (int)stats.dropped, (int)stats.oversized,
+             (int)stats.underruns, (int)stats.target_delay_ms);
+    return ESP_OK;
+}
+
+esp_err_t audio_playback_mark_end(void)
+{
+    xSemaphoreTake(audio_playback.jitter_lock, portMAX_DELAY);
+    audio_jitter_buffer_mark_end(audio_playback.jitter_buffer);
+    xSemaphoreGive(audio_playback.jitter_lock);
+    return ESP_OK;
+}
+
+/* Called with `jitter_lock` held, once per pulled packet */
+static void playback_push_gain(audio_jitter_buffer_pull_result_t result)
+{
+    if (result == AUDIO_JITTER_BUFFER_PULL_CONCEALED) {
+        int step = PLAYBACK_GAIN_UNITY / (ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM + 1);
+        audio_playback.gain_pull = (audio_playback.gain_pull > step) ? (audio_playback.gain_pull - step) : 0;
+    } else {
+        audio_playback.gain_pull = PLAYBACK_GAIN_UNITY;
+    }
+    if (audio_playback.gain_queue_num == PLAYBACK_GAIN_QUEUE_LEN) {
+        audio_playback.gain_queue_head = (audio_playback.gain_queue_head + 1) % PLAYBACK_GAIN_QUEUE_LEN;
+        audio_playback.gain_queue_num--;
+    }
+    int tail = (audio_playback.gain_queue_head + audio_playback.gain_queue_num) % PLAYBACK_GAIN_QUEUE_LEN;
+    audio_playback.gain_queue[tail] = (uint16_t)audio_playback.gain_pull;
+    audio_playback.gain_queue_num++;
+}
+
+/* Gain of the next decoded packet, unity once the queue was flushed */
+static int playback_pop_gain(void)
+{
+    int gain = PLAYBACK_GAIN_UNITY;
+    xSemaphoreTake(audio_playback.jitter_lock, portMAX_DELAY);
+    if (audio_playback.gain_queue_num > 0) {
+        gain = audio_playback.gain_queue[audio_playback.gain_queue_head];
+        audio_playback.gain_queue_head = (audio_playback.gain_queue_head + 1) % PLAYBACK_GAIN_QUEUE_LEN;
+        audio_playback.gain_queue_num--;
+    }
+    xSemaphoreGive(audio_playback.jitter_lock);
+    return gain;
+}
+
+static int playback_read_callback(uint8_t *data, int data_size, void *ctx)
+{
+    size_t len = 0;
+    audio_jitter_buffer_pull_result_t result = AUDIO_JITTER_BUFFER_PULL_WAIT;
+    while (true) {
+        xSemaphoreTake(audio_playback.jitter_lock, portMAX_DELAY);
+        esp_err_t err = audio_jitter_buffer_pull(audio_playback.jitter_buffer, data, data_size, esp_timer_get_time(),
+                        &len, &result);
+        if ((err == ESP_OK) && (result != AUDIO_JITTER_BUFFER_PULL_WAIT)) {
+            playback_push_gain(result);
+        }
+        xSemaphoreGive(audio_playback.jitter_lock);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Jitter buffer pull failed (0x%x)", err);
+            continue;
+        }
+        if (result != AUDIO_JITTER_BUFFER_PULL_WAIT) {
+            break;
+        }
+        xSemaphoreTake(audio_playback.jitter_data_sem, pdMS_TO_TICKS(JITTER_BUFFER_POLL_MS));
+    }
+    return (int)len;
+}
+
+/* Ramp the gain linearly over each decoded packet, so concealed packets fade out and real ones fade back in without
+ * clicks. The decoder outputs one frame per packet, whatever the size of the blocks it is written in */
+static void playback_apply_gain(uint8_t *data, int data_size)
+{
+    int bits = audio_playback.bits;
+    int packet_samples = ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS * audio_playback.sample_rate / 1000 *
+                         audio_playback.channels;
+    // Only the 16 and 32-bit PCM of the decoder are handled, other formats play without fading
+    if (((bits != 16) && (bits != 32)) || (packet_samples <= 0)) {
+        return;
+    }
+    int sample_num = data_size / (bits / 8);
+    for (int i = 0; i < sample_num;) {
+        if (audio_playback.gain_left == 0) {
+            audio_playback.gain = audio_playback.gain_to;
+            audio_playback.gain_to = playback_pop_gain();
+            audio_playback.gain_left = packet_samples;
+        }
+        audio_playback.gain_left = (audio_playback.gain_left < packet_samples) ? audio_playback.gain_left :
+                                   packet_samples;
+        int from = audio_playback.gain;
+        int to = audio_playback.gain_to;
+        int pos = packet_samples - audio_playback.gain_left;
+        int num = ((sample_num - i) < audio_playback.gain_left) ? (sample_num - i) : audio_playback.gain_left;
+        if ((from != PLAYBACK_GAIN_UNITY) || (to != PLAYBACK_GAIN_UNITY)) {
+            for (int j = 0; j < num; j++) {
+                int64_t gain = from + (int64_t)(to - from) * (pos + j) / packet_samples;
+                if (bits == 16) {
+                    int16_t *sample = (int16_t *)data + i + j;
+                    *sample = (int16_t)((*sample * gain) >> 8);
+                } else {
+                    int32_t *sample = (int32_t *)data + i + j;
+                    *sample = (int32_t)((*sample * gain) >> 8);
+                }
+            }
+        }
+        audio_playback.gain_left -= num;
+        i += num;
+    }
+}
+#else
 esp_err_t audio_playback_feed_data(uint8_t *data, int data_size)
 {
     esp_gmf_data_bus_block_t blk = {0};
@@ -389,6 +591,16 @@ esp_err_t audio_playback_feed_data(uint8_t *data, int data_size)
     return ESP_OK;
 }
 
+esp_err_t audio_playback_flush(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t audio_playback_mark_end(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 static int playback_read_callback(uint8_t *data, int data_size, void *ctx)
 {
     esp_gmf_data_bus_block_t blk = {0};
@@ -401,6 +613,7 @@ static int playback_read_callback(uint8_t *data, int data_size, void *ctx)
     esp_gmf_fifo_release_read(audio_playback.fifo, &blk, 0);
     return blk.valid_size;
 }
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
 
 static int playback_write_callback(uint8_t *data, int data_size, void *ctx)
 {
@@ -409,6 +622,10 @@ static int playback_write_callback(uint8_t *data, int data_size, void *ctx)
         return data_size;
     }
     esp_codec_dev_handle_t dev = (esp_codec_dev_handle_t)ctx;
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+    playback_apply_gain(data, data_size);
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
+    agent_telemetry_mark(AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK);
     int ret =  esp_codec_dev_write(dev, data, data_size);
     if (ret != ESP_CODEC_DEV_OK) {
         ESP_LOGE(TAG, "Write to codec dev failed (0x%x)\n", ret);
@@ -424,6 +641,11 @@ static int playback_event_callback(esp_asp_event_pkt_t *event, void *ctx)
         memcpy(&info, event->payload, event->payload_size);
         ESP_LOGI(TAG, "Get info, rate:%d, channels:%d, bits:%d", info.sample_rate,
                  info.channels, info.bits);
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+        audio_playback.sample_rate = info.sample_rate;
+        audio_playback.channels = info.channels;
+        audio_playback.bits = info.bits;
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
     } else if (event->type == ESP_ASP_EVENT_TYPE_STATE) {
         esp_asp_state_t st = ESP_ASP_STATE_NONE;
         memcpy(&st, event->payload, event->payload_size);
@@ -441,14 +663,38 @@ esp_err_t audio_playback_open(void)
     esp_err_t err = ESP_GMF_ERR_OK;
 
     do {
-        err = esp_gmf_fifo_create(DEFAULT_FIFO_NUM, 1, &audio_playback.fifo);
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+        audio_jitter_buffer_cfg_t jitter_cfg = AUDIO_JITTER_BUFFER_DEFAULT_CONFIG();
+        err = audio_jitter_buffer_create(&jitter_cfg, &audio_playback.jitter_buffer);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Jitter buffer init failed (0x%x)", err);
+            break;
+        }
+        audio_playback.jitter_lock = xSemaphoreCreateMutex();
+        audio_playback.jitter_data_sem = xSemaphoreCreateBinary();
+        if ((audio_playback.jitter_lock == NULL) || (audio_playback.jitter_data_sem == NULL)) {
+            ESP_LOGE(TAG, "Jitter buffer semaphore create failed");
+            err = ESP_ERR_NO_MEM;
+            break;
+        }
+        audio_playback.gain_queue_head = 0;
+        audio_playback.gain_queue_num = 0;
+        audio_playback.gain_pull = PLAYBACK_GAIN_UNITY;
+        audio_playback.gain = PLAYBACK_GAIN_UNITY;
+        audio_playback.gain_to = PLAYBACK_GAIN_UNITY;
+        audio_playback.gain_left = 0;
+#else
+        err = esp_gmf_fifo_create(DEFAULT_FIFO_NUM, DEFAULT_FIFO_BLOCK_SIZE, &audio_playback.fifo);
         if (err != ESP_GMF_ERR_OK) {
             ESP_LOGE(TAG, "oai_plr_dec_fifo init failed (0x%x)", err);
             break;
         }
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
         esp_asp_cfg_t player_cfg = {0};
         player_cfg.in.cb = playback_read_callback;
+#if !ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
         player_cfg.in.user_ctx = audio_playback.fifo;
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
         player_cfg.out.cb = playback_write_callback;
         player_cfg.out.user_ctx = audio_manager.play_dev;
         player_cfg.task_prio = 5;
@@ -474,9 +720,22 @@ esp_err_t audio_playback_open(void)
     if (audio_playback.player) {
         esp_audio_simple_player_destroy(audio_playback.player);
     }
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+    audio_jitter_buffer_destroy(audio_playback.jitter_buffer);
+    audio_playback.jitter_buffer = NULL;
+    if (audio_playback.jitter_lock) {
+        vSemaphoreDelete(audio_playback.jitter_lock);
+        audio_playback.jitter_lock = NULL;
+    }
+    if (audio_playback.jitter_data_sem) {
+        vSemaphoreDelete(audio_playback.jitter_data_sem);
+        audio_playback.jitter_data_sem = NULL;
+    }
+#else
     if (audio_playback.fifo) {
         esp_gmf_fifo_destroy(audio_playback.fifo);
     }
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
     return err;
 }
 
@@ -509,6 +768,11 @@ esp_err_t audio_playback_run(void)
     music_info.channels = 1;
     music_info.bits = 16;
     music_info.bitrate = 0;
+#if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+    audio_playback.sample_rate = music_info.sample_rate;
+    audio_playback.channels = music_info.channels;
+    audio_playback.bits = music_info.bits;
+#endif  /* ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER */
 
     esp_err_t err = esp_audio_simple_player_run(audio_playback.player, "raw://sdcard/coze.opus",
                     &music_info);
@@ -133,6 +133,25 @@ esp_err_t audio_playback_stop(void);
  */
 esp_err_t audio_playback_feed_data(uint8_t *data, int data_size);
 
+/**
+ * @brief  Drops the downlink audio buffered for playback, used when the conversation is interrupted
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_NOT_SUPPORTED  If the jitter buffer is disabled
+ */
+esp_err_t audio_playback_flush(void);
+
+/**
+ * @brief  Marks the end of the downlink audio of a reply, so the last packet is not repeated to cover a gap once the
+ *         buffered audio is played
+ *
+ * @return
+ *       - ESP_OK                 On success
+ *       - ESP_ERR_NOT_SUPPORTED  If the jitter buffer is disabled
+ */
+esp_err_t audio_playback_mark_end(void);
+
 /**
  * @brief  Opens the audio prompt system
  *
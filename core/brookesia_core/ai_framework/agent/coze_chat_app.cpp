@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <atomic>
 #include <mutex>
 #include <stdio.h>
 #include <string.h>
@@ -21,11 +22,14 @@
 #include "esp_gmf_oal_mem.h"
 #include "esp_coze_chat.h"
 #include "esp_coze_utils.h"
-#include "http_client_request.h"
 #include "boost/thread.hpp"
+#include "services/executor/esp_brookesia_service_executor.hpp"
 #include "private/esp_brookesia_ai_agent_utils.hpp"
+#include "agent_telemetry.h"
 #include "audio_processor.h"
 #include "function_calling.hpp"
+#include "coze_token_manager.hpp"
+#include "session_supervisor.hpp"
 #include "coze_chat_app.hpp"
 
 #define SPEAKING_TIMEOUT_MS         (2000)
@@ -36,26 +40,36 @@
 #define COZE_INTERRUPT_TIMES        (20)
 #define COZE_INTERRUPT_INTERVAL_MS  (100)
 
+// G711A at 8 kHz
+#define COZE_UPLINK_BYTES_PER_MS    (8)
+// Attempts before this one only reopen the websocket of the existing session, later ones rebuild the session
+#define COZE_RESUME_REBUILD_ATTEMPT (2)
+#define COZE_RESUME_POLL_MS         (20)
+
 using namespace esp_brookesia::ai_framework;
+using esp_brookesia::services::Executor;
 
 struct coze_chat_t {
     esp_coze_chat_handle_t  chat;
     std::recursive_mutex    chat_mutex;
-    bool                    chat_start;
+    std::atomic<bool>       chat_start;
     bool                    chat_pause;
     bool                    chat_sleep;
     bool                    speaking;
     bool                    wakeup;
     bool                    wakeup_start;
-    bool                    websocket_connected;
+    std::atomic<bool>       websocket_connected;
+    std::atomic<bool>       disconnect_signaled;
     esp_timer_handle_t      speaking_timeout_timer;
     esp_gmf_oal_thread_t    read_thread;
     esp_gmf_oal_thread_t    btn_thread;
     QueueHandle_t           btn_evt_q;
+    CozeChatAgentInfo       agent_info;
+    CozeChatRobotInfo       robot_info;
 };
 
 static struct coze_chat_t coze_chat = {};
-static const char *coze_authorization_url = "https://api.coze.cn/api/permission/oauth2/token";
+static SessionSupervisor session_supervisor;
 
 boost::signals2::signal<void(const std::string &emoji)> coze_chat_emoji_signal;
 boost::signals2::signal<void(bool is_speaking)> coze_chat_speaking_signal;
@@ -176,12 +190,15 @@ static void audio_event_callback(esp_coze_chat_event_t event, char *data, void *
         ESP_UTILS_LOGI("chat stop");
         // change_speaking_state(true);
     } else if (event == ESP_COZE_CHAT_EVENT_CHAT_COMPLETED) {
-        boost::thread([&]() {
-            boost::this_thread::sleep_for(boost::chrono::milliseconds(SPEAKING_MUTE_DELAY_MS));
+        agent_telemetry_mark(AGENT_TELEMETRY_STAGE_COMPLETED);
+        // All the audio of the reply has been received, the end of the playback is not a gap to conceal
+        audio_playback_mark_end();
+        Executor::requestInstance().postDelayed([]() {
             change_speaking_state(false);
-        }).detach();
+        }, SPEAKING_MUTE_DELAY_MS, Executor::Priority::Normal, "coze_speaking_mute");
         ESP_UTILS_LOGI("chat complete");
     } else if (event == ESP_COZE_CHAT_EVENT_CHAT_CUSTOMER_DATA) {
+        agent_telemetry_mark(AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK);
         // cjson format data
         ESP_UTILS_LOGI("Customer data: %s", data);
 
@@ -251,6 +268,7 @@ static void audio_event_callback(esp_coze_chat_event_t event, char *data, void *
 
         cJSON_Delete(json_data);
     } else if (event == ESP_COZE_CHAT_EVENT_CHAT_SUBTITLE_EVENT) {
+        agent_telemetry_mark(AGENT_TELEMETRY_STAGE_SUBTITLE);
         if (strncmp(data, "（", 3) == 0 && strncmp(data + strlen(data) - 3, "）", 3) == 0) {
             std::string emoji_str(data + 3);
             emoji_str = emoji_str.substr(0, emoji_str.length() - 3);
@@ -263,18 +281,33 @@ static void audio_event_callback(esp_coze_chat_event_t event, char *data, void *
     }
 }
 
+// The transport keeps reporting errors while it is down, the restart only needs to be requested once per drop
+static void coze_chat_signal_disconnected()
+{
+    if (!coze_chat.disconnect_signaled.exchange(true)) {
+        coze_chat_websocket_disconnected_signal();
+    }
+}
+
 static void websocket_event_callback(esp_coze_ws_event_t *event)
 {
     switch (event->event_id) {
     case WEBSOCKET_EVENT_CONNECTED:
         ESP_UTILS_LOGI("Websocket connected");
         coze_chat.websocket_connected = true;
+        coze_chat.disconnect_signaled = false;
+        session_supervisor.notifyConnected();
         break;
     case WEBSOCKET_EVENT_DISCONNECTED:
     case WEBSOCKET_EVENT_ERROR:
-        ESP_UTILS_LOGE("Websocke_signalt disconnected or error");
+        ESP_UTILS_LOGE("Websocket disconnected or error");
         coze_chat.websocket_connected = false;
-        coze_chat_websocket_disconnected_signal();
+        // A supervised session is resumed in place, otherwise fall back to a full restart
+        if (session_supervisor.getState() == SessionSupervisor::State::Idle) {
+            coze_chat_signal_disconnected();
+        } else {
+            session_supervisor.notifyDisconnected();
+        }
         break;
     default:
         break;
@@ -284,6 +317,7 @@ static void websocket_event_callback(esp_coze_ws_event_t *event)
 static void audio_data_callback(char *data, int len, void *ctx)
 {
     ESP_UTILS_LOGD("audio_data_callback");
+    agent_telemetry_mark(AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK);
     if (!coze_chat.chat_pause && !coze_chat.chat_sleep && coze_chat.speaking) {
         audio_playback_feed_data((uint8_t *)data, len);
     }
@@ -292,149 +326,6 @@ static void audio_data_callback(char *data, int len, void *ctx)
     }
 }
 
-void generate_random_string(char *output, size_t length)
-{
-    const char charset[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
-    size_t charset_size = sizeof(charset) - 1;
-    for (size_t i = 0; i < length; i++) {
-        int key = esp_random() % charset_size;
-        output[i] = charset[key];
-    }
-    output[length] = '\0';
-}
-
-static char *coze_get_access_token(const CozeChatAgentInfo &agent_info)
-{
-    // 构建 JWT payload
-    cJSON *payload_json = cJSON_CreateObject();
-    if (!payload_json) {
-        ESP_UTILS_LOGE("Failed to create payload_json");
-        return NULL;
-    }
-    char random_str[33] = {0};
-    generate_random_string(random_str, 32);
-    time_t now = time(NULL);
-    cJSON_AddStringToObject(payload_json, "iss", agent_info.app_id.c_str());
-    cJSON_AddStringToObject(payload_json, "aud", "api.coze.cn");
-    cJSON_AddNumberToObject(payload_json, "iat", now);
-    cJSON_AddNumberToObject(payload_json, "exp", now + 6000);
-    cJSON_AddStringToObject(payload_json, "jti", random_str);
-    cJSON_AddStringToObject(payload_json, "session_name", agent_info.session_name.c_str());
-    cJSON *session_context_json = cJSON_CreateObject();
-    cJSON *device_info_json = cJSON_CreateObject();
-    cJSON_AddStringToObject(device_info_json, "device_id", agent_info.device_id.c_str());
-    cJSON_AddStringToObject(device_info_json, "custom_consumer", agent_info.custom_consumer.c_str());
-    cJSON_AddItemToObject(session_context_json, "device_info", device_info_json);
-    cJSON_AddItemToObject(payload_json, "session_context", session_context_json);
-
-    char *payload_str = cJSON_PrintUnformatted(payload_json);
-    if (!payload_str) {
-        ESP_UTILS_LOGE("Failed to print payload_json");
-        cJSON_Delete(payload_json);
-        return NULL;
-    }
-    ESP_UTILS_LOGI("payload_str: %s\n", payload_str);
-    char *formatted_payload_str = cJSON_Print(payload_json);
-    if (formatted_payload_str) {
-        ESP_UTILS_LOGI("formatted_payload_str: %s\n", formatted_payload_str);
-        free(formatted_payload_str);
-    }
-
-    char *jwt = coze_jwt_create_handler(
-                    agent_info.public_key.c_str(), payload_str, (const uint8_t *)agent_info.private_key.c_str(),
-                    strlen(agent_info.private_key.c_str())
-                );
-    cJSON_Delete(payload_json);
-    free(payload_str);
-
-    if (!jwt) {
-        ESP_UTILS_LOGE("Failed to create JWT");
-        // payload_json and payload_str already freed above
-        return NULL;
-    }
-
-    char *authorization = (char *)calloc(1, strlen(jwt) + 16);
-    if (!authorization) {
-        ESP_UTILS_LOGE("Failed to allocate authorization");
-        free(jwt);
-        return NULL;
-    }
-    sprintf(authorization, "Bearer %s", jwt);
-    ESP_UTILS_LOGD("Authorization: %s", authorization);
-
-    cJSON *http_req_json = cJSON_CreateObject();
-    if (!http_req_json) {
-        ESP_UTILS_LOGE("Failed to create http_req_json");
-        free(jwt);
-        free(authorization);
-        return NULL;
-    }
-    cJSON_AddNumberToObject(http_req_json, "duration_seconds", 86399);
-    cJSON_AddStringToObject(http_req_json, "grant_type", "urn:ietf:params:oauth:grant-type:jwt-bearer");
-    char *http_req_json_str = cJSON_PrintUnformatted(http_req_json);
-    if (!http_req_json_str) {
-        ESP_UTILS_LOGE("Failed to print http_req_json");
-        free(jwt);
-        free(authorization);
-        cJSON_Delete(http_req_json);
-        return NULL;
-    }
-
-    http_req_header_t header[] = {
-        {"Content-Type", "application/json"},
-        {"Authorization", authorization},
-        {NULL, NULL}
-    };
-
-    http_response_t response = {0};
-    esp_err_t ret = http_client_post(coze_authorization_url, header, http_req_json_str, &response);
-    if (ret != ESP_OK) {
-        ESP_UTILS_LOGE("HTTP POST failed");
-        return NULL;
-    }
-
-    char *access_token = NULL;
-    if (response.body) {
-        ESP_UTILS_LOGI("response: %s\n", response.body);
-
-        cJSON *root = cJSON_Parse(response.body);
-        if (root) {
-            cJSON *access_token_item = cJSON_GetObjectItem(root, "access_token");
-            if (cJSON_IsString(access_token_item) && access_token_item->valuestring != NULL) {
-                ESP_UTILS_LOGI("access_token: %s\n", access_token_item->valuestring);
-                access_token = strdup(access_token_item->valuestring);
-            } else {
-                ESP_UTILS_LOGE("access_token is invalid or not exist");
-            }
-
-            cJSON *expires_in_item = cJSON_GetObjectItem(root, "expires_in");
-            if (cJSON_IsNumber(expires_in_item)) {
-                ESP_UTILS_LOGI("expires_in: %d\n", expires_in_item->valueint);
-            }
-
-            cJSON *token_type_item = cJSON_GetObjectItem(root, "token_type");
-            if (cJSON_IsString(token_type_item)) {
-                ESP_UTILS_LOGI("token_type: %s\n", token_type_item->valuestring);
-            }
-
-            cJSON_Delete(root);
-        } else {
-            ESP_UTILS_LOGE("Failed to parse JSON response");
-        }
-    }
-
-    // 释放内存
-    free(jwt);
-    free(authorization);
-    cJSON_Delete(http_req_json);
-    free(http_req_json_str);
-    if (response.body) {
-        free(response.body);
-    }
-
-    return access_token;
-}
-
 static void recorder_event_callback_fn(void *event, void *ctx)
 {
     if (!coze_chat.chat_start || coze_chat.chat_pause) {
@@ -491,8 +382,10 @@ static void audio_data_read_task(void *pv)
     int ret = 0;
     while (true) {
         ret = audio_recorder_read_data(data, AUDIO_RECORDER_READ_SIZE);
-        if (coze_chat->chat_start && coze_chat->wakeup && !coze_chat->chat_pause && !coze_chat->chat_sleep && !coze_chat->speaking) {
-            esp_coze_chat_send_audio_data(coze_chat->chat, (char *)data, ret);
+        if ((ret > 0) && coze_chat->chat_start && coze_chat->wakeup && !coze_chat->chat_pause && !coze_chat->chat_sleep &&
+                !coze_chat->speaking) {
+            session_supervisor.sendAudio(data, ret);
+            agent_telemetry_mark(AGENT_TELEMETRY_STAGE_LAST_UPLINK);
         }
         // heap_caps_check_integrity_all(true);
     }
@@ -520,9 +413,9 @@ esp_err_t coze_chat_app_init(void)
         .callback = [](void *arg)
         {
             ESP_UTILS_LOGI("speaking timeout start");
-            boost::thread([&]() {
+            Executor::requestInstance().post([]() {
                 change_speaking_state(false);
-            }).detach();
+            }, Executor::Priority::Normal, "coze_speaking_timeout");
             ESP_UTILS_LOGI("speaking timeout end");
         },
         .arg = &coze_chat,
@@ -541,26 +434,17 @@ esp_err_t coze_chat_app_init(void)
     return ESP_OK;
 }
 
-esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, const CozeChatRobotInfo &robot_info)
+static esp_err_t coze_chat_create(const std::string &token)
 {
-    ESP_UTILS_LOG_TRACE_GUARD();
-
-    char *token_str = NULL;
-    token_str = coze_get_access_token(agent_info);
-    if (token_str == NULL) {
-        ESP_UTILS_LOGE("Failed to get access token");
-        return ESP_FAIL;
-    }
-
     esp_coze_chat_config_t chat_config = ESP_COZE_CHAT_DEFAULT_CONFIG();
     chat_config.enable_subtitle = true;
     chat_config.subscribe_event = (const char *[]) {
         "conversation.chat.requires_action", NULL
     };
-    chat_config.user_id = agent_info.user_id.c_str();
-    chat_config.bot_id = robot_info.bot_id.c_str();
-    chat_config.voice_id = robot_info.voice_id.c_str();
-    chat_config.access_token = token_str;
+    chat_config.user_id = coze_chat.agent_info.user_id.c_str();
+    chat_config.bot_id = coze_chat.robot_info.bot_id.c_str();
+    chat_config.voice_id = coze_chat.robot_info.voice_id.c_str();
+    chat_config.access_token = token.c_str();
     chat_config.uplink_audio_type = ESP_COZE_CHAT_AUDIO_TYPE_G711A;
     chat_config.audio_callback = audio_data_callback;
     chat_config.event_callback = audio_event_callback;
@@ -568,10 +452,13 @@ esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, const CozeCha
     // chat_config.websocket_buffer_size = 4096;
     // chat_config.mode = ESP_COZE_CHAT_NORMAL_MODE;
 
-    std::lock_guard lock(coze_chat.chat_mutex);
     esp_err_t ret = esp_coze_chat_init(&chat_config, &coze_chat.chat);
     ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_chat_init failed(%s)", esp_err_to_name(ret));
 
+    // The functions are all registered once they are sent to the server, the lookups of the calls can be frozen
+    if (!FunctionDefinitionList::requestInstance().freeze()) {
+        ESP_UTILS_LOGW("Freeze function list failed, keep looking up the functions by map");
+    }
     static auto func_call = FunctionDefinitionList::requestInstance().getJson();
 
     esp_coze_parameters_kv_t param[] = {
@@ -580,12 +467,126 @@ esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, const CozeCha
     };
     ret = esp_coze_set_chat_config_parameters(coze_chat.chat, param);
     ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_set_chat_config_parameters failed(%s)", esp_err_to_name(ret));
-    ret = esp_coze_chat_start(coze_chat.chat);
-    ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_chat_start failed(%s)", esp_err_to_name(ret));
 
-    coze_chat.chat_start = true;
+    return ESP_OK;
+}
+
+static bool coze_chat_reconnect(int attempt)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    {
+        std::lock_guard lock(coze_chat.chat_mutex);
+        if (!coze_chat.chat_start) {
+            return false;
+        }
+
+        if (coze_chat.chat != NULL) {
+            esp_coze_chat_stop(coze_chat.chat);
+            // Reopening the websocket keeps the session configured by `coze_chat_create()`. If that keeps failing,
+            // the server may have dropped the session for good (e.g. the token expired), so build a new one.
+            if (attempt >= COZE_RESUME_REBUILD_ATTEMPT) {
+                esp_coze_chat_deinit(coze_chat.chat);
+                coze_chat.chat = NULL;
+            }
+        }
+        if (coze_chat.chat == NULL) {
+            std::string token;
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                CozeTokenManager::requestInstance().getToken(token), false, "Failed to get access token"
+            );
+            if (coze_chat_create(token) != ESP_OK) {
+                if (coze_chat.chat != NULL) {
+                    esp_coze_chat_deinit(coze_chat.chat);
+                    coze_chat.chat = NULL;
+                }
+                return false;
+            }
+        }
+
+        coze_chat.websocket_connected = false;
+        esp_err_t ret = esp_coze_chat_start(coze_chat.chat);
+        if (ret != ESP_OK) {
+            if (attempt >= COZE_RESUME_REBUILD_ATTEMPT) {
+                CozeTokenManager::requestInstance().invalidate();
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "esp_coze_chat_start failed(%s)", esp_err_to_name(ret));
+        }
+    }
+
+    // Don't hold the chat lock while waiting, `coze_chat_app_stop()` must be able to cut the attempt short
+    for (int waited_ms = 0; waited_ms < ESP_BROOKESIA_AGENT_SESSION_RESUME_CONNECT_TIMEOUT_MS;
+            waited_ms += COZE_RESUME_POLL_MS) {
+        if (coze_chat.websocket_connected) {
+            return true;
+        }
+        if (!coze_chat.chat_start) {
+            return false;
+        }
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(COZE_RESUME_POLL_MS));
+    }
+    ESP_UTILS_LOGE("Websocket connect timeout");
+
+    return false;
+}
+
+esp_err_t coze_chat_app_start(const CozeChatAgentInfo &agent_info, const CozeChatRobotInfo &robot_info)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    auto &token_manager = CozeTokenManager::requestInstance();
+    ESP_UTILS_CHECK_FALSE_RETURN(token_manager.begin(agent_info), ESP_FAIL, "Begin token manager failed");
+    std::string token;
+    ESP_UTILS_CHECK_FALSE_RETURN(token_manager.getToken(token), ESP_FAIL, "Failed to get access token");
+
+    {
+        std::lock_guard lock(coze_chat.chat_mutex);
+        // Keep the session parameters, a resume may have to rebuild the session later
+        coze_chat.agent_info = agent_info;
+        coze_chat.robot_info = robot_info;
+        coze_chat.disconnect_signaled = false;
+        esp_err_t ret = coze_chat_create(token);
+        ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "Create chat failed");
+    }
+
+    // The supervisor calls the send callback with its send lock held, and the callback takes the chat lock, so the
+    // supervisor must never be begun or ended with the chat lock held
+    SessionSupervisor::Config supervisor_config = SessionSupervisor::getDefaultConfig();
+    supervisor_config.uplink_buffer_size =
+        ESP_BROOKESIA_AGENT_SESSION_RESUME_UPLINK_BUFFER_MS * COZE_UPLINK_BYTES_PER_MS;
+    ESP_UTILS_CHECK_FALSE_RETURN(session_supervisor.begin(supervisor_config, {
+        .reconnect = coze_chat_reconnect,
+        .send = [](const uint8_t *data, size_t len)
+        {
+            std::lock_guard lock(coze_chat.chat_mutex);
+            if ((coze_chat.chat == NULL) || !coze_chat.websocket_connected) {
+                return false;
+            }
+            return esp_coze_chat_send_audio_data(coze_chat.chat, (char *)data, len) == ESP_OK;
+        },
+        .give_up = []()
+        {
+            coze_chat_signal_disconnected();
+        },
+    }), ESP_FAIL, "Begin session supervisor failed");
 
-    free(token_str);
+    esp_err_t ret = ESP_OK;
+    {
+        std::lock_guard lock(coze_chat.chat_mutex);
+        ret = esp_coze_chat_start(coze_chat.chat);
+        if (ret == ESP_OK) {
+            if (coze_chat.websocket_connected) {
+                session_supervisor.notifyConnected();
+            }
+            coze_chat.chat_start = true;
+        }
+    }
+    if (ret != ESP_OK) {
+        session_supervisor.end();
+        // The cached token may have been revoked, exchange a new one on the next attempt
+        token_manager.invalidate();
+        ESP_UTILS_CHECK_FALSE_RETURN(false, ret, "esp_coze_chat_start failed(%s)", esp_err_to_name(ret));
+    }
 
     return ESP_OK;
 }
@@ -594,8 +595,23 @@ esp_err_t coze_chat_app_stop(void)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
+    // Cut a reconnect attempt short first, ending the supervisor waits for it
+    coze_chat.chat_start = false;
+    session_supervisor.end();
+
+#if ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY && ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_ON_STOP
+    agent_telemetry_dump(
+        ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_BINARY ? AGENT_TELEMETRY_FORMAT_BINARY : AGENT_TELEMETRY_FORMAT_JSON
+    );
+#endif
+
     std::lock_guard lock(coze_chat.chat_mutex);
 
+    // A failed resume may have left no session behind
+    if (coze_chat.chat == NULL) {
+        return ESP_OK;
+    }
+
     esp_err_t ret = esp_coze_chat_stop(coze_chat.chat);
     ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_chat_stop failed(%s)", esp_err_to_name(ret));
 
@@ -603,8 +619,6 @@ esp_err_t coze_chat_app_stop(void)
     ESP_UTILS_CHECK_FALSE_RETURN(ret == ESP_OK, ret, "esp_coze_chat_deinit failed(%s)", esp_err_to_name(ret));
     coze_chat.chat = NULL;
 
-    coze_chat.chat_start = false;
-
     return ESP_OK;
 }
 
@@ -648,21 +662,30 @@ void coze_chat_app_sleep(void)
     change_speaking_state(false);
 }
 
+// Each cancel is a separate job, so the interrupt doesn't hold a worker for the whole retry period
+static void send_audio_cancel(int remaining_times)
+{
+    {
+        std::lock_guard lock(coze_chat.chat_mutex);
+        if ((coze_chat.chat == NULL) || !coze_chat.websocket_connected) {
+            return;
+        }
+        esp_coze_chat_send_audio_cancel(coze_chat.chat);
+    }
+    if (remaining_times > 1) {
+        Executor::requestInstance().postDelayed([remaining_times]() {
+            send_audio_cancel(remaining_times - 1);
+        }, COZE_INTERRUPT_INTERVAL_MS, Executor::Priority::High, "coze_interrupt");
+    }
+}
+
 void coze_chat_app_interrupt(void)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
-    boost::thread([&]() {
-        ESP_UTILS_LOG_TRACE_GUARD();
-        for (int i = 0; i < COZE_INTERRUPT_TIMES; i++) {
-            {
-                std::lock_guard lock(coze_chat.chat_mutex);
-                if ((coze_chat.chat == NULL) || !coze_chat.websocket_connected) {
-                    break;
-                }
-                esp_coze_chat_send_audio_cancel(coze_chat.chat);
-            }
-            boost::this_thread::sleep_for(boost::chrono::milliseconds(COZE_INTERRUPT_INTERVAL_MS));
-        }
-    }).detach();
+    audio_playback_flush();
+
+    Executor::requestInstance().post([]() {
+        send_audio_cancel(COZE_INTERRUPT_TIMES);
+    }, Executor::Priority::High, "coze_interrupt");
 }
@@ -0,0 +1,485 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <string.h>
+#include <time.h>
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "cJSON.h"
+#include "esp_coze_utils.h"
+#include "http_client_request.h"
+#include "services/executor/esp_brookesia_service_executor.hpp"
+#include "private/esp_brookesia_ai_agent_utils.hpp"
+#if ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST
+#   include "services/storage_nvs/esp_brookesia_service_storage_nvs.hpp"
+#endif
+#include "coze_token_manager.hpp"
+
+#define COZE_AUTHORIZATION_URL      "https://api.coze.cn/api/permission/oauth2/token"
+#define COZE_JWT_LIFETIME_S         (6000)
+
+// The clock is only trusted once it is past this (2024-01-01), before that the time is not synchronized
+#define TIME_SYNC_MIN_VALID_TIME    (1704067200)
+// NVS strings are limited to `NVS_VALUE_STR_MAX_LEN` including the terminator, so the token is split into chunks
+#define PERSIST_CHUNK_LEN           (120)
+#define PERSIST_CHUNK_NUM_MAX       (4)
+#define PERSIST_KEY_AGENT_ID        "coze_tk_id"
+#define PERSIST_KEY_EXPIRE_TIME     "coze_tk_exp"
+#define PERSIST_KEY_CHUNK_NUM       "coze_tk_num"
+#define PERSIST_KEY_CHUNK_PREFIX    "coze_tk_"
+
+using esp_brookesia::services::Executor;
+#if ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST
+using esp_brookesia::services::StorageNVS;
+#endif
+
+namespace esp_brookesia::ai_framework {
+
+static void generate_random_string(char *output, size_t length)
+{
+    const char charset[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    size_t charset_size = sizeof(charset) - 1;
+    for (size_t i = 0; i < length; i++) {
+        int key = esp_random() % charset_size;
+        output[i] = charset[key];
+    }
+    output[length] = '\0';
+}
+
+static uint32_t get_agent_id(const CozeChatAgentInfo &agent_info)
+{
+    // FNV-1a, it only has to be stable across reboots and firmware updates
+    uint32_t hash = 2166136261u;
+    for (const std::string *field : {
+                &agent_info.app_id, &agent_info.session_name, &agent_info.device_id, &agent_info.user_id,
+                &agent_info.custom_consumer, &agent_info.public_key
+            }) {
+        for (char c : *field) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        hash = (hash ^ 0xff) * 16777619u;
+    }
+    return hash;
+}
+
+static char *create_authorization(const CozeChatAgentInfo &agent_info, int64_t now)
+{
+    cJSON *payload_json = cJSON_CreateObject();
+    ESP_UTILS_CHECK_NULL_RETURN(payload_json, nullptr, "Failed to create payload_json");
+
+    char random_str[33] = {0};
+    generate_random_string(random_str, 32);
+    cJSON_AddStringToObject(payload_json, "iss", agent_info.app_id.c_str());
+    cJSON_AddStringToObject(payload_json, "aud", "api.coze.cn");
+    cJSON_AddNumberToObject(payload_json, "iat", now);
+    cJSON_AddNumberToObject(payload_json, "exp", now + COZE_JWT_LIFETIME_S);
+    cJSON_AddStringToObject(payload_json, "jti", random_str);
+    cJSON_AddStringToObject(payload_json, "session_name", agent_info.session_name.c_str());
+    cJSON *session_context_json = cJSON_CreateObject();
+    cJSON *device_info_json = cJSON_CreateObject();
+    cJSON_AddStringToObject(device_info_json, "device_id", agent_info.device_id.c_str());
+    cJSON_AddStringToObject(device_info_json, "custom_consumer", agent_info.custom_consumer.c_str());
+    cJSON_AddItemToObject(session_context_json, "device_info", device_info_json);
+    cJSON_AddItemToObject(payload_json, "session_context", session_context_json);
+
+    char *payload_str = cJSON_PrintUnformatted(payload_json);
+    cJSON_Delete(payload_json);
+    ESP_UTILS_CHECK_NULL_RETURN(payload_str, nullptr, "Failed to print payload_json");
+    ESP_UTILS_LOGD("payload_str: %s", payload_str);
+
+    char *jwt = coze_jwt_create_handler(
+                    agent_info.public_key.c_str(), payload_str, (const uint8_t *)agent_info.private_key.c_str(),
+                    strlen(agent_info.private_key.c_str())
+                );
+    free(payload_str);
+    ESP_UTILS_CHECK_NULL_RETURN(jwt, nullptr, "Failed to create JWT");
+
+    char *authorization = (char *)calloc(1, strlen(jwt) + 16);
+    if (authorization != nullptr) {
+        sprintf(authorization, "Bearer %s", jwt);
+    }
+    free(jwt);
+    ESP_UTILS_CHECK_NULL_RETURN(authorization, nullptr, "Failed to allocate authorization");
+
+    return authorization;
+}
+
+static bool parse_token_response(const char *body, int64_t now, int duration_s, std::string &token,
+                                 int64_t &expire_time)
+{
+    cJSON *root = cJSON_Parse(body);
+    ESP_UTILS_CHECK_NULL_RETURN(root, false, "Failed to parse JSON response: %s", body);
+
+    bool ret = false;
+    cJSON *access_token_item = cJSON_GetObjectItem(root, "access_token");
+    if (cJSON_IsString(access_token_item) && (access_token_item->valuestring != NULL) &&
+            (access_token_item->valuestring[0] != '\0')) {
+        token = access_token_item->valuestring;
+        // Coze returns the expiration as a Unix time, a small value is taken as a lifetime to stay on the safe side
+        cJSON *expires_in_item = cJSON_GetObjectItem(root, "expires_in");
+        if (!cJSON_IsNumber(expires_in_item)) {
+            expire_time = now + duration_s;
+        } else if (expires_in_item->valuedouble < TIME_SYNC_MIN_VALID_TIME) {
+            expire_time = now + static_cast<int64_t>(expires_in_item->valuedouble);
+        } else {
+            expire_time = static_cast<int64_t>(expires_in_item->valuedouble);
+        }
+        ret = true;
+    } else {
+        ESP_UTILS_LOGE("access_token is invalid or not exist: %s", body);
+    }
+    cJSON_Delete(root);
+
+    return ret;
+}
+
+static bool fetch_token(const CozeChatAgentInfo &agent_info, const CozeTokenManager::Config &config,
+                        std::string &token, int64_t &expire_time)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    int64_t now = time(NULL);
+    char *authorization = create_authorization(agent_info, now);
+    ESP_UTILS_CHECK_NULL_RETURN(authorization, false, "Create authorization failed");
+
+    cJSON *http_req_json = cJSON_CreateObject();
+    cJSON_AddNumberToObject(http_req_json, "duration_seconds", config.duration_s);
+    cJSON_AddStringToObject(http_req_json, "grant_type", "urn:ietf:params:oauth:grant-type:jwt-bearer");
+    char *http_req_json_str = cJSON_PrintUnformatted(http_req_json);
+    cJSON_Delete(http_req_json);
+    if (http_req_json_str == nullptr) {
+        free(authorization);
+        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Failed to print http_req_json");
+    }
+
+    http_req_header_t header[] = {
+        {"Content-Type", "application/json"},
+        {"Authorization", authorization},
+        {NULL, NULL}
+    };
+    http_response_t response = {0};
+    esp_err_t ret = http_client_post(config.authorization_url.c_str(), header, http_req_json_str, &response);
+    free(authorization);
+    free(http_req_json_str);
+
+    bool is_ok = false;
+    if (ret != ESP_OK) {
+        ESP_UTILS_LOGE("HTTP POST failed(%s)", esp_err_to_name(ret));
+    } else if (response.body == nullptr) {
+        ESP_UTILS_LOGE("Empty response");
+    } else {
+        is_ok = parse_token_response(response.body, now, config.duration_s, token, expire_time);
+    }
+    if (response.body) {
+        free(response.body);
+    }
+
+    return is_ok;
+}
+
+CozeTokenManager::Config CozeTokenManager::getDefaultConfig()
+{
+    return Config{
+        .authorization_url = COZE_AUTHORIZATION_URL,
+        .duration_s = ESP_BROOKESIA_AGENT_COZE_TOKEN_DURATION_S,
+        .refresh_ahead_s = ESP_BROOKESIA_AGENT_COZE_TOKEN_REFRESH_AHEAD_S,
+        .min_remaining_s = ESP_BROOKESIA_AGENT_COZE_TOKEN_MIN_REMAINING_S,
+        .retry_interval_s = ESP_BROOKESIA_AGENT_COZE_TOKEN_RETRY_INTERVAL_S,
+        .persist = ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST,
+    };
+}
+
+bool CozeTokenManager::begin(const CozeChatAgentInfo &agent_info, const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(agent_info.isValid(), false, "Invalid agent info");
+    ESP_UTILS_CHECK_FALSE_RETURN(!config.authorization_url.empty(), false, "Invalid authorization url");
+
+    uint32_t agent_id = get_agent_id(agent_info);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _config = config;
+    if (_is_begun && (agent_id == _agent_id)) {
+        return true;
+    }
+
+    if (_refresh_job_id != Executor::INVALID_JOB_ID) {
+        Executor::requestInstance().cancel(_refresh_job_id);
+        _refresh_job_id = Executor::INVALID_JOB_ID;
+    }
+    _generation++;
+    _agent_info = agent_info;
+    _agent_id = agent_id;
+    _token = {};
+    _is_loaded = false;
+    _is_begun = true;
+
+    return true;
+}
+
+void CozeTokenManager::end()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_refresh_job_id != Executor::INVALID_JOB_ID) {
+        Executor::requestInstance().cancel(_refresh_job_id);
+        _refresh_job_id = Executor::INVALID_JOB_ID;
+    }
+    _generation++;
+    _agent_info = {};
+    _token = {};
+    _is_loaded = false;
+    _is_begun = false;
+}
+
+bool CozeTokenManager::getToken(std::string &token)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+
+        int64_t now = time(NULL);
+        if (!_is_loaded) {
+            _is_loaded = true;
+            if (loadToken(now)) {
+                scheduleRefresh(now, false);
+            }
+        }
+        if (isUsable(_token, now)) {
+            token = _token.value;
+            _stats.cache_hits++;
+            ESP_UTILS_LOGD("Use cached token, expires in %d s", static_cast<int>(_token.expire_time - now));
+            return true;
+        }
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(refreshToken(false), false, "Exchange token failed");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(isUsable(_token, time(NULL)), false, "New token expires too soon");
+    token = _token.value;
+
+    return true;
+}
+
+void CozeTokenManager::invalidate()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_refresh_job_id != Executor::INVALID_JOB_ID) {
+        Executor::requestInstance().cancel(_refresh_job_id);
+        _refresh_job_id = Executor::INVALID_JOB_ID;
+    }
+    _token = {};
+    eraseStoredToken();
+}
+
+CozeTokenManager::Stats CozeTokenManager::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+bool CozeTokenManager::refreshToken(bool is_background)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    // Only one exchange at a time, a caller that waited here usually finds the token refreshed by the other one
+    std::lock_guard<std::mutex> fetch_lock(_fetch_mutex);
+
+    uint32_t generation = 0;
+    CozeChatAgentInfo agent_info;
+    Config config;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_is_begun) {
+            return false;
+        }
+        if (!is_background && isUsable(_token, time(NULL))) {
+            return true;
+        }
+        generation = _generation;
+        agent_info = _agent_info;
+        config = _config;
+    }
+
+    Token token;
+    int64_t start_us = esp_timer_get_time();
+    bool is_ok = fetch_token(agent_info, config, token.value, token.expire_time);
+    uint32_t fetch_ms = static_cast<uint32_t>((esp_timer_get_time() - start_us) / 1000);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (generation != _generation) {
+        ESP_UTILS_LOGW("Agent changed during the exchange, drop the token");
+        return false;
+    }
+
+    int64_t now = time(NULL);
+    _stats.fetches++;
+    _stats.last_fetch_ms = fetch_ms;
+    if (is_background) {
+        _stats.background_refreshes++;
+    }
+    if (is_ok) {
+        ESP_UTILS_LOGI(
+            "Got token in %d ms, expires in %d s", static_cast<int>(fetch_ms),
+            static_cast<int>(token.expire_time - now)
+        );
+        _token = std::move(token);
+        storeToken(_token);
+    } else {
+        _stats.fetch_failures++;
+    }
+    scheduleRefresh(now, !is_ok);
+
+    return is_ok;
+}
+
+void CozeTokenManager::scheduleRefresh(int64_t now, bool is_failed)
+{
+    auto &executor = Executor::requestInstance();
+    if (_refresh_job_id != Executor::INVALID_JOB_ID) {
+        executor.cancel(_refresh_job_id);
+        _refresh_job_id = Executor::INVALID_JOB_ID;
+    }
+
+    int64_t delay_s = 0;
+    if (is_failed || _token.value.empty()) {
+        delay_s = _config.retry_interval_s;
+    } else if (now < TIME_SYNC_MIN_VALID_TIME) {
+        // Until the time is synchronized, `now` is near 1970 and the expiration looks decades away, check again later
+        delay_s = _config.retry_interval_s;
+    } else {
+        delay_s = std::max<int64_t>(_token.expire_time - _config.refresh_ahead_s - now, 0);
+    }
+    // Whatever the clock says, a token never lives longer than requested
+    delay_s = std::min<int64_t>(delay_s, _config.duration_s);
+    uint32_t delay_ms = static_cast<uint32_t>(std::min<int64_t>(delay_s * 1000, UINT32_MAX));
+    ESP_UTILS_LOGD("Schedule token refresh in %d s", static_cast<int>(delay_s));
+
+    // The exchange blocks on the network, so it runs with the other connectivity jobs in the low priority class
+    ESP_UTILS_CHECK_FALSE_EXIT(executor.postDelayed([this]() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            int64_t now = time(NULL);
+            // Keep the token until its expiration can be compared with the clock, rather than exchanging it blindly
+            if (_is_begun && (now < TIME_SYNC_MIN_VALID_TIME) && !_token.value.empty()) {
+                scheduleRefresh(now, false);
+                return;
+            }
+        }
+        refreshToken(true);
+    }, delay_ms, Executor::Priority::Low, "coze_token_refresh", &_refresh_job_id), "Post token refresh failed");
+}
+
+bool CozeTokenManager::isUsable(const Token &token, int64_t now) const
+{
+    return !token.value.empty() && ((token.expire_time - now) >= _config.min_remaining_s);
+}
+
+bool CozeTokenManager::loadToken(int64_t now)
+{
+#if ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST
+    if (!_config.persist) {
+        return false;
+    }
+    if (now < TIME_SYNC_MIN_VALID_TIME) {
+        ESP_UTILS_LOGW("Time is not synchronized, ignore the persisted token");
+        return false;
+    }
+
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Value agent_id;
+    StorageNVS::Value expire_time;
+    StorageNVS::Value chunk_num;
+    if (!storage.getLocalParam(PERSIST_KEY_AGENT_ID, agent_id) ||
+            !storage.getLocalParam(PERSIST_KEY_EXPIRE_TIME, expire_time) ||
+            !storage.getLocalParam(PERSIST_KEY_CHUNK_NUM, chunk_num) ||
+            !std::holds_alternative<int>(agent_id) || !std::holds_alternative<int>(expire_time) ||
+            !std::holds_alternative<int>(chunk_num)) {
+        ESP_UTILS_LOGD("No persisted token");
+        return false;
+    }
+    if (static_cast<uint32_t>(std::get<int>(agent_id)) != _agent_id) {
+        ESP_UTILS_LOGI("Persisted token belongs to another agent, ignore it");
+        return false;
+    }
+
+    Token token;
+    token.expire_time = static_cast<uint32_t>(std::get<int>(expire_time));
+    int num = std::get<int>(chunk_num);
+    if ((num <= 0) || (num > PERSIST_CHUNK_NUM_MAX)) {
+        return false;
+    }
+    for (int i = 0; i < num; i++) {
+        StorageNVS::Value chunk;
+        std::string key = PERSIST_KEY_CHUNK_PREFIX + std::to_string(i);
+        if (!storage.getLocalParam(key, chunk) || !std::holds_alternative<std::string>(chunk)) {
+            ESP_UTILS_LOGW("Persisted token is incomplete, ignore it");
+            return false;
+        }
+        token.value += std::get<std::string>(chunk);
+    }
+    if (!isUsable(token, now)) {
+        ESP_UTILS_LOGI("Persisted token has expired");
+        return false;
+    }
+    ESP_UTILS_LOGI("Loaded persisted token, expires in %d s", static_cast<int>(token.expire_time - now));
+    _token = std::move(token);
+
+    return true;
+#else
+    (void)now;
+    return false;
+#endif
+}
+
+void CozeTokenManager::storeToken(const Token &token)
+{
+#if ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST
+    if (!_config.persist) {
+        return;
+    }
+    int num = static_cast<int>((token.value.size() + PERSIST_CHUNK_LEN - 1) / PERSIST_CHUNK_LEN);
+    if (num > PERSIST_CHUNK_NUM_MAX) {
+        ESP_UTILS_LOGW("Token is too long(%d) to persist", static_cast<int>(token.value.size()));
+        eraseStoredToken();
+        return;
+    }
+
+    auto &storage = StorageNVS::requestInstance();
+    // Invalidate first, so an interrupted write never pairs new chunks with an old expiration
+    storage.setLocalParam(PERSIST_KEY_CHUNK_NUM, 0);
+    for (int i = 0; i < num; i++) {
+        storage.setLocalParam(
+            PERSIST_KEY_CHUNK_PREFIX + std::to_string(i), token.value.substr(i * PERSIST_CHUNK_LEN, PERSIST_CHUNK_LEN)
+        );
+    }
+    // Unix time fits an `int` until 2038, which is far beyond any token lifetime
+    storage.setLocalParam(PERSIST_KEY_AGENT_ID, static_cast<int>(_agent_id));
+    storage.setLocalParam(PERSIST_KEY_EXPIRE_TIME, static_cast<int>(token.expire_time));
+    storage.setLocalParam(PERSIST_KEY_CHUNK_NUM, num);
+#else
+    (void)token;
+#endif
+}
+
+void CozeTokenManager::eraseStoredToken()
+{
+#if ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST
+    if (!_config.persist) {
+        return;
+    }
+    StorageNVS::requestInstance().setLocalParam(PERSIST_KEY_CHUNK_NUM, 0);
+#endif
+}
+
+} // namespace esp_brookesia::ai_framework
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include "coze_chat_app.hpp"
+
+namespace esp_brookesia::ai_framework {
+
+/**
+ * @brief Cache of the Coze OAuth access token
+ *
+ * The token is exchanged with a signed JWT, which takes an RSA signature plus an HTTPS round trip. The manager keeps
+ * the token (optionally in NVS, so it survives a reboot), hands it out as long as it stays valid, and refreshes it on
+ * the shared executor shortly before it expires, so starting a chat normally does not wait for the network.
+ *
+ * All times are Unix times in seconds, so the system time must be synchronized before `getToken()` is called.
+ */
+class CozeTokenManager {
+public:
+    struct Config {
+        std::string authorization_url;  // Token exchange endpoint
+        int duration_s;                 // Lifetime requested for a new token
+        int refresh_ahead_s;            // Refresh in the background this long before the token expires
+        int min_remaining_s;            // A token with less time left than this is never handed out
+        int retry_interval_s;           // Interval between background refresh attempts after a failure
+        bool persist;                   // Store the token in NVS
+    };
+
+    struct Stats {
+        uint32_t cache_hits;        // `getToken()` served from the cache
+        uint32_t fetches;           // Token exchanges, foreground and background
+        uint32_t fetch_failures;
+        uint32_t background_refreshes;
+        uint32_t last_fetch_ms;     // Duration of the last token exchange
+    };
+
+    CozeTokenManager(const CozeTokenManager &) = delete;
+    CozeTokenManager(CozeTokenManager &&) = delete;
+    ~CozeTokenManager() = default;
+
+    CozeTokenManager &operator=(const CozeTokenManager &) = delete;
+    CozeTokenManager &operator=(CozeTokenManager &&) = delete;
+
+    /**
+     * @brief Set the agent the token belongs to
+     *
+     * A cached token issued for a different agent (app, session, device or user) is dropped. Can be called again to
+     * switch agents.
+     */
+    bool begin(const CozeChatAgentInfo &agent_info, const Config &config = getDefaultConfig());
+
+    /**
+     * @brief Cancel the pending refresh and forget the token in memory, the persisted copy is kept
+     */
+    void end();
+
+    /**
+     * @brief Get a valid token, from the cache when possible, otherwise by a blocking token exchange
+     */
+    bool getToken(std::string &token);
+
+    /**
+     * @brief Drop the cached token, e.g. after the server rejected it, so the next `getToken()` exchanges a new one
+     */
+    void invalidate();
+
+    Stats getStats();
+
+    static Config getDefaultConfig();
+
+    static CozeTokenManager &requestInstance()
+    {
+        static CozeTokenManager instance;
+        return instance;
+    }
+
+private:
+    struct Token {
+        std::string value;
+        int64_t expire_time = 0;
+    };
+
+    CozeTokenManager() = default;
+
+    bool refreshToken(bool is_background);
+    void scheduleRefresh(int64_t now, bool is_failed);
+    bool loadToken(int64_t now);
+    void storeToken(const Token &token);
+    void eraseStoredToken();
+    bool isUsable(const Token &token, int64_t now) const;
+
+    std::mutex _mutex;
+    std::mutex _fetch_mutex;
+    bool _is_begun = false;
+    bool _is_loaded = false;
+    uint32_t _generation = 0;
+    CozeChatAgentInfo _agent_info;
+    uint32_t _agent_id = 0;
+    Config _config = {};
+    Token _token;
+    uint32_t _refresh_job_id = 0;
+    Stats _stats = {};
+};
+
+} // namespace esp_brookesia::ai_framework
@@ -3,7 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
-#include "boost/thread.hpp"
+#include "services/executor/esp_brookesia_service_executor.hpp"
 #include "private/esp_brookesia_ai_agent_utils.hpp"
 #include "function_calling.hpp"
 
@@ -76,16 +76,10 @@ void FunctionDefinition::addParameter(
     parameters_.push_back(FunctionParameter(name, description, type, required));
 }
 
-void FunctionDefinition::setCallback(Callback callback, std::optional<CallbackThreadConfig> thread_config)
+void FunctionDefinition::setCallback(Callback callback, bool is_async)
 {
-#if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
-    if (thread_config != std::nullopt) {
-        thread_config->dump();
-    }
-#endif
-
     callback_ = callback;
-    thread_config_ = thread_config;
+    is_async_ = is_async;
 }
 
 bool FunctionDefinition::invoke(const cJSON *args) const
@@ -137,12 +131,13 @@ bool FunctionDefinition::invoke(const cJSON *args) const
         }
     }
 
-    if (thread_config_ != std::nullopt) {
-        esp_utils::thread_config_guard thread_config(*thread_config_);
-        boost::thread([this, params]() {
-            ESP_UTILS_LOG_TRACE_GUARD();
-            callback_(params);
-        }).detach();
+    if (is_async_) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            services::Executor::requestInstance().post([this, params]() {
+                ESP_UTILS_LOG_TRACE_GUARD();
+                callback_(params);
+            }, services::Executor::Priority::Normal, "function_call"), false, "Post function %s failed", name_.c_str()
+        );
     } else {
         callback_(params);
     }
@@ -214,7 +209,7 @@ FunctionDefinitionList &FunctionDefinitionList::requestInstance()
 
 void FunctionDefinitionList::addFunction(const FunctionDefinition &func)
 {
-    function_index_[func.name()] = functions_.size();
+    function_index_.add(func.name(), functions_.size());
     functions_.push_back(func);
     ESP_UTILS_LOGD("Added function to list: %s, index: %zu", func.name().c_str(), functions_.size() - 1);
 }
@@ -277,18 +272,18 @@ bool FunctionDefinitionList::invokeFunction(const cJSON *function_call) const
                 }
 
                 // Find and call the corresponding function
-                auto it = function_index_.find(actual_name->valuestring);
-                if (it == function_index_.end()) {
+                auto index = function_index_.get(actual_name->valuestring);
+                if (index == nullptr) {
                     ESP_UTILS_LOGE("Function not found: %s", actual_name->valuestring);
                     cJSON_Delete(action_obj);
                     cJSON_Delete(args_obj);
                     return false;
                 }
 
-                ESP_UTILS_LOGD("Found function %s, index: %zu", actual_name->valuestring, it->second);
+                ESP_UTILS_LOGD("Found function %s, index: %zu", actual_name->valuestring, *index);
 
                 // Call the callback function
-                bool result = functions_[it->second].invoke(actual_args);
+                bool result = functions_[*index].invoke(actual_args);
 
                 cJSON_Delete(action_obj);
                 cJSON_Delete(args_obj);
@@ -298,8 +293,8 @@ bool FunctionDefinitionList::invokeFunction(const cJSON *function_call) const
 
 next:
         // Standard JSON parameter handling
-        auto it = function_index_.find(name->valuestring);
-        if (it == function_index_.end()) {
+        auto index = function_index_.get(name->valuestring);
+        if (index == nullptr) {
             ESP_UTILS_LOGE("Function not found: %s", name->valuestring);
             if (args_obj != nullptr) {
                 cJSON_Delete(args_obj);
@@ -307,10 +302,10 @@ next:
             return false;
         }
 
-        ESP_UTILS_LOGD("Found function %s, index: %zu", name->valuestring, it->second);
+        ESP_UTILS_LOGD("Found function %s, index: %zu", name->valuestring, *index);
 
         // Call the callback function
-        bool result = functions_[it->second].invoke(args_obj);
+        bool result = functions_[*index].invoke(args_obj);
 
         if (args_obj != nullptr) {
             cJSON_Delete(args_obj);
@@ -318,16 +313,16 @@ next:
         return result;
     } else if (cJSON_IsObject(arguments)) {
         // Process object type parameters directly
-        auto it = function_index_.find(name->valuestring);
-        if (it == function_index_.end()) {
+        auto index = function_index_.get(name->valuestring);
+        if (index == nullptr) {
             ESP_UTILS_LOGE("Function not found: %s", name->valuestring);
             return false;
         }
 
-        ESP_UTILS_LOGD("Found function %s, index: %zu", name->valuestring, it->second);
+        ESP_UTILS_LOGD("Found function %s, index: %zu", name->valuestring, *index);
 
         // Call the callback function
-        bool result = functions_[it->second].invoke(arguments);
+        bool result = functions_[*index].invoke(arguments);
         return result;
     }
 
@@ -348,4 +343,12 @@ std::string FunctionDefinitionList::getJson() const
     return json;
 }
 
+bool FunctionDefinitionList::freeze()
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(function_index_.freeze(), false, "Freeze function index failed");
+    ESP_UTILS_LOGD("Froze function index: %zu functions", function_index_.size());
+
+    return true;
+}
+
 } // namespace esp_brookesia::ai_framework
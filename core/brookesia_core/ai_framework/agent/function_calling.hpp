@@ -7,12 +7,11 @@
 
 #include <map>
 #include <string>
-#include <optional>
 #include <functional>
 #include <vector>
 #include <mutex>
 #include "cJSON.h"
-#include "thread/esp_utils_thread.hpp"
+#include "utils/esp_brookesia_frozen_registry.hpp"
 
 namespace esp_brookesia::ai_framework {
 
@@ -68,13 +67,12 @@ private:
  * 
  * 功能原理：
  * - 支持注册函数名、描述、参数列表
- * - 支持设置回调（可指定线程配置）
+ * - 支持设置回调（可指定在执行器中异步执行）
  * - 支持通过JSON参数调用
  * - 用于AI助手等场景下，动态注册和调用功能
  */
 class FunctionDefinition {
 public:
-    using CallbackThreadConfig = esp_utils::ThreadConfig; // 回调线程配置类型
     using Callback = std::function<void(const std::vector<FunctionParameter>&)>; // 回调类型
 
     // 构造函数，指定函数名-描述
@@ -84,8 +82,8 @@ public:
     void addParameter(
         const std::string &name, const std::string &description, FunctionParameter::ValueType type, bool required = true
     );
-    // 设置回调及线程配置
-    void setCallback(Callback callback, std::optional<CallbackThreadConfig> thread_config = std::nullopt);
+    // 设置回调，异步时回调在共享 Executor 的普通优先级工作线程中执行，不再为每次调用单独创建线程
+    void setCallback(Callback callback, bool is_async = false);
     // 通过cJSON参数调用函数
     bool invoke(const cJSON *args) const;
     // 获取函数名
@@ -98,7 +96,7 @@ private:
     std::string description_;  // 函数描述
     std::vector<FunctionParameter> parameters_; // 参数列表
     Callback callback_;        // 回调函数
-    std::optional<CallbackThreadConfig> thread_config_; // 线程配置
+    bool is_async_ = false;    // 是否异步执行回调
 };
 
 /**
@@ -121,12 +119,14 @@ public:
     bool invokeFunction(const cJSON *function_call) const;
     // 获取所有函数定义的JSON字符串
     std::string getJson() const;
+    // 函数注册完成后冻结名称索引，之后按名称查找使用完美哈希，再添加函数会退回普通映射直到再次冻结
+    bool freeze();
 
 private:
     FunctionDefinitionList() = default;
 
     std::vector<FunctionDefinition> functions_;           // 所有函数定义
-    std::map<std::string, size_t> function_index_;        // 名称到索引的映射
+    utils::FrozenRegistry<size_t> function_index_;        // 名称到索引的映射
 };
 
 } // namespace esp_brookesia::ai_framework
\ No newline at end of file
@@ -0,0 +1,361 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <string.h>
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "boost/thread.hpp"
+#include "private/esp_brookesia_ai_agent_utils.hpp"
+#include "session_supervisor.hpp"
+
+// Bytes of uplink audio sent to the transport at once when flushing the buffer
+#define FLUSH_CHUNK_SIZE    (1024)
+
+#define WORKER_THREAD_NAME  "session_resume"
+
+namespace esp_brookesia::ai_framework {
+
+// Supervisor of the worker running on the current task, if any
+static thread_local SessionSupervisor *current_worker_owner = nullptr;
+
+SessionSupervisor::~SessionSupervisor()
+{
+    end();
+}
+
+SessionSupervisor::Config SessionSupervisor::getDefaultConfig()
+{
+    return Config{
+        .initial_backoff_ms = ESP_BROOKESIA_AGENT_SESSION_RESUME_INITIAL_BACKOFF_MS,
+        .max_backoff_ms = ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_BACKOFF_MS,
+        .max_attempts = ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_ATTEMPTS,
+        .uplink_buffer_size = 0,
+    };
+}
+
+uint32_t SessionSupervisor::getBackoffDelay(const Config &config, int attempt, uint32_t random)
+{
+    if (attempt <= 0) {
+        return 0;
+    }
+    uint64_t nominal = static_cast<uint64_t>(config.initial_backoff_ms) << std::min(attempt - 1, 31);
+    nominal = std::min<uint64_t>(nominal, config.max_backoff_ms);
+    uint32_t half = static_cast<uint32_t>(nominal / 2);
+
+    return half + ((half == 0) ? 0 : (random % (static_cast<uint32_t>(nominal) - half + 1)));
+}
+
+bool SessionSupervisor::begin(const Config &config, const Callbacks &callbacks)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        callbacks.reconnect && callbacks.send && callbacks.give_up, false, "Invalid callbacks"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(config.max_attempts > 0, false, "Invalid max attempts");
+
+    end();
+
+    std::lock_guard<std::mutex> send_lock(_send_mutex);
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(_uplink.resize(config.uplink_buffer_size), false, "Allocate uplink buffer failed");
+    _uplink_head = 0;
+    _uplink_len = 0;
+    _config = config;
+    _callbacks = callbacks;
+    _state = State::Idle;
+    _is_begun = true;
+
+    return true;
+}
+
+void SessionSupervisor::end()
+{
+    {
+        std::lock_guard<std::mutex> send_lock(_send_mutex);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_is_begun) {
+            ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+            // The worker wakes up and leaves, an attempt in progress finishes on its own and its result is ignored
+            _generation++;
+            _is_worker_running = false;
+            _worker_cv.notify_all();
+            _state = State::Idle;
+            _callbacks = {};
+            std::vector<uint8_t>().swap(_uplink);
+            _uplink_head = 0;
+            _uplink_len = 0;
+            _is_begun = false;
+        }
+    }
+
+    // The workers use the supervisor until they return, a worker ending the supervisor only waits for the others
+    std::unique_lock<std::mutex> lock(_mutex);
+    _worker_cv.wait(lock, [this]() {
+        return _worker_num == ((current_worker_owner == this) ? 1 : 0);
+    });
+}
+
+void SessionSupervisor::notifyConnected()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_is_begun) {
+        return;
+    }
+
+    if (_state == State::Reconnecting) {
+        // The transport came back by itself or during an attempt, the pending attempt is no longer needed
+        markRecovered();
+    } else if (_state == State::Idle) {
+        ESP_UTILS_LOGI("Session connected");
+        _state = State::Connected;
+    }
+}
+
+void SessionSupervisor::notifyDisconnected()
+{
+    GiveUpCallback give_up;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // While reconnecting, the disconnections are caused by the attempts themselves
+        if (!_is_begun || (_state != State::Connected)) {
+            return;
+        }
+
+        ESP_UTILS_LOGW("Session disconnected, start reconnecting");
+        _state = State::Reconnecting;
+        _disconnect_time_us = esp_timer_get_time();
+        _attempt = 0;
+        _stats.disconnects++;
+        // The worker of a previous outage may still be leaving, it picks this one up instead
+        if (_is_worker_running || startWorker()) {
+            return;
+        }
+
+        _state = State::Idle;
+        _stats.give_ups++;
+        give_up = _callbacks.give_up;
+    }
+
+    give_up();
+}
+
+bool SessionSupervisor::sendAudio(const uint8_t *data, size_t len)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN((data != nullptr) && (len > 0), false, "Invalid data");
+
+    std::lock_guard<std::mutex> send_lock(_send_mutex);
+    SendCallback send;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_is_begun || (_state == State::Idle)) {
+            return false;
+        }
+        if (_state == State::Reconnecting) {
+            pushUplink(data, len);
+            return true;
+        }
+        send = _callbacks.send;
+    }
+
+    // Audio kept during the outage goes first, in case the live audio overtook the flush of the attempt
+    flushUplink();
+
+    return send(data, len);
+}
+
+SessionSupervisor::State SessionSupervisor::getState()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state;
+}
+
+SessionSupervisor::Stats SessionSupervisor::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+bool SessionSupervisor::startWorker()
+{
+    uint32_t generation = _generation;
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = WORKER_THREAD_NAME,
+        .core_id = ESP_BROOKESIA_AGENT_SESSION_RESUME_CORE_ID,
+        .priority = static_cast<size_t>(ESP_BROOKESIA_AGENT_SESSION_RESUME_PRIORITY),
+        .stack_size = static_cast<size_t>(ESP_BROOKESIA_AGENT_SESSION_RESUME_STACK_SIZE),
+    });
+    // Detached, since the give-up callback may end the supervisor from the worker itself
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(boost::thread([this, generation]() {
+        current_worker_owner = this;
+        runWorker(generation);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _worker_num--;
+        _worker_cv.notify_all();
+    }).detach(), false, "Create worker failed");
+    _is_worker_running = true;
+    _worker_num++;
+
+    return true;
+}
+
+void SessionSupervisor::runWorker(uint32_t generation)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while ((generation == _generation) && (_state == State::Reconnecting)) {
+        uint32_t delay_ms = getBackoffDelay(_config, _attempt, esp_random());
+        ESP_UTILS_LOGI("Reconnect attempt %d in %d ms", _attempt + 1, static_cast<int>(delay_ms));
+        // The transport may come back by itself during the delay
+        bool is_woken = _worker_cv.wait_for(lock, std::chrono::milliseconds(delay_ms), [this, generation]() {
+            return (generation != _generation) || (_state != State::Reconnecting);
+        });
+        if (is_woken) {
+            break;
+        }
+
+        ReconnectCallback reconnect = _callbacks.reconnect;
+        int attempt = _attempt;
+        uint32_t disconnects = _stats.disconnects;
+        _stats.attempts++;
+        lock.unlock();
+
+        bool is_connected = reconnect(attempt);
+
+        lock.lock();
+        if ((generation != _generation) || (_state != State::Reconnecting)) {
+            break;
+        }
+        // The session came back and dropped again during the attempt, its result is about the previous outage
+        if (_stats.disconnects != disconnects) {
+            continue;
+        }
+        if (is_connected) {
+            markRecovered();
+            break;
+        }
+        _attempt++;
+        if (_attempt >= _config.max_attempts) {
+            ESP_UTILS_LOGE("Reconnect failed after %d attempts, give up", _attempt);
+            _state = State::Idle;
+            _stats.give_ups++;
+            _stats.dropped_bytes += _uplink_len;
+            _uplink_head = 0;
+            _uplink_len = 0;
+            _is_worker_running = false;
+            GiveUpCallback give_up = _callbacks.give_up;
+            lock.unlock();
+
+            give_up();
+            return;
+        }
+    }
+    if (generation != _generation) {
+        return;
+    }
+    // Leaving is decided under the lock, so a disconnection right after this starts a new worker
+    _is_worker_running = false;
+    lock.unlock();
+
+    std::lock_guard<std::mutex> send_lock(_send_mutex);
+    flushUplink();
+}
+
+void SessionSupervisor::markRecovered()
+{
+    _state = State::Connected;
+    _worker_cv.notify_all();
+    _stats.recoveries++;
+    _stats.last_recovery_ms = static_cast<uint32_t>((esp_timer_get_time() - _disconnect_time_us) / 1000);
+    _stats.max_recovery_ms = std::max(_stats.max_recovery_ms, _stats.last_recovery_ms);
+    ESP_UTILS_LOGI(
+        "Session recovered in %d ms after %d attempt(s), %d bytes of uplink kept",
+        static_cast<int>(_stats.last_recovery_ms), _attempt + 1, static_cast<int>(_uplink_len)
+    );
+}
+
+bool SessionSupervisor::flushUplink()
+{
+    uint8_t chunk[FLUSH_CHUNK_SIZE];
+    while (true) {
+        SendCallback send;
+        size_t len = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if ((_state != State::Connected) || (_uplink_len == 0)) {
+                return true;
+            }
+            len = std::min<size_t>({_uplink_len, sizeof(chunk), _uplink.size() - _uplink_head});
+            memcpy(chunk, _uplink.data() + _uplink_head, len);
+            _uplink_head = (_uplink_head + len) % _uplink.size();
+            _uplink_len -= len;
+            _stats.buffered_bytes += len;
+            send = _callbacks.send;
+        }
+        if (!send(chunk, len)) {
+            // Keep the chunk for the next flush, unless the buffered audio was dropped meanwhile
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.buffered_bytes -= len;
+            if (_is_begun && (_state != State::Idle)) {
+                unshiftUplink(chunk, len);
+            } else {
+                _stats.dropped_bytes += len;
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Send buffered uplink failed");
+        }
+    }
+}
+
+void SessionSupervisor::unshiftUplink(const uint8_t *data, size_t len)
+{
+    // The chunk is older than the buffered audio, only its end is kept if the buffer got fuller meanwhile
+    size_t capacity = _uplink.size();
+    size_t room = capacity - _uplink_len;
+    if (len > room) {
+        _stats.dropped_bytes += len - room;
+        data += len - room;
+        len = room;
+    }
+    if (len == 0) {
+        return;
+    }
+    _uplink_head = (_uplink_head + capacity - len) % capacity;
+    size_t first = std::min(len, capacity - _uplink_head);
+    memcpy(_uplink.data() + _uplink_head, data, first);
+    memcpy(_uplink.data(), data + first, len - first);
+    _uplink_len += len;
+}
+
+void SessionSupervisor::pushUplink(const uint8_t *data, size_t len)
+{
+    size_t capacity = _uplink.size();
+    if (capacity == 0) {
+        _stats.dropped_bytes += len;
+        return;
+    }
+    if (len > capacity) {
+        _stats.dropped_bytes += len - capacity;
+        data += len - capacity;
+        len = capacity;
+    }
+    // The newest audio is the most useful, make room by dropping the oldest
+    size_t overflow = (_uplink_len + len > capacity) ? (_uplink_len + len - capacity) : 0;
+    if (overflow > 0) {
+        _uplink_head = (_uplink_head + overflow) % capacity;
+        _uplink_len -= overflow;
+        _stats.dropped_bytes += overflow;
+    }
+    size_t tail = (_uplink_head + _uplink_len) % capacity;
+    size_t first = std::min(len, capacity - tail);
+    memcpy(_uplink.data() + tail, data, first);
+    memcpy(_uplink.data(), data + first, len - first);
+    _uplink_len += len;
+}
+
+} // namespace esp_brookesia::ai_framework
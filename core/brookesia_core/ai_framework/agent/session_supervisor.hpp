@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+namespace esp_brookesia::ai_framework {
+
+/**
+ * @brief Keeps a chat session alive across transport drops
+ *
+ * When the transport reports a disconnection, the supervisor retries the connection with a jittered exponential
+ * backoff instead of tearing the session down. The first attempt is immediate. The attempts block on the network, so
+ * they run on a task of the supervisor which only lives during the outage, not on the shared executor. Uplink audio
+ * sent while reconnecting is kept in a ring buffer (the newest data wins) and flushed in order before any live audio
+ * once the session is back. If every attempt fails, the give-up callback hands over to the full restart path.
+ */
+class SessionSupervisor {
+public:
+    /**
+     * @brief Re-open the transport, blocking until it is connected or has failed
+     *
+     * @param attempt  Index of the attempt since the disconnection, starting from 0
+     */
+    using ReconnectCallback = std::function<bool(int attempt)>;
+    using SendCallback = std::function<bool(const uint8_t *data, size_t len)>;
+    using GiveUpCallback = std::function<void()>;
+
+    enum class State {
+        Idle,
+        Connected,
+        Reconnecting,
+    };
+
+    struct Config {
+        uint32_t initial_backoff_ms;    // Nominal delay of the second attempt, doubled for each next one
+        uint32_t max_backoff_ms;        // Upper bound of the nominal delay
+        int max_attempts;               // Attempts before giving up
+        size_t uplink_buffer_size;      // Bytes of uplink audio kept while reconnecting, 0 to drop it
+    };
+
+    struct Callbacks {
+        ReconnectCallback reconnect;
+        SendCallback send;
+        GiveUpCallback give_up;
+    };
+
+    struct Stats {
+        uint32_t disconnects;
+        uint32_t recoveries;
+        uint32_t attempts;
+        uint32_t give_ups;
+        uint32_t buffered_bytes;        // Uplink bytes kept during outages and sent after the recovery
+        uint32_t dropped_bytes;         // Uplink bytes lost because the buffer was full or the session was given up
+        uint32_t last_recovery_ms;      // From the disconnection to the session being usable again
+        uint32_t max_recovery_ms;
+    };
+
+    SessionSupervisor() = default;
+    ~SessionSupervisor();
+
+    SessionSupervisor(const SessionSupervisor &) = delete;
+    SessionSupervisor(SessionSupervisor &&) = delete;
+    SessionSupervisor &operator=(const SessionSupervisor &) = delete;
+    SessionSupervisor &operator=(SessionSupervisor &&) = delete;
+
+    /**
+     * @brief Start supervising
+     *
+     * The send callback is called with the lock that orders the uplink held, which `begin()` and `end()` take too, so
+     * they must not be called with a lock that the send callback takes.
+     */
+    bool begin(const Config &config, const Callbacks &callbacks);
+
+    /**
+     * @brief Stop supervising, the pending attempt is cancelled and an attempt in progress is ignored
+     *
+     * Returns once the task of the attempts has left, unless called from that task, e.g. by the give-up callback.
+     */
+    void end();
+
+    void notifyConnected();
+
+    /**
+     * @brief Start reconnecting, ignored unless the session is connected
+     */
+    void notifyDisconnected();
+
+    /**
+     * @brief Send uplink audio, or keep it while reconnecting
+     *
+     * @return false if the session is not supervised or the transport refused the data
+     */
+    bool sendAudio(const uint8_t *data, size_t len);
+
+    State getState();
+    Stats getStats();
+
+    static Config getDefaultConfig();
+
+    /**
+     * @brief Delay before an attempt, "equal jitter": half of the nominal delay plus a random part of the other half
+     */
+    static uint32_t getBackoffDelay(const Config &config, int attempt, uint32_t random);
+
+private:
+    bool startWorker();
+    void runWorker(uint32_t generation);
+    void markRecovered();
+    bool flushUplink();
+    void pushUplink(const uint8_t *data, size_t len);
+    void unshiftUplink(const uint8_t *data, size_t len);
+
+    std::mutex _mutex;
+    std::mutex _send_mutex;         // Keeps buffered and live audio in order, taken before `_mutex`
+    bool _is_begun = false;
+    State _state = State::Idle;
+    Config _config = {};
+    Callbacks _callbacks;
+    uint32_t _generation = 0;
+    int _attempt = 0;
+    bool _is_worker_running = false;   // A worker handles the current outage
+    int _worker_num = 0;                // Workers not returned yet, including the ones of previous outages
+    std::condition_variable _worker_cv;
+    int64_t _disconnect_time_us = 0;
+    std::vector<uint8_t> _uplink;
+    size_t _uplink_head = 0;
+    size_t _uplink_len = 0;
+    Stats _stats = {};
+};
+
+} // namespace esp_brookesia::ai_framework
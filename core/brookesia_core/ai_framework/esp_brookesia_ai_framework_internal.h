@@ -30,6 +30,199 @@
 #           define ESP_BROOKESIA_AGENT_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY)
+#           define ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY  CONFIG_ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY
+#       else
+#           define ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY  (0)
+#       endif
+#   endif
+
+#   if ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY
+#       if !defined(ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM)
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM  CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM
+#           else
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM  (16)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_TELEMETRY_LOG_EACH_TURN)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_LOG_EACH_TURN)
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_LOG_EACH_TURN  CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_LOG_EACH_TURN
+#           else
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_LOG_EACH_TURN  (0)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_ON_STOP)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_ON_STOP)
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_ON_STOP  CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_ON_STOP
+#           else
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_ON_STOP  (0)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_BINARY)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_BINARY)
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_BINARY  CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_BINARY
+#           else
+#               define ESP_BROOKESIA_AGENT_TELEMETRY_DUMP_BINARY  (0)
+#           endif
+#       endif
+#   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER)
+#           define ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER  CONFIG_ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+#       else
+#           define ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER  (0)
+#       endif
+#   endif
+
+#   if ESP_BROOKESIA_AGENT_ENABLE_JITTER_BUFFER
+#       if !defined(ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_NUM)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_NUM)
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_NUM  CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_NUM
+#           else
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_NUM  (32)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_SIZE)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_SIZE)
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_SIZE  CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_SIZE
+#           else
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_PACKET_SIZE  (1024)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS)
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS  CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS
+#           else
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_FRAME_MS  (60)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_JITTER_BUFFER_MIN_DELAY_MS)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_MIN_DELAY_MS)
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_MIN_DELAY_MS  CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_MIN_DELAY_MS
+#           else
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_MIN_DELAY_MS  (60)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_DELAY_MS)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_DELAY_MS)
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_DELAY_MS  CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_DELAY_MS
+#           else
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_DELAY_MS  (600)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM)
+#           if defined(CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM)
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM  CONFIG_ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM
+#           else
+#               define ESP_BROOKESIA_AGENT_JITTER_BUFFER_MAX_CONCEAL_NUM  (2)
+#           endif
+#       endif
+#   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS)
+#           define ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS  CONFIG_ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS
+#       else
+#           define ESP_BROOKESIA_AGENT_PIPELINE_PROFILE_LOG_PERIOD_MS  (0)
+#       endif
+#   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_COZE_TOKEN_DURATION_S)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_DURATION_S)
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_DURATION_S  CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_DURATION_S
+#       else
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_DURATION_S  (86399)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_COZE_TOKEN_REFRESH_AHEAD_S)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_REFRESH_AHEAD_S)
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_REFRESH_AHEAD_S  CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_REFRESH_AHEAD_S
+#       else
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_REFRESH_AHEAD_S  (600)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_COZE_TOKEN_MIN_REMAINING_S)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_MIN_REMAINING_S)
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_MIN_REMAINING_S  CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_MIN_REMAINING_S
+#       else
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_MIN_REMAINING_S  (60)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_COZE_TOKEN_RETRY_INTERVAL_S)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_RETRY_INTERVAL_S)
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_RETRY_INTERVAL_S  CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_RETRY_INTERVAL_S
+#       else
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_RETRY_INTERVAL_S  (30)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST)
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST  CONFIG_ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST
+#       else
+#           define ESP_BROOKESIA_AGENT_COZE_TOKEN_PERSIST  (0)
+#       endif
+#   endif
+
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_INITIAL_BACKOFF_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_INITIAL_BACKOFF_MS)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_INITIAL_BACKOFF_MS  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_INITIAL_BACKOFF_MS
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_INITIAL_BACKOFF_MS  (250)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_BACKOFF_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_BACKOFF_MS)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_BACKOFF_MS  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_BACKOFF_MS
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_BACKOFF_MS  (8000)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_ATTEMPTS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_ATTEMPTS)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_ATTEMPTS  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_ATTEMPTS
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_MAX_ATTEMPTS  (6)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_CONNECT_TIMEOUT_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_CONNECT_TIMEOUT_MS)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_CONNECT_TIMEOUT_MS  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_CONNECT_TIMEOUT_MS
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_CONNECT_TIMEOUT_MS  (5000)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_UPLINK_BUFFER_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_UPLINK_BUFFER_MS)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_UPLINK_BUFFER_MS  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_UPLINK_BUFFER_MS
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_UPLINK_BUFFER_MS  (2000)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_CORE_ID)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_CORE_ID)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_CORE_ID  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_CORE_ID
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_CORE_ID  (-1)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_PRIORITY)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_PRIORITY)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_PRIORITY  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_PRIORITY
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_PRIORITY  (2)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_AGENT_SESSION_RESUME_STACK_SIZE)
+#       if defined(CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_STACK_SIZE)
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_STACK_SIZE  CONFIG_ESP_BROOKESIA_AGENT_SESSION_RESUME_STACK_SIZE
+#       else
+#           define ESP_BROOKESIA_AGENT_SESSION_RESUME_STACK_SIZE  (8192)
+#       endif
+#   endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -48,7 +48,11 @@ bool Expression::begin(const ExpressionData &data, const EmojiMap *emoji_map, co
             );
         }
 
-        _emoji_map = emoji_map_tmp;
+        _emoji_registry.clear();
+        for (auto &[emoji, emotion_icon] : emoji_map_tmp) {
+            _emoji_registry.add(emoji, emotion_icon);
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_emoji_registry.freeze(), false, "Freeze emoji registry failed");
         _emotion_player = std::make_unique<gui::AnimPlayer>();
         ESP_UTILS_CHECK_NULL_RETURN(_emotion_player, false, "Invalid emotion player");
         ESP_UTILS_CHECK_FALSE_RETURN(_emotion_player->begin(data.emotion.data), false, "Emotion player begin failed");
@@ -65,7 +69,11 @@ bool Expression::begin(const ExpressionData &data, const EmojiMap *emoji_map, co
             );
         }
 
-        _system_icon_map = system_icon_map_tmp;
+        _system_icon_registry.clear();
+        for (auto &[icon, icon_type] : system_icon_map_tmp) {
+            _system_icon_registry.add(icon, icon_type);
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_system_icon_registry.freeze(), false, "Freeze system icon registry failed");
         _icon_player = std::make_unique<gui::AnimPlayer>();
         ESP_UTILS_CHECK_NULL_RETURN(_icon_player, false, "Invalid icon player");
         ESP_UTILS_CHECK_FALSE_RETURN(_icon_player->begin(data.icon.data), false, "Icon player begin failed");
@@ -90,6 +98,8 @@ bool Expression::del()
     _icon_operation_before_pause = gui::AnimPlayer::Operation::PlayOnceStop;
     _emotion_type_before_pause = EMOTION_TYPE_NONE;
     _icon_type_before_pause = ICON_TYPE_NONE;
+    _emoji_registry.clear();
+    _system_icon_registry.clear();
 
     return true;
 }
@@ -196,13 +206,13 @@ bool Expression::setEmoji(
         icon_config.repeat, icon_config.keep_when_stop, icon_config.immediate
     );
     ESP_UTILS_CHECK_FALSE_RETURN(_flags.is_begun, false, "Not begun");
-    ESP_UTILS_CHECK_FALSE_RETURN(_emoji_map.size() > 0, false, "Emoji map not enabled");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_emoji_registry.empty(), false, "Emoji map not enabled");
 
-    auto it = _emoji_map.find(emoji);
-    ESP_UTILS_CHECK_FALSE_RETURN(it != _emoji_map.end(), false, "Unknown emoji");
+    auto emotion_icon = _emoji_registry.get(emoji);
+    ESP_UTILS_CHECK_NULL_RETURN(emotion_icon, false, "Unknown emoji");
 
     if (_emotion_player != nullptr) {
-        auto emotion_type = it->second.first;
+        auto emotion_type = emotion_icon->first;
         gui::AnimPlayer::Operation emotion_operation = gui::AnimPlayer::Operation::Stop;
         if (emotion_type != EMOTION_TYPE_NONE) {
             emotion_operation = emotion_config.repeat ? gui::AnimPlayer::Operation::PlayLoop :
@@ -215,7 +225,7 @@ bool Expression::setEmoji(
     }
 
     if (_icon_player != nullptr) {
-        auto icon_type = it->second.second;
+        auto icon_type = emotion_icon->second;
         gui::AnimPlayer::Operation icon_operation = gui::AnimPlayer::Operation::Stop;
         if (icon_type != ICON_TYPE_NONE) {
             icon_operation = icon_config.repeat ? gui::AnimPlayer::Operation::PlayLoop :
@@ -239,13 +249,13 @@ bool Expression::setSystemIcon(const std::string &icon, const AnimOperationConfi
         config.repeat, config.keep_when_stop, config.immediate
     );
     ESP_UTILS_CHECK_FALSE_RETURN(_flags.is_begun, false, "Not begun");
-    ESP_UTILS_CHECK_FALSE_RETURN(_system_icon_map.size() > 0, false, "System icon map not enabled");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_system_icon_registry.empty(), false, "System icon map not enabled");
 
-    auto it = _system_icon_map.find(icon);
-    ESP_UTILS_CHECK_FALSE_RETURN(it != _system_icon_map.end(), false, "Unknown icon");
+    auto icon_type_ptr = _system_icon_registry.get(icon);
+    ESP_UTILS_CHECK_NULL_RETURN(icon_type_ptr, false, "Unknown icon");
 
     if (_icon_player != nullptr) {
-        auto icon_type = it->second;
+        auto icon_type = *icon_type_ptr;
         gui::AnimPlayer::Operation operation = gui::AnimPlayer::Operation::Stop;
         if (icon_type != ICON_TYPE_NONE) {
             operation = config.repeat ? gui::AnimPlayer::Operation::PlayLoop :
@@ -9,6 +9,7 @@
 #include <string>
 #include "boost/thread.hpp"
 #include "gui/anim_player/esp_brookesia_anim_player.hpp"
+#include "utils/esp_brookesia_frozen_registry.hpp"
 
 namespace esp_brookesia::ai_framework {
 
@@ -77,8 +78,9 @@ private:
     } _flags = {};
     std::mutex _mutex;
 
-    EmojiMap _emoji_map;
-    SystemIconMap _system_icon_map;
+    // Frozen in `begin()`, the emoji and icon names come with every emotion change
+    utils::FrozenRegistry<std::pair<EmotionType, IconType>> _emoji_registry;
+    utils::FrozenRegistry<IconType> _system_icon_registry;
 
     EmotionType _emotion_type_before_pause = EMOTION_TYPE_NONE;
     gui::AnimPlayer::Operation _emotion_operation_before_pause = gui::AnimPlayer::Operation::PlayOnceStop;
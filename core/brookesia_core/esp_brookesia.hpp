@@ -16,12 +16,28 @@
 /* GUI - lvgl */
 #include "style/esp_brookesia_gui_style.hpp"
 #include "gui/lvgl/esp_brookesia_lv_helper.hpp"
+/* GUI - Compositor */
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+#   include "gui/compositor/esp_brookesia_compositor.hpp"
+#endif
+/* GUI - Panel Filler */
+#if ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER
+#   include "gui/panel_filler/esp_brookesia_panel_filler.hpp"
+#endif
 
 /* Services */
 /* Services - Storage NVS */
 #if ESP_BROOKESIA_SERVICES_ENABLE_STORAGE_NVS
 #   include "services/storage_nvs/esp_brookesia_service_storage_nvs.hpp"
 #endif
+/* Services - Executor */
+#if ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR
+#   include "services/executor/esp_brookesia_service_executor.hpp"
+#endif
+/* Services - Boot */
+#if ESP_BROOKESIA_SERVICES_ENABLE_BOOT
+#   include "services/boot/esp_brookesia_service_boot.hpp"
+#endif
 
 /* Systems */
 /* Systems - Core */
@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <utility>
+#include "esp_brookesia_gui_internal.h"
+// Don't use the utils of the animation player, the verifier is also built by the host test without the player
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:AnimVerify"
+#include "esp_lib_utils.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG || defined(ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG)
+#   undef ESP_UTILS_LOGD_IMPL_FUNC
+#   define ESP_UTILS_LOGD_IMPL_FUNC(fmt, ...)
+#endif
+#include "esp_brookesia_anim_asset_verifier.hpp"
+
+#define FNV_OFFSET_BASIS    (2166136261UL)
+#define FNV_PRIME           (16777619UL)
+
+namespace esp_brookesia::gui {
+
+static uint32_t get_u32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static uint32_t update_hash(uint32_t hash, const uint8_t *data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+AnimAssetVerifier::AnimAssetVerifier(ReadFunction read_function, uint32_t image_size):
+    _read_function(std::move(read_function)),
+    _image_size(image_size)
+{
+}
+
+bool AnimAssetVerifier::checkIndex(uint32_t checksum, const std::vector<Asset> &assets)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    _state = State::Unchecked;
+
+    uint8_t header[HEADER_SIZE] = {};
+    ESP_UTILS_CHECK_FALSE_RETURN(read(0, header, sizeof(header)), false, "Read header failed");
+
+    uint32_t file_num = get_u32(header);
+    uint32_t header_checksum = get_u32(header + 4);
+    uint32_t stored_length = get_u32(header + 8);
+    ESP_UTILS_LOGD(
+        "Header: files(%d), checksum(0x%04x), length(%d)", static_cast<int>(file_num),
+        static_cast<unsigned>(header_checksum), static_cast<int>(stored_length)
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        header_checksum == checksum, false, "Checksum mismatch: 0x%04x != 0x%04x",
+        static_cast<unsigned>(header_checksum), static_cast<unsigned>(checksum)
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        file_num == assets.size(), false, "File number mismatch: %d != %d", static_cast<int>(file_num),
+        static_cast<int>(assets.size())
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        stored_length <= _image_size - std::min(_image_size, HEADER_SIZE), false, "Image length(%d) out of range",
+        static_cast<int>(stored_length)
+    );
+
+    // The data of the assets follows each other at the end of the image, right after the index table
+    uint64_t data_length = 0;
+    for (auto &asset : assets) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            asset.offset == data_length, false, "Asset offset(%d) doesn't follow the previous one(%d)",
+            static_cast<int>(asset.offset), static_cast<int>(data_length)
+        );
+        data_length += ASSET_MAGIC_SIZE + asset.size;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        data_length < stored_length, false, "Data length(%d) out of range", static_cast<int>(data_length)
+    );
+    uint32_t data_start = HEADER_SIZE + stored_length - static_cast<uint32_t>(data_length);
+
+    for (size_t i = 0; i < assets.size(); i++) {
+        uint8_t magic[ASSET_MAGIC_SIZE] = {};
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            read(data_start + assets[i].offset, magic, sizeof(magic)), false, "Read asset(%d) magic failed",
+            static_cast<int>(i)
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (magic[0] == ASSET_MAGIC_BYTE) && (magic[1] == ASSET_MAGIC_BYTE), false,
+            "Invalid asset(%d) magic: 0x%02x%02x", static_cast<int>(i), magic[0], magic[1]
+        );
+    }
+
+    // The header and the index identify the image, the data is only covered by the checksum
+    uint32_t hash = update_hash(FNV_OFFSET_BASIS, header, sizeof(header));
+    uint8_t buffer[READ_BUFFER_SIZE];
+    for (uint32_t offset = HEADER_SIZE; offset < data_start;) {
+        uint32_t size = std::min(READ_BUFFER_SIZE, data_start - offset);
+        ESP_UTILS_CHECK_FALSE_RETURN(read(offset, buffer, size), false, "Read index failed");
+        hash = update_hash(hash, buffer, size);
+        offset += size;
+    }
+
+    _checksum = header_checksum;
+    _image_hash = hash;
+    _scan_offset = HEADER_SIZE;
+    _scan_end = HEADER_SIZE + stored_length;
+    _scan_sum = 0;
+    _state = State::Indexed;
+
+    return true;
+}
+
+AnimAssetVerifier::State AnimAssetVerifier::scan(uint32_t max_bytes)
+{
+    if (_state != State::Indexed) {
+        return _state;
+    }
+
+    uint8_t buffer[READ_BUFFER_SIZE];
+    uint32_t end = _scan_offset + std::min(max_bytes, _scan_end - _scan_offset);
+    while (_scan_offset < end) {
+        uint32_t size = std::min(READ_BUFFER_SIZE, end - _scan_offset);
+        if (!read(_scan_offset, buffer, size)) {
+            ESP_UTILS_LOGE("Read image at offset(%d) failed", static_cast<int>(_scan_offset));
+            _state = State::Corrupt;
+            return _state;
+        }
+        for (uint32_t i = 0; i < size; i++) {
+            _scan_sum += buffer[i];
+        }
+        _scan_offset += size;
+    }
+
+    if (_scan_offset == _scan_end) {
+        uint32_t sum = _scan_sum & CHECKSUM_MASK;
+        if (sum == _checksum) {
+            ESP_UTILS_LOGD("Image verified, hash(0x%08x)", static_cast<unsigned>(_image_hash));
+            _state = State::Verified;
+        } else {
+            ESP_UTILS_LOGE(
+                "Image corrupted, checksum 0x%04x != 0x%04x", static_cast<unsigned>(sum),
+                static_cast<unsigned>(_checksum)
+            );
+            _state = State::Corrupt;
+        }
+    }
+
+    return _state;
+}
+
+void AnimAssetVerifier::markVerified()
+{
+    if (_state == State::Indexed) {
+        _scan_offset = _scan_end;
+        _state = State::Verified;
+    }
+}
+
+bool AnimAssetVerifier::read(uint32_t offset, void *buffer, uint32_t size) const
+{
+    if ((offset > _image_size) || (size > _image_size - offset)) {
+        return false;
+    }
+
+    return _read_function(offset, buffer, size);
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Integrity checker of an assets partition image generated by `spiffs_create_partition_assets()`
+ *
+ * The image is made of a header (file number, checksum, length of the rest), the index table, then the data of every
+ * asset preceded by a magic. The check is split in two steps:
+ *
+ * - `checkIndex()` only reads the header, the index table and the magics, it is fast enough to run before the assets
+ *   are used;
+ * - `scan()` sums the index table and the data against the checksum of the header, a given number of bytes per call,
+ *   so the work can be spread over a low priority task or finished on the first access of an asset.
+ *
+ * The checksum covers the whole image, so an asset can't be trusted until the scan of the image is done.
+ * The class is not thread-safe.
+ */
+class AnimAssetVerifier {
+public:
+    enum class State : uint8_t {
+        Unchecked = 0,  // `checkIndex()` not called yet, or failed
+        Indexed,        // Header and index are valid, the data is not fully scanned yet
+        Verified,
+        Corrupt,
+    };
+
+    struct Asset {
+        uint32_t offset;    // Offset of the asset data from the data of the first asset
+        uint32_t size;
+    };
+
+    using ReadFunction = std::function<bool(uint32_t offset, void *buffer, uint32_t size)>;
+
+    static constexpr uint32_t HEADER_SIZE = 12;
+    static constexpr uint32_t ASSET_MAGIC_SIZE = 2;
+    static constexpr uint8_t ASSET_MAGIC_BYTE = 0x5A;
+    static constexpr uint32_t CHECKSUM_MASK = 0xFFFF;
+    static constexpr uint32_t READ_BUFFER_SIZE = 1024;
+
+    /**
+     * @param read_function  Reads `size` bytes of the image at `offset`, returns false on error
+     * @param image_size     Size of the storage holding the image, e.g. the partition size
+     */
+    AnimAssetVerifier(ReadFunction read_function, uint32_t image_size);
+
+    /**
+     * @brief Check the header and the index of the image against the assets found by the assets library
+     *
+     * @param checksum  Checksum expected by the application, generated with the image
+     * @param assets    Offset and size of every asset, in the order of the index table
+     *
+     * @return true if the header and the index are valid, the state is then `Indexed`
+     */
+    bool checkIndex(uint32_t checksum, const std::vector<Asset> &assets);
+
+    /**
+     * @brief Sum the next `max_bytes` bytes of the image, and compare the sum with the checksum at the end
+     *
+     * @return State after the call, `Verified` or `Corrupt` once the whole image is scanned
+     */
+    State scan(uint32_t max_bytes);
+
+    /**
+     * @brief Mark the image as verified without scanning it, e.g. when the image hash was verified on a previous boot
+     */
+    void markVerified();
+
+    State getState() const
+    {
+        return _state;
+    }
+
+    /**
+     * @brief Hash of the header and the index table, which identifies the image. Valid after `checkIndex()`
+     */
+    uint32_t getImageHash() const
+    {
+        return _image_hash;
+    }
+
+    /**
+     * @brief Number of bytes scanned and total number of bytes to scan
+     */
+    void getScanProgress(uint32_t &scanned, uint32_t &total) const
+    {
+        scanned = _scan_offset - HEADER_SIZE;
+        total = _scan_end - HEADER_SIZE;
+    }
+
+private:
+    bool read(uint32_t offset, void *buffer, uint32_t size) const;
+
+    ReadFunction _read_function;
+    uint32_t _image_size = 0;
+    State _state = State::Unchecked;
+    uint32_t _checksum = 0;
+    uint32_t _image_hash = 0;
+    uint32_t _scan_offset = HEADER_SIZE;
+    uint32_t _scan_end = HEADER_SIZE;
+    uint32_t _scan_sum = 0;
+};
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,314 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include "esp_brookesia_gui_internal.h"
+// Don't use the utils of the animation player, the decoder is also built by the host test without the player
+#ifdef ESP_UTILS_LOG_TAG
+#   undef ESP_UTILS_LOG_TAG
+#endif
+#define ESP_UTILS_LOG_TAG "BS:AnimCodec"
+#include "esp_lib_utils.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG || defined(ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG)
+#   undef ESP_UTILS_LOGD_IMPL_FUNC
+#   define ESP_UTILS_LOGD_IMPL_FUNC(fmt, ...)
+#endif
+#include "esp_brookesia_anim_codec.hpp"
+
+#define OP_LENGTH_BITS  (6)
+#define OP_LENGTH_MASK  ((1 << OP_LENGTH_BITS) - 1)
+
+namespace esp_brookesia::gui {
+
+static uint16_t get_u16(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+bool AnimCodecDecoder::isEncoded(const void *data, size_t length)
+{
+    return (data != nullptr) && (length >= HEADER_SIZE) && (memcmp(data, MAGIC, sizeof(MAGIC)) == 0);
+}
+
+bool AnimCodecDecoder::begin(const void *data, size_t length, bool swap_bytes)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    _frame_num = 0;
+    _last_frame = -1;
+    _palette_index = -1;
+    ESP_UTILS_CHECK_FALSE_RETURN(isEncoded(data, length), false, "Invalid header");
+
+    auto header = static_cast<const uint8_t *>(data);
+    _data = header;
+    _length = length;
+    _swap_bytes = swap_bytes;
+    _width = get_u16(header + 4);
+    _height = get_u16(header + 6);
+    int frame_num = get_u16(header + 8);
+    _tile_size = header[10];
+    _palette_num = get_u16(header + 12);
+    _palette_table_offset = get_u32(header + 16);
+    _frame_table_offset = get_u32(header + 20);
+    ESP_UTILS_LOGD(
+        "Header: size(%dx%d), frames(%d), tile(%d), palettes(%d)", _width, _height, frame_num, _tile_size,
+        _palette_num
+    );
+
+    ESP_UTILS_CHECK_FALSE_RETURN((_width > 0) && (_height > 0), false, "Invalid size: %dx%d", _width, _height);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_tile_size == 8) || (_tile_size == 16) || (_tile_size == 32), false, "Invalid tile size: %d", _tile_size
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN((frame_num > 0) && (_palette_num > 0), false, "No frame or palette");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_palette_table_offset <= length) &&
+        (static_cast<size_t>(_palette_num) * 4 <= length - _palette_table_offset), false, "Palette table out of range"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (_frame_table_offset <= length) && (static_cast<size_t>(frame_num) * 8 <= length - _frame_table_offset),
+        false, "Frame table out of range"
+    );
+
+    _tiles_x = (_width + _tile_size - 1) / _tile_size;
+    _tiles_y = (_height + _tile_size - 1) / _tile_size;
+    size_t frame_size_min = FRAME_HEADER_SIZE + (_tiles_x * _tiles_y * 2 + 7) / 8;
+    for (int i = 0; i < frame_num; i++) {
+        auto entry = _data + _frame_table_offset + i * 8;
+        uint32_t offset = get_u32(entry);
+        uint32_t size = get_u32(entry + 4);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (offset <= length) && (size <= length - offset) && (size >= frame_size_min), false,
+            "Frame(%d) out of range", i
+        );
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _data[get_u32(_data + _frame_table_offset) + 2] == FRAME_KEY, false, "First frame is not a key frame"
+    );
+    _frame_num = frame_num;
+
+    return true;
+}
+
+bool AnimCodecDecoder::decodeFrame(int index, uint16_t *buffer, int &y_start, int &y_end)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN((index >= 0) && (index < _frame_num), false, "Invalid index: %d", index);
+    ESP_UTILS_CHECK_NULL_RETURN(buffer, false, "Invalid buffer");
+
+    // A delta frame only applies to the frame before it. Applying it again to its own result changes nothing
+    int start = index;
+    if ((index != _last_frame) && (index != _last_frame + 1)) {
+        const uint8_t *frame = nullptr;
+        uint32_t size = 0;
+        while ((start > 0) && getFrame(start, frame, size) && (frame[2] != FRAME_KEY)) {
+            start--;
+        }
+    }
+
+    y_start = _height;
+    y_end = 0;
+    for (int i = start; i <= index; i++) {
+        int frame_y_start = 0;
+        int frame_y_end = 0;
+        if (!decodeOneFrame(i, buffer, frame_y_start, frame_y_end)) {
+            ESP_UTILS_LOGE("Decode frame(%d) failed", i);
+            _last_frame = -1;
+            return false;
+        }
+        if (frame_y_start < frame_y_end) {
+            y_start = std::min(y_start, frame_y_start);
+            y_end = std::max(y_end, frame_y_end);
+        }
+    }
+    if (y_start >= y_end) {
+        y_start = y_end = 0;
+    }
+    _last_frame = index;
+
+    return true;
+}
+
+bool AnimCodecDecoder::decodeOneFrame(int index, uint16_t *buffer, int &y_start, int &y_end)
+{
+    const uint8_t *frame = nullptr;
+    uint32_t size = 0;
+    if (!getFrame(index, frame, size) || !loadPalette(get_u16(frame))) {
+        return false;
+    }
+
+    bool is_key = (frame[2] == FRAME_KEY);
+    int bits = frame[3];
+    if ((bits != 1) && (bits != 2) && (bits != 4) && (bits != 8)) {
+        return false;
+    }
+
+    const uint8_t *modes = frame + FRAME_HEADER_SIZE;
+    const uint8_t *pos = modes + (_tiles_x * _tiles_y * 2 + 7) / 8;
+    const uint8_t *end = frame + size;
+    const uint16_t *palette = _palette;
+    int tile_y_min = _tiles_y;
+    int tile_y_max = -1;
+    for (int ty = 0; ty < _tiles_y; ty++) {
+        int y0 = ty * _tile_size;
+        int th = std::min(_tile_size, _height - y0);
+        for (int tx = 0; tx < _tiles_x; tx++) {
+            int tile = ty * _tiles_x + tx;
+            int mode = (modes[tile >> 2] >> (6 - 2 * (tile & 3))) & 0x3;
+            if (mode == TILE_SKIP) {
+                if (is_key) {
+                    return false;
+                }
+                continue;
+            }
+            tile_y_min = std::min(tile_y_min, ty);
+            tile_y_max = ty;
+
+            int x0 = tx * _tile_size;
+            int tw = std::min(_tile_size, _width - x0);
+            uint16_t *out = buffer + y0 * _width + x0;
+            switch (mode) {
+            case TILE_FILL: {
+                if (pos >= end) {
+                    return false;
+                }
+                uint16_t color = palette[*pos++];
+                for (int y = 0; y < th; y++, out += _width) {
+                    std::fill_n(out, tw, color);
+                }
+                break;
+            }
+            case TILE_RAW: {
+                size_t raw_size = (tw * th * bits + 7) / 8;
+                if (static_cast<size_t>(end - pos) < raw_size) {
+                    return false;
+                }
+                if (bits == 8) {
+                    for (int y = 0; y < th; y++, out += _width) {
+                        for (int x = 0; x < tw; x++) {
+                            out[x] = palette[*pos++];
+                        }
+                    }
+                } else {
+                    uint32_t bit = 0;
+                    uint8_t mask = (1 << bits) - 1;
+                    for (int y = 0; y < th; y++, out += _width) {
+                        for (int x = 0; x < tw; x++, bit += bits) {
+                            out[x] = palette[(pos[bit >> 3] >> (8 - bits - (bit & 0x7))) & mask];
+                        }
+                    }
+                    pos += raw_size;
+                }
+                break;
+            }
+            case TILE_OPS: {
+                int x = 0;
+                int y = 0;
+                int remaining = tw * th;
+                while (remaining > 0) {
+                    if (pos >= end) {
+                        return false;
+                    }
+                    int op = *pos >> OP_LENGTH_BITS;
+                    int length = (*pos++ & OP_LENGTH_MASK) + 1;
+                    if ((length > remaining) || ((op == OP_COPY_UP) && (y == 0)) || ((op == OP_KEEP) && is_key) ||
+                            ((op == OP_LITERAL) && (end - pos < length)) || ((op == OP_RUN) && (pos >= end))) {
+                        return false;
+                    }
+                    uint16_t color = (op == OP_RUN) ? palette[*pos++] : 0;
+                    remaining -= length;
+                    // Split the operation at the end of the rows of the tile
+                    while (length > 0) {
+                        int count = std::min(length, tw - x);
+                        uint16_t *row = out + y * _width + x;
+                        switch (op) {
+                        case OP_LITERAL:
+                            for (int i = 0; i < count; i++) {
+                                row[i] = palette[*pos++];
+                            }
+                            break;
+                        case OP_RUN:
+                            std::fill_n(row, count, color);
+                            break;
+                        case OP_COPY_UP:
+                            memcpy(row, row - _width, count * sizeof(uint16_t));
+                            break;
+                        default:
+                            break;
+                        }
+                        length -= count;
+                        x += count;
+                        if (x == tw) {
+                            x = 0;
+                            y++;
+                        }
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    if (tile_y_max < 0) {
+        y_start = y_end = 0;
+    } else {
+        y_start = tile_y_min * _tile_size;
+        y_end = std::min((tile_y_max + 1) * _tile_size, _height);
+    }
+
+    return true;
+}
+
+bool AnimCodecDecoder::loadPalette(int index)
+{
+    if (index == _palette_index) {
+        return true;
+    }
+    if (index >= _palette_num) {
+        return false;
+    }
+
+    uint32_t offset = get_u32(_data + _palette_table_offset + index * 4);
+    if ((offset > _length) || (_length - offset < 2)) {
+        return false;
+    }
+    int color_num = get_u16(_data + offset);
+    if ((color_num > PALETTE_COLOR_MAX) || (static_cast<size_t>(color_num) * 2 > _length - offset - 2)) {
+        return false;
+    }
+
+    auto colors = _data + offset + 2;
+    for (int i = 0; i < color_num; i++) {
+        uint16_t color = get_u16(colors + i * 2);
+        _palette[i] = _swap_bytes ? static_cast<uint16_t>((color >> 8) | (color << 8)) : color;
+    }
+    // Indices past the palette of a corrupted file still read a valid entry
+    std::fill(_palette + color_num, _palette + PALETTE_COLOR_MAX, 0);
+    _palette_index = index;
+
+    return true;
+}
+
+bool AnimCodecDecoder::getFrame(int index, const uint8_t *&data, uint32_t &size) const
+{
+    if ((index < 0) || (index >= _frame_num)) {
+        return false;
+    }
+
+    auto entry = _data + _frame_table_offset + index * 8;
+    data = _data + get_u32(entry);
+    size = get_u32(entry + 4);
+
+    return true;
+}
+
+} // namespace esp_brookesia::gui
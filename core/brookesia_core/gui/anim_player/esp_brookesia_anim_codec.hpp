@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Decoder of the tile codec of the animation player, whose files are packed from AAF files by
+ *        `tools/anim_pack.py`
+ *
+ * Every frame is split in square tiles. A tile of a delta frame is skipped when it is the same as in the previous
+ * frame, otherwise it is a single color, raw palette indices packed on 1, 2, 4 or 8 bits, or a stream of operations:
+ * literal indices, runs, copies of the row above and pixels kept from the previous frame. Frames use RGB565 palettes
+ * of the colors they need only, shared by the frames with the same colors.
+ *
+ * The decoder writes into a RGB565 buffer of the whole frame which must be kept between the calls, since a delta
+ * frame only writes what changed. Decoding the frames in order only reads the data of these frames, jumping to
+ * another frame decodes again from the key frame before it.
+ */
+class AnimCodecDecoder {
+public:
+    static constexpr uint8_t MAGIC[] = {'B', 'A', 'C', '1'};
+    static constexpr size_t HEADER_SIZE = 24;
+    static constexpr size_t FRAME_HEADER_SIZE = 4;
+    static constexpr int PALETTE_COLOR_MAX = 256;
+
+    enum FrameType : uint8_t {
+        FRAME_KEY = 0,
+        FRAME_DELTA,
+    };
+
+    enum TileMode : uint8_t {
+        TILE_SKIP = 0,
+        TILE_FILL,
+        TILE_OPS,
+        TILE_RAW,
+    };
+
+    enum Operation : uint8_t {
+        OP_LITERAL = 0,
+        OP_RUN,
+        OP_COPY_UP,
+        OP_KEEP,
+    };
+
+    /**
+     * @brief Check if the data is a file of the codec, instead of an AAF file
+     */
+    static bool isEncoded(const void *data, size_t length);
+
+    /**
+     * @brief Check the header and the tables of the file, and reset the decoding
+     *
+     * @param data        File data, which must stay valid while decoding. Memory mapped flash is fine
+     * @param length      File length
+     * @param swap_bytes  Swap the bytes of the output RGB565 pixels
+     */
+    bool begin(const void *data, size_t length, bool swap_bytes);
+
+    int getWidth() const
+    {
+        return _width;
+    }
+
+    int getHeight() const
+    {
+        return _height;
+    }
+
+    int getFrameNum() const
+    {
+        return _frame_num;
+    }
+
+    /**
+     * @brief Decode a frame
+     *
+     * @param index    Frame index
+     * @param buffer   RGB565 buffer of `width * height` pixels, holding the frame decoded by the previous call
+     * @param y_start  Output of the first row changed by the frame
+     * @param y_end    Output of the row after the last row changed, equal to `y_start` if nothing changed
+     *
+     * @return false if the frame data is invalid
+     */
+    bool decodeFrame(int index, uint16_t *buffer, int &y_start, int &y_end);
+
+private:
+    bool decodeOneFrame(int index, uint16_t *buffer, int &y_start, int &y_end);
+    bool loadPalette(int index);
+    bool getFrame(int index, const uint8_t *&data, uint32_t &size) const;
+
+    const uint8_t *_data = nullptr;
+    size_t _length = 0;
+    bool _swap_bytes = false;
+    int _width = 0;
+    int _height = 0;
+    int _frame_num = 0;
+    int _tile_size = 0;
+    int _tiles_x = 0;
+    int _tiles_y = 0;
+    int _palette_num = 0;
+    uint32_t _palette_table_offset = 0;
+    uint32_t _frame_table_offset = 0;
+    int _last_frame = -1;
+    int _palette_index = -1;
+    uint16_t _palette[PALETTE_COLOR_MAX] = {};
+};
+
+} // namespace esp_brookesia::gui
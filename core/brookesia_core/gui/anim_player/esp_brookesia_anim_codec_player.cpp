@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_heap_caps.h"
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_codec_player.hpp"
+
+#define THREAD_EXIT_CHECK_INTERVAL_MS       100
+
+#define CODEC_PLAYER_THREAD_NAME            "anim_codec"
+#define CODEC_PLAYER_FPS_DEFAULT            (30)
+
+namespace esp_brookesia::gui {
+
+AnimCodecPlayer::~AnimCodecPlayer()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_is_begun && !del()) {
+        ESP_UTILS_LOGE("Delete failed");
+    }
+}
+
+bool AnimCodecPlayer::begin(const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_begun, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(config.flush_callback && config.event_callback, false, "Invalid callbacks");
+
+    _config = config;
+    _thread_need_exit = false;
+    {
+        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+            .name = CODEC_PLAYER_THREAD_NAME,
+            .core_id = config.task_affinity,
+            .priority = static_cast<size_t>(config.task_priority),
+            .stack_size = static_cast<size_t>(config.task_stack),
+            .stack_in_ext = config.task_stack_in_ext,
+        });
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            _thread = boost::thread([this] { run(); }), false, "Create thread failed"
+        );
+    }
+    _is_begun = true;
+
+    return true;
+}
+
+bool AnimCodecPlayer::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    {
+        std::lock_guard lock(_mutex);
+        _thread_need_exit = true;
+        _cv.notify_all();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    heap_caps_free(_buffer);
+    _buffer = nullptr;
+    _buffer_size = 0;
+    _has_action = false;
+    _is_active = false;
+    _is_playing = false;
+    _is_begun = false;
+
+    return true;
+}
+
+bool AnimCodecPlayer::setSource(const void *data, size_t length)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_playing, false, "Still playing");
+    ESP_UTILS_CHECK_FALSE_RETURN(_decoder.begin(data, length, _config.swap_bytes), false, "Invalid animation data");
+
+    // The buffer keeps the last frame, since the next one only writes what changed
+    size_t size = static_cast<size_t>(_decoder.getWidth()) * _decoder.getHeight() * sizeof(uint16_t);
+    if (size > _buffer_size) {
+        heap_caps_free(_buffer);
+        _buffer_size = 0;
+        uint32_t caps = (_config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+        _buffer = static_cast<uint16_t *>(heap_caps_malloc(size, caps));
+        ESP_UTILS_CHECK_NULL_RETURN(_buffer, false, "Allocate frame buffer(%d) failed", static_cast<int>(size));
+        _buffer_size = size;
+    }
+    _segment_start = 0;
+    _segment_end = _decoder.getFrameNum() - 1;
+
+    return true;
+}
+
+void AnimCodecPlayer::getSegment(uint32_t &start, uint32_t &end)
+{
+    std::lock_guard lock(_mutex);
+    start = 0;
+    end = std::max(_decoder.getFrameNum() - 1, 0);
+}
+
+void AnimCodecPlayer::setSegment(uint32_t start, uint32_t end, int fps, bool repeat)
+{
+    std::lock_guard lock(_mutex);
+    uint32_t last = std::max(_decoder.getFrameNum() - 1, 0);
+    _segment_end = std::min(end, last);
+    _segment_start = std::min(start, _segment_end);
+    _frame_period_ms = 1000 / ((fps > 0) ? fps : CODEC_PLAYER_FPS_DEFAULT);
+    _is_repeat = repeat;
+}
+
+void AnimCodecPlayer::update(player_action_t action)
+{
+    std::lock_guard lock(_mutex);
+    _action = action;
+    _has_action = true;
+    _cv.notify_all();
+}
+
+void AnimCodecPlayer::notifyFlushFinished()
+{
+    std::lock_guard lock(_mutex);
+    _is_flush_done = true;
+    _cv.notify_all();
+}
+
+void AnimCodecPlayer::run()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::unique_lock lock(_mutex);
+    while (!_thread_need_exit) {
+        if (_has_action) {
+            _has_action = false;
+            if (_action == PLAYER_ACTION_START) {
+                ESP_UTILS_LOGD(
+                    "Start segment(%d,%d)", static_cast<int>(_segment_start), static_cast<int>(_segment_end)
+                );
+                _is_active = (_buffer != nullptr);
+                _is_playing = _is_active;
+                _frame = _segment_start;
+                _next_frame_time = Clock::now();
+            } else if (_is_active) {
+                _is_active = false;
+                _is_playing = false;
+                lock.unlock();
+                _config.event_callback(PLAYER_EVENT_IDLE);
+                lock.lock();
+            }
+            continue;
+        }
+
+        if (!_is_playing || (Clock::now() < _next_frame_time)) {
+            auto timeout = _is_playing ? _next_frame_time :
+                           Clock::now() + std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS);
+            _cv.wait_until(lock, timeout, [this] {
+                return _has_action || _thread_need_exit;
+            });
+            continue;
+        }
+
+        uint32_t frame = _frame;
+        _next_frame_time += std::chrono::milliseconds(_frame_period_ms);
+        if (!playFrame(frame, lock)) {
+            ESP_UTILS_LOGE("Play frame(%d) failed, pause", static_cast<int>(frame));
+            _is_playing = false;
+            continue;
+        }
+        // Don't try to catch up after a slow frame
+        _next_frame_time = std::max(_next_frame_time, Clock::now());
+
+        if (frame < _segment_end) {
+            _frame = frame + 1;
+            continue;
+        }
+        if (_is_repeat) {
+            _frame = _segment_start;
+        } else {
+            _is_playing = false;
+        }
+        lock.unlock();
+        _config.event_callback(PLAYER_EVENT_ALL_FRAME_DONE);
+        lock.lock();
+    }
+}
+
+bool AnimCodecPlayer::playFrame(int index, std::unique_lock<std::mutex> &lock)
+{
+    // The source doesn't change while playing, the frame is decoded with the lock held
+    int y_start = 0;
+    int y_end = 0;
+    ESP_UTILS_CHECK_FALSE_RETURN(_decoder.decodeFrame(index, _buffer, y_start, y_end), false, "Decode failed");
+    if (y_start >= y_end) {
+        return true;
+    }
+
+    _is_flush_done = false;
+    lock.unlock();
+    _config.flush_callback(
+        0, y_start, _decoder.getWidth(), y_end, _buffer + static_cast<size_t>(y_start) * _decoder.getWidth()
+    );
+    lock.lock();
+    // The rows must be drawn before the buffer is written again, a stop doesn't wait for it
+    _cv.wait(lock, [this] {
+        return _is_flush_done || _thread_need_exit || (_has_action && (_action == PLAYER_ACTION_STOP));
+    });
+
+    return true;
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include "boost/thread.hpp"
+#include "anim_player.h"
+#include "esp_brookesia_anim_codec.hpp"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Player of the animations packed with the tile codec, with the same actions, segments and events as the
+ *        player of the AAF files, so `AnimPlayer` can choose one or the other for each animation
+ *
+ * The frames are decoded into a buffer of the whole canvas, and only the rows changed by a frame are flushed.
+ */
+class AnimCodecPlayer {
+public:
+    using FlushCallback = std::function<void(int x1, int y1, int x2, int y2, const void *data)>;
+    using EventCallback = std::function<void(player_event_t event)>;
+
+    struct Config {
+        FlushCallback flush_callback;
+        EventCallback event_callback;
+        bool swap_bytes;
+        int task_priority;
+        int task_stack;
+        int task_affinity;
+        bool task_stack_in_ext;
+        bool buffer_in_ext;
+    };
+
+    AnimCodecPlayer() = default;
+    ~AnimCodecPlayer();
+
+    AnimCodecPlayer(const AnimCodecPlayer &) = delete;
+    AnimCodecPlayer &operator=(const AnimCodecPlayer &) = delete;
+
+    bool begin(const Config &config);
+    bool del();
+
+    /**
+     * @brief Set the animation to play, the player must be stopped
+     */
+    bool setSource(const void *data, size_t length);
+    void getSegment(uint32_t &start, uint32_t &end);
+    void setSegment(uint32_t start, uint32_t end, int fps, bool repeat);
+
+    /**
+     * @brief Start the segment from its first frame, or stop. `PLAYER_EVENT_IDLE` is sent once stopped
+     */
+    void update(player_action_t action);
+
+    /**
+     * @brief Tell the player that the last flushed rows are drawn, so the buffer can be written again
+     */
+    void notifyFlushFinished();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    bool playFrame(int index, std::unique_lock<std::mutex> &lock);
+
+    bool _is_begun = false;
+    Config _config = {};
+    AnimCodecDecoder _decoder;
+    uint16_t *_buffer = nullptr;
+    size_t _buffer_size = 0;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _has_action = false;
+    player_action_t _action = PLAYER_ACTION_STOP;
+    bool _is_active = false;        // Started and not stopped yet, paused on the last frame after a segment played once
+    bool _is_playing = false;
+    bool _is_flush_done = true;
+    uint32_t _segment_start = 0;
+    uint32_t _segment_end = 0;
+    uint32_t _frame = 0;
+    int _frame_period_ms = 0;
+    bool _is_repeat = false;
+    Clock::time_point _next_frame_time;
+
+    std::atomic<bool> _thread_need_exit = false;
+    boost::thread _thread;
+};
+
+} // namespace esp_brookesia::gui
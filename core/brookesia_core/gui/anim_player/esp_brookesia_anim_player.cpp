@@ -3,8 +3,14 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 #include <vector>
 #include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "nvs.h"
+#include "nvs_flash.h"
 #include "private/esp_brookesia_anim_player_utils.hpp"
 #include "esp_brookesia_anim_player.hpp"
 
@@ -14,8 +20,32 @@
 #define ANIM_EVENT_THREAD_STACK_SIZE        (10 * 1024)
 #define ANIM_EVENT_THREAD_STACK_CAPS_EXT    (true)
 
+#define ANIM_VERIFY_THREAD_NAME             "anim_verify"
+#define ANIM_VERIFY_THREAD_PRIORITY         (1)
+#define ANIM_VERIFY_THREAD_STACK_SIZE       (4 * 1024)
+#define ANIM_VERIFY_THREAD_STACK_CAPS_EXT   (false)
+#define ANIM_VERIFY_CHUNK_SIZE              (16 * 1024)
+#define ANIM_VERIFY_CHUNK_INTERVAL_MS       (5)
+// Once a play waits for the verification, the task still yields to let the idle task run
+#define ANIM_VERIFY_URGENT_CHUNK_INTERVAL_MS (1)
+
+#define ANIM_VERIFY_NVS_NAMESPACE           "bs_anim"
+
 namespace esp_brookesia::gui {
 
+// NVS keys are too short for partition labels, the key is "p" and the FNV-1a hash of the whole label
+static std::string get_verify_nvs_key(const char *partition_label)
+{
+    uint32_t hash = 2166136261u;
+    for (const char *c = partition_label; *c != '\0'; c++) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    snprintf(key, sizeof(key), "p%08" PRIx32, hash);
+
+    return key;
+}
+
 AnimPlayer::FlushReadySignal AnimPlayer::flush_ready_signal;
 AnimPlayer::AnimationStopSignal AnimPlayer::animation_stop_signal;
 
@@ -53,7 +83,7 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
             .checksum = partition_config.checksum,
             .flags = {
                 .mmap_enable = true,
-                .full_check = true,
+                .full_check = (partition_config.verify_mode == AnimPlayerVerifyMode::Full),
             },
         };
         ESP_UTILS_CHECK_FALSE_RETURN(
@@ -69,6 +99,10 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
             _animation_configs[i].data_address = mmap_assets_get_mem(_assets_handle, i);
             _animation_configs[i].data_length = mmap_assets_get_size(_assets_handle, i);
         }
+
+        if (partition_config.verify_mode == AnimPlayerVerifyMode::Deferred) {
+            ESP_UTILS_CHECK_FALSE_GOTO(beginAssetsVerify(partition_config), err, "Begin assets verify failed");
+        }
     } else {
         ESP_UTILS_LOGD("Disable source partition");
         for (int i = 0; i < data.source.animation_num; i++) {
@@ -89,57 +123,15 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
         anim_player_config_t config = {
             .flush_cb = [](anim_player_handle_t handle, int x1, int y1, int x2, int y2, const void *data)
             {
-                // ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
-
-                // ESP_UTILS_LOGD("Param: x1(%03d), y1(%03d), x2(%03d), y2(%03d), data(%p)", x1, y1, x2, y2, data);
-
                 auto *self = static_cast<AnimPlayer *>(anim_player_get_user_data(handle));
                 ESP_UTILS_CHECK_NULL_EXIT(self, "Invalid user data");
-                auto &canvas_config = self->_canvas_config;
-
-                ESP_UTILS_CHECK_FALSE_EXIT(
-                    (x1 > 0 || y1 > 0 || x2 <= canvas_config.width),
-                    "Invalid coordinates: (%03d,%03d)-(%03d,%03d)", x1, y1, x2, y2
-                );
-
-                int x_start = x1 + canvas_config.coord_x;
-                int y_start = y1 + canvas_config.coord_y;
-                int width = std::min(x2 - x1, canvas_config.width);
-                int height = std::min(y2 - y1, canvas_config.height);
-                int x_end = std::min(x_start + width, canvas_config.coord_x + canvas_config.width);
-                int y_end = std::min(y_start + height, canvas_config.coord_y + canvas_config.height);
-
-                flush_ready_signal(x_start, y_start, x_end, y_end, data, self);
+                self->onPlayerFlush(x1, y1, x2, y2, data);
             },
             .update_cb = [](anim_player_handle_t handle, player_event_t event)
             {
-                // ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
-
-                // ESP_UTILS_LOGD("Param: handle(%p), event(%d)", handle, static_cast<int>(event));
-
                 auto *self = static_cast<AnimPlayer *>(anim_player_get_user_data(handle));
                 ESP_UTILS_CHECK_NULL_EXIT(self, "Invalid user data");
-
-                std::unique_lock<std::mutex> lock(self->_player_mutex);
-                if (event == PLAYER_EVENT_ALL_FRAME_DONE) {
-                    if (self->_player_operation == Operation::PlayOnceStop) {
-                        ESP_UTILS_LOGD("Animation play once stop: %d", self->_player_index);
-                        if ((self->_event_queue.empty()) && !self->_player_flags.is_starting) {
-                            self->sendEvent({-1, Operation::Stop, {true, true}}, false);
-                        }
-                    } else if (self->_player_operation == Operation::PlayOncePause) {
-                        ESP_UTILS_LOGD("Animation play once pause: %d", self->_player_index);
-                        self->_player_state = OperationState::Pause;
-                    }
-                    self->_player_flags.is_end = true;
-                } else if (event == PLAYER_EVENT_IDLE) {
-                    ESP_UTILS_LOGD("Animation idle: %d", self->_player_index);
-                    self->_player_state = OperationState::Stop;
-                    self->_player_flags.is_end = true;
-                    self->_player_index = -1;
-                }
-
-                self->_player_condition.notify_all();
+                self->onPlayerEvent(event);
             },
             .user_data = this,
             .flags = {
@@ -158,6 +150,37 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
         ESP_UTILS_CHECK_NULL_GOTO(_player_handle, err, "Failed to create anim player");
     }
 
+    {
+        // The codec player is only needed if an animation is packed with the tile codec
+        bool is_codec_needed = std::any_of(
+        _animation_configs.begin(), _animation_configs.end(), [](const AnimPlayerAnimConfig & config) {
+            return AnimCodecDecoder::isEncoded(config.data_address, config.data_length);
+        });
+        if (is_codec_needed) {
+            ESP_UTILS_LOGD("Enable codec player");
+            ESP_UTILS_CHECK_EXCEPTION_GOTO(
+                _codec_player = std::make_unique<AnimCodecPlayer>(), err, "Failed to create codec player"
+            );
+            AnimCodecPlayer::Config config = {
+                .flush_callback = [this](int x1, int y1, int x2, int y2, const void *data)
+                {
+                    onPlayerFlush(x1, y1, x2, y2, data);
+                },
+                .event_callback = [this](player_event_t event)
+                {
+                    onPlayerEvent(event);
+                },
+                .swap_bytes = static_cast<bool>(data.flags.enable_data_swap_bytes),
+                .task_priority = data.task.task_priority,
+                .task_stack = data.task.task_stack,
+                .task_affinity = data.task.task_affinity,
+                .task_stack_in_ext = data.task.task_stack_in_ext,
+                .buffer_in_ext = data.task.task_stack_in_ext,
+            };
+            ESP_UTILS_CHECK_FALSE_GOTO(_codec_player->begin(config), err, "Failed to begin codec player");
+        }
+    }
+
     _event_thread_need_exit = false;
     {
         esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
@@ -222,6 +245,20 @@ bool AnimPlayer::del()
         _event_thread.join();
     }
 
+    _verify_thread_need_exit = true;
+    if (_verify_thread.joinable()) {
+        _verify_thread.join();
+    }
+    _assets_verifier.reset();
+    _assets_partition_label.clear();
+    _assets_nvs_key.clear();
+    _verify_pending_event.reset();
+    _is_verify_done = true;
+    _is_verify_urgent = false;
+
+    _codec_player.reset();
+    _is_codec_playing = false;
+
     if (_player_handle != nullptr) {
         anim_player_deinit(_player_handle);
         _player_handle = nullptr;
@@ -248,6 +285,8 @@ bool AnimPlayer::sendEvent(const Event &event, bool clear_queue)
     );
 
     std::lock_guard lock(_event_mutex);
+    // A play waiting for the verification is superseded by any newer event
+    _verify_pending_event.reset();
     if (clear_queue) {
         while (!_event_queue.empty()) {
             ESP_UTILS_LOGD("Pop event: %d", _event_queue.front().index);
@@ -279,7 +318,11 @@ bool AnimPlayer::notifyFlushFinished() const
 
     ESP_UTILS_CHECK_NULL_RETURN(_player_handle, false, "Invalid handle");
 
-    anim_player_flush_ready(_player_handle);
+    if (_is_codec_playing && (_codec_player != nullptr)) {
+        _codec_player->notifyFlushFinished();
+    } else {
+        anim_player_flush_ready(_player_handle);
+    }
 
     return true;
 }
@@ -320,7 +363,7 @@ bool AnimPlayer::processEvent(const Event &event)
         }
 
         ESP_UTILS_LOGD("Update animation[%d] to stop", _player_index);
-        anim_player_update(_player_handle, PLAYER_ACTION_STOP);
+        updatePlayer(PLAYER_ACTION_STOP);
 
         ESP_UTILS_LOGD("Wait for animation[%d] stop start", _player_index);
         while ((_player_state != OperationState::Stop) && !_event_thread_need_exit) {
@@ -344,22 +387,59 @@ bool AnimPlayer::processEvent(const Event &event)
                 false, "Invalid index: %d", _player_index
             );
 
+            // Only play verified data. The event thread doesn't scan the partition, a play received before the verify
+            // task is done is sent again by the task once it is, and the task shortens its pauses between the chunks
+            {
+                std::lock_guard event_lock(_event_mutex);
+                if (!_is_verify_done) {
+                    ESP_UTILS_LOGI(
+                        "Assets of partition(%s) not verified yet, play animation[%d] once they are",
+                        _assets_partition_label.c_str(), _player_index
+                    );
+                    if (_event_queue.empty()) {
+                        _verify_pending_event = event;
+                        _verify_pending_event->flags.force = true;
+                    }
+                    _is_verify_urgent = true;
+                    break;
+                }
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                getAssetsVerifyState() == AnimAssetVerifier::State::Verified, false,
+                "Assets of partition(%s) are corrupted, refuse to play", _assets_partition_label.c_str()
+            );
+
             auto &config = _animation_configs[_player_index];
             uint32_t start = 0;
             uint32_t end = 0;
             bool is_repeat = (event.operation == Operation::PlayLoop);
 
-            ESP_UTILS_LOGD("Animation[%d] set src data start", _player_index);
+            // Both players are stopped here, the one for the format of the animation is chosen
+            bool is_codec = AnimCodecDecoder::isEncoded(config.data_address, config.data_length);
+            ESP_UTILS_LOGD("Animation[%d] set src data start, codec(%d)", _player_index, is_codec);
             lock.unlock();
-            anim_player_set_src_data(_player_handle, config.data_address, config.data_length);
+            bool is_set = true;
+            if (is_codec) {
+                is_set = (_codec_player != nullptr) &&
+                         _codec_player->setSource(config.data_address, config.data_length);
+            } else {
+                anim_player_set_src_data(_player_handle, config.data_address, config.data_length);
+            }
             lock.lock();
+            ESP_UTILS_CHECK_FALSE_RETURN(is_set, false, "Set animation[%d] source failed", _player_index);
+            _is_codec_playing = is_codec;
             ESP_UTILS_LOGD("Animation[%d] set src data end", _player_index);
 
             _player_flags.is_started = true;
             _player_state = OperationState::Play;
-            anim_player_get_segment(_player_handle, &start, &end);
-            anim_player_set_segment(_player_handle, start, end, config.fps, is_repeat);
-            anim_player_update(_player_handle, PLAYER_ACTION_START);
+            if (is_codec) {
+                _codec_player->getSegment(start, end);
+                _codec_player->setSegment(start, end, config.fps, is_repeat);
+            } else {
+                anim_player_get_segment(_player_handle, &start, &end);
+                anim_player_set_segment(_player_handle, start, end, config.fps, is_repeat);
+            }
+            updatePlayer(PLAYER_ACTION_START);
             ESP_UTILS_LOGI(
                 "Update animation: %d, start(%d), end(%d), fps(%d), is_repeat(%d)", _player_index,
                 static_cast<int>(start), static_cast<int>(end), config.fps, is_repeat
@@ -388,4 +468,192 @@ bool AnimPlayer::processEvent(const Event &event)
     return true;
 }
 
+void AnimPlayer::onPlayerFlush(int x1, int y1, int x2, int y2, const void *data)
+{
+    // ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    // ESP_UTILS_LOGD("Param: x1(%03d), y1(%03d), x2(%03d), y2(%03d), data(%p)", x1, y1, x2, y2, data);
+
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        (x1 > 0 || y1 > 0 || x2 <= _canvas_config.width),
+        "Invalid coordinates: (%03d,%03d)-(%03d,%03d)", x1, y1, x2, y2
+    );
+
+    int x_start = x1 + _canvas_config.coord_x;
+    int y_start = y1 + _canvas_config.coord_y;
+    int width = std::min(x2 - x1, _canvas_config.width);
+    int height = std::min(y2 - y1, _canvas_config.height);
+    int x_end = std::min(x_start + width, _canvas_config.coord_x + _canvas_config.width);
+    int y_end = std::min(y_start + height, _canvas_config.coord_y + _canvas_config.height);
+
+    flush_ready_signal(x_start, y_start, x_end, y_end, data, this);
+}
+
+void AnimPlayer::onPlayerEvent(player_event_t event)
+{
+    // ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    // ESP_UTILS_LOGD("Param: event(%d)", static_cast<int>(event));
+
+    std::unique_lock<std::mutex> lock(_player_mutex);
+    if (event == PLAYER_EVENT_ALL_FRAME_DONE) {
+        if (_player_operation == Operation::PlayOnceStop) {
+            ESP_UTILS_LOGD("Animation play once stop: %d", _player_index);
+            if ((_event_queue.empty()) && !_player_flags.is_starting) {
+                sendEvent({-1, Operation::Stop, {true, true}}, false);
+            }
+        } else if (_player_operation == Operation::PlayOncePause) {
+            ESP_UTILS_LOGD("Animation play once pause: %d", _player_index);
+            _player_state = OperationState::Pause;
+        }
+        _player_flags.is_end = true;
+    } else if (event == PLAYER_EVENT_IDLE) {
+        ESP_UTILS_LOGD("Animation idle: %d", _player_index);
+        _player_state = OperationState::Stop;
+        _player_flags.is_end = true;
+        _player_index = -1;
+    }
+
+    _player_condition.notify_all();
+}
+
+void AnimPlayer::updatePlayer(player_action_t action)
+{
+    if (_is_codec_playing) {
+        _codec_player->update(action);
+    } else {
+        anim_player_update(_player_handle, action);
+    }
+}
+
+bool AnimPlayer::beginAssetsVerify(const AnimPlayerPartitionConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto partition = esp_partition_find_first(
+                         ESP_PARTITION_TYPE_ANY, ESP_PARTITION_SUBTYPE_ANY, config.partition_label
+                     );
+    ESP_UTILS_CHECK_NULL_RETURN(partition, false, "Partition(%s) not found", config.partition_label);
+
+    // The offsets of the assets are relative, since the library only gives their address in the mapped partition
+    int file_num = mmap_assets_get_stored_files(_assets_handle);
+    std::vector<AnimAssetVerifier::Asset> assets(file_num);
+    auto first_address = static_cast<const uint8_t *>(mmap_assets_get_mem(_assets_handle, 0));
+    for (int i = 0; i < file_num; i++) {
+        auto address = static_cast<const uint8_t *>(mmap_assets_get_mem(_assets_handle, i));
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (address != nullptr) && (address >= first_address), false, "Invalid asset(%d) address", i
+        );
+        assets[i] = {
+            .offset = static_cast<uint32_t>(address - first_address),
+            .size = static_cast<uint32_t>(mmap_assets_get_size(_assets_handle, i)),
+        };
+    }
+
+    auto read_function = [partition](uint32_t offset, void *buffer, uint32_t size) {
+        return esp_partition_read(partition, offset, buffer, size) == ESP_OK;
+    };
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        _assets_verifier = std::make_unique<AnimAssetVerifier>(read_function, partition->size), false,
+        "Create assets verifier failed"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _assets_verifier->checkIndex(config.checksum, assets), false, "Invalid index of partition(%s)",
+        config.partition_label
+    );
+    _assets_partition_label = config.partition_label;
+    _assets_nvs_key = get_verify_nvs_key(config.partition_label);
+
+    // Skip the scan if the same image was verified on a previous boot
+    // `nvs_flash_init()` does nothing if NVS is already initialized, and NVS errors only disable the cache
+    uint32_t verified_hash = 0;
+    nvs_handle_t nvs_handle = 0;
+    if ((nvs_flash_init() == ESP_OK) && (nvs_open(ANIM_VERIFY_NVS_NAMESPACE, NVS_READONLY, &nvs_handle) == ESP_OK)) {
+        if ((nvs_get_u32(nvs_handle, _assets_nvs_key.c_str(), &verified_hash) == ESP_OK) &&
+                (verified_hash == _assets_verifier->getImageHash())) {
+            ESP_UTILS_LOGI("Partition(%s) verified on a previous boot", config.partition_label);
+            _assets_verifier->markVerified();
+        }
+        nvs_close(nvs_handle);
+    }
+    if (_assets_verifier->getState() == AnimAssetVerifier::State::Verified) {
+        return true;
+    }
+
+    // The event thread is not running yet
+    _is_verify_done = false;
+    _is_verify_urgent = false;
+    _verify_thread_need_exit = false;
+    {
+        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+            .name = ANIM_VERIFY_THREAD_NAME,
+            .priority = ANIM_VERIFY_THREAD_PRIORITY,
+            .stack_size = ANIM_VERIFY_THREAD_STACK_SIZE,
+            .stack_in_ext = ANIM_VERIFY_THREAD_STACK_CAPS_EXT,
+        });
+        _verify_thread = boost::thread([this] {
+            ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+            while (!_verify_thread_need_exit &&
+                    (verifyAssets(ANIM_VERIFY_CHUNK_SIZE) == AnimAssetVerifier::State::Indexed))
+            {
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(
+                                                  _is_verify_urgent ? ANIM_VERIFY_URGENT_CHUNK_INTERVAL_MS :
+                                                  ANIM_VERIFY_CHUNK_INTERVAL_MS
+                                              ));
+            }
+
+            std::lock_guard lock(_event_mutex);
+            _is_verify_done = true;
+            if (_verify_pending_event.has_value()) {
+                _event_queue.push(*_verify_pending_event);
+                _verify_pending_event.reset();
+                _event_cv.notify_all();
+            }
+        });
+    }
+
+    return true;
+}
+
+AnimAssetVerifier::State AnimPlayer::getAssetsVerifyState()
+{
+    if (_assets_verifier == nullptr) {
+        return AnimAssetVerifier::State::Verified;
+    }
+
+    std::lock_guard lock(_verify_mutex);
+    return _assets_verifier->getState();
+}
+
+AnimAssetVerifier::State AnimPlayer::verifyAssets(uint32_t max_bytes)
+{
+    // Nothing to do if the partition is checked by `begin()`, or the data is not in a partition
+    if (_assets_verifier == nullptr) {
+        return AnimAssetVerifier::State::Verified;
+    }
+
+    std::lock_guard lock(_verify_mutex);
+    auto state = _assets_verifier->getState();
+    if (state != AnimAssetVerifier::State::Indexed) {
+        return state;
+    }
+
+    state = _assets_verifier->scan(max_bytes);
+    if (state == AnimAssetVerifier::State::Verified) {
+        ESP_UTILS_LOGI("Partition(%s) verified", _assets_partition_label.c_str());
+        nvs_handle_t nvs_handle = 0;
+        if (nvs_open(ANIM_VERIFY_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle) == ESP_OK) {
+            auto hash = _assets_verifier->getImageHash();
+            if ((nvs_set_u32(nvs_handle, _assets_nvs_key.c_str(), hash) != ESP_OK) ||
+                    (nvs_commit(nvs_handle) != ESP_OK)) {
+                ESP_UTILS_LOGW("Save verified marker of partition(%s) failed", _assets_partition_label.c_str());
+            }
+            nvs_close(nvs_handle);
+        }
+    }
+
+    return state;
+}
+
 } // namespace esp_brookesia::speaker
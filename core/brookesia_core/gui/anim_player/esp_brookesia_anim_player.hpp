@@ -6,6 +6,9 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 #include <queue>
 #include <condition_variable>
@@ -13,6 +16,8 @@
 #include "boost/thread.hpp"
 #include "esp_mmap_assets.h"
 #include "anim_player.h"
+#include "esp_brookesia_anim_asset_verifier.hpp"
+#include "esp_brookesia_anim_codec_player.hpp"
 
 namespace esp_brookesia::gui {
 
@@ -29,10 +34,17 @@ struct AnimPlayerAnimConfig {
     int fps;
 };
 
+enum class AnimPlayerVerifyMode : uint8_t {
+    Full = 0,   // The whole partition is checked by `begin()`
+    Deferred,   // `begin()` only checks the header and the index, the data is checked by a low priority task. A play
+                // sent before the task is done starts once it is. The result is cached in NVS per image
+};
+
 struct AnimPlayerPartitionConfig {
     const char *partition_label;
     int max_files;
     uint32_t checksum;
+    AnimPlayerVerifyMode verify_mode;
 };
 
 struct AnimPlayerData {
@@ -108,6 +120,12 @@ public:
 
 private:
     bool processEvent(const Event &event);
+    void onPlayerFlush(int x1, int y1, int x2, int y2, const void *data);
+    void onPlayerEvent(player_event_t event);
+    void updatePlayer(player_action_t action);
+    bool beginAssetsVerify(const AnimPlayerPartitionConfig &config);
+    AnimAssetVerifier::State getAssetsVerifyState();
+    AnimAssetVerifier::State verifyAssets(uint32_t max_bytes);
 
     bool _is_begun = false;
     AnimPlayerCanvasConfig _canvas_config = {};
@@ -131,6 +149,20 @@ private:
     std::condition_variable _player_condition;
     anim_player_handle_t _player_handle = nullptr;
     mmap_assets_handle_t _assets_handle = nullptr;
+    // Animations packed with the tile codec are played by this player instead of the AAF one
+    std::unique_ptr<AnimCodecPlayer> _codec_player;
+    std::atomic<bool> _is_codec_playing = false;
+
+    std::string _assets_partition_label;
+    std::string _assets_nvs_key;
+    std::unique_ptr<AnimAssetVerifier> _assets_verifier;
+    std::mutex _verify_mutex;
+    std::atomic<bool> _verify_thread_need_exit = false;
+    // Set once the verify task is done, with the play it delays, both taken with `_event_mutex`
+    bool _is_verify_done = true;
+    std::optional<Event> _verify_pending_event;
+    std::atomic<bool> _is_verify_urgent = false;
+    boost::thread _verify_thread;
 };
 
 } // namespace esp_brookesia::speaker
@@ -0,0 +1,251 @@
+#!/usr/bin/env python
+#
+# Packs AAF animations into the tile codec of the animation player
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import argparse
+import os
+import struct
+import sys
+from typing import Dict, List, Tuple
+
+MAGIC = b'BAC1'
+HEADER_FORMAT = '<4sHHHBBHHII'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+FRAME_HEADER_FORMAT = '<HBB'
+
+FRAME_KEY = 0
+FRAME_DELTA = 1
+
+TILE_SKIP = 0
+TILE_FILL = 1
+TILE_OPS = 2
+TILE_RAW = 3
+
+# Operations of the `TILE_OPS` tiles: the 2 high bits of the control byte, the 6 low bits are the length minus 1
+OP_LITERAL = 0      # Indices follow
+OP_RUN = 1          # One index follows, repeated
+OP_COPY_UP = 2      # Same pixels as the row above in the tile
+OP_KEEP = 3         # Same pixels as the previous frame, only in delta frames
+OP_LENGTH_MAX = 64
+
+AAF_HEADER = b'_S\x00V1.00\x00'
+AAF_ENCODING_RLE = 0
+AAF_ASSET_MAGIC = b'ZZ'
+
+
+class PackError(Exception):
+    pass
+
+
+def read_aaf(data: bytes) -> Tuple[int, int, List[List[int]]]:
+    """Returns the width, the height and the RGB565 pixels of every frame, in playback order"""
+    frame_num, _, _ = struct.unpack_from('<III', data, 0)
+    data_start = 12 + frame_num * 8
+    width = height = 0
+    frames = []
+    decoded: Dict[int, List[int]] = {}
+    for i in range(frame_num):
+        size, offset = struct.unpack_from('<II', data, 12 + i * 8)
+        if offset in decoded:
+            frames.append(decoded[offset])
+            continue
+        frame = data[data_start + offset:data_start + offset + size]
+        if frame[:2] != AAF_ASSET_MAGIC or frame[2:2 + len(AAF_HEADER)] != AAF_HEADER:
+            raise PackError(f'frame {i}: invalid header')
+        frame = frame[2:]
+        pos = len(AAF_HEADER)
+        bit_depth = frame[pos]
+        width, height, blocks, block_height = struct.unpack_from('<HHHH', frame, pos + 1)
+        pos += 9
+        block_lengths = struct.unpack_from(f'<{blocks}H', frame, pos)
+        pos += 2 * blocks
+        palette = []
+        for c in range(1 << bit_depth):
+            b, g, r, _ = frame[pos + c * 4:pos + c * 4 + 4]
+            palette.append(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
+        pos += (1 << bit_depth) * 4
+        pixels: List[int] = []
+        for block, length in enumerate(block_lengths):
+            block_data = frame[pos:pos + length]
+            if block_data[0] != AAF_ENCODING_RLE:
+                raise PackError(f'frame {i}: block {block} encoding {block_data[0]} is not supported')
+            for run in range(1, length - 1, 2):
+                pixels.extend([palette[block_data[run + 1]]] * block_data[run])
+            pos += length
+        if len(pixels) != width * height:
+            raise PackError(f'frame {i}: {len(pixels)} pixels decoded instead of {width * height}')
+        decoded[offset] = pixels
+        frames.append(pixels)
+
+    return width, height, frames
+
+
+def get_index_bits(color_num: int) -> int:
+    for bits in (1, 2, 4):
+        if color_num <= (1 << bits):
+            return bits
+    return 8
+
+
+def get_match_length(indices: List[int], pos: int, offset: int) -> int:
+    length = 0
+    while pos + length < len(indices) and length < OP_LENGTH_MAX and indices[pos + length] == indices[pos + length - offset]:
+        length += 1
+    return length
+
+
+def encode_ops(indices: List[int], keep: List[bool], tile_width: int) -> bytes:
+    ops = bytearray()
+    literals: List[int] = []
+
+    def flush_literals() -> None:
+        for start in range(0, len(literals), OP_LENGTH_MAX):
+            chunk = literals[start:start + OP_LENGTH_MAX]
+            ops.append((OP_LITERAL << 6) | (len(chunk) - 1))
+            ops.extend(chunk)
+        literals.clear()
+
+    pos = 0
+    while pos < len(indices):
+        keep_length = 0
+        while pos + keep_length < len(indices) and keep_length < OP_LENGTH_MAX and keep[pos + keep_length]:
+            keep_length += 1
+        up_length = get_match_length(indices, pos, tile_width) if pos >= tile_width else 0
+        run_length = 1 + get_match_length(indices, pos + 1, 1) if pos + 1 < len(indices) else 1
+        run_length = min(run_length, OP_LENGTH_MAX)
+        # A run costs one byte more than the other operations, and two literals cost as much as a run
+        candidates = [(keep_length, 1, OP_KEEP), (up_length, 1, OP_COPY_UP), (run_length - 1, 0, OP_RUN)]
+        length, _, op = max(candidates)
+        if op == OP_RUN:
+            length += 1
+        if (op == OP_RUN and length < 3) or length < 2:
+            literals.append(indices[pos])
+            pos += 1
+            continue
+        flush_literals()
+        ops.append((op << 6) | (length - 1))
+        if op == OP_RUN:
+            ops.append(indices[pos])
+        pos += length
+    flush_literals()
+
+    return bytes(ops)
+
+
+def encode_tile(indices: List[int], keep: List[bool], tile_width: int, bits: int) -> Tuple[int, bytes]:
+    if all(index == indices[0] for index in indices):
+        return TILE_FILL, bytes([indices[0]])
+
+    raw = bytearray((len(indices) * bits + 7) // 8)
+    for i, index in enumerate(indices):
+        bit = i * bits
+        raw[bit // 8] |= index << (8 - bits - bit % 8)
+
+    # Raw tiles are faster to decode, only use operations when they are smaller
+    ops = encode_ops(indices, keep, tile_width)
+    if len(ops) < len(raw):
+        return TILE_OPS, ops
+    return TILE_RAW, bytes(raw)
+
+
+def pack(width: int, height: int, frames: List[List[int]], tile_size: int, key_interval: int) -> bytes:
+    tiles_x = (width + tile_size - 1) // tile_size
+    tiles_y = (height + tile_size - 1) // tile_size
+    tiles = []
+    for ty in range(tiles_y):
+        for tx in range(tiles_x):
+            x0, y0 = tx * tile_size, ty * tile_size
+            tile_width = min(tile_size, width - x0)
+            tiles.append((tile_width, [y * width + x for y in range(y0, min(y0 + tile_size, height))
+                                       for x in range(x0, x0 + tile_width)]))
+
+    palettes: Dict[Tuple[int, ...], int] = {}
+    frame_data: List[bytes] = []
+    previous: List[int] = []
+    for i, pixels in enumerate(frames):
+        is_key = (i == 0) or (key_interval > 0 and i % key_interval == 0)
+        colors = tuple(sorted(set(pixels)))
+        if len(colors) > 256:
+            raise PackError(f'frame {i}: {len(colors)} colors')
+        palette = palettes.setdefault(colors, len(palettes))
+        color_index = {color: index for index, color in enumerate(colors)}
+        bits = get_index_bits(len(colors))
+
+        modes = bytearray((len(tiles) * 2 + 7) // 8)
+        payloads = bytearray()
+        for t, (tile_width, tile) in enumerate(tiles):
+            keep = [(not is_key) and pixels[p] == previous[p] for p in tile]
+            if all(keep):
+                mode = TILE_SKIP
+            else:
+                mode, payload = encode_tile([color_index[pixels[p]] for p in tile], keep, tile_width, bits)
+                payloads += payload
+            modes[t // 4] |= mode << (6 - 2 * (t % 4))
+        frame_data.append(struct.pack(FRAME_HEADER_FORMAT, palette, FRAME_KEY if is_key else FRAME_DELTA, bits) +
+                          bytes(modes) + bytes(payloads))
+        previous = pixels
+
+    palette_table_offset = HEADER_SIZE
+    palette_blob = bytearray()
+    palette_offsets = []
+    palette_start = palette_table_offset + 4 * len(palettes)
+    for colors in palettes:
+        palette_offsets.append(palette_start + len(palette_blob))
+        palette_blob += struct.pack(f'<H{len(colors)}H', len(colors), *colors)
+    frame_table_offset = palette_start + len(palette_blob)
+
+    # A frame with the same data as an earlier one is stored once
+    frame_blob = bytearray()
+    frame_entries = []
+    offsets: Dict[bytes, int] = {}
+    frame_start = frame_table_offset + 8 * len(frames)
+    for data in frame_data:
+        if data not in offsets:
+            offsets[data] = frame_start + len(frame_blob)
+            frame_blob += data
+        frame_entries.append((offsets[data], len(data)))
+
+    header = struct.pack(HEADER_FORMAT, MAGIC, width, height, len(frames), tile_size, 0, len(palettes), 0,
+                         palette_table_offset, frame_table_offset)
+    return (header + struct.pack(f'<{len(palettes)}I', *palette_offsets) + bytes(palette_blob) +
+            b''.join(struct.pack('<II', *entry) for entry in frame_entries) + bytes(frame_blob))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__ or 'Pack AAF animations into the tile codec')
+    parser.add_argument('inputs', nargs='+', help='AAF files')
+    parser.add_argument('-o', '--output-dir', required=True, help='Directory of the packed files, with the same names')
+    parser.add_argument('--tile-size', type=int, default=16, choices=(8, 16, 32))
+    parser.add_argument('--key-interval', type=int, default=0,
+                        help='Frames between two key frames, 0 for the first frame only')
+    args = parser.parse_args()
+
+    os.makedirs(args.output_dir, exist_ok=True)
+    total_in = total_out = 0
+    for path in args.inputs:
+        with open(path, 'rb') as f:
+            data = f.read()
+        try:
+            width, height, frames = read_aaf(data)
+            packed = pack(width, height, frames, args.tile_size, args.key_interval)
+        except (PackError, struct.error) as e:
+            print(f'{path}: {e}', file=sys.stderr)
+            return 1
+        # Keep the name, so the generated asset enums don't change
+        with open(os.path.join(args.output_dir, os.path.basename(path)), 'wb') as f:
+            f.write(packed)
+        total_in += len(data)
+        total_out += len(packed)
+        print(f'{os.path.basename(path)}: {len(data)} -> {len(packed)} bytes ({len(packed) / len(data):.1%})')
+    if total_in > 0:
+        print(f'Total: {total_in} -> {total_out} bytes ({total_out / total_in:.1%})')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
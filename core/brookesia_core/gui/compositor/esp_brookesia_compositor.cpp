@@ -0,0 +1,299 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "private/esp_brookesia_compositor_utils.hpp"
+#include "esp_brookesia_compositor.hpp"
+
+// Dirty areas kept apart before they are merged into their bounding box
+#define MAX_DIRTY_AREAS     (4)
+
+namespace esp_brookesia::gui {
+
+Compositor::~Compositor()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (isBegun() && !del()) {
+        ESP_UTILS_LOGE("Delete failed");
+    }
+}
+
+bool Compositor::begin(const Config &config, FlushCallback flush_callback)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN((config.width > 0) && (config.height > 0), false, "Invalid size");
+    ESP_UTILS_CHECK_FALSE_RETURN(flush_callback, false, "Invalid flush callback");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_begun, false, "Already begun");
+
+    size_t layer_size = static_cast<size_t>(config.width) * config.height * sizeof(uint16_t);
+    uint32_t caps = (config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    _base = static_cast<uint16_t *>(heap_caps_malloc(layer_size, caps));
+    _overlay = static_cast<uint16_t *>(heap_caps_malloc(layer_size, caps));
+    _compose = static_cast<uint16_t *>(heap_caps_malloc(layer_size, caps));
+    ESP_UTILS_CHECK_FALSE_GOTO((_base != nullptr) && (_overlay != nullptr) && (_compose != nullptr), err,
+                               "Allocate layers failed");
+    ESP_UTILS_CHECK_EXCEPTION_GOTO(
+        (_overlay_row_x1.assign(config.height, 0), _overlay_row_x2.assign(config.height, 0),
+         _dirty.reserve(MAX_DIRTY_AREAS + 1)), err, "Allocate overlay rows failed"
+    );
+
+    // Nothing is drawn yet: black base, fully transparent overlay
+    memset(_base, 0, layer_size);
+    std::fill(_overlay, _overlay + static_cast<size_t>(config.width) * config.height, config.key_color);
+    _config = config;
+    _flush_callback = std::move(flush_callback);
+    _dirty.clear();
+    _stats = {};
+    _stats.begin_time_us = esp_timer_get_time();
+    _is_begun = true;
+
+    return true;
+
+err:
+    heap_caps_free(_base);
+    heap_caps_free(_overlay);
+    heap_caps_free(_compose);
+    _base = _overlay = _compose = nullptr;
+
+    return false;
+}
+
+bool Compositor::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    heap_caps_free(_base);
+    heap_caps_free(_overlay);
+    heap_caps_free(_compose);
+    _base = _overlay = _compose = nullptr;
+    std::vector<int16_t>().swap(_overlay_row_x1);
+    std::vector<int16_t>().swap(_overlay_row_x2);
+    std::vector<Area>().swap(_dirty);
+    _flush_callback = nullptr;
+    _is_begun = false;
+
+    return true;
+}
+
+bool Compositor::updateBase(int x_start, int y_start, int x_end, int y_end, const void *data)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+
+    Area area = {x_start, y_start, x_end, y_end};
+    if (!clipArea(area)) {
+        return true;
+    }
+
+    int src_width = x_end - x_start;
+    int width = area.x2 - area.x1;
+    auto frame = static_cast<const uint16_t *>(data) + static_cast<size_t>(area.y1 - y_start) * src_width +
+                 (area.x1 - x_start);
+    auto src = frame;
+    for (int y = area.y1; y < area.y2; y++, src += src_width) {
+        memcpy(_base + static_cast<size_t>(y) * _config.width + area.x1, src, width * sizeof(uint16_t));
+    }
+    _stats.base_bytes += static_cast<uint64_t>(width) * (area.y2 - area.y1) * sizeof(uint16_t);
+
+    // Nothing to blend, the frame goes to the panel as it is
+    if ((width == src_width) && !hasOverlayIn(area)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _flush_callback(area.x1, area.y1, area.x2, area.y2, frame), false, "Flush frame failed"
+        );
+        _stats.frames++;
+        _stats.flush_bytes += static_cast<uint64_t>(width) * (area.y2 - area.y1) * sizeof(uint16_t);
+        return true;
+    }
+
+    return flushArea(area);
+}
+
+bool Compositor::updateOverlay(int x_start, int y_start, int x_end, int y_end, const void *data, bool is_last)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+
+    Area area = {x_start, y_start, x_end, y_end};
+    if (clipArea(area)) {
+        int src_width = x_end - x_start;
+        int width = area.x2 - area.x1;
+        auto src = static_cast<const uint16_t *>(data) + static_cast<size_t>(area.y1 - y_start) * src_width +
+                   (area.x1 - x_start);
+        for (int y = area.y1; y < area.y2; y++, src += src_width) {
+            memcpy(_overlay + static_cast<size_t>(y) * _config.width + area.x1, src, width * sizeof(uint16_t));
+        }
+        _stats.overlay_bytes += static_cast<uint64_t>(width) * (area.y2 - area.y1) * sizeof(uint16_t);
+        updateOverlayRows(area.y1, area.y2);
+        addDirty(area);
+    }
+
+    return is_last ? flushDirty() : true;
+}
+
+bool Compositor::fillBase(uint16_t color)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+
+    std::fill(_base, _base + static_cast<size_t>(_config.width) * _config.height, color);
+
+    return true;
+}
+
+void Compositor::discardDirty()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _dirty.clear();
+}
+
+Compositor::Stats Compositor::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void Compositor::resetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats = {};
+    _stats.begin_time_us = esp_timer_get_time();
+}
+
+bool Compositor::clipArea(Area &area) const
+{
+    area.x1 = std::max(area.x1, 0);
+    area.y1 = std::max(area.y1, 0);
+    area.x2 = std::min(area.x2, _config.width);
+    area.y2 = std::min(area.y2, _config.height);
+
+    return (area.x1 < area.x2) && (area.y1 < area.y2);
+}
+
+void Compositor::addDirty(const Area &area)
+{
+    Area merged = area;
+    // Fold every dirty area touching the new one into it, so the kept areas never overlap
+    for (auto it = _dirty.begin(); it != _dirty.end();) {
+        if ((it->x1 <= merged.x2) && (merged.x1 <= it->x2) && (it->y1 <= merged.y2) && (merged.y1 <= it->y2)) {
+            merged = {
+                std::min(it->x1, merged.x1), std::min(it->y1, merged.y1),
+                std::max(it->x2, merged.x2), std::max(it->y2, merged.y2)
+            };
+            _dirty.erase(it);
+            it = _dirty.begin();
+        } else {
+            ++it;
+        }
+    }
+    _dirty.push_back(merged);
+
+    if (_dirty.size() > MAX_DIRTY_AREAS) {
+        Area box = _dirty.front();
+        for (const auto &dirty : _dirty) {
+            box = {
+                std::min(box.x1, dirty.x1), std::min(box.y1, dirty.y1),
+                std::max(box.x2, dirty.x2), std::max(box.y2, dirty.y2)
+            };
+        }
+        _dirty.assign(1, box);
+    }
+}
+
+bool Compositor::flushDirty()
+{
+    bool ret = true;
+    for (const auto &area : _dirty) {
+        if (!flushArea(area)) {
+            ESP_UTILS_LOGE("Flush area (%d,%d)-(%d,%d) failed", area.x1, area.y1, area.x2, area.y2);
+            ret = false;
+        }
+    }
+    _dirty.clear();
+
+    return ret;
+}
+
+bool Compositor::flushArea(const Area &area)
+{
+    int64_t start_us = esp_timer_get_time();
+    bool has_overlay = false;
+    int width = area.x2 - area.x1;
+    uint16_t *dest = _compose;
+    for (int y = area.y1; y < area.y2; y++, dest += width) {
+        const uint16_t *base = _base + static_cast<size_t>(y) * _config.width;
+        const uint16_t *overlay = _overlay + static_cast<size_t>(y) * _config.width;
+        int overlay_x1 = std::max<int>(area.x1, _overlay_row_x1[y]);
+        int overlay_x2 = std::min<int>(area.x2, _overlay_row_x2[y]);
+        if (overlay_x1 >= overlay_x2) {
+            memcpy(dest, base + area.x1, width * sizeof(uint16_t));
+            continue;
+        }
+
+        has_overlay = true;
+        memcpy(dest, base + area.x1, (overlay_x1 - area.x1) * sizeof(uint16_t));
+        for (int x = overlay_x1; x < overlay_x2; x++) {
+            dest[x - area.x1] = (overlay[x] == _config.key_color) ? base[x] : overlay[x];
+        }
+        memcpy(dest + (overlay_x2 - area.x1), base + overlay_x2, (area.x2 - overlay_x2) * sizeof(uint16_t));
+    }
+    uint32_t compose_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _flush_callback(area.x1, area.y1, area.x2, area.y2, _compose), false, "Flush composed area failed"
+    );
+
+    _stats.frames++;
+    _stats.flush_bytes += static_cast<uint64_t>(width) * (area.y2 - area.y1) * sizeof(uint16_t);
+    if (has_overlay) {
+        _stats.composed_frames++;
+        _stats.last_compose_us = compose_us;
+        _stats.max_compose_us = std::max(_stats.max_compose_us, compose_us);
+    }
+
+    return true;
+}
+
+bool Compositor::hasOverlayIn(const Area &area) const
+{
+    for (int y = area.y1; y < area.y2; y++) {
+        if ((_overlay_row_x1[y] < area.x2) && (area.x1 < _overlay_row_x2[y]) &&
+                (_overlay_row_x1[y] < _overlay_row_x2[y])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Compositor::updateOverlayRows(int y1, int y2)
+{
+    for (int y = y1; y < y2; y++) {
+        const uint16_t *row = _overlay + static_cast<size_t>(y) * _config.width;
+        int x1 = 0;
+        int x2 = _config.width;
+        while ((x1 < x2) && (row[x1] == _config.key_color)) {
+            x1++;
+        }
+        while ((x2 > x1) && (row[x2 - 1] == _config.key_color)) {
+            x2--;
+        }
+        _overlay_row_x1[y] = static_cast<int16_t>(x1);
+        _overlay_row_x2[y] = static_cast<int16_t>(x2);
+    }
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Two-layer RGB565 compositor for a panel shared by an animation player and LVGL
+ *
+ * The base layer is a screen-sized copy of the animation frames, written at their screen coordinates. The overlay
+ * layer is a screen-sized copy of what LVGL flushed, where the pixels of the key color are transparent. Every update
+ * marks its area dirty, and the dirty areas are composed into one buffer and pushed to the panel once per frame: right
+ * away for an animation frame, and on the last flush of an LVGL refresh for the overlay. Where no overlay pixel is
+ * visible, animation frames go to the panel as they are, without being composed.
+ *
+ * All the pixel data, including the key color, is in the byte order expected by the panel.
+ */
+class Compositor {
+public:
+    /**
+     * @brief Push a composed area to the panel, blocking until the data is no longer needed
+     *
+     * @note  The end coordinates are exclusive, like the ones of `esp_lcd_panel_draw_bitmap()`
+     */
+    using FlushCallback = std::function<bool(int x_start, int y_start, int x_end, int y_end, const void *data)>;
+
+    struct Config {
+        int width;
+        int height;
+        uint16_t key_color;     // Overlay pixels of this color show the base layer
+        bool buffer_in_ext;     // Allocate the layers in PSRAM
+    };
+
+    struct Stats {
+        uint32_t frames;            // Areas pushed to the panel
+        uint32_t composed_frames;   // Of which had overlay pixels blended in, the others were pushed as they were
+        uint64_t base_bytes;        // Animation data received
+        uint64_t overlay_bytes;     // LVGL data received
+        uint64_t flush_bytes;       // Data pushed to the panel
+        uint32_t last_compose_us;   // Time spent blending the last composed area, without the panel transfer
+        uint32_t max_compose_us;
+        int64_t begin_time_us;      // Start of the statistics, to turn the counters into rates
+    };
+
+    Compositor() = default;
+    ~Compositor();
+
+    Compositor(const Compositor &) = delete;
+    Compositor(Compositor &&) = delete;
+    Compositor &operator=(const Compositor &) = delete;
+    Compositor &operator=(Compositor &&) = delete;
+
+    bool begin(const Config &config, FlushCallback flush_callback);
+    bool del();
+
+    /**
+     * @brief Update the base layer with an animation frame and push it to the panel
+     */
+    bool updateBase(int x_start, int y_start, int x_end, int y_end, const void *data);
+
+    /**
+     * @brief Update the overlay layer with an area flushed by LVGL
+     *
+     * @param is_last  The area is the last one of the LVGL refresh, so the dirty areas are pushed to the panel
+     */
+    bool updateOverlay(int x_start, int y_start, int x_end, int y_end, const void *data, bool is_last);
+
+    /**
+     * @brief Fill the base layer with a color, without pushing it
+     *
+     * Used when the animation starts or stops, the next update then composes on top of a clean base.
+     */
+    bool fillBase(uint16_t color);
+
+    /**
+     * @brief Drop the dirty areas that were not pushed, e.g. when LVGL stops drawing into the compositor
+     */
+    void discardDirty();
+
+    bool isBegun() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _is_begun;
+    }
+    Stats getStats();
+    void resetStats();
+
+private:
+    struct Area {
+        int x1;     // Inclusive
+        int y1;
+        int x2;     // Exclusive
+        int y2;
+    };
+
+    bool clipArea(Area &area) const;
+    void addDirty(const Area &area);
+    bool flushDirty();
+    bool flushArea(const Area &area);
+    bool hasOverlayIn(const Area &area) const;
+    void updateOverlayRows(int y1, int y2);
+
+    mutable std::mutex _mutex;
+    bool _is_begun = false;
+    Config _config = {};
+    FlushCallback _flush_callback;
+    uint16_t *_base = nullptr;
+    uint16_t *_overlay = nullptr;
+    uint16_t *_compose = nullptr;
+    // Columns spanned by the visible overlay pixels of each row, [x1, x2), empty when x1 >= x2
+    std::vector<int16_t> _overlay_row_x1;
+    std::vector<int16_t> _overlay_row_x2;
+    std::vector<Area> _dirty;
+    Stats _stats = {};
+};
+
+} // namespace esp_brookesia::gui
@@ -32,6 +32,48 @@
 #   endif
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////// Compositor ///////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR)
+#   if defined(CONFIG_ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR)
+#       define ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR  CONFIG_ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+#   else
+#       define ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR  (0)
+#   endif
+#endif
+
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+#   if !defined(ESP_BROOKESIA_COMPOSITOR_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_COMPOSITOR_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_COMPOSITOR_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_COMPOSITOR_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_COMPOSITOR_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////// Panel Filler /////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER)
+#   if defined(CONFIG_ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER)
+#       define ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER  CONFIG_ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER
+#   else
+#       define ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER  (0)
+#   endif
+#endif
+
+#if ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER
+#   if !defined(ESP_BROOKESIA_PANEL_FILLER_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_PANEL_FILLER_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_PANEL_FILLER_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_PANEL_FILLER_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_PANEL_FILLER_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////// LVGL //////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +93,13 @@
 #           define ESP_BROOKESIA_LVGL_ANIMATION_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
 #   if !defined(ESP_BROOKESIA_LVGL_CANVAS_ENABLE_DEBUG_LOG)
 #       if defined(CONFIG_ESP_BROOKESIA_LVGL_CANVAS_ENABLE_DEBUG_LOG)
 #           define ESP_BROOKESIA_LVGL_CANVAS_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_CANVAS_ENABLE_DEBUG_LOG
@@ -72,6 +121,13 @@
 #           define ESP_BROOKESIA_LVGL_DISPLAY_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_LVGL_FRAME_GOVERNOR_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_LVGL_FRAME_GOVERNOR_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_LVGL_FRAME_GOVERNOR_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_FRAME_GOVERNOR_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_LVGL_FRAME_GOVERNOR_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
 #   if !defined(ESP_BROOKESIA_LVGL_HELPER_ENABLE_DEBUG_LOG)
 #       if defined(CONFIG_ESP_BROOKESIA_LVGL_HELPER_ENABLE_DEBUG_LOG)
 #           define ESP_BROOKESIA_LVGL_HELPER_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_HELPER_ENABLE_DEBUG_LOG
@@ -100,6 +156,21 @@
 #           define ESP_BROOKESIA_LVGL_TIMER_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_LVGL_TICK_SCHEDULER_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_LVGL_TICK_SCHEDULER_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_LVGL_TICK_SCHEDULER_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_TICK_SCHEDULER_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_LVGL_TICK_SCHEDULER_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK)
+#   if defined(CONFIG_ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK)
+#       define ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK  CONFIG_ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+#   else
+#       define ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK  (0)
+#   endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
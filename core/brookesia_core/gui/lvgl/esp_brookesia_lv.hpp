@@ -7,9 +7,12 @@
 
 #include "esp_brookesia_lv_helper.hpp"
 #include "esp_brookesia_lv_animation.hpp"
+#include "esp_brookesia_lv_arena.hpp"
 #include "esp_brookesia_lv_canvas.hpp"
 #include "esp_brookesia_lv_container.hpp"
 #include "esp_brookesia_lv_display.hpp"
+#include "esp_brookesia_lv_frame_governor.hpp"
 #include "esp_brookesia_lv_object.hpp"
 #include "esp_brookesia_lv_screen.hpp"
+#include "esp_brookesia_lv_tick_scheduler.hpp"
 #include "esp_brookesia_lv_timer.hpp"
@@ -0,0 +1,515 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_lv_utils.hpp"
+#include "esp_brookesia_lv_arena.hpp"
+
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+// Every block of the chunks starts with a header, the states of the blocks
+#   define BLOCK_MAGIC_MEMORY       (0x4d454d30)
+#   define BLOCK_MAGIC_POINTER      (0x50545230)
+#   define BLOCK_MAGIC_RELEASED     (0x52454c30)
+#   define BLOCK_MAGIC_DESTROYED    (0x44535430)
+// Released and destroyed blocks are filled with it
+#   define BLOCK_POISON             (0xa5)
+#endif
+
+namespace esp_brookesia::gui {
+
+static thread_local LvArena *current_arena = nullptr;
+
+static uintptr_t align_up(uintptr_t value, size_t align)
+{
+    return (value + align - 1) & ~static_cast<uintptr_t>(align - 1);
+}
+
+static void collect_topmost_objects(
+    lv_obj_t *obj, const std::vector<lv_obj_t *> &objects, std::vector<lv_obj_t *> &topmost
+)
+{
+    if (std::binary_search(objects.begin(), objects.end(), obj)) {
+        // The children go with it
+        topmost.push_back(obj);
+        return;
+    }
+
+    uint32_t child_count = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < child_count; i++) {
+        collect_topmost_objects(lv_obj_get_child(obj, i), objects, topmost);
+    }
+}
+
+struct LvArena::State {
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+    struct BlockHeader {
+        uint32_t magic;
+        uint32_t size;
+        BlockHeader *next;
+    };
+#endif
+
+    // The state is at the start of the first chunk taken, the small blocks are carved from the head of the list
+    struct Chunk {
+        Chunk *next;
+        size_t size;
+        size_t used;
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+        BlockHeader *first_block;
+        BlockHeader *last_block;
+#endif
+
+        // Address of a block carved after the used part, or 0 if it doesn't fit
+        uintptr_t fit(size_t block_size, size_t align, size_t header_size) const
+        {
+            uintptr_t data = reinterpret_cast<uintptr_t>(this + 1);
+            uintptr_t block = align_up(data + used + header_size, align);
+            return (block + block_size <= data + size - sizeof(Chunk)) ? block : 0;
+        }
+    };
+
+    struct ObjectRecord {
+        lv_obj_t *obj;                  // `nullptr` once its pointer deleted it
+        ObjectRecord *next;
+    };
+
+    struct DestructorRecord {
+        void (*destroy)(void *);
+        void *object;
+        size_t size;
+        DestructorRecord *next;
+    };
+
+    // Carves the control blocks of the pointers, rebound by `std::shared_ptr` to the type of the control block
+    template <typename T>
+    class Allocator {
+    public:
+        using value_type = T;
+
+        explicit Allocator(State *state): state(state) {}
+        template <typename U>
+        Allocator(const Allocator<U> &other): state(other.state) {}
+
+        T *allocate(size_t n)
+        {
+            void *block = state->carvePointer(n * sizeof(T), alignof(T));
+            if (block == nullptr) {
+#if defined(__cpp_exceptions)
+                throw std::bad_alloc();
+#else
+                abort();
+#endif
+            }
+            return static_cast<T *>(block);
+        }
+
+        void deallocate(T *p, size_t n)
+        {
+            state->releasePointer(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const Allocator<U> &other) const
+        {
+            return state == other.state;
+        }
+
+        template <typename U>
+        bool operator!=(const Allocator<U> &other) const
+        {
+            return state != other.state;
+        }
+
+        State *state;
+    };
+
+    struct ObjDeleter {
+        void operator()(lv_obj_t *obj)
+        {
+            // After `close()`, the object is gone with its topmost ancestor of the arena
+            if (state->is_closed) {
+                return;
+            }
+            record->obj = nullptr;
+            state->statistics.objects--;
+            LvObjDeleter()(obj);
+        }
+
+        State *state;
+        ObjectRecord *record;
+    };
+
+    static State *create(size_t chunk_size);
+
+    void *carve(size_t size, size_t align);
+    void *carvePointer(size_t size, size_t align);
+    void releasePointer(void *block, size_t size);
+    ObjectRecord *recordObject(lv_obj_t *obj);
+    void close();
+    void deleteObjects();
+    void destroyWrappers();
+    void freeChunks();
+
+    Chunk *chunks;
+    size_t chunk_size;
+    ObjectRecord *objects;
+    DestructorRecord *destructors;     // Newest first
+    Statistics statistics;
+    bool is_closed;
+};
+
+LvArena::State *LvArena::State::create(size_t chunk_size)
+{
+    size_t chunk_bytes = std::max(chunk_size, sizeof(Chunk) + sizeof(State) + alignof(std::max_align_t));
+    auto *chunk = static_cast<Chunk *>(malloc(chunk_bytes));
+    ESP_UTILS_CHECK_NULL_RETURN(chunk, nullptr, "Allocate chunk(%d) failed", static_cast<int>(chunk_bytes));
+    *chunk = {};
+    chunk->size = chunk_bytes;
+
+    // Carve the state from its own chunk
+    uintptr_t data = reinterpret_cast<uintptr_t>(chunk + 1);
+    uintptr_t state_begin = align_up(data, alignof(State));
+    chunk->used = state_begin + sizeof(State) - data;
+    auto *state = new (reinterpret_cast<void *>(state_begin)) State{};
+    state->chunks = chunk;
+    state->chunk_size = chunk_size;
+    state->statistics.chunks = 1;
+    state->statistics.chunk_bytes = chunk_bytes;
+    state->statistics.used_bytes = sizeof(Chunk) + chunk->used;
+
+    return state;
+}
+
+void *LvArena::State::carve(size_t size, size_t align)
+{
+    size_t header_size = 0;
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+    header_size = sizeof(BlockHeader);
+    align = std::max(align, alignof(BlockHeader));
+#endif
+
+    Chunk *chunk = chunks;
+    uintptr_t block = chunk->fit(size, align, header_size);
+    if (block == 0) {
+        size_t chunk_bytes = sizeof(Chunk) + header_size + size + align;
+        bool is_dedicated = (chunk_bytes > chunk_size);
+        chunk_bytes = std::max(chunk_bytes, chunk_size);
+        chunk = static_cast<Chunk *>(malloc(chunk_bytes));
+        ESP_UTILS_CHECK_NULL_RETURN(chunk, nullptr, "Allocate chunk(%d) failed", static_cast<int>(chunk_bytes));
+        *chunk = {};
+        chunk->size = chunk_bytes;
+        // A block larger than the chunks gets a chunk of its own, the newest chunk keeps serving the small ones
+        if (is_dedicated) {
+            chunk->next = chunks->next;
+            chunks->next = chunk;
+        } else {
+            chunk->next = chunks;
+            chunks = chunk;
+        }
+        statistics.chunks++;
+        statistics.chunk_bytes += chunk_bytes;
+        statistics.used_bytes += sizeof(Chunk);
+        block = chunk->fit(size, align, header_size);
+    }
+
+    uintptr_t data = reinterpret_cast<uintptr_t>(chunk + 1);
+    size_t used = block + size - data;
+    statistics.used_bytes += used - chunk->used;
+    chunk->used = used;
+
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+    auto *header = reinterpret_cast<BlockHeader *>(block) - 1;
+    *header = {BLOCK_MAGIC_MEMORY, static_cast<uint32_t>(size), nullptr};
+    if (chunk->last_block != nullptr) {
+        chunk->last_block->next = header;
+    } else {
+        chunk->first_block = header;
+    }
+    chunk->last_block = header;
+#endif
+
+    return reinterpret_cast<void *>(block);
+}
+
+void *LvArena::State::carvePointer(size_t size, size_t align)
+{
+    void *block = carve(size, align);
+    if (block == nullptr) {
+        return nullptr;
+    }
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+    (reinterpret_cast<BlockHeader *>(block) - 1)->magic = BLOCK_MAGIC_POINTER;
+#endif
+    statistics.pointers++;
+    statistics.live_pointers++;
+
+    return block;
+}
+
+void LvArena::State::releasePointer(void *block, size_t size)
+{
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+    auto *header = reinterpret_cast<BlockHeader *>(block) - 1;
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        header->magic == BLOCK_MAGIC_POINTER, "Control block(@%p) released twice or not from the arena", block
+    );
+    header->magic = BLOCK_MAGIC_RELEASED;
+    memset(block, BLOCK_POISON, size);
+#else
+    (void)block;
+    (void)size;
+#endif
+
+    if ((--statistics.live_pointers == 0) && is_closed) {
+        freeChunks();
+    }
+}
+
+LvArena::State::ObjectRecord *LvArena::State::recordObject(lv_obj_t *obj)
+{
+    auto *record = static_cast<ObjectRecord *>(carve(sizeof(ObjectRecord), alignof(ObjectRecord)));
+    ESP_UTILS_CHECK_NULL_RETURN(record, nullptr, "Carve object record failed");
+
+    record->obj = obj;
+    record->next = objects;
+    objects = record;
+    statistics.objects++;
+
+    return record;
+}
+
+void LvArena::State::close()
+{
+    // Mark it first, so the deleters of the pointers let the objects go with their ancestors, and hold the chunks for
+    // the pointers released by the delete events and the destructors meanwhile
+    is_closed = true;
+    statistics.live_pointers++;
+    deleteObjects();
+    destroyWrappers();
+
+    if (--statistics.live_pointers == 0) {
+        freeChunks();
+    } else {
+        ESP_UTILS_LOGD("Keep the chunks for %d pointers not released yet", static_cast<int>(statistics.live_pointers));
+    }
+}
+
+void LvArena::State::deleteObjects()
+{
+    std::vector<lv_obj_t *> arena_objects;
+    arena_objects.reserve(statistics.objects);
+    for (auto record = objects; record != nullptr; record = record->next) {
+        if (record->obj != nullptr) {
+            arena_objects.push_back(record->obj);
+        }
+    }
+    statistics.objects = 0;
+    if (arena_objects.empty()) {
+        return;
+    }
+    std::sort(arena_objects.begin(), arena_objects.end());
+
+    // Walk the trees of all the displays once, instead of checking each object with `lv_obj_is_valid()`, so the
+    // records of objects already deleted by LVGL are skipped, and only the topmost ones are deleted
+    std::vector<lv_obj_t *> topmost;
+    for (auto display = lv_display_get_next(nullptr); display != nullptr; display = lv_display_get_next(display)) {
+        // The layers are screens of the display too
+        for (uint32_t i = 0; i < display->screen_cnt; i++) {
+            collect_topmost_objects(display->screens[i], arena_objects, topmost);
+        }
+    }
+    ESP_UTILS_LOGD("Delete %d topmost of %d objects", static_cast<int>(topmost.size()), (int)arena_objects.size());
+    for (auto obj : topmost) {
+        lv_obj_delete(obj);
+    }
+}
+
+void LvArena::State::destroyWrappers()
+{
+    while (destructors != nullptr) {
+        DestructorRecord *record = destructors;
+        destructors = record->next;
+        record->destroy(record->object);
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+        (reinterpret_cast<BlockHeader *>(record->object) - 1)->magic = BLOCK_MAGIC_DESTROYED;
+        memset(record->object, BLOCK_POISON, record->size);
+#endif
+        statistics.wrappers--;
+    }
+}
+
+void LvArena::State::freeChunks()
+{
+    Chunk *chunk = chunks;
+    ESP_UTILS_LOGD(
+        "Free %d chunks(%d bytes), %d bytes used", static_cast<int>(statistics.chunks),
+        static_cast<int>(statistics.chunk_bytes), static_cast<int>(statistics.used_bytes)
+    );
+
+    // The state is in one of the chunks, only the locals are used from here
+    while (chunk != nullptr) {
+        Chunk *next = chunk->next;
+#if ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK
+        for (auto header = chunk->first_block; header != nullptr; header = header->next) {
+            if ((header->magic != BLOCK_MAGIC_RELEASED) && (header->magic != BLOCK_MAGIC_DESTROYED)) {
+                continue;
+            }
+            auto *block = reinterpret_cast<const uint8_t *>(header + 1);
+            if (std::count(block, block + header->size, BLOCK_POISON) != header->size) {
+                ESP_UTILS_LOGE(
+                    "Block(@%p, %d bytes) written after it was %s", block, static_cast<int>(header->size),
+                    (header->magic == BLOCK_MAGIC_RELEASED) ? "released" : "destroyed"
+                );
+            }
+        }
+#endif
+        free(chunk);
+        chunk = next;
+    }
+}
+
+LvArena::LvArena(size_t chunk_size):
+    _chunk_size(chunk_size)
+{
+}
+
+LvArena::~LvArena()
+{
+    close();
+}
+
+void *LvArena::allocate(size_t size, size_t align)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (align > 0) && ((align & (align - 1)) == 0), nullptr, "Invalid align(%d)", static_cast<int>(align)
+    );
+
+    State *state = open();
+    ESP_UTILS_CHECK_NULL_RETURN(state, nullptr, "Open failed");
+
+    return state->carve(size, align);
+}
+
+bool LvArena::addObject(lv_obj_t *obj)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(obj, false, "Invalid object");
+
+    State *state = open();
+    ESP_UTILS_CHECK_NULL_RETURN(state, false, "Open failed");
+
+    return state->recordObject(obj) != nullptr;
+}
+
+LvObjSharedPtr LvArena::makeObjPtr(lv_obj_t *obj)
+{
+    if (obj == nullptr) {
+        return nullptr;
+    }
+
+    State *state = open();
+    State::ObjectRecord *record = (state != nullptr) ? state->recordObject(obj) : nullptr;
+    if (record == nullptr) {
+        return LvObjSharedPtr(obj, LvObjDeleter());
+    }
+
+    return LvObjSharedPtr(obj, State::ObjDeleter{state, record}, State::Allocator<lv_obj_t>(state));
+}
+
+LvTimerSharedPtr LvArena::makeTimerPtr(lv_timer_t *timer)
+{
+    if (timer == nullptr) {
+        return nullptr;
+    }
+
+    State *state = open();
+    if (state == nullptr) {
+        return LvTimerSharedPtr(timer, LvTimerDeleter());
+    }
+
+    return LvTimerSharedPtr(timer, LvTimerDeleter(), State::Allocator<lv_timer_t>(state));
+}
+
+LvAnimSharedPtr LvArena::makeAnimPtr(lv_anim_t *anim)
+{
+    if (anim == nullptr) {
+        return nullptr;
+    }
+
+    State *state = open();
+    if (state == nullptr) {
+        return LvAnimSharedPtr(anim, LvAnimDeleter());
+    }
+
+    return LvAnimSharedPtr(anim, LvAnimDeleter(), State::Allocator<lv_anim_t>(state));
+}
+
+void LvArena::close()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_state == nullptr) {
+        return;
+    }
+
+    State *state = _state;
+    _state = nullptr;
+    state->close();
+}
+
+LvArena::Statistics LvArena::getStatistics() const
+{
+    return (_state != nullptr) ? _state->statistics : Statistics{};
+}
+
+LvArena *LvArena::getCurrent()
+{
+    return current_arena;
+}
+
+bool LvArena::addDestructor(void *object, size_t size, void (*destroy)(void *))
+{
+    State *state = open();
+    ESP_UTILS_CHECK_NULL_RETURN(state, false, "Open failed");
+
+    auto *record = static_cast<State::DestructorRecord *>(
+                       state->carve(sizeof(State::DestructorRecord), alignof(State::DestructorRecord))
+                   );
+    ESP_UTILS_CHECK_NULL_RETURN(record, false, "Carve destructor record failed");
+
+    *record = {destroy, object, size, state->destructors};
+    state->destructors = record;
+    state->statistics.wrappers++;
+
+    return true;
+}
+
+LvArena::State *LvArena::open()
+{
+    if (_state == nullptr) {
+        _state = State::create(_chunk_size);
+    }
+
+    return _state;
+}
+
+LvArenaScope::LvArenaScope(LvArena &arena):
+    _previous(current_arena)
+{
+    current_arena = &arena;
+}
+
+LvArenaScope::~LvArenaScope()
+{
+    current_arena = _previous;
+}
+
+} // namespace esp_brookesia::gui
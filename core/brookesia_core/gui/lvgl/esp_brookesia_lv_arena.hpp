@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "lvgl.h"
+#include "esp_brookesia_lv_helper.hpp"
+#include "esp_brookesia_lv_object.hpp"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Memory of the widget tree of a screen or an app, given back in one shot when it closes
+ *
+ * While a `LvArenaScope` of the arena is active on the task, the pointers made by `ESP_BROOKESIA_MAKE_LV_OBJ_PTR()`,
+ * `ESP_BROOKESIA_MAKE_LV_TIMER_PTR()` and `ESP_BROOKESIA_MAKE_LV_ANIM_PTR()` have their control block carved from the
+ * arena instead of the heap, and the LVGL objects they point to belong to the arena. The wrappers made by `create()`
+ * live in the arena too.
+ *
+ * `close()` deletes the topmost objects of the arena with one `lv_obj_delete()` each, so the deleters of the pointers
+ * released afterwards have nothing left to look for, then destroys the wrappers. The chunks go back to the heap once
+ * the last pointer of the arena is released, so the pointers may be released in any order, even after the arena is
+ * destroyed. A pointer released before `close()` deletes its object as usual. Like with `LvObjDeleter`, the objects are
+ * known by their address, so an object of the arena deleted behind its pointer must not be followed by another object
+ * at the same address before `close()`.
+ *
+ * With `CONFIG_ESP_BROOKESIA_LVGL_ARENA_ENABLE_DEBUG_CHECK`, the released control blocks and the destroyed wrappers are
+ * filled with a pattern which is checked when the chunks go back to the heap, to catch the writes through dangling
+ * pointers, and the control blocks released twice are reported.
+ *
+ * All the functions must be called from the LVGL task or with the LVGL lock held, like `lv_obj_*()`.
+ */
+class LvArena {
+public:
+    struct Statistics {
+        uint32_t chunks;                /*!< Chunks taken from the heap */
+        uint32_t chunk_bytes;
+        uint32_t used_bytes;            /*!< Bytes carved from the chunks, including the alignment */
+        uint32_t pointers;              /*!< Control blocks carved since the arena was opened */
+        uint32_t live_pointers;         /*!< Pointers not released yet */
+        uint32_t objects;               /*!< LVGL objects of the arena not released yet */
+        uint32_t wrappers;              /*!< Objects made by `create()` */
+    };
+
+    static constexpr size_t CHUNK_SIZE_DEFAULT = 4096;
+
+    /**
+     * @brief The arena opens on its first allocation, and opens again after `close()` if it is used again
+     *
+     * @param chunk_size Size of the chunks taken from the heap, a larger allocation gets a chunk of its own
+     */
+    explicit LvArena(size_t chunk_size = CHUNK_SIZE_DEFAULT);
+    ~LvArena();
+
+    LvArena(const LvArena &) = delete;
+    LvArena &operator=(const LvArena &) = delete;
+
+    /**
+     * @brief Make an object in the arena, destroyed by `close()` in the reverse order of creation
+     *
+     * The LVGL object of a wrapper (`LvObject` and the classes derived from it) belongs to the arena too.
+     *
+     * @return The object, or `nullptr` if there is no memory
+     */
+    template <typename T, typename... Args>
+    T *create(Args &&... args)
+    {
+        void *memory = allocate(sizeof(T), alignof(T));
+        if (memory == nullptr) {
+            return nullptr;
+        }
+        T *object = new (memory) T(std::forward<Args>(args)...);
+        if (!addDestructor(object, sizeof(T), destroy<T>)) {
+            object->~T();
+            return nullptr;
+        }
+        if constexpr (std::is_base_of_v<LvObject, T>) {
+            addObject(object->getNativeHandle());
+        }
+
+        return object;
+    }
+
+    /**
+     * @brief Carve raw memory from the arena, valid until `close()`
+     *
+     * @return The memory, or `nullptr` if there is no memory
+     */
+    void *allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    /**
+     * @brief Make an LVGL object belong to the arena without a pointer, it is deleted by `close()`
+     */
+    bool addObject(lv_obj_t *obj);
+
+    LvObjSharedPtr makeObjPtr(lv_obj_t *obj);
+    LvTimerSharedPtr makeTimerPtr(lv_timer_t *timer);
+    LvAnimSharedPtr makeAnimPtr(lv_anim_t *anim);
+
+    /**
+     * @brief Delete the LVGL objects and destroy the wrappers of the arena
+     */
+    void close();
+
+    Statistics getStatistics() const;
+
+    /**
+     * @brief The arena of the innermost `LvArenaScope` active on the task, or `nullptr`
+     */
+    static LvArena *getCurrent();
+
+private:
+    friend class LvArenaScope;
+
+    struct State;
+
+    template <typename T>
+    static void destroy(void *object)
+    {
+        static_cast<T *>(object)->~T();
+    }
+    bool addDestructor(void *object, size_t size, void (*destroy)(void *));
+    State *open();
+
+    size_t _chunk_size = 0;
+    State *_state = nullptr;
+};
+
+/**
+ * @brief Make the pointers of the task come from an arena within a scope, scopes can be nested
+ */
+class LvArenaScope {
+public:
+    explicit LvArenaScope(LvArena &arena);
+    ~LvArenaScope();
+
+    LvArenaScope(const LvArenaScope &) = delete;
+    LvArenaScope &operator=(const LvArenaScope &) = delete;
+
+private:
+    LvArena *_previous = nullptr;
+};
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_LVGL_FRAME_GOVERNOR_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_lv_utils.hpp"
+#include "esp_brookesia_lv_frame_governor.hpp"
+
+// Vsync periods out of this range are glitches of the source, not a panel
+#define VSYNC_PERIOD_MIN_MS     (4)
+#define VSYNC_PERIOD_MAX_MS     (100)
+// The vsync is not followed anymore if it stops for this number of periods
+#define VSYNC_TIMEOUT_PERIODS   (4)
+
+namespace esp_brookesia::gui {
+
+static bool is_tick_before(uint32_t tick, uint32_t other)
+{
+    return static_cast<int32_t>(tick - other) < 0;
+}
+
+LvFrameGovernor &LvFrameGovernor::getInstance()
+{
+    static LvFrameGovernor instance;
+    return instance;
+}
+
+bool LvFrameGovernor::begin(lv_display_t *display, const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: display(%p), default_fps(%d)", display, config.default_fps);
+    ESP_UTILS_CHECK_FALSE_RETURN(!isBegun(), false, "Already begun");
+    ESP_UTILS_CHECK_NULL_RETURN(display, false, "Invalid display");
+    ESP_UTILS_CHECK_NULL_RETURN(lv_display_get_refr_timer(display), false, "Display has no refresh timer");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (config.default_fps > 0) && (config.default_fps <= 1000), false, "Invalid default fps(%d)", config.default_fps
+    );
+    for (auto fps : config.scene_fps) {
+        ESP_UTILS_CHECK_FALSE_RETURN((fps > 0) && (fps <= 1000), false, "Invalid scene fps(%d)", fps);
+    }
+
+    _display = display;
+    _config = config;
+    _is_refreshing = false;
+    _is_frame_pending = false;
+    _has_frame = false;
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_INVALIDATE_AREA, this);
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_REFR_REQUEST, this);
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_RENDER_START, this);
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_REFR_READY, this);
+    applyFrameRateCap();
+    resetStatistics();
+
+    return true;
+}
+
+bool LvFrameGovernor::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (!isBegun()) {
+        return true;
+    }
+
+    lv_display_remove_event_cb_with_user_data(_display, onDisplayEvent, this);
+    lv_timer_set_period(lv_display_get_refr_timer(_display), LV_DEF_REFR_PERIOD);
+    lv_timer_set_period(lv_anim_get_timer(), LV_DEF_REFR_PERIOD);
+    _display = nullptr;
+
+    return true;
+}
+
+bool LvFrameGovernor::enterScene(Scene scene)
+{
+    ESP_UTILS_LOGD("Param: scene(%d)", static_cast<int>(scene));
+    ESP_UTILS_CHECK_FALSE_RETURN(scene < Scene::Max, false, "Invalid scene(%d)", static_cast<int>(scene));
+
+    if (_scene_counts[static_cast<int>(scene)]++ == 0) {
+        applyFrameRateCap();
+    }
+
+    return true;
+}
+
+bool LvFrameGovernor::exitScene(Scene scene)
+{
+    ESP_UTILS_LOGD("Param: scene(%d)", static_cast<int>(scene));
+    ESP_UTILS_CHECK_FALSE_RETURN(scene < Scene::Max, false, "Invalid scene(%d)", static_cast<int>(scene));
+
+    auto &count = _scene_counts[static_cast<int>(scene)];
+    ESP_UTILS_CHECK_FALSE_RETURN(count > 0, false, "Scene(%d) not entered", static_cast<int>(scene));
+    if (--count == 0) {
+        applyFrameRateCap();
+    }
+
+    return true;
+}
+
+void LvFrameGovernor::notifyVsync()
+{
+    uint32_t now = lv_tick_get();
+    uint32_t period = now - _vsync_tick.exchange(now);
+    _vsync_period_ms = ((period >= VSYNC_PERIOD_MIN_MS) && (period <= VSYNC_PERIOD_MAX_MS)) ? period : 0;
+}
+
+int LvFrameGovernor::getFrameRateCap() const
+{
+    int fps = 0;
+    for (int i = 0; i < static_cast<int>(Scene::Max); i++) {
+        if (_scene_counts[i] > 0) {
+            fps = std::max(fps, _config.scene_fps[i]);
+        }
+    }
+
+    return (fps > 0) ? fps : _config.default_fps;
+}
+
+LvFrameGovernor::Statistics LvFrameGovernor::getStatistics() const
+{
+    auto statistics = _statistics;
+    statistics.elapsed_ms = lv_tick_elaps(_statistics_start_tick);
+    statistics.idle_percent = lv_timer_get_idle();
+
+    return statistics;
+}
+
+void LvFrameGovernor::resetStatistics()
+{
+    _statistics = {};
+    _statistics_start_tick = lv_tick_get();
+}
+
+void LvFrameGovernor::applyFrameRateCap()
+{
+    if (!isBegun()) {
+        return;
+    }
+
+    // The animations don't need to step faster than the display refreshes
+    uint32_t period = getFramePeriod();
+    ESP_UTILS_LOGD("Apply frame rate cap(%d)", getFrameRateCap());
+    lv_timer_set_period(lv_anim_get_timer(), period);
+    if (_is_frame_pending && !_is_refreshing) {
+        scheduleRefresh();
+    } else {
+        lv_timer_set_period(lv_display_get_refr_timer(_display), period);
+    }
+}
+
+void LvFrameGovernor::scheduleRefresh()
+{
+    // No sooner than one period after the last frame, and on the next vsync if the panel reports it
+    uint32_t now = lv_tick_get();
+    uint32_t due = now;
+    if (_has_frame && is_tick_before(now, _last_frame_tick + getFramePeriod())) {
+        due = _last_frame_tick + getFramePeriod();
+    }
+    due = getVsyncAlignedTick(due);
+    _deadline_tick = getVsyncAlignedTick(_pending_tick + getFramePeriod());
+
+    auto timer = lv_display_get_refr_timer(_display);
+    lv_timer_reset(timer);
+    lv_timer_set_period(timer, due - now);
+    lv_timer_resume(timer);
+}
+
+bool LvFrameGovernor::isVsyncActive(uint32_t now) const
+{
+    uint32_t period = _vsync_period_ms;
+    return (period > 0) && (lv_tick_elaps(_vsync_tick) < period * VSYNC_TIMEOUT_PERIODS) &&
+           !is_tick_before(now, _vsync_tick);
+}
+
+uint32_t LvFrameGovernor::getVsyncAlignedTick(uint32_t tick) const
+{
+    if (!isVsyncActive(lv_tick_get())) {
+        return tick;
+    }
+
+    uint32_t vsync_tick = _vsync_tick;
+    uint32_t period = _vsync_period_ms;
+    if (is_tick_before(tick, vsync_tick)) {
+        return vsync_tick;
+    }
+    // The next vsync predicted from the last one
+    uint32_t periods = (tick - vsync_tick + period - 1) / period;
+
+    return vsync_tick + periods * period;
+}
+
+void LvFrameGovernor::onDisplayEvent(lv_event_t *event)
+{
+    auto governor = static_cast<LvFrameGovernor *>(lv_event_get_user_data(event));
+    ESP_UTILS_CHECK_NULL_EXIT(governor, "Invalid governor");
+
+    switch (lv_event_get_code(event)) {
+    case LV_EVENT_INVALIDATE_AREA:
+    case LV_EVENT_REFR_REQUEST:
+        // The areas invalidated while refreshing are drawn by the same refresh
+        if (governor->_is_refreshing || governor->_is_frame_pending) {
+            break;
+        }
+        governor->_is_frame_pending = true;
+        governor->_pending_tick = lv_tick_get();
+        governor->scheduleRefresh();
+        break;
+    case LV_EVENT_REFR_START:
+        governor->_is_refreshing = true;
+        break;
+    case LV_EVENT_RENDER_START: {
+        uint32_t now = lv_tick_get();
+        governor->_statistics.frames++;
+        if (governor->_is_frame_pending &&
+                is_tick_before(governor->_deadline_tick + governor->getFramePeriod() / 2, now)) {
+            governor->_statistics.missed_deadlines++;
+            ESP_UTILS_LOGD("Frame missed its deadline by %dms", static_cast<int>(now - governor->_deadline_tick));
+        }
+        governor->_has_frame = true;
+        governor->_last_frame_tick = now;
+        break;
+    }
+    case LV_EVENT_REFR_READY:
+        governor->_is_refreshing = false;
+        governor->_is_frame_pending = false;
+        lv_timer_set_period(lv_display_get_refr_timer(governor->_display), governor->getFramePeriod());
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace esp_brookesia::gui
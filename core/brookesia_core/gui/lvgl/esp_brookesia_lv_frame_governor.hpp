@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include "lvgl.h"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Pacing of the refreshes of a LVGL display
+ *
+ * The refresh timer of the display only runs when something was invalidated, no sooner than one frame period after
+ * the last frame, so a static screen doesn't wake the LVGL task and an animated one is capped. The cap is the highest
+ * frame rate of the scenes entered (e.g. 60 fps while a gesture is in progress, 10 fps for a clock face), or the
+ * default one if there is none. When the panel reports its vsync (or TE) with `notifyVsync()`, the refreshes start on
+ * the predicted vsync, so the flushes don't tear.
+ *
+ * All the functions except `notifyVsync()` must be called from the LVGL task or with the LVGL lock held.
+ */
+class LvFrameGovernor {
+public:
+    enum class Scene : uint8_t {
+        Gesture = 0,
+        Clock,
+        Max,
+    };
+
+    struct Config {
+        int default_fps = 1000 / LV_DEF_REFR_PERIOD;
+        std::array<int, static_cast<int>(Scene::Max)> scene_fps = {
+            60,     // Gesture
+            10,     // Clock
+        };
+    };
+
+    struct Statistics {
+        uint32_t elapsed_ms;
+        uint32_t frames;                    /*!< Refreshes which rendered something */
+        uint32_t missed_deadlines;          /*!< Frames started more than half a period after their deadline */
+        int idle_percent;                   /*!< Time out of `lv_timer_handler()`, over the last 500 ms */
+
+        float getFrameRate() const
+        {
+            return (elapsed_ms == 0) ? 0 : frames * 1000.0f / elapsed_ms;
+        }
+    };
+
+    LvFrameGovernor(const LvFrameGovernor &) = delete;
+    LvFrameGovernor &operator=(const LvFrameGovernor &) = delete;
+
+    bool begin(lv_display_t *display, const Config &config);
+    bool del();
+
+    /**
+     * @brief Enter or exit a scene, the scenes may be entered several times and are active until exited as many times.
+     *        The scenes are counted even if the governor is not begun yet
+     */
+    bool enterScene(Scene scene);
+    bool exitScene(Scene scene);
+
+    /**
+     * @brief Tell the governor that the panel started a new frame. Can be called from an ISR
+     */
+    void notifyVsync();
+
+    bool isBegun() const
+    {
+        return (_display != nullptr);
+    }
+    int getFrameRateCap() const;
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+    static LvFrameGovernor &getInstance();
+
+private:
+    LvFrameGovernor() = default;
+    ~LvFrameGovernor() = default;
+
+    void applyFrameRateCap();
+    void scheduleRefresh();
+    bool isVsyncActive(uint32_t now) const;
+    uint32_t getVsyncAlignedTick(uint32_t tick) const;
+    uint32_t getFramePeriod() const
+    {
+        return 1000 / getFrameRateCap();
+    }
+
+    static void onDisplayEvent(lv_event_t *event);
+
+    lv_display_t *_display = nullptr;
+    Config _config = {};
+    std::array<int, static_cast<int>(Scene::Max)> _scene_counts = {};
+    bool _is_refreshing = false;
+    bool _is_frame_pending = false;
+    uint32_t _pending_tick = 0;
+    uint32_t _deadline_tick = 0;
+    bool _has_frame = false;
+    uint32_t _last_frame_tick = 0;
+    std::atomic<uint32_t> _vsync_tick = 0;
+    std::atomic<uint32_t> _vsync_period_ms = 0;
+    uint32_t _statistics_start_tick = 0;
+    Statistics _statistics = {};
+};
+
+} // namespace esp_brookesia::gui
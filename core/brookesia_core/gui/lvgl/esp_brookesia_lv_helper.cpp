@@ -13,6 +13,7 @@
 #include "private/esp_brookesia_lv_utils.hpp"
 #include "style/esp_brookesia_gui_style.hpp"
 #include "esp_brookesia_lv_helper.hpp"
+#include "esp_brookesia_lv_arena.hpp"
 
 #define FONT_SWITH_CASE(size)           \
     case (size):                        \
@@ -321,4 +322,39 @@ lv_anim_path_cb_t getLvAnimPathCb(StyleAnimation::AnimationPathType type)
     return nullptr;
 }
 
+LvObjSharedPtr makeLvObjPtr(lv_obj_t *obj)
+{
+    LvArena *arena = LvArena::getCurrent();
+    if (arena != nullptr) {
+        return arena->makeObjPtr(obj);
+    }
+
+    return LvObjSharedPtr(obj, LvObjDeleter());
+}
+
+LvTimerSharedPtr makeLvTimerPtr(lv_timer_t *timer)
+{
+    LvArena *arena = LvArena::getCurrent();
+    if (arena != nullptr) {
+        return arena->makeTimerPtr(timer);
+    }
+
+    return LvTimerSharedPtr(timer, LvTimerDeleter());
+}
+
+LvAnimSharedPtr makeLvAnimPtr()
+{
+    lv_anim_t *anim = new lv_anim_t;
+    if (anim != nullptr) {
+        lv_anim_init(anim);
+    }
+
+    LvArena *arena = LvArena::getCurrent();
+    if (arena != nullptr) {
+        return arena->makeAnimPtr(anim);
+    }
+
+    return LvAnimSharedPtr(anim, LvAnimDeleter());
+}
+
 } // namespace esp_brookesia::gui
@@ -70,23 +70,22 @@ bool getLvInternalFontBySize(uint8_t size_px, const lv_font_t **font);
 lv_color_t getLvRandomColor(void);
 lv_indev_t *getLvInputDev(const lv_display_t *display, lv_indev_type_t type);
 lv_anim_path_cb_t getLvAnimPathCb(esp_brookesia::gui::StyleAnimation::AnimationPathType type);
+
+/**
+ * @brief Make the smart pointers, in the arena of the innermost `LvArenaScope` of the task if there is one, on the
+ *        heap otherwise
+ */
+LvObjSharedPtr makeLvObjPtr(lv_obj_t *obj);
+LvTimerSharedPtr makeLvTimerPtr(lv_timer_t *timer);
+LvAnimSharedPtr makeLvAnimPtr();
 } // namespace esp_brookesia::gui
 
 #define ESP_BROOKESIA_MAKE_LV_OBJ_PTR(type, parent) \
-    esp_brookesia::gui::LvObjSharedPtr(lv_##type##_create(parent), esp_brookesia::gui::LvObjDeleter());
+    esp_brookesia::gui::makeLvObjPtr(lv_##type##_create(parent));
 #define ESP_BROOKESIA_MAKE_LV_TIMER_PTR(func, t, data) \
-    esp_brookesia::gui::LvTimerSharedPtr(lv_timer_create(func, t, data), esp_brookesia::gui::LvTimerDeleter());
+    esp_brookesia::gui::makeLvTimerPtr(lv_timer_create(func, t, data));
 #define ESP_BROOKESIA_MAKE_LV_ANIM_PTR() \
-    esp_brookesia::gui::LvAnimSharedPtr( \
-        [](){ \
-            lv_anim_t *anim = new lv_anim_t; \
-            if (anim != nullptr) { \
-                lv_anim_init(anim); \
-            } \
-            return anim; \
-        }(), \
-        esp_brookesia::gui::LvAnimDeleter() \
-    )
+    esp_brookesia::gui::makeLvAnimPtr()
 
 /**
  * @brief Backward compatibility for macro definitions
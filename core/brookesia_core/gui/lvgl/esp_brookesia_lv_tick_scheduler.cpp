@@ -0,0 +1,299 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_LVGL_TICK_SCHEDULER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_lv_utils.hpp"
+#include "esp_brookesia_lv_tick_scheduler.hpp"
+
+namespace esp_brookesia::gui {
+
+// Next multiple of the period after the tick, so the subscribers with the same period are always due together
+static uint32_t get_next_due_tick(uint32_t tick, uint32_t period_ms)
+{
+    return tick - (tick % period_ms) + period_ms;
+}
+
+static bool is_tick_reached(uint32_t tick, uint32_t now)
+{
+    return static_cast<int32_t>(now - tick) >= 0;
+}
+
+LvTickScheduler &LvTickScheduler::getInstance()
+{
+    static LvTickScheduler instance;
+    return instance;
+}
+
+LvTickScheduler::ID LvTickScheduler::subscribe(Callback callback, const SubscriberConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: period(%d), slack(%d), visible_object(%p), paused(%d)", static_cast<int>(config.period_ms),
+        static_cast<int>(config.slack_ms), config.visible_object, config.is_paused
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(callback, INVALID_ID, "Invalid callback");
+    ESP_UTILS_CHECK_FALSE_RETURN(config.period_ms > 0, INVALID_ID, "Invalid period");
+
+    if (_timer == nullptr) {
+        _timer = lv_timer_create([](lv_timer_t *t) {
+            auto scheduler = static_cast<LvTickScheduler *>(lv_timer_get_user_data(t));
+            ESP_UTILS_CHECK_NULL_EXIT(scheduler, "Invalid scheduler");
+            scheduler->run();
+        }, std::numeric_limits<int32_t>::max(), this);
+        ESP_UTILS_CHECK_NULL_RETURN(_timer, INVALID_ID, "Create timer failed");
+        lv_timer_pause(_timer);
+        if (_next_id == 0) {
+            resetStatistics();
+        }
+    }
+
+    ID id = _next_id++;
+    _subscribers[id] = Subscriber{
+        .callback = std::move(callback),
+        .config = config,
+        .due_tick = get_next_due_tick(lv_tick_get(), config.period_ms),
+    };
+    schedule();
+
+    return id;
+}
+
+bool LvTickScheduler::unsubscribe(ID id)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: id(%d)", id);
+    ESP_UTILS_CHECK_FALSE_RETURN(_subscribers.erase(id) > 0, false, "Invalid ID(%d)", id);
+
+    // Called from a callback, the timer is updated once all the callbacks are done
+    if (_is_running) {
+        return true;
+    }
+    if (_subscribers.empty()) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    } else {
+        schedule();
+    }
+
+    return true;
+}
+
+bool LvTickScheduler::setPaused(ID id, bool paused)
+{
+    ESP_UTILS_LOGD("Param: id(%d), paused(%d)", id, paused);
+
+    auto it = _subscribers.find(id);
+    ESP_UTILS_CHECK_FALSE_RETURN(it != _subscribers.end(), false, "Invalid ID(%d)", id);
+
+    auto &subscriber = it->second;
+    if (subscriber.config.is_paused == paused) {
+        return true;
+    }
+    subscriber.config.is_paused = paused;
+    if (!paused) {
+        subscriber.due_tick = get_next_due_tick(lv_tick_get(), subscriber.config.period_ms);
+    }
+    schedule();
+
+    return true;
+}
+
+bool LvTickScheduler::setPeriod(ID id, uint32_t period_ms)
+{
+    ESP_UTILS_LOGD("Param: id(%d), period(%d)", id, static_cast<int>(period_ms));
+    ESP_UTILS_CHECK_FALSE_RETURN(period_ms > 0, false, "Invalid period");
+
+    auto it = _subscribers.find(id);
+    ESP_UTILS_CHECK_FALSE_RETURN(it != _subscribers.end(), false, "Invalid ID(%d)", id);
+
+    auto &subscriber = it->second;
+    subscriber.config.period_ms = period_ms;
+    subscriber.due_tick = get_next_due_tick(lv_tick_get(), period_ms);
+    schedule();
+
+    return true;
+}
+
+bool LvTickScheduler::trigger(ID id)
+{
+    ESP_UTILS_LOGD("Param: id(%d)", id);
+
+    auto it = _subscribers.find(id);
+    ESP_UTILS_CHECK_FALSE_RETURN(it != _subscribers.end(), false, "Invalid ID(%d)", id);
+
+    auto &subscriber = it->second;
+    subscriber.config.is_paused = false;
+    subscriber.due_tick = lv_tick_get();
+    schedule();
+
+    return true;
+}
+
+LvTickScheduler::Statistics LvTickScheduler::getStatistics() const
+{
+    auto statistics = _statistics;
+    statistics.elapsed_ms = lv_tick_elaps(_statistics_start_tick);
+
+    return statistics;
+}
+
+void LvTickScheduler::resetStatistics()
+{
+    _statistics = {};
+    _statistics_start_tick = lv_tick_get();
+}
+
+void LvTickScheduler::run()
+{
+    _statistics.wakeups++;
+    _is_running = true;
+
+    // The callbacks may change the subscribers, only the ones due before the first callback are run
+    uint32_t now = lv_tick_get();
+    std::vector<ID> due_ids;
+    for (auto &[id, subscriber] : _subscribers) {
+        if (!subscriber.config.is_paused && is_tick_reached(subscriber.due_tick, now)) {
+            due_ids.push_back(id);
+        }
+    }
+    for (auto id : due_ids) {
+        auto it = _subscribers.find(id);
+        if ((it == _subscribers.end()) || it->second.config.is_paused) {
+            continue;
+        }
+        auto &subscriber = it->second;
+        subscriber.due_tick = get_next_due_tick(now, subscriber.config.period_ms);
+        if (isObjectHidden(subscriber.config.visible_object)) {
+            _statistics.skipped_callbacks++;
+            continue;
+        }
+        _statistics.callbacks++;
+        // Keep the callback alive, the subscriber may unsubscribe in it
+        auto callback = subscriber.callback;
+        callback();
+    }
+
+    _is_running = false;
+    if (_subscribers.empty()) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    } else {
+        schedule();
+    }
+}
+
+void LvTickScheduler::schedule()
+{
+    if ((_timer == nullptr) || _is_running) {
+        return;
+    }
+
+    // Wake up when the first callback can't be delayed anymore, the others already due run at the same time
+    uint32_t now = lv_tick_get();
+    int32_t wait_ms = std::numeric_limits<int32_t>::max();
+    bool has_active = false;
+    for (auto &[id, subscriber] : _subscribers) {
+        if (subscriber.config.is_paused) {
+            continue;
+        }
+        has_active = true;
+        wait_ms = std::min(wait_ms, static_cast<int32_t>(subscriber.due_tick + subscriber.config.slack_ms - now));
+    }
+    if (!has_active) {
+        lv_timer_pause(_timer);
+        return;
+    }
+
+    wait_ms = std::max(wait_ms, static_cast<int32_t>(0));
+    lv_timer_set_period(_timer, wait_ms);
+    lv_timer_reset(_timer);
+    lv_timer_resume(_timer);
+    if (wait_ms == 0) {
+        lv_timer_ready(_timer);
+    }
+}
+
+bool LvTickScheduler::isObjectHidden(const lv_obj_t *object)
+{
+    if (object == nullptr) {
+        return false;
+    }
+
+    auto screen = object;
+    for (auto obj = object; obj != nullptr; obj = lv_obj_get_parent(obj)) {
+        if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) {
+            return true;
+        }
+        screen = obj;
+    }
+
+    // The screen of a paused app is not loaded, only the active screen and the layers are visible
+    auto display = lv_obj_get_display(screen);
+    return (screen != lv_display_get_screen_active(display)) && (screen != lv_display_get_layer_top(display)) &&
+           (screen != lv_display_get_layer_sys(display)) && (screen != lv_display_get_layer_bottom(display));
+}
+
+LvTickSubscriber::LvTickSubscriber(
+    TickCallback callback, uint32_t period_ms, uint32_t slack_ms, void *user_data, lv_obj_t *visible_object
+)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(callback, "Invalid callback");
+    _id = LvTickScheduler::getInstance().subscribe([callback, user_data]() {
+        callback(user_data);
+    }, LvTickScheduler::SubscriberConfig{
+        .period_ms = period_ms,
+        .slack_ms = slack_ms,
+        .visible_object = visible_object,
+    });
+}
+
+LvTickSubscriber::~LvTickSubscriber()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (isValid()) {
+        LvTickScheduler::getInstance().unsubscribe(_id);
+    }
+}
+
+bool LvTickSubscriber::pause()
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isValid(), false, "Invalid subscriber");
+
+    return LvTickScheduler::getInstance().setPaused(_id, true);
+}
+
+bool LvTickSubscriber::resume()
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isValid(), false, "Invalid subscriber");
+
+    return LvTickScheduler::getInstance().setPaused(_id, false);
+}
+
+bool LvTickSubscriber::trigger()
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isValid(), false, "Invalid subscriber");
+
+    return LvTickScheduler::getInstance().trigger(_id);
+}
+
+bool LvTickSubscriber::setInterval(uint32_t interval_ms)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isValid(), false, "Invalid subscriber");
+
+    return LvTickScheduler::getInstance().setPeriod(_id, interval_ms);
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include "lvgl.h"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Scheduler of the periodic refreshes of the widgets, with a single LVGL timer for all of them
+ *
+ * The callbacks of every subscriber are due on multiples of their period since the LVGL tick 0, so subscribers whose
+ * periods divide each other are due at the same time. The timer wakes up at the earliest time a due callback can't be
+ * delayed anymore, which is its due time plus its slack, then runs every callback already due. A paused subscriber
+ * doesn't wake the timer, and the callback of a subscriber whose object is hidden, or on a screen which is not loaded,
+ * is skipped.
+ *
+ * All the functions must be called from the LVGL task or with the LVGL lock held, like `lv_timer_*()`.
+ */
+class LvTickScheduler {
+public:
+    using ID = int;
+    using Callback = std::function<void()>;
+
+    static constexpr ID INVALID_ID = -1;
+
+    struct SubscriberConfig {
+        uint32_t period_ms = 0;
+        uint32_t slack_ms = 0;                  /*!< How late the callback may run, to share a wakeup with others */
+        lv_obj_t *visible_object = nullptr;     /*!< If set, the callback is skipped while the object is not visible */
+        bool is_paused = false;
+    };
+
+    struct Statistics {
+        uint32_t elapsed_ms;
+        uint32_t wakeups;
+        uint32_t callbacks;
+        uint32_t skipped_callbacks;             /*!< Callbacks not run since the object was not visible */
+
+        float getWakeupsPerSecond() const
+        {
+            return (elapsed_ms == 0) ? 0 : wakeups * 1000.0f / elapsed_ms;
+        }
+    };
+
+    LvTickScheduler(const LvTickScheduler &) = delete;
+    LvTickScheduler &operator=(const LvTickScheduler &) = delete;
+
+    /**
+     * @brief Add a subscriber, its first callback is due on the next multiple of its period
+     *
+     * @return The ID of the subscriber, or `INVALID_ID` if failed
+     */
+    ID subscribe(Callback callback, const SubscriberConfig &config);
+    bool unsubscribe(ID id);
+
+    /**
+     * @brief Pause or resume a subscriber. A resumed subscriber is due on the next multiple of its period
+     */
+    bool setPaused(ID id, bool paused);
+    bool setPeriod(ID id, uint32_t period_ms);
+
+    /**
+     * @brief Resume a subscriber and run its callback on the next run of the LVGL timer handler
+     */
+    bool trigger(ID id);
+
+    bool isSubscribed(ID id) const
+    {
+        return (_subscribers.find(id) != _subscribers.end());
+    }
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+    static LvTickScheduler &getInstance();
+
+private:
+    struct Subscriber {
+        Callback callback;
+        SubscriberConfig config;
+        uint32_t due_tick;
+    };
+
+    // The timer is deleted with the last subscriber, nothing is left to release if LVGL is deinitialized first
+    LvTickScheduler() = default;
+    ~LvTickScheduler() = default;
+
+    void run();
+    void schedule();
+    static bool isObjectHidden(const lv_obj_t *object);
+
+    ID _next_id = 0;
+    std::map<ID, Subscriber> _subscribers;
+    lv_timer_t *_timer = nullptr;
+    bool _is_running = false;
+    uint32_t _statistics_start_tick = 0;
+    Statistics _statistics = {};
+};
+
+/**
+ * @brief Subscriber of `LvTickScheduler`, which unsubscribes when deleted. Same usage as `LvTimer`
+ */
+class LvTickSubscriber {
+public:
+    using TickCallback = std::function<void(void *)>;
+
+    LvTickSubscriber(
+        TickCallback callback, uint32_t period_ms, uint32_t slack_ms, void *user_data,
+        lv_obj_t *visible_object = nullptr
+    );
+    ~LvTickSubscriber();
+
+    LvTickSubscriber(const LvTickSubscriber &other) = delete;
+    LvTickSubscriber &operator=(const LvTickSubscriber &other) = delete;
+
+    bool pause();
+    bool resume();
+    bool trigger();
+    bool setInterval(uint32_t interval_ms);
+
+    bool isValid() const
+    {
+        return (_id != LvTickScheduler::INVALID_ID);
+    }
+
+private:
+    LvTickScheduler::ID _id = LvTickScheduler::INVALID_ID;
+};
+
+using LvTickSubscriberUniquePtr = std::unique_ptr<LvTickSubscriber>;
+
+} // namespace esp_brookesia::gui
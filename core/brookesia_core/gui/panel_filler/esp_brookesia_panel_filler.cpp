@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "boost/thread.hpp"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "private/esp_brookesia_panel_filler_utils.hpp"
+#include "esp_brookesia_panel_filler.hpp"
+
+namespace esp_brookesia::gui {
+
+PanelFiller::~PanelFiller()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_is_begun && !del()) {
+        ESP_UTILS_LOGE("Delete failed");
+    }
+}
+
+bool PanelFiller::begin(const Config &config, DrawCallback draw_callback, FillCallback fill_callback)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_begun, false, "Already begun");
+    ESP_UTILS_CHECK_FALSE_RETURN((config.max_width > 0) && (config.lines > 0), false, "Invalid buffer size");
+    ESP_UTILS_CHECK_FALSE_RETURN(draw_callback, false, "Invalid draw callback");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t buffer_size = static_cast<size_t>(config.max_width) * config.lines * sizeof(uint16_t);
+    uint32_t caps = (config.buffer_in_ext ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA)) |
+                    MALLOC_CAP_8BIT;
+    _buffer = static_cast<uint16_t *>(heap_caps_malloc(buffer_size, caps));
+    ESP_UTILS_CHECK_NULL_RETURN(_buffer, false, "Allocate line buffer(%d) failed", static_cast<int>(buffer_size));
+
+    _config = config;
+    _draw_callback = std::move(draw_callback);
+    _fill_callback = std::move(fill_callback);
+    _is_buffer_filled = false;
+    _stats = {};
+    _is_begun = true;
+
+    return true;
+}
+
+bool PanelFiller::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    heap_caps_free(_buffer);
+    _buffer = nullptr;
+    _draw_callback = nullptr;
+    _fill_callback = nullptr;
+    _is_begun = false;
+
+    return true;
+}
+
+bool PanelFiller::fill(int x_start, int y_start, int x_end, int y_end, uint16_t color)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(x_end - x_start <= _config.max_width, false, "Area is wider than the buffer");
+
+    if ((x_start >= x_end) || (y_start >= y_end)) {
+        return true;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    ESP_UTILS_CHECK_FALSE_RETURN(fillRows(x_start, y_start, x_end, y_end, color, 1), false, "Fill area failed");
+
+    _stats.last_fill_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    _stats.max_fill_us = std::max(_stats.max_fill_us, _stats.last_fill_us);
+
+    return true;
+}
+
+bool PanelFiller::fadeOut(
+    int x_start, int y_start, int x_end, int y_end, uint16_t color, const void *source, int steps, int step_ms
+)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(x_end - x_start <= _config.max_width, false, "Area is wider than the buffer");
+
+    if ((x_start >= x_end) || (y_start >= y_end)) {
+        return true;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    steps = std::max(steps, 1);
+    for (int step = 1; step <= steps; step++) {
+        if (step > 1) {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(step_ms));
+        }
+        if (source != nullptr) {
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                blendRows(x_start, y_start, x_end, y_end, color, static_cast<const uint16_t *>(source), step, steps),
+                false, "Blend step(%d) failed", step
+            );
+        } else {
+            // Each step fills every `steps`-th row, one row further down than the previous step
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                fillRows(x_start, y_start + step - 1, x_end, y_end, color, steps), false, "Fill step(%d) failed",
+                step
+            );
+        }
+    }
+
+    _stats.last_fill_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    _stats.max_fill_us = std::max(_stats.max_fill_us, _stats.last_fill_us);
+
+    return true;
+}
+
+PanelFiller::Stats PanelFiller::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void PanelFiller::resetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats = {};
+}
+
+bool PanelFiller::fillRows(int x_start, int y_start, int x_end, int y_end, uint16_t color, int row_step)
+{
+    int width = x_end - x_start;
+    _stats.fills++;
+
+    // Let the panel fill the area by itself when it can, that costs no transfer at all
+    if (row_step == 1) {
+        if (_fill_callback && _fill_callback(x_start, y_start, x_end, y_end, color)) {
+            _stats.panel_fills++;
+            return true;
+        }
+    } else if (_fill_callback) {
+        bool is_filled = true;
+        for (int y = y_start; is_filled && (y < y_end); y += row_step) {
+            is_filled = _fill_callback(x_start, y, x_end, y + 1, color);
+        }
+        if (is_filled) {
+            _stats.panel_fills++;
+            return true;
+        }
+    }
+
+    size_t buffer_pixels = static_cast<size_t>(_config.max_width) * _config.lines;
+    if (!_is_buffer_filled || (_buffer_color != color)) {
+        std::fill(_buffer, _buffer + buffer_pixels, color);
+        _buffer_color = color;
+        _is_buffer_filled = true;
+    }
+
+    // A narrow area fits more rows in the buffer than a full-width one
+    int strip_rows = (row_step == 1) ? static_cast<int>(buffer_pixels / width) : 1;
+    for (int y = y_start; y < y_end; y += strip_rows * row_step) {
+        int rows = std::min(strip_rows, y_end - y);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _draw_callback(x_start, y, x_end, y + rows, _buffer), false, "Draw strip(%d,%d)-(%d,%d) failed", x_start,
+            y, x_end, y + rows
+        );
+        _stats.transfers++;
+        _stats.bytes += static_cast<uint64_t>(width) * rows * sizeof(uint16_t);
+    }
+
+    return true;
+}
+
+bool PanelFiller::blendRows(int x_start, int y_start, int x_end, int y_end, uint16_t color, const uint16_t *source,
+                            int level, int levels)
+{
+    if (level == levels) {
+        return fillRows(x_start, y_start, x_end, y_end, color, 1);
+    }
+
+    int width = x_end - x_start;
+    int strip_rows = static_cast<int>(static_cast<size_t>(_config.max_width) * _config.lines / width);
+    _stats.fills++;
+    _is_buffer_filled = false;
+    for (int y = y_start; y < y_end; y += strip_rows) {
+        int rows = std::min(strip_rows, y_end - y);
+        const uint16_t *src = source + static_cast<size_t>(y - y_start) * width;
+        for (int i = 0; i < width * rows; i++) {
+            _buffer[i] = blendColor(src[i], color, level, levels);
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _draw_callback(x_start, y, x_end, y + rows, _buffer), false, "Draw strip(%d,%d)-(%d,%d) failed", x_start,
+            y, x_end, y + rows
+        );
+        _stats.transfers++;
+        _stats.bytes += static_cast<uint64_t>(width) * rows * sizeof(uint16_t);
+    }
+
+    return true;
+}
+
+uint16_t PanelFiller::blendColor(uint16_t from, uint16_t to, int level, int levels) const
+{
+    if (_config.swap_bytes) {
+        from = static_cast<uint16_t>((from >> 8) | (from << 8));
+        to = static_cast<uint16_t>((to >> 8) | (to << 8));
+    }
+
+    auto blend = [level, levels](int from, int to) {
+        return from + (to - from) * level / levels;
+    };
+    int r = blend(from >> 11, to >> 11);
+    int g = blend((from >> 5) & 0x3F, (to >> 5) & 0x3F);
+    int b = blend(from & 0x1F, to & 0x1F);
+    uint16_t color = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+
+    return _config.swap_bytes ? static_cast<uint16_t>((color >> 8) | (color << 8)) : color;
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <mutex>
+#include <cstdint>
+#include <functional>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Fill areas of an RGB565 panel with a solid color, without allocating per fill
+ *
+ * A small line buffer is allocated once by `begin()`, filled with the color and pushed to the panel again and again,
+ * one strip of rows at a time, until the whole area is covered. When the panel can fill an area by itself, the fill
+ * callback is tried first and the line buffer is only used if it fails.
+ *
+ * This is meant for the consumers of `AnimPlayer::animation_stop_signal`, which have to blank the canvas of the
+ * animation that just stopped, but works for any area of the panel.
+ *
+ * All the colors and pixel data are in the byte order expected by the panel.
+ */
+class PanelFiller {
+public:
+    /**
+     * @brief Push an area to the panel, blocking until the data is no longer needed
+     *
+     * @note  The end coordinates are exclusive, like the ones of `esp_lcd_panel_draw_bitmap()`
+     */
+    using DrawCallback = std::function<bool(int x_start, int y_start, int x_end, int y_end, const void *data)>;
+    /**
+     * @brief Fill an area of the panel with a color by the panel itself, without pixel data
+     *
+     * @return false if the area could not be filled, the line buffer is then used instead
+     */
+    using FillCallback = std::function<bool(int x_start, int y_start, int x_end, int y_end, uint16_t color)>;
+
+    struct Config {
+        int max_width;          // Widest area to fill, usually the panel width
+        int lines;              // Rows pushed per transfer
+        bool buffer_in_ext;     // Allocate the line buffer in PSRAM, otherwise in DMA capable internal RAM
+        bool swap_bytes;        // The pixel data is byte swapped, so the color channels are too when fading
+    };
+
+    struct Stats {
+        uint32_t fills;         // Areas filled, including the ones of the fades
+        uint32_t panel_fills;   // Of which were filled by the panel itself
+        uint32_t transfers;     // Strips pushed from the line buffer
+        uint64_t bytes;         // Data pushed from the line buffer
+        uint32_t last_fill_us;  // Time to fill the last area, until the panel got all of it
+        uint32_t max_fill_us;
+    };
+
+    PanelFiller() = default;
+    ~PanelFiller();
+
+    PanelFiller(const PanelFiller &) = delete;
+    PanelFiller(PanelFiller &&) = delete;
+    PanelFiller &operator=(const PanelFiller &) = delete;
+    PanelFiller &operator=(PanelFiller &&) = delete;
+
+    bool begin(const Config &config, DrawCallback draw_callback, FillCallback fill_callback = nullptr);
+    bool del();
+
+    /**
+     * @brief Fill an area with a color
+     */
+    bool fill(int x_start, int y_start, int x_end, int y_end, uint16_t color);
+
+    /**
+     * @brief Fade an area out to a color, instead of blanking it at once
+     *
+     * With the pixels of the area, every step blends them a bit more into the color. Without them, e.g. when the last
+     * frame is gone, every step fills some more of the interleaved rows, so the area dissolves into the color. Either
+     * way, the area is filled with the color at the end.
+     *
+     * @param source   Pixels currently shown in the area, `x_end - x_start` per row, or `nullptr` if unknown
+     * @param steps    Number of steps, the last one being the plain fill
+     * @param step_ms  Delay between the steps
+     */
+    bool fadeOut(
+        int x_start, int y_start, int x_end, int y_end, uint16_t color, const void *source, int steps, int step_ms
+    );
+
+    bool isBegun() const
+    {
+        return _is_begun;
+    }
+    Stats getStats();
+    void resetStats();
+
+private:
+    bool fillRows(int x_start, int y_start, int x_end, int y_end, uint16_t color, int row_step);
+    bool blendRows(int x_start, int y_start, int x_end, int y_end, uint16_t color, const uint16_t *source,
+                   int level, int levels);
+    uint16_t blendColor(uint16_t from, uint16_t to, int level, int levels) const;
+
+    std::mutex _mutex;
+    bool _is_begun = false;
+    Config _config = {};
+    DrawCallback _draw_callback;
+    FillCallback _fill_callback;
+    uint16_t *_buffer = nullptr;
+    // Color currently held by the line buffer, so consecutive fills don't rewrite it
+    uint16_t _buffer_color = 0;
+    bool _is_buffer_filled = false;
+    Stats _stats = {};
+};
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "host_check.hpp"
+
+static const char *TAG = "host_check";
+
+// Constructed on first use, the registrars of other files may run before the static initialization of this one
+static std::vector<HostCheckModule> &host_check_get_modules()
+{
+    static std::vector<HostCheckModule> modules;
+    return modules;
+}
+
+HostCheckRegistrar::HostCheckRegistrar(const HostCheckModule &module)
+{
+    host_check_get_modules().push_back(module);
+}
+
+int host_check_run_all()
+{
+    // The order of the static initialization across files is unspecified, sort the modules to keep the log stable
+    auto modules = host_check_get_modules();
+    std::sort(modules.begin(), modules.end(), [](const HostCheckModule & a, const HostCheckModule & b) {
+        return strcmp(a.id, b.id) < 0;
+    });
+
+    int failures = 0;
+    for (auto &module : modules) {
+        for (size_t i = 0; i < module.check_num; i++) {
+            auto &check = module.checks[i];
+            bool is_ok = check.func();
+            ESP_LOGI(TAG, "%s check(%s): %s", module.name, check.name, is_ok ? "pass" : "FAIL");
+            failures += is_ok ? 0 : 1;
+        }
+    }
+
+    return failures;
+}
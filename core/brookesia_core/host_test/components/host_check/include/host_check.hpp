@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include "esp_log.h"
+
+/**
+ * @brief Fail the current check if `x` is false, the failed expression is logged with the `TAG` of the file
+ */
+#define HOST_CHECK(x) do {                                                  \
+        if (!(x)) {                                                         \
+            ESP_LOGE(TAG, "%s:%d: check failed: %s", __func__, __LINE__, #x); \
+            return false;                                                   \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief Register the checks of a module, each one given as `{name, function}`, the functions return true on success
+ *
+ * @param id    Identifier of the module, the modules run in the order of their identifiers
+ * @param name  Name of the module printed with the result of each check
+ */
+#define HOST_CHECK_REGISTER(id, name, ...)                                                  \
+    static const HostCheck host_check_##id##_checks[] = {__VA_ARGS__};                      \
+    static const HostCheckRegistrar host_check_##id##_registrar(HostCheckModule{            \
+        #id, name, host_check_##id##_checks,                                                \
+        sizeof(host_check_##id##_checks) / sizeof(host_check_##id##_checks[0])              \
+    })
+
+struct HostCheck {
+    const char *name;
+    bool (*func)();
+};
+
+struct HostCheckModule {
+    const char *id;
+    const char *name;
+    const HostCheck *checks;
+    size_t check_num;
+};
+
+/**
+ * @brief Adds a module to the table of `host_check_run_all()` during the static initialization, the component of the
+ *        checks must be linked as a whole archive so the registrars are not dropped by the linker
+ */
+class HostCheckRegistrar {
+public:
+    explicit HostCheckRegistrar(const HostCheckModule &module);
+};
+
+/**
+ * @brief Run the checks of every registered module
+ *
+ * @return Number of failed checks
+ */
+int host_check_run_all();
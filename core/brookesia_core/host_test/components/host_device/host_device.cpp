@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <cstring>
+#include "esp_log.h"
+#include "host_device.hpp"
+
+// Same as the partial buffers of the boards: a tenth of the screen
+#define HOST_DEVICE_DRAW_BUFFER_DIV    (10)
+
+static const char *TAG = "host_device";
+
+uint32_t HostDevice::_tick_ms = 0;
+
+HostDevice::~HostDevice()
+{
+    del();
+}
+
+bool HostDevice::begin(int width, int height)
+{
+    ESP_LOGI(TAG, "Create headless display(%dx%d)", width, height);
+
+    // Every display starts at the same virtual time, so the results do not depend on the previous ones
+    _tick_ms = 0;
+    lv_init();
+    lv_tick_set_cb(onTick);
+
+    _width = width;
+    _height = height;
+    _framebuffer.assign(static_cast<size_t>(width) * height, 0);
+    _draw_buffer.assign(
+        static_cast<size_t>(width) * (height / HOST_DEVICE_DRAW_BUFFER_DIV) *
+        lv_color_format_get_size(LV_COLOR_FORMAT_RGB565), 0
+    );
+
+    _display = lv_display_create(width, height);
+    if (_display == nullptr) {
+        ESP_LOGE(TAG, "Create display failed");
+        return false;
+    }
+    lv_display_set_color_format(_display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(
+        _display, _draw_buffer.data(), nullptr, _draw_buffer.size(), LV_DISPLAY_RENDER_MODE_PARTIAL
+    );
+    lv_display_set_flush_cb(_display, onFlush);
+    lv_display_set_user_data(_display, this);
+    lv_display_add_event_cb(_display, onInvalidate, LV_EVENT_INVALIDATE_AREA, this);
+
+    _touch = lv_indev_create();
+    if (_touch == nullptr) {
+        ESP_LOGE(TAG, "Create touch failed");
+        return false;
+    }
+    lv_indev_set_type(_touch, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_display(_touch, _display);
+    lv_indev_set_read_cb(_touch, onTouchRead);
+    lv_indev_set_user_data(_touch, this);
+
+    resetStats();
+
+    return true;
+}
+
+void HostDevice::del()
+{
+    if (_display == nullptr) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Delete headless display");
+    lv_indev_delete(_touch);
+    lv_display_delete(_display);
+    lv_deinit();
+    _touch = nullptr;
+    _display = nullptr;
+    _framebuffer.clear();
+    _draw_buffer.clear();
+}
+
+void HostDevice::setTouch(bool pressed, int x, int y)
+{
+    _touch_pressed = pressed;
+    _touch_point.x = x;
+    _touch_point.y = y;
+}
+
+void HostDevice::run(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += STEP_MS) {
+        _tick_ms += STEP_MS;
+
+        uint32_t frames = _stats.frames;
+        auto start = std::chrono::steady_clock::now();
+        lv_timer_handler();
+        auto end = std::chrono::steady_clock::now();
+        if (_stats.frames != frames) {
+            _stats.frame_us.push_back(
+                static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count())
+            );
+        }
+        sampleHeap();
+    }
+}
+
+void HostDevice::stall(uint32_t ms)
+{
+    _tick_ms += ms;
+}
+
+void HostDevice::resetStats()
+{
+    _stats = {};
+    sampleHeap();
+}
+
+void HostDevice::sampleHeap()
+{
+    lv_mem_monitor_t monitor = {};
+    lv_mem_monitor(&monitor);
+    uint32_t used = static_cast<uint32_t>(monitor.total_size - monitor.free_size);
+    if (used > _stats.lv_heap_peak) {
+        _stats.lv_heap_peak = used;
+    }
+}
+
+uint32_t HostDevice::onTick()
+{
+    return _tick_ms;
+}
+
+void HostDevice::onFlush(lv_display_t *display, const lv_area_t *area, uint8_t *px_map)
+{
+    auto device = static_cast<HostDevice *>(lv_display_get_user_data(display));
+    int32_t width = lv_area_get_width(area);
+    auto src = reinterpret_cast<const uint16_t *>(px_map);
+
+    for (int32_t y = area->y1; y <= area->y2; y++, src += width) {
+        memcpy(&device->_framebuffer[static_cast<size_t>(y) * device->_width + area->x1], src, width * sizeof(uint16_t));
+    }
+    device->_stats.flushes++;
+    device->_stats.flushed_pixels += static_cast<uint64_t>(width) * lv_area_get_height(area);
+    if (lv_display_flush_is_last(display)) {
+        device->_stats.frames++;
+    }
+
+    lv_display_flush_ready(display);
+}
+
+void HostDevice::onTouchRead(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    auto device = static_cast<HostDevice *>(lv_indev_get_user_data(indev));
+
+    data->point = device->_touch_point;
+    data->state = device->_touch_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void HostDevice::onInvalidate(lv_event_t *event)
+{
+    static_cast<HostDevice *>(lv_event_get_user_data(event))->_stats.invalidations++;
+}
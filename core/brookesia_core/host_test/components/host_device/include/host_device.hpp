@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "lvgl.h"
+
+/**
+ * @brief Headless LVGL device for the host: the display renders into a framebuffer in memory, the touch reports the
+ *        points set by the script, and the LVGL tick is a virtual clock that only moves when `run()` is called. The
+ *        same script gives the same frames on every run.
+ */
+class HostDevice {
+public:
+    struct Stats {
+        uint32_t frames;                        /*!< Frames flushed completely */
+        uint32_t flushes;                       /*!< Calls of the flush callback */
+        uint64_t flushed_pixels;                /*!< Pixels copied to the framebuffer */
+        uint32_t invalidations;                 /*!< Areas invalidated on the display */
+        uint32_t lv_heap_peak;                  /*!< Peak of the LVGL heap usage, in bytes */
+        std::vector<uint32_t> frame_us;         /*!< Host time spent in the LVGL handler for each frame */
+    };
+
+    /* The virtual time between two calls of the LVGL handler */
+    static constexpr uint32_t STEP_MS = 5;
+
+    HostDevice() = default;
+    ~HostDevice();
+
+    HostDevice(const HostDevice &) = delete;
+    HostDevice &operator=(const HostDevice &) = delete;
+
+    bool begin(int width, int height);
+    void del();
+
+    void setTouch(bool pressed, int x, int y);
+    void run(uint32_t ms);
+    /* Move the virtual tick without calling the LVGL handler, like a busy CPU delaying the LVGL task */
+    void stall(uint32_t ms);
+
+    void resetStats();
+    const Stats &getStats() const
+    {
+        return _stats;
+    }
+    lv_display_t *getDisplay() const
+    {
+        return _display;
+    }
+    lv_indev_t *getTouch() const
+    {
+        return _touch;
+    }
+    int getWidth() const
+    {
+        return _width;
+    }
+    int getHeight() const
+    {
+        return _height;
+    }
+
+private:
+    static uint32_t onTick();
+    static void onFlush(lv_display_t *display, const lv_area_t *area, uint8_t *px_map);
+    static void onTouchRead(lv_indev_t *indev, lv_indev_data_t *data);
+    static void onInvalidate(lv_event_t *event);
+
+    void sampleHeap();
+
+    static uint32_t _tick_ms;
+
+    int _width = 0;
+    int _height = 0;
+    lv_display_t *_display = nullptr;
+    lv_indev_t *_touch = nullptr;
+    std::vector<uint16_t> _framebuffer;
+    std::vector<uint8_t> _draw_buffer;
+    bool _touch_pressed = false;
+    lv_point_t _touch_point = {};
+    Stats _stats = {};
+};
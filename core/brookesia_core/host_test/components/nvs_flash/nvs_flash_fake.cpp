@@ -0,0 +1,385 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "nvs_flash.h"
+
+namespace {
+
+struct Entry {
+    nvs_type_t type;
+    std::vector<uint8_t> data;
+};
+
+using Namespace = std::map<std::string, Entry>;
+
+struct Handle {
+    std::string namespace_name;
+    nvs_open_mode_t mode;
+};
+
+struct Storage {
+    std::mutex mutex;
+    bool is_initialized = false;
+    std::map<std::string, Namespace> namespaces;
+    std::map<nvs_handle_t, Handle> handles;
+    nvs_handle_t next_handle = 1;
+};
+
+Storage &storage()
+{
+    static Storage instance;
+    return instance;
+}
+
+esp_err_t set_value(nvs_handle_t handle, const char *key, nvs_type_t type, const void *value, size_t length)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.handles.find(handle);
+    if (it == s.handles.end()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (it->second.mode == NVS_READONLY) {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    if ((key == nullptr) || (strlen(key) == 0)) {
+        return ESP_ERR_NVS_INVALID_NAME;
+    }
+    if (strlen(key) >= NVS_KEY_NAME_MAX_SIZE) {
+        return ESP_ERR_NVS_KEY_TOO_LONG;
+    }
+
+    auto bytes = static_cast<const uint8_t *>(value);
+    s.namespaces[it->second.namespace_name][key] = Entry{type, std::vector<uint8_t>(bytes, bytes + length)};
+
+    return ESP_OK;
+}
+
+/* `length` is the size of `out_value` on input, and the size of the value on output */
+esp_err_t get_value(nvs_handle_t handle, const char *key, nvs_type_t type, void *out_value, size_t *length)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.handles.find(handle);
+    if (it == s.handles.end()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    auto &entries = s.namespaces[it->second.namespace_name];
+    auto entry_it = entries.find(key);
+    if (entry_it == entries.end()) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (entry_it->second.type != type) {
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+
+    auto &data = entry_it->second.data;
+    if (out_value == nullptr) {
+        *length = data.size();
+        return ESP_OK;
+    }
+    if (*length < data.size()) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(out_value, data.data(), data.size());
+    *length = data.size();
+
+    return ESP_OK;
+}
+
+template <typename T>
+esp_err_t get_scalar(nvs_handle_t handle, const char *key, nvs_type_t type, T *out_value)
+{
+    size_t length = sizeof(T);
+    return get_value(handle, key, type, out_value, &length);
+}
+
+} // namespace
+
+struct nvs_opaque_iterator_t {
+    std::vector<nvs_entry_info_t> entries;
+    size_t index;
+};
+
+extern "C" {
+
+esp_err_t nvs_flash_init(void)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.is_initialized = true;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_deinit(void)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.is_initialized) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    s.is_initialized = false;
+    s.handles.clear();
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.namespaces.clear();
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    if (!s.is_initialized) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    if ((namespace_name == nullptr) || (strlen(namespace_name) >= NVS_NS_NAME_MAX_SIZE)) {
+        return ESP_ERR_NVS_INVALID_NAME;
+    }
+    // Like on the flash, a namespace only exists once something opened it for writing
+    if ((open_mode == NVS_READONLY) && (s.namespaces.find(namespace_name) == s.namespaces.end())) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    s.namespaces[namespace_name];
+    *out_handle = s.next_handle++;
+    s.handles[*out_handle] = Handle{namespace_name, open_mode};
+
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.handles.erase(handle);
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    return (s.handles.find(handle) != s.handles.end()) ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.handles.find(handle);
+    if (it == s.handles.end()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (it->second.mode == NVS_READONLY) {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+
+    return (s.namespaces[it->second.namespace_name].erase(key) > 0) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.handles.find(handle);
+    if (it == s.handles.end()) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (it->second.mode == NVS_READONLY) {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    s.namespaces[it->second.namespace_name].clear();
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_i8(nvs_handle_t handle, const char *key, int8_t value)
+{
+    return set_value(handle, key, NVS_TYPE_I8, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char *key, uint8_t value)
+{
+    return set_value(handle, key, NVS_TYPE_U8, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_i16(nvs_handle_t handle, const char *key, int16_t value)
+{
+    return set_value(handle, key, NVS_TYPE_I16, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_u16(nvs_handle_t handle, const char *key, uint16_t value)
+{
+    return set_value(handle, key, NVS_TYPE_U16, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_i32(nvs_handle_t handle, const char *key, int32_t value)
+{
+    return set_value(handle, key, NVS_TYPE_I32, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char *key, uint32_t value)
+{
+    return set_value(handle, key, NVS_TYPE_U32, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_i64(nvs_handle_t handle, const char *key, int64_t value)
+{
+    return set_value(handle, key, NVS_TYPE_I64, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_u64(nvs_handle_t handle, const char *key, uint64_t value)
+{
+    return set_value(handle, key, NVS_TYPE_U64, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char *key, const char *value)
+{
+    return set_value(handle, key, NVS_TYPE_STR, value, strlen(value) + 1);
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    return set_value(handle, key, NVS_TYPE_BLOB, value, length);
+}
+
+esp_err_t nvs_get_i8(nvs_handle_t handle, const char *key, int8_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_I8, out_value);
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char *key, uint8_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_U8, out_value);
+}
+
+esp_err_t nvs_get_i16(nvs_handle_t handle, const char *key, int16_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_I16, out_value);
+}
+
+esp_err_t nvs_get_u16(nvs_handle_t handle, const char *key, uint16_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_U16, out_value);
+}
+
+esp_err_t nvs_get_i32(nvs_handle_t handle, const char *key, int32_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_I32, out_value);
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char *key, uint32_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_U32, out_value);
+}
+
+esp_err_t nvs_get_i64(nvs_handle_t handle, const char *key, int64_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_I64, out_value);
+}
+
+esp_err_t nvs_get_u64(nvs_handle_t handle, const char *key, uint64_t *out_value)
+{
+    return get_scalar(handle, key, NVS_TYPE_U64, out_value);
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char *key, char *out_value, size_t *length)
+{
+    return get_value(handle, key, NVS_TYPE_STR, out_value, length);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    return get_value(handle, key, NVS_TYPE_BLOB, out_value, length);
+}
+
+esp_err_t nvs_entry_find(const char *part_name, const char *namespace_name, nvs_type_t type,
+                         nvs_iterator_t *output_iterator)
+{
+    auto &s = storage();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    *output_iterator = nullptr;
+    if (!s.is_initialized) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    if ((part_name == nullptr) || (strcmp(part_name, NVS_DEFAULT_PART_NAME) != 0)) {
+        return ESP_ERR_NVS_PART_NOT_FOUND;
+    }
+
+    auto iterator = new nvs_opaque_iterator_t{{}, 0};
+    for (auto &[ns_name, entries] : s.namespaces) {
+        if ((namespace_name != nullptr) && (ns_name != namespace_name)) {
+            continue;
+        }
+        for (auto &[key, entry] : entries) {
+            if ((type != NVS_TYPE_ANY) && (entry.type != type)) {
+                continue;
+            }
+            nvs_entry_info_t info = {};
+            strncpy(info.namespace_name, ns_name.c_str(), sizeof(info.namespace_name) - 1);
+            strncpy(info.key, key.c_str(), sizeof(info.key) - 1);
+            info.type = entry.type;
+            iterator->entries.push_back(info);
+        }
+    }
+    if (iterator->entries.empty()) {
+        delete iterator;
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    *output_iterator = iterator;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_entry_next(nvs_iterator_t *iterator)
+{
+    if ((iterator == nullptr) || (*iterator == nullptr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (++(*iterator)->index >= (*iterator)->entries.size()) {
+        delete *iterator;
+        *iterator = nullptr;
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_entry_info(const nvs_iterator_t iterator, nvs_entry_info_t *out_info)
+{
+    if ((iterator == nullptr) || (out_info == nullptr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_info = iterator->entries[iterator->index];
+
+    return ESP_OK;
+}
+
+void nvs_release_iterator(nvs_iterator_t iterator)
+{
+    delete iterator;
+}
+
+} // extern "C"
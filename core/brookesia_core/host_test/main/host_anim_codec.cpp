@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "esp_log.h"
+#include "anim_player/esp_brookesia_anim_codec.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::gui::AnimCodecDecoder;
+
+#define HOST_ANIM_AAF_HEADER        "_S\0V1.00\0"
+#define HOST_ANIM_AAF_HEADER_SIZE   (9)
+#define HOST_ANIM_DECODE_ROUNDS     (5)
+
+static const char *TAG = "host_anim_codec";
+
+using Clock = std::chrono::steady_clock;
+
+struct HostAnimFile {
+    std::string name;
+    std::vector<uint8_t> aaf;
+    std::vector<uint8_t> packed;
+};
+
+static std::vector<uint8_t> host_anim_read_file(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static uint32_t host_anim_get_u32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static uint16_t host_anim_get_u16(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+/* Reference decoder of the AAF files: 8-bit palette and RLE blocks, the same conversion to RGB565 as the packer */
+class HostAafDecoder {
+public:
+    bool begin(const std::vector<uint8_t> &data)
+    {
+        _data = &data;
+        if (data.size() < 12) {
+            return false;
+        }
+        _frame_num = host_anim_get_u32(data.data());
+        return (12 + _frame_num * 8) <= data.size();
+    }
+
+    int getFrameNum() const
+    {
+        return _frame_num;
+    }
+
+    bool decodeFrame(int index, std::vector<uint16_t> &pixels, int &width, int &height) const
+    {
+        auto &data = *_data;
+        auto entry = data.data() + 12 + index * 8;
+        size_t size = host_anim_get_u32(entry);
+        size_t offset = 12 + _frame_num * 8 + host_anim_get_u32(entry + 4);
+        if ((offset + size > data.size()) || (size < 2 + HOST_ANIM_AAF_HEADER_SIZE + 11)) {
+            return false;
+        }
+        auto frame = data.data() + offset + 2;
+        if (memcmp(frame, HOST_ANIM_AAF_HEADER, HOST_ANIM_AAF_HEADER_SIZE) != 0) {
+            return false;
+        }
+        auto pos = frame + HOST_ANIM_AAF_HEADER_SIZE;
+        int bit_depth = pos[0];
+        width = host_anim_get_u16(pos + 1);
+        height = host_anim_get_u16(pos + 3);
+        int blocks = host_anim_get_u16(pos + 5);
+        auto block_lengths = pos + 9;
+        auto colors = block_lengths + blocks * 2;
+        uint16_t palette[256] = {};
+        for (int i = 0; i < (1 << bit_depth); i++) {
+            auto color = colors + i * 4;
+            palette[i] = ((color[2] & 0xF8) << 8) | ((color[1] & 0xFC) << 3) | (color[0] >> 3);
+        }
+        auto block = colors + (1 << bit_depth) * 4;
+        pixels.resize(width * height);
+        size_t count = 0;
+        for (int b = 0; b < blocks; b++) {
+            int length = host_anim_get_u16(block_lengths + b * 2);
+            if (block[0] != 0) {
+                return false;
+            }
+            for (int i = 1; i + 1 < length; i += 2) {
+                if (count + block[i] > pixels.size()) {
+                    return false;
+                }
+                std::fill_n(pixels.data() + count, block[i], palette[block[i + 1]]);
+                count += block[i];
+            }
+            block += length;
+        }
+
+        return count == pixels.size();
+    }
+
+private:
+    const std::vector<uint8_t> *_data = nullptr;
+    size_t _frame_num = 0;
+};
+
+static std::vector<HostAnimFile> host_anim_get_files()
+{
+    std::vector<HostAnimFile> files;
+    for (auto &entry : std::filesystem::recursive_directory_iterator(HOST_ANIM_AAF_DIR)) {
+        if (entry.path().extension() != ".aaf") {
+            continue;
+        }
+        auto name = entry.path().filename();
+        files.push_back({
+            .name = name.string(),
+            .aaf = host_anim_read_file(entry.path()),
+            .packed = host_anim_read_file(std::filesystem::path(HOST_ANIM_PACKED_DIR) / name),
+        });
+    }
+    std::sort(files.begin(), files.end(), [](const HostAnimFile & a, const HostAnimFile & b) {
+        return a.name < b.name;
+    });
+
+    return files;
+}
+
+/* Every frame of the bundled animations decodes to the same pixels as the AAF file, in order or not */
+static bool host_anim_check_bundled()
+{
+    auto files = host_anim_get_files();
+    HOST_CHECK(!files.empty());
+
+    size_t aaf_total = 0;
+    size_t packed_total = 0;
+    for (auto &file : files) {
+        HostAafDecoder aaf;
+        AnimCodecDecoder codec;
+        HOST_CHECK(aaf.begin(file.aaf));
+        HOST_CHECK(!AnimCodecDecoder::isEncoded(file.aaf.data(), file.aaf.size()));
+        HOST_CHECK(AnimCodecDecoder::isEncoded(file.packed.data(), file.packed.size()));
+        HOST_CHECK(codec.begin(file.packed.data(), file.packed.size(), false));
+        HOST_CHECK(codec.getFrameNum() == aaf.getFrameNum());
+
+        // Decode all the frames once to check them, then time the decoding of the whole animation
+        int width = 0;
+        int height = 0;
+        std::vector<std::vector<uint16_t>> expected(aaf.getFrameNum());
+        for (int i = 0; i < aaf.getFrameNum(); i++) {
+            HOST_CHECK(aaf.decodeFrame(i, expected[i], width, height));
+        }
+        HOST_CHECK((codec.getWidth() == width) && (codec.getHeight() == height));
+        std::vector<uint16_t> buffer(width * height);
+        for (int i = 0; i < codec.getFrameNum(); i++) {
+            int y_start = 0;
+            int y_end = 0;
+            HOST_CHECK(codec.decodeFrame(i, buffer.data(), y_start, y_end));
+            HOST_CHECK(buffer == expected[i]);
+            HOST_CHECK((y_start >= 0) && (y_start <= y_end) && (y_end <= height));
+            // Only the changed rows are flushed, the rows outside are the same as in the previous frame
+            if (i > 0) {
+                HOST_CHECK(std::equal(
+                                    expected[i].begin(), expected[i].begin() + y_start * width, expected[i - 1].begin()
+                                ));
+                HOST_CHECK(std::equal(
+                                    expected[i].begin() + y_end * width, expected[i].end(),
+                                    expected[i - 1].begin() + y_end * width
+                                ));
+            }
+        }
+        // Jump back and forth, as a segment or a loop does
+        for (int i : {codec.getFrameNum() / 2, 0, codec.getFrameNum() - 1, codec.getFrameNum() / 3}) {
+            int y_start = 0;
+            int y_end = 0;
+            HOST_CHECK(codec.decodeFrame(i, buffer.data(), y_start, y_end));
+            HOST_CHECK(buffer == expected[i]);
+        }
+
+        auto aaf_begin = Clock::now();
+        std::vector<uint16_t> pixels;
+        for (int round = 0; round < HOST_ANIM_DECODE_ROUNDS; round++) {
+            for (int i = 0; i < aaf.getFrameNum(); i++) {
+                aaf.decodeFrame(i, pixels, width, height);
+            }
+        }
+        auto codec_begin = Clock::now();
+        for (int round = 0; round < HOST_ANIM_DECODE_ROUNDS; round++) {
+            for (int i = 0; i < codec.getFrameNum(); i++) {
+                int y_start = 0;
+                int y_end = 0;
+                codec.decodeFrame(i, buffer.data(), y_start, y_end);
+            }
+        }
+        auto codec_end = Clock::now();
+        auto frames = HOST_ANIM_DECODE_ROUNDS * codec.getFrameNum();
+        auto aaf_us = std::chrono::duration_cast<std::chrono::microseconds>(codec_begin - aaf_begin).count();
+        auto codec_us = std::chrono::duration_cast<std::chrono::microseconds>(codec_end - codec_begin).count();
+        ESP_LOGI(
+            TAG, "%s: %d frames, %d -> %d bytes (%.1f%%), decode %.1f -> %.1f us/frame", file.name.c_str(),
+            codec.getFrameNum(), static_cast<int>(file.aaf.size()), static_cast<int>(file.packed.size()),
+            100.0 * file.packed.size() / file.aaf.size(), static_cast<double>(aaf_us) / frames,
+            static_cast<double>(codec_us) / frames
+        );
+        aaf_total += file.aaf.size();
+        packed_total += file.packed.size();
+    }
+    ESP_LOGI(
+        TAG, "Total: %d -> %d bytes (%.1f%%)", static_cast<int>(aaf_total), static_cast<int>(packed_total),
+        100.0 * packed_total / aaf_total
+    );
+
+    return true;
+}
+
+/* Broken files are refused by `begin()` or `decodeFrame()`, without reading or writing out of the buffers */
+static bool host_anim_check_corrupted()
+{
+    auto files = host_anim_get_files();
+    HOST_CHECK(!files.empty());
+    auto &packed = files.front().packed;
+    AnimCodecDecoder codec;
+
+    std::vector<size_t> lengths = {0, AnimCodecDecoder::HEADER_SIZE, packed.size() / 2, packed.size() - 1};
+    for (auto length : lengths) {
+        HOST_CHECK(!codec.begin(packed.data(), length, false));
+    }
+    HOST_CHECK(codec.begin(packed.data(), packed.size(), false));
+    std::vector<uint16_t> buffer(codec.getWidth() * codec.getHeight());
+    int y_start = 0;
+    int y_end = 0;
+    HOST_CHECK(!codec.decodeFrame(-1, buffer.data(), y_start, y_end));
+    HOST_CHECK(!codec.decodeFrame(codec.getFrameNum(), buffer.data(), y_start, y_end));
+
+    // Random bytes in the frames of a copy, whatever the result is
+    int failures = 0;
+    for (uint32_t seed = 1; seed <= 64; seed++) {
+        auto copy = packed;
+        uint32_t random = seed;
+        for (int i = 0; i < 16; i++) {
+            random = random * 1103515245 + 12345;
+            copy[copy.size() - 1 - (random >> 8) % (copy.size() / 2)] = static_cast<uint8_t>(random >> 16);
+        }
+        std::vector<uint16_t> copy_buffer(buffer.size());
+        HOST_CHECK(codec.begin(copy.data(), copy.size(), false));
+        for (int i = 0; i < codec.getFrameNum(); i++) {
+            failures += codec.decodeFrame(i, copy_buffer.data(), y_start, y_end) ? 0 : 1;
+        }
+    }
+    HOST_CHECK(failures > 0);
+
+    return true;
+}
+
+// Check the tile codec of the animation player with the bundled speaker animations, packed at build time, and report
+// the compression ratio and the decode time per frame against the AAF files
+HOST_CHECK_REGISTER(
+    anim_codec, "Anim codec",
+    {"bundled", host_anim_check_bundled},
+    {"corrupted", host_anim_check_corrupted}
+);
@@ -0,0 +1,233 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include <vector>
+#include "esp_log.h"
+#include "anim_player/esp_brookesia_anim_asset_verifier.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::gui::AnimAssetVerifier;
+
+// Size of an entry of the index table: name, size, offset, width and height
+#define HOST_ASSETS_TABLE_ENTRY_SIZE    (32 + 4 + 4 + 2 + 2)
+#define HOST_ASSETS_PARTITION_SIZE      (64 * 1024)
+
+static const char *TAG = "host_assets";
+
+/* Partition image laid out like the ones of `spiffs_create_partition_assets()`, followed by erased flash */
+struct HostAssetsImage {
+    std::vector<uint8_t> data;
+    std::vector<AnimAssetVerifier::Asset> assets;
+    uint32_t checksum;
+    uint32_t data_start;
+    int reads = 0;
+    int fail_read_offset = -1;
+
+    AnimAssetVerifier::ReadFunction getReadFunction()
+    {
+        return [this](uint32_t offset, void *buffer, uint32_t size) {
+            reads++;
+            if ((fail_read_offset >= 0) && (offset <= static_cast<uint32_t>(fail_read_offset)) &&
+                    (static_cast<uint32_t>(fail_read_offset) < offset + size)) {
+                return false;
+            }
+            memcpy(buffer, data.data() + offset, size);
+            return true;
+        };
+    }
+};
+
+static void host_assets_put_u32(std::vector<uint8_t> &data, uint32_t offset, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static HostAssetsImage host_assets_create_image(const std::vector<uint32_t> &sizes)
+{
+    HostAssetsImage image = {};
+    uint32_t table_size = sizes.size() * HOST_ASSETS_TABLE_ENTRY_SIZE;
+    std::vector<uint8_t> body(table_size, 0);
+    uint32_t offset = 0;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        uint8_t *entry = body.data() + i * HOST_ASSETS_TABLE_ENTRY_SIZE;
+        snprintf(reinterpret_cast<char *>(entry), 32, "anim_%d.aaf", static_cast<int>(i));
+        image.assets.push_back({offset, sizes[i]});
+        body.push_back(AnimAssetVerifier::ASSET_MAGIC_BYTE);
+        body.push_back(AnimAssetVerifier::ASSET_MAGIC_BYTE);
+        for (uint32_t j = 0; j < sizes[i]; j++) {
+            body.push_back(static_cast<uint8_t>((i * 31 + j * 7) & 0xFF));
+        }
+        offset += AnimAssetVerifier::ASSET_MAGIC_SIZE + sizes[i];
+    }
+
+    uint32_t sum = 0;
+    for (auto byte : body) {
+        sum += byte;
+    }
+    image.checksum = sum & AnimAssetVerifier::CHECKSUM_MASK;
+    image.data_start = AnimAssetVerifier::HEADER_SIZE + table_size;
+    image.data.assign(HOST_ASSETS_PARTITION_SIZE, 0xFF);
+    host_assets_put_u32(image.data, 0, sizes.size());
+    host_assets_put_u32(image.data, 4, image.checksum);
+    host_assets_put_u32(image.data, 8, body.size());
+    memcpy(image.data.data() + AnimAssetVerifier::HEADER_SIZE, body.data(), body.size());
+
+    return image;
+}
+
+static AnimAssetVerifier::State host_assets_scan(AnimAssetVerifier &verifier, uint32_t chunk_size, int *steps = nullptr)
+{
+    auto state = verifier.getState();
+    int count = 0;
+    while (state == AnimAssetVerifier::State::Indexed) {
+        state = verifier.scan(chunk_size);
+        count++;
+    }
+    if (steps != nullptr) {
+        *steps = count;
+    }
+    return state;
+}
+
+static const std::vector<uint32_t> host_assets_sizes = {3000, 17, 5000, 1};
+
+static bool host_assets_check_valid()
+{
+    auto image = host_assets_create_image(host_assets_sizes);
+    AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+    HOST_CHECK(verifier.getState() == AnimAssetVerifier::State::Unchecked);
+    HOST_CHECK(verifier.scan(UINT32_MAX) == AnimAssetVerifier::State::Unchecked);
+    HOST_CHECK(verifier.checkIndex(image.checksum, image.assets));
+    HOST_CHECK(verifier.getState() == AnimAssetVerifier::State::Indexed);
+
+    // The index check doesn't read the data, the scan reads it in chunks
+    uint32_t scanned = 0;
+    uint32_t total = 0;
+    verifier.getScanProgress(scanned, total);
+    HOST_CHECK(scanned == 0);
+    HOST_CHECK(total > 8000);
+    int steps = 0;
+    HOST_CHECK(host_assets_scan(verifier, 1000, &steps) == AnimAssetVerifier::State::Verified);
+    HOST_CHECK(steps == static_cast<int>((total + 999) / 1000));
+    verifier.getScanProgress(scanned, total);
+    HOST_CHECK(scanned == total);
+    HOST_CHECK(verifier.scan(UINT32_MAX) == AnimAssetVerifier::State::Verified);
+
+    // The same image has the same hash, another index has another one
+    AnimAssetVerifier same(image.getReadFunction(), image.data.size());
+    HOST_CHECK(same.checkIndex(image.checksum, image.assets));
+    HOST_CHECK(same.getImageHash() == verifier.getImageHash());
+    auto other_image = host_assets_create_image({3000, 17, 5001, 1});
+    AnimAssetVerifier other(other_image.getReadFunction(), other_image.data.size());
+    HOST_CHECK(other.checkIndex(other_image.checksum, other_image.assets));
+    HOST_CHECK(other.getImageHash() != verifier.getImageHash());
+
+    return true;
+}
+
+/* The data is only checked by the scan, a corrupted asset must be found before it is marked as verified */
+static bool host_assets_check_corrupted_data()
+{
+    for (int asset : {0, 2, 3}) {
+        auto image = host_assets_create_image(host_assets_sizes);
+        uint32_t offset = image.data_start + image.assets[asset].offset + AnimAssetVerifier::ASSET_MAGIC_SIZE +
+                          image.assets[asset].size / 2;
+        image.data[offset] ^= 0x10;
+
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(verifier.checkIndex(image.checksum, image.assets));
+        HOST_CHECK(host_assets_scan(verifier, 4096) == AnimAssetVerifier::State::Corrupt);
+        HOST_CHECK(verifier.scan(UINT32_MAX) == AnimAssetVerifier::State::Corrupt);
+        verifier.markVerified();
+        HOST_CHECK(verifier.getState() == AnimAssetVerifier::State::Corrupt);
+    }
+    {
+        // Corrupted index table, but not in the fields used by the index check
+        auto image = host_assets_create_image(host_assets_sizes);
+        image.data[AnimAssetVerifier::HEADER_SIZE + 1] ^= 0x01;
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(verifier.checkIndex(image.checksum, image.assets));
+        HOST_CHECK(host_assets_scan(verifier, UINT32_MAX) == AnimAssetVerifier::State::Corrupt);
+    }
+    {
+        // A read error in the middle of the scan
+        auto image = host_assets_create_image(host_assets_sizes);
+        image.fail_read_offset = image.data_start + 4000;
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(verifier.checkIndex(image.checksum, image.assets));
+        HOST_CHECK(host_assets_scan(verifier, 512) == AnimAssetVerifier::State::Corrupt);
+    }
+
+    return true;
+}
+
+/* Errors found synchronously by the index check */
+static bool host_assets_check_corrupted_index()
+{
+    {
+        auto image = host_assets_create_image(host_assets_sizes);
+        image.data[image.data_start + image.assets[2].offset] = 0x00;
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(!verifier.checkIndex(image.checksum, image.assets));
+        HOST_CHECK(verifier.getState() == AnimAssetVerifier::State::Unchecked);
+        HOST_CHECK(verifier.scan(UINT32_MAX) == AnimAssetVerifier::State::Unchecked);
+        verifier.markVerified();
+        HOST_CHECK(verifier.getState() == AnimAssetVerifier::State::Unchecked);
+    }
+    {
+        auto image = host_assets_create_image(host_assets_sizes);
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(!verifier.checkIndex(image.checksum ^ 0x1, image.assets));
+        auto missing = image.assets;
+        missing.pop_back();
+        HOST_CHECK(!verifier.checkIndex(image.checksum, missing));
+        auto gap = image.assets;
+        gap[1].size++;
+        HOST_CHECK(!verifier.checkIndex(image.checksum, gap));
+    }
+    {
+        // Length in the header larger than the partition
+        auto image = host_assets_create_image(host_assets_sizes);
+        host_assets_put_u32(image.data, 8, HOST_ASSETS_PARTITION_SIZE);
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(!verifier.checkIndex(image.checksum, image.assets));
+    }
+    {
+        // Erased partition
+        auto image = host_assets_create_image(host_assets_sizes);
+        std::fill(image.data.begin(), image.data.end(), 0xFF);
+        AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+        HOST_CHECK(!verifier.checkIndex(image.checksum, image.assets));
+    }
+
+    return true;
+}
+
+/* An image verified on a previous boot is not read again */
+static bool host_assets_check_cached()
+{
+    auto image = host_assets_create_image(host_assets_sizes);
+    AnimAssetVerifier verifier(image.getReadFunction(), image.data.size());
+    HOST_CHECK(verifier.checkIndex(image.checksum, image.assets));
+    int reads = image.reads;
+    verifier.markVerified();
+    HOST_CHECK(verifier.getState() == AnimAssetVerifier::State::Verified);
+    HOST_CHECK(verifier.scan(UINT32_MAX) == AnimAssetVerifier::State::Verified);
+    HOST_CHECK(image.reads == reads);
+
+    return true;
+}
+
+// Check the deferred verification of the animation assets with synthetic partition images, valid and corrupted
+HOST_CHECK_REGISTER(
+    assets, "Assets",
+    {"valid", host_assets_check_valid},
+    {"corrupted_data", host_assets_check_corrupted_data},
+    {"corrupted_index", host_assets_check_corrupted_index},
+    {"cached", host_assets_check_cached}
+);
@@ -0,0 +1,204 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <stdexcept>
+#include "esp_log.h"
+#include "esp_brookesia.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::services::Boot;
+
+static const char *TAG = "host_boot";
+
+/* Stage which sleeps for `ms` and counts how many stages run at the same time */
+static Boot::StageConfig host_boot_stage(
+    const char *name, std::vector<std::string> depends, uint32_t ms, std::atomic<int> *running = nullptr,
+    std::atomic<int> *max_running = nullptr, bool is_ok = true
+)
+{
+    return Boot::StageConfig{
+        .name = name,
+        .depends = std::move(depends),
+        .function = [ms, running, max_running, is_ok]() {
+            if (running != nullptr) {
+                int now = ++(*running);
+                int max = max_running->load();
+                while ((now > max) && !max_running->compare_exchange_weak(max, now)) {
+                }
+            }
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(ms));
+            if (running != nullptr) {
+                (*running)--;
+            }
+            return is_ok;
+        },
+    };
+}
+
+static std::map<std::string, Boot::StageRecord> host_boot_get_records(const Boot &boot)
+{
+    std::map<std::string, Boot::StageRecord> records;
+    for (auto &record : boot.getTimeline()) {
+        records[record.name] = record;
+    }
+    return records;
+}
+
+/* Stages added before their dependencies, `a -> b -> d` and `c -> d`, with `c` longer than `a` and `b` together */
+static bool host_boot_check_ordering()
+{
+    Boot boot;
+    HOST_CHECK(boot.addStage(host_boot_stage("d", {"b", "c"}, 10)));
+    HOST_CHECK(boot.addStage(host_boot_stage("b", {"a"}, 20)));
+    HOST_CHECK(boot.addStage(host_boot_stage("a", {}, 30)));
+    HOST_CHECK(boot.addStage(host_boot_stage("c", {}, 100)));
+    HOST_CHECK(!boot.addStage(host_boot_stage("a", {}, 0)));
+    HOST_CHECK(boot.checkGraph());
+    HOST_CHECK(boot.run());
+    HOST_CHECK(!boot.run());
+    HOST_CHECK(!boot.addStage(host_boot_stage("e", {}, 0)));
+
+    auto records = host_boot_get_records(boot);
+    for (auto &[name, record] : records) {
+        HOST_CHECK(record.state == Boot::StageState::Done);
+        HOST_CHECK(record.start_us >= record.ready_us);
+        HOST_CHECK(record.end_us > record.start_us);
+    }
+    HOST_CHECK(records["b"].start_us >= records["a"].end_us);
+    HOST_CHECK(records["d"].start_us >= records["b"].end_us);
+    HOST_CHECK(records["d"].start_us >= records["c"].end_us);
+    // `a` and `c` have no dependency, they run at the same time
+    HOST_CHECK(records["c"].start_us < records["a"].end_us);
+    HOST_CHECK(records["a"].start_us < records["c"].end_us);
+
+    uint32_t duration_us = 0;
+    auto critical_path = boot.getCriticalPath(&duration_us);
+    HOST_CHECK((critical_path == std::vector<std::string> {"c", "d"}));
+    HOST_CHECK(duration_us == records["d"].end_us);
+    // Shorter than the 160 ms of the stages one after another
+    HOST_CHECK(duration_us < 150 * 1000);
+
+    return true;
+}
+
+static bool host_boot_check_deadlock()
+{
+    std::atomic<int> running = 0;
+    std::atomic<int> max_running = 0;
+    {
+        Boot boot;
+        HOST_CHECK(boot.addStage(host_boot_stage("init", {}, 1, &running, &max_running)));
+        HOST_CHECK(boot.addStage(host_boot_stage("x", {"init", "z"}, 1, &running, &max_running)));
+        HOST_CHECK(boot.addStage(host_boot_stage("y", {"x"}, 1, &running, &max_running)));
+        HOST_CHECK(boot.addStage(host_boot_stage("z", {"y"}, 1, &running, &max_running)));
+
+        std::vector<std::string> cycle;
+        HOST_CHECK(!boot.checkGraph(&cycle));
+        HOST_CHECK(cycle.size() == 4);
+        HOST_CHECK(cycle.front() == cycle.back());
+        for (auto name : {"x", "y", "z"}) {
+            HOST_CHECK(std::find(cycle.begin(), cycle.end(), name) != cycle.end());
+        }
+        // Nothing runs, not even the stages outside of the cycle
+        HOST_CHECK(!boot.run());
+        for (auto &record : boot.getTimeline()) {
+            HOST_CHECK(record.state == Boot::StageState::Pending);
+        }
+    }
+    {
+        Boot boot;
+        HOST_CHECK(boot.addStage(host_boot_stage("self", {"self"}, 1, &running, &max_running)));
+        std::vector<std::string> cycle;
+        HOST_CHECK(!boot.checkGraph(&cycle));
+        HOST_CHECK((cycle == std::vector<std::string> {"self", "self"}));
+    }
+    {
+        Boot boot;
+        HOST_CHECK(boot.addStage(host_boot_stage("orphan", {"missing"}, 1, &running, &max_running)));
+        std::vector<std::string> cycle;
+        HOST_CHECK(!boot.checkGraph(&cycle));
+        HOST_CHECK(cycle.empty());
+        HOST_CHECK(!boot.run());
+    }
+    HOST_CHECK(max_running == 0);
+
+    return true;
+}
+
+static bool host_boot_check_failure()
+{
+    {
+        Boot boot;
+        auto optional = host_boot_stage("optional", {}, 5, nullptr, nullptr, false);
+        optional.is_optional = true;
+        HOST_CHECK(boot.addStage(std::move(optional)));
+        HOST_CHECK(boot.addStage(host_boot_stage("after_optional", {"optional"}, 5)));
+        HOST_CHECK(boot.run());
+        auto records = host_boot_get_records(boot);
+        HOST_CHECK(records["optional"].state == Boot::StageState::Failed);
+        HOST_CHECK(records["after_optional"].state == Boot::StageState::Done);
+    }
+    {
+        Boot boot;
+        HOST_CHECK(boot.addStage(host_boot_stage("broken", {}, 5, nullptr, nullptr, false)));
+        HOST_CHECK(boot.addStage(host_boot_stage("child", {"broken"}, 5)));
+        HOST_CHECK(boot.addStage(host_boot_stage("grandchild", {"child"}, 5)));
+        HOST_CHECK(boot.addStage(host_boot_stage("slow", {}, 50)));
+        HOST_CHECK(boot.addStage(host_boot_stage("after_slow", {"slow"}, 5)));
+        Boot::StageConfig throwing = host_boot_stage("throwing", {}, 0);
+        throwing.function = []() -> bool {
+            throw std::runtime_error("stage error");
+        };
+        throwing.is_optional = true;
+        HOST_CHECK(boot.addStage(std::move(throwing)));
+        HOST_CHECK(!boot.run());
+        auto records = host_boot_get_records(boot);
+        HOST_CHECK(records["broken"].state == Boot::StageState::Failed);
+        HOST_CHECK(records["child"].state == Boot::StageState::Skipped);
+        HOST_CHECK(records["grandchild"].state == Boot::StageState::Skipped);
+        HOST_CHECK(records["throwing"].state == Boot::StageState::Failed);
+        // The running stage is waited for, but no new stage starts after the failure
+        HOST_CHECK(records["slow"].state == Boot::StageState::Done);
+        HOST_CHECK(records["after_slow"].state == Boot::StageState::Skipped);
+    }
+
+    return true;
+}
+
+static bool host_boot_check_parallel_limit()
+{
+    std::atomic<int> running = 0;
+    std::atomic<int> max_running = 0;
+    Boot boot;
+    const char *names[] = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7", "p8"};
+    for (auto name : names) {
+        HOST_CHECK(boot.addStage(host_boot_stage(name, {}, 20, &running, &max_running)));
+    }
+    HOST_CHECK(boot.run());
+    HOST_CHECK(max_running > 1);
+    HOST_CHECK(max_running <= ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES);
+    bool is_delayed = false;
+    for (auto &record : boot.getTimeline()) {
+        HOST_CHECK(record.state == Boot::StageState::Done);
+        is_delayed |= (record.start_us > record.ready_us + 10 * 1000);
+    }
+    // More stages than the limit, some waited for a free slot after being ready
+    HOST_CHECK(is_delayed == (sizeof(names) / sizeof(names[0]) > ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES));
+
+    return true;
+}
+
+// Check the boot orchestrator with synthetic stages: ordering, parallel stages, deadlock detection, failures and
+// critical path
+HOST_CHECK_REGISTER(
+    boot, "Boot",
+    {"ordering", host_boot_check_ordering},
+    {"deadlock", host_boot_check_deadlock},
+    {"failure", host_boot_check_failure},
+    {"parallel_limit", host_boot_check_parallel_limit}
+);
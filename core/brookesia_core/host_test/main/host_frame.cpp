@@ -0,0 +1,226 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <vector>
+#include "esp_log.h"
+#include "lvgl/esp_brookesia_lv_frame_governor.hpp"
+#include "host_device.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::gui::LvFrameGovernor;
+
+#define HOST_FRAME_WIDTH            (240)
+#define HOST_FRAME_HEIGHT           (240)
+#define HOST_FRAME_WARMUP_MS        (200)
+#define HOST_FRAME_RUN_MS           (2000)
+#define HOST_FRAME_VSYNC_PERIOD_MS  (20)
+
+static const char *TAG = "host_frame";
+
+/* Redraw an object on every call of the LVGL handler, like an animation with no pacing of its own */
+static lv_timer_t *host_frame_create_animator(lv_obj_t *obj)
+{
+    return lv_timer_create([](lv_timer_t *t) {
+        lv_obj_invalidate(static_cast<lv_obj_t *>(lv_timer_get_user_data(t)));
+    }, 0, obj);
+}
+
+static bool host_frame_begin(HostDevice &device, lv_obj_t *&obj)
+{
+    HOST_CHECK(device.begin(HOST_FRAME_WIDTH, HOST_FRAME_HEIGHT));
+    HOST_CHECK(LvFrameGovernor::getInstance().begin(device.getDisplay(), LvFrameGovernor::Config{}));
+    obj = lv_obj_create(lv_screen_active());
+    HOST_CHECK(obj != nullptr);
+    device.run(HOST_FRAME_WARMUP_MS);
+
+    return true;
+}
+
+static void host_frame_end(HostDevice &device)
+{
+    LvFrameGovernor::getInstance().del();
+    device.del();
+}
+
+static void host_frame_reset(HostDevice &device)
+{
+    device.resetStats();
+    LvFrameGovernor::getInstance().resetStatistics();
+}
+
+/* The frame rate of a screen always redrawn is the highest cap of the scenes entered */
+static bool host_frame_check_caps()
+{
+    using Scene = LvFrameGovernor::Scene;
+    struct Case {
+        const char *name;
+        std::vector<Scene> scenes;
+        int fps;
+    };
+    const LvFrameGovernor::Config config = {};
+    const Case cases[] = {
+        {"default", {}, config.default_fps},
+        {"gesture", {Scene::Gesture}, config.scene_fps[static_cast<int>(Scene::Gesture)]},
+        {"clock", {Scene::Clock}, config.scene_fps[static_cast<int>(Scene::Clock)]},
+        {"clock_and_gesture", {Scene::Clock, Scene::Gesture}, config.scene_fps[static_cast<int>(Scene::Gesture)]},
+    };
+
+    HostDevice device;
+    lv_obj_t *obj = nullptr;
+    HOST_CHECK(host_frame_begin(device, obj));
+    auto &governor = LvFrameGovernor::getInstance();
+    auto animator = host_frame_create_animator(obj);
+    HOST_CHECK(animator != nullptr);
+
+    for (auto &test_case : cases) {
+        for (auto scene : test_case.scenes) {
+            HOST_CHECK(governor.enterScene(scene));
+        }
+        HOST_CHECK(governor.getFrameRateCap() == test_case.fps);
+        device.run(HOST_FRAME_WARMUP_MS);
+        host_frame_reset(device);
+        device.run(HOST_FRAME_RUN_MS);
+        auto statistics = governor.getStatistics();
+        ESP_LOGI(
+            TAG, "Scene(%s): cap %d fps, %.2f fps, idle %d%%", test_case.name, test_case.fps,
+            statistics.getFrameRate(), statistics.idle_percent
+        );
+        // The virtual tick moves by steps, so the frames can only be later than the cap
+        HOST_CHECK(statistics.frames == device.getStats().frames);
+        HOST_CHECK(statistics.getFrameRate() <= test_case.fps);
+        HOST_CHECK(statistics.getFrameRate() >= test_case.fps * 0.8f);
+        HOST_CHECK(statistics.missed_deadlines == 0);
+        for (auto scene : test_case.scenes) {
+            HOST_CHECK(governor.exitScene(scene));
+        }
+    }
+    // Exited as many times as entered
+    HOST_CHECK(!governor.exitScene(Scene::Gesture));
+    lv_timer_delete(animator);
+    host_frame_end(device);
+
+    return true;
+}
+
+/* A static screen is not refreshed at all, a single change is drawn on the next call of the LVGL handler */
+static bool host_frame_check_idle()
+{
+    HostDevice device;
+    lv_obj_t *obj = nullptr;
+    HOST_CHECK(host_frame_begin(device, obj));
+    auto &governor = LvFrameGovernor::getInstance();
+
+    host_frame_reset(device);
+    device.run(HOST_FRAME_RUN_MS);
+    HOST_CHECK(device.getStats().frames == 0);
+    HOST_CHECK(governor.getStatistics().frames == 0);
+
+    lv_obj_invalidate(obj);
+    device.run(HostDevice::STEP_MS);
+    HOST_CHECK(device.getStats().frames == 1);
+    device.run(HOST_FRAME_RUN_MS);
+    HOST_CHECK(device.getStats().frames == 1);
+    HOST_CHECK(governor.getStatistics().missed_deadlines == 0);
+    host_frame_end(device);
+
+    return true;
+}
+
+/* A frame delayed by a busy CPU is counted as missed, the next ones are on time again */
+static bool host_frame_check_missed_deadline()
+{
+    HostDevice device;
+    lv_obj_t *obj = nullptr;
+    HOST_CHECK(host_frame_begin(device, obj));
+    auto &governor = LvFrameGovernor::getInstance();
+    auto animator = host_frame_create_animator(obj);
+    HOST_CHECK(animator != nullptr);
+    HOST_CHECK(governor.enterScene(LvFrameGovernor::Scene::Clock));
+
+    host_frame_reset(device);
+    device.run(HOST_FRAME_RUN_MS);
+    HOST_CHECK(governor.getStatistics().missed_deadlines == 0);
+
+    device.stall(3 * 1000 / governor.getFrameRateCap());
+    device.run(HOST_FRAME_RUN_MS);
+    HOST_CHECK(governor.getStatistics().missed_deadlines == 1);
+
+    HOST_CHECK(governor.exitScene(LvFrameGovernor::Scene::Clock));
+    lv_timer_delete(animator);
+    host_frame_end(device);
+
+    return true;
+}
+
+/* With the vsync reported by the panel, every frame starts on a vsync */
+static bool host_frame_check_vsync()
+{
+    HostDevice device;
+    lv_obj_t *obj = nullptr;
+    HOST_CHECK(host_frame_begin(device, obj));
+    auto &governor = LvFrameGovernor::getInstance();
+    auto animator = host_frame_create_animator(obj);
+    HOST_CHECK(animator != nullptr);
+
+    std::vector<uint32_t> render_ticks;
+    lv_display_add_event_cb(device.getDisplay(), [](lv_event_t *event) {
+        static_cast<std::vector<uint32_t> *>(lv_event_get_user_data(event))->push_back(lv_tick_get());
+    }, LV_EVENT_RENDER_START, &render_ticks);
+
+    // Without vsync, the default cap doesn't fall on the period of the panel
+    host_frame_reset(device);
+    render_ticks.clear();
+    device.run(HOST_FRAME_RUN_MS);
+    // The vsync created now is reported on this phase
+    uint32_t vsync_phase = lv_tick_get() % HOST_FRAME_VSYNC_PERIOD_MS;
+    int aligned_frames = 0;
+    for (auto tick : render_ticks) {
+        aligned_frames += ((tick % HOST_FRAME_VSYNC_PERIOD_MS) == vsync_phase) ? 1 : 0;
+    }
+    float free_frame_rate = governor.getStatistics().getFrameRate();
+    HOST_CHECK(aligned_frames < static_cast<int>(render_ticks.size()));
+
+    auto vsync = lv_timer_create([](lv_timer_t *) {
+        LvFrameGovernor::getInstance().notifyVsync();
+    }, HOST_FRAME_VSYNC_PERIOD_MS, nullptr);
+    HOST_CHECK(vsync != nullptr);
+    device.run(HOST_FRAME_WARMUP_MS);
+    host_frame_reset(device);
+    render_ticks.clear();
+    device.run(HOST_FRAME_RUN_MS);
+    auto statistics = governor.getStatistics();
+    ESP_LOGI(
+        TAG, "Vsync(%dms): %.2f fps without it, %.2f fps aligned", HOST_FRAME_VSYNC_PERIOD_MS, free_frame_rate,
+        statistics.getFrameRate()
+    );
+    HOST_CHECK(!render_ticks.empty());
+    for (auto tick : render_ticks) {
+        HOST_CHECK((tick % HOST_FRAME_VSYNC_PERIOD_MS) == vsync_phase);
+    }
+    HOST_CHECK(statistics.getFrameRate() <= governor.getFrameRateCap());
+    HOST_CHECK(statistics.missed_deadlines == 0);
+
+    // The frames are not held back anymore once the vsync stops
+    lv_timer_delete(vsync);
+    device.run(HOST_FRAME_WARMUP_MS);
+    host_frame_reset(device);
+    device.run(HOST_FRAME_RUN_MS);
+    HOST_CHECK(governor.getStatistics().getFrameRate() > statistics.getFrameRate());
+
+    lv_timer_delete(animator);
+    host_frame_end(device);
+
+    return true;
+}
+
+// Check the frame governor of the display on the virtual LVGL tick: frame rate caps of the scenes, no refresh of a
+// static screen, missed deadlines and refreshes aligned to the vsync
+HOST_CHECK_REGISTER(
+    frame, "Frame",
+    {"caps", host_frame_check_caps},
+    {"idle", host_frame_check_idle},
+    {"missed_deadline", host_frame_check_missed_deadline},
+    {"vsync", host_frame_check_vsync}
+);
@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string_view>
+#include "esp_log.h"
+#include "lvgl.h"
+#include "esp_brookesia.hpp"
+#include "widgets/keyboard/esp_brookesia_keyboard.hpp"
+#include "stylesheets/360x360/dark/keyboard.hpp"
+#include "host_device.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::gui::LvObject;
+using esp_brookesia::gui::StyleColor;
+using esp_brookesia::gui::toLvColor;
+using esp_brookesia::speaker::Keyboard;
+using esp_brookesia::speaker::KeyboardData;
+
+// Same screen and stylesheet as the speaker
+#define HOST_KEYBOARD_WIDTH     (360)
+#define HOST_KEYBOARD_HEIGHT    (360)
+#define HOST_KEYBOARD_REDRAWS   (200)
+
+static const char *TAG = "host_keyboard";
+
+// Keys drawn with the special colors, the other ones use the normal colors
+static const std::string_view keyboard_special_str[] = {
+    LV_SYMBOL_BACKSPACE, LV_SYMBOL_LEFT, LV_SYMBOL_RIGHT, "Space", "ABC", "abc", "123", ",.?!",
+};
+
+struct HostKeyboard {
+    HostDevice device;
+    KeyboardData data = esp_brookesia::speaker::ESP_BROOKESIA_SPEAKER_360_360_DARK_KEYBOARD_DATA;
+    std::unique_ptr<ESP_Brookesia_Phone> phone;
+    std::unique_ptr<LvObject> screen;
+    std::unique_ptr<Keyboard> keyboard;
+    bool is_ok_enabled = true;
+    // Key fills checked against the stylesheet and their mismatches, counted by the draw task signal while set
+    bool is_checking = false;
+    uint32_t fills = 0;
+    uint32_t ok_fills = 0;
+    uint32_t wrong_fills = 0;
+
+    bool begin()
+    {
+        if (!device.begin(HOST_KEYBOARD_WIDTH, HOST_KEYBOARD_HEIGHT)) {
+            return false;
+        }
+        phone = std::make_unique<ESP_Brookesia_Phone>(device.getDisplay());
+        if (!phone->begin() ||
+                !Keyboard::calibrateData(phone->getCoreData().screen_size, phone->getCoreDisplay(), data)) {
+            return false;
+        }
+        screen = std::make_unique<LvObject>(lv_obj_create(nullptr));
+        lv_screen_load(screen->getNativeHandle());
+        keyboard = std::make_unique<Keyboard>(*phone, data);
+        if (!keyboard->begin(screen.get())) {
+            return false;
+        }
+        keyboard->on_keyboard_draw_task_signal.connect([this](lv_event_t *e) {
+            if (is_checking) {
+                checkFill(e);
+            }
+        });
+
+        return true;
+    }
+
+    void del()
+    {
+        keyboard.reset();
+        screen.reset();
+        phone.reset();
+        device.del();
+    }
+
+    // The button matrix is the only child of the main object of the keyboard
+    lv_obj_t *getButtonMatrix() const
+    {
+        return lv_obj_get_child(lv_obj_get_child(screen->getNativeHandle(), 0), 0);
+    }
+
+    void redraw()
+    {
+        lv_obj_invalidate(screen->getNativeHandle());
+        lv_refr_now(device.getDisplay());
+    }
+
+    void checkFill(lv_event_t *e)
+    {
+        lv_draw_task_t *draw_task = lv_event_get_draw_task(e);
+        lv_draw_fill_dsc_t *fill_dsc = lv_draw_task_get_fill_dsc(draw_task);
+        if (fill_dsc == nullptr) {
+            return;
+        }
+
+        // Classify the key from its text, as the draw task hook did before the types were cached
+        auto button_matrix = static_cast<lv_obj_t *>(lv_event_get_current_target(e));
+        const char *text = lv_buttonmatrix_get_button_text(button_matrix, fill_dsc->base.id1);
+        std::string_view key = (text != nullptr) ? text : "";
+        const StyleColor *expected = &data.keyboard.normal_button_inactive_background_color;
+        if (key == LV_SYMBOL_OK) {
+            expected = is_ok_enabled ? &data.keyboard.ok_button_enabled_background_color :
+                       &data.keyboard.ok_button_disabled_background_color;
+            ok_fills++;
+        } else if (std::find(std::begin(keyboard_special_str), std::end(keyboard_special_str), key) !=
+                   std::end(keyboard_special_str)) {
+            expected = &data.keyboard.special_button_inactive_background_color;
+        }
+
+        fills++;
+        if (!lv_color_eq(fill_dsc->color, toLvColor(expected->color)) || (fill_dsc->opa != expected->opacity)) {
+            ESP_LOGE(TAG, "Key(%d, %s) filled with 0x%06x", static_cast<int>(fill_dsc->base.id1), text,
+                     static_cast<unsigned>(lv_color_to_u32(fill_dsc->color) & 0xFFFFFF));
+            wrong_fills++;
+        }
+    }
+
+    bool checkRedraw()
+    {
+        fills = 0;
+        ok_fills = 0;
+        wrong_fills = 0;
+        is_checking = true;
+        redraw();
+        is_checking = false;
+
+        return (fills > 0) && (ok_fills == 1) && (wrong_fills == 0);
+    }
+};
+
+static bool host_keyboard_check_key_styles()
+{
+    HostKeyboard keyboard;
+    bool is_ok = keyboard.begin();
+    if (is_ok) {
+        // Each map has its own key indexes, the OK key moves from one to the other
+        is_ok &= keyboard.checkRedraw();
+        is_ok &= keyboard.keyboard->setMode(LV_KEYBOARD_MODE_NUMBER);
+        is_ok &= keyboard.checkRedraw();
+        is_ok &= keyboard.keyboard->setMode(LV_KEYBOARD_MODE_SPECIAL);
+        is_ok &= keyboard.checkRedraw();
+        // The cached styles follow the OK key being disabled and enabled again
+        keyboard.is_ok_enabled = false;
+        is_ok &= keyboard.keyboard->setOkEnabled(false);
+        is_ok &= keyboard.checkRedraw();
+        is_ok &= keyboard.keyboard->setMode(LV_KEYBOARD_MODE_TEXT_LOWER);
+        is_ok &= keyboard.checkRedraw();
+        keyboard.is_ok_enabled = true;
+        is_ok &= keyboard.keyboard->setOkEnabled(true);
+        is_ok &= keyboard.checkRedraw();
+    }
+    keyboard.del();
+    HOST_CHECK(is_ok);
+
+    return true;
+}
+
+static bool host_keyboard_check_redraw_time()
+{
+    using Clock = std::chrono::steady_clock;
+
+    HostKeyboard keyboard;
+    bool is_ok = keyboard.begin();
+    float hooked_us = 0;
+    float plain_us = 0;
+    if (is_ok) {
+        auto bench = [&keyboard]() {
+            keyboard.redraw();
+            auto start = Clock::now();
+            for (int i = 0; i < HOST_KEYBOARD_REDRAWS; i++) {
+                keyboard.redraw();
+            }
+            return std::chrono::duration<float, std::micro>(Clock::now() - start).count() / HOST_KEYBOARD_REDRAWS;
+        };
+        hooked_us = bench();
+        // Without the draw task events, the keys keep the style of the button matrix
+        lv_obj_remove_flag(keyboard.getButtonMatrix(), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+        plain_us = bench();
+    }
+    keyboard.del();
+    HOST_CHECK(is_ok);
+
+    ESP_LOGI(
+        TAG, "Full redraw of the lowercase keyboard: %.1f us with the key styles hook, %.1f us without, the hook "
+        "costs %.1f us", hooked_us, plain_us, hooked_us - plain_us
+    );
+
+    return true;
+}
+
+// Check the key styles the speaker keyboard caches for its draw task hook against the stylesheet, on every map and
+// with the OK key enabled and disabled, and benchmark the cost of the hook on a full redraw of the keyboard
+HOST_CHECK_REGISTER(
+    keyboard, "Keyboard",
+    {"key_styles", host_keyboard_check_key_styles},
+    {"redraw_time", host_keyboard_check_redraw_time}
+);
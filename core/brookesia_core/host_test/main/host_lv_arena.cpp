@@ -0,0 +1,431 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "esp_log.h"
+#include "lvgl.h"
+#include "lvgl/esp_brookesia_lv_arena.hpp"
+#include "lvgl/esp_brookesia_lv_container.hpp"
+#include "host_device.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::gui::LvAnimSharedPtr;
+using esp_brookesia::gui::LvArena;
+using esp_brookesia::gui::LvArenaScope;
+using esp_brookesia::gui::LvContainer;
+using esp_brookesia::gui::LvObject;
+using esp_brookesia::gui::LvObjSharedPtr;
+using esp_brookesia::gui::LvTimerSharedPtr;
+
+#define HOST_LV_ARENA_WIDTH         (240)
+#define HOST_LV_ARENA_HEIGHT        (240)
+// Same screens as the settings app, with a few cell containers of a few cells each
+#define HOST_LV_ARENA_SCREENS       (6)
+#define HOST_LV_ARENA_CONTAINERS    (3)
+#define HOST_LV_ARENA_CELLS         (4)
+#define HOST_LV_ARENA_CYCLES        (20)
+
+static const char *TAG = "host_lv_arena";
+
+/* The global allocations and frees of the C++ code are counted while they are set, the LVGL ones go through
+ * `lv_malloc()` and are the same with and without the arena */
+static std::atomic<bool> is_counting_news = false;
+static std::atomic<bool> is_counting_deletes = false;
+static std::atomic<uint32_t> news = 0;
+static std::atomic<uint32_t> deletes = 0;
+
+void *operator new (size_t size)
+{
+    if (is_counting_news) {
+        news++;
+    }
+    void *p = malloc((size > 0) ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete (void *p) noexcept
+{
+    if (is_counting_deletes && (p != nullptr)) {
+        deletes++;
+    }
+    free(p);
+}
+
+void operator delete (void *p, size_t size) noexcept
+{
+    (void)size;
+    operator delete (p);
+}
+
+/* Same objects as a cell of `SettingsUI_WidgetCell` with an icon, a label on each side and a split line */
+struct HostArenaCell {
+    LvObjSharedPtr main_object;
+    LvObjSharedPtr left_area_object;
+    LvObjSharedPtr left_icon_object;
+    LvObjSharedPtr left_icon_image;
+    LvObjSharedPtr left_label_object;
+    LvObjSharedPtr left_main_label;
+    LvObjSharedPtr right_area_object;
+    LvObjSharedPtr right_label_object;
+    LvObjSharedPtr right_main_label;
+    LvObjSharedPtr split_line;
+};
+
+struct HostArenaCellContainer {
+    LvObjSharedPtr main_object;
+    LvObjSharedPtr title_label;
+    LvObjSharedPtr container_object;
+    std::vector<std::unique_ptr<HostArenaCell>> cells;
+};
+
+/* Same objects as `SettingsUI_ScreenBase`, the header and the content object, then the map of its cell containers */
+struct HostArenaScreen {
+    lv_obj_t *screen_object;
+    std::array<LvObjSharedPtr, 7> objects;
+    std::map<int, std::unique_ptr<HostArenaCellContainer>> cell_containers_map;
+};
+
+static void host_lv_arena_build(HostArenaScreen &screen)
+{
+    auto &objects = screen.objects;
+    objects[0] = ESP_BROOKESIA_LV_OBJ(obj, screen.screen_object);
+    objects[1] = ESP_BROOKESIA_LV_OBJ(label, objects[0].get());
+    objects[2] = ESP_BROOKESIA_LV_OBJ(obj, objects[0].get());
+    objects[3] = ESP_BROOKESIA_LV_OBJ(obj, objects[2].get());
+    objects[4] = ESP_BROOKESIA_LV_OBJ(image, objects[3].get());
+    objects[5] = ESP_BROOKESIA_LV_OBJ(label, objects[2].get());
+    objects[6] = ESP_BROOKESIA_LV_OBJ(obj, screen.screen_object);
+
+    for (int i = 0; i < HOST_LV_ARENA_CONTAINERS; i++) {
+        auto container = std::make_unique<HostArenaCellContainer>();
+        container->main_object = ESP_BROOKESIA_LV_OBJ(obj, objects[6].get());
+        container->title_label = ESP_BROOKESIA_LV_OBJ(label, container->main_object.get());
+        container->container_object = ESP_BROOKESIA_LV_OBJ(obj, container->main_object.get());
+        for (int j = 0; j < HOST_LV_ARENA_CELLS; j++) {
+            auto cell = std::make_unique<HostArenaCell>();
+            cell->main_object = ESP_BROOKESIA_LV_OBJ(obj, container->container_object.get());
+            cell->left_area_object = ESP_BROOKESIA_LV_OBJ(obj, cell->main_object.get());
+            cell->left_icon_object = ESP_BROOKESIA_LV_OBJ(obj, cell->left_area_object.get());
+            cell->left_icon_image = ESP_BROOKESIA_LV_OBJ(image, cell->left_icon_object.get());
+            cell->left_label_object = ESP_BROOKESIA_LV_OBJ(obj, cell->left_area_object.get());
+            cell->left_main_label = ESP_BROOKESIA_LV_OBJ(label, cell->left_label_object.get());
+            cell->right_area_object = ESP_BROOKESIA_LV_OBJ(obj, cell->main_object.get());
+            cell->right_label_object = ESP_BROOKESIA_LV_OBJ(obj, cell->right_area_object.get());
+            cell->right_main_label = ESP_BROOKESIA_LV_OBJ(label, cell->right_label_object.get());
+            cell->split_line = ESP_BROOKESIA_LV_OBJ(line, cell->main_object.get());
+            container->cells.push_back(std::move(cell));
+        }
+        screen.cell_containers_map[i] = std::move(container);
+    }
+}
+
+/* Same order as `SettingsUI_ScreenBase::del()` */
+static void host_lv_arena_release(HostArenaScreen &screen)
+{
+    for (auto &object : screen.objects) {
+        object.reset();
+    }
+    screen.cell_containers_map.clear();
+}
+
+static uint32_t host_lv_arena_count_children(lv_obj_t *obj)
+{
+    uint32_t count = lv_obj_get_child_count(obj);
+    uint32_t total = count;
+    for (uint32_t i = 0; i < count; i++) {
+        total += host_lv_arena_count_children(lv_obj_get_child(obj, i));
+    }
+
+    return total;
+}
+
+static bool host_lv_arena_check_scopes()
+{
+    LvArena outer;
+    LvArena inner;
+
+    HOST_CHECK(LvArena::getCurrent() == nullptr);
+    {
+        LvArenaScope outer_scope(outer);
+        HOST_CHECK(LvArena::getCurrent() == &outer);
+        {
+            LvArenaScope inner_scope(inner);
+            HOST_CHECK(LvArena::getCurrent() == &inner);
+        }
+        HOST_CHECK(LvArena::getCurrent() == &outer);
+
+        // Each thread has its own scopes
+        LvArena *thread_arena = &outer;
+        std::thread([&thread_arena]() {
+            thread_arena = LvArena::getCurrent();
+        }).join();
+        HOST_CHECK(thread_arena == nullptr);
+    }
+    HOST_CHECK(LvArena::getCurrent() == nullptr);
+
+    return true;
+}
+
+static bool host_lv_arena_check_pointers()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_LV_ARENA_WIDTH, HOST_LV_ARENA_HEIGHT));
+    lv_obj_t *screen = lv_screen_active();
+
+    bool is_ok = [&]() {
+        LvArena arena;
+
+        // Out of a scope, the pointers are the usual ones
+        LvObjSharedPtr heap_object = ESP_BROOKESIA_LV_OBJ(obj, screen);
+        HOST_CHECK((heap_object != nullptr) && (arena.getStatistics().pointers == 0));
+
+        LvObjSharedPtr object;
+        LvObjSharedPtr child;
+        LvTimerSharedPtr timer;
+        LvAnimSharedPtr anim;
+        {
+            LvArenaScope scope(arena);
+            object = ESP_BROOKESIA_LV_OBJ(obj, screen);
+            child = ESP_BROOKESIA_LV_OBJ(label, object.get());
+            timer = ESP_BROOKESIA_LV_TIMER([](lv_timer_t *) {}, 1000, nullptr);
+            anim = ESP_BROOKESIA_LV_ANIM();
+            HOST_CHECK((object != nullptr) && (child != nullptr) && (timer != nullptr) && (anim != nullptr));
+            HOST_CHECK(esp_brookesia::gui::makeLvObjPtr(nullptr) == nullptr);
+        }
+        LvArena::Statistics stats = arena.getStatistics();
+        HOST_CHECK((stats.pointers == 4) && (stats.live_pointers == 4) && (stats.objects == 2));
+        HOST_CHECK((stats.chunks == 1) && (stats.used_bytes <= stats.chunk_bytes));
+
+        // Copies share the control block of the arena
+        LvObjSharedPtr copy = object;
+        HOST_CHECK(arena.getStatistics().pointers == 4);
+
+        // A pointer released before the arena closes deletes its object as usual
+        copy.reset();
+        HOST_CHECK(lv_obj_is_valid(object.get()));
+        lv_obj_t *child_obj = child.get();
+        child.reset();
+        HOST_CHECK(!lv_obj_is_valid(child_obj) && (lv_obj_get_child_count(object.get()) == 0));
+        timer.reset();
+        anim.reset();
+        stats = arena.getStatistics();
+        HOST_CHECK((stats.live_pointers == 1) && (stats.objects == 1));
+
+        // The heap pointer is not touched by the arena
+        lv_obj_t *object_obj = object.get();
+        arena.close();
+        HOST_CHECK(!lv_obj_is_valid(object_obj) && lv_obj_is_valid(heap_object.get()));
+        HOST_CHECK(arena.getStatistics().chunks == 0);
+        object.reset();
+
+        return true;
+    }();
+
+    device.del();
+
+    return is_ok;
+}
+
+static bool host_lv_arena_check_close()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_LV_ARENA_WIDTH, HOST_LV_ARENA_HEIGHT));
+
+    bool is_ok = [&]() {
+        auto arena = std::make_unique<LvArena>();
+        HostArenaScreen screen = {};
+        screen.screen_object = lv_screen_active();
+        {
+            LvArenaScope scope(*arena);
+            host_lv_arena_build(screen);
+        }
+        uint32_t object_num = host_lv_arena_count_children(screen.screen_object);
+        HOST_CHECK(arena->getStatistics().objects == object_num);
+
+        // A cell created out of the scope stays on the heap, it goes with its parent of the arena
+        LvObjSharedPtr heap_cell = ESP_BROOKESIA_LV_OBJ(obj, screen.objects[6].get());
+        // An object deleted by LVGL with its parent, not by its pointer, is skipped
+        auto &container = screen.cell_containers_map[0];
+        lv_obj_delete(container->main_object.get());
+
+        // The whole tree goes in one shot, the pointers are still held
+        arena->close();
+        HOST_CHECK(lv_obj_get_child_count(screen.screen_object) == 0);
+        HOST_CHECK(!lv_obj_is_valid(heap_cell.get()));
+
+        // The pointers may be released in any order after that, even after the arena is destroyed
+        LvObjSharedPtr last = screen.cell_containers_map[1]->cells[0]->left_main_label;
+        arena.reset();
+        host_lv_arena_release(screen);
+        heap_cell.reset();
+        last.reset();
+
+        // The arena opens again when it is used again
+        LvArena reused(256);
+        for (int i = 0; i < 3; i++) {
+            {
+                LvArenaScope scope(reused);
+                host_lv_arena_build(screen);
+            }
+            HOST_CHECK(reused.getStatistics().objects == object_num);
+            HOST_CHECK(reused.getStatistics().chunks > 1);
+            reused.close();
+            host_lv_arena_release(screen);
+            HOST_CHECK(lv_obj_get_child_count(screen.screen_object) == 0);
+        }
+
+        return true;
+    }();
+
+    device.del();
+
+    return is_ok;
+}
+
+static bool host_lv_arena_check_wrappers()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_LV_ARENA_WIDTH, HOST_LV_ARENA_HEIGHT));
+
+    bool is_ok = [&]() {
+        LvObject screen(lv_screen_active(), false);
+        LvArena arena;
+
+        auto *container = arena.create<LvContainer>(&screen);
+        HOST_CHECK((container != nullptr) && container->isValid());
+        auto *inner = arena.create<LvContainer>(container);
+        HOST_CHECK((inner != nullptr) && inner->isValid());
+        LvArena::Statistics stats = arena.getStatistics();
+        HOST_CHECK((stats.wrappers == 2) && (stats.objects == 2) && (stats.pointers == 0));
+
+        // Raw memory keeps its alignment, a block larger than the chunks gets one of its own
+        auto *values = static_cast<uint64_t *>(arena.allocate(sizeof(uint64_t) * 3, alignof(uint64_t)));
+        HOST_CHECK((values != nullptr) && (reinterpret_cast<uintptr_t>(values) % alignof(uint64_t) == 0));
+        void *aligned = arena.allocate(10, 64);
+        HOST_CHECK((aligned != nullptr) && (reinterpret_cast<uintptr_t>(aligned) % 64 == 0));
+        HOST_CHECK(arena.allocate(LvArena::CHUNK_SIZE_DEFAULT * 2) != nullptr);
+        HOST_CHECK(arena.getStatistics().chunks == 2);
+        HOST_CHECK(arena.allocate(16, 3) == nullptr);
+
+        // Objects added without a pointer are deleted by `close()` too
+        lv_obj_t *raw = lv_obj_create(screen.getNativeHandle());
+        HOST_CHECK(arena.addObject(raw) && !arena.addObject(nullptr));
+
+        arena.close();
+        HOST_CHECK(lv_obj_get_child_count(screen.getNativeHandle()) == 0);
+
+        return true;
+    }();
+
+    device.del();
+
+    return is_ok;
+}
+
+static bool host_lv_arena_check_benchmark()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_LV_ARENA_WIDTH, HOST_LV_ARENA_HEIGHT));
+
+    using Clock = std::chrono::steady_clock;
+    struct Result {
+        uint32_t open_news;
+        uint32_t close_deletes;
+        uint32_t chunks;
+        float open_us;
+        float close_us;
+    };
+    auto bench = [](LvArena * arena) -> Result {
+        Result result = {};
+        std::vector<HostArenaScreen> screens(HOST_LV_ARENA_SCREENS);
+        for (int cycle = 0; cycle < HOST_LV_ARENA_CYCLES; cycle++) {
+            for (auto &screen : screens) {
+                screen.screen_object = lv_obj_create(nullptr);
+            }
+
+            news = 0;
+            is_counting_news = true;
+            auto start = Clock::now();
+            {
+                std::optional<LvArenaScope> scope;
+                if (arena != nullptr) {
+                    scope.emplace(*arena);
+                }
+                for (auto &screen : screens) {
+                    host_lv_arena_build(screen);
+                }
+            }
+            auto built = Clock::now();
+            is_counting_news = false;
+            result.open_news = news;
+            result.chunks = (arena != nullptr) ? arena->getStatistics().chunks : 0;
+
+            deletes = 0;
+            is_counting_deletes = true;
+            if (arena != nullptr) {
+                arena->close();
+            }
+            for (auto &screen : screens) {
+                host_lv_arena_release(screen);
+            }
+            auto end = Clock::now();
+            is_counting_deletes = false;
+            result.close_deletes = deletes;
+            result.open_us += std::chrono::duration<float, std::micro>(built - start).count() / HOST_LV_ARENA_CYCLES;
+            result.close_us += std::chrono::duration<float, std::micro>(end - built).count() / HOST_LV_ARENA_CYCLES;
+
+            for (auto &screen : screens) {
+                lv_obj_delete(screen.screen_object);
+            }
+        }
+        return result;
+    };
+
+    Result heap = bench(nullptr);
+    LvArena arena;
+    Result arena_result = bench(&arena);
+    uint32_t object_num = HOST_LV_ARENA_SCREENS * (7 + HOST_LV_ARENA_CONTAINERS * (3 + HOST_LV_ARENA_CELLS * 10));
+    ESP_LOGI(
+        TAG, "Settings app of %d objects on the heap: open %d allocations in %.0f us, close %d frees in %.0f us",
+        static_cast<int>(object_num), static_cast<int>(heap.open_news), heap.open_us,
+        static_cast<int>(heap.close_deletes), heap.close_us
+    );
+    ESP_LOGI(
+        TAG, "Settings app of %d objects in the arena: open %d allocations and %d chunks in %.0f us, close %d frees in "
+        "%.0f us", static_cast<int>(object_num), static_cast<int>(arena_result.open_news),
+        static_cast<int>(arena_result.chunks), arena_result.open_us, static_cast<int>(arena_result.close_deletes),
+        arena_result.close_us
+    );
+
+    device.del();
+
+    // Only the allocations of the app itself are left, the control blocks are all in the arena
+    HOST_CHECK(heap.open_news - arena_result.open_news == object_num);
+
+    return true;
+}
+
+// Check the arena of the widget trees, and benchmark the allocations and the open and close time of a synthetic
+// settings app with and without it
+HOST_CHECK_REGISTER(
+    lv_arena, "Widget arena",
+    {"scopes", host_lv_arena_check_scopes},
+    {"pointers", host_lv_arena_check_pointers},
+    {"close", host_lv_arena_check_close},
+    {"wrappers", host_lv_arena_check_wrappers},
+    {"benchmark", host_lv_arena_check_benchmark}
+);
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "esp_log.h"
+#include "esp_brookesia.hpp"
+#include "esp_brookesia_app_squareline_demo.hpp"
+#include "host_check.hpp"
+#include "host_device.hpp"
+#include "host_script.hpp"
+
+// Time given to the phone to draw its home screen after `begin()`
+#define HOST_TEST_BOOT_MS   (1000)
+
+using namespace esp_brookesia::apps;
+
+struct Resolution {
+    int width;
+    int height;
+    const ESP_Brookesia_PhoneStylesheet_t *stylesheet;
+};
+
+static const char *TAG = "host_test";
+
+/* Same resolutions as the `sdkconfig.ci.*` files of the test app, with the stylesheet the test app picks for them */
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_320_240 = ESP_BROOKESIA_PHONE_320_240_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_320_480 = ESP_BROOKESIA_PHONE_320_480_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_480_480 = ESP_BROOKESIA_PHONE_480_480_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_720_1280 = ESP_BROOKESIA_PHONE_720_1280_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_800_480 = ESP_BROOKESIA_PHONE_800_480_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_800_1280 = ESP_BROOKESIA_PHONE_800_1280_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_1024_600 = ESP_BROOKESIA_PHONE_1024_600_DARK_STYLESHEET();
+static const ESP_Brookesia_PhoneStylesheet_t stylesheet_1280_800 = ESP_BROOKESIA_PHONE_1280_800_DARK_STYLESHEET();
+
+static const Resolution resolutions[] = {
+    {240, 240, nullptr},            // sdkconfig.ci.default, the phone calibrates its default stylesheet
+    {320, 240, &stylesheet_320_240},
+    {320, 480, &stylesheet_320_480},
+    {480, 480, &stylesheet_480_480},
+    {720, 1280, &stylesheet_720_1280},
+    {800, 480, &stylesheet_800_480},
+    {800, 1280, &stylesheet_800_1280},
+    {1024, 600, &stylesheet_1024_600},
+    {1280, 800, &stylesheet_1280_800},
+};
+
+static void print_header()
+{
+    printf("resolution,script,ok,frames,flushes,flushed_px,invalidations,lv_heap_peak,app_events,navigate_events,"
+           "data_update_events");
+#if CONFIG_HOST_TEST_REPORT_FRAME_TIME
+    printf(",frame_us_p50,frame_us_p99,frame_us_max");
+#endif
+    printf("\n");
+}
+
+static void print_result(const Resolution &resolution, const HostScriptResult &result)
+{
+    auto &stats = result.device;
+    printf("%dx%d,%s,%d,%u,%u,%llu,%u,%u,%u,%u,%u", resolution.width, resolution.height, result.script.c_str(),
+           result.is_ok ? 1 : 0, (unsigned)stats.frames, (unsigned)stats.flushes,
+           (unsigned long long)stats.flushed_pixels, (unsigned)stats.invalidations, (unsigned)stats.lv_heap_peak,
+           (unsigned)result.app_events, (unsigned)result.navigate_events, (unsigned)result.data_update_events);
+#if CONFIG_HOST_TEST_REPORT_FRAME_TIME
+    auto frame_us = stats.frame_us;
+    std::sort(frame_us.begin(), frame_us.end());
+    auto percentile = [&frame_us](int p) -> unsigned {
+        return frame_us.empty() ? 0 : frame_us[(frame_us.size() - 1) * p / 100];
+    };
+    printf(",%u,%u,%u", percentile(50), percentile(99), percentile(100));
+#endif
+    printf("\n");
+}
+
+static bool run_resolution(const Resolution &resolution)
+{
+    HostDevice device;
+    if (!device.begin(resolution.width, resolution.height)) {
+        ESP_LOGE(TAG, "Begin device(%dx%d) failed", resolution.width, resolution.height);
+        return false;
+    }
+
+    bool is_ok = true;
+    {
+        ESP_Brookesia_Phone phone(device.getDisplay());
+        phone.setTouchDevice(device.getTouch());
+        if (resolution.stylesheet != nullptr) {
+            is_ok &= phone.addStylesheet(resolution.stylesheet);
+            is_ok &= phone.activateStylesheet(resolution.stylesheet);
+        }
+
+        // The boot is reported as a script of its own, from `begin()` to the home screen drawn
+        device.resetStats();
+        is_ok &= phone.begin();
+        int app_id = phone.installApp(SquarelineDemo::requestInstance(true, true));
+        is_ok &= phone.checkAppID_Valid(app_id);
+        device.run(HOST_TEST_BOOT_MS);
+        HostScriptResult boot = {
+            .script = "boot",
+            .device = device.getStats(),
+            .app_events = 0,
+            .navigate_events = 0,
+            .data_update_events = 0,
+            .is_ok = is_ok,
+        };
+        print_result(resolution, boot);
+
+        if (is_ok) {
+            for (auto &script : host_script_get_all()) {
+                auto result = host_script_replay(script, device, phone, app_id);
+                print_result(resolution, result);
+                is_ok &= result.is_ok;
+            }
+            phone.uninstallApp(app_id);
+        }
+    }
+    device.del();
+
+    return is_ok;
+}
+
+extern "C" void app_main(void)
+{
+    int failures = host_check_run_all();
+
+    print_header();
+    for (auto &resolution : resolutions) {
+        if (!run_resolution(resolution)) {
+            ESP_LOGE(TAG, "Resolution(%dx%d) failed", resolution.width, resolution.height);
+            failures++;
+        }
+    }
+
+    ESP_LOGI(TAG, "Finished, %d check(s) or resolution(s) failed", failures);
+    fflush(stdout);
+    exit((failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "esp_log.h"
+#include "utils/esp_brookesia_frozen_registry.hpp"
+#include "host_check.hpp"
+
+#define HOST_REGISTRY_RANDOM_KEYS   (1000)
+#define HOST_REGISTRY_BENCH_LOOKUPS (1000000)
+
+using esp_brookesia::utils::FrozenRegistry;
+using Registry = FrozenRegistry<int>;
+
+static const char *TAG = "host_registry";
+
+/* Keys of the tables of the speaker: emojis and system icons of the AI buddy, AI functions and NVS keys */
+static const std::vector<std::string> emoji_keys = {
+    "neutral", "happy", "laughing", "funny", "sad", "angry", "crying", "loving", "embarrassed", "surprised",
+    "shocked", "thinking", "relaxed", "delicious", "kissy", "confident", "sleepy", "silly", "confused", "curious",
+};
+static const std::vector<std::string> system_icon_keys = {
+    "brightness_down", "brightness_up", "server_connected", "server_connecting", "volume_down", "volume_mute",
+    "volume_up", "wifi_disconnected",
+};
+static const std::vector<std::string> function_keys = {
+    "open_app", "set_volume", "set_brightness", "terminate_chat",
+};
+static const std::vector<std::string> nvs_keys = {
+    "volume", "brightness", "wlan_switch", "wlan_ssid", "wlan_password",
+};
+
+static std::vector<std::string> host_registry_random_keys(size_t num, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> length(1, 24);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::map<std::string, int> unique;
+    std::vector<std::string> keys;
+    while (keys.size() < num) {
+        std::string key(length(rng), ' ');
+        for (auto &c : key) {
+            c = static_cast<char>(letter(rng));
+        }
+        if (unique.emplace(key, 0).second) {
+            keys.push_back(key);
+        }
+    }
+
+    return keys;
+}
+
+// Every key must be found with its handle and value, whether the registry is frozen or not
+static bool host_registry_check_keys(const Registry &registry, const std::vector<std::string> &keys)
+{
+    HOST_CHECK(registry.size() == keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto handle = registry.find(keys[i]);
+        HOST_CHECK(handle == i);
+        HOST_CHECK(registry.getKey(handle) == keys[i]);
+        HOST_CHECK((registry.get(keys[i]) != nullptr) && (*registry.get(keys[i]) == static_cast<int>(i)));
+    }
+
+    return true;
+}
+
+static bool host_registry_check_handles()
+{
+    Registry registry;
+    for (size_t i = 0; i < emoji_keys.size(); i++) {
+        HOST_CHECK(registry.add(emoji_keys[i], i) == i);
+    }
+    HOST_CHECK(!registry.isFrozen());
+    HOST_CHECK(host_registry_check_keys(registry, emoji_keys));
+
+    HOST_CHECK(registry.freeze() && registry.isFrozen());
+    HOST_CHECK(host_registry_check_keys(registry, emoji_keys));
+
+    // Keys looked up from a buffer which is not the one they were added from
+    std::string buffer = "xhappyx";
+    HOST_CHECK(registry.find(std::string_view(buffer).substr(1, 5)) == 1);
+    HOST_CHECK(registry.get(Registry::HANDLE_NONE) == nullptr);
+    HOST_CHECK(registry.get(static_cast<Registry::Handle>(emoji_keys.size())) == nullptr);
+
+    return true;
+}
+
+static bool host_registry_check_unknown_keys()
+{
+    Registry registry;
+    for (size_t i = 0; i < emoji_keys.size(); i++) {
+        registry.add(emoji_keys[i], i);
+    }
+
+    // Unknown keys land on the slot of some key, they must still be rejected by the compare
+    auto unknown_keys = host_registry_random_keys(HOST_REGISTRY_RANDOM_KEYS, 1);
+    unknown_keys.insert(unknown_keys.end(), {"", "Happy", "happy ", "happ", "neutra", "surprise", "winking"});
+    for (int is_frozen = 0; is_frozen < 2; is_frozen++) {
+        if (is_frozen) {
+            HOST_CHECK(registry.freeze());
+        }
+        for (auto &key : unknown_keys) {
+            auto handle = registry.find(key);
+            HOST_CHECK((handle == Registry::HANDLE_NONE) || (registry.getKey(handle) == key));
+            HOST_CHECK((handle == Registry::HANDLE_NONE) == (registry.get(key) == nullptr));
+        }
+    }
+
+    return true;
+}
+
+static bool host_registry_check_thaw()
+{
+    Registry registry;
+    for (size_t i = 0; i < nvs_keys.size(); i++) {
+        registry.add(nvs_keys[i], i);
+    }
+    HOST_CHECK(registry.freeze());
+
+    // Setting the value of a key keeps the registry frozen, a new key thaws it until the next freeze
+    HOST_CHECK(registry.add("volume", 100) == 0);
+    HOST_CHECK(registry.isFrozen() && (*registry.get("volume") == 100));
+    *registry.get("volume") = 0;
+
+    auto keys = nvs_keys;
+    keys.push_back("agent_id");
+    HOST_CHECK(registry.add("agent_id", keys.size() - 1) == keys.size() - 1);
+    HOST_CHECK(!registry.isFrozen());
+    HOST_CHECK(host_registry_check_keys(registry, keys));
+    HOST_CHECK(registry.freeze() && registry.isFrozen());
+    HOST_CHECK(host_registry_check_keys(registry, keys));
+
+    // A cleared registry starts over from the first handle
+    registry.clear();
+    HOST_CHECK(registry.empty() && !registry.isFrozen());
+    HOST_CHECK(registry.find("volume") == Registry::HANDLE_NONE);
+    HOST_CHECK(registry.freeze() && (registry.find("volume") == Registry::HANDLE_NONE));
+    HOST_CHECK(registry.add("brightness", 0) == 0);
+    HOST_CHECK(registry.freeze() && (registry.find("brightness") == 0));
+
+    return true;
+}
+
+static bool host_registry_check_sizes()
+{
+    // Every size up to a few buckets, then many keys, including the keys sharing most of their characters
+    auto random_keys = host_registry_random_keys(HOST_REGISTRY_RANDOM_KEYS, 2);
+    for (size_t i = 0; i < 100; i++) {
+        random_keys.push_back("key_" + std::to_string(i));
+    }
+    for (size_t size = 0; size <= random_keys.size(); size = (size < 16) ? (size + 1) : (size * 2)) {
+        size = std::min(size, random_keys.size());
+        std::vector<std::string> keys(random_keys.begin(), random_keys.begin() + size);
+        Registry registry;
+        for (size_t i = 0; i < keys.size(); i++) {
+            registry.add(keys[i], i);
+        }
+        HOST_CHECK(registry.freeze());
+        HOST_CHECK(host_registry_check_keys(registry, keys));
+        if (size == random_keys.size()) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool host_registry_check_move()
+{
+    Registry registry;
+    for (size_t i = 0; i < function_keys.size(); i++) {
+        registry.add(function_keys[i], i);
+    }
+
+    // The index of a registry moved before its freeze must still see its keys
+    Registry moved(std::move(registry));
+    HOST_CHECK(host_registry_check_keys(moved, function_keys));
+    HOST_CHECK(moved.freeze());
+    Registry assigned;
+    assigned = std::move(moved);
+    HOST_CHECK(assigned.isFrozen());
+    HOST_CHECK(host_registry_check_keys(assigned, function_keys));
+
+    return true;
+}
+
+static bool host_registry_check_bench()
+{
+    struct Table {
+        const char *name;
+        const std::vector<std::string> *keys;
+    };
+    const Table tables[] = {
+        {"emojis", &emoji_keys},
+        {"system icons", &system_icon_keys},
+        {"functions", &function_keys},
+        {"nvs keys", &nvs_keys},
+    };
+
+    using Clock = std::chrono::steady_clock;
+    for (auto &table : tables) {
+        auto &keys = *table.keys;
+        std::map<std::string, int> map;
+        Registry registry;
+        for (size_t i = 0; i < keys.size(); i++) {
+            map[keys[i]] = i;
+            registry.add(keys[i], i);
+        }
+        HOST_CHECK(registry.freeze());
+
+        // The keys come in a random order as separate strings, like the names parsed from the messages of the agent
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+        std::vector<std::string> lookups;
+        for (size_t i = 0; i < 1024; i++) {
+            lookups.push_back(keys[pick(rng)]);
+        }
+
+        long sum_map = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < HOST_REGISTRY_BENCH_LOOKUPS; i++) {
+            sum_map += map.find(lookups[i % lookups.size()])->second;
+        }
+        float map_ns = std::chrono::duration<float>(Clock::now() - start).count() * 1e9f / HOST_REGISTRY_BENCH_LOOKUPS;
+
+        long sum_registry = 0;
+        start = Clock::now();
+        for (int i = 0; i < HOST_REGISTRY_BENCH_LOOKUPS; i++) {
+            sum_registry += *registry.get(lookups[i % lookups.size()]);
+        }
+        float registry_ns =
+            std::chrono::duration<float>(Clock::now() - start).count() * 1e9f / HOST_REGISTRY_BENCH_LOOKUPS;
+
+        HOST_CHECK(sum_map == sum_registry);
+        ESP_LOGI(
+            TAG, "Lookup of %s(%d keys): std::map %.1f ns, frozen registry %.1f ns", table.name,
+            static_cast<int>(keys.size()), map_ns, registry_ns
+        );
+    }
+
+    return true;
+}
+
+// Check the frozen registries of the string-keyed tables, and benchmark their lookups against `std::map` on the keys of
+// the speaker
+HOST_CHECK_REGISTER(
+    registry, "Frozen registry",
+    {"handles", host_registry_check_handles},
+    {"unknown_keys", host_registry_check_unknown_keys},
+    {"thaw", host_registry_check_thaw},
+    {"sizes", host_registry_check_sizes},
+    {"move", host_registry_check_move},
+    {"bench", host_registry_check_bench}
+);
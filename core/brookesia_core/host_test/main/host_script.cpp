@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_log.h"
+#include "host_script.hpp"
+
+// Time between the touch points of a swipe, the period of the touch reads of LVGL
+#define HOST_SCRIPT_SWIPE_STEP_MS   (LV_DEF_REFR_PERIOD)
+// Time given to the animations of the phone after each app and navigation step
+#define HOST_SCRIPT_SETTLE_MS       (600)
+
+static const char *TAG = "host_script";
+
+struct EventCounters {
+    uint32_t app;
+    uint32_t navigate;
+    uint32_t data_update;
+};
+
+HostScriptStep host_script_wait(uint32_t ms)
+{
+    return {HostScriptStep::Type::Wait, 0, 0, ms, ESP_BROOKESIA_CORE_NAVIGATE_TYPE_MAX};
+}
+
+HostScriptStep host_script_start_app()
+{
+    return {HostScriptStep::Type::StartApp, 0, 0, HOST_SCRIPT_SETTLE_MS, ESP_BROOKESIA_CORE_NAVIGATE_TYPE_MAX};
+}
+
+HostScriptStep host_script_stop_app()
+{
+    return {HostScriptStep::Type::StopApp, 0, 0, HOST_SCRIPT_SETTLE_MS, ESP_BROOKESIA_CORE_NAVIGATE_TYPE_MAX};
+}
+
+HostScriptStep host_script_navigate(ESP_Brookesia_CoreNavigateType_t type)
+{
+    return {HostScriptStep::Type::Navigate, 0, 0, HOST_SCRIPT_SETTLE_MS, type};
+}
+
+std::vector<HostScriptStep> host_script_swipe(int x0, int y0, int x1, int y1, uint32_t ms)
+{
+    std::vector<HostScriptStep> steps;
+    int moves = std::max<int>(ms / HOST_SCRIPT_SWIPE_STEP_MS, 1);
+
+    steps.push_back({HostScriptStep::Type::Press, x0, y0, HOST_SCRIPT_SWIPE_STEP_MS, {}});
+    for (int i = 1; i <= moves; i++) {
+        steps.push_back({
+            HostScriptStep::Type::Move, x0 + (x1 - x0) * i / moves, y0 + (y1 - y0) * i / moves,
+            HOST_SCRIPT_SWIPE_STEP_MS, {}
+        });
+    }
+    steps.push_back({HostScriptStep::Type::Release, x1, y1, HOST_SCRIPT_SETTLE_MS, {}});
+
+    return steps;
+}
+
+const std::vector<HostScript> &host_script_get_all()
+{
+    static const std::vector<HostScript> scripts = [] {
+        std::vector<HostScript> scripts;
+
+        HostScript idle = {"idle_home", {host_script_wait(2000)}};
+        scripts.push_back(idle);
+
+        HostScript open_close = {"app_open_close", {}};
+        for (int i = 0; i < 3; i++) {
+            open_close.steps.push_back(host_script_start_app());
+            open_close.steps.push_back(host_script_stop_app());
+        }
+        scripts.push_back(open_close);
+
+        HostScript launcher_swipe = {"launcher_swipe", {}};
+        for (auto &step : host_script_swipe(800, 500, 200, 500, 300)) {
+            launcher_swipe.steps.push_back(step);
+        }
+        for (auto &step : host_script_swipe(200, 500, 800, 500, 300)) {
+            launcher_swipe.steps.push_back(step);
+        }
+        scripts.push_back(launcher_swipe);
+
+        // Swipe up from the bottom edge goes home, from the left edge goes back
+        HostScript gesture_home = {"gesture_home", {host_script_start_app()}};
+        for (auto &step : host_script_swipe(500, 999, 500, 400, 300)) {
+            gesture_home.steps.push_back(step);
+        }
+        scripts.push_back(gesture_home);
+
+        HostScript gesture_back = {"gesture_back", {host_script_start_app()}};
+        for (auto &step : host_script_swipe(0, 500, 600, 500, 300)) {
+            gesture_back.steps.push_back(step);
+        }
+        gesture_back.steps.push_back(host_script_stop_app());
+        scripts.push_back(gesture_back);
+
+        HostScript recents = {"recents_screen", {
+                host_script_start_app(),
+                host_script_navigate(ESP_BROOKESIA_CORE_NAVIGATE_TYPE_RECENTS_SCREEN),
+                host_script_navigate(ESP_BROOKESIA_CORE_NAVIGATE_TYPE_HOME),
+                host_script_stop_app(),
+            }
+        };
+        scripts.push_back(recents);
+
+        return scripts;
+    }();
+
+    return scripts;
+}
+
+static void on_count_event(lv_event_t *event)
+{
+    auto counter = static_cast<uint32_t *>(lv_event_get_user_data(event));
+    (*counter)++;
+}
+
+HostScriptResult host_script_replay(
+    const HostScript &script, HostDevice &device, ESP_Brookesia_Phone &phone, int app_id
+)
+{
+    ESP_LOGI(TAG, "Replay script(%s)", script.name);
+
+    EventCounters counters = {};
+    phone.registerAppEventCallback(on_count_event, &counters.app);
+    phone.registerNavigateEventCallback(on_count_event, &counters.navigate);
+    phone.registerDateUpdateEventCallback(on_count_event, &counters.data_update);
+    device.resetStats();
+
+    bool is_ok = true;
+    for (auto &step : script.steps) {
+        int x = (device.getWidth() - 1) * step.x / 1000;
+        int y = (device.getHeight() - 1) * step.y / 1000;
+        switch (step.type) {
+        case HostScriptStep::Type::Press:
+        case HostScriptStep::Type::Move:
+            device.setTouch(true, x, y);
+            break;
+        case HostScriptStep::Type::Release:
+            device.setTouch(false, x, y);
+            break;
+        case HostScriptStep::Type::StartApp:
+        case HostScriptStep::Type::StopApp: {
+            ESP_Brookesia_CoreAppEventData_t data = {
+                .id = app_id,
+                .type = (step.type == HostScriptStep::Type::StartApp) ? ESP_BROOKESIA_CORE_APP_EVENT_TYPE_START :
+                ESP_BROOKESIA_CORE_APP_EVENT_TYPE_STOP,
+                .data = nullptr,
+            };
+            is_ok &= phone.sendAppEvent(&data);
+            break;
+        }
+        case HostScriptStep::Type::Navigate:
+            is_ok &= phone.sendNavigateEvent(step.navigate);
+            break;
+        default:
+            break;
+        }
+        device.run(step.ms);
+    }
+
+    // Leave the phone on the home screen for the next script
+    if (phone.getCoreManager().getRunningAppById(app_id) != nullptr) {
+        ESP_Brookesia_CoreAppEventData_t data = {
+            .id = app_id,
+            .type = ESP_BROOKESIA_CORE_APP_EVENT_TYPE_STOP,
+            .data = nullptr,
+        };
+        phone.sendAppEvent(&data);
+    }
+
+    HostScriptResult result = {
+        .script = script.name,
+        .device = device.getStats(),
+        .app_events = counters.app,
+        .navigate_events = counters.navigate,
+        .data_update_events = counters.data_update,
+        .is_ok = is_ok,
+    };
+    device.run(HOST_SCRIPT_SETTLE_MS);
+
+    phone.unregisterAppEventCallback(on_count_event, &counters.app);
+    phone.unregisterNavigateEventCallback(on_count_event, &counters.navigate);
+    phone.unregisterDateUpdateEventCallback(on_count_event, &counters.data_update);
+
+    return result;
+}
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "esp_brookesia.hpp"
+#include "host_device.hpp"
+
+/**
+ * @brief One step of a script. The touch points are in thousandths of the screen size, so a script works at every
+ *        resolution.
+ */
+struct HostScriptStep {
+    enum class Type {
+        Wait,
+        Press,
+        Move,
+        Release,
+        StartApp,
+        StopApp,
+        Navigate,
+    };
+
+    Type type;
+    int x;
+    int y;
+    uint32_t ms;
+    ESP_Brookesia_CoreNavigateType_t navigate;
+};
+
+struct HostScript {
+    const char *name;
+    std::vector<HostScriptStep> steps;
+};
+
+/**
+ * @brief Counters of one replay, the host frame times aside they are the same on every run
+ */
+struct HostScriptResult {
+    std::string script;
+    HostDevice::Stats device;
+    uint32_t app_events;
+    uint32_t navigate_events;
+    uint32_t data_update_events;
+    bool is_ok;
+};
+
+/* Step builders */
+HostScriptStep host_script_wait(uint32_t ms);
+HostScriptStep host_script_start_app();
+HostScriptStep host_script_stop_app();
+HostScriptStep host_script_navigate(ESP_Brookesia_CoreNavigateType_t type);
+/* Press at (x0, y0), move to (x1, y1) in `ms`, then release */
+std::vector<HostScriptStep> host_script_swipe(int x0, int y0, int x1, int y1, uint32_t ms);
+
+/**
+ * @brief Scripts replayed at every resolution
+ */
+const std::vector<HostScript> &host_script_get_all();
+
+/**
+ * @brief Replay a script on a phone, the app of the script being `app_id`
+ */
+HostScriptResult host_script_replay(
+    const HostScript &script, HostDevice &device, ESP_Brookesia_Phone &phone, int app_id
+);
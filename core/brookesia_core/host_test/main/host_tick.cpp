@@ -0,0 +1,356 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <memory>
+#include <vector>
+#include "esp_log.h"
+#include "lvgl/esp_brookesia_lv_tick_scheduler.hpp"
+#include "host_device.hpp"
+#include "host_check.hpp"
+
+using esp_brookesia::gui::LvTickScheduler;
+using esp_brookesia::gui::LvTickSubscriber;
+using esp_brookesia::gui::LvTickSubscriberUniquePtr;
+
+#define HOST_TICK_WIDTH         (240)
+#define HOST_TICK_HEIGHT        (240)
+#define HOST_TICK_LAYOUT_MS     (60 * 1000)
+
+static const char *TAG = "host_tick";
+
+/* Callbacks run in the same call of the LVGL handler are counted as one wakeup */
+struct HostTickCounter {
+    uint32_t wakeups;
+    uint32_t last_tick;
+};
+
+struct HostTickClient {
+    HostTickCounter *counter;
+    uint32_t callbacks;
+};
+
+struct HostTickEntry {
+    const char *name;
+    uint32_t period_ms;
+    uint32_t slack_ms;
+};
+
+struct HostTickLayout {
+    const char *name;
+    std::vector<HostTickEntry> entries;
+};
+
+static void host_tick_on_callback(void *user_data)
+{
+    auto client = static_cast<HostTickClient *>(user_data);
+    auto counter = client->counter;
+    client->callbacks++;
+    if ((counter->wakeups == 0) || (counter->last_tick != lv_tick_get())) {
+        counter->wakeups++;
+        counter->last_tick = lv_tick_get();
+    }
+}
+
+static int host_tick_get_timer_num()
+{
+    int num = 0;
+    for (auto timer = lv_timer_get_next(nullptr); timer != nullptr; timer = lv_timer_get_next(timer)) {
+        num++;
+    }
+    return num;
+}
+
+/* Subscribers whose periods divide each other share the wakeups of the shortest one, whenever they subscribed */
+static bool host_tick_check_coalescing()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_TICK_WIDTH, HOST_TICK_HEIGHT));
+
+    int timer_num = host_tick_get_timer_num();
+    HostTickCounter counter = {};
+    HostTickClient clients[3] = {{&counter, 0}, {&counter, 0}, {&counter, 0}};
+    {
+        auto &scheduler = LvTickScheduler::getInstance();
+        LvTickSubscriber fast(host_tick_on_callback, 100, 0, &clients[0]);
+        device.run(35);
+        LvTickSubscriber slow(host_tick_on_callback, 500, 0, &clients[1]);
+        device.run(65);
+        LvTickSubscriber slowest(host_tick_on_callback, 1000, 0, &clients[2]);
+        HOST_CHECK(fast.isValid() && slow.isValid() && slowest.isValid());
+        HOST_CHECK(host_tick_get_timer_num() == timer_num + 1);
+
+        counter = {};
+        for (auto &client : clients) {
+            client.callbacks = 0;
+        }
+        scheduler.resetStatistics();
+        device.run(10 * 1000);
+        auto statistics = scheduler.getStatistics();
+        HOST_CHECK(clients[0].callbacks == 100);
+        HOST_CHECK(clients[1].callbacks == 20);
+        HOST_CHECK(clients[2].callbacks == 10);
+        HOST_CHECK(counter.wakeups == clients[0].callbacks);
+        HOST_CHECK(statistics.wakeups == counter.wakeups);
+        HOST_CHECK(statistics.callbacks == clients[0].callbacks + clients[1].callbacks + clients[2].callbacks);
+        HOST_CHECK(statistics.elapsed_ms == 10 * 1000);
+        HOST_CHECK((statistics.getWakeupsPerSecond() > 9.9f) && (statistics.getWakeupsPerSecond() < 10.2f));
+    }
+    // The timer is deleted with the last subscriber
+    HOST_CHECK(host_tick_get_timer_num() == timer_num);
+    device.del();
+
+    return true;
+}
+
+/* A subscriber due between the wakeups of another one waits for the next of them, if its slack allows it */
+static bool host_tick_check_slack()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_TICK_WIDTH, HOST_TICK_HEIGHT));
+
+    HostTickCounter counter = {};
+    HostTickClient clients[2] = {{&counter, 0}, {&counter, 0}};
+    {
+        auto &scheduler = LvTickScheduler::getInstance();
+        LvTickSubscriber fast(host_tick_on_callback, 30, 0, &clients[0]);
+        LvTickSubscriber tolerant(host_tick_on_callback, 50, 30, &clients[1]);
+        scheduler.resetStatistics();
+        device.run(3000);
+        // Each callback of the tolerant subscriber is at most `period + slack` after the previous one
+        HOST_CHECK(clients[0].callbacks == 100);
+        HOST_CHECK(clients[1].callbacks >= 3000 / 80);
+        HOST_CHECK(counter.wakeups == clients[0].callbacks);
+        HOST_CHECK(scheduler.getStatistics().wakeups == counter.wakeups);
+    }
+    device.del();
+
+    return true;
+}
+
+static bool host_tick_check_pause()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_TICK_WIDTH, HOST_TICK_HEIGHT));
+
+    HostTickCounter counter = {};
+    HostTickClient client = {&counter, 0};
+    {
+        auto &scheduler = LvTickScheduler::getInstance();
+        LvTickSubscriber subscriber(host_tick_on_callback, 100, 0, &client);
+        device.run(1000);
+        HOST_CHECK(client.callbacks == 10);
+
+        // A paused subscriber doesn't wake the timer at all
+        HOST_CHECK(subscriber.pause());
+        scheduler.resetStatistics();
+        device.run(1000);
+        HOST_CHECK(client.callbacks == 10);
+        HOST_CHECK(scheduler.getStatistics().wakeups == 0);
+
+        // The triggered callback runs on the next call of the LVGL handler, then on the grid of the period
+        HOST_CHECK(subscriber.trigger());
+        device.run(HostDevice::STEP_MS);
+        HOST_CHECK(client.callbacks == 11);
+        device.run(1000 - HostDevice::STEP_MS);
+        HOST_CHECK(client.callbacks == 21);
+
+        HOST_CHECK(subscriber.setInterval(250));
+        device.run(1000);
+        HOST_CHECK(client.callbacks == 25);
+    }
+    device.del();
+
+    return true;
+}
+
+static bool host_tick_check_hidden()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_TICK_WIDTH, HOST_TICK_HEIGHT));
+
+    HostTickCounter counter = {};
+    HostTickClient clients[2] = {{&counter, 0}, {&counter, 0}};
+    lv_obj_t *screen = lv_screen_active();
+    lv_obj_t *container = lv_obj_create(screen);
+    lv_obj_t *label = lv_label_create(container);
+    // Like the screen of a paused app, created but not loaded
+    lv_obj_t *other_screen = lv_obj_create(nullptr);
+    lv_obj_t *other_label = lv_label_create(other_screen);
+    {
+        auto &scheduler = LvTickScheduler::getInstance();
+        LvTickSubscriber subscriber(host_tick_on_callback, 100, 0, &clients[0], label);
+        LvTickSubscriber other_subscriber(host_tick_on_callback, 100, 0, &clients[1], other_label);
+        scheduler.resetStatistics();
+        device.run(1000);
+        HOST_CHECK(clients[0].callbacks == 10);
+        HOST_CHECK(clients[1].callbacks == 0);
+        HOST_CHECK(scheduler.getStatistics().skipped_callbacks == 10);
+
+        lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
+        device.run(1000);
+        HOST_CHECK(clients[0].callbacks == 10);
+
+        lv_obj_remove_flag(container, LV_OBJ_FLAG_HIDDEN);
+        lv_screen_load(other_screen);
+        device.run(1000);
+        HOST_CHECK(clients[0].callbacks == 10);
+        HOST_CHECK(clients[1].callbacks == 10);
+        HOST_CHECK(scheduler.getStatistics().skipped_callbacks == 40);
+
+        lv_screen_load(screen);
+        device.run(1000);
+        HOST_CHECK(clients[0].callbacks == 20);
+    }
+    lv_obj_delete(other_screen);
+    device.del();
+
+    return true;
+}
+
+/* A callback may unsubscribe itself or another subscriber, the one due at the same time is then not run */
+static bool host_tick_check_unsubscribe_in_callback()
+{
+    HostDevice device;
+    HOST_CHECK(device.begin(HOST_TICK_WIDTH, HOST_TICK_HEIGHT));
+
+    struct Context {
+        LvTickSubscriberUniquePtr self;
+        LvTickSubscriberUniquePtr other;
+        int self_callbacks;
+        int other_callbacks;
+    } context = {};
+    context.self = std::make_unique<LvTickSubscriber>([](void *user_data) {
+        auto context = static_cast<Context *>(user_data);
+        context->self_callbacks++;
+        context->other = nullptr;
+        context->self = nullptr;
+    }, 100, 0, &context);
+    context.other = std::make_unique<LvTickSubscriber>([](void *user_data) {
+        static_cast<Context *>(user_data)->other_callbacks++;
+    }, 100, 0, &context);
+    int timer_num = host_tick_get_timer_num();
+    device.run(1000);
+    HOST_CHECK(context.self_callbacks == 1);
+    HOST_CHECK(context.other_callbacks == 0);
+    HOST_CHECK((context.self == nullptr) && (context.other == nullptr));
+    HOST_CHECK(host_tick_get_timer_num() == timer_num - 1);
+    device.del();
+
+    return true;
+}
+
+/* One LVGL timer per refresh, created one after the other like the widgets, so their phases differ */
+static bool host_tick_run_layout_legacy(HostDevice &device, const HostTickLayout &layout,
+                                        std::vector<HostTickClient> &clients, HostTickCounter &counter)
+{
+    std::vector<lv_timer_t *> timers;
+    for (size_t i = 0; i < layout.entries.size(); i++) {
+        device.run(HostDevice::STEP_MS * (i + 1));
+        timers.push_back(lv_timer_create([](lv_timer_t *t) {
+            host_tick_on_callback(lv_timer_get_user_data(t));
+        }, layout.entries[i].period_ms, &clients[i]));
+        HOST_CHECK(timers.back() != nullptr);
+    }
+    counter = {};
+    for (auto &client : clients) {
+        client.callbacks = 0;
+    }
+    device.run(HOST_TICK_LAYOUT_MS);
+    for (auto timer : timers) {
+        lv_timer_delete(timer);
+    }
+
+    return true;
+}
+
+static bool host_tick_run_layout_scheduler(HostDevice &device, const HostTickLayout &layout,
+        std::vector<HostTickClient> &clients, HostTickCounter &counter)
+{
+    std::vector<LvTickSubscriberUniquePtr> subscribers;
+    for (size_t i = 0; i < layout.entries.size(); i++) {
+        auto &entry = layout.entries[i];
+        device.run(HostDevice::STEP_MS * (i + 1));
+        subscribers.push_back(
+            std::make_unique<LvTickSubscriber>(host_tick_on_callback, entry.period_ms, entry.slack_ms, &clients[i])
+        );
+        HOST_CHECK(subscribers.back()->isValid());
+    }
+    counter = {};
+    for (auto &client : clients) {
+        client.callbacks = 0;
+    }
+    LvTickScheduler::getInstance().resetStatistics();
+    device.run(HOST_TICK_LAYOUT_MS);
+    HOST_CHECK(LvTickScheduler::getInstance().getStatistics().wakeups == counter.wakeups);
+
+    return true;
+}
+
+/* The periodic refreshes of the default layouts, with the same periods as the widgets and apps */
+static bool host_tick_check_layouts()
+{
+    const HostTickLayout layouts[] = {
+        {
+            "phone", {
+                {"gesture", 20, 0},
+                {"status_bar_clock", 1000, 100},
+            }
+        },
+        {
+            "speaker", {
+                {"gesture", 20, 0},
+                {"quick_settings_clock", 1000, 100},
+                {"timer_app_clock", 1000, 100},
+                {"settings_wlan_scan", 20000, 1000},
+            }
+        },
+        // The gesture polling sets the wakeups of the layouts above, the other refreshes are also compared alone
+        {
+            "speaker_without_gesture", {
+                {"quick_settings_clock", 1000, 100},
+                {"timer_app_clock", 1000, 100},
+                {"settings_wlan_scan", 20000, 1000},
+            }
+        },
+    };
+
+    for (auto &layout : layouts) {
+        HostDevice device;
+        HOST_CHECK(device.begin(HOST_TICK_WIDTH, HOST_TICK_HEIGHT));
+
+        HostTickCounter legacy_counter = {};
+        HostTickCounter scheduler_counter = {};
+        std::vector<HostTickClient> legacy_clients(layout.entries.size(), HostTickClient{&legacy_counter, 0});
+        std::vector<HostTickClient> scheduler_clients(layout.entries.size(), HostTickClient{&scheduler_counter, 0});
+        HOST_CHECK(host_tick_run_layout_legacy(device, layout, legacy_clients, legacy_counter));
+        HOST_CHECK(host_tick_run_layout_scheduler(device, layout, scheduler_clients, scheduler_counter));
+        device.del();
+
+        ESP_LOGI(
+            TAG, "Layout(%s): wakeups/s, %.2f with one timer each, %.2f with the scheduler", layout.name,
+            legacy_counter.wakeups * 1000.0f / HOST_TICK_LAYOUT_MS,
+            scheduler_counter.wakeups * 1000.0f / HOST_TICK_LAYOUT_MS
+        );
+        HOST_CHECK(scheduler_counter.wakeups < legacy_counter.wakeups);
+        // No refresh is lost, the callbacks are only moved
+        for (size_t i = 0; i < layout.entries.size(); i++) {
+            HOST_CHECK(scheduler_clients[i].callbacks + 1 >= legacy_clients[i].callbacks);
+        }
+    }
+
+    return true;
+}
+
+// Check the tick scheduler of the UI on the virtual LVGL tick: shared wakeups, slack, paused and hidden subscribers,
+// and the wakeups of the default phone and speaker layouts compared with one LVGL timer each
+HOST_CHECK_REGISTER(
+    tick, "Tick",
+    {"coalescing", host_tick_check_coalescing},
+    {"slack", host_tick_check_slack},
+    {"pause", host_tick_check_pause},
+    {"hidden", host_tick_check_hidden},
+    {"unsubscribe_in_callback", host_tick_check_unsubscribe_in_callback},
+    {"layouts", host_tick_check_layouts}
+);
@@ -0,0 +1,389 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <map>
+#include "private/esp_brookesia_service_boot_utils.hpp"
+#include "esp_brookesia_service_boot.hpp"
+
+namespace esp_brookesia::services {
+
+static const char *get_state_name(Boot::StageState state)
+{
+    switch (state) {
+    case Boot::StageState::Pending:
+        return "pending";
+    case Boot::StageState::Running:
+        return "running";
+    case Boot::StageState::Done:
+        return "done";
+    case Boot::StageState::Failed:
+        return "failed";
+    case Boot::StageState::Skipped:
+        return "skipped";
+    default:
+        return "unknown";
+    }
+}
+
+bool Boot::addStage(StageConfig config)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(!config.name.empty(), false, "Invalid stage name");
+    ESP_UTILS_CHECK_FALSE_RETURN(config.function != nullptr, false, "Invalid stage(%s) function", config.name.c_str());
+    ESP_UTILS_CHECK_FALSE_RETURN(config.core_id >= -1, false, "Invalid stage(%s) core", config.name.c_str());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_run, false, "Boot already ran");
+    auto it = std::find_if(_stages.begin(), _stages.end(), [&config](const Stage & stage) {
+        return stage.config.name == config.name;
+    });
+    ESP_UTILS_CHECK_FALSE_RETURN(it == _stages.end(), false, "Stage(%s) already exists", config.name.c_str());
+
+    Stage stage = {};
+    stage.record = {
+        .name = config.name,
+        .core_id = config.core_id,
+        .state = StageState::Pending,
+        .ready_us = 0,
+        .start_us = 0,
+        .end_us = 0,
+    };
+    stage.config = std::move(config);
+    _stages.emplace_back(std::move(stage));
+
+    return true;
+}
+
+bool Boot::checkGraph(std::vector<std::string> *cycle) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<std::string, size_t> indexes;
+    for (size_t i = 0; i < _stages.size(); i++) {
+        indexes[_stages[i].config.name] = i;
+    }
+    std::vector<std::vector<size_t>> depends(_stages.size());
+    for (size_t i = 0; i < _stages.size(); i++) {
+        for (auto &name : _stages[i].config.depends) {
+            auto it = indexes.find(name);
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                it != indexes.end(), false, "Stage(%s) depends on unknown stage(%s)", _stages[i].config.name.c_str(),
+                name.c_str()
+            );
+            depends[i].push_back(it->second);
+        }
+    }
+
+    // Depth first search, a dependency found on the current path closes a cycle
+    enum class Mark : uint8_t {
+        None = 0,
+        OnPath,
+        Checked,
+    };
+    std::vector<Mark> marks(_stages.size(), Mark::None);
+    std::vector<size_t> path;
+    std::function<bool(size_t)> visit = [&](size_t index) {
+        marks[index] = Mark::OnPath;
+        path.push_back(index);
+        for (auto depend : depends[index]) {
+            if (marks[depend] == Mark::OnPath) {
+                if (cycle != nullptr) {
+                    cycle->clear();
+                    auto it = std::find(path.begin(), path.end(), depend);
+                    for (; it != path.end(); it++) {
+                        cycle->push_back(_stages[*it].config.name);
+                    }
+                    cycle->push_back(_stages[depend].config.name);
+                }
+                return false;
+            }
+            if ((marks[depend] == Mark::None) && !visit(depend)) {
+                return false;
+            }
+        }
+        path.pop_back();
+        marks[index] = Mark::Checked;
+        return true;
+    };
+    for (size_t i = 0; i < _stages.size(); i++) {
+        if ((marks[i] == Mark::None) && !visit(i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Boot::run()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ESP_UTILS_CHECK_FALSE_RETURN(!_is_run, false, "Boot already ran");
+        _is_run = true;
+    }
+
+    std::vector<std::string> cycle;
+    if (!checkGraph(&cycle)) {
+        if (!cycle.empty()) {
+            std::string cycle_str;
+            for (auto &name : cycle) {
+                cycle_str += (cycle_str.empty() ? "" : " -> ") + name;
+            }
+            ESP_UTILS_LOGE("Stages would wait for each other forever: %s", cycle_str.c_str());
+        }
+        return false;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(resolveDepends(), false, "Resolve depends failed");
+
+    auto begin_time = Clock::now();
+    std::vector<boost::thread> threads;
+    threads.reserve(_stages.size());
+    bool is_failed = false;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            for (size_t i = 0; i < _stages.size(); i++) {
+                auto &stage = _stages[i];
+                if ((stage.record.state == StageState::Failed) && !stage.config.is_optional) {
+                    is_failed = true;
+                }
+            }
+            // Stages are added in any order, so loop until no stage changes, a skipped stage may skip later ones
+            bool is_changed = true;
+            while (is_changed) {
+                is_changed = false;
+                for (size_t i = 0; i < _stages.size(); i++) {
+                    auto &stage = _stages[i];
+                    if (stage.record.state != StageState::Pending) {
+                        continue;
+                    }
+                    if (!stage.is_ready) {
+                        bool is_skipped = false;
+                        if (!isStageReady(stage, is_skipped)) {
+                            continue;
+                        }
+                        auto now_us = getElapsedUs(begin_time);
+                        stage.record.ready_us = now_us;
+                        if (is_skipped) {
+                            stage.record.state = StageState::Skipped;
+                            stage.record.start_us = now_us;
+                            stage.record.end_us = now_us;
+                            is_changed = true;
+                            ESP_UTILS_LOGW("Skip stage(%s), a stage it depends on failed", stage.config.name.c_str());
+                            continue;
+                        }
+                        stage.is_ready = true;
+                    }
+                    if (is_failed || (_running_num >= ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES)) {
+                        continue;
+                    }
+                    if (!startStage(i, begin_time, threads)) {
+                        stage.record.state = StageState::Failed;
+                        stage.record.start_us = getElapsedUs(begin_time);
+                        stage.record.end_us = stage.record.start_us;
+                        is_failed |= !stage.config.is_optional;
+                        is_changed = true;
+                    }
+                }
+            }
+            if (_running_num == 0) {
+                break;
+            }
+            _cv.wait(lock);
+        }
+        // Stages left after a failure were never started
+        for (auto &stage : _stages) {
+            if (stage.record.state == StageState::Pending) {
+                stage.record.state = StageState::Skipped;
+            }
+        }
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    uint32_t duration_us = 0;
+    auto critical_path = getCriticalPath(&duration_us);
+    ESP_UTILS_LOGD(
+        "Boot %s in %d ms, critical path ends with stage(%s)", is_failed ? "failed" : "done",
+        static_cast<int>(duration_us / 1000), critical_path.empty() ? "none" : critical_path.back().c_str()
+    );
+
+    return !is_failed;
+}
+
+std::vector<Boot::StageRecord> Boot::getTimeline() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<StageRecord> timeline;
+    timeline.reserve(_stages.size());
+    for (auto &stage : _stages) {
+        timeline.push_back(stage.record);
+    }
+    std::stable_sort(timeline.begin(), timeline.end(), [](const StageRecord & a, const StageRecord & b) {
+        return a.start_us < b.start_us;
+    });
+
+    return timeline;
+}
+
+std::vector<std::string> Boot::getCriticalPath(uint32_t *duration_us) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto has_run = [this](size_t index) {
+        auto state = _stages[index].record.state;
+        return (state == StageState::Done) || (state == StageState::Failed);
+    };
+
+    std::vector<std::string> path;
+    int last = -1;
+    for (size_t i = 0; i < _stages.size(); i++) {
+        if (has_run(i) && ((last < 0) || (_stages[i].record.end_us > _stages[last].record.end_us))) {
+            last = i;
+        }
+    }
+    if (duration_us != nullptr) {
+        *duration_us = (last < 0) ? 0 : _stages[last].record.end_us;
+    }
+    while (last >= 0) {
+        auto &stage = _stages[last];
+        path.push_back(stage.config.name);
+        last = -1;
+        for (auto depend : stage.depends) {
+            if (has_run(depend) && ((last < 0) || (_stages[depend].record.end_us > _stages[last].record.end_us))) {
+                last = depend;
+            }
+        }
+    }
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+void Boot::dumpTimeline() const
+{
+    auto timeline = getTimeline();
+    uint32_t duration_us = 0;
+    auto critical_path = getCriticalPath(&duration_us);
+
+    ESP_UTILS_LOGI("{Boot timeline}: %d stages, %d ms", static_cast<int>(timeline.size()),
+                   static_cast<int>(duration_us / 1000));
+    for (auto &record : timeline) {
+        ESP_UTILS_LOGI(
+            "\t- %-16s core(%2d) %-7s ready(%6d us) start(%6d us) end(%6d us) cost(%6d us)", record.name.c_str(),
+            record.core_id, get_state_name(record.state), static_cast<int>(record.ready_us),
+            static_cast<int>(record.start_us), static_cast<int>(record.end_us),
+            static_cast<int>(record.end_us - record.start_us)
+        );
+    }
+    std::string path_str;
+    for (auto &name : critical_path) {
+        path_str += (path_str.empty() ? "" : " -> ") + name;
+    }
+    ESP_UTILS_LOGI("{Critical path}: %s", path_str.empty() ? "none" : path_str.c_str());
+}
+
+bool Boot::resolveDepends()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto &stage : _stages) {
+        stage.depends.clear();
+        for (auto &name : stage.config.depends) {
+            auto it = std::find_if(_stages.begin(), _stages.end(), [&name](const Stage & other) {
+                return other.config.name == name;
+            });
+            ESP_UTILS_CHECK_FALSE_RETURN(it != _stages.end(), false, "Unknown stage(%s)", name.c_str());
+            stage.depends.push_back(it - _stages.begin());
+        }
+    }
+
+    return true;
+}
+
+bool Boot::isStageReady(const Stage &stage, bool &is_skipped) const
+{
+    for (auto depend : stage.depends) {
+        auto &other = _stages[depend];
+        switch (other.record.state) {
+        case StageState::Done:
+            break;
+        case StageState::Failed:
+            if (!other.config.is_optional) {
+                is_skipped = true;
+                return true;
+            }
+            break;
+        case StageState::Skipped:
+            is_skipped = true;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Boot::startStage(size_t index, Clock::time_point begin_time, std::vector<boost::thread> &threads)
+{
+    auto &stage = _stages[index];
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = stage.config.name,
+        .core_id = stage.config.core_id,
+        .priority = static_cast<size_t>(ESP_BROOKESIA_BOOT_STAGE_PRIORITY),
+        .stack_size = (stage.config.stack_size > 0) ? stage.config.stack_size :
+        static_cast<size_t>(ESP_BROOKESIA_BOOT_STAGE_STACK_SIZE),
+        .stack_in_ext = ESP_BROOKESIA_BOOT_STACK_IN_EXT,
+    });
+    // The stage task can only record its end after the lock is released, so its start is recorded first
+    stage.record.state = StageState::Running;
+    stage.record.start_us = getElapsedUs(begin_time);
+    _running_num++;
+    try {
+        threads.emplace_back([this, index, begin_time]() {
+            auto &stage = _stages[index];
+            ESP_UTILS_LOGD("Stage(%s) start", stage.config.name.c_str());
+            bool is_ok = false;
+            try {
+                is_ok = stage.config.function();
+            } catch (...) {
+                ESP_UTILS_LOGE("Stage(%s) threw an exception", stage.config.name.c_str());
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            stage.record.end_us = getElapsedUs(begin_time);
+            stage.record.state = is_ok ? StageState::Done : StageState::Failed;
+            _running_num--;
+            if (is_ok) {
+                ESP_UTILS_LOGD(
+                    "Stage(%s) done in %d us", stage.config.name.c_str(),
+                    static_cast<int>(stage.record.end_us - stage.record.start_us)
+                );
+            } else {
+                ESP_UTILS_LOGE(
+                    "Stage(%s) failed%s", stage.config.name.c_str(), stage.config.is_optional ? ", ignored" : ""
+                );
+            }
+            _cv.notify_all();
+        });
+    } catch (...) {
+        _running_num--;
+        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Create stage(%s) task failed", stage.config.name.c_str());
+    }
+
+    return true;
+}
+
+uint32_t Boot::getElapsedUs(Clock::time_point begin_time) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin_time).count();
+}
+
+} // namespace esp_brookesia::services
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "boost/thread.hpp"
+
+namespace esp_brookesia::services {
+
+/**
+ * @brief Boot orchestrator that runs the startup stages of a product as a dependency graph
+ *
+ * Each stage declares the stages it depends on and runs in a task of its own as soon as all of them are done, so
+ * independent stages (e.g. audio codec and SD card) run at the same time instead of one after another. The start and
+ * end time of every stage is recorded in a timeline, from which the critical path of the boot can be reported.
+ */
+class Boot {
+public:
+    using Clock = std::chrono::steady_clock;
+    using StageFunction = std::function<bool()>;
+
+    struct StageConfig {
+        std::string name;
+        std::vector<std::string> depends;   // Stages that must be done before this one starts
+        StageFunction function;             // Returns false if the stage failed
+        int core_id = -1;                   // Core of the stage task, -1 means no affinity
+        size_t stack_size = 0;              // Stack size of the stage task, 0 means the Kconfig default
+        bool is_optional = false;           // A failed optional stage doesn't stop the stages depending on it
+    };
+
+    enum class StageState : uint8_t {
+        Pending = 0,    // Not started yet
+        Running,
+        Done,
+        Failed,
+        Skipped,        // Not run because a required stage it depends on failed
+    };
+
+    struct StageRecord {
+        std::string name;
+        int core_id;
+        StageState state;
+        uint32_t ready_us;  // Time at which all the dependencies were done
+        uint32_t start_us;  // Time at which the stage started, later than `ready_us` if too many stages were running
+        uint32_t end_us;
+    };
+
+    Boot() = default;
+    Boot(const Boot &) = delete;
+    Boot(Boot &&) = delete;
+    ~Boot() = default;
+
+    Boot &operator=(const Boot &) = delete;
+    Boot &operator=(Boot &&) = delete;
+
+    /**
+     * @brief Add a stage, the stages it depends on may be added later
+     *
+     * @return false if a stage with the same name exists or the boot already ran
+     */
+    bool addStage(StageConfig config);
+
+    /**
+     * @brief Check the graph: every dependency must exist and the dependencies must not form a cycle
+     *
+     * @param cycle  Optional output of the stages forming the first cycle found, the first one repeated at the end
+     *
+     * @return true if the graph can be run
+     */
+    bool checkGraph(std::vector<std::string> *cycle = nullptr) const;
+
+    /**
+     * @brief Run all the stages and wait until they end
+     *
+     * After a required stage failed, no new stage is started and the running ones are waited for.
+     *
+     * @return true if all the required stages are done, false if the graph is invalid or a required stage failed
+     */
+    bool run();
+
+    /**
+     * @brief Get the timeline of the last run, with the time of each stage since the start of `run()`
+     */
+    std::vector<StageRecord> getTimeline() const;
+
+    /**
+     * @brief Get the critical path of the last run
+     *
+     * Starting from the stage that ended last, each step goes to the dependency that ended last, that is the one
+     * which made the stage wait. Shortening any other stage doesn't make the boot faster.
+     *
+     * @param duration_us  Optional output of the end time of the last stage
+     *
+     * @return Stage names from the first one of the path to the last one
+     */
+    std::vector<std::string> getCriticalPath(uint32_t *duration_us = nullptr) const;
+
+    /**
+     * @brief Print the timeline and the critical path of the last run
+     */
+    void dumpTimeline() const;
+
+private:
+    struct Stage {
+        StageConfig config;
+        std::vector<size_t> depends;
+        StageRecord record;
+        bool is_ready;
+    };
+
+    bool resolveDepends();
+    bool isStageReady(const Stage &stage, bool &is_skipped) const;
+    bool startStage(size_t index, Clock::time_point begin_time, std::vector<boost::thread> &threads);
+    uint32_t getElapsedUs(Clock::time_point begin_time) const;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<Stage> _stages;
+    bool _is_run = false;
+    int _running_num = 0;
+};
+
+} // namespace esp_brookesia::services
@@ -31,3 +31,157 @@
 #       endif
 #   endif
 #endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////// Executor /////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR)
+#    if defined(CONFIG_ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR)
+#        define ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR  CONFIG_ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR
+#    else
+#        define ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR  (0)
+#    endif
+#endif
+
+#if ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR
+#   if !defined(ESP_BROOKESIA_EXECUTOR_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_EXECUTOR_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_EXECUTOR_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_CORE_ID)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_CORE_ID)
+#           define ESP_BROOKESIA_EXECUTOR_CORE_ID  CONFIG_ESP_BROOKESIA_EXECUTOR_CORE_ID
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_CORE_ID  (-1)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_QUEUE_DEPTH)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_QUEUE_DEPTH)
+#           define ESP_BROOKESIA_EXECUTOR_QUEUE_DEPTH  CONFIG_ESP_BROOKESIA_EXECUTOR_QUEUE_DEPTH
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_QUEUE_DEPTH  (32)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT)
+#           define ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT  CONFIG_ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT  (0)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_HIGH_WORKER_NUM)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_HIGH_WORKER_NUM)
+#           define ESP_BROOKESIA_EXECUTOR_HIGH_WORKER_NUM  CONFIG_ESP_BROOKESIA_EXECUTOR_HIGH_WORKER_NUM
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_HIGH_WORKER_NUM  (1)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_HIGH_PRIORITY)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_HIGH_PRIORITY)
+#           define ESP_BROOKESIA_EXECUTOR_HIGH_PRIORITY  CONFIG_ESP_BROOKESIA_EXECUTOR_HIGH_PRIORITY
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_HIGH_PRIORITY  (10)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_HIGH_STACK_SIZE)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_HIGH_STACK_SIZE)
+#           define ESP_BROOKESIA_EXECUTOR_HIGH_STACK_SIZE  CONFIG_ESP_BROOKESIA_EXECUTOR_HIGH_STACK_SIZE
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_HIGH_STACK_SIZE  (6144)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_NORMAL_WORKER_NUM)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_NORMAL_WORKER_NUM)
+#           define ESP_BROOKESIA_EXECUTOR_NORMAL_WORKER_NUM  CONFIG_ESP_BROOKESIA_EXECUTOR_NORMAL_WORKER_NUM
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_NORMAL_WORKER_NUM  (2)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_NORMAL_PRIORITY)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_NORMAL_PRIORITY)
+#           define ESP_BROOKESIA_EXECUTOR_NORMAL_PRIORITY  CONFIG_ESP_BROOKESIA_EXECUTOR_NORMAL_PRIORITY
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_NORMAL_PRIORITY  (5)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_NORMAL_STACK_SIZE)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_NORMAL_STACK_SIZE)
+#           define ESP_BROOKESIA_EXECUTOR_NORMAL_STACK_SIZE  CONFIG_ESP_BROOKESIA_EXECUTOR_NORMAL_STACK_SIZE
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_NORMAL_STACK_SIZE  (12288)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_LOW_WORKER_NUM)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_LOW_WORKER_NUM)
+#           define ESP_BROOKESIA_EXECUTOR_LOW_WORKER_NUM  CONFIG_ESP_BROOKESIA_EXECUTOR_LOW_WORKER_NUM
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_LOW_WORKER_NUM  (1)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_LOW_PRIORITY)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_LOW_PRIORITY)
+#           define ESP_BROOKESIA_EXECUTOR_LOW_PRIORITY  CONFIG_ESP_BROOKESIA_EXECUTOR_LOW_PRIORITY
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_LOW_PRIORITY  (2)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_EXECUTOR_LOW_STACK_SIZE)
+#       if defined(CONFIG_ESP_BROOKESIA_EXECUTOR_LOW_STACK_SIZE)
+#           define ESP_BROOKESIA_EXECUTOR_LOW_STACK_SIZE  CONFIG_ESP_BROOKESIA_EXECUTOR_LOW_STACK_SIZE
+#       else
+#           define ESP_BROOKESIA_EXECUTOR_LOW_STACK_SIZE  (8192)
+#       endif
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////// Boot ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(ESP_BROOKESIA_SERVICES_ENABLE_BOOT)
+#   if defined(CONFIG_ESP_BROOKESIA_SERVICES_ENABLE_BOOT)
+#       define ESP_BROOKESIA_SERVICES_ENABLE_BOOT  CONFIG_ESP_BROOKESIA_SERVICES_ENABLE_BOOT
+#   else
+#       define ESP_BROOKESIA_SERVICES_ENABLE_BOOT  (0)
+#   endif
+#endif
+
+#if ESP_BROOKESIA_SERVICES_ENABLE_BOOT
+#   if !defined(ESP_BROOKESIA_BOOT_ENABLE_DEBUG_LOG)
+#       if defined(CONFIG_ESP_BROOKESIA_BOOT_ENABLE_DEBUG_LOG)
+#           define ESP_BROOKESIA_BOOT_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_BOOT_ENABLE_DEBUG_LOG
+#       else
+#           define ESP_BROOKESIA_BOOT_ENABLE_DEBUG_LOG  (0)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES)
+#       if defined(CONFIG_ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES)
+#           define ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES  CONFIG_ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES
+#       else
+#           define ESP_BROOKESIA_BOOT_MAX_PARALLEL_STAGES  (3)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_BOOT_STAGE_PRIORITY)
+#       if defined(CONFIG_ESP_BROOKESIA_BOOT_STAGE_PRIORITY)
+#           define ESP_BROOKESIA_BOOT_STAGE_PRIORITY  CONFIG_ESP_BROOKESIA_BOOT_STAGE_PRIORITY
+#       else
+#           define ESP_BROOKESIA_BOOT_STAGE_PRIORITY  (5)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_BOOT_STAGE_STACK_SIZE)
+#       if defined(CONFIG_ESP_BROOKESIA_BOOT_STAGE_STACK_SIZE)
+#           define ESP_BROOKESIA_BOOT_STAGE_STACK_SIZE  CONFIG_ESP_BROOKESIA_BOOT_STAGE_STACK_SIZE
+#       else
+#           define ESP_BROOKESIA_BOOT_STAGE_STACK_SIZE  (8192)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_BOOT_STACK_IN_EXT)
+#       if defined(CONFIG_ESP_BROOKESIA_BOOT_STACK_IN_EXT)
+#           define ESP_BROOKESIA_BOOT_STACK_IN_EXT  CONFIG_ESP_BROOKESIA_BOOT_STACK_IN_EXT
+#       else
+#           define ESP_BROOKESIA_BOOT_STACK_IN_EXT  (0)
+#       endif
+#   endif
+#endif
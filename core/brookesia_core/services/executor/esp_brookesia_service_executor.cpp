@@ -0,0 +1,331 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <exception>
+#include <string.h>
+#include "private/esp_brookesia_service_executor_utils.hpp"
+#include "esp_brookesia_service_executor.hpp"
+
+#define WORKER_THREAD_NAME_HIGH     "exec_high"
+#define WORKER_THREAD_NAME_NORMAL   "exec_normal"
+#define WORKER_THREAD_NAME_LOW      "exec_low"
+
+namespace esp_brookesia::services {
+
+struct WorkerConfig {
+    const char *name;
+    int num;
+    int priority;
+    int stack_size;
+    bool stack_in_ext;
+};
+
+static const WorkerConfig worker_configs[] = {
+    {
+        WORKER_THREAD_NAME_HIGH, ESP_BROOKESIA_EXECUTOR_HIGH_WORKER_NUM, ESP_BROOKESIA_EXECUTOR_HIGH_PRIORITY,
+        ESP_BROOKESIA_EXECUTOR_HIGH_STACK_SIZE, false
+    },
+    {
+        WORKER_THREAD_NAME_NORMAL, ESP_BROOKESIA_EXECUTOR_NORMAL_WORKER_NUM, ESP_BROOKESIA_EXECUTOR_NORMAL_PRIORITY,
+        ESP_BROOKESIA_EXECUTOR_NORMAL_STACK_SIZE, ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT
+    },
+    {
+        WORKER_THREAD_NAME_LOW, ESP_BROOKESIA_EXECUTOR_LOW_WORKER_NUM, ESP_BROOKESIA_EXECUTOR_LOW_PRIORITY,
+        ESP_BROOKESIA_EXECUTOR_LOW_STACK_SIZE, ESP_BROOKESIA_EXECUTOR_STACK_IN_EXT
+    },
+};
+static_assert(sizeof(worker_configs) / sizeof(worker_configs[0]) == static_cast<size_t>(Executor::Priority::Max));
+
+static thread_local bool is_worker_thread = false;
+
+void Executor::Stats::dump(const char *name) const
+{
+    ESP_UTILS_LOGI(
+        "{Stats(%s)}: posted(%d), rejected(%d), cancelled(%d), executed(%d), failed(%d), queue(%d/%d), "
+        "max_wait(%d us), runtime(avg: %d us, max: %d us)", name, static_cast<int>(posted), static_cast<int>(rejected),
+        static_cast<int>(cancelled), static_cast<int>(executed), static_cast<int>(failed), static_cast<int>(queue_depth),
+        static_cast<int>(max_queue_depth), static_cast<int>(max_wait_us),
+        (executed == 0) ? 0 : static_cast<int>(total_runtime_us / executed), static_cast<int>(max_runtime_us)
+    );
+}
+
+bool Executor::begin()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard<std::mutex> lock(_begin_mutex);
+    if (_is_begun) {
+        return true;
+    }
+
+    for (size_t i = 0; i < _classes.size(); i++) {
+        auto &worker_class = _classes[i];
+        auto &config = worker_configs[i];
+        for (int j = 0; j < config.num; j++) {
+            esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+                .name = config.name,
+                .core_id = ESP_BROOKESIA_EXECUTOR_CORE_ID,
+                .priority = static_cast<size_t>(config.priority),
+                .stack_size = static_cast<size_t>(config.stack_size),
+                .stack_in_ext = config.stack_in_ext,
+            });
+            try {
+                worker_class.workers.emplace_back([this, &worker_class]() {
+                    is_worker_thread = true;
+                    runWorker(worker_class);
+                });
+            } catch (...) {
+                // Don't leave the workers created so far behind, a later `begin()` would create them again
+                stopWorkers();
+                ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Create worker(%s) failed", config.name);
+            }
+        }
+    }
+    _is_begun = true;
+
+    return true;
+}
+
+bool Executor::post(Job job, Priority priority, const char *name, JobId *id)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(job != nullptr, false, "Invalid job");
+    ESP_UTILS_CHECK_FALSE_RETURN(priority < Priority::Max, false, "Invalid priority");
+
+    Entry entry = {
+        .id = _next_id++,
+        .job = std::move(job),
+        .name = name,
+        .due_time = Clock::now(),
+    };
+    if (id != nullptr) {
+        *id = entry.id;
+    }
+
+    return enqueue(std::move(entry), priority, false);
+}
+
+bool Executor::postDelayed(Job job, uint32_t delay_ms, Priority priority, const char *name, JobId *id)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(job != nullptr, false, "Invalid job");
+    ESP_UTILS_CHECK_FALSE_RETURN(priority < Priority::Max, false, "Invalid priority");
+
+    Entry entry = {
+        .id = _next_id++,
+        .job = std::move(job),
+        .name = name,
+        .due_time = Clock::now() + std::chrono::milliseconds(delay_ms),
+    };
+    if (id != nullptr) {
+        *id = entry.id;
+    }
+
+    return enqueue(std::move(entry), priority, delay_ms > 0);
+}
+
+bool Executor::cancel(JobId id)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    for (auto &worker_class : _classes) {
+        std::lock_guard<std::mutex> lock(worker_class.mutex);
+        auto ready_it = std::find_if(worker_class.ready.begin(), worker_class.ready.end(), [id](const Entry & entry) {
+            return entry.id == id;
+        });
+        if (ready_it != worker_class.ready.end()) {
+            worker_class.ready.erase(ready_it);
+            worker_class.stats.cancelled++;
+            worker_class.stats.queue_depth--;
+            return true;
+        }
+        auto delayed_it = std::find_if(
+                              worker_class.delayed.begin(), worker_class.delayed.end(), [id](const auto & item) {
+            return item.second.id == id;
+        });
+        if (delayed_it != worker_class.delayed.end()) {
+            worker_class.delayed.erase(delayed_it);
+            worker_class.stats.cancelled++;
+            worker_class.stats.queue_depth--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Executor::getStats(Priority priority, Stats &stats)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(priority < Priority::Max, false, "Invalid priority");
+
+    auto &worker_class = _classes[static_cast<size_t>(priority)];
+    std::lock_guard<std::mutex> lock(worker_class.mutex);
+    stats = worker_class.stats;
+
+    return true;
+}
+
+bool Executor::getJobStats(const std::string &name, JobStats &stats)
+{
+    // Copies of the same name in different files have different addresses, merge them
+    bool is_found = false;
+    stats = {};
+    std::lock_guard<std::mutex> lock(_job_stats_mutex);
+    for (auto &[job_name, job_stats] : _job_stats) {
+        if (strcmp(job_name, name.c_str()) != 0) {
+            continue;
+        }
+        stats.count += job_stats.count;
+        stats.total_runtime_us += job_stats.total_runtime_us;
+        stats.max_runtime_us = std::max(stats.max_runtime_us, job_stats.max_runtime_us);
+        is_found = true;
+    }
+
+    return is_found;
+}
+
+void Executor::dumpStats()
+{
+    for (size_t i = 0; i < _classes.size(); i++) {
+        Stats stats = {};
+        getStats(static_cast<Priority>(i), stats);
+        stats.dump(worker_configs[i].name);
+    }
+
+    std::lock_guard<std::mutex> lock(_job_stats_mutex);
+    for (auto &[name, stats] : _job_stats) {
+        ESP_UTILS_LOGI(
+            "{Job(%s)}: count(%d), runtime(avg: %d us, max: %d us)", name, static_cast<int>(stats.count),
+            static_cast<int>(stats.total_runtime_us / std::max<uint32_t>(stats.count, 1)),
+            static_cast<int>(stats.max_runtime_us)
+        );
+    }
+}
+
+bool Executor::isWorkerThread() const
+{
+    return is_worker_thread;
+}
+
+bool Executor::enqueue(Entry &&entry, Priority priority, bool is_delayed)
+{
+    if (!_is_begun) {
+        ESP_UTILS_CHECK_FALSE_RETURN(begin(), false, "Begin failed");
+    }
+
+    auto &worker_class = _classes[static_cast<size_t>(priority)];
+    {
+        std::lock_guard<std::mutex> lock(worker_class.mutex);
+        if (worker_class.stats.queue_depth >= ESP_BROOKESIA_EXECUTOR_QUEUE_DEPTH) {
+            worker_class.stats.rejected++;
+            ESP_UTILS_LOGE(
+                "Queue of %s is full, reject job(%s)", worker_configs[static_cast<size_t>(priority)].name,
+                (entry.name == nullptr) ? "unnamed" : entry.name
+            );
+            return false;
+        }
+        if (is_delayed) {
+            worker_class.delayed.emplace(entry.due_time, std::move(entry));
+        } else {
+            worker_class.ready.emplace_back(std::move(entry));
+        }
+        worker_class.stats.posted++;
+        worker_class.stats.queue_depth++;
+        worker_class.stats.max_queue_depth = std::max(worker_class.stats.max_queue_depth,
+                                                      worker_class.stats.queue_depth);
+    }
+    // A new delayed job may be due earlier than the one the workers are sleeping on, so wake all of them
+    if (is_delayed) {
+        worker_class.cv.notify_all();
+    } else {
+        worker_class.cv.notify_one();
+    }
+
+    return true;
+}
+
+void Executor::runWorker(WorkerClass &worker_class)
+{
+    std::unique_lock<std::mutex> lock(worker_class.mutex);
+    while (!worker_class.is_stopping) {
+        auto now = Clock::now();
+        while (!worker_class.delayed.empty() && (worker_class.delayed.begin()->first <= now)) {
+            worker_class.ready.emplace_back(std::move(worker_class.delayed.begin()->second));
+            worker_class.delayed.erase(worker_class.delayed.begin());
+        }
+
+        if (worker_class.ready.empty()) {
+            if (worker_class.delayed.empty()) {
+                worker_class.cv.wait(lock);
+            } else {
+                worker_class.cv.wait_until(lock, worker_class.delayed.begin()->first);
+            }
+            continue;
+        }
+
+        Entry entry = std::move(worker_class.ready.front());
+        worker_class.ready.pop_front();
+        worker_class.stats.queue_depth--;
+        lock.unlock();
+
+        // A throwing job must not take the worker, and all the jobs of its priority, down with it
+        auto start_time = Clock::now();
+        bool is_failed = false;
+        try {
+            entry.job();
+        } catch (const std::exception &e) {
+            ESP_UTILS_LOGE("Job(%s) threw: %s", (entry.name != nullptr) ? entry.name : "unnamed", e.what());
+            is_failed = true;
+        } catch (...) {
+            ESP_UTILS_LOGE("Job(%s) threw an unknown exception", (entry.name != nullptr) ? entry.name : "unnamed");
+            is_failed = true;
+        }
+        recordJob(worker_class, entry, start_time, is_failed);
+
+        lock.lock();
+    }
+}
+
+void Executor::stopWorkers()
+{
+    for (auto &worker_class : _classes) {
+        {
+            std::lock_guard<std::mutex> lock(worker_class.mutex);
+            worker_class.is_stopping = true;
+        }
+        worker_class.cv.notify_all();
+        for (auto &worker : worker_class.workers) {
+            worker.join();
+        }
+        worker_class.workers.clear();
+        std::lock_guard<std::mutex> lock(worker_class.mutex);
+        worker_class.is_stopping = false;
+    }
+}
+
+void Executor::recordJob(WorkerClass &worker_class, const Entry &entry, Clock::time_point start_time, bool is_failed)
+{
+    auto end_time = Clock::now();
+    uint32_t runtime_us = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+    uint32_t wait_us = std::chrono::duration_cast<std::chrono::microseconds>(start_time - entry.due_time).count();
+
+    {
+        std::lock_guard<std::mutex> lock(worker_class.mutex);
+        worker_class.stats.executed++;
+        worker_class.stats.failed += is_failed ? 1 : 0;
+        worker_class.stats.total_runtime_us += runtime_us;
+        worker_class.stats.max_runtime_us = std::max(worker_class.stats.max_runtime_us, runtime_us);
+        worker_class.stats.max_wait_us = std::max(worker_class.stats.max_wait_us, wait_us);
+    }
+
+    if (entry.name != nullptr) {
+        std::lock_guard<std::mutex> lock(_job_stats_mutex);
+        auto &stats = _job_stats[entry.name];
+        stats.count++;
+        stats.total_runtime_us += runtime_us;
+        stats.max_runtime_us = std::max(stats.max_runtime_us, runtime_us);
+    }
+}
+
+} // namespace esp_brookesia::services
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+#include "boost/thread.hpp"
+
+namespace esp_brookesia::services {
+
+/**
+ * @brief Shared pool of worker tasks for short jobs
+ *
+ * Jobs are queued to one of the priority classes and run by the fixed set of workers of that class, so posting a job
+ * never creates a task. A job must not block for long, since it holds one of the few workers of its class.
+ */
+class Executor {
+public:
+    using Job = std::function<void()>;
+    using JobId = uint32_t;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr JobId INVALID_JOB_ID = 0;
+
+    enum class Priority : uint8_t {
+        High = 0,
+        Normal,
+        Low,
+        Max,
+    };
+
+    struct Stats {
+        void dump(const char *name) const;
+
+        uint32_t posted;            // Jobs accepted
+        uint32_t rejected;          // Jobs refused because the queue was full
+        uint32_t cancelled;         // Jobs removed before running
+        uint32_t executed;          // Jobs that ran
+        uint32_t failed;            // Jobs that ran and threw, the worker goes on with the next ones
+        uint16_t queue_depth;       // Ready and delayed jobs currently waiting
+        uint16_t max_queue_depth;   // Peak of the above
+        uint32_t max_wait_us;       // Longest time between the due time of a job and its start
+        uint32_t max_runtime_us;    // Longest job
+        uint64_t total_runtime_us;  // Sum of all job runtimes
+    };
+
+    struct JobStats {
+        uint32_t count;
+        uint32_t max_runtime_us;
+        uint64_t total_runtime_us;
+    };
+
+    Executor(const Executor &) = delete;
+    Executor(Executor &&) = delete;
+    ~Executor() = default;
+
+    Executor &operator=(const Executor &) = delete;
+    Executor &operator=(Executor &&) = delete;
+
+    /**
+     * @brief Start the workers, called automatically by the first `post()`
+     */
+    bool begin();
+
+    /**
+     * @brief Queue a job to run as soon as a worker of the class is free
+     *
+     * @param job       Job to run
+     * @param priority  Priority class
+     * @param name      Optional name with static storage, jobs with a name get their own runtime statistics, which
+     *                  are keyed by the address of the name
+     * @param id        Optional output of the job id, which can be used with `cancel()`
+     *
+     * @return true if the job was queued, false if the queue of the class is full
+     */
+    bool post(Job job, Priority priority = Priority::Normal, const char *name = nullptr, JobId *id = nullptr);
+
+    /**
+     * @brief Queue a job to run after a delay
+     */
+    bool postDelayed(
+        Job job, uint32_t delay_ms, Priority priority = Priority::Normal, const char *name = nullptr,
+        JobId *id = nullptr
+    );
+
+    /**
+     * @brief Remove a job that has not started yet
+     *
+     * @return true if the job was found and removed
+     */
+    bool cancel(JobId id);
+
+    bool getStats(Priority priority, Stats &stats);
+    bool getJobStats(const std::string &name, JobStats &stats);
+    void dumpStats();
+
+    /**
+     * @brief Check whether the caller runs on one of the workers
+     */
+    bool isWorkerThread() const;
+
+    static Executor &requestInstance()
+    {
+        static Executor instance;
+        return instance;
+    }
+
+private:
+    struct Entry {
+        JobId id;
+        Job job;
+        const char *name;
+        Clock::time_point due_time;
+    };
+
+    struct WorkerClass {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Entry> ready;
+        std::multimap<Clock::time_point, Entry> delayed;
+        std::vector<boost::thread> workers;
+        bool is_stopping = false;
+        Stats stats = {};
+    };
+
+    Executor() = default;
+
+    bool enqueue(Entry &&entry, Priority priority, bool is_delayed);
+    void runWorker(WorkerClass &worker_class);
+    void stopWorkers();
+    void recordJob(WorkerClass &worker_class, const Entry &entry, Clock::time_point start_time, bool is_failed);
+
+    std::mutex _begin_mutex;
+    std::atomic<bool> _is_begun = false;
+    std::atomic<JobId> _next_id = 1;
+    std::array<WorkerClass, static_cast<size_t>(Priority::Max)> _classes;
+
+    std::mutex _job_stats_mutex;
+    std::unordered_map<const char *, JobStats> _job_stats;
+};
+
+} // namespace esp_brookesia::services
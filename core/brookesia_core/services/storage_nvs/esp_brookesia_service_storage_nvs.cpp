@@ -108,7 +108,10 @@ bool StorageNVS::setLocalParam(const Key &key, const Value &value, std::optional
 
     {
         std::lock_guard<std::mutex> lock(_params_mutex);
-        _local_params[key] = value;
+        _local_params.add(key, value);
+        if (!_local_params.freeze()) {
+            ESP_UTILS_LOGW("Freeze local params failed, keep looking up the keys by map");
+        }
     }
 
     if (wait_finish_timeout_ms.has_value()) {
@@ -125,13 +128,13 @@ bool StorageNVS::getLocalParam(const Key &key, Value &value)
 {
     std::lock_guard<std::mutex> lock(_params_mutex);
 
-    auto it = _local_params.find(key);
-    if (it == _local_params.end()) {
+    auto param = _local_params.get(key);
+    if (param == nullptr) {
         ESP_UTILS_LOGW("NVS key(%s) not found", key.c_str());
         return false;
     }
 
-    value = it->second;
+    value = *param;
 
     return true;
 }
@@ -233,9 +236,9 @@ bool StorageNVS::doEventOperationUpdateNVS(const Key &key)
 
     std::lock_guard<std::mutex> lock(_params_mutex);
 
-    auto it = _local_params.find(key);
+    auto param = _local_params.get(key);
     ESP_UTILS_CHECK_FALSE_RETURN(
-        it != _local_params.end(), false, "Invalid NVS key(%s)", key.c_str()
+        param != nullptr, false, "Invalid NVS key(%s)", key.c_str()
     );
     ESP_UTILS_LOGD("Update key(%s) NVS parameter", key.c_str());
 
@@ -248,7 +251,7 @@ bool StorageNVS::doEventOperationUpdateNVS(const Key &key)
         nvs_close(nvs_handle);
     });
 
-    auto &value = it->second;
+    auto &value = *param;
     const char *key_str = key.c_str();
 
     if (std::holds_alternative<int>(value)) {
@@ -319,7 +322,7 @@ bool StorageNVS::doEventOperationUpdateParam()
                 ESP_UTILS_LOGI(
                     "\t- Found key(%s): type(%s), value(%d)", info.key, type_str_it->second, static_cast<int>(value_int)
                 );
-                _local_params[info.key] = Value(static_cast<int>(value_int));
+                _local_params.add(info.key, Value(static_cast<int>(value_int)));
             }
             break;
         }
@@ -333,7 +336,7 @@ bool StorageNVS::doEventOperationUpdateParam()
                 ESP_UTILS_LOGI(
                     "\t- Found key(%s): type(%s), value(%s)", info.key, type_str_it->second, value_str.get()
                 );
-                _local_params[info.key] = Value(std::string(value_str.get()));
+                _local_params.add(info.key, Value(std::string(value_str.get())));
             }
             break;
         }
@@ -345,6 +348,9 @@ bool StorageNVS::doEventOperationUpdateParam()
     }
     nvs_release_iterator(it);
 
+    if (!_local_params.freeze()) {
+        ESP_UTILS_LOGW("Freeze local params failed, keep looking up the keys by map");
+    }
     ESP_UTILS_LOGI("Found %d keys in NVS", static_cast<int>(_local_params.size()));
 
     return true;
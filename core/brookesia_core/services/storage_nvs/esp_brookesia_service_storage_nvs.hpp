@@ -9,6 +9,7 @@
 #include <queue>
 #include <future>
 #include "boost/thread.hpp"
+#include "utils/esp_brookesia_frozen_registry.hpp"
 
 namespace esp_brookesia::services {
 
@@ -68,7 +69,8 @@ private:
     bool doEventOperationUpdateParam();
     bool doEventOperationEraseNVS();
 
-    std::map<Key, Value> _local_params;
+    // The set of keys rarely changes after the NVS is loaded, so a new key refreezes it
+    utils::FrozenRegistry<Value> _local_params;
     std::mutex _params_mutex;
 
     std::queue<EventWrapper> _event_queue;
@@ -256,6 +256,46 @@ bool Display::processDummyDraw(bool enable)
     return true;
 }
 
+bool Display::setDummyDrawOverlay(bool enable, uint32_t key_color24)
+{
+    // 设置叠加模式：调整遮罩的尺寸、背景和层级
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+    ESP_UTILS_LOGD("Param: enable(%d), key_color24(0x%06x)", enable, static_cast<int>(key_color24));
+
+    if (enable) {
+        // 遮罩覆盖主屏幕，只留下系统控件和关键色
+        const auto &screen_size = _core.getCoreData().screen_size;
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _dummy_draw_mask->setStyleAttribute(gui::StyleSize::RECT(screen_size.width, screen_size.height)), false,
+            "Set dummy draw mask size failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _dummy_draw_mask->setStyleAttribute(
+                gui::STYLE_COLOR_ITEM_BACKGROUND, gui::StyleColor::COLOR(key_color24)
+            ), false, "Set dummy draw mask background failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(_dummy_draw_mask->moveBackground(), false, "Move dummy draw mask failed");
+    } else {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _dummy_draw_mask->setStyleAttribute(
+                gui::StyleSize::RECT(gui::StyleSize::LENGTH_AUTO, gui::StyleSize::LENGTH_AUTO)
+            ), false, "Set dummy draw mask size failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _dummy_draw_mask->setStyleAttribute(
+                gui::STYLE_COLOR_ITEM_BACKGROUND, gui::StyleColor::COLOR_WITH_OPACITY(0, 0)
+            ), false, "Set dummy draw mask background failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(_dummy_draw_mask->moveForeground(), false, "Move dummy draw mask failed");
+    }
+    _is_dummy_draw_overlay = enable;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+    return true;
+}
+
 bool Display::startBootAnimation(void)
 {
     // 启动开机动画：播放系统启动时的动画效果
@@ -80,6 +80,13 @@ public:
     Keyboard &getKeyboard(void)                     { return _keyboard; }
     // 获取虚拟绘制遮罩对象，用于启用/禁用界面遮罩绘制
     gui::LvContainer *getDummyDrawMask(void)        { return _dummy_draw_mask.get(); }
+    // 检查虚拟绘制遮罩是否处于叠加模式
+    bool isDummyDrawOverlay(void) const             { return _is_dummy_draw_overlay; }
+
+    // 设置虚拟绘制遮罩的叠加模式
+    // 启用后，遮罩以关键色填满屏幕并置于系统屏幕底层，快速设置、键盘等系统控件仍由 LVGL 绘制在其上，
+    // 由合成器将关键色像素替换为虚拟绘制的内容（如动画），两者无需切换显示模式即可同时显示
+    bool setDummyDrawOverlay(bool enable, uint32_t key_color24);
 
     // 播放启动动画，需在显示初始化后调用
     bool startBootAnimation(void);
@@ -113,6 +120,7 @@ private:
     QuickSettings _quick_settings;
     Keyboard _keyboard;
     gui::LvContainerUniquePtr _dummy_draw_mask;
+    bool _is_dummy_draw_overlay = false;
 };
 // *INDENT-ON*
 
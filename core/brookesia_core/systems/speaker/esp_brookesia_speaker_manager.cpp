@@ -614,8 +614,9 @@ bool Manager::processQuickSettingsGesturePressEvent(lv_event_t *event)
     ESP_UTILS_LOGD("Param: event(%p)", event);
     ESP_UTILS_CHECK_NULL_RETURN(event, false, "Invalid event");
 
+    // In the overlay mode, the quick settings are drawn on top of the dummy draw content
     auto dummy_draw_mask = display.getDummyDrawMask();
-    if (!dummy_draw_mask->hasFlags(gui::STYLE_FLAG_HIDDEN)) {
+    if (!dummy_draw_mask->hasFlags(gui::STYLE_FLAG_HIDDEN) && !display.isDummyDrawOverlay()) {
         goto end;
     }
 
@@ -41,6 +41,7 @@ constexpr DisplayData ESP_BROOKESIA_SPEAKER_360_360_DARK_DISPLAY_DATA = {
                     .partition_label = "anim_boot",
                     .max_files = MMAP_BOOT_FILES,
                     .checksum = MMAP_BOOT_CHECKSUM,
+                    .verify_mode = gui::AnimPlayerVerifyMode::Deferred,
                 },
             },
             .flags = {
@@ -115,6 +116,7 @@ constexpr AI_BuddyData ESP_BROOKESIA_SPEAKER_360_360_DARK_AI_AGENT_DATA = {
                             .partition_label = "anim_emotion",
                             .max_files = MMAP_EMOTION_FILES,
                             .checksum = MMAP_EMOTION_CHECKSUM,
+                            .verify_mode = gui::AnimPlayerVerifyMode::Deferred,
                         },
                     },
                     .flags = {
@@ -157,6 +159,7 @@ constexpr AI_BuddyData ESP_BROOKESIA_SPEAKER_360_360_DARK_AI_AGENT_DATA = {
                             .partition_label = "anim_icon",
                             .max_files = MMAP_ICON_FILES,
                             .checksum = MMAP_ICON_CHECKSUM,
+                            .verify_mode = gui::AnimPlayerVerifyMode::Deferred,
                         },
                     },
                     .flags = {
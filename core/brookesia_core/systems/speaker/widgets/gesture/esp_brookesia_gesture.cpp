@@ -66,7 +66,7 @@ Gesture::~Gesture()
 
 bool Gesture::begin(lv_obj_t *parent)
 {
-    ESP_Brookesia_LvTimer_t detect_timer = nullptr;
+    LvTickSubscriberUniquePtr detect_timer = nullptr;
     ESP_Brookesia_LvObj_t event_mask_obj = nullptr;
     array<ESP_Brookesia_LvObj_t, GESTURE_INDICATOR_BAR_TYPE_MAX> indicator_bars = {};
     array<ESP_Brookesia_LvAnim_t, GESTURE_INDICATOR_BAR_TYPE_MAX> indicator_bar_scale_back_anims = {};
@@ -78,8 +78,9 @@ bool Gesture::begin(lv_obj_t *parent)
     ESP_UTILS_CHECK_NULL_RETURN(core.getTouchDevice(), false, "Invalid core touch device");
 
     /* Create objects */
-    detect_timer = ESP_BROOKESIA_LV_TIMER(onTouchDetectTimerCallback, data.detect_period_ms, this);
-    ESP_UTILS_CHECK_NULL_RETURN(detect_timer, false, "Create detect timer failed");
+    // The touch is polled at the shared ticks of the periodic refreshes
+    detect_timer = std::make_unique<LvTickSubscriber>(onTouchDetectTimerCallback, data.detect_period_ms, 0, this);
+    ESP_UTILS_CHECK_FALSE_RETURN(detect_timer->isValid(), false, "Create detect timer failed");
     event_mask_obj = ESP_BROOKESIA_LV_OBJ(obj, parent);
     ESP_UTILS_CHECK_NULL_RETURN(event_mask_obj, false, "Create event & mask object failed");
     press_event_code = core.getFreeEventCode();
@@ -127,7 +128,7 @@ bool Gesture::begin(lv_obj_t *parent)
 
     // Save objects
     _touch_device = core.getTouchDevice();
-    _detect_timer = detect_timer;
+    _detect_timer = std::move(detect_timer);
     _event_mask_obj = event_mask_obj;
     _press_event_code = press_event_code;
     _pressing_event_code = pressing_event_code;
@@ -415,6 +416,10 @@ bool Gesture::controlIndicatorBarScaleBackAnim(GestureIndicatorBarType type, boo
 
 void Gesture::resetGestureInfo(void)
 {
+    if (checkGestureStart()) {
+        LvFrameGovernor::getInstance().exitScene(LvFrameGovernor::Scene::Gesture);
+    }
+
     GestureInfo reset_info = (GestureInfo)ESP_BROOKESIA_INFO_INIT();
     _info = reset_info;
 }
@@ -429,7 +434,7 @@ bool Gesture::updateByNewData(void)
     int align_y_offset = 0;
     lv_align_t align = LV_ALIGN_DEFAULT;
     // Timer
-    lv_timer_set_period(_detect_timer.get(), data.detect_period_ms);
+    _detect_timer->setInterval(data.detect_period_ms);
     // Mask
     lv_obj_set_size(_event_mask_obj.get(), core.getCoreData().screen_size.width, core.getCoreData().screen_size.height);
     // Indicator bar
@@ -496,7 +501,7 @@ void Gesture::onDataUpdateEventCallback(lv_event_t *event)
     ESP_UTILS_CHECK_FALSE_EXIT(gesture->updateByNewData(), "Update gesture object style failed");
 }
 
-void Gesture::onTouchDetectTimerCallback(struct _lv_timer_t *t)
+void Gesture::onTouchDetectTimerCallback(void *user_data)
 {
     bool touched = false;
     int distance_x = 0;
@@ -504,7 +509,7 @@ void Gesture::onTouchDetectTimerCallback(struct _lv_timer_t *t)
     float distance_tan = numeric_limits<float>::infinity();
     lv_event_code_t event_code = LV_EVENT_ALL;
 
-    Gesture *gesture = (Gesture *)t->user_data;
+    Gesture *gesture = (Gesture *)user_data;
     ESP_UTILS_CHECK_NULL_EXIT(gesture, "Invalid gesture");
 
     const GestureData &data = gesture->data;
@@ -542,6 +547,9 @@ void Gesture::onTouchDetectTimerCallback(struct _lv_timer_t *t)
         info.start_area |= (info.start_x < data.threshold.horizontal_edge) ? GESTURE_AREA_LEFT_EDGE : 0;
         info.start_area |= ((display_w - info.start_x) < data.threshold.horizontal_edge) ? GESTURE_AREA_RIGHT_EDGE : 0;
 
+        // Let the indicator bars and the dragged app follow the finger smoothly until the release
+        LvFrameGovernor::getInstance().enterScene(LvFrameGovernor::Scene::Gesture);
+
         // Set the press event code
         event_code = gesture->_press_event_code;
         ESP_UTILS_LOGD("Gesture send press event");
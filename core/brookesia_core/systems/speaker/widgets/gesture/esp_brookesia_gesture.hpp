@@ -7,6 +7,7 @@
 
 #include "lvgl.h"
 #include "systems/core/esp_brookesia_core.hpp"
+#include "lvgl/esp_brookesia_lv_tick_scheduler.hpp"
 
 // *INDENT-OFF*
 
@@ -131,7 +132,7 @@ private:
     bool updateByNewData(void);
 
     static void onDataUpdateEventCallback(lv_event_t *event);
-    static void onTouchDetectTimerCallback(struct _lv_timer_t *t);
+    static void onTouchDetectTimerCallback(void *user_data);
     static void onIndicatorBarScaleBackAnimationExecuteCallback(void *var, int32_t value);
     static void onIndicatorBarScaleBackAnimationReadyCallback(lv_anim_t *anim);
 
@@ -145,7 +146,7 @@ private:
     std::array<int, GESTURE_INDICATOR_BAR_TYPE_MAX>  _indicator_bar_min_lengths;
     std::array<int, GESTURE_INDICATOR_BAR_TYPE_MAX>  _indicator_bar_max_lengths;
     uint32_t _touch_start_tick;
-    ESP_Brookesia_LvTimer_t _detect_timer;
+    gui::LvTickSubscriberUniquePtr _detect_timer;
     ESP_Brookesia_LvObj_t _event_mask_obj;
     std::array<ESP_Brookesia_LvObj_t, GESTURE_INDICATOR_BAR_TYPE_MAX>  _indicator_bars;
     std::array<IndicatorBarAnimVar_t, GESTURE_INDICATOR_BAR_TYPE_MAX>  _indicator_bar_anim_var;
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
 #include <memory>
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_SPEAKER_KEYBOARD_ENABLE_DEBUG_LOG
@@ -176,6 +177,7 @@ bool Keyboard::del(void)
 
     _main_object = nullptr;
     _keyboard = nullptr;
+    _map_key_types.clear();
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
     return true;
@@ -292,77 +294,30 @@ bool Keyboard::processOnKeyboardDrawTask(lv_event_t *e)
     }
 
     {
+        // Only the pressed state is checked per key, its type and styles are known already
+        auto keyboard = _keyboard.get()->getNativeHandle();
+        auto &key_types = getKeyTypes(lv_buttonmatrix_get_map(keyboard));
         auto key_id = base_dsc->id1;
+        ESP_UTILS_CHECK_FALSE_RETURN(key_id < key_types.size(), false, "Invalid key id(%d)", static_cast<int>(key_id));
+
         bool pressed = false;
-        auto keyboard = _keyboard.get()->getNativeHandle();
         if ((lv_buttonmatrix_get_selected_button(keyboard) == key_id) && lv_obj_has_state(keyboard, LV_STATE_PRESSED)) {
             pressed = true;
         }
+        auto &key_style = _key_styles[key_types[key_id]][pressed];
 
-        const char *text = lv_buttonmatrix_get_button_text(keyboard, key_id);
         // Change the color for normal and active buttons
         lv_draw_fill_dsc_t *fill_draw_dsc = lv_draw_task_get_fill_dsc(draw_task);
         if (fill_draw_dsc) {
-            lv_color_t inactive_color = gui::toLvColor(_data.keyboard.normal_button_inactive_background_color.color);
-            lv_opa_t inactive_opa = _data.keyboard.normal_button_inactive_background_color.opacity;
-            lv_color_t active_color = gui::toLvColor(_data.keyboard.normal_button_active_background_color.color);
-            lv_opa_t active_opa = _data.keyboard.normal_button_active_background_color.opacity;
-
-            if (strcmp(text, LV_SYMBOL_OK) == 0) {
-                inactive_color = gui::toLvColor(
-                                     _is_keyboard_ok_enabled ? _data.keyboard.ok_button_enabled_background_color.color :
-                                     _data.keyboard.ok_button_disabled_background_color.color
-                                 );
-                inactive_opa = _is_keyboard_ok_enabled ? _data.keyboard.ok_button_enabled_background_color.opacity :
-                               _data.keyboard.ok_button_disabled_background_color.opacity;
-                active_color = gui::toLvColor(_data.keyboard.ok_button_active_background_color.color);
-                active_opa = _data.keyboard.ok_button_active_background_color.opacity;
-            } else if (std::find(keyboard_special_str.begin(), keyboard_special_str.end(), text) != keyboard_special_str.end()) {
-                inactive_color = gui::toLvColor(_data.keyboard.special_button_inactive_background_color.color);
-                inactive_opa = _data.keyboard.special_button_inactive_background_color.opacity;
-                active_color = gui::toLvColor(_data.keyboard.special_button_active_background_color.color);
-                active_opa = _data.keyboard.special_button_active_background_color.opacity;
-            }
-
-            fill_draw_dsc->color = (pressed && (strcmp(text, LV_KB_PHR_STR) != 0)) ? active_color : inactive_color;
-            fill_draw_dsc->opa = (pressed && (strcmp(text, LV_KB_PHR_STR) != 0)) ? active_opa : inactive_opa;
+            fill_draw_dsc->color = key_style.background_color;
+            fill_draw_dsc->opa = key_style.background_opa;
         }
         // Change the text font and color
         lv_draw_label_dsc_t *label_draw_dsc = lv_draw_task_get_label_dsc(draw_task);
         if (label_draw_dsc) {
-            const lv_font_t *font = static_cast<const lv_font_t *>(_data.keyboard.button_text_font.font_resource);
-
-            lv_color_t inactive_color = gui::toLvColor(_data.keyboard.normal_button_inactive_text_color.color);
-            lv_opa_t inactive_opa = _data.keyboard.normal_button_inactive_text_color.opacity;
-            lv_color_t active_color = gui::toLvColor(_data.keyboard.normal_button_active_text_color.color);
-            lv_opa_t active_opa = _data.keyboard.normal_button_active_text_color.opacity;
-
-            if (strcmp(text, LV_SYMBOL_OK) == 0) {
-                inactive_color = gui::toLvColor(
-                                     !_is_keyboard_ok_enabled ? _data.keyboard.ok_button_disabled_text_color.color :
-                                     _data.keyboard.normal_button_inactive_text_color.color
-                                 );
-                inactive_opa = !_is_keyboard_ok_enabled ? _data.keyboard.ok_button_disabled_text_color.opacity :
-                               _data.keyboard.normal_button_inactive_text_color.opacity;
-                active_color = gui::toLvColor(_data.keyboard.ok_button_active_text_color.color);
-                active_opa = _data.keyboard.ok_button_active_text_color.opacity;
-            } else if (std::find(keyboard_special_str.begin(), keyboard_special_str.end(), text) != keyboard_special_str.end()) {
-                inactive_color = gui::toLvColor(_data.keyboard.special_button_inactive_text_color.color);
-                inactive_opa = _data.keyboard.special_button_inactive_text_color.opacity;
-                active_color = gui::toLvColor(_data.keyboard.special_button_active_text_color.color);
-                active_opa = _data.keyboard.special_button_active_text_color.opacity;
-            }
-
-            // Use the internal symbol font for the symbol buttons
-            if (std::find(keyboard_symbol_str.begin(), keyboard_symbol_str.end(), text) != keyboard_symbol_str.end()) {
-                ESP_UTILS_CHECK_FALSE_RETURN(
-                    gui::getLvInternalFontBySize(_data.keyboard.button_text_font.size_px, &font), false, "Get font failed"
-                );
-            }
-
-            label_draw_dsc->font = font;
-            label_draw_dsc->color = pressed ? active_color : inactive_color;
-            label_draw_dsc->opa = pressed ? active_opa : inactive_opa;
+            label_draw_dsc->font = key_style.text_font;
+            label_draw_dsc->color = key_style.text_color;
+            label_draw_dsc->opa = key_style.text_opa;
         }
 
         on_keyboard_draw_task_signal(e);
@@ -391,7 +346,10 @@ bool Keyboard::setOkEnabled(bool enabled)
 
     ESP_UTILS_CHECK_FALSE_RETURN(isBegun(), false, "Not begun");
 
-    _is_keyboard_ok_enabled = enabled;
+    if (_is_keyboard_ok_enabled != enabled) {
+        _is_keyboard_ok_enabled = enabled;
+        ESP_UTILS_CHECK_FALSE_RETURN(updateKeyStyles(), false, "Update key styles failed");
+    }
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
     return true;
@@ -472,9 +430,120 @@ bool Keyboard::updateByNewData(void)
     ESP_UTILS_CHECK_FALSE_RETURN(
         _keyboard->setStyleAttribute(_data.keyboard.button_text_font), false, "Set button text font failed"
     );
+    ESP_UTILS_CHECK_FALSE_RETURN(updateKeyStyles(), false, "Update key styles failed");
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
     return true;
 }
 
+bool Keyboard::updateKeyStyles(void)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto &data = _data.keyboard;
+    auto text_font = static_cast<const lv_font_t *>(data.button_text_font.font_resource);
+    // Use the internal symbol font for the symbol buttons, or keep the font of the keyboard if there is none
+    const lv_font_t *symbol_font = nullptr;
+    if (!gui::getLvInternalFontBySize(data.button_text_font.size_px, &symbol_font)) {
+        ESP_UTILS_LOGE("Get symbol font(%d) failed", static_cast<int>(data.button_text_font.size_px));
+        symbol_font = text_font;
+    }
+
+    auto set_key_style = [this](
+                             KeyType type, bool pressed, const gui::StyleColor & background_color,
+                             const gui::StyleColor & text_color, const lv_font_t *text_font
+    ) {
+        _key_styles[type][pressed] = {
+            .background_color = gui::toLvColor(background_color.color),
+            .background_opa = background_color.opacity,
+            .text_color = gui::toLvColor(text_color.color),
+            .text_opa = text_color.opacity,
+            .text_font = text_font,
+        };
+    };
+
+    set_key_style(
+        KEY_TYPE_NORMAL, false, data.normal_button_inactive_background_color, data.normal_button_inactive_text_color,
+        text_font
+    );
+    set_key_style(
+        KEY_TYPE_NORMAL, true, data.normal_button_active_background_color, data.normal_button_active_text_color,
+        text_font
+    );
+    set_key_style(
+        KEY_TYPE_SPECIAL, false, data.special_button_inactive_background_color, data.special_button_inactive_text_color,
+        text_font
+    );
+    set_key_style(
+        KEY_TYPE_SPECIAL, true, data.special_button_active_background_color, data.special_button_active_text_color,
+        text_font
+    );
+    set_key_style(
+        KEY_TYPE_SYMBOL, false, data.special_button_inactive_background_color, data.special_button_inactive_text_color,
+        symbol_font
+    );
+    set_key_style(
+        KEY_TYPE_SYMBOL, true, data.special_button_active_background_color, data.special_button_active_text_color,
+        symbol_font
+    );
+    set_key_style(
+        KEY_TYPE_OK, false,
+        _is_keyboard_ok_enabled ? data.ok_button_enabled_background_color : data.ok_button_disabled_background_color,
+        _is_keyboard_ok_enabled ? data.normal_button_inactive_text_color : data.ok_button_disabled_text_color,
+        symbol_font
+    );
+    set_key_style(
+        KEY_TYPE_OK, true, data.ok_button_active_background_color, data.ok_button_active_text_color, symbol_font
+    );
+    // The placeholders never look pressed
+    set_key_style(
+        KEY_TYPE_PLACEHOLDER, false, data.normal_button_inactive_background_color,
+        data.normal_button_inactive_text_color, text_font
+    );
+    set_key_style(
+        KEY_TYPE_PLACEHOLDER, true, data.normal_button_inactive_background_color,
+        data.normal_button_active_text_color, text_font
+    );
+
+    return true;
+}
+
+const std::vector<Keyboard::KeyType> &Keyboard::getKeyTypes(const char *const *map)
+{
+    auto it = std::find_if(_map_key_types.begin(), _map_key_types.end(), [map](const auto & map_key_types) {
+        return map_key_types.first == map;
+    });
+    if (it != _map_key_types.end()) {
+        return it->second;
+    }
+
+    // The keys are classified once per map, the key index of LVGL doesn't count the line breaks
+    ESP_UTILS_LOGD("Classify keys of map(%p)", map);
+    std::vector<KeyType> key_types;
+    for (int i = 0; (map != nullptr) && (map[i][0] != '\0'); i++) {
+        const char *text = map[i];
+        if (strcmp(text, "\n") == 0) {
+            continue;
+        }
+        KeyType type = KEY_TYPE_NORMAL;
+        if (strcmp(text, LV_SYMBOL_OK) == 0) {
+            type = KEY_TYPE_OK;
+        } else if (strcmp(text, LV_KB_PHR_STR) == 0) {
+            type = KEY_TYPE_PLACEHOLDER;
+        } else if (
+            std::find(keyboard_symbol_str.begin(), keyboard_symbol_str.end(), text) != keyboard_symbol_str.end()
+        ) {
+            type = KEY_TYPE_SYMBOL;
+        } else if (
+            std::find(keyboard_special_str.begin(), keyboard_special_str.end(), text) != keyboard_special_str.end()
+        ) {
+            type = KEY_TYPE_SPECIAL;
+        }
+        key_types.push_back(type);
+    }
+    _map_key_types.emplace_back(map, std::move(key_types));
+
+    return _map_key_types.back().second;
+}
+
 } // namespace esp_brookesia::speaker
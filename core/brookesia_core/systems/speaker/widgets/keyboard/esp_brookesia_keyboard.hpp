@@ -5,7 +5,10 @@
  */
 #pragma once
 
+#include <array>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include "lvgl/esp_brookesia_lv.hpp"
 #include "systems/core/esp_brookesia_core.hpp"
 #include "boost/signals2/signal.hpp"
@@ -78,7 +81,26 @@ public:
     OnKeyboardValueChangedSignal on_keyboard_value_changed_signal;
     OnKeyboardDrawTaskSignal on_keyboard_draw_task_signal;
 private:
+    enum KeyType {
+        KEY_TYPE_NORMAL = 0,
+        KEY_TYPE_SPECIAL,
+        KEY_TYPE_SYMBOL,        // Special key drawn with the internal symbol font
+        KEY_TYPE_OK,
+        KEY_TYPE_PLACEHOLDER,
+        KEY_TYPE_MAX,
+    };
+
+    struct KeyStyle {
+        lv_color_t background_color;
+        lv_opa_t background_opa;
+        lv_color_t text_color;
+        lv_opa_t text_opa;
+        const lv_font_t *text_font;
+    };
+
     bool updateByNewData(void);
+    bool updateKeyStyles(void);
+    const std::vector<KeyType> &getKeyTypes(const char *const *map);
 
     bool processOnKeyboardValueChanged(lv_event_t *e);
     bool processOnKeyboardDrawTask(lv_event_t *e);
@@ -90,6 +112,10 @@ private:
     gui::LvContainerUniquePtr _main_object{nullptr};
     gui::LvObjectUniquePtr _keyboard{nullptr};
     int _last_keyboard_mode = static_cast<int>(LV_KEYBOARD_MODE_TEXT_LOWER);
+    // Styles of the keys by type, released then pressed, resolved from the stylesheet once
+    std::array<std::array<KeyStyle, 2>, KEY_TYPE_MAX> _key_styles = {};
+    // Types of the keys of each map the keyboard used, by key index
+    std::vector<std::pair<const char *const *, std::vector<KeyType>>> _map_key_types;
 
     static const std::vector<std::string_view> _keyboard_symbol_str;
     static const std::vector<std::string_view> _keyboard_special_str;
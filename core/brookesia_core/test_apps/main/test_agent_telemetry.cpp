@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_AI_FRAMEWORK && CONFIG_ESP_BROOKESIA_AI_FRAMEWORK_ENABLE_AGENT && \
+    CONFIG_ESP_BROOKESIA_AGENT_ENABLE_TELEMETRY
+#include <vector>
+#include "unity.h"
+#include "agent/agent_telemetry.h"
+
+#define TEST_MS(ms) (static_cast<int64_t>(ms) * 1000)
+
+// Record a full turn starting at `start_ms`, the server answers `server_ms` after the last uplink packet
+static void test_mark_turn(int start_ms, int server_ms)
+{
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_WAKE_WORD, TEST_MS(start_ms));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_VAD_END, TEST_MS(start_ms + 1000));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_LAST_UPLINK, TEST_MS(start_ms + 1010));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_LAST_UPLINK, TEST_MS(start_ms + 1020));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK, TEST_MS(start_ms + 1020 + server_ms));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK, TEST_MS(start_ms + 1500 + server_ms));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_FIRST_PLAYBACK, TEST_MS(start_ms + 1100 + server_ms));
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_COMPLETED, TEST_MS(start_ms + 3000 + server_ms));
+}
+
+TEST_CASE("test agent telemetry turns", "[esp-brookesia][agent][telemetry]")
+{
+    agent_telemetry_reset();
+    test_mark_turn(1000, 300);
+    // A follow-up utterance without wake word opens a new turn once the previous one got a reply
+    agent_telemetry_mark_at(AGENT_TELEMETRY_STAGE_VAD_END, TEST_MS(10000));
+    TEST_ASSERT_EQUAL(2, agent_telemetry_get_turn_count());
+
+    agent_telemetry_turn_t turn = {};
+    TEST_ASSERT_EQUAL(ESP_OK, agent_telemetry_get_turn(1, &turn));
+    // "First" stages keep the earliest timestamp, the last uplink keeps the latest one
+    TEST_ASSERT_EQUAL(TEST_MS(2020), turn.stage_us[AGENT_TELEMETRY_STAGE_LAST_UPLINK]);
+    TEST_ASSERT_EQUAL(TEST_MS(2320), turn.stage_us[AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK]);
+    TEST_ASSERT_EQUAL(0, turn.stage_us[AGENT_TELEMETRY_STAGE_SUBTITLE]);
+
+    TEST_ASSERT_EQUAL(ESP_OK, agent_telemetry_get_turn(0, &turn));
+    TEST_ASSERT_EQUAL(0, turn.stage_us[AGENT_TELEMETRY_STAGE_WAKE_WORD]);
+    TEST_ASSERT_EQUAL(TEST_MS(10000), turn.stage_us[AGENT_TELEMETRY_STAGE_VAD_END]);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, agent_telemetry_get_turn(2, &turn));
+
+    // The ring keeps the most recent turns only
+    agent_telemetry_reset();
+    for (int i = 0; i < CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM + 3; i++) {
+        test_mark_turn((i + 1) * 10000, 300);
+    }
+    TEST_ASSERT_EQUAL(CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM, agent_telemetry_get_turn_count());
+    agent_telemetry_reset();
+}
+
+TEST_CASE("test agent telemetry stats", "[esp-brookesia][agent][telemetry]")
+{
+    agent_telemetry_reset();
+    std::vector<int> server_ms;
+    for (int i = 0; i < CONFIG_ESP_BROOKESIA_AGENT_TELEMETRY_TURN_NUM; i++) {
+        server_ms.push_back((i + 1) * 100);
+        test_mark_turn((i + 1) * 10000, server_ms.back());
+    }
+
+    agent_telemetry_stats_t stats = {};
+    TEST_ASSERT_EQUAL(ESP_OK, agent_telemetry_get_stats(AGENT_TELEMETRY_STAGE_LAST_UPLINK,
+                      AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK, &stats));
+    TEST_ASSERT_EQUAL(server_ms.size(), stats.count);
+    TEST_ASSERT_EQUAL(TEST_MS(server_ms.front()), stats.min_us);
+    TEST_ASSERT_EQUAL(TEST_MS(server_ms.back()), stats.max_us);
+    // Nearest rank
+    TEST_ASSERT_EQUAL(TEST_MS(server_ms[(server_ms.size() + 1) / 2 - 1]), stats.p50_us);
+
+    // No turn got a subtitle
+    TEST_ASSERT_EQUAL(ESP_OK, agent_telemetry_get_stats(AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK,
+                      AGENT_TELEMETRY_STAGE_SUBTITLE, &stats));
+    TEST_ASSERT_EQUAL(0, stats.count);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, agent_telemetry_get_stats(AGENT_TELEMETRY_STAGE_MAX,
+                      AGENT_TELEMETRY_STAGE_SUBTITLE, &stats));
+
+    agent_telemetry_dump(AGENT_TELEMETRY_FORMAT_JSON);
+    agent_telemetry_reset();
+}
+
+TEST_CASE("test agent telemetry binary export", "[esp-brookesia][agent][telemetry]")
+{
+    agent_telemetry_reset();
+    test_mark_turn(1000, 300);
+    test_mark_turn(20000, 500);
+
+    size_t length = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, agent_telemetry_export_binary(NULL, 0, &length));
+    TEST_ASSERT_EQUAL(6 + 2 * (4 + 8 + 4 * AGENT_TELEMETRY_STAGE_MAX), length);
+
+    std::vector<uint8_t> buffer(length);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, agent_telemetry_export_binary(buffer.data(), length - 1, &length));
+    TEST_ASSERT_EQUAL(ESP_OK, agent_telemetry_export_binary(buffer.data(), buffer.size(), &length));
+    TEST_ASSERT_EQUAL('A', buffer[0]);
+    TEST_ASSERT_EQUAL('T', buffer[1]);
+    TEST_ASSERT_EQUAL(AGENT_TELEMETRY_STAGE_MAX, buffer[3]);
+    TEST_ASSERT_EQUAL(2, buffer[4] | (buffer[5] << 8));
+
+    // Oldest turn first, its base is the wake word and the subtitle is missing
+    const uint8_t *turn = buffer.data() + 6;
+    auto get_u32 = [](const uint8_t *p) {
+        return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24));
+    };
+    TEST_ASSERT_EQUAL(TEST_MS(1000), get_u32(turn + 4));
+    TEST_ASSERT_EQUAL(0, get_u32(turn + 12 + 4 * AGENT_TELEMETRY_STAGE_WAKE_WORD));
+    TEST_ASSERT_EQUAL(TEST_MS(1320), get_u32(turn + 12 + 4 * AGENT_TELEMETRY_STAGE_FIRST_DOWNLINK));
+    TEST_ASSERT_EQUAL(UINT32_MAX, get_u32(turn + 12 + 4 * AGENT_TELEMETRY_STAGE_SUBTITLE));
+
+    agent_telemetry_dump(AGENT_TELEMETRY_FORMAT_BINARY);
+    agent_telemetry_reset();
+}
+#endif
@@ -8,6 +8,8 @@
 #include "unity_test_runner.h"
 #include "unity_test_utils_memory.h"
 #include "esp_heap_caps.h"
+#include "esp_netif.h"
+#include "esp_brookesia.hpp"
 
 // Some resources are lazy allocated in the LCD driver, the threadhold is left for that case
 #define TEST_MEMORY_LEAK_THRESHOLD  (300)
@@ -53,5 +55,13 @@ extern "C" void app_main(void)
     printf("| $$_____ |  \\__| $$| $$              | $$__/ $$| $$      | $$__/ $$| $$__/ $$| $$$$$$\\ | $$$$$$$$ _\\$$$$$$\\| $$|  $$$$$$$\r\n");
     printf("| $$     \\ \\$$    $$| $$              | $$    $$| $$       \\$$    $$ \\$$    $$| $$  \\$$\\ \\$$     \\|       $$| $$ \\$$    $$\r\n");
     printf(" \\$$$$$$$$  \\$$$$$$  \\$$               \\$$$$$$$  \\$$        \\$$$$$$   \\$$$$$$  \\$$   \\$$  \\$$$$$$$ \\$$$$$$$  \\$$  \\$$$$$$$\r\n");
+#if ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR
+    // The workers live for the whole application, start them before any leak check
+    esp_brookesia::services::Executor::requestInstance().begin();
+#endif
+#if CONFIG_ESP_BROOKESIA_AI_FRAMEWORK_ENABLE_AGENT
+    // The network stack is never torn down, the agent tests talk to a stand-in server over loopback
+    ESP_ERROR_CHECK(esp_netif_init());
+#endif
     unity_run_menu();
 }
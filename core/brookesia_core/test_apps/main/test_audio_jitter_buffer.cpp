@@ -0,0 +1,187 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_AI_FRAMEWORK && CONFIG_ESP_BROOKESIA_AI_FRAMEWORK_ENABLE_AGENT
+#include <vector>
+#include "esp_log.h"
+#include "unity.h"
+#include "agent/audio_jitter_buffer.h"
+
+#define TEST_FRAME_MS       (60)
+#define TEST_PACKET_SIZE    (64)
+#define TEST_PULL_RETRY_MS  (5)
+
+static const char *TAG = "test_audio_jitter_buffer";
+
+static audio_jitter_buffer_cfg_t test_get_config(void)
+{
+    audio_jitter_buffer_cfg_t cfg = {
+        .packet_num = 32,
+        .packet_size = TEST_PACKET_SIZE,
+        .frame_ms = TEST_FRAME_MS,
+        .min_delay_ms = 60,
+        .max_delay_ms = 600,
+        .max_conceal_num = 2,
+    };
+    return cfg;
+}
+
+/**
+ * Replay a trace of arrival times (ms) against a consumer that behaves like the decoder: it pulls one packet every
+ * frame while playing and polls every few milliseconds while the buffer is filling up.
+ */
+static audio_jitter_buffer_stats_t test_replay_trace(const std::vector<int> &arrival_ms)
+{
+    audio_jitter_buffer_handle_t jb = NULL;
+    audio_jitter_buffer_cfg_t cfg = test_get_config();
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_create(&cfg, &jb));
+
+    uint8_t packet[TEST_PACKET_SIZE] = {};
+    size_t next_arrival = 0;
+    int next_pull_ms = 0;
+    int end_ms = arrival_ms.back() + 2000;
+    for (int now_ms = 0; now_ms <= end_ms; now_ms++) {
+        while ((next_arrival < arrival_ms.size()) && (arrival_ms[next_arrival] <= now_ms)) {
+            packet[0] = (uint8_t)next_arrival;
+            TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_push(jb, packet, sizeof(packet), (int64_t)now_ms * 1000));
+            next_arrival++;
+        }
+        if (now_ms < next_pull_ms) {
+            continue;
+        }
+        size_t len = 0;
+        audio_jitter_buffer_pull_result_t result = AUDIO_JITTER_BUFFER_PULL_WAIT;
+        TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_pull(jb, packet, sizeof(packet), (int64_t)now_ms * 1000, &len,
+                          &result));
+        next_pull_ms = now_ms + ((result == AUDIO_JITTER_BUFFER_PULL_WAIT) ? TEST_PULL_RETRY_MS : TEST_FRAME_MS);
+    }
+
+    audio_jitter_buffer_stats_t stats = {};
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_get_stats(jb, &stats));
+    audio_jitter_buffer_destroy(jb);
+
+    ESP_LOGI(TAG, "received: %d, played: %d, concealed: %d, dropped: %d, underruns: %d, jitter: %dms, target: %dms, "
+             "added latency: avg %dms / max %dms", (int)stats.received, (int)stats.played, (int)stats.concealed,
+             (int)stats.dropped, (int)stats.underruns, (int)stats.jitter_ms, (int)stats.target_delay_ms,
+             (int)stats.avg_added_latency_ms, (int)stats.max_added_latency_ms);
+
+    return stats;
+}
+
+TEST_CASE("test audio jitter buffer with a jittery real-time stream", "[esp-brookesia][agent][jitter_buffer]")
+{
+    // 40 packets paced at the frame rate with up to 25ms of lateness
+    static const int jitter_ms[] = {0, 10, 25, 5, 15, 0, 20, 8};
+    std::vector<int> trace;
+    for (int i = 0; i < 40; i++) {
+        trace.push_back(i * TEST_FRAME_MS + jitter_ms[i % (sizeof(jitter_ms) / sizeof(jitter_ms[0]))]);
+    }
+    audio_jitter_buffer_stats_t stats = test_replay_trace(trace);
+
+    TEST_ASSERT_EQUAL(40, stats.played);
+    TEST_ASSERT_EQUAL(0, stats.underruns);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+    TEST_ASSERT_LESS_OR_EQUAL(100, stats.max_added_latency_ms);
+}
+
+TEST_CASE("test audio jitter buffer with a burst stream", "[esp-brookesia][agent][jitter_buffer]")
+{
+    // The server usually sends speech faster than real time, a burst must not inflate the delay
+    std::vector<int> trace(24, 100);
+    audio_jitter_buffer_stats_t stats = test_replay_trace(trace);
+
+    TEST_ASSERT_EQUAL(24, stats.played);
+    TEST_ASSERT_EQUAL(0, stats.underruns);
+    TEST_ASSERT_EQUAL(0, stats.jitter_ms);
+    TEST_ASSERT_EQUAL(test_get_config().min_delay_ms, stats.target_delay_ms);
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_PULL_RETRY_MS, stats.max_added_latency_ms);
+}
+
+TEST_CASE("test audio jitter buffer with a network stall", "[esp-brookesia][agent][jitter_buffer]")
+{
+    // Real-time stream stalled for 400ms in the middle, then the late packets arrive together
+    std::vector<int> trace;
+    for (int i = 0; i < 30; i++) {
+        int arrival = i * TEST_FRAME_MS;
+        if ((i >= 10) && (i < 17)) {
+            arrival = 17 * TEST_FRAME_MS;
+        }
+        trace.push_back(arrival);
+    }
+    audio_jitter_buffer_stats_t stats = test_replay_trace(trace);
+
+    TEST_ASSERT_EQUAL(30, stats.played);
+    TEST_ASSERT_EQUAL(1, stats.underruns);
+    TEST_ASSERT_GREATER_THAN(0, stats.concealed);
+    // The stall is remembered, the next talk spurt starts with a larger delay
+    TEST_ASSERT_GREATER_THAN(test_get_config().min_delay_ms, stats.target_delay_ms);
+}
+
+TEST_CASE("test audio jitter buffer flush", "[esp-brookesia][agent][jitter_buffer]")
+{
+    audio_jitter_buffer_handle_t jb = NULL;
+    audio_jitter_buffer_cfg_t cfg = test_get_config();
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_create(&cfg, &jb));
+
+    uint8_t packet[TEST_PACKET_SIZE] = {};
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_push(jb, packet, sizeof(packet), 1000));
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, audio_jitter_buffer_push(jb, packet, TEST_PACKET_SIZE + 1, 1000));
+    TEST_ASSERT_EQUAL(8, audio_jitter_buffer_get_buffered_num(jb));
+
+    audio_jitter_buffer_stats_t stats = {};
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_get_stats(jb, &stats));
+    TEST_ASSERT_EQUAL(1, stats.oversized);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+
+    audio_jitter_buffer_flush(jb);
+    TEST_ASSERT_EQUAL(0, audio_jitter_buffer_get_buffered_num(jb));
+
+    size_t len = 0;
+    audio_jitter_buffer_pull_result_t result = AUDIO_JITTER_BUFFER_PULL_PACKET;
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_pull(jb, packet, sizeof(packet), 1000000, &len, &result));
+    TEST_ASSERT_EQUAL(AUDIO_JITTER_BUFFER_PULL_WAIT, result);
+    TEST_ASSERT_EQUAL(0, len);
+
+    audio_jitter_buffer_destroy(jb);
+}
+
+TEST_CASE("test audio jitter buffer end of a talk spurt", "[esp-brookesia][agent][jitter_buffer]")
+{
+    audio_jitter_buffer_handle_t jb = NULL;
+    audio_jitter_buffer_cfg_t cfg = test_get_config();
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_create(&cfg, &jb));
+
+    uint8_t packet[TEST_PACKET_SIZE] = {};
+    size_t len = 0;
+    audio_jitter_buffer_pull_result_t result = AUDIO_JITTER_BUFFER_PULL_WAIT;
+    for (int spurt = 0; spurt < 2; spurt++) {
+        int64_t start_us = (int64_t)spurt * 10000000;
+        for (int i = 0; i < 4; i++) {
+            TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_push(jb, packet, sizeof(packet), start_us));
+        }
+        // Only the first spurt is marked as ended, the second one ends like a network gap
+        if (spurt == 0) {
+            audio_jitter_buffer_mark_end(jb);
+        }
+        for (int i = 0; i < 4; i++) {
+            TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_pull(jb, packet, sizeof(packet), start_us, &len, &result));
+            TEST_ASSERT_EQUAL(AUDIO_JITTER_BUFFER_PULL_PACKET, result);
+        }
+        TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_pull(jb, packet, sizeof(packet), start_us, &len, &result));
+        TEST_ASSERT_EQUAL((spurt == 0) ? AUDIO_JITTER_BUFFER_PULL_WAIT : AUDIO_JITTER_BUFFER_PULL_CONCEALED, result);
+    }
+
+    audio_jitter_buffer_stats_t stats = {};
+    TEST_ASSERT_EQUAL(ESP_OK, audio_jitter_buffer_get_stats(jb, &stats));
+    TEST_ASSERT_EQUAL(8, stats.played);
+    TEST_ASSERT_EQUAL(1, stats.concealed);
+    TEST_ASSERT_EQUAL(0, stats.underruns);
+
+    audio_jitter_buffer_destroy(jb);
+}
+#endif
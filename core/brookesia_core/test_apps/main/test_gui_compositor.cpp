@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_GUI && CONFIG_ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+#include <string.h>
+#include <vector>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "gui/compositor/esp_brookesia_compositor.hpp"
+
+// Small screen, so the layers fit in the internal RAM of any target
+#define TEST_WIDTH          (120)
+#define TEST_HEIGHT         (90)
+#define TEST_KEY_COLOR      (0xF81F)
+#define TEST_BASE_COLOR     (0x001F)
+#define TEST_OVERLAY_COLOR  (0x07E0)
+#define TEST_FRAME_NUM      (60)
+// Subtitle bar at the bottom of the screen, like the widgets drawn over the animation
+#define TEST_BAR_Y          (TEST_HEIGHT - 20)
+
+using namespace esp_brookesia::gui;
+
+static const char *TAG = "test_gui_compositor";
+
+/**
+ * Stand-in for the panel: keeps the pushed pixels so the result of the composition can be checked
+ */
+struct TestPanel {
+    std::vector<uint16_t> pixels = std::vector<uint16_t>(TEST_WIDTH * TEST_HEIGHT, 0);
+    std::vector<const void *> pushed_data;
+    int pushes = 0;
+
+    Compositor::FlushCallback getCallback()
+    {
+        return [this](int x_start, int y_start, int x_end, int y_end, const void *data) {
+            auto src = static_cast<const uint16_t *>(data);
+            for (int y = y_start; y < y_end; y++, src += x_end - x_start) {
+                memcpy(&pixels[y * TEST_WIDTH + x_start], src, (x_end - x_start) * sizeof(uint16_t));
+            }
+            pushed_data.push_back(data);
+            pushes++;
+            return true;
+        };
+    }
+};
+
+static Compositor::Config test_get_config(void)
+{
+    return Compositor::Config{
+        .width = TEST_WIDTH,
+        .height = TEST_HEIGHT,
+        .key_color = TEST_KEY_COLOR,
+        .buffer_in_ext = false,
+    };
+}
+
+static void test_draw_bar(Compositor &compositor, bool is_visible)
+{
+    // LVGL flushes the bar in two strips, only the last one pushes the composed area
+    std::vector<uint16_t> strip(TEST_WIDTH * (TEST_HEIGHT - TEST_BAR_Y) / 2, TEST_KEY_COLOR);
+    if (is_visible) {
+        // Rounded corners: the first and last columns stay transparent
+        for (size_t i = 0; i < strip.size(); i++) {
+            int x = i % TEST_WIDTH;
+            strip[i] = ((x == 0) || (x == TEST_WIDTH - 1)) ? TEST_KEY_COLOR : TEST_OVERLAY_COLOR;
+        }
+    }
+    int strip_height = (TEST_HEIGHT - TEST_BAR_Y) / 2;
+    TEST_ASSERT_TRUE(compositor.updateOverlay(0, TEST_BAR_Y, TEST_WIDTH, TEST_BAR_Y + strip_height, strip.data(),
+                     false));
+    TEST_ASSERT_TRUE(compositor.updateOverlay(0, TEST_BAR_Y + strip_height, TEST_WIDTH, TEST_HEIGHT, strip.data(),
+                     true));
+}
+
+TEST_CASE("test gui compositor blends the overlay over the base", "[esp-brookesia][gui][compositor]")
+{
+    TestPanel panel;
+    Compositor compositor;
+    TEST_ASSERT_TRUE(compositor.begin(test_get_config(), panel.getCallback()));
+
+    std::vector<uint16_t> frame(TEST_WIDTH * TEST_HEIGHT, TEST_BASE_COLOR);
+    TEST_ASSERT_TRUE(compositor.updateBase(0, 0, TEST_WIDTH, TEST_HEIGHT, frame.data()));
+    // Without overlay, the frame itself goes to the panel
+    TEST_ASSERT_EQUAL(1, panel.pushes);
+    TEST_ASSERT_EQUAL_PTR(frame.data(), panel.pushed_data.back());
+
+    test_draw_bar(compositor, true);
+    // Two strips of one LVGL refresh are pushed once, as a single merged area
+    TEST_ASSERT_EQUAL(2, panel.pushes);
+    TEST_ASSERT_EQUAL_HEX16(TEST_BASE_COLOR, panel.pixels[(TEST_BAR_Y - 1) * TEST_WIDTH + 10]);
+    TEST_ASSERT_EQUAL_HEX16(TEST_OVERLAY_COLOR, panel.pixels[TEST_BAR_Y * TEST_WIDTH + 10]);
+    TEST_ASSERT_EQUAL_HEX16(TEST_BASE_COLOR, panel.pixels[TEST_BAR_Y * TEST_WIDTH]);
+    TEST_ASSERT_EQUAL_HEX16(TEST_BASE_COLOR, panel.pixels[TEST_HEIGHT * TEST_WIDTH - 1]);
+
+    // A new animation frame keeps the overlay on top
+    std::fill(frame.begin(), frame.end(), 0);
+    TEST_ASSERT_TRUE(compositor.updateBase(0, 0, TEST_WIDTH, TEST_HEIGHT, frame.data()));
+    TEST_ASSERT_NOT_EQUAL(frame.data(), panel.pushed_data.back());
+    TEST_ASSERT_EQUAL_HEX16(0, panel.pixels[10]);
+    TEST_ASSERT_EQUAL_HEX16(TEST_OVERLAY_COLOR, panel.pixels[(TEST_HEIGHT - 1) * TEST_WIDTH + 10]);
+    TEST_ASSERT_EQUAL_HEX16(0, panel.pixels[(TEST_HEIGHT - 1) * TEST_WIDTH]);
+
+    // Hiding the overlay shows the base again, and the frames are pushed as they are
+    test_draw_bar(compositor, false);
+    TEST_ASSERT_EQUAL_HEX16(0, panel.pixels[(TEST_HEIGHT - 1) * TEST_WIDTH + 10]);
+    TEST_ASSERT_TRUE(compositor.updateBase(0, 0, TEST_WIDTH, TEST_HEIGHT, frame.data()));
+    TEST_ASSERT_EQUAL_PTR(frame.data(), panel.pushed_data.back());
+
+    // A partial frame lands at its coordinates, clipped to the screen
+    std::vector<uint16_t> tile(40 * 40, TEST_BASE_COLOR);
+    TEST_ASSERT_TRUE(compositor.updateBase(TEST_WIDTH - 20, 20, TEST_WIDTH + 20, 60, tile.data()));
+    TEST_ASSERT_EQUAL_HEX16(TEST_BASE_COLOR, panel.pixels[40 * TEST_WIDTH + TEST_WIDTH - 1]);
+    TEST_ASSERT_EQUAL_HEX16(0, panel.pixels[40 * TEST_WIDTH + TEST_WIDTH - 21]);
+
+    Compositor::Stats stats = compositor.getStats();
+    TEST_ASSERT_EQUAL(panel.pushes, stats.frames);
+    TEST_ASSERT_EQUAL(2, stats.composed_frames);
+
+    TEST_ASSERT_TRUE(compositor.del());
+}
+
+static Compositor::Stats test_run_frames(bool has_overlay, int64_t &elapsed_us)
+{
+    TestPanel panel;
+    Compositor compositor;
+    TEST_ASSERT_TRUE(compositor.begin(test_get_config(), panel.getCallback()));
+
+    std::vector<uint16_t> frame(TEST_WIDTH * TEST_HEIGHT);
+    if (has_overlay) {
+        test_draw_bar(compositor, true);
+    }
+    compositor.resetStats();
+
+    int64_t start_us = esp_timer_get_time();
+    for (int i = 0; i < TEST_FRAME_NUM; i++) {
+        std::fill(frame.begin(), frame.end(), static_cast<uint16_t>(i));
+        TEST_ASSERT_TRUE(compositor.updateBase(0, 0, TEST_WIDTH, TEST_HEIGHT, frame.data()));
+        // The overlay is redrawn once in a while, e.g. a subtitle update
+        if (has_overlay && ((i % 10) == 0)) {
+            test_draw_bar(compositor, true);
+        }
+    }
+    elapsed_us = esp_timer_get_time() - start_us;
+
+    Compositor::Stats stats = compositor.getStats();
+    TEST_ASSERT_TRUE(compositor.del());
+
+    ESP_LOGI(TAG, "%s overlay: %.1f fps, %d frames (%d composed), flush %.1f KB/frame, overlay %.1f KB, "
+             "compose max %d us", has_overlay ? "with" : "without", TEST_FRAME_NUM * 1000000.0f / elapsed_us,
+             (int)stats.frames, (int)stats.composed_frames, stats.flush_bytes / 1024.0f / TEST_FRAME_NUM,
+             stats.overlay_bytes / 1024.0f, (int)stats.max_compose_us);
+
+    return stats;
+}
+
+TEST_CASE("test gui compositor frame rate and flush bandwidth", "[esp-brookesia][gui][compositor]")
+{
+    int64_t plain_us = 0;
+    int64_t overlay_us = 0;
+    Compositor::Stats plain = test_run_frames(false, plain_us);
+    Compositor::Stats overlay = test_run_frames(true, overlay_us);
+
+    // Every animation frame is pushed once, whatever the overlay
+    TEST_ASSERT_EQUAL(0, plain.composed_frames);
+    TEST_ASSERT_EQUAL(TEST_FRAME_NUM, plain.frames);
+    TEST_ASSERT_EQUAL(TEST_FRAME_NUM, overlay.composed_frames - TEST_FRAME_NUM / 10);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)TEST_FRAME_NUM * TEST_WIDTH * TEST_HEIGHT * 2, plain.flush_bytes);
+    // The overlay only adds the redrawn bar to the flush bandwidth
+    TEST_ASSERT_EQUAL_UINT64(
+        plain.flush_bytes + (uint64_t)(TEST_FRAME_NUM / 10) * TEST_WIDTH * (TEST_HEIGHT - TEST_BAR_Y) * 2,
+        overlay.flush_bytes
+    );
+}
+#endif
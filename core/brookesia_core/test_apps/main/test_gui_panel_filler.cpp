@@ -0,0 +1,252 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_GUI && CONFIG_ESP_BROOKESIA_GUI_ENABLE_PANEL_FILLER
+#include <string.h>
+#include <vector>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "gui/panel_filler/esp_brookesia_panel_filler.hpp"
+
+#define TEST_WIDTH          (120)
+#define TEST_HEIGHT         (90)
+#define TEST_LINES          (10)
+#define TEST_FRAME_COLOR    (0x07E0)
+#define TEST_STOP_NUM       (20)
+
+using namespace esp_brookesia::gui;
+
+static const char *TAG = "test_gui_panel_filler";
+
+/**
+ * Stand-in for the panel: keeps the pushed pixels, and the lowest free heap seen while they were pushed
+ */
+struct TestPanel {
+    std::vector<uint16_t> pixels = std::vector<uint16_t>(TEST_WIDTH * TEST_HEIGHT, TEST_FRAME_COLOR);
+    int draws = 0;
+    int panel_fills = 0;
+    size_t min_free_size = SIZE_MAX;
+
+    PanelFiller::DrawCallback getDrawCallback()
+    {
+        return [this](int x_start, int y_start, int x_end, int y_end, const void *data) {
+            auto src = static_cast<const uint16_t *>(data);
+            for (int y = y_start; y < y_end; y++, src += x_end - x_start) {
+                memcpy(&pixels[y * TEST_WIDTH + x_start], src, (x_end - x_start) * sizeof(uint16_t));
+            }
+            min_free_size = std::min(min_free_size, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+            draws++;
+            return true;
+        };
+    }
+
+    PanelFiller::FillCallback getFillCallback(bool is_supported)
+    {
+        return [this, is_supported](int x_start, int y_start, int x_end, int y_end, uint16_t color) {
+            if (!is_supported) {
+                return false;
+            }
+            for (int y = y_start; y < y_end; y++) {
+                std::fill(&pixels[y * TEST_WIDTH + x_start], &pixels[y * TEST_WIDTH + x_end], color);
+            }
+            panel_fills++;
+            return true;
+        };
+    }
+
+    bool isFilled(int x_start, int y_start, int x_end, int y_end, uint16_t color) const
+    {
+        for (int y = y_start; y < y_end; y++) {
+            for (int x = x_start; x < x_end; x++) {
+                if (pixels[y * TEST_WIDTH + x] != color) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static PanelFiller::Config test_get_config(void)
+{
+    return PanelFiller::Config{
+        .max_width = TEST_WIDTH,
+        .lines = TEST_LINES,
+        .buffer_in_ext = false,
+        .swap_bytes = false,
+    };
+}
+
+TEST_CASE("test gui panel filler fills areas with the line buffer", "[esp-brookesia][gui][panel_filler]")
+{
+    TestPanel panel;
+    PanelFiller filler;
+    TEST_ASSERT_TRUE(filler.begin(test_get_config(), panel.getDrawCallback()));
+
+    TEST_ASSERT_TRUE(filler.fill(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_TRUE(panel.isFilled(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_EQUAL(TEST_HEIGHT / TEST_LINES, panel.draws);
+
+    // A narrow area takes more rows per transfer
+    TEST_ASSERT_TRUE(filler.fill(10, 5, 10 + TEST_WIDTH / 4, 5 + TEST_LINES * 4, 0x001F));
+    TEST_ASSERT_TRUE(panel.isFilled(10, 5, 10 + TEST_WIDTH / 4, 5 + TEST_LINES * 4, 0x001F));
+    TEST_ASSERT_EQUAL_HEX16(0, panel.pixels[4 * TEST_WIDTH + 10]);
+    TEST_ASSERT_EQUAL_HEX16(0, panel.pixels[5 * TEST_WIDTH + 9]);
+    TEST_ASSERT_EQUAL(TEST_HEIGHT / TEST_LINES + 1, panel.draws);
+
+    // Too wide for the buffer
+    TEST_ASSERT_FALSE(filler.fill(0, 0, TEST_WIDTH + 1, 1, 0));
+
+    PanelFiller::Stats stats = filler.getStats();
+    TEST_ASSERT_EQUAL(2, stats.fills);
+    TEST_ASSERT_EQUAL(panel.draws, stats.transfers);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)(TEST_WIDTH * TEST_HEIGHT + TEST_WIDTH / 4 * TEST_LINES * 4) * 2, stats.bytes);
+
+    TEST_ASSERT_TRUE(filler.del());
+}
+
+TEST_CASE("test gui panel filler prefers the panel fill", "[esp-brookesia][gui][panel_filler]")
+{
+    TestPanel panel;
+    PanelFiller filler;
+    TEST_ASSERT_TRUE(filler.begin(test_get_config(), panel.getDrawCallback(), panel.getFillCallback(true)));
+    TEST_ASSERT_TRUE(filler.fill(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_TRUE(panel.isFilled(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_EQUAL(1, panel.panel_fills);
+    TEST_ASSERT_EQUAL(0, panel.draws);
+    TEST_ASSERT_EQUAL(1, filler.getStats().panel_fills);
+    TEST_ASSERT_TRUE(filler.del());
+
+    // The line buffer takes over when the panel can't fill the area
+    TestPanel fallback_panel;
+    TEST_ASSERT_TRUE(filler.begin(
+                         test_get_config(), fallback_panel.getDrawCallback(), fallback_panel.getFillCallback(false)
+                     ));
+    TEST_ASSERT_TRUE(filler.fill(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_TRUE(fallback_panel.isFilled(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_EQUAL(TEST_HEIGHT / TEST_LINES, fallback_panel.draws);
+    TEST_ASSERT_EQUAL(0, filler.getStats().panel_fills);
+    TEST_ASSERT_TRUE(filler.del());
+}
+
+TEST_CASE("test gui panel filler fades out", "[esp-brookesia][gui][panel_filler]")
+{
+    constexpr int steps = 4;
+    TestPanel panel;
+    PanelFiller filler;
+    PanelFiller::Config config = test_get_config();
+    auto draw = panel.getDrawCallback();
+
+    // With the last frame, the area is blended into the color: green 63 -> 48 -> 32 -> 16 -> 0
+    std::vector<uint16_t> frame(TEST_WIDTH * TEST_HEIGHT, TEST_FRAME_COLOR);
+    std::vector<uint16_t> greens;
+    TEST_ASSERT_TRUE(filler.begin(config, [&](int x_start, int y_start, int x_end, int y_end, const void *data) {
+        if ((y_start == 0) && (x_start == 0)) {
+            greens.push_back((static_cast<const uint16_t *>(data)[0] >> 5) & 0x3F);
+        }
+        return draw(x_start, y_start, x_end, y_end, data);
+    }));
+    TEST_ASSERT_TRUE(filler.fadeOut(0, 0, TEST_WIDTH, TEST_HEIGHT, 0, frame.data(), steps, 1));
+    TEST_ASSERT_TRUE(panel.isFilled(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_EQUAL(steps, greens.size());
+    TEST_ASSERT_EQUAL(48, greens[0]);
+    TEST_ASSERT_EQUAL(32, greens[1]);
+    TEST_ASSERT_EQUAL(16, greens[2]);
+    TEST_ASSERT_EQUAL(0, greens[3]);
+    TEST_ASSERT_TRUE(filler.del());
+
+    // The channels of byte swapped pixels are blended the same way
+    config.swap_bytes = true;
+    std::fill(panel.pixels.begin(), panel.pixels.end(), TEST_FRAME_COLOR);
+    std::fill(frame.begin(), frame.end(), static_cast<uint16_t>((TEST_FRAME_COLOR >> 8) | (TEST_FRAME_COLOR << 8)));
+    greens.clear();
+    TEST_ASSERT_TRUE(filler.begin(config, [&](int x_start, int y_start, int x_end, int y_end, const void *data) {
+        if ((y_start == 0) && (x_start == 0)) {
+            uint16_t color = static_cast<const uint16_t *>(data)[0];
+            greens.push_back((static_cast<uint16_t>((color >> 8) | (color << 8)) >> 5) & 0x3F);
+        }
+        return draw(x_start, y_start, x_end, y_end, data);
+    }));
+    TEST_ASSERT_TRUE(filler.fadeOut(0, 0, TEST_WIDTH, TEST_HEIGHT, 0, frame.data(), steps, 1));
+    TEST_ASSERT_EQUAL(steps, greens.size());
+    TEST_ASSERT_EQUAL(48, greens[0]);
+    TEST_ASSERT_EQUAL(0, greens[3]);
+    TEST_ASSERT_TRUE(filler.del());
+
+    // Without the last frame, the rows are filled a few more at each step
+    config.swap_bytes = false;
+    std::fill(panel.pixels.begin(), panel.pixels.end(), TEST_FRAME_COLOR);
+    panel.draws = 0;
+    int step = 0;
+    TEST_ASSERT_TRUE(filler.begin(config, [&](int x_start, int y_start, int x_end, int y_end, const void *data) {
+        // One row at a time, going down the rows of the step
+        TEST_ASSERT_EQUAL(1, y_end - y_start);
+        step = y_start % steps;
+        for (int y = step; y < TEST_HEIGHT; y += steps) {
+            TEST_ASSERT_EQUAL_HEX16((y < y_start) ? 0 : TEST_FRAME_COLOR, panel.pixels[y * TEST_WIDTH]);
+        }
+        return draw(x_start, y_start, x_end, y_end, data);
+    }));
+    TEST_ASSERT_TRUE(filler.fadeOut(0, 0, TEST_WIDTH, TEST_HEIGHT, 0, nullptr, steps, 1));
+    TEST_ASSERT_EQUAL(steps - 1, step);
+    TEST_ASSERT_TRUE(panel.isFilled(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    TEST_ASSERT_EQUAL(TEST_HEIGHT, panel.draws);
+    TEST_ASSERT_TRUE(filler.del());
+}
+
+struct TestStopResult {
+    size_t allocated_bytes;
+    int64_t time_to_black_us;
+};
+
+static TestStopResult test_run_stops(bool use_filler)
+{
+    TestPanel panel;
+    PanelFiller filler;
+    if (use_filler) {
+        TEST_ASSERT_TRUE(filler.begin(test_get_config(), panel.getDrawCallback()));
+    }
+    auto draw = panel.getDrawCallback();
+
+    size_t free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    int64_t start_us = esp_timer_get_time();
+    for (int i = 0; i < TEST_STOP_NUM; i++) {
+        std::fill(panel.pixels.begin(), panel.pixels.end(), TEST_FRAME_COLOR);
+        if (use_filler) {
+            TEST_ASSERT_TRUE(filler.fill(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+        } else {
+            // What the `animation_stop_signal` handlers used to do
+            std::vector<uint8_t> buffer(TEST_WIDTH * TEST_HEIGHT * 2, 0);
+            TEST_ASSERT_TRUE(draw(0, 0, TEST_WIDTH, TEST_HEIGHT, buffer.data()));
+        }
+        TEST_ASSERT_TRUE(panel.isFilled(0, 0, TEST_WIDTH, TEST_HEIGHT, 0));
+    }
+    TestStopResult result = {
+        .allocated_bytes = free_size - std::min(free_size, panel.min_free_size),
+        .time_to_black_us = (esp_timer_get_time() - start_us) / TEST_STOP_NUM,
+    };
+
+    ESP_LOGI(TAG, "%s: %d bytes allocated per stop, %d us to black", use_filler ? "Panel filler" : "Frame buffer",
+             (int)result.allocated_bytes, (int)result.time_to_black_us);
+    if (use_filler) {
+        TEST_ASSERT_TRUE(filler.del());
+    }
+
+    return result;
+}
+
+TEST_CASE("test gui panel filler allocation and time to black", "[esp-brookesia][gui][panel_filler]")
+{
+    TestStopResult frame_buffer = test_run_stops(false);
+    TestStopResult panel_filler = test_run_stops(true);
+
+    // The line buffer is allocated once by `begin()`, nothing is allocated by the fills
+    TEST_ASSERT_EQUAL(0, panel_filler.allocated_bytes);
+    TEST_ASSERT_GREATER_OR_EQUAL(panel_filler.allocated_bytes, frame_buffer.allocated_bytes);
+}
+#endif
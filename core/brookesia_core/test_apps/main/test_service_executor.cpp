@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_brookesia.hpp"
+#if ESP_BROOKESIA_SERVICES_ENABLE_EXECUTOR
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "unity.h"
+#include "boost/thread.hpp"
+
+#define TEST_SOAK_ROUNDS            (20)
+#define TEST_SOAK_JOBS_PER_ROUND    (24)
+#define TEST_BASELINE_THREADS       (24)
+#define TEST_JOB_ALLOC_SIZE         (256)
+#define TEST_WAIT_TIMEOUT_MS        (5000)
+
+using esp_brookesia::services::Executor;
+
+static const char *TAG = "test_service_executor";
+
+static int test_get_fragmentation(void)
+{
+    size_t free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    return (free_size == 0) ? 0 : (100 - (int)(largest * 100 / free_size));
+}
+
+static void test_wait_count(std::atomic<int> &count, int expected, UBaseType_t &max_task_num)
+{
+    int waited_ms = 0;
+    while ((count < expected) && (waited_ms < TEST_WAIT_TIMEOUT_MS)) {
+        max_task_num = std::max(max_task_num, uxTaskGetNumberOfTasks());
+        vTaskDelay(pdMS_TO_TICKS(10));
+        waited_ms += 10;
+    }
+    TEST_ASSERT_EQUAL(expected, count.load());
+}
+
+TEST_CASE("test executor delayed job and cancel", "[esp-brookesia][services][executor]")
+{
+    auto &executor = Executor::requestInstance();
+    std::atomic<int> count = 0;
+
+    Executor::JobId id = Executor::INVALID_JOB_ID;
+    TEST_ASSERT_TRUE(executor.postDelayed([&count]() {
+        count += 100;
+    }, 200, Executor::Priority::Low, nullptr, &id));
+    TEST_ASSERT_TRUE(executor.postDelayed([&count]() {
+        count++;
+    }, 50, Executor::Priority::Low));
+    TEST_ASSERT_TRUE(executor.cancel(id));
+    TEST_ASSERT_FALSE(executor.cancel(id));
+
+    vTaskDelay(pdMS_TO_TICKS(300));
+    TEST_ASSERT_EQUAL(1, count.load());
+}
+
+TEST_CASE("test executor survives a throwing job", "[esp-brookesia][services][executor]")
+{
+    auto &executor = Executor::requestInstance();
+    std::atomic<int> count = 0;
+
+    Executor::Stats stats_before = {};
+    TEST_ASSERT_TRUE(executor.getStats(Executor::Priority::Low, stats_before));
+    TEST_ASSERT_TRUE(executor.post([]() {
+        throw std::runtime_error("test");
+    }, Executor::Priority::Low, "test_throw"));
+    // The worker of the priority still runs the next jobs
+    TEST_ASSERT_TRUE(executor.post([&count]() {
+        count++;
+    }, Executor::Priority::Low));
+
+    UBaseType_t max_task_num = 0;
+    test_wait_count(count, 1, max_task_num);
+    Executor::Stats stats_after = {};
+    TEST_ASSERT_TRUE(executor.getStats(Executor::Priority::Low, stats_after));
+    TEST_ASSERT_EQUAL(stats_before.failed + 1, stats_after.failed);
+}
+
+TEST_CASE("test executor soak against detached threads", "[esp-brookesia][services][executor][soak]")
+{
+    auto &executor = Executor::requestInstance();
+    UBaseType_t idle_task_num = uxTaskGetNumberOfTasks();
+    int frag_before = test_get_fragmentation();
+
+    // Baseline: one detached thread per job, as the call sites did before
+    UBaseType_t thread_max_task_num = idle_task_num;
+    std::atomic<int> thread_count = 0;
+    for (int i = 0; i < TEST_BASELINE_THREADS; i++) {
+        boost::thread([&thread_count]() {
+            void *buf = malloc(TEST_JOB_ALLOC_SIZE);
+            vTaskDelay(pdMS_TO_TICKS(5));
+            free(buf);
+            thread_count++;
+        }).detach();
+    }
+    test_wait_count(thread_count, TEST_BASELINE_THREADS, thread_max_task_num);
+    // Let the idle task reclaim the deleted threads
+    vTaskDelay(pdMS_TO_TICKS(100));
+    int frag_threads = test_get_fragmentation();
+
+    UBaseType_t executor_max_task_num = idle_task_num;
+    std::atomic<int> job_count = 0;
+    for (int round = 0; round < TEST_SOAK_ROUNDS; round++) {
+        for (int i = 0; i < TEST_SOAK_JOBS_PER_ROUND; i++) {
+            auto job = [&job_count]() {
+                void *buf = malloc(TEST_JOB_ALLOC_SIZE);
+                vTaskDelay(pdMS_TO_TICKS(1));
+                free(buf);
+                job_count++;
+            };
+            auto priority = static_cast<Executor::Priority>(i % static_cast<int>(Executor::Priority::Max));
+            if (i % 4 == 0) {
+                TEST_ASSERT_TRUE(executor.postDelayed(job, i, priority));
+            } else {
+                TEST_ASSERT_TRUE(executor.post(job, priority));
+            }
+        }
+        test_wait_count(job_count, (round + 1) * TEST_SOAK_JOBS_PER_ROUND, executor_max_task_num);
+    }
+    int frag_executor = test_get_fragmentation();
+
+    ESP_LOGI(TAG, "Detached threads: %d jobs, max tasks %d (idle %d), fragmentation %d%% -> %d%%",
+             TEST_BASELINE_THREADS, (int)thread_max_task_num, (int)idle_task_num, frag_before, frag_threads);
+    ESP_LOGI(TAG, "Executor: %d jobs, max tasks %d (idle %d), fragmentation %d%% -> %d%%",
+             TEST_SOAK_ROUNDS * TEST_SOAK_JOBS_PER_ROUND, (int)executor_max_task_num, (int)idle_task_num,
+             frag_threads, frag_executor);
+    executor.dumpStats();
+
+    // Posting jobs must never create a task
+    TEST_ASSERT_EQUAL(idle_task_num, executor_max_task_num);
+    for (int i = 0; i < static_cast<int>(Executor::Priority::Max); i++) {
+        Executor::Stats stats = {};
+        TEST_ASSERT_TRUE(executor.getStats(static_cast<Executor::Priority>(i), stats));
+        TEST_ASSERT_EQUAL(0, stats.queue_depth);
+        TEST_ASSERT_EQUAL(0, stats.rejected);
+    }
+}
+#endif
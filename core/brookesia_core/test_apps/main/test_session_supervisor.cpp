@@ -0,0 +1,315 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_AI_FRAMEWORK && CONFIG_ESP_BROOKESIA_AI_FRAMEWORK_ENABLE_AGENT
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_http_server.h"
+#include "esp_websocket_client.h"
+#include "unity.h"
+#include "boost/thread.hpp"
+#include "agent/session_supervisor.hpp"
+
+using esp_brookesia::ai_framework::SessionSupervisor;
+
+#define TEST_SERVER_PORT        (18090)
+#define TEST_SERVER_CTRL_PORT   (18091)
+#define TEST_WS_URI             "/ws"
+#define TEST_FRAME_SIZE         (160)   // 20ms of G711A at 8 kHz
+#define TEST_FRAME_MS           (20)
+#define TEST_OUTAGE_FRAME_NUM   (15)
+#define TEST_DISCONNECT_NUM     (3)
+#define TEST_WAIT_MS            (3000)
+#define TEST_SESSION_UPDATE     "{\"event_type\":\"chat.update\"}"
+
+static const char *TAG = "test_session_supervisor";
+
+struct TestStandIn {
+    httpd_handle_t server;
+    esp_websocket_client_handle_t client;
+    SessionSupervisor supervisor;
+    std::atomic<int> sockfd = -1;
+    std::atomic<int> server_audio_bytes = 0;
+    std::atomic<int> session_updates = 0;
+    std::atomic<bool> connected = false;
+    std::atomic<int> turn_audio_bytes = -1;
+};
+
+static TestStandIn *stand_in = nullptr;
+
+/* Stand-in of the chat server: it counts uplink audio and answers a "turn" with the audio received since the last
+ * one, which is what a recovered turn needs to be answered correctly */
+static esp_err_t test_ws_handler(httpd_req_t *req)
+{
+    if (req->method == HTTP_GET) {
+        stand_in->sockfd = httpd_req_to_sockfd(req);
+        return ESP_OK;
+    }
+
+    httpd_ws_frame_t frame = {};
+    esp_err_t ret = httpd_ws_recv_frame(req, &frame, 0);
+    if ((ret != ESP_OK) || (frame.len == 0)) {
+        return ret;
+    }
+    uint8_t *payload = (uint8_t *)calloc(1, frame.len + 1);
+    TEST_ASSERT_NOT_NULL(payload);
+    frame.payload = payload;
+    ret = httpd_ws_recv_frame(req, &frame, frame.len);
+    if (ret == ESP_OK) {
+        if (frame.type == HTTPD_WS_TYPE_BINARY) {
+            stand_in->server_audio_bytes += frame.len;
+        } else if ((frame.type == HTTPD_WS_TYPE_TEXT) && (strcmp((char *)payload, TEST_SESSION_UPDATE) == 0)) {
+            stand_in->session_updates++;
+        } else if ((frame.type == HTTPD_WS_TYPE_TEXT) && (strcmp((char *)payload, "turn") == 0)) {
+            char response[32];
+            snprintf(response, sizeof(response), "turn.done:%d", stand_in->server_audio_bytes.exchange(0));
+            httpd_ws_frame_t response_frame = {
+                .final = true,
+                .fragmented = false,
+                .type = HTTPD_WS_TYPE_TEXT,
+                .payload = (uint8_t *)response,
+                .len = strlen(response),
+            };
+            ret = httpd_ws_send_frame(req, &response_frame);
+        }
+    }
+    free(payload);
+
+    return ret;
+}
+
+static void test_ws_event_handler(void *arg, esp_event_base_t base, int32_t event_id, void *event_data)
+{
+    esp_websocket_event_data_t *data = (esp_websocket_event_data_t *)event_data;
+    switch (event_id) {
+    case WEBSOCKET_EVENT_CONNECTED:
+        stand_in->connected = true;
+        break;
+    case WEBSOCKET_EVENT_DISCONNECTED:
+    case WEBSOCKET_EVENT_ERROR:
+        stand_in->connected = false;
+        stand_in->supervisor.notifyDisconnected();
+        break;
+    case WEBSOCKET_EVENT_DATA: {
+        int bytes = 0;
+        if ((data->op_code == 0x1) && (data->data_len > 0) &&
+                (sscanf(data->data_ptr, "turn.done:%d", &bytes) == 1)) {
+            stand_in->turn_audio_bytes = bytes;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static bool test_wait_for(const std::function<bool()> &condition, int timeout_ms)
+{
+    for (int waited_ms = 0; waited_ms < timeout_ms; waited_ms += 5) {
+        if (condition()) {
+            return true;
+        }
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+// Same as the Coze glue: reopen the websocket, then replay the prepared session update
+static bool test_reconnect(int attempt)
+{
+    esp_websocket_client_stop(stand_in->client);
+    if (esp_websocket_client_start(stand_in->client) != ESP_OK) {
+        return false;
+    }
+    if (!test_wait_for([]() {
+        return stand_in->connected.load();
+    }, 1000)) {
+        return false;
+    }
+    return esp_websocket_client_send_text(stand_in->client, TEST_SESSION_UPDATE, strlen(TEST_SESSION_UPDATE),
+                                          pdMS_TO_TICKS(1000)) > 0;
+}
+
+static void test_start_stand_in(const SessionSupervisor::Config &config, std::atomic<bool> *gave_up)
+{
+    stand_in = new TestStandIn();
+    TEST_ASSERT_NOT_NULL(stand_in);
+
+    httpd_config_t server_config = HTTPD_DEFAULT_CONFIG();
+    server_config.server_port = TEST_SERVER_PORT;
+    server_config.ctrl_port = TEST_SERVER_CTRL_PORT;
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_start(&stand_in->server, &server_config));
+    httpd_uri_t uri = {
+        .uri = TEST_WS_URI,
+        .method = HTTP_GET,
+        .handler = test_ws_handler,
+        .user_ctx = NULL,
+        .is_websocket = true,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_register_uri_handler(stand_in->server, &uri));
+
+    esp_websocket_client_config_t client_config = {};
+    client_config.uri = "ws://127.0.0.1:18090" TEST_WS_URI;
+    client_config.disable_auto_reconnect = true;
+    stand_in->client = esp_websocket_client_init(&client_config);
+    TEST_ASSERT_NOT_NULL(stand_in->client);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_websocket_register_events(
+                          stand_in->client, WEBSOCKET_EVENT_ANY, test_ws_event_handler, NULL
+                      ));
+
+    TEST_ASSERT_TRUE(stand_in->supervisor.begin(config, {
+        .reconnect = test_reconnect,
+        .send = [](const uint8_t *data, size_t len)
+        {
+            return esp_websocket_client_send_bin(stand_in->client, (const char *)data, len, pdMS_TO_TICKS(1000)) ==
+                   (int)len;
+        },
+        .give_up = [gave_up]()
+        {
+            if (gave_up != nullptr) {
+                *gave_up = true;
+            }
+        },
+    }));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_websocket_client_start(stand_in->client));
+    TEST_ASSERT_TRUE(test_wait_for([]() {
+        return stand_in->connected.load();
+    }, TEST_WAIT_MS));
+    TEST_ASSERT_GREATER_THAN(0, esp_websocket_client_send_text(
+                                 stand_in->client, TEST_SESSION_UPDATE, strlen(TEST_SESSION_UPDATE), pdMS_TO_TICKS(1000)
+                             ));
+    stand_in->supervisor.notifyConnected();
+}
+
+static void test_stop_stand_in(void)
+{
+    stand_in->supervisor.end();
+    esp_websocket_client_stop(stand_in->client);
+    esp_websocket_client_destroy(stand_in->client);
+    if (stand_in->server != NULL) {
+        httpd_stop(stand_in->server);
+    }
+    delete stand_in;
+    stand_in = nullptr;
+}
+
+static int test_request_turn(void)
+{
+    stand_in->turn_audio_bytes = -1;
+    TEST_ASSERT_GREATER_THAN(0, esp_websocket_client_send_text(stand_in->client, "turn", 4, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_TRUE(test_wait_for([]() {
+        return stand_in->turn_audio_bytes >= 0;
+    }, TEST_WAIT_MS));
+    return stand_in->turn_audio_bytes.load();
+}
+
+static int test_send_frames(int num)
+{
+    uint8_t frame[TEST_FRAME_SIZE];
+    memset(frame, 0xd5, sizeof(frame));
+    for (int i = 0; i < num; i++) {
+        TEST_ASSERT_TRUE(stand_in->supervisor.sendAudio(frame, sizeof(frame)));
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(TEST_FRAME_MS));
+    }
+    return num * TEST_FRAME_SIZE;
+}
+
+TEST_CASE("test session supervisor resumes injected disconnects", "[esp-brookesia][agent][session_supervisor]")
+{
+    SessionSupervisor::Config config = SessionSupervisor::getDefaultConfig();
+    config.uplink_buffer_size = TEST_OUTAGE_FRAME_NUM * TEST_FRAME_SIZE;
+    test_start_stand_in(config, nullptr);
+
+    int max_turn_ms = 0;
+    for (int i = 0; i < TEST_DISCONNECT_NUM; i++) {
+        // Complete a turn first, so no audio is in flight when the connection drops
+        int sent_bytes = test_send_frames(5);
+        TEST_ASSERT_EQUAL(sent_bytes, test_request_turn());
+
+        // Drop the connection from the server side, the user keeps talking through the outage
+        int64_t disconnect_us = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(ESP_OK, httpd_sess_trigger_close(stand_in->server, stand_in->sockfd));
+        TEST_ASSERT_TRUE(test_wait_for([]() {
+            return stand_in->supervisor.getState() != SessionSupervisor::State::Connected;
+        }, TEST_WAIT_MS));
+        sent_bytes = test_send_frames(TEST_OUTAGE_FRAME_NUM);
+
+        TEST_ASSERT_TRUE(test_wait_for([]() {
+            return stand_in->supervisor.getState() == SessionSupervisor::State::Connected;
+        }, TEST_WAIT_MS));
+        sent_bytes += test_send_frames(5);
+        int turn_bytes = test_request_turn();
+        int turn_ms = (int)((esp_timer_get_time() - disconnect_us) / 1000);
+        max_turn_ms = std::max(max_turn_ms, turn_ms);
+
+        SessionSupervisor::Stats stats = stand_in->supervisor.getStats();
+        ESP_LOGI(TAG, "Disconnect %d: recovered in %d ms, turn answered %d ms after the drop, %d bytes buffered so far",
+                 i + 1, (int)stats.last_recovery_ms, turn_ms, (int)stats.buffered_bytes);
+        // No uplink audio is lost, including what was said during the outage
+        TEST_ASSERT_EQUAL(sent_bytes, turn_bytes);
+    }
+
+    SessionSupervisor::Stats stats = stand_in->supervisor.getStats();
+    TEST_ASSERT_EQUAL(TEST_DISCONNECT_NUM, stats.disconnects);
+    TEST_ASSERT_EQUAL(TEST_DISCONNECT_NUM, stats.recoveries);
+    TEST_ASSERT_EQUAL(0, stats.dropped_bytes);
+    TEST_ASSERT_EQUAL(TEST_DISCONNECT_NUM + 1, stand_in->session_updates);
+    // The outage itself takes `TEST_OUTAGE_FRAME_NUM` frames, the rest is the resume
+    TEST_ASSERT_LESS_THAN(TEST_OUTAGE_FRAME_NUM * TEST_FRAME_MS + 1000, max_turn_ms);
+
+    test_stop_stand_in();
+}
+
+TEST_CASE("test session supervisor backs off and gives up", "[esp-brookesia][agent][session_supervisor]")
+{
+    std::atomic<bool> gave_up = false;
+    SessionSupervisor::Config config = {
+        .initial_backoff_ms = 100,
+        .max_backoff_ms = 400,
+        .max_attempts = 4,
+        .uplink_buffer_size = 4 * TEST_FRAME_SIZE,
+    };
+    test_start_stand_in(config, &gave_up);
+
+    // The server goes away for good
+    int64_t disconnect_us = esp_timer_get_time();
+    httpd_stop(stand_in->server);
+    stand_in->server = NULL;
+    TEST_ASSERT_TRUE(test_wait_for([]() {
+        return stand_in->supervisor.getState() == SessionSupervisor::State::Reconnecting;
+    }, TEST_WAIT_MS));
+    test_send_frames(6);
+
+    TEST_ASSERT_TRUE(test_wait_for([&gave_up]() {
+        return gave_up.load();
+    }, 10000));
+    int give_up_ms = (int)((esp_timer_get_time() - disconnect_us) / 1000);
+    ESP_LOGI(TAG, "Gave up %d ms after the drop", give_up_ms);
+
+    SessionSupervisor::Stats stats = stand_in->supervisor.getStats();
+    TEST_ASSERT_EQUAL(config.max_attempts, stats.attempts);
+    TEST_ASSERT_EQUAL(1, stats.give_ups);
+    // Two frames did not fit the buffer, the four kept ones are dropped when giving up
+    TEST_ASSERT_EQUAL(6 * TEST_FRAME_SIZE, stats.dropped_bytes);
+    TEST_ASSERT_EQUAL(SessionSupervisor::State::Idle, stand_in->supervisor.getState());
+    // Attempts 2 to 4 wait at least half of 100, 200 and 400 ms
+    TEST_ASSERT_GREATER_OR_EQUAL(350, give_up_ms);
+
+    for (int attempt = 1; attempt < 8; attempt++) {
+        uint32_t nominal = std::min<uint32_t>(config.initial_backoff_ms << (attempt - 1), config.max_backoff_ms);
+        TEST_ASSERT_EQUAL(nominal / 2, SessionSupervisor::getBackoffDelay(config, attempt, 0));
+        TEST_ASSERT_LESS_OR_EQUAL(nominal, SessionSupervisor::getBackoffDelay(config, attempt, UINT32_MAX));
+    }
+    TEST_ASSERT_EQUAL(0, SessionSupervisor::getBackoffDelay(config, 0, UINT32_MAX));
+
+    test_stop_stand_in();
+}
+#endif
@@ -0,0 +1,280 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace esp_brookesia::utils {
+
+/**
+ * @brief String-keyed table whose key set is known once registration completes
+ *
+ * Every key gets an integer handle when it is added, in the order of addition, which stays the same until `clear()`.
+ * While keys are added, they are looked up in an ordered map. `freeze()` then builds a minimal perfect hash of the
+ * keys (hash and displace), so a lookup is one hash of the key, three table reads and one string compare. Adding a new
+ * key thaws the registry, it is back on the map until the next `freeze()`. Setting the value of a handle doesn't.
+ *
+ * Not thread-safe, like `std::map`: concurrent lookups are fine, but not with an addition.
+ */
+template <typename T>
+class FrozenRegistry {
+public:
+    using Handle = uint32_t;
+
+    static constexpr Handle HANDLE_NONE = std::numeric_limits<Handle>::max();
+
+    FrozenRegistry() = default;
+    // The index refers to the keys, which keep their address when the registry is moved, not when it is copied
+    FrozenRegistry(const FrozenRegistry &) = delete;
+    FrozenRegistry &operator=(const FrozenRegistry &) = delete;
+    FrozenRegistry(FrozenRegistry &&) = default;
+    FrozenRegistry &operator=(FrozenRegistry &&) = default;
+
+    /**
+     * @brief Add a key, or set its value if it is already there
+     *
+     * @return The handle of the key
+     */
+    Handle add(std::string_view key, T value)
+    {
+        Handle handle = find(key);
+        if (handle != HANDLE_NONE) {
+            _values[handle] = std::move(value);
+            return handle;
+        }
+
+        handle = static_cast<Handle>(_keys.size());
+        _keys.emplace_back(key);
+        _values.push_back(std::move(value));
+        _index.emplace(_keys.back(), handle);
+        _is_frozen = false;
+
+        return handle;
+    }
+
+    /**
+     * @brief Build the perfect hash of the keys, the lookups stay on the map if it can't be built
+     */
+    bool freeze()
+    {
+        if (_is_frozen) {
+            return true;
+        }
+        for (uint32_t seed = 0; seed < FREEZE_SEEDS_MAX; seed++) {
+            if (build(seed)) {
+                _is_frozen = true;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool isFrozen() const
+    {
+        return _is_frozen;
+    }
+
+    /**
+     * @brief Find the handle of a key
+     *
+     * @return The handle, or `HANDLE_NONE` if the key is not registered
+     */
+    Handle find(std::string_view key) const
+    {
+        if (!_is_frozen) {
+            auto it = _index.find(key);
+            return (it != _index.end()) ? it->second : HANDLE_NONE;
+        }
+        if (_slots.empty()) {
+            return HANDLE_NONE;
+        }
+
+        uint64_t hash = hashKey(key, _seed);
+        size_t slot = slotOf(hash, _displacements[bucketOf(hash)]);
+
+        return (_slot_keys[slot] == key) ? _slots[slot] : HANDLE_NONE;
+    }
+
+    /**
+     * @brief The value of a handle, valid until the next addition
+     *
+     * @return The value, or `nullptr` if the handle is invalid
+     */
+    T *get(Handle handle)
+    {
+        return (handle < _values.size()) ? &_values[handle] : nullptr;
+    }
+    const T *get(Handle handle) const
+    {
+        return (handle < _values.size()) ? &_values[handle] : nullptr;
+    }
+
+    /**
+     * @brief The value of a key, same as `get(find(key))`
+     */
+    T *get(std::string_view key)
+    {
+        return get(find(key));
+    }
+    const T *get(std::string_view key) const
+    {
+        return get(find(key));
+    }
+
+    const std::string &getKey(Handle handle) const
+    {
+        return _keys.at(handle);
+    }
+
+    size_t size() const
+    {
+        return _keys.size();
+    }
+
+    bool empty() const
+    {
+        return _keys.empty();
+    }
+
+    void clear()
+    {
+        _index.clear();
+        _keys.clear();
+        _values.clear();
+        _displacements.clear();
+        _slots.clear();
+        _slot_keys.clear();
+        _is_frozen = false;
+    }
+
+private:
+    // Each bucket holds 2 keys on average, the displacements of larger ones are searched first
+    static constexpr size_t KEYS_PER_BUCKET = 2;
+    static constexpr uint32_t DISPLACEMENT_MAX = std::numeric_limits<uint16_t>::max();
+    // Another seed is tried if the keys of a bucket can't be placed, a full 64-bit collision needs it
+    static constexpr uint32_t FREEZE_SEEDS_MAX = 8;
+
+    // Eight bytes of the key per multiply, then the finalizer of SplitMix64 mixes the seed and the length in
+    static uint64_t hashKey(std::string_view key, uint32_t seed)
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= key.size(); i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, key.data() + i, sizeof(word));
+            hash = (hash ^ word) * 0x100000001b3ULL;
+            hash ^= hash >> 29;
+        }
+        uint64_t tail = 0;
+        for (size_t shift = 0; i < key.size(); i++, shift += 8) {
+            tail |= static_cast<uint64_t>(static_cast<unsigned char>(key[i])) << shift;
+        }
+        hash = (hash ^ tail ^ (static_cast<uint64_t>(key.size()) << 56)) * 0xbf58476d1ce4e5b9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+        return hash ^ (hash >> 31);
+    }
+
+    // The high 32 bits of the hash scaled to the range, cheaper than a 64-bit modulo on the 32-bit targets
+    static size_t reduce(uint64_t hash, size_t range)
+    {
+        return static_cast<size_t>(((hash >> 32) * static_cast<uint64_t>(range)) >> 32);
+    }
+
+    size_t bucketOf(uint64_t hash) const
+    {
+        return reduce(hash, _displacements.size());
+    }
+
+    // One more multiply spreads the displaced hash over the slots, the hash itself is already mixed
+    size_t slotOf(uint64_t hash, uint16_t displacement) const
+    {
+        return reduce((hash ^ (displacement * 0x9e3779b97f4a7c15ULL)) * 0xbf58476d1ce4e5b9ULL, _slots.size());
+    }
+
+    bool build(uint32_t seed)
+    {
+        size_t key_num = _keys.size();
+        _seed = seed;
+        _slots.assign(key_num, HANDLE_NONE);
+        _displacements.assign(std::max<size_t>((key_num + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET, 1), 0);
+        if (key_num == 0) {
+            _slots.clear();
+            _slot_keys.clear();
+            return true;
+        }
+
+        std::vector<uint64_t> hashes(key_num);
+        std::vector<std::vector<Handle>> buckets(_displacements.size());
+        for (Handle handle = 0; handle < key_num; handle++) {
+            hashes[handle] = hashKey(_keys[handle], seed);
+            buckets[bucketOf(hashes[handle])].push_back(handle);
+        }
+        std::vector<size_t> order(buckets.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs) {
+            return buckets[lhs].size() > buckets[rhs].size();
+        });
+
+        std::vector<size_t> placed;
+        for (size_t bucket : order) {
+            auto &handles = buckets[bucket];
+            if (handles.empty()) {
+                break;
+            }
+            uint32_t displacement = 1;
+            for (; displacement <= DISPLACEMENT_MAX; displacement++) {
+                placed.clear();
+                for (Handle handle : handles) {
+                    size_t slot = slotOf(hashes[handle], displacement);
+                    if (_slots[slot] != HANDLE_NONE) {
+                        break;
+                    }
+                    _slots[slot] = handle;
+                    placed.push_back(slot);
+                }
+                if (placed.size() == handles.size()) {
+                    break;
+                }
+                for (size_t slot : placed) {
+                    _slots[slot] = HANDLE_NONE;
+                }
+            }
+            if (displacement > DISPLACEMENT_MAX) {
+                return false;
+            }
+            _displacements[bucket] = static_cast<uint16_t>(displacement);
+        }
+        _slot_keys.resize(key_num);
+        for (size_t slot = 0; slot < key_num; slot++) {
+            _slot_keys[slot] = _keys[_slots[slot]];
+        }
+
+        return true;
+    }
+
+    std::deque<std::string> _keys;                  // By handle, the views of the index stay valid in a deque
+    std::vector<T> _values;                         // By handle
+    std::map<std::string_view, Handle> _index;      // Lookups before `freeze()`
+    std::vector<uint16_t> _displacements;           // By bucket
+    std::vector<Handle> _slots;                     // Handles by perfect hash
+    std::vector<std::string_view> _slot_keys;       // Keys by perfect hash, compared without going through the deque
+    uint32_t _seed = 0;
+    bool _is_frozen = false;
+};
+
+} // namespace esp_brookesia::utils
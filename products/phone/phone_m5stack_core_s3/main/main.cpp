@@ -27,7 +27,7 @@ using namespace esp_brookesia::apps;
 
 static const char *TAG = "app_main";
 
-static void on_clock_update_timer_cb(struct _lv_timer_t *t);
+static void on_clock_update_timer_cb(ESP_Brookesia_Phone *phone);
 
 extern "C" void app_main(void)
 {
@@ -75,8 +75,10 @@ extern "C" void app_main(void)
     assert(app_squareline && "Create app squareline failed");
     assert((phone->installApp(app_squareline) >= 0) && "Install app squareline failed");
 
-    /* Create a timer to update the clock */
-    lv_timer_create(on_clock_update_timer_cb, 1000, phone);
+    /* Subscribe to the UI ticks to update the clock, it may be late to share a wakeup with the other refreshes */
+    esp_brookesia::gui::LvTickScheduler::getInstance().subscribe([phone]() {
+        on_clock_update_timer_cb(phone);
+    }, {.period_ms = 1000, .slack_ms = 100});
 
     /* Release the lock */
     bsp_display_unlock();
@@ -117,11 +119,10 @@ extern "C" void app_main(void)
 #endif
 }
 
-static void on_clock_update_timer_cb(struct _lv_timer_t *t)
+static void on_clock_update_timer_cb(ESP_Brookesia_Phone *phone)
 {
     time_t now;
     struct tm timeinfo;
-    ESP_Brookesia_Phone *phone = (ESP_Brookesia_Phone *)t->user_data;
 
     time(&now);
     localtime_r(&now, &timeinfo);
@@ -27,7 +27,7 @@ using namespace esp_brookesia::apps;
 
 static const char *TAG = "app_main";
 
-static void on_clock_update_timer_cb(struct _lv_timer_t *t);
+static void on_clock_update_timer_cb(ESP_Brookesia_Phone *phone);
 
 extern "C" void app_main(void)
 {
@@ -81,8 +81,11 @@ extern "C" void app_main(void)
     assert(app_squareline && "Create app squareline failed");
     assert((phone->installApp(app_squareline) >= 0) && "Install app squareline failed");
 
-    /* Create a timer to update the clock */
-    assert(lv_timer_create(on_clock_update_timer_cb, 1000, phone) && "Create clock update timer failed");
+    /* Subscribe to the UI ticks to update the clock, it may be late to share a wakeup with the other refreshes */
+    assert((esp_brookesia::gui::LvTickScheduler::getInstance().subscribe([phone]() {
+        on_clock_update_timer_cb(phone);
+    }, {.period_ms = 1000, .slack_ms = 100}) != esp_brookesia::gui::LvTickScheduler::INVALID_ID) &&
+           "Create clock update timer failed");
 
     /* Release the lock */
     bsp_display_unlock();
@@ -122,11 +125,10 @@ extern "C" void app_main(void)
 #endif
 }
 
-static void on_clock_update_timer_cb(struct _lv_timer_t *t)
+static void on_clock_update_timer_cb(ESP_Brookesia_Phone *phone)
 {
     time_t now;
     struct tm timeinfo;
-    ESP_Brookesia_Phone *phone = (ESP_Brookesia_Phone *)t->user_data;
 
     time(&now);
     localtime_r(&now, &timeinfo);
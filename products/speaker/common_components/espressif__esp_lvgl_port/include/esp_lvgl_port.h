@@ -54,7 +54,8 @@ typedef struct {
     int task_affinity;        /*!< LVGL task pinned to core (-1 is no affinity) */
     int task_max_sleep_ms;    /*!< Maximum sleep in LVGL task */
     unsigned task_stack_caps; /*!< LVGL task stack memory capabilities (see esp_heap_caps.h) */
-    int timer_period_ms;      /*!< LVGL timer tick period in ms */
+    int timer_period_ms;      /*!< LVGL timer tick period in ms, 0 (LVGL 9 only) to read the tick from esp_timer instead of
+                                   incrementing it periodically (tickless) */
 } lvgl_port_cfg_t;
 
 /**
@@ -136,6 +136,29 @@ esp_err_t lvgl_port_remove_disp(lv_display_t *disp);
  */
 void lvgl_port_disp_set_dummy_draw(lv_display_t *disp, bool enable);
 
+/**
+ * @brief Callback taking over an area rendered by LVGL instead of the display driver
+ *
+ * @param disp LVGL display handle
+ * @param area Area on the panel, after rotation
+ * @param color_map Pixel data of the area, after rotation and byte swapping
+ * @param is_last True if the area is the last one of the current refresh
+ * @param user_data User data passed to `lvgl_port_disp_set_flush_hook()`
+ */
+typedef void (*lvgl_port_flush_hook_t)(lv_display_t *disp, const lv_area_t *area, uint8_t *color_map, bool is_last, void *user_data);
+
+/**
+ * @brief Set the flush hook to hand the areas rendered by LVGL to another drawing path (e.g. a compositor)
+ *
+ * @note The hook is called from the LVGL task and must have finished with the data when it returns. Dummy draw takes precedence over the hook.
+ * @note The hook and its user data are set under the LVGL port lock, so they never change during a flush.
+ *
+ * @param disp LVGL display handle
+ * @param hook Flush hook, NULL to send the areas to the display driver again
+ * @param user_data User data passed to the hook
+ */
+void lvgl_port_disp_set_flush_hook(lv_display_t *disp, lvgl_port_flush_hook_t hook, void *user_data);
+
 /**
  * @brief Take the transfer semaphore
  *
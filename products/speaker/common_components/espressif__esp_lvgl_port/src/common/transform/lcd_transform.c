@@ -0,0 +1,331 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_lvgl_port_transform.h"
+
+/* Side of the square tiles, in pixels. A 16x16 RGB565 tile reads 32 bytes from 16 source rows and writes 32 bytes to
+ * 16 destination rows, so the lines of both sides are still in the cache while the tile is rotated. */
+#define TILE_SIZE       (16)
+
+#if CONFIG_IDF_TARGET_ESP32S3
+/* PIE kernels work on 8x8 blocks */
+#define PIE_BLOCK_SIZE  (8)
+
+/* Transpose `blocks` 8x8 RGB565 blocks laid side by side in the source, see lcd_transpose_rgb565_esp32s3.S */
+extern void lcd_transpose_rgb565_esp(const uint16_t *src, uint16_t *dst, int32_t src_stride, int32_t dst_stride,
+                                     uint32_t blocks);
+#endif
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline int32_t min_i32(int32_t a, int32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/*
+ * Move the pixels of the source rectangle [x0, x1) x [y0, y1) to their transposed place, tile by tile: the pixel (x, y)
+ * goes to the destination row starting at `dst_row0 + x * dst_row_step` bytes, at the column `col0 + y * col_step`.
+ * Each destination row of a tile is written in one go, while its source pixels are read down a column of the tile.
+ */
+static void transpose_tiled_rgb565(const uint8_t *src, int32_t src_stride, int32_t x0, int32_t x1, int32_t y0,
+                                   int32_t y1, uint8_t *dst_row0, int32_t dst_row_step, int32_t col0, int32_t col_step)
+{
+    for (int32_t ty = y0; ty < y1; ty += TILE_SIZE) {
+        int32_t ty_end = min_i32(ty + TILE_SIZE, y1);
+        for (int32_t tx = x0; tx < x1; tx += TILE_SIZE) {
+            int32_t tx_end = min_i32(tx + TILE_SIZE, x1);
+            for (int32_t x = tx; x < tx_end; x++) {
+                uint16_t *d = (uint16_t *)(dst_row0 + x * dst_row_step);
+                const uint8_t *s = src + ty * src_stride + x * 2;
+                int32_t col = col0 + ty * col_step;
+                for (int32_t y = ty; y < ty_end; y++) {
+                    d[col] = *(const uint16_t *)s;
+                    s += src_stride;
+                    col += col_step;
+                }
+            }
+        }
+    }
+}
+
+static void transpose_tiled_rgb888(const uint8_t *src, int32_t src_stride, int32_t x0, int32_t x1, int32_t y0,
+                                   int32_t y1, uint8_t *dst_row0, int32_t dst_row_step, int32_t col0, int32_t col_step)
+{
+    for (int32_t ty = y0; ty < y1; ty += TILE_SIZE) {
+        int32_t ty_end = min_i32(ty + TILE_SIZE, y1);
+        for (int32_t tx = x0; tx < x1; tx += TILE_SIZE) {
+            int32_t tx_end = min_i32(tx + TILE_SIZE, x1);
+            for (int32_t x = tx; x < tx_end; x++) {
+                uint8_t *d = dst_row0 + x * dst_row_step;
+                const uint8_t *s = src + ty * src_stride + x * 3;
+                int32_t col = (col0 + ty * col_step) * 3;
+                for (int32_t y = ty; y < ty_end; y++) {
+                    d[col] = s[0];
+                    d[col + 1] = s[1];
+                    d[col + 2] = s[2];
+                    s += src_stride;
+                    col += col_step * 3;
+                }
+            }
+        }
+    }
+}
+
+#if CONFIG_IDF_TARGET_ESP32S3
+/*
+ * Transpose the whole 8x8 blocks at the top left of the source with PIE, see `transpose_tiled_rgb565()` for the other
+ * parameters. The blocks are only handled if the buffers are aligned as the PIE loads and stores need.
+ */
+static bool transpose_pie_rgb565(const uint8_t *src, int32_t src_stride, int32_t w_blocks, int32_t h_blocks,
+                                 uint8_t *dst_row0, int32_t dst_row_step, int32_t col0, int32_t col_step)
+{
+    /* The destination columns of a block go from left to right, so with a descending `col_step` the rows of the
+     * block are read from the bottom */
+    bool is_ascending = (col_step > 0);
+    int32_t block_src_step = is_ascending ? src_stride : -src_stride;
+    const uint8_t *block_src = is_ascending ? src : src + (PIE_BLOCK_SIZE - 1) * src_stride;
+    uint8_t *block_dst = dst_row0 + (is_ascending ? col0 : col0 - (PIE_BLOCK_SIZE - 1)) * 2;
+
+    if ((w_blocks == 0) || (h_blocks == 0) ||
+            (((uintptr_t)src & 0xf) != 0) || ((src_stride & 0xf) != 0) ||
+            (((uintptr_t)block_dst & 0x7) != 0) || ((dst_row_step & 0x7) != 0)) {
+        return false;
+    }
+
+    for (int32_t i = 0; i < h_blocks; i++) {
+        lcd_transpose_rgb565_esp(
+            (const uint16_t *)block_src, (uint16_t *)block_dst, block_src_step, dst_row_step, w_blocks
+        );
+        block_src += PIE_BLOCK_SIZE * src_stride;
+        block_dst += PIE_BLOCK_SIZE * col_step * 2;
+    }
+
+    return true;
+}
+#endif
+
+static void rotate_rows_180_rgb565(const uint8_t *src, uint8_t *dst, int32_t w, int32_t h, int32_t src_stride,
+                                   int32_t dst_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+        const uint16_t *s = (const uint16_t *)(src + y * src_stride);
+        uint16_t *d = (uint16_t *)(dst + (h - 1 - y) * dst_stride) + w - 1;
+        for (int32_t x = 0; x < w; x++) {
+            *d-- = s[x];
+        }
+    }
+}
+
+static void rotate_rows_180_rgb888(const uint8_t *src, uint8_t *dst, int32_t w, int32_t h, int32_t src_stride,
+                                   int32_t dst_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+        const uint8_t *s = src + y * src_stride;
+        uint8_t *d = dst + (h - 1 - y) * dst_stride + (w - 1) * 3;
+        for (int32_t x = 0; x < w; x++, s += 3, d -= 3) {
+            d[0] = s[0];
+            d[1] = s[1];
+            d[2] = s[2];
+        }
+    }
+}
+
+static void copy_rows(const uint8_t *src, uint8_t *dst, int32_t w_bytes, int32_t h, int32_t src_stride,
+                      int32_t dst_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+        memcpy(dst + y * dst_stride, src + y * src_stride, w_bytes);
+    }
+}
+
+/* Step through `i * num / den` for i = 0, 1, 2... without dividing for every pixel */
+typedef struct {
+    int32_t value;
+    int32_t quot;
+    int32_t rem;
+    int32_t den;
+    int32_t err;
+} scale_step_t;
+
+static inline void scale_step_init(scale_step_t *step, int32_t num, int32_t den)
+{
+    step->value = 0;
+    step->quot = num / den;
+    step->rem = num % den;
+    step->den = den;
+    step->err = 0;
+}
+
+static inline void scale_step_next(scale_step_t *step)
+{
+    step->value += step->quot;
+    step->err += step->rem;
+    if (step->err >= step->den) {
+        step->err -= step->den;
+        step->value++;
+    }
+}
+
+/* Blend 4 pixels, `fx` and `fy` being the weights of the right and bottom ones out of 256 */
+static inline uint32_t bilinear_channel(uint32_t c00, uint32_t c01, uint32_t c10, uint32_t c11, uint32_t fx,
+                                        uint32_t fy)
+{
+    uint32_t top = c00 * (256 - fx) + c01 * fx;
+    uint32_t bottom = c10 * (256 - fx) + c11 * fx;
+
+    return (top * (256 - fy) + bottom * fy + 32768) >> 16;
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_rotate_rgb565(const uint16_t *src, uint16_t *dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                             int32_t dst_stride, lvgl_port_rotate_t rotation)
+{
+    const uint8_t *s = (const uint8_t *)src;
+    uint8_t *d = (uint8_t *)dst;
+
+    switch (rotation) {
+    case LVGL_PORT_ROTATE_0:
+        copy_rows(s, d, src_w * 2, src_h, src_stride, dst_stride);
+        return;
+    case LVGL_PORT_ROTATE_180:
+        rotate_rows_180_rgb565(s, d, src_w, src_h, src_stride, dst_stride);
+        return;
+    default:
+        break;
+    }
+
+    /* 90: the source column x goes to the row (src_w - 1 - x), from left to right
+     * 270: the source column x goes to the row x, from right to left */
+    bool is_90 = (rotation == LVGL_PORT_ROTATE_90);
+    uint8_t *dst_row0 = is_90 ? d + (src_w - 1) * dst_stride : d;
+    int32_t dst_row_step = is_90 ? -dst_stride : dst_stride;
+    int32_t col0 = is_90 ? 0 : src_h - 1;
+    int32_t col_step = is_90 ? 1 : -1;
+    int32_t w_done = 0;
+    int32_t h_done = 0;
+
+#if CONFIG_IDF_TARGET_ESP32S3
+    int32_t w_blocks = src_w / PIE_BLOCK_SIZE;
+    int32_t h_blocks = src_h / PIE_BLOCK_SIZE;
+    if (transpose_pie_rgb565(s, src_stride, w_blocks, h_blocks, dst_row0, dst_row_step, col0, col_step)) {
+        w_done = w_blocks * PIE_BLOCK_SIZE;
+        h_done = h_blocks * PIE_BLOCK_SIZE;
+    }
+#endif
+
+    /* What is left by the PIE blocks: the right columns, then the bottom rows under the blocks */
+    transpose_tiled_rgb565(s, src_stride, w_done, src_w, 0, src_h, dst_row0, dst_row_step, col0, col_step);
+    transpose_tiled_rgb565(s, src_stride, 0, w_done, h_done, src_h, dst_row0, dst_row_step, col0, col_step);
+}
+
+void lvgl_port_rotate_rgb888(const uint8_t *src, uint8_t *dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                             int32_t dst_stride, lvgl_port_rotate_t rotation)
+{
+    switch (rotation) {
+    case LVGL_PORT_ROTATE_0:
+        copy_rows(src, dst, src_w * 3, src_h, src_stride, dst_stride);
+        return;
+    case LVGL_PORT_ROTATE_180:
+        rotate_rows_180_rgb888(src, dst, src_w, src_h, src_stride, dst_stride);
+        return;
+    default:
+        break;
+    }
+
+    bool is_90 = (rotation == LVGL_PORT_ROTATE_90);
+    transpose_tiled_rgb888(
+        src, src_stride, 0, src_w, 0, src_h, is_90 ? dst + (src_w - 1) * dst_stride : dst,
+        is_90 ? -dst_stride : dst_stride, is_90 ? 0 : src_h - 1, is_90 ? 1 : -1
+    );
+}
+
+void lvgl_port_scale_rgb565(const uint16_t *src, int32_t src_w, int32_t src_h, int32_t src_stride, uint16_t *dst,
+                            int32_t dst_w, int32_t dst_h, int32_t dst_stride, lvgl_port_scale_mode_t mode)
+{
+    scale_step_t step_y;
+    scale_step_init(&step_y, (mode == LVGL_PORT_SCALE_BILINEAR) ? src_h * 256 : src_h, dst_h);
+
+    for (int32_t y = 0; y < dst_h; y++, scale_step_next(&step_y)) {
+        uint16_t *d = (uint16_t *)((uint8_t *)dst + y * dst_stride);
+        scale_step_t step_x;
+
+        if (mode == LVGL_PORT_SCALE_NEAREST) {
+            const uint16_t *s = (const uint16_t *)((const uint8_t *)src + step_y.value * src_stride);
+            scale_step_init(&step_x, src_w, dst_w);
+            for (int32_t x = 0; x < dst_w; x++, scale_step_next(&step_x)) {
+                d[x] = s[step_x.value];
+            }
+            continue;
+        }
+
+        int32_t y0 = step_y.value >> 8;
+        uint32_t fy = step_y.value & 0xff;
+        const uint16_t *s0 = (const uint16_t *)((const uint8_t *)src + y0 * src_stride);
+        const uint16_t *s1 = (const uint16_t *)((const uint8_t *)src + min_i32(y0 + 1, src_h - 1) * src_stride);
+        scale_step_init(&step_x, src_w * 256, dst_w);
+        for (int32_t x = 0; x < dst_w; x++, scale_step_next(&step_x)) {
+            int32_t x0 = step_x.value >> 8;
+            int32_t x1 = min_i32(x0 + 1, src_w - 1);
+            uint32_t fx = step_x.value & 0xff;
+            uint32_t c00 = s0[x0];
+            uint32_t c01 = s0[x1];
+            uint32_t c10 = s1[x0];
+            uint32_t c11 = s1[x1];
+            uint32_t r = bilinear_channel(c00 >> 11, c01 >> 11, c10 >> 11, c11 >> 11, fx, fy);
+            uint32_t g = bilinear_channel((c00 >> 5) & 0x3f, (c01 >> 5) & 0x3f, (c10 >> 5) & 0x3f, (c11 >> 5) & 0x3f,
+                                          fx, fy);
+            uint32_t b = bilinear_channel(c00 & 0x1f, c01 & 0x1f, c10 & 0x1f, c11 & 0x1f, fx, fy);
+            d[x] = (uint16_t)((r << 11) | (g << 5) | b);
+        }
+    }
+}
+
+void lvgl_port_scale_rgb888(const uint8_t *src, int32_t src_w, int32_t src_h, int32_t src_stride, uint8_t *dst,
+                            int32_t dst_w, int32_t dst_h, int32_t dst_stride, lvgl_port_scale_mode_t mode)
+{
+    scale_step_t step_y;
+    scale_step_init(&step_y, (mode == LVGL_PORT_SCALE_BILINEAR) ? src_h * 256 : src_h, dst_h);
+
+    for (int32_t y = 0; y < dst_h; y++, scale_step_next(&step_y)) {
+        uint8_t *d = dst + y * dst_stride;
+        scale_step_t step_x;
+
+        if (mode == LVGL_PORT_SCALE_NEAREST) {
+            const uint8_t *s = src + step_y.value * src_stride;
+            scale_step_init(&step_x, src_w, dst_w);
+            for (int32_t x = 0; x < dst_w; x++, scale_step_next(&step_x), d += 3) {
+                const uint8_t *p = s + step_x.value * 3;
+                d[0] = p[0];
+                d[1] = p[1];
+                d[2] = p[2];
+            }
+            continue;
+        }
+
+        int32_t y0 = step_y.value >> 8;
+        uint32_t fy = step_y.value & 0xff;
+        const uint8_t *s0 = src + y0 * src_stride;
+        const uint8_t *s1 = src + min_i32(y0 + 1, src_h - 1) * src_stride;
+        scale_step_init(&step_x, src_w * 256, dst_w);
+        for (int32_t x = 0; x < dst_w; x++, scale_step_next(&step_x), d += 3) {
+            int32_t x0 = (step_x.value >> 8) * 3;
+            int32_t x1 = min_i32((step_x.value >> 8) + 1, src_w - 1) * 3;
+            uint32_t fx = step_x.value & 0xff;
+            for (int i = 0; i < 3; i++) {
+                d[i] = (uint8_t)bilinear_channel(s0[x0 + i], s0[x1 + i], s1[x0 + i], s1[x1 + i], fx, fy);
+            }
+        }
+    }
+}
@@ -113,6 +113,10 @@ esp_err_t lvgl_port_resume(void)
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(true);
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
+    } else if (lvgl_port_ctx.running && (lvgl_port_ctx.timer_period_ms == 0)) {
+        /* Tickless, the tick keeps counting by itself */
+        lv_timer_enable(true);
+        ret = ESP_OK;
     }
 
     return ret;
@@ -125,6 +129,9 @@ esp_err_t lvgl_port_stop(void)
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(false);
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
+    } else if (lvgl_port_ctx.running && (lvgl_port_ctx.timer_period_ms == 0)) {
+        lv_timer_enable(false);
+        ret = ESP_OK;
     }
 
     return ret;
@@ -311,8 +318,19 @@ static void lvgl_port_tick_increment(void *arg)
     xSemaphoreGive(lvgl_port_ctx.timer_mux);
 }
 
+static uint32_t lvgl_port_tick_get(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
 static esp_err_t lvgl_port_tick_init(void)
 {
+    if (lvgl_port_ctx.timer_period_ms == 0) {
+        /* Tickless, LVGL reads the time when it needs it, so nothing wakes the CPU while the task sleeps */
+        lv_tick_set_cb(lvgl_port_tick_get);
+        return ESP_OK;
+    }
+
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = &lvgl_port_tick_increment,
@@ -18,6 +18,7 @@
 #include "esp_lcd_panel_ops.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_transform.h"
 
 #define LVGL_PORT_PPA   (CONFIG_LVGL_PORT_ENABLE_PPA)
 
@@ -60,6 +61,8 @@ typedef struct {
     lv_display_t              *disp_drv;      /* LVGL display driver */
     lv_display_rotation_t     current_rotation;
     SemaphoreHandle_t         trans_sem;      /* Idle transfer mutex */
+    lvgl_port_flush_hook_t    flush_hook;     /* Takes over the rendered areas instead of the display driver */
+    void                      *flush_hook_user_data;
 #if LVGL_PORT_PPA
     lvgl_port_ppa_handle_t    ppa_handle;
 #endif //LVGL_PORT_PPA
@@ -658,7 +661,14 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
             lv_color_format_t cf = lv_display_get_color_format(drv);
             uint32_t w_stride = lv_draw_buf_width_to_stride(ww, cf);
             uint32_t h_stride = lv_draw_buf_width_to_stride(hh, cf);
-            if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
+            /* The destination stride follows the rotated width */
+            uint32_t dst_stride = (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) ? w_stride : h_stride;
+            if (cf == LV_COLOR_FORMAT_RGB565) {
+                /* Tiled kernels, with PIE on esp32s3 */
+                lvgl_port_rotate_rgb565((const uint16_t *)color_map, (uint16_t *)disp_ctx->draw_buffs[2], ww, hh, w_stride, dst_stride, (lvgl_port_rotate_t)disp_ctx->current_rotation);
+            } else if (cf == LV_COLOR_FORMAT_RGB888) {
+                lvgl_port_rotate_rgb888(color_map, (uint8_t *)disp_ctx->draw_buffs[2], ww, hh, w_stride, dst_stride, (lvgl_port_rotate_t)disp_ctx->current_rotation);
+            } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], hh, ww, h_stride, h_stride, LV_DISPLAY_ROTATION_180, cf);
             } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_90) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, LV_DISPLAY_ROTATION_90, cf);
@@ -684,7 +694,20 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
         _lvgl_port_transform_monochrome(drv, area, &color_map);
     }
 
-    if ((disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI) && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh)) {
+    /* Read the hook and its user data together, under the lock `lvgl_port_disp_set_flush_hook()` sets them with */
+    lvgl_port_lock(0);
+    lvgl_port_flush_hook_t flush_hook = disp_ctx->flush_hook;
+    void *flush_hook_user_data = disp_ctx->flush_hook_user_data;
+    lvgl_port_unlock();
+    if (flush_hook && !disp_ctx->flags.dummy_draw) {
+        const lv_area_t hook_area = {
+            .x1 = offsetx1,
+            .y1 = offsety1,
+            .x2 = offsetx2,
+            .y2 = offsety2,
+        };
+        flush_hook(drv, &hook_area, color_map, lv_disp_flush_is_last(drv), flush_hook_user_data);
+    } else if ((disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI) && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh)) {
         if (lv_disp_flush_is_last(drv)) {
             /* If the interface is I80 or SPI, this step cannot be used for drawing. */
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_disp_get_hor_res(drv), lv_disp_get_ver_res(drv), color_map);
@@ -699,7 +722,7 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
         }
     }
 
-    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh)) || disp_ctx->flags.dummy_draw) {
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh)) || disp_ctx->flags.dummy_draw || flush_hook) {
         lv_disp_flush_ready(drv);
     }
 }
@@ -771,6 +794,17 @@ void lvgl_port_disp_set_dummy_draw(lv_display_t *disp, bool enable)
     disp_ctx->flags.dummy_draw = enable;
 }
 
+void lvgl_port_disp_set_flush_hook(lv_display_t *disp, lvgl_port_flush_hook_t hook, void *user_data)
+{
+    assert(disp != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+    lvgl_port_lock(0);
+    disp_ctx->flush_hook_user_data = user_data;
+    disp_ctx->flush_hook = hook;
+    lvgl_port_unlock();
+}
+
 esp_err_t lvgl_port_disp_take_trans_sem(lv_display_t *disp, uint32_t timeout_ms)
 {
     assert(disp != NULL);
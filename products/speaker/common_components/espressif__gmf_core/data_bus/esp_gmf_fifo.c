@@ -26,6 +26,7 @@ typedef struct esp_esp_gmf_fifo_node {
     size_t                        buf_length;
     size_t                        valid_size;
     bool                          is_done;
+    uint8_t                      *slab_buf;  /* Buffer carved out of the FIFO slab, NULL for a node allocated on its own */
 } esp_gmf_fifo_node_t;
 
 /**
@@ -42,6 +43,9 @@ typedef struct {
     uint8_t              _is_write_done : 1;  /*!< Flag indicating if all writing operations to the FIFO have been completed. Set to 1 when writing is finished */
     uint8_t              _is_abort      : 1;  /*!< Flag indicating if an abort operation has been requested. Set to 1 to signal that FIFO operations should be aborted */
     uint8_t              align;               /*!< Alignment for the request buffer */
+    uint32_t             block_size;          /*!< Minimum buffer size of the nodes preallocated in the slab */
+    esp_gmf_fifo_node_t *slab_nodes;          /*!< All the nodes, allocated at once on the first write, NULL if not preallocated */
+    uint8_t             *slab;                /*!< Buffers of all the slab nodes, in one aligned allocation */
 } esp_gmf_fifo_t;
 
 static inline esp_gmf_fifo_node_t *esp_gmf_fifo_node_create(void)
@@ -87,6 +91,14 @@ static inline void esp_gmf_fifo_node_destroy(esp_gmf_fifo_node_t *node)
     if (!node) {
         return;
     }
+    if (node->slab_buf) {
+        // The node and its slab buffer are freed with the slab, only a buffer grown beyond the slab one is its own
+        if (node->buffer != node->slab_buf) {
+            esp_gmf_oal_free(node->buffer);
+        }
+        node->buffer = NULL;
+        return;
+    }
     if (node->buffer) {
         esp_gmf_oal_free(node->buffer);
         node->buffer = NULL;
@@ -94,6 +106,32 @@ static inline void esp_gmf_fifo_node_destroy(esp_gmf_fifo_node_t *node)
     esp_gmf_oal_free(node);
 }
 
+static inline esp_gmf_err_t esp_gmf_fifo_slab_create(esp_gmf_fifo_t *fifo, size_t buf_size)
+{
+    // Round the buffer size up so that every node buffer keeps the alignment
+    size_t stride = (buf_size + fifo->align - 1) & ~((size_t)fifo->align - 1);
+    fifo->slab_nodes = esp_gmf_oal_calloc(fifo->capacity, sizeof(esp_gmf_fifo_node_t));
+    ESP_GMF_MEM_CHECK(TAG, fifo->slab_nodes, return ESP_GMF_ERR_MEMORY_LACK);
+    fifo->slab = esp_gmf_oal_malloc_align(fifo->align, stride * fifo->capacity);
+    ESP_GMF_MEM_CHECK(TAG, fifo->slab, {
+        esp_gmf_oal_free(fifo->slab_nodes);
+        fifo->slab_nodes = NULL;
+        return ESP_GMF_ERR_MEMORY_LACK;
+    });
+    memset(fifo->slab, 0, stride * fifo->capacity);
+    for (int i = fifo->capacity - 1; i >= 0; i--) {
+        esp_gmf_fifo_node_t *node = &fifo->slab_nodes[i];
+        node->slab_buf = fifo->slab + stride * i;
+        node->buffer = node->slab_buf;
+        node->buf_length = buf_size;
+        node->next = fifo->empty_head;
+        fifo->empty_head = node;
+    }
+    fifo->node_cnt = fifo->capacity;
+    ESP_LOGD(TAG, "New a slab of %ld nodes, addr:%p, sz:%d", fifo->capacity, fifo->slab, buf_size);
+    return ESP_GMF_ERR_OK;
+}
+
 static inline void _gmf_fifo_handle_free(esp_gmf_fifo_handle_t handle)
 {
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
@@ -118,6 +156,8 @@ static inline void _gmf_fifo_handle_free(esp_gmf_fifo_handle_t handle)
     if (fifo->lock) {
         esp_gmf_oal_mutex_destroy(fifo->lock);
     }
+    esp_gmf_oal_free(fifo->slab);
+    esp_gmf_oal_free(fifo->slab_nodes);
     esp_gmf_oal_free(fifo);
 }
 
@@ -138,6 +178,7 @@ esp_gmf_err_t esp_gmf_fifo_create(int block_cnt, int block_size, esp_gmf_fifo_ha
     ESP_GMF_MEM_CHECK(TAG, fifo->lock, goto esp_gmf_fifo_err;);
 
     fifo->capacity = block_cnt;
+    fifo->block_size = block_size > 0 ? block_size : 0;
     fifo->node_cnt = 0;
     fifo->_is_write_done = 0;
     fifo->align = GMF_FIFO_DEFAULT_ALIGNMENT;
@@ -235,6 +276,14 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gm
     ESP_LOGD(TAG, "WR_ACQ+, hd:%p, wanted:%ld, ticks:%d", handle, wanted_size, block_ticks);
     esp_gmf_fifo_node_t *node = NULL;
     esp_gmf_oal_mutex_lock(fifo->lock);
+    if ((fifo->node_cnt == 0) && (fifo->slab_nodes == NULL)) {
+        // Preallocate all the nodes on the first write, once the alignment is settled, so that the
+        // steady state never touches the heap. Fall back to the nodes allocated one by one if it fails.
+        size_t buf_size = wanted_size > fifo->block_size ? wanted_size : fifo->block_size;
+        if (esp_gmf_fifo_slab_create(fifo, buf_size) != ESP_GMF_ERR_OK) {
+            ESP_LOGW(TAG, "Failed to preallocate %ld nodes of %d bytes, allocate them on demand", fifo->capacity, buf_size);
+        }
+    }
     if (fifo->empty_head == NULL) {
         if (fifo->node_cnt < fifo->capacity) {
             node = esp_gmf_fifo_node_with_buf_create(wanted_size, fifo->align);
@@ -258,8 +307,10 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gm
     }
     node = fifo->empty_head;
     if (node->buf_length < wanted_size) {
-        esp_gmf_oal_free(node->buffer);
-        node->buffer = esp_gmf_oal_malloc(wanted_size);
+        if (node->buffer != node->slab_buf) {
+            esp_gmf_oal_free(node->buffer);
+        }
+        node->buffer = esp_gmf_oal_malloc_align(fifo->align, wanted_size);
         ESP_GMF_NULL_CHECK(TAG, node->buffer, {esp_gmf_oal_mutex_unlock(fifo->lock); return ESP_GMF_ERR_MEMORY_LACK;});
         node->buf_length = wanted_size;
     }
@@ -93,6 +93,24 @@ typedef struct {
     esp_gmf_event_cb          event_receiver;  /*!< Event receiver function */
 } esp_gmf_element_ops_t;
 
+/**
+ * @brief  Profiling counters of an element, accumulated since the element was created or last reset
+ *
+ *         `process_us` is the time spent in the process function minus the time spent waiting in the acquire
+ *         callbacks of the element ports, which is accounted in `wait_us` instead. Only the callbacks of the
+ *         pipeline edge ports can block, so `wait_us` of the inner elements stays 0.
+ *
+ *         The times are only measured when `CONFIG_GMF_CORE_ENABLE_PROFILE` is set, they stay 0 otherwise.
+ */
+typedef struct {
+    uint32_t  process_cnt;     /*!< Number of process calls */
+    uint32_t  process_max_us;  /*!< Longest single process call, port waits excluded */
+    uint64_t  process_us;      /*!< Total time spent in the process calls, port waits excluded */
+    uint64_t  wait_us;         /*!< Total time spent waiting in the port acquire callbacks */
+    uint64_t  bytes_in;        /*!< Total valid bytes released on the input port */
+    uint64_t  bytes_out;       /*!< Total valid bytes released on the output port */
+} esp_gmf_element_prof_t;
+
 /**
  * @brief  Structure representing a GMF element
  */
@@ -113,6 +131,7 @@ typedef struct esp_gmf_element {
     esp_gmf_event_cb                event_func;     /*!< Event function */
     esp_gmf_method_t               *method;         /*!< It can access the data members and member functions of the objects */
     esp_gmf_cap_t                  *caps;           /*!< Element capabilities */
+    esp_gmf_element_prof_t          prof;           /*!< Profiling counters */
 
     /* Protect */
     void                           *ctx;            /*!< User Context */
@@ -491,6 +510,32 @@ esp_gmf_err_t esp_gmf_element_get_method(esp_gmf_element_handle_t handle, const
  */
 esp_gmf_err_t esp_gmf_element_get_caps(esp_gmf_element_handle_t handle, const esp_gmf_cap_t **caps);
 
+/**
+ * @brief  Get a snapshot of the profiling counters of the specific element
+ *
+ * @note  The counters are updated by the task running the element without lock, a snapshot taken while
+ *        the element runs may be off by the last process call
+ *
+ * @param[in]   handle  GMF element handle
+ * @param[out]  prof    Pointer to store the profiling counters
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the handle or prof is invalid
+ */
+esp_gmf_err_t esp_gmf_element_get_prof(esp_gmf_element_handle_t handle, esp_gmf_element_prof_t *prof);
+
+/**
+ * @brief  Clear the profiling counters of the specific element
+ *
+ * @param[in]  handle  GMF element handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_element_reset_prof(esp_gmf_element_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
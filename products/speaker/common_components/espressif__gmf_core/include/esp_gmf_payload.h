@@ -24,8 +24,32 @@ typedef struct {
     bool      is_done;         /*!< Flag indicating if this payload buffer marks the end of the stream */
     uint64_t  pts;             /*!< Presentation time stamp */
     uint8_t   needs_free : 1;  /*!< Flag indicating if the payload buffer needs to be freed by esp_gmf_payload_delete or not*/
+    uint8_t   is_pooled  : 1;  /*!< Flag indicating if the payload was taken from a payload pool, it goes back there on esp_gmf_payload_delete */
 } esp_gmf_payload_t;
 
+/**
+ * @brief  Handle to a GMF payload pool
+ *
+ *         A payload pool holds a fixed number of payloads whose buffers are carved out of one aligned slab, all
+ *         allocated when the pool is created. Taking a payload from the pool and deleting it with
+ *         `esp_gmf_payload_delete` never touch the heap, unless the payload buffer has to grow beyond the slot size.
+ *         In that case the payload falls back to a heap buffer until it goes back to the pool, and the miss is counted.
+ */
+typedef struct esp_gmf_payload_pool *esp_gmf_payload_pool_handle_t;
+
+/**
+ * @brief  Statistics of a GMF payload pool
+ */
+typedef struct {
+    uint16_t  slot_cnt;      /*!< Number of payloads in the pool */
+    uint16_t  in_use;        /*!< Number of payloads currently taken from the pool */
+    uint16_t  peak_in_use;   /*!< Highest number of payloads taken at the same time */
+    uint32_t  buf_size;      /*!< Buffer size of each payload */
+    uint32_t  hit_cnt;       /*!< Number of payloads taken from the pool */
+    uint32_t  empty_cnt;     /*!< Number of requests failed because the pool was empty */
+    uint32_t  oversize_cnt;  /*!< Number of times a pooled payload buffer was reallocated on the heap */
+} esp_gmf_payload_pool_stats_t;
+
 /**
  * @brief  Create a new payload instance without buffer
  *
@@ -117,11 +141,66 @@ esp_gmf_err_t esp_gmf_payload_clean_done(esp_gmf_payload_t *instance);
 
 /**
  * @brief  Delete a payload instance, if needs_free is set free associated resources
+ *         A payload taken from a payload pool is returned to its pool instead
  *
  * @param[in]  instance  Payload instance to delete
  */
 void esp_gmf_payload_delete(esp_gmf_payload_t *instance);
 
+/**
+ * @brief  Create a payload pool with `slot_cnt` payloads of `buf_size` bytes each
+ *
+ * @param[in]   slot_cnt  Number of payloads in the pool
+ * @param[in]   buf_size  Buffer size of each payload
+ * @param[in]   align     Byte alignment of each payload buffer, 0 for the default alignment
+ * @param[out]  handle    Pointer to store the handle of the created payload pool
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Not enough memory to create the payload pool
+ */
+esp_gmf_err_t esp_gmf_payload_pool_create(uint16_t slot_cnt, uint32_t buf_size, uint8_t align, esp_gmf_payload_pool_handle_t *handle);
+
+/**
+ * @brief  Destroy a payload pool
+ *
+ * @note  The payloads still taken from the pool stay valid, the pool memory is released when the last of them is deleted
+ *
+ * @param[in]  handle  Payload pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_payload_pool_destroy(esp_gmf_payload_pool_handle_t handle);
+
+/**
+ * @brief  Take a payload from a payload pool, its buffer length is the slot size and its valid size is 0
+ *
+ * @param[in]   handle    Payload pool handle
+ * @param[out]  instance  Pointer to store the payload instance
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK            On success
+ *       - ESP_GMF_ERR_INVALID_ARG   Invalid argument provided
+ *       - ESP_GMF_ERR_NOT_ENOUGH    All the payloads are in use
+ *       - ESP_GMF_ERR_INVALID_STATE The pool is being destroyed
+ */
+esp_gmf_err_t esp_gmf_payload_pool_get(esp_gmf_payload_pool_handle_t handle, esp_gmf_payload_t **instance);
+
+/**
+ * @brief  Get the statistics of a payload pool
+ *
+ * @param[in]   handle  Payload pool handle
+ * @param[out]  stats   Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_payload_pool_get_stats(esp_gmf_payload_pool_handle_t handle, esp_gmf_payload_pool_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
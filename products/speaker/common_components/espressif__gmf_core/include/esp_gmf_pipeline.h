@@ -35,22 +35,23 @@ typedef esp_gmf_err_t (*esp_gmf_pipeline_prev_act)(void *handle);  /*!<  */
  * @brief  Structure representing a pipeline in GMF
  */
 typedef struct esp_gmf_pipeline {
-    esp_gmf_element_handle_t    head_el;        /*!< Handle of the first element in the pipeline */
-    esp_gmf_element_handle_t    last_el;        /*!< Handle of the last element in the pipeline */
-    esp_gmf_io_handle_t         in;             /*!< Handle of the input I/O port */
-    esp_gmf_io_handle_t         out;            /*!< Handle of the output I/O port */
-    esp_gmf_event_item_t       *evt_conveyor;   /*!< Event conveyor list */
-    esp_gmf_event_cb            evt_acceptor;   /*!< Event acceptor callback function */
-    esp_gmf_event_cb            user_cb;        /*!< User callback function */
-    void                       *user_ctx;       /*!< User context */
-    esp_gmf_event_state_t       state;          /*!< Current state of the pipeline */
-    esp_gmf_task_handle_t       thread;         /*!< Handle of the task associated with the pipeline */
-    esp_gmf_pipeline_prev_act   prev_run;       /*!< A pointer to the previous run callback */
-    esp_gmf_pipeline_prev_act   prev_stop;      /*!< A pointer to the previous stop callback */
-    void                       *prev_run_ctx;   /*!< The previous run context */
-    void                       *prev_stop_ctx;  /*!< The previous stop context */
-    uint8_t                     prev_state;     /*!< The previous action state */
-    void                       *lock;           /*!< Lock for thread synchronization */
+    esp_gmf_element_handle_t       head_el;        /*!< Handle of the first element in the pipeline */
+    esp_gmf_element_handle_t       last_el;        /*!< Handle of the last element in the pipeline */
+    esp_gmf_io_handle_t            in;             /*!< Handle of the input I/O port */
+    esp_gmf_io_handle_t            out;            /*!< Handle of the output I/O port */
+    esp_gmf_event_item_t          *evt_conveyor;   /*!< Event conveyor list */
+    esp_gmf_event_cb               evt_acceptor;   /*!< Event acceptor callback function */
+    esp_gmf_event_cb               user_cb;        /*!< User callback function */
+    void                          *user_ctx;       /*!< User context */
+    esp_gmf_event_state_t          state;          /*!< Current state of the pipeline */
+    esp_gmf_task_handle_t          thread;         /*!< Handle of the task associated with the pipeline */
+    esp_gmf_pipeline_prev_act      prev_run;       /*!< A pointer to the previous run callback */
+    esp_gmf_pipeline_prev_act      prev_stop;      /*!< A pointer to the previous stop callback */
+    void                          *prev_run_ctx;   /*!< The previous run context */
+    void                          *prev_stop_ctx;  /*!< The previous stop context */
+    uint8_t                        prev_state;     /*!< The previous action state */
+    void                          *lock;           /*!< Lock for thread synchronization */
+    esp_gmf_payload_pool_handle_t  payload_pool;   /*!< Pool of the port self payloads, NULL if not set up */
 } esp_gmf_pipeline_t;
 
 /**
@@ -330,6 +331,27 @@ esp_gmf_err_t esp_gmf_pipeline_pause(esp_gmf_pipeline_handle_t pipeline);
  */
 esp_gmf_err_t esp_gmf_pipeline_resume(esp_gmf_pipeline_handle_t pipeline);
 
+/**
+ * @brief  Set up a payload pool for the ports of the GMF pipeline elements
+ *
+ *         The pool holds one payload per port, and its buffers are allocated at once, so that the ports take their
+ *         self payloads from it instead of allocating them on the first acquisition. When `buf_size` is 0, the buffer
+ *         size is the largest data length and element data size of the ports. The pool is destroyed with the pipeline.
+ *
+ * @note  It must be called after all the ports are registered and before the pipeline runs,
+ *        the ports registered later still allocate their self payloads on the heap
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  buf_size  Buffer size of each payload, 0 to size it from the ports
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    If the pipeline handle is invalid, or the pipeline has no element
+ *       - ESP_GMF_ERR_INVALID_STATE  The payload pool is already set up
+ *       - ESP_GMF_ERR_MEMORY_LACK    Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_pipeline_setup_payload_pool(esp_gmf_pipeline_handle_t pipeline, uint32_t buf_size);
+
 /**
  * @brief  Reset the GMF pipeline to its initial state, including job lists, port states, and element states
  *         To run the pipeline again, `esp_gmf_pipeline_loading_jobs` must be called
@@ -514,6 +536,46 @@ esp_gmf_err_t esp_gmf_pipeline_report_info(esp_gmf_pipeline_handle_t pipeline, e
  */
 esp_gmf_err_t esp_gmf_pipeline_show(esp_gmf_pipeline_handle_t handle);
 
+/**
+ * @brief  Log the profile of a GMF pipeline in one line
+ *
+ *         The line holds the loop count, average and maximum loop time and overrun count of the bound task,
+ *         then for each element its average and maximum process time, port wait time, and bytes in and out:
+ *         `PROF [task] n:500 loop:312/2100us ovr:3 | ai_afe:250/900us w:9800ms i:640000 o:640000 | ...`
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ */
+esp_gmf_err_t esp_gmf_pipeline_log_prof(esp_gmf_pipeline_handle_t pipeline);
+
+/**
+ * @brief  Log the profile of a GMF pipeline periodically from its task, as `esp_gmf_pipeline_log_prof` does
+ *
+ * @param[in]  pipeline   GMF pipeline handle
+ * @param[in]  period_ms  Log period in milliseconds, 0 to stop logging
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    If the pipeline handle is invalid
+ *       - ESP_GMF_ERR_INVALID_STATE  No task is bound to the pipeline
+ *       - ESP_GMF_ERR_NOT_SUPPORT    `period_ms` is not 0 and `CONFIG_GMF_CORE_ENABLE_PROFILE` is not set
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_prof_log(esp_gmf_pipeline_handle_t pipeline, int period_ms);
+
+/**
+ * @brief  Clear the profiling counters of the GMF pipeline elements and of its bound task
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ */
+esp_gmf_err_t esp_gmf_pipeline_reset_prof(esp_gmf_pipeline_handle_t pipeline);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -13,6 +13,7 @@
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_oal_sys.h"
 #include "esp_memory_utils.h"
+#include "esp_timer.h"
 
 static const char *TAG = "ESP_GMF_OAL_SYS";
 
@@ -50,6 +51,11 @@ int64_t esp_gmf_oal_sys_get_time_ms(void)
     return milliseconds;
 }
 
+int64_t esp_gmf_oal_sys_get_time_us(void)
+{
+    return esp_timer_get_time();
+}
+
 #if (CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
 static TaskStatus_t *matched_status;
 
@@ -7,12 +7,14 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include "sdkconfig.h"
 #include "esp_log.h"
 #include "esp_gmf_element.h"
 
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_oal_thread.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_node.h"
 
 static const char *TAG = "ESP_GMF_ELEMENT";
@@ -80,6 +82,7 @@ esp_gmf_err_t esp_gmf_element_init(esp_gmf_element_handle_t handle, esp_gmf_elem
     el->out_attr.port.buf_size_aligned = config->out_attr.port.buf_size_aligned == 0 ? 1 : config->out_attr.port.buf_size_aligned;
 
     el->ctx = config->ctx;
+    memset(&el->prof, 0, sizeof(el->prof));
     el->job_mask = 0;
     return ESP_GMF_ERR_OK;
 }
@@ -277,7 +280,25 @@ esp_gmf_job_err_t esp_gmf_element_process_running(esp_gmf_element_handle_t handl
         ESP_LOGE(TAG, "There is no process function [%p-%s]", handle, OBJ_GET_TAG(handle));
         return ESP_GMF_ERR_FAIL;
     }
+#if CONFIG_GMF_CORE_ENABLE_PROFILE
+    // The ports add their acquire waits to `wait_us` meanwhile, take them out of the process time
+    uint64_t wait_us = el->prof.wait_us;
+    int64_t start_us = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_job_err_t ret = el->ops.process(el, NULL);
+    // A reset from another task may have cleared `wait_us` meanwhile
+    wait_us = (el->prof.wait_us >= wait_us) ? (el->prof.wait_us - wait_us) : el->prof.wait_us;
+    int64_t cost = esp_gmf_oal_sys_get_time_us() - start_us - (int64_t)wait_us;
+    uint32_t cost_us = cost > 0 ? (uint32_t)cost : 0;
+    el->prof.process_cnt++;
+    el->prof.process_us += cost_us;
+    if (cost_us > el->prof.process_max_us) {
+        el->prof.process_max_us = cost_us;
+    }
+    return ret;
+#else
+    el->prof.process_cnt++;
     return el->ops.process(el, NULL);
+#endif  /* CONFIG_GMF_CORE_ENABLE_PROFILE */
 }
 
 esp_gmf_job_err_t esp_gmf_element_process_close(esp_gmf_element_handle_t handle, void *para)
@@ -477,3 +498,20 @@ esp_gmf_err_t esp_gmf_element_get_caps(esp_gmf_element_handle_t handle, const es
     *caps = el->caps;
     return ESP_GMF_ERR_OK;
 }
+
+esp_gmf_err_t esp_gmf_element_get_prof(esp_gmf_element_handle_t handle, esp_gmf_element_prof_t *prof)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, prof, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    *prof = el->prof;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_element_reset_prof(esp_gmf_element_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    memset(&el->prof, 0, sizeof(el->prof));
+    return ESP_GMF_ERR_OK;
+}
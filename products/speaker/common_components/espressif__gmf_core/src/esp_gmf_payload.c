@@ -7,12 +7,95 @@
 
 #include "stdlib.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_payload.h"
 #include "esp_log.h"
 #include "string.h"
 
 static const char *TAG = "ESP_GMF_PAYLOAD";
 
+#define GMF_PAYLOAD_POOL_DEFAULT_ALIGNMENT (16)
+
+typedef struct esp_gmf_payload_slot {
+    esp_gmf_payload_t             load;      /*!< Payload handed out, must be the first member */
+    struct esp_gmf_payload_pool  *pool;      /*!< Pool the slot belongs to */
+    struct esp_gmf_payload_slot  *next;      /*!< Next free slot */
+    uint8_t                      *slab_buf;  /*!< Buffer of the slot inside the pool slab */
+    uint8_t                      *heap_buf;  /*!< Buffer allocated when the slab one is too small, NULL if none */
+} esp_gmf_payload_slot_t;
+
+struct esp_gmf_payload_pool {
+    esp_gmf_payload_slot_t       *slots;              /*!< Array of all the slots */
+    esp_gmf_payload_slot_t       *free_head;          /*!< Head of the free slot list */
+    uint8_t                      *slab;               /*!< Buffers of all the slots, in one aligned allocation */
+    void                         *lock;               /*!< Lock for the free list and the statistics */
+    esp_gmf_payload_pool_stats_t  stats;              /*!< Statistics of the pool */
+    uint8_t                       is_destroying : 1;  /*!< Destroy was called, the pool is freed when the last slot comes back */
+};
+
+static void payload_pool_free(struct esp_gmf_payload_pool *pool)
+{
+    if (pool->lock) {
+        esp_gmf_oal_mutex_destroy(pool->lock);
+    }
+    esp_gmf_oal_free(pool->slab);
+    esp_gmf_oal_free(pool->slots);
+    esp_gmf_oal_free(pool);
+}
+
+static void payload_pool_put(esp_gmf_payload_t *instance)
+{
+    esp_gmf_payload_slot_t *slot = (esp_gmf_payload_slot_t *)instance;
+    struct esp_gmf_payload_pool *pool = slot->pool;
+    if (slot->heap_buf) {
+        // The buffer grew beyond the slot size, go back to the slab one
+        esp_gmf_oal_free(slot->heap_buf);
+        slot->heap_buf = NULL;
+    }
+    memset(instance, 0, sizeof(esp_gmf_payload_t));
+    instance->buf = slot->slab_buf;
+    instance->buf_length = pool->stats.buf_size;
+    instance->needs_free = 1;
+    instance->is_pooled = 1;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    slot->next = pool->free_head;
+    pool->free_head = slot;
+    pool->stats.in_use--;
+    bool release = pool->is_destroying && (pool->stats.in_use == 0);
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    if (release) {
+        payload_pool_free(pool);
+    }
+}
+
+static esp_gmf_err_t payload_pool_realloc(esp_gmf_payload_t *instance, uint8_t align, uint32_t new_length)
+{
+    esp_gmf_payload_slot_t *slot = (esp_gmf_payload_slot_t *)instance;
+    struct esp_gmf_payload_pool *pool = slot->pool;
+    if ((new_length <= pool->stats.buf_size) && ((align == 0) || (((uintptr_t)slot->slab_buf % align) == 0))) {
+        if (slot->heap_buf) {
+            esp_gmf_oal_free(slot->heap_buf);
+            slot->heap_buf = NULL;
+        }
+        instance->buf = slot->slab_buf;
+        instance->buf_length = pool->stats.buf_size;
+        return ESP_GMF_ERR_OK;
+    }
+    uint8_t *buf = esp_gmf_oal_malloc_align(align, new_length);
+    ESP_GMF_NULL_CHECK(TAG, buf, { return ESP_GMF_ERR_MEMORY_LACK;});
+    if (slot->heap_buf) {
+        esp_gmf_oal_free(slot->heap_buf);
+    }
+    slot->heap_buf = buf;
+    ESP_LOGW(TAG, "Pooled payload:%p grows beyond the slot size, %ld > %ld", instance, new_length, pool->stats.buf_size);
+    instance->buf = buf;
+    instance->buf_length = new_length;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    pool->stats.oversize_cnt++;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_payload_new(esp_gmf_payload_t **instance)
 {
     if (instance == NULL) {
@@ -73,6 +156,9 @@ esp_gmf_err_t esp_gmf_payload_realloc_aligned_buf(esp_gmf_payload_t *instance, u
         ESP_LOGW(TAG, "Does not support reallocation of payload buffer that were allocated externally, p:%p, buf:%p, l:%d, new_l:%ld", instance, instance->buf, instance->buf_length, new_length);
         return ESP_GMF_ERR_NOT_SUPPORT;
     }
+    if (instance->is_pooled) {
+        return payload_pool_realloc(instance, align, new_length);
+    }
     uint8_t *buf = esp_gmf_oal_malloc_align(align, new_length);
     ESP_GMF_NULL_CHECK(TAG, buf, { return ESP_GMF_ERR_MEMORY_LACK;});
     if (instance->buf) {
@@ -110,6 +196,10 @@ void esp_gmf_payload_delete(esp_gmf_payload_t *instance)
 {
     ESP_LOGD(TAG, "Delete a payload, h:%p, needs_free:%d, buf:%p, l:%d", instance, instance != NULL ? instance->needs_free : -1,
              instance != NULL ? instance->buf : NULL, instance != NULL ? instance->buf_length : -1);
+    if (instance && instance->is_pooled) {
+        payload_pool_put(instance);
+        return;
+    }
     if (instance) {
         if (instance->needs_free) {
             esp_gmf_oal_free(instance->buf);
@@ -120,3 +210,100 @@ void esp_gmf_payload_delete(esp_gmf_payload_t *instance)
         esp_gmf_oal_free(instance);
     }
 }
+
+esp_gmf_err_t esp_gmf_payload_pool_create(uint16_t slot_cnt, uint32_t buf_size, uint8_t align, esp_gmf_payload_pool_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    if ((slot_cnt == 0) || (buf_size == 0)) {
+        ESP_LOGE(TAG, "Invalid parameters on %s, cnt:%d, sz:%ld", __func__, slot_cnt, buf_size);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    if (align == 0) {
+        align = GMF_PAYLOAD_POOL_DEFAULT_ALIGNMENT;
+    }
+    // Round the slot size up so that every slot buffer keeps the alignment
+    uint32_t stride = (buf_size + align - 1) & ~((uint32_t)align - 1);
+    struct esp_gmf_payload_pool *pool = esp_gmf_oal_calloc(1, sizeof(struct esp_gmf_payload_pool));
+    ESP_GMF_MEM_CHECK(TAG, pool, return ESP_GMF_ERR_MEMORY_LACK);
+    pool->slots = esp_gmf_oal_calloc(slot_cnt, sizeof(esp_gmf_payload_slot_t));
+    ESP_GMF_MEM_CHECK(TAG, pool->slots, goto _pool_create_fail);
+    pool->slab = esp_gmf_oal_malloc_align(align, (size_t)stride * slot_cnt);
+    ESP_GMF_MEM_CHECK(TAG, pool->slab, goto _pool_create_fail);
+    pool->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, pool->lock, goto _pool_create_fail);
+    pool->stats.slot_cnt = slot_cnt;
+    pool->stats.buf_size = buf_size;
+    for (int i = slot_cnt - 1; i >= 0; i--) {
+        esp_gmf_payload_slot_t *slot = &pool->slots[i];
+        slot->pool = pool;
+        slot->slab_buf = pool->slab + (size_t)stride * i;
+        slot->load.buf = slot->slab_buf;
+        slot->load.buf_length = buf_size;
+        slot->load.needs_free = 1;
+        slot->load.is_pooled = 1;
+        slot->next = pool->free_head;
+        pool->free_head = slot;
+    }
+    ESP_LOGD(TAG, "New a payload pool, h:%p, cnt:%d, sz:%ld, align:%d", pool, slot_cnt, buf_size, align);
+    *handle = pool;
+    return ESP_GMF_ERR_OK;
+
+_pool_create_fail:
+    payload_pool_free(pool);
+    return ESP_GMF_ERR_MEMORY_LACK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_destroy(esp_gmf_payload_pool_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    struct esp_gmf_payload_pool *pool = handle;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    pool->is_destroying = 1;
+    bool release = (pool->stats.in_use == 0);
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    ESP_LOGD(TAG, "Destroy a payload pool, h:%p, in use:%d", pool, pool->stats.in_use);
+    if (release) {
+        payload_pool_free(pool);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_get(esp_gmf_payload_pool_handle_t handle, esp_gmf_payload_t **instance)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, instance, return ESP_GMF_ERR_INVALID_ARG);
+    struct esp_gmf_payload_pool *pool = handle;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    *instance = NULL;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    if (pool->is_destroying) {
+        ret = ESP_GMF_ERR_INVALID_STATE;
+    } else if (pool->free_head == NULL) {
+        pool->stats.empty_cnt++;
+        ret = ESP_GMF_ERR_NOT_ENOUGH;
+    } else {
+        esp_gmf_payload_slot_t *slot = pool->free_head;
+        pool->free_head = slot->next;
+        slot->next = NULL;
+        pool->stats.in_use++;
+        pool->stats.hit_cnt++;
+        if (pool->stats.in_use > pool->stats.peak_in_use) {
+            pool->stats.peak_in_use = pool->stats.in_use;
+        }
+        *instance = &slot->load;
+    }
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    ESP_LOGD(TAG, "Get a pooled payload, pool:%p, h:%p, ret:%d", pool, *instance, ret);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_get_stats(esp_gmf_payload_pool_handle_t handle, esp_gmf_payload_pool_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    struct esp_gmf_payload_pool *pool = handle;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    *stats = pool->stats;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    return ESP_GMF_ERR_OK;
+}
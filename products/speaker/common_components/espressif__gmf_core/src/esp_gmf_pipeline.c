@@ -15,9 +15,19 @@
 
 #define PIPELINE_PRE_RUN_STATE  (1 << 0)
 #define PIPELINE_PRE_STOP_STATE (1 << 1)
+#define PIPELINE_PROF_LINE_SIZE (320)
 
 static const char *TAG = "ESP_GMF_PIPELINE";
 
+static void pipeline_log_prof(esp_gmf_pipeline_handle_t pipeline, const esp_gmf_task_prof_t *tsk_prof);
+
+static void pipeline_prof_log(esp_gmf_task_handle_t task, void *ctx)
+{
+    // Called by the task between two loops, its counters are read without the task lock, which the task APIs hold
+    // while they wait for the task
+    pipeline_log_prof((esp_gmf_pipeline_handle_t)ctx, &((esp_gmf_task_t *)task)->prof);
+}
+
 static inline void register_close_jobs_to_task(esp_gmf_pipeline_handle_t pipeline)
 {
     esp_gmf_node_t *node = (esp_gmf_node_t *)pipeline->head_el;
@@ -279,7 +289,15 @@ esp_gmf_err_t esp_gmf_pipeline_destroy(esp_gmf_pipeline_handle_t pipeline)
         esp_gmf_oal_free(item);
         item = tmp;
     }
+    if (pipeline->thread && (((esp_gmf_task_t *)pipeline->thread)->log_ctx == pipeline)) {
+        esp_gmf_task_set_prof_log(pipeline->thread, 0, NULL, NULL);
+    }
     esp_gmf_node_clear((esp_gmf_node_t **)&pipeline->head_el, (void *)esp_gmf_obj_delete);
+    if (pipeline->payload_pool) {
+        // Payloads still held by ports outside the pipeline keep the pool alive until they are deleted
+        esp_gmf_payload_pool_destroy(pipeline->payload_pool);
+        pipeline->payload_pool = NULL;
+    }
     esp_gmf_oal_mutex_unlock(pipeline->lock);
     esp_gmf_oal_mutex_destroy(pipeline->lock);
     esp_gmf_oal_free(pipeline);
@@ -517,6 +535,55 @@ esp_gmf_err_t esp_gmf_pipeline_resume(esp_gmf_pipeline_handle_t pipeline)
     return ret;
 }
 
+esp_gmf_err_t esp_gmf_pipeline_setup_payload_pool(esp_gmf_pipeline_handle_t pipeline, uint32_t buf_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, pipeline->head_el, return ESP_GMF_ERR_INVALID_ARG);
+    if (pipeline->payload_pool) {
+        ESP_LOGE(TAG, "The payload pool is already set up, [%p]", pipeline);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    uint16_t port_cnt = 0;
+    uint32_t max_size = 0;
+    uint8_t align = 0;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    // Size the pool from the caps of every port: the port data length, and the data size the element acquires
+    do {
+        esp_gmf_element_t *cur = (esp_gmf_element_t *)el;
+        max_size = (uint32_t)cur->in_attr.data_size > max_size ? (uint32_t)cur->in_attr.data_size : max_size;
+        max_size = (uint32_t)cur->out_attr.data_size > max_size ? (uint32_t)cur->out_attr.data_size : max_size;
+        esp_gmf_port_t *ports[] = {cur->in, cur->out};
+        for (int i = 0; i < (int)(sizeof(ports) / sizeof(ports[0])); i++) {
+            for (esp_gmf_port_t *port = ports[i]; port; port = port->next) {
+                port_cnt++;
+                max_size = (uint32_t)port->data_length > max_size ? (uint32_t)port->data_length : max_size;
+                align = port->attr.buf_addr_aligned > align ? port->attr.buf_addr_aligned : align;
+            }
+        }
+    } while ((el = (esp_gmf_element_handle_t)esp_gmf_node_for_next(el)));
+    if (buf_size == 0) {
+        buf_size = max_size;
+    }
+    if ((port_cnt == 0) || (buf_size == 0)) {
+        ESP_LOGE(TAG, "No port to pool, [%p], ports:%d, size:%ld", pipeline, port_cnt, buf_size);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_err_t ret = esp_gmf_payload_pool_create(port_cnt, buf_size, align, &pipeline->payload_pool);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to create the payload pool, [%p]", pipeline);
+    el = pipeline->head_el;
+    do {
+        esp_gmf_element_t *cur = (esp_gmf_element_t *)el;
+        esp_gmf_port_t *ports[] = {cur->in, cur->out};
+        for (int i = 0; i < (int)(sizeof(ports) / sizeof(ports[0])); i++) {
+            for (esp_gmf_port_t *port = ports[i]; port; port = port->next) {
+                esp_gmf_port_set_payload_pool(port, pipeline->payload_pool);
+            }
+        }
+    } while ((el = (esp_gmf_element_handle_t)esp_gmf_node_for_next(el)));
+    ESP_LOGI(TAG, "Payload pool set up, [%p], ports:%d, size:%ld, align:%d", pipeline, port_cnt, buf_size, align);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
@@ -706,3 +773,53 @@ esp_gmf_err_t esp_gmf_pipeline_show(esp_gmf_pipeline_handle_t pipeline)
     ESP_LOGI(TAG, "The OUT port, [%p-%s]", pipeline->out, OBJ_GET_TAG(pipeline->out));
     return ESP_GMF_ERR_OK;
 }
+
+static void pipeline_log_prof(esp_gmf_pipeline_handle_t pipeline, const esp_gmf_task_prof_t *tsk_prof)
+{
+    char line[PIPELINE_PROF_LINE_SIZE];
+    int len = 0;
+    uint32_t loop_avg = tsk_prof->loop_cnt ? (uint32_t)(tsk_prof->loop_us / tsk_prof->loop_cnt) : 0;
+    len = snprintf(line, sizeof(line), "PROF [%s] n:%ld loop:%ld/%ldus ovr:%ld", OBJ_GET_TAG(pipeline->thread),
+                   tsk_prof->loop_cnt, loop_avg, tsk_prof->loop_max_us, tsk_prof->overrun_cnt);
+    for (esp_gmf_element_handle_t el = pipeline->head_el; el && (len < (int)sizeof(line));
+         el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_element_prof_t *prof = &ESP_GMF_ELEMENT_GET(el)->prof;
+        uint32_t avg = prof->process_cnt ? (uint32_t)(prof->process_us / prof->process_cnt) : 0;
+        len += snprintf(line + len, sizeof(line) - len, " | %s:%ld/%ldus w:%ldms i:%llu o:%llu", OBJ_GET_TAG(el), avg,
+                        prof->process_max_us, (uint32_t)(prof->wait_us / 1000), prof->bytes_in, prof->bytes_out);
+    }
+    ESP_LOGI(TAG, "%s", line);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_log_prof(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_prof_t tsk_prof = {0};
+    if (pipeline->thread) {
+        esp_gmf_task_get_prof(pipeline->thread, &tsk_prof);
+    }
+    pipeline_log_prof(pipeline, &tsk_prof);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_prof_log(esp_gmf_pipeline_handle_t pipeline, int period_ms)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    if (pipeline->thread == NULL) {
+        ESP_LOGE(TAG, "No task bound to log the profile, [%p]", pipeline);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    return esp_gmf_task_set_prof_log(pipeline->thread, period_ms, pipeline_prof_log, pipeline);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_reset_prof(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    for (esp_gmf_element_handle_t el = pipeline->head_el; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_element_reset_prof(el);
+    }
+    if (pipeline->thread) {
+        esp_gmf_task_reset_prof(pipeline->thread);
+    }
+    return ESP_GMF_ERR_OK;
+}
@@ -0,0 +1,244 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host comparison of the mutex based `esp_gmf_rb` and the lock-free `esp_gmf_spsc_rb` with one writer thread and one
+ * reader thread, moving 20 ms chunks of 16 kHz mono audio as the recorder does:
+ *  - throughput: the writer generates chunks as fast as it can, the reader verifies them
+ *  - latency: the writer sends a timestamped chunk every `LATENCY_PERIOD_US`, the reader measures its arrival
+ * Both implementations are built from the component sources against the stubs of `stubs/`, see the README.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_gmf_ringbuffer.h"
+#include "esp_gmf_spsc_ringbuffer.h"
+
+#define CHUNK_SIZE          (640)
+#define THROUGHPUT_BYTES    (256 * 1024 * 1024)
+#define LATENCY_CHUNKS      (4000)
+#define LATENCY_PERIOD_US   (250)
+
+typedef enum {
+    MODE_RB,
+    MODE_SPSC_COPY,
+    MODE_SPSC_ZERO_COPY,
+} bench_mode_t;
+
+static const char *mode_names[] = {"esp_gmf_rb", "spsc copy", "spsc zero-copy"};
+
+typedef struct {
+    bench_mode_t mode;
+    void        *rb;
+    uint64_t     total;
+    bool         timestamped;
+    uint64_t    *latency;
+} bench_ctx_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void wait_until_ns(uint64_t deadline)
+{
+    while (now_ns() < deadline) {
+    }
+}
+
+/* The byte at stream offset `n` is `n * 31`, which repeats every 256 bytes, so it is copied from a template */
+static uint8_t pattern[256 + CHUNK_SIZE];
+
+static void fill_pattern(uint8_t *buf, uint32_t len, uint64_t offset)
+{
+    memcpy(buf, pattern + offset % 256, len);
+}
+
+static void check_pattern(const uint8_t *buf, uint32_t len, uint64_t offset)
+{
+    if (memcmp(buf, pattern + offset % 256, len) != 0) {
+        fprintf(stderr, "Data mismatch around %llu\n", (unsigned long long)offset);
+        exit(1);
+    }
+}
+
+static void write_chunk(bench_ctx_t *ctx, uint8_t *chunk, uint64_t offset)
+{
+    if (ctx->timestamped) {
+        uint64_t stamp = now_ns();
+        memcpy(chunk, &stamp, sizeof(stamp));
+    }
+    if (ctx->mode == MODE_RB) {
+        esp_gmf_data_bus_block_t blk = {.buf = chunk, .buf_length = CHUNK_SIZE, .valid_size = CHUNK_SIZE};
+        esp_gmf_rb_acquire_write(ctx->rb, &blk, CHUNK_SIZE, portMAX_DELAY);
+        esp_gmf_rb_release_write(ctx->rb, &blk, portMAX_DELAY);
+    } else if (ctx->mode == MODE_SPSC_COPY || ctx->timestamped) {
+        esp_gmf_spsc_rb_write(ctx->rb, chunk, CHUNK_SIZE, portMAX_DELAY);
+    } else {
+        // Generate the data straight in the ring buffer, as an element writing its output in place would
+        esp_gmf_data_bus_block_t blk = {0};
+        for (uint32_t done = 0; done < CHUNK_SIZE; done += blk.valid_size) {
+            esp_gmf_spsc_rb_acquire_write(ctx->rb, &blk, CHUNK_SIZE - done, portMAX_DELAY);
+            fill_pattern(blk.buf, blk.buf_length, offset + done);
+            blk.valid_size = blk.buf_length;
+            esp_gmf_spsc_rb_release_write(ctx->rb, &blk, portMAX_DELAY);
+        }
+    }
+}
+
+static void *writer_thread(void *arg)
+{
+    bench_ctx_t *ctx = (bench_ctx_t *)arg;
+    uint8_t chunk[CHUNK_SIZE];
+    uint64_t next = now_ns();
+    for (uint64_t offset = 0; offset < ctx->total; offset += CHUNK_SIZE) {
+        if (ctx->timestamped) {
+            next += LATENCY_PERIOD_US * 1000;
+            wait_until_ns(next);
+        } else if (ctx->mode != MODE_SPSC_ZERO_COPY) {
+            fill_pattern(chunk, CHUNK_SIZE, offset);
+        }
+        write_chunk(ctx, chunk, offset);
+    }
+    return NULL;
+}
+
+static void *reader_thread(void *arg)
+{
+    bench_ctx_t *ctx = (bench_ctx_t *)arg;
+    uint8_t chunk[CHUNK_SIZE];
+    for (uint64_t offset = 0; offset < ctx->total; offset += CHUNK_SIZE) {
+        if (ctx->mode == MODE_RB) {
+            esp_gmf_data_bus_block_t blk = {.buf = chunk, .buf_length = CHUNK_SIZE};
+            esp_gmf_rb_acquire_read(ctx->rb, &blk, CHUNK_SIZE, portMAX_DELAY);
+            esp_gmf_rb_release_read(ctx->rb, &blk, portMAX_DELAY);
+        } else if (ctx->mode == MODE_SPSC_COPY || ctx->timestamped) {
+            esp_gmf_spsc_rb_read(ctx->rb, chunk, CHUNK_SIZE, portMAX_DELAY);
+        } else {
+            esp_gmf_data_bus_block_t blk = {0};
+            for (uint32_t done = 0; done < CHUNK_SIZE; done += blk.valid_size) {
+                esp_gmf_spsc_rb_acquire_read(ctx->rb, &blk, CHUNK_SIZE - done, portMAX_DELAY);
+                check_pattern(blk.buf, blk.valid_size, offset + done);
+                esp_gmf_spsc_rb_release_read(ctx->rb, &blk, portMAX_DELAY);
+            }
+            continue;
+        }
+        if (ctx->timestamped) {
+            uint64_t stamp;
+            memcpy(&stamp, chunk, sizeof(stamp));
+            ctx->latency[offset / CHUNK_SIZE] = now_ns() - stamp;
+        } else {
+            check_pattern(chunk, CHUNK_SIZE, offset);
+        }
+    }
+    return NULL;
+}
+
+static void *create_rb(bench_mode_t mode, int size)
+{
+    void *rb = NULL;
+    if (mode == MODE_RB) {
+        esp_gmf_rb_create(1, size, &rb);
+    } else {
+        esp_gmf_spsc_rb_create(1, size, &rb);
+    }
+    if (rb == NULL) {
+        fprintf(stderr, "Create ring buffer failed\n");
+        exit(1);
+    }
+    return rb;
+}
+
+static void destroy_rb(bench_mode_t mode, void *rb)
+{
+    if (mode == MODE_RB) {
+        esp_gmf_rb_destroy(rb);
+    } else {
+        esp_gmf_spsc_rb_destroy(rb);
+    }
+}
+
+static void run(bench_ctx_t *ctx)
+{
+    pthread_t writer, reader;
+    pthread_create(&reader, NULL, reader_thread, ctx);
+    pthread_create(&writer, NULL, writer_thread, ctx);
+    pthread_join(writer, NULL);
+    pthread_join(reader, NULL);
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_throughput(bench_mode_t mode, int rb_size)
+{
+    bench_ctx_t ctx = {
+        .mode = mode,
+        .rb = create_rb(mode, rb_size),
+        .total = THROUGHPUT_BYTES,
+    };
+    uint64_t blocks = freertos_host_block_count;
+    uint64_t syncs = freertos_host_sync_count;
+    uint64_t start = now_ns();
+    run(&ctx);
+    double seconds = (now_ns() - start) / 1e9;
+    double chunks = (double)THROUGHPUT_BYTES / CHUNK_SIZE;
+    printf("%-16s %6d  %9.1f MB/s  %7.3f blocks/chunk  %7.3f sync ops/chunk\n", mode_names[mode], rb_size,
+           THROUGHPUT_BYTES / seconds / (1024 * 1024), (freertos_host_block_count - blocks) / chunks,
+           (freertos_host_sync_count - syncs) / chunks);
+    destroy_rb(mode, ctx.rb);
+}
+
+static void bench_latency(bench_mode_t mode, int rb_size)
+{
+    bench_ctx_t ctx = {
+        .mode = mode,
+        .rb = create_rb(mode, rb_size),
+        .total = (uint64_t)LATENCY_CHUNKS * CHUNK_SIZE,
+        .timestamped = true,
+        .latency = calloc(LATENCY_CHUNKS, sizeof(uint64_t)),
+    };
+    run(&ctx);
+    qsort(ctx.latency, LATENCY_CHUNKS, sizeof(uint64_t), compare_u64);
+    uint64_t sum = 0;
+    for (int i = 0; i < LATENCY_CHUNKS; i++) {
+        sum += ctx.latency[i];
+    }
+    printf("%-16s %6d  avg %7.2f us  p50 %7.2f us  p99 %7.2f us  max %8.2f us\n", mode_names[mode], rb_size,
+           sum / 1e3 / LATENCY_CHUNKS, ctx.latency[LATENCY_CHUNKS / 2] / 1e3,
+           ctx.latency[LATENCY_CHUNKS * 99 / 100] / 1e3, ctx.latency[LATENCY_CHUNKS - 1] / 1e3);
+    free(ctx.latency);
+    destroy_rb(mode, ctx.rb);
+}
+
+int main(void)
+{
+    const int rb_sizes[] = {3 * 1024, 16 * 1024};
+    for (size_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 31);
+    }
+    printf("Throughput, %d bytes chunks, %d MB\n", CHUNK_SIZE, THROUGHPUT_BYTES / (1024 * 1024));
+    for (size_t s = 0; s < sizeof(rb_sizes) / sizeof(rb_sizes[0]); s++) {
+        for (int mode = MODE_RB; mode <= MODE_SPSC_ZERO_COPY; mode++) {
+            bench_throughput(mode, rb_sizes[s]);
+        }
+    }
+    printf("\nLatency, a %d bytes chunk every %d us\n", CHUNK_SIZE, LATENCY_PERIOD_US);
+    for (int mode = MODE_RB; mode <= MODE_SPSC_COPY; mode++) {
+        bench_latency(mode, rb_sizes[0]);
+    }
+    return 0;
+}
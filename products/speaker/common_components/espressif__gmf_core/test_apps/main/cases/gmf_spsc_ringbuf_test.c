@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_ringbuffer.h"
+#include "esp_gmf_spsc_ringbuffer.h"
+
+#define TEST_RB_SIZE     (3 * 1024)
+#define TEST_CHUNK_SIZE  (640)
+#define TEST_STREAM_SIZE (256 * 1024)
+
+static const char *TAG = "TEST_ESP_GMF_SPSC_RB";
+
+typedef struct {
+    void              *rb;
+    bool               is_spsc;
+    uint32_t           cycles;
+    volatile bool      is_done;
+} spsc_test_ctx_t;
+
+static inline uint8_t pattern_byte(uint32_t offset)
+{
+    return (uint8_t)(offset * 31);
+}
+
+static void writer_task(void *param)
+{
+    spsc_test_ctx_t *ctx = (spsc_test_ctx_t *)param;
+    uint8_t *chunk = esp_gmf_oal_malloc(TEST_CHUNK_SIZE);
+    TEST_ASSERT_NOT_NULL(chunk);
+    for (uint32_t offset = 0; offset < TEST_STREAM_SIZE; offset += TEST_CHUNK_SIZE) {
+        uint32_t len = (TEST_STREAM_SIZE - offset < TEST_CHUNK_SIZE) ? (TEST_STREAM_SIZE - offset) : TEST_CHUNK_SIZE;
+        if (ctx->is_spsc) {
+            // Generate the data straight in the ring buffer
+            esp_gmf_data_bus_block_t blk = {0};
+            for (uint32_t done = 0; done < len; done += blk.valid_size) {
+                TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_spsc_rb_acquire_write(ctx->rb, &blk, len - done, portMAX_DELAY));
+                for (uint32_t i = 0; i < blk.buf_length; i++) {
+                    blk.buf[i] = pattern_byte(offset + done + i);
+                }
+                blk.valid_size = blk.buf_length;
+                blk.is_last = (offset + done + blk.valid_size == TEST_STREAM_SIZE);
+                esp_gmf_spsc_rb_release_write(ctx->rb, &blk, portMAX_DELAY);
+            }
+        } else {
+            for (uint32_t i = 0; i < len; i++) {
+                chunk[i] = pattern_byte(offset + i);
+            }
+            esp_gmf_data_bus_block_t blk = {.buf = chunk, .buf_length = len, .valid_size = len};
+            blk.is_last = (offset + len == TEST_STREAM_SIZE);
+            esp_gmf_rb_release_write(ctx->rb, &blk, portMAX_DELAY);
+        }
+    }
+    esp_gmf_oal_free(chunk);
+    vTaskDelete(NULL);
+}
+
+static void reader_task(void *param)
+{
+    spsc_test_ctx_t *ctx = (spsc_test_ctx_t *)param;
+    uint8_t *chunk = esp_gmf_oal_malloc(TEST_CHUNK_SIZE);
+    TEST_ASSERT_NOT_NULL(chunk);
+    uint32_t offset = 0;
+    uint32_t start = esp_cpu_get_cycle_count();
+    while (true) {
+        esp_gmf_data_bus_block_t blk = {.buf = chunk, .buf_length = TEST_CHUNK_SIZE};
+        if (ctx->is_spsc) {
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_spsc_rb_acquire_read(ctx->rb, &blk, TEST_CHUNK_SIZE, portMAX_DELAY));
+        } else {
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_read(ctx->rb, &blk, TEST_CHUNK_SIZE, portMAX_DELAY));
+        }
+        for (uint32_t i = 0; i < blk.valid_size; i++) {
+            TEST_ASSERT_EQUAL_UINT8(pattern_byte(offset + i), blk.buf[i]);
+        }
+        offset += blk.valid_size;
+        if (ctx->is_spsc) {
+            esp_gmf_spsc_rb_release_read(ctx->rb, &blk, 0);
+        } else {
+            esp_gmf_rb_release_read(ctx->rb, &blk, 0);
+        }
+        if (blk.is_last || offset == TEST_STREAM_SIZE) {
+            break;
+        }
+    }
+    ctx->cycles = esp_cpu_get_cycle_count() - start;
+    TEST_ASSERT_EQUAL(TEST_STREAM_SIZE, offset);
+    esp_gmf_oal_free(chunk);
+    ctx->is_done = true;
+    vTaskDelete(NULL);
+}
+
+static uint32_t run_stream(void *rb, bool is_spsc, int reader_core, int writer_core)
+{
+    spsc_test_ctx_t ctx = {.rb = rb, .is_spsc = is_spsc};
+    xTaskCreatePinnedToCore(reader_task, "reader", 4096, &ctx, 5, NULL, reader_core);
+    xTaskCreatePinnedToCore(writer_task, "writer", 4096, &ctx, 5, NULL, writer_core);
+    while (!ctx.is_done) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+    return ctx.cycles;
+}
+
+TEST_CASE("SPSC ringbuffer read and write on different task", "ESP_GMF_SPSC_RB")
+{
+    esp_gmf_spsc_rb_handle_t rb = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_rb_create(1, TEST_RB_SIZE, &rb));
+    TEST_ASSERT_NOT_NULL(rb);
+    for (int cores = 0; cores < portNUM_PROCESSORS; cores++) {
+        esp_gmf_spsc_rb_reset(rb);
+        run_stream(rb, true, 0, cores);
+    }
+    esp_gmf_spsc_rb_destroy(rb);
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+}
+
+TEST_CASE("SPSC ringbuffer copy, done, abort and timeout", "ESP_GMF_SPSC_RB")
+{
+    esp_gmf_spsc_rb_handle_t rb = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_spsc_rb_create(4, 16, &rb));
+    uint8_t in[100];
+    uint8_t out[100];
+    for (int i = 0; i < sizeof(in); i++) {
+        in[i] = pattern_byte(i);
+    }
+    uint32_t size = 0;
+    esp_gmf_spsc_rb_get_size(rb, &size);
+    TEST_ASSERT_EQUAL(64, size);
+
+    // Nothing to read, and no space after a full write
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_spsc_rb_acquire_read(rb, &blk, 10, 0));
+    TEST_ASSERT_EQUAL(64, esp_gmf_spsc_rb_write(rb, in, sizeof(in), 10 / portTICK_PERIOD_MS));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_spsc_rb_acquire_write(rb, &blk, 10, 0));
+    esp_gmf_spsc_rb_bytes_filled(rb, &size);
+    TEST_ASSERT_EQUAL(64, size);
+
+    // A region stops at the end of the buffer, the copy helpers go across it
+    TEST_ASSERT_EQUAL(40, esp_gmf_spsc_rb_read(rb, out, 40, 0));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(in, out, 40);
+    TEST_ASSERT_EQUAL(36, esp_gmf_spsc_rb_write(rb, in + 64, 36, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_spsc_rb_acquire_read(rb, &blk, 64, 0));
+    TEST_ASSERT_EQUAL(24, blk.valid_size);
+    esp_gmf_spsc_rb_release_read(rb, &blk, 0);
+    TEST_ASSERT_EQUAL(36, esp_gmf_spsc_rb_read(rb, out, 36, 0));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(in + 64, out, 36);
+
+    // Done write lets the reader drain the data, then reports the end
+    TEST_ASSERT_EQUAL(10, esp_gmf_spsc_rb_write(rb, in, 10, 0));
+    esp_gmf_spsc_rb_done_write(rb);
+    TEST_ASSERT_EQUAL(10, esp_gmf_spsc_rb_read(rb, out, sizeof(out), portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_spsc_rb_acquire_read(rb, &blk, 10, portMAX_DELAY));
+    TEST_ASSERT_TRUE(blk.is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_spsc_rb_acquire_write(rb, &blk, 10, 0));
+
+    // Abort wakes the waiting side up
+    esp_gmf_spsc_rb_reset(rb);
+    esp_gmf_spsc_rb_abort(rb);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_spsc_rb_acquire_read(rb, &blk, 10, portMAX_DELAY));
+    esp_gmf_spsc_rb_destroy(rb);
+}
+
+TEST_CASE("SPSC ringbuffer compare with ringbuffer", "ESP_GMF_SPSC_RB")
+{
+    esp_gmf_rb_handle_t rb = NULL;
+    esp_gmf_spsc_rb_handle_t spsc_rb = NULL;
+    esp_gmf_rb_create(1, TEST_RB_SIZE, &rb);
+    esp_gmf_spsc_rb_create(1, TEST_RB_SIZE, &spsc_rb);
+    TEST_ASSERT_NOT_NULL(rb);
+    TEST_ASSERT_NOT_NULL(spsc_rb);
+    for (int cores = 0; cores < portNUM_PROCESSORS; cores++) {
+        esp_gmf_rb_reset(rb);
+        esp_gmf_spsc_rb_reset(spsc_rb);
+        uint32_t rb_cycles = run_stream(rb, false, 0, cores);
+        uint32_t spsc_cycles = run_stream(spsc_rb, true, 0, cores);
+        ESP_LOGI(TAG, "%s core, %d bytes: ringbuffer %ld cycles, spsc ringbuffer %ld cycles",
+                 cores ? "Cross" : "Same", TEST_STREAM_SIZE, rb_cycles, spsc_cycles);
+    }
+    esp_gmf_rb_destroy(rb);
+    esp_gmf_spsc_rb_destroy(spsc_rb);
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+}
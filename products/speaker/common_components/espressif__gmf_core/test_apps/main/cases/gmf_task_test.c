@@ -734,3 +734,70 @@ TEST_CASE("Return error after call STOP", "ESP_GMF_TASK")
 
     ESP_GMF_MEM_SHOW(TAG);
 }
+
+static int prof_slow_cnt;
+static int prof_log_cnt;
+
+static esp_gmf_job_err_t prof_fast_job(void *self, void *para)
+{
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t prof_slow_job(void *self, void *para)
+{
+    // One loop out of five takes 40 ms more than the others
+    prof_slow_cnt++;
+    vTaskDelay(((prof_slow_cnt % 5) ? 10 : 50) / portTICK_PERIOD_MS);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static void prof_log(esp_gmf_task_handle_t handle, void *ctx)
+{
+    // Called by the task itself, which updates the counters
+    esp_gmf_task_prof_t *prof = &((esp_gmf_task_t *)handle)->prof;
+    ESP_LOGI(TAG, "PROF, loops:%ld, max:%ldus, overruns:%ld", prof->loop_cnt, prof->loop_max_us, prof->overrun_cnt);
+    prof_log_cnt++;
+}
+
+TEST_CASE("Loop profile with overruns", "ESP_GMF_TASK")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    prof_slow_cnt = 0;
+    prof_log_cnt = 0;
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_loop_budget(hd, 40 * 1000));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_prof_log(hd, 300, prof_log, NULL));
+    esp_gmf_task_register_ready_job(hd, NULL, prof_fast_job, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, NULL, prof_slow_job, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(1500 / portTICK_PERIOD_MS);
+    // Time spent paused is not part of a loop
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pause(hd));
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_resume(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+
+    esp_gmf_task_prof_t prof = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_get_prof(hd, &prof));
+    ESP_LOGI(TAG, "Loops:%ld, avg:%ldus, max:%ldus, overruns:%ld, slow:%d, logs:%d", prof.loop_cnt,
+             (uint32_t)(prof.loop_us / prof.loop_cnt), prof.loop_max_us, prof.overrun_cnt, prof_slow_cnt, prof_log_cnt);
+    // Each loop runs the slow job once, the loop being stopped may not be completed
+    TEST_ASSERT_INT_WITHIN(1, prof_slow_cnt, prof.loop_cnt);
+    TEST_ASSERT_INT_WITHIN(1, prof_slow_cnt / 5, prof.overrun_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(60 * 1000, prof.loop_max_us);
+    TEST_ASSERT_LESS_THAN(200 * 1000, prof.loop_max_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(5, prof_log_cnt);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_reset_prof(hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_get_prof(hd, &prof));
+    TEST_ASSERT_EQUAL(0, prof.loop_cnt);
+    TEST_ASSERT_EQUAL(0, prof.overrun_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
@@ -0,0 +1,584 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "esp_log.h"
+#include "mem_slab.h"
+#include "host_check.hpp"
+
+// Same as the default of `CONFIG_EXAMPLE_LV_MEM_SLAB_SIZE_KB` of the speaker
+#define HOST_LV_MEM_SLAB_SIZE       (64 * 1024)
+#define HOST_LV_MEM_CYCLES          (50)
+// Frames drawn while the app is open, the app is closed after its opening animation
+#define HOST_LV_MEM_FRAMES          (30)
+#define HOST_LV_MEM_BENCH_RUNS      (20)
+#define HOST_LV_MEM_NONE            (UINT32_MAX)
+
+static const char *TAG = "host_lv_mem";
+
+/* Routing of `lv_mem_core_custom.c` of the speaker, with malloc in place of the PSRAM heap */
+static void *host_lv_mem_slab_malloc(mem_slab_t *slab, size_t size)
+{
+    if (size <= MEM_SLAB_MAX_BLOCK_SIZE) {
+        void *p = mem_slab_alloc(slab, size);
+        if (p != nullptr) {
+            return p;
+        }
+    }
+
+    return malloc(size);
+}
+
+static void host_lv_mem_slab_free(mem_slab_t *slab, void *p)
+{
+    if (mem_slab_owns(slab, p)) {
+        mem_slab_free(slab, p);
+        return;
+    }
+
+    free(p);
+}
+
+static void *host_lv_mem_slab_realloc(mem_slab_t *slab, void *p, size_t new_size)
+{
+    if (p == nullptr) {
+        return host_lv_mem_slab_malloc(slab, new_size);
+    }
+    if (!mem_slab_owns(slab, p)) {
+        return realloc(p, new_size);
+    }
+
+    size_t block_size = mem_slab_block_size(slab, p);
+    if (new_size <= block_size) {
+        return p;
+    }
+    void *new_p = host_lv_mem_slab_malloc(slab, new_size);
+    if (new_p != nullptr) {
+        memcpy(new_p, p, block_size);
+        host_lv_mem_slab_free(slab, p);
+    }
+
+    return new_p;
+}
+
+struct TraceOp {
+    enum class Type : uint8_t {
+        Alloc,
+        Realloc,
+        Free,
+    };
+    Type type;
+    uint32_t id;
+    uint32_t size;
+};
+
+struct Trace {
+    std::vector<TraceOp> ops;
+    // Index of the first op of the close of the app, and of the op after the close, for each cycle
+    std::vector<size_t> close_starts;
+    std::vector<size_t> cycle_ends;
+    uint32_t id_num = 0;
+};
+
+/* Records the allocations of the trace, the ids of the freed blocks are reused like the addresses */
+class TraceBuilder {
+public:
+    TraceBuilder(Trace &trace): _trace(trace) {}
+
+    uint32_t alloc(uint32_t size)
+    {
+        uint32_t id = _trace.id_num;
+        if (!_free_ids.empty()) {
+            id = _free_ids.back();
+            _free_ids.pop_back();
+        } else {
+            _trace.id_num++;
+        }
+        _trace.ops.push_back({TraceOp::Type::Alloc, id, size});
+        return id;
+    }
+
+    /* Grows an array of `lv_realloc()`, allocated by the first call */
+    void grow(uint32_t &id, uint32_t size)
+    {
+        if (id == HOST_LV_MEM_NONE) {
+            id = alloc(size);
+            return;
+        }
+        _trace.ops.push_back({TraceOp::Type::Realloc, id, size});
+    }
+
+    void free(uint32_t &id)
+    {
+        if (id == HOST_LV_MEM_NONE) {
+            return;
+        }
+        _trace.ops.push_back({TraceOp::Type::Free, id, 0});
+        _free_ids.push_back(id);
+        id = HOST_LV_MEM_NONE;
+    }
+
+private:
+    Trace &_trace;
+    std::vector<uint32_t> _free_ids;
+};
+
+/* Allocations of an object of LVGL 9 on a 32-bit target, the arrays are in its special attributes */
+struct TraceObj {
+    uint32_t body = HOST_LV_MEM_NONE;
+    uint32_t spec_attr = HOST_LV_MEM_NONE;
+    uint32_t children = HOST_LV_MEM_NONE;
+    uint32_t styles = HOST_LV_MEM_NONE;
+    uint32_t local_style = HOST_LV_MEM_NONE;
+    uint32_t event_list = HOST_LV_MEM_NONE;
+    std::vector<uint32_t> events;
+    uint32_t text = HOST_LV_MEM_NONE;
+    int child_num = 0;
+};
+
+/**
+ * Synthetic trace of the open and close cycles of an app, with the sizes of the structures of LVGL 9 on a 32-bit
+ * target: the app creates its widget tree with styles, events and texts, starts its animations and images, draws
+ * frames whose draw tasks live until the end of the frame, then deletes its tree children first. The clock of the
+ * status bar is updated in between and survives the cycles.
+ */
+static Trace host_lv_mem_make_trace(int cycles)
+{
+    // Widgets: base object, button, label, image, bar, slider, arc
+    static const uint32_t obj_sizes[] = {64, 68, 100, 88, 120, 140, 156};
+    // Draw descriptors: border, fill, label, image, line, arc, box shadow
+    static const uint32_t draw_dsc_sizes[] = {48, 64, 112, 96, 40, 56, 180};
+    static const uint32_t spec_attr_size = 60;
+    static const uint32_t style_size = 12;
+    static const uint32_t style_prop_size = 8;
+    static const uint32_t event_dsc_size = 16;
+    static const uint32_t anim_size = 112;
+    static const uint32_t timer_size = 44;
+    static const uint32_t draw_task_size = 88;
+    static const uint32_t layer_size = 104;
+    static const uint32_t draw_buf_size = 60;
+
+    Trace trace;
+    TraceBuilder builder(trace);
+    std::mt19937 rng(0x1A7E);
+    auto random = [&rng](uint32_t min, uint32_t max) {
+        return std::uniform_int_distribution<uint32_t>(min, max)(rng);
+    };
+
+    uint32_t clock_text = builder.alloc(6);
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        std::vector<TraceObj> objs;
+        std::vector<uint32_t> images;
+        std::vector<uint32_t> anims;
+        std::vector<uint32_t> timers;
+
+        // Open: the screen then its widgets, each added to a random parent
+        int obj_num = random(120, 160);
+        objs.reserve(obj_num);
+        for (int i = 0; i < obj_num; i++) {
+            TraceObj obj;
+            obj.body = builder.alloc(obj_sizes[(i == 0) ? 0 : random(0, 6)]);
+            if (i > 0) {
+                TraceObj &parent = objs[random(0, i - 1)];
+                if (parent.spec_attr == HOST_LV_MEM_NONE) {
+                    parent.spec_attr = builder.alloc(spec_attr_size);
+                }
+                parent.child_num++;
+                builder.grow(parent.children, parent.child_num * sizeof(uint32_t));
+            }
+            int style_num = random(0, 3);
+            for (int k = 1; k <= style_num; k++) {
+                builder.grow(obj.styles, k * style_size);
+            }
+            if (random(0, 9) < 3) {
+                int prop_num = random(1, 5);
+                for (int k = 1; k <= prop_num; k++) {
+                    builder.grow(obj.local_style, k * style_prop_size);
+                }
+            }
+            if (random(0, 9) < 4) {
+                if (obj.spec_attr == HOST_LV_MEM_NONE) {
+                    obj.spec_attr = builder.alloc(spec_attr_size);
+                }
+                int event_num = random(1, 2);
+                for (int k = 1; k <= event_num; k++) {
+                    obj.events.push_back(builder.alloc(event_dsc_size));
+                    builder.grow(obj.event_list, k * sizeof(uint32_t));
+                }
+            }
+            if (random(0, 9) < 4) {
+                obj.text = builder.alloc(random(4, 40));
+            }
+            objs.push_back(std::move(obj));
+        }
+        for (int i = random(2, 4); i > 0; i--) {
+            images.push_back(builder.alloc(random(8, 64) * 1024));
+        }
+        for (int i = 0; i < 8; i++) {
+            anims.push_back(builder.alloc(anim_size));
+        }
+        for (int i = 0; i < 2; i++) {
+            timers.push_back(builder.alloc(timer_size));
+        }
+
+        // Frames: the draw tasks and their descriptors are freed once drawn, some frames need a layer
+        for (int frame = 0; frame < HOST_LV_MEM_FRAMES; frame++) {
+            std::vector<uint32_t> frame_ids;
+            uint32_t layer_buf = HOST_LV_MEM_NONE;
+            if (random(0, 9) == 0) {
+                frame_ids.push_back(builder.alloc(layer_size));
+                frame_ids.push_back(builder.alloc(draw_buf_size));
+                layer_buf = builder.alloc(random(4, 30) * 1024);
+            }
+            for (int i = random(20, 60); i > 0; i--) {
+                frame_ids.push_back(builder.alloc(draw_task_size));
+                frame_ids.push_back(builder.alloc(draw_dsc_sizes[random(0, 6)]));
+            }
+            for (auto &id : frame_ids) {
+                builder.free(id);
+            }
+            builder.free(layer_buf);
+            // The opening animations end during the first frames
+            if ((frame % 4 == 3) && !anims.empty()) {
+                builder.free(anims.back());
+                anims.pop_back();
+            }
+            if (frame % 10 == 0) {
+                builder.grow(clock_text, random(5, 8));
+            }
+        }
+
+        // Close: the timers and animations are deleted with the objects, the children before their parent
+        trace.close_starts.push_back(trace.ops.size());
+        for (auto &id : timers) {
+            builder.free(id);
+        }
+        for (auto &id : anims) {
+            builder.free(id);
+        }
+        for (auto it = objs.rbegin(); it != objs.rend(); it++) {
+            for (auto &id : it->events) {
+                builder.free(id);
+            }
+            builder.free(it->event_list);
+            builder.free(it->text);
+            builder.free(it->local_style);
+            builder.free(it->styles);
+            builder.free(it->children);
+            builder.free(it->spec_attr);
+            builder.free(it->body);
+        }
+        for (auto &id : images) {
+            builder.free(id);
+        }
+        trace.cycle_ends.push_back(trace.ops.size());
+    }
+    builder.free(clock_text);
+
+    return trace;
+}
+
+/* Allocators replaying the trace, the blocks are zeroed like most of the allocations of LVGL */
+struct MallocAllocator {
+    void *alloc(size_t size)
+    {
+        return malloc(size);
+    }
+    void *realloc(void *p, size_t size)
+    {
+        return ::realloc(p, size);
+    }
+    void free(void *p)
+    {
+        ::free(p);
+    }
+};
+
+struct SlabAllocator {
+    mem_slab_t *slab;
+
+    void *alloc(size_t size)
+    {
+        return host_lv_mem_slab_malloc(slab, size);
+    }
+    void *realloc(void *p, size_t size)
+    {
+        return host_lv_mem_slab_realloc(slab, p, size);
+    }
+    void free(void *p)
+    {
+        host_lv_mem_slab_free(slab, p);
+    }
+};
+
+template <typename Allocator>
+static bool host_lv_mem_replay_ops(
+    Allocator &allocator, const Trace &trace, size_t begin, size_t end, std::vector<void *> &ptrs,
+    std::vector<uint32_t> *sizes
+)
+{
+    for (size_t i = begin; i < end; i++) {
+        const TraceOp &op = trace.ops[i];
+        void *&p = ptrs[op.id];
+        switch (op.type) {
+        case TraceOp::Type::Alloc:
+            p = allocator.alloc(op.size);
+            if (p == nullptr) {
+                return false;
+            }
+            memset(p, 0, op.size);
+            break;
+        case TraceOp::Type::Realloc:
+            p = allocator.realloc(p, op.size);
+            if (p == nullptr) {
+                return false;
+            }
+            break;
+        default:
+            allocator.free(p);
+            p = nullptr;
+            break;
+        }
+        if (sizes == nullptr) {
+            continue;
+        }
+
+        // Each block is filled with its id, which must still be there when it is moved or freed
+        uint8_t pattern = static_cast<uint8_t>(op.id * 31 + 7);
+        uint32_t &size = (*sizes)[op.id];
+        if (op.type == TraceOp::Type::Free) {
+            size = 0;
+            continue;
+        }
+        if (op.type == TraceOp::Type::Realloc) {
+            const uint8_t *data = static_cast<const uint8_t *>(p);
+            for (uint32_t k = 0; k < std::min(size, op.size); k++) {
+                if (data[k] != pattern) {
+                    return false;
+                }
+            }
+        }
+        memset(p, pattern, op.size);
+        size = op.size;
+    }
+
+    return true;
+}
+
+static bool host_lv_mem_check_classes()
+{
+    std::vector<uint8_t> mem(2 * MEM_SLAB_PAGE_SIZE + 256);
+    mem_slab_t slab;
+    HOST_CHECK(!mem_slab_init(&slab, mem.data(), MEM_SLAB_PAGE_SIZE / 2));
+    HOST_CHECK(!mem_slab_owns(&slab, mem.data()));
+    HOST_CHECK(mem_slab_init(&slab, mem.data(), mem.size()));
+    HOST_CHECK(slab.page_num == 2);
+
+    // The waste is the part of the blocks not asked for
+    mem_slab_stats_t stats;
+    mem_slab_free(&slab, mem_slab_alloc(&slab, 180));
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK((stats.classes[6].alloc_cnt == 1) && (stats.classes[6].waste_pct == (192 - 180) * 100 / 192));
+
+    // Every size gets the smallest class it fits in, aligned on 8 bytes
+    size_t previous_block_size = 0;
+    for (size_t size = 0; size <= MEM_SLAB_MAX_BLOCK_SIZE; size++) {
+        void *p = mem_slab_alloc(&slab, size);
+        HOST_CHECK(p != nullptr);
+        HOST_CHECK(mem_slab_owns(&slab, p));
+        HOST_CHECK(reinterpret_cast<uintptr_t>(p) % 8 == 0);
+        size_t block_size = mem_slab_block_size(&slab, p);
+        HOST_CHECK((block_size >= size) && (block_size >= previous_block_size));
+        HOST_CHECK((size <= previous_block_size) || (block_size == size) || (size % 16 != 0));
+        previous_block_size = block_size;
+        memset(p, 0xA5, size);
+        mem_slab_free(&slab, p);
+        HOST_CHECK(mem_slab_check(&slab));
+    }
+    HOST_CHECK(mem_slab_alloc(&slab, MEM_SLAB_MAX_BLOCK_SIZE + 1) == nullptr);
+
+    // The blocks of a class fill their pages, then the allocations miss
+    std::vector<void *> blocks;
+    for (void *p = mem_slab_alloc(&slab, 64); p != nullptr; p = mem_slab_alloc(&slab, 64)) {
+        HOST_CHECK(std::find(blocks.begin(), blocks.end(), p) == blocks.end());
+        blocks.push_back(p);
+    }
+    HOST_CHECK(blocks.size() == 2 * MEM_SLAB_PAGE_SIZE / 64);
+    HOST_CHECK(mem_slab_alloc(&slab, 16) == nullptr);
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK((stats.miss_cnt == 2) && (stats.free_page_num == 0) && (stats.free_size == 0));
+    HOST_CHECK((stats.classes[3].used == blocks.size()) && (stats.classes[3].frag_pct == 0));
+    HOST_CHECK(mem_slab_check(&slab));
+
+    // Freeing every other block fragments the pages, freeing the others gives the pages back
+    for (size_t i = 0; i < blocks.size(); i += 2) {
+        mem_slab_free(&slab, blocks[i]);
+    }
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK((stats.classes[3].frag_pct == 50) && (stats.frag_pct == 100));
+    HOST_CHECK(mem_slab_check(&slab));
+    for (size_t i = 1; i < blocks.size(); i += 2) {
+        mem_slab_free(&slab, blocks[i]);
+    }
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK((stats.used_cnt == 0) && (stats.used_size == 0) && (stats.free_page_num == 2));
+    HOST_CHECK((stats.classes[3].pages == 0) && (stats.frag_pct == 0));
+    HOST_CHECK(mem_slab_check(&slab));
+
+    // Other classes take the pages
+    void *p = mem_slab_alloc(&slab, 180);
+    void *q = mem_slab_alloc(&slab, 250);
+    HOST_CHECK((p != nullptr) && (q != nullptr));
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK((stats.free_page_num == 0) && (stats.classes[6].pages == 1) && (stats.classes[7].pages == 1));
+
+    // A corrupted free list is found
+    void *r = mem_slab_alloc(&slab, 180);
+    mem_slab_free(&slab, r);
+    *static_cast<void **>(r) = static_cast<uint8_t *>(r) + 1;
+    HOST_CHECK(!mem_slab_check(&slab));
+
+    return true;
+}
+
+static bool host_lv_mem_check_realloc()
+{
+    std::vector<uint8_t> mem(HOST_LV_MEM_SLAB_SIZE);
+    mem_slab_t slab;
+    HOST_CHECK(mem_slab_init(&slab, mem.data(), mem.size()));
+
+    // The array grows in place in its block, then moves to bigger classes and out of the slab with its content
+    uint8_t *data = nullptr;
+    uint8_t *previous = nullptr;
+    int moves = 0;
+    for (size_t size = 4; size <= 1024; size += 4) {
+        data = static_cast<uint8_t *>(host_lv_mem_slab_realloc(&slab, data, size));
+        HOST_CHECK(data != nullptr);
+        for (size_t i = 0; i + 4 < size; i++) {
+            HOST_CHECK(data[i] == static_cast<uint8_t>(i));
+        }
+        for (size_t i = size - 4; i < size; i++) {
+            data[i] = static_cast<uint8_t>(i);
+        }
+        HOST_CHECK(mem_slab_owns(&slab, data) == (size <= MEM_SLAB_MAX_BLOCK_SIZE));
+        moves += (data != previous) ? 1 : 0;
+        previous = data;
+    }
+    // One move for each class, then `realloc()` may move it
+    HOST_CHECK(moves >= MEM_SLAB_CLASS_NUM + 1);
+
+    // Shrinking back stays out of the slab, a small block shrinks in place
+    data = static_cast<uint8_t *>(host_lv_mem_slab_realloc(&slab, data, 16));
+    HOST_CHECK(!mem_slab_owns(&slab, data));
+    host_lv_mem_slab_free(&slab, data);
+    data = static_cast<uint8_t *>(host_lv_mem_slab_malloc(&slab, 100));
+    HOST_CHECK(host_lv_mem_slab_realloc(&slab, data, 10) == data);
+    host_lv_mem_slab_free(&slab, data);
+
+    mem_slab_stats_t stats;
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK(stats.used_cnt == 0);
+    HOST_CHECK(mem_slab_check(&slab));
+
+    return true;
+}
+
+static bool host_lv_mem_check_trace()
+{
+    Trace trace = host_lv_mem_make_trace(HOST_LV_MEM_CYCLES);
+    std::vector<void *> ptrs(trace.id_num, nullptr);
+    std::vector<uint32_t> sizes(trace.id_num, 0);
+
+    // The blocks keep their content with the slab, and every cycle gives back its blocks and pages
+    std::vector<uint8_t> mem(HOST_LV_MEM_SLAB_SIZE);
+    mem_slab_t slab;
+    HOST_CHECK(mem_slab_init(&slab, mem.data(), mem.size()));
+    SlabAllocator slab_allocator{&slab};
+    mem_slab_stats_t open_stats = {};
+    mem_slab_stats_t stats = {};
+    size_t begin = 0;
+    size_t first_used_size = 0;
+    uint32_t first_free_page_num = 0;
+    for (size_t cycle = 0; cycle < trace.cycle_ends.size(); cycle++) {
+        size_t close_start = trace.close_starts[cycle];
+        size_t end = trace.cycle_ends[cycle];
+        HOST_CHECK(host_lv_mem_replay_ops(slab_allocator, trace, begin, close_start, ptrs, &sizes));
+        if (cycle == 0) {
+            mem_slab_get_stats(&slab, &open_stats);
+        }
+        HOST_CHECK(host_lv_mem_replay_ops(slab_allocator, trace, close_start, end, ptrs, &sizes));
+        HOST_CHECK(mem_slab_check(&slab));
+        mem_slab_get_stats(&slab, &stats);
+        if (cycle == 0) {
+            first_used_size = stats.used_size;
+            first_free_page_num = stats.free_page_num;
+        }
+        HOST_CHECK(stats.used_size == first_used_size);
+        HOST_CHECK(stats.free_page_num == first_free_page_num);
+        begin = end;
+    }
+    HOST_CHECK(host_lv_mem_replay_ops(slab_allocator, trace, begin, trace.ops.size(), ptrs, &sizes));
+    mem_slab_get_stats(&slab, &stats);
+    HOST_CHECK((stats.used_cnt == 0) && mem_slab_check(&slab));
+    HOST_CHECK(std::all_of(ptrs.begin(), ptrs.end(), [](void *p) {
+        return p == nullptr;
+    }));
+
+    uint32_t slab_alloc_cnt = 0;
+    for (auto &class_stats : stats.classes) {
+        slab_alloc_cnt += class_stats.alloc_cnt;
+    }
+    uint32_t small_alloc_cnt = slab_alloc_cnt + stats.miss_cnt;
+    HOST_CHECK(slab_alloc_cnt > 0);
+    ESP_LOGI(
+        TAG, "Trace: %d cycles, %d ops, %d small allocations, %d%% from the slab of %d KB (peak %d B)",
+        HOST_LV_MEM_CYCLES, static_cast<int>(trace.ops.size()), static_cast<int>(small_alloc_cnt),
+        static_cast<int>(100ULL * slab_alloc_cnt / small_alloc_cnt), HOST_LV_MEM_SLAB_SIZE / 1024,
+        static_cast<int>(stats.peak_used_size)
+    );
+    for (auto &class_stats : open_stats.classes) {
+        ESP_LOGI(
+            TAG, "Class(%3d B) with the app open: %d pages, %4d used, %4d free, frag %3d%%, waste %3d%%",
+            class_stats.block_size, static_cast<int>(class_stats.pages), static_cast<int>(class_stats.used),
+            static_cast<int>(class_stats.free), class_stats.frag_pct, class_stats.waste_pct
+        );
+    }
+
+    // Time of the replay with malloc alone and with the slab in front of it
+    using Clock = std::chrono::steady_clock;
+    MallocAllocator malloc_allocator;
+    float malloc_s = 0;
+    float slab_s = 0;
+    for (int run = 0; run < HOST_LV_MEM_BENCH_RUNS; run++) {
+        auto start = Clock::now();
+        HOST_CHECK(host_lv_mem_replay_ops(malloc_allocator, trace, 0, trace.ops.size(), ptrs, nullptr));
+        malloc_s += std::chrono::duration<float>(Clock::now() - start).count();
+
+        start = Clock::now();
+        HOST_CHECK(host_lv_mem_replay_ops(slab_allocator, trace, 0, trace.ops.size(), ptrs, nullptr));
+        slab_s += std::chrono::duration<float>(Clock::now() - start).count();
+    }
+    float op_num = static_cast<float>(trace.ops.size()) * HOST_LV_MEM_BENCH_RUNS;
+    ESP_LOGI(
+        TAG, "Replay: malloc %.1f ns/op, slab + malloc %.1f ns/op", malloc_s * 1e9f / op_num, slab_s * 1e9f / op_num
+    );
+
+    return true;
+}
+
+// Check the slab allocator of the LVGL small allocations of the speaker, and benchmark it against malloc on the
+// allocation trace of app open and close cycles
+HOST_CHECK_REGISTER(
+    lv_mem, "LVGL memory",
+    {"classes", host_lv_mem_check_classes},
+    {"realloc", host_lv_mem_check_realloc},
+    {"trace", host_lv_mem_check_trace}
+);
@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstdio>
+#include <cstdlib>
+#include "esp_log.h"
+#include "host_check.hpp"
+
+static const char *TAG = "host_test_speaker";
+
+extern "C" void app_main(void)
+{
+    int failures = host_check_run_all();
+
+    ESP_LOGI(TAG, "Finished, %d check(s) failed", failures);
+    fflush(stdout);
+    exit((failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,452 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "esp_log.h"
+#include "mem_tag.h"
+#include "host_check.hpp"
+
+// Same as the default of `CONFIG_EXAMPLE_MEM_TAG_CAPACITY` of the speaker
+#define HOST_MEM_TAG_CAPACITY       (4096)
+#define HOST_MEM_TAG_THREADS        (4)
+#define HOST_MEM_TAG_THREAD_OPS     (100000)
+// Live allocations of each thread, the table is about half full with all of them
+#define HOST_MEM_TAG_THREAD_LIVE    (400)
+// Blocks handed between the threads, so that they are freed by another thread than the one which allocated them
+#define HOST_MEM_TAG_SHARED         (64)
+#define HOST_MEM_TAG_BENCH_OPS      (1000000)
+
+static const char *TAG = "host_mem_tag";
+
+/* Allocations of the workloads, recorded like the heap hooks of ESP-IDF do */
+static void *host_mem_tag_malloc(size_t size)
+{
+    void *p = malloc(size);
+    mem_tag_record_alloc(p, size);
+    return p;
+}
+
+static void host_mem_tag_free(void *p)
+{
+    mem_tag_record_free(p);
+    free(p);
+}
+
+static bool host_mem_tag_init(std::vector<uint8_t> &table, size_t capacity)
+{
+    table.assign(mem_tag_get_table_size(capacity), 0);
+    return mem_tag_init(table.data(), table.size());
+}
+
+static bool host_mem_tag_check_scopes()
+{
+    std::vector<uint8_t> table;
+    HOST_CHECK(!mem_tag_init(nullptr, 0));
+    HOST_CHECK(host_mem_tag_init(table, 64));
+
+    mem_tag_t audio = mem_tag_register("audio");
+    mem_tag_t ui = mem_tag_register("ui");
+    HOST_CHECK((audio != MEM_TAG_NONE) && (ui != MEM_TAG_NONE) && (audio != ui));
+    HOST_CHECK(mem_tag_register(std::string("audio").c_str()) == audio);
+
+    // The innermost scope wins, deeper scopes than the stack keep its top and pop in pairs
+    HOST_CHECK(mem_tag_current() == MEM_TAG_NONE);
+    {
+        MemTagScope audio_scope(audio);
+        HOST_CHECK(mem_tag_current() == audio);
+        {
+            MemTagScope ui_scope(ui);
+            HOST_CHECK(mem_tag_current() == ui);
+            for (int i = 0; i < MEM_TAG_STACK_DEPTH + 4; i++) {
+                mem_tag_push(audio);
+            }
+            HOST_CHECK(mem_tag_current() == audio);
+            for (int i = 0; i < MEM_TAG_STACK_DEPTH + 4; i++) {
+                mem_tag_pop();
+            }
+            HOST_CHECK(mem_tag_current() == ui);
+            MemTagScope none_scope(MEM_TAG_NONE);
+            HOST_CHECK(mem_tag_current() == MEM_TAG_NONE);
+        }
+        HOST_CHECK(mem_tag_current() == audio);
+
+        // Each thread has its own stack
+        mem_tag_t thread_tag = audio;
+        std::thread([&thread_tag, ui]() {
+            thread_tag = mem_tag_current();
+            MemTagScope scope(ui);
+        }).join();
+        HOST_CHECK((thread_tag == MEM_TAG_NONE) && (mem_tag_current() == audio));
+    }
+    HOST_CHECK(mem_tag_current() == MEM_TAG_NONE);
+
+    // The number of tags is bounded
+    static char names[MEM_TAG_MAX][16];
+    int registered = 2;
+    for (int i = 0; i < MEM_TAG_MAX; i++) {
+        snprintf(names[i], sizeof(names[i]), "tag%d", i);
+        registered += (mem_tag_register(names[i]) != MEM_TAG_NONE) ? 1 : 0;
+    }
+    HOST_CHECK(registered == MEM_TAG_MAX - 1);
+
+    return true;
+}
+
+static bool host_mem_tag_check_accounting()
+{
+    std::vector<uint8_t> table;
+    HOST_CHECK(host_mem_tag_init(table, HOST_MEM_TAG_CAPACITY));
+    mem_tag_t json = mem_tag_register("json");
+    mem_tag_t lvgl = mem_tag_register("lvgl");
+
+    // Untagged allocations are not recorded
+    void *untagged = host_mem_tag_malloc(100);
+    std::vector<void *> blocks;
+    {
+        MemTagScope scope(json);
+        for (int i = 1; i <= 10; i++) {
+            blocks.push_back(host_mem_tag_malloc(i * 100));
+        }
+    }
+    void *lvgl_block = malloc(64);
+    mem_tag_record_alloc_as(lvgl, lvgl_block, 64);
+
+    mem_tag_snapshot_t snapshot;
+    mem_tag_take_snapshot(&snapshot, 0);
+    const mem_tag_stats_t &json_stats = snapshot.tags[json];
+    HOST_CHECK((json_stats.live_bytes == 5500) && (json_stats.live_cnt == 10));
+    HOST_CHECK((json_stats.peak_bytes == 5500) && (json_stats.alloc_cnt == 10));
+    HOST_CHECK((snapshot.tags[lvgl].live_bytes == 64) && (snapshot.tags[lvgl].live_cnt == 1));
+    HOST_CHECK(snapshot.tags[MEM_TAG_NONE].alloc_cnt == 0);
+    HOST_CHECK(snapshot.seq == 11);
+
+    // Frees are found without their tag, from any scope, and the peak stays
+    host_mem_tag_free(untagged);
+    for (size_t i = 0; i < blocks.size(); i += 2) {
+        host_mem_tag_free(blocks[i]);
+    }
+    mem_tag_record_free(lvgl_block);
+    free(lvgl_block);
+    mem_tag_take_snapshot(&snapshot, 0);
+    HOST_CHECK((json_stats.live_bytes == 3000) && (json_stats.live_cnt == 5));
+    HOST_CHECK((json_stats.peak_bytes == 5500) && (json_stats.free_cnt == 5));
+    HOST_CHECK((snapshot.tags[lvgl].live_bytes == 0) && (snapshot.tags[lvgl].free_cnt == 1));
+
+    // A realloc is a free and an allocation, possibly with another tag
+    {
+        MemTagScope scope(lvgl);
+        mem_tag_record_free(blocks[1]);
+        blocks[1] = realloc(blocks[1], 1000);
+        mem_tag_record_alloc(blocks[1], 1000);
+    }
+    mem_tag_take_snapshot(&snapshot, 0);
+    HOST_CHECK((json_stats.live_bytes == 2800) && (snapshot.tags[lvgl].live_bytes == 1000));
+
+    // The dump has a line for each tag which allocated, with the changes since the previous snapshot
+    mem_tag_snapshot_t previous = snapshot;
+    previous.time_us = 0;
+    {
+        MemTagScope scope(json);
+        blocks.push_back(host_mem_tag_malloc(4000));
+    }
+    mem_tag_take_snapshot(&snapshot, 2000000);
+    char dump[512];
+    size_t len = mem_tag_dump(dump, sizeof(dump), &snapshot, &previous);
+    HOST_CHECK((len == strlen(dump)) && (std::count(dump, dump + len, '\n') == 2));
+    const char *json_line = "json       live    6800 B     5 blk, peak    6800 B,   +4000 B,     0 alloc/s";
+    HOST_CHECK(strstr(dump, json_line) != nullptr);
+    HOST_CHECK(strstr(dump, "   2000 B/s\n") != nullptr);
+    HOST_CHECK(strstr(dump, "lvgl       live    1000 B     1 blk") != nullptr);
+    char short_dump[16];
+    HOST_CHECK(mem_tag_dump(short_dump, sizeof(short_dump), &snapshot, nullptr) > sizeof(short_dump));
+    HOST_CHECK(strlen(short_dump) == sizeof(short_dump) - 1);
+
+    for (size_t i = 1; i < 10; i += 2) {
+        host_mem_tag_free(blocks[i]);
+    }
+    host_mem_tag_free(blocks.back());
+    mem_tag_take_snapshot(&snapshot, 0);
+    HOST_CHECK((json_stats.live_bytes == 0) && (json_stats.live_cnt == 0));
+    HOST_CHECK(snapshot.tags[lvgl].live_bytes == 0);
+
+    return true;
+}
+
+static bool host_mem_tag_check_threads()
+{
+    std::vector<uint8_t> table;
+    HOST_CHECK(host_mem_tag_init(table, HOST_MEM_TAG_CAPACITY));
+    mem_tag_t tags[HOST_MEM_TAG_THREADS];
+    static const char *names[HOST_MEM_TAG_THREADS] = {"audio", "ai", "ui", "net"};
+    for (int i = 0; i < HOST_MEM_TAG_THREADS; i++) {
+        tags[i] = mem_tag_register(names[i]);
+    }
+
+    // Every thread allocates with its own tag, and frees some of the blocks of the others
+    std::mutex shared_mutex;
+    std::vector<void *> shared;
+    std::atomic<uint32_t> expected_alloc_bytes[HOST_MEM_TAG_THREADS] = {};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < HOST_MEM_TAG_THREADS; i++) {
+        threads.emplace_back([ &, i]() {
+            std::mt19937 rng(i + 1);
+            std::vector<void *> live;
+            MemTagScope scope(tags[i]);
+            for (int op = 0; op < HOST_MEM_TAG_THREAD_OPS; op++) {
+                if ((live.size() < HOST_MEM_TAG_THREAD_LIVE) && (rng() % 2 == 0)) {
+                    size_t size = 16 + rng() % 512;
+                    live.push_back(host_mem_tag_malloc(size));
+                    expected_alloc_bytes[i] += size;
+                    continue;
+                }
+                if (live.empty()) {
+                    continue;
+                }
+                size_t index = rng() % live.size();
+                void *p = live[index];
+                live[index] = live.back();
+                live.pop_back();
+                if (rng() % 8 == 0) {
+                    std::lock_guard<std::mutex> lock(shared_mutex);
+                    shared.push_back(p);
+                    if (shared.size() <= HOST_MEM_TAG_SHARED) {
+                        continue;
+                    }
+                    size_t shared_index = rng() % shared.size();
+                    p = shared[shared_index];
+                    shared[shared_index] = shared.back();
+                    shared.pop_back();
+                }
+                host_mem_tag_free(p);
+            }
+            std::lock_guard<std::mutex> lock(shared_mutex);
+            shared.insert(shared.end(), live.begin(), live.end());
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    mem_tag_snapshot_t snapshot;
+    mem_tag_take_snapshot(&snapshot, 0);
+    uint32_t live_cnt = 0;
+    for (int i = 0; i < HOST_MEM_TAG_THREADS; i++) {
+        const mem_tag_stats_t &stats = snapshot.tags[tags[i]];
+        HOST_CHECK(stats.untracked_cnt == 0);
+        HOST_CHECK(stats.alloc_bytes == expected_alloc_bytes[i]);
+        HOST_CHECK(stats.alloc_cnt - stats.free_cnt == stats.live_cnt);
+        live_cnt += stats.live_cnt;
+    }
+    HOST_CHECK(live_cnt == shared.size());
+    for (auto p : shared) {
+        host_mem_tag_free(p);
+    }
+    mem_tag_take_snapshot(&snapshot, 0);
+    for (int i = 0; i < HOST_MEM_TAG_THREADS; i++) {
+        HOST_CHECK((snapshot.tags[tags[i]].live_bytes == 0) && (snapshot.tags[tags[i]].live_cnt == 0));
+        HOST_CHECK(snapshot.tags[tags[i]].peak_bytes > 0);
+    }
+
+    return true;
+}
+
+static void host_mem_tag_collect_leak(void *ptr, size_t size, mem_tag_t tag, void *user_data)
+{
+    (void)size;
+    (void)tag;
+    static_cast<std::vector<void *> *>(user_data)->push_back(ptr);
+}
+
+static bool host_mem_tag_check_leaks()
+{
+    std::vector<uint8_t> table;
+    HOST_CHECK(host_mem_tag_init(table, HOST_MEM_TAG_CAPACITY));
+    mem_tag_t ai = mem_tag_register("ai");
+    mem_tag_t json = mem_tag_register("json");
+
+    // Long lived blocks before the first snapshot are not reported
+    std::vector<void *> resident;
+    {
+        MemTagScope scope(ai);
+        for (int i = 0; i < 50; i++) {
+            resident.push_back(host_mem_tag_malloc(256));
+        }
+    }
+    mem_tag_snapshot_t before;
+    mem_tag_take_snapshot(&before, 0);
+
+    // Chat rounds: the requests and responses are freed, but every round leaks one parsed JSON node
+    std::vector<void *> leaked;
+    for (int round = 0; round < 20; round++) {
+        MemTagScope scope(ai);
+        void *request = host_mem_tag_malloc(2048);
+        {
+            MemTagScope json_scope(json);
+            std::vector<void *> nodes;
+            for (int i = 0; i < 30; i++) {
+                nodes.push_back(host_mem_tag_malloc(64));
+            }
+            leaked.push_back(nodes[round % nodes.size()]);
+            nodes.erase(nodes.begin() + round % nodes.size());
+            for (auto node : nodes) {
+                host_mem_tag_free(node);
+            }
+        }
+        host_mem_tag_free(request);
+    }
+    mem_tag_snapshot_t after;
+    mem_tag_take_snapshot(&after, 0);
+
+    // Blocks allocated after the last snapshot are not reported either
+    void *late = nullptr;
+    {
+        MemTagScope scope(json);
+        late = host_mem_tag_malloc(64);
+    }
+
+    std::vector<void *> found;
+    HOST_CHECK(mem_tag_find_leaks(&before, &after, host_mem_tag_collect_leak, &found) == leaked.size());
+    std::sort(found.begin(), found.end());
+    std::sort(leaked.begin(), leaked.end());
+    HOST_CHECK(found == leaked);
+    HOST_CHECK(after.tags[json].live_bytes - before.tags[json].live_bytes == 64 * leaked.size());
+    HOST_CHECK(after.tags[ai].live_bytes == before.tags[ai].live_bytes);
+
+    // Once freed, they are not reported anymore
+    for (auto p : leaked) {
+        host_mem_tag_free(p);
+    }
+    HOST_CHECK(mem_tag_find_leaks(&before, &after, nullptr, nullptr) == 0);
+    host_mem_tag_free(late);
+    for (auto p : resident) {
+        host_mem_tag_free(p);
+    }
+
+    return true;
+}
+
+static bool host_mem_tag_check_full_table()
+{
+    std::vector<uint8_t> table;
+    HOST_CHECK(host_mem_tag_init(table, 16));
+    mem_tag_t audio = mem_tag_register("audio");
+
+    // The allocations which don't fit are counted as untracked, and their frees are ignored
+    std::vector<void *> blocks;
+    {
+        MemTagScope scope(audio);
+        for (int i = 0; i < 40; i++) {
+            blocks.push_back(host_mem_tag_malloc(10));
+        }
+    }
+    mem_tag_snapshot_t snapshot;
+    mem_tag_take_snapshot(&snapshot, 0);
+    const mem_tag_stats_t &stats = snapshot.tags[audio];
+    HOST_CHECK((stats.live_cnt == 16) && (stats.untracked_cnt == 24) && (stats.live_bytes == 160));
+    for (auto p : blocks) {
+        host_mem_tag_free(p);
+    }
+    mem_tag_take_snapshot(&snapshot, 0);
+    HOST_CHECK((stats.live_cnt == 0) && (stats.live_bytes == 0) && (stats.free_cnt == 16));
+
+    // The deleted entries are reused
+    {
+        MemTagScope scope(audio);
+        for (int i = 0; i < 16; i++) {
+            blocks[i] = host_mem_tag_malloc(10);
+        }
+    }
+    mem_tag_take_snapshot(&snapshot, 0);
+    HOST_CHECK((stats.live_cnt == 16) && (stats.untracked_cnt == 24));
+    for (int i = 0; i < 16; i++) {
+        host_mem_tag_free(blocks[i]);
+    }
+
+    return true;
+}
+
+static bool host_mem_tag_check_overhead()
+{
+    std::vector<uint8_t> table;
+    HOST_CHECK(host_mem_tag_init(table, HOST_MEM_TAG_CAPACITY));
+    mem_tag_t ui = mem_tag_register("ui");
+
+    // The table holds the live blocks of a busy system, the benchmark allocates and frees next to them
+    std::vector<void *> live;
+    {
+        MemTagScope scope(ui);
+        for (int i = 0; i < HOST_MEM_TAG_CAPACITY / 2; i++) {
+            live.push_back(host_mem_tag_malloc(32));
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto bench = [](bool is_recorded) {
+        void *blocks[64] = {};
+        auto start = Clock::now();
+        for (int op = 0; op < HOST_MEM_TAG_BENCH_OPS; op++) {
+            void *&p = blocks[op % 64];
+            if (p != nullptr) {
+                if (is_recorded) {
+                    mem_tag_record_free(p);
+                }
+                free(p);
+            }
+            p = malloc(32 + op % 64);
+            if (is_recorded) {
+                mem_tag_record_alloc(p, 32 + op % 64);
+            }
+        }
+        float elapsed_s = std::chrono::duration<float>(Clock::now() - start).count();
+        for (auto p : blocks) {
+            if (is_recorded) {
+                mem_tag_record_free(p);
+            }
+            free(p);
+        }
+        return elapsed_s * 1e9f / HOST_MEM_TAG_BENCH_OPS;
+    };
+    float plain_ns = bench(false);
+    float untagged_ns = bench(true);
+    float tagged_ns = 0;
+    {
+        MemTagScope scope(ui);
+        tagged_ns = bench(true);
+    }
+    ESP_LOGI(
+        TAG, "Allocation and free: plain %.1f ns, untagged %.1f ns, tagged %.1f ns, with %d tagged blocks live",
+        plain_ns, untagged_ns, tagged_ns, HOST_MEM_TAG_CAPACITY / 2
+    );
+
+    mem_tag_snapshot_t snapshot;
+    mem_tag_take_snapshot(&snapshot, 0);
+    HOST_CHECK((snapshot.tags[ui].live_cnt == live.size()) && (snapshot.tags[ui].untracked_cnt == 0));
+    for (auto p : live) {
+        host_mem_tag_free(p);
+    }
+
+    return true;
+}
+
+// Check the heap telemetry by subsystem of the speaker on synthetic tagged workloads, and benchmark the time it adds to
+// each allocation and free
+HOST_CHECK_REGISTER(
+    mem_tag, "Heap telemetry",
+    {"scopes", host_mem_tag_check_scopes},
+    {"accounting", host_mem_tag_check_accounting},
+    {"threads", host_mem_tag_check_threads},
+    {"leaks", host_mem_tag_check_leaks},
+    {"full_table", host_mem_tag_check_full_table},
+    {"overhead", host_mem_tag_check_overhead}
+);
@@ -6,15 +6,17 @@
  * LVGL自定义内存管理实现文件
  * 
  * 本文件为LVGL图形库提供自定义的内存分配实现，主要特点：
- * - 使用ESP32的heap_caps_malloc()替代标准malloc()
- * - 优先从SPIRAM（外部PSRAM）分配内存，提高内存利用率
+ * - 小块内存（不超过256字节）由内部RAM中的slab分配器提供，见mem_slab.h
+ * - 大块内存使用ESP32的heap_caps_malloc()从SPIRAM（外部PSRAM）分配
  * - 针对LVGL的内存使用模式进行优化
  * - 支持大内存对象的高效分配（如图像缓冲区、画布等）
- * 
+ *
  * 内存分配策略：
+ * - 样式、事件描述符、绘制任务、动画等频繁分配的小对象走slab快速路径，
+ *   避免PSRAM的访问延迟和通用堆的锁开销
+ * - slab的页用尽时，小块内存也退回到PSRAM，不会分配失败
  * - MEM_CAPS设置为SPIRAM优先，充分利用外部PSRAM
  * - 支持8位对齐的内存访问要求
- * - 自动处理内存碎片和大块内存需求
  * 
  * 适用场景：
  * - ESP32-S3等具有PSRAM的芯片
@@ -32,7 +34,11 @@
 #include "lvgl.h"
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
 
+#include <string.h>
 #include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "mem_slab.h"
+#include "mem_tag.h"
 
 /*********************
  *      宏定义
@@ -41,6 +47,9 @@
 #define MEM_CAPS (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
 // 备选方案：使用内部RAM（注释掉）
 // #define MEM_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+// slab分配器的内存：内部RAM + 8位对齐
+#define SLAB_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define SLAB_SIZE (CONFIG_EXAMPLE_LV_MEM_SLAB_SIZE_KB * 1024)
 
 /**********************
  *      类型定义
@@ -54,9 +63,41 @@
  *  静态变量
  **********************/
 
+// slab分配器实例及其内存，内存分配失败时所有分配都走PSRAM
+static mem_slab_t slab;
+static void *slab_mem = NULL;
+#if LV_USE_OS != LV_OS_NONE
+// LVGL的绘制线程会在不持有LVGL锁时分配内存，此时slab需要自己的锁
+static portMUX_TYPE slab_lock = portMUX_INITIALIZER_UNLOCKED;
+#endif
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+// 堆内存统计中LVGL的标签
+static mem_tag_t lvgl_tag = MEM_TAG_NONE;
+#endif
+
 /**********************
  *      宏函数
  **********************/
+#if LV_USE_OS != LV_OS_NONE
+#define SLAB_LOCK()     portENTER_CRITICAL(&slab_lock)
+#define SLAB_UNLOCK()   portEXIT_CRITICAL(&slab_lock)
+#else
+// 所有LVGL调用都持有LVGL锁，slab不需要再加锁
+#define SLAB_LOCK()
+#define SLAB_UNLOCK()
+#endif
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+// slab中的块直接记到LVGL标签下，PSRAM中的块由堆钩子按压入的LVGL标签记录
+#define TAG_SLAB_ALLOC(p, size) mem_tag_record_alloc_as(lvgl_tag, p, size)
+#define TAG_SLAB_FREE(p)        mem_tag_record_free(p)
+#define TAG_HEAP_BEGIN()        mem_tag_push(lvgl_tag)
+#define TAG_HEAP_END()          mem_tag_pop()
+#else
+#define TAG_SLAB_ALLOC(p, size)
+#define TAG_SLAB_FREE(p)
+#define TAG_HEAP_BEGIN()
+#define TAG_HEAP_END()
+#endif
 
 /**********************
  *   全局函数实现
@@ -64,24 +105,42 @@
 
 /**
  * @brief LVGL内存管理初始化
- * 
- * 由于使用ESP32的heap_caps系统，无需特殊初始化。
- * PSRAM在系统启动时已由ESP-IDF初始化。
+ *
+ * 从内部RAM申请slab分配器的内存。申请失败时不影响LVGL运行，
+ * 所有分配都退回到PSRAM。PSRAM在系统启动时已由ESP-IDF初始化。
  */
 void lv_mem_init(void)
 {
-    return; /* 无需初始化操作 */
+    if (slab_mem != NULL) {
+        return; /* 已经初始化 */
+    }
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+    lvgl_tag = mem_tag_register("lvgl");
+#endif
+
+    slab_mem = heap_caps_malloc(SLAB_SIZE, SLAB_CAPS);
+    if ((slab_mem == NULL) || !mem_slab_init(&slab, slab_mem, SLAB_SIZE)) {
+        LV_LOG_WARN("No internal RAM for the slab, all allocations use PSRAM");
+        free(slab_mem);
+        slab_mem = NULL;
+        memset(&slab, 0, sizeof(slab));
+    }
 }
 
 /**
  * @brief LVGL内存管理反初始化
- * 
- * 由于使用系统级内存管理，无需特殊清理操作。
+ *
+ * 所有小块内存都已释放时，把slab分配器的内存还给内部RAM。
  */
 void lv_mem_deinit(void)
 {
-    return; /* 无需反初始化操作 */
+    if ((slab_mem == NULL) || (slab.used_size > 0)) {
+        return; /* 仍有小块内存在使用，保留slab */
+    }
 
+    memset(&slab, 0, sizeof(slab));
+    free(slab_mem);
+    slab_mem = NULL;
 }
 
 /**
@@ -117,74 +176,147 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 /**
  * @brief LVGL核心内存分配函数
- * 
+ *
+ * 小块内存先从内部RAM的slab分配，大块内存或slab用尽时，
  * 使用ESP32的heap_caps_malloc()从SPIRAM分配内存。
- * 这确保了LVGL的内存分配优先使用外部PSRAM，
- * 从而为其他组件保留更多的内部RAM。
- * 
+ *
  * @param size 要分配的内存大小（字节）
  * @return void* 分配的内存指针，失败时返回NULL
  */
 void *lv_malloc_core(size_t size)
 {
-    return heap_caps_malloc(size, MEM_CAPS);
+    if (size <= MEM_SLAB_MAX_BLOCK_SIZE) {
+        SLAB_LOCK();
+        void *p = mem_slab_alloc(&slab, size);
+        SLAB_UNLOCK();
+        if (p != NULL) {
+            TAG_SLAB_ALLOC(p, size);
+            return p;
+        }
+    }
+
+    TAG_HEAP_BEGIN();
+    void *p = heap_caps_malloc(size, MEM_CAPS);
+    TAG_HEAP_END();
+
+    return p;
 }
 
 /**
  * @brief LVGL核心内存重分配函数
- * 
- * 使用ESP32的heap_caps_realloc()重新分配内存大小。
- * 保持与原始分配相同的内存类型属性（SPIRAM优先）。
- * 
+ *
+ * slab中的块在新大小仍放得下时原地返回，否则分配新内存并复制内容。
+ * 其他内存使用ESP32的heap_caps_realloc()重新分配，保持SPIRAM优先。
+ *
  * @param p 原内存指针
  * @param new_size 新的内存大小（字节）
  * @return void* 重新分配的内存指针，失败时返回NULL
  */
 void *lv_realloc_core(void *p, size_t new_size)
 {
-    return heap_caps_realloc(p, new_size, MEM_CAPS);
+    if (p == NULL) {
+        return lv_malloc_core(new_size);
+    }
+    if (!mem_slab_owns(&slab, p)) {
+        TAG_HEAP_BEGIN();
+        void *new_p = heap_caps_realloc(p, new_size, MEM_CAPS);
+        TAG_HEAP_END();
+        return new_p;
+    }
+
+    size_t block_size = mem_slab_block_size(&slab, p);
+    if (new_size <= block_size) {
+        TAG_SLAB_FREE(p);
+        TAG_SLAB_ALLOC(p, new_size);
+        return p;
+    }
+    void *new_p = lv_malloc_core(new_size);
+    if (new_p != NULL) {
+        memcpy(new_p, p, block_size);
+        lv_free_core(p);
+    }
+
+    return new_p;
 }
 
 /**
  * @brief LVGL核心内存释放函数
- * 
- * 释放之前分配的内存。由于heap_caps_malloc()分配的内存
- * 可以用标准free()释放，这里直接使用free()。
- * 
+ *
+ * slab中的块按地址范围识别并还给slab。由于heap_caps_malloc()分配的内存
+ * 可以用标准free()释放，其他内存直接使用free()。
+ *
  * @param p 要释放的内存指针
  */
 void lv_free_core(void *p)
 {
+    if (mem_slab_owns(&slab, p)) {
+        TAG_SLAB_FREE(p);
+        SLAB_LOCK();
+        mem_slab_free(&slab, p);
+        SLAB_UNLOCK();
+        return;
+    }
+
     free(p);
 }
 
 /**
- * @brief LVGL内存监控函数（不支持）
- * 
- * 在当前实现中不提供详细的内存使用统计。
- * 可以通过ESP32的heap_caps_get_info()获取堆信息。
- * 
+ * @brief LVGL内存监控函数
+ *
+ * 合并slab和SPIRAM堆的使用情况，碎片率取自SPIRAM堆。
+ * 只读取计数，可以在不持有LVGL锁的监控线程中调用。
+ * 各尺寸级别的使用情况和碎片见lv_mem_slab_get_stats()。
+ *
  * @param mon_p 内存监控结构体指针
  */
 void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
 {
-    /* 不支持详细内存监控 */
-    LV_UNUSED(mon_p);
-    return;
+    mem_slab_stats_t slab_stats;
+    multi_heap_info_t heap_info;
+    mem_slab_get_stats(&slab, &slab_stats);
+    heap_caps_get_info(&heap_info, MEM_CAPS);
+
+    size_t heap_total = heap_info.total_free_bytes + heap_info.total_allocated_bytes;
+    mon_p->total_size = slab_stats.total_size + heap_total;
+    mon_p->free_size = slab_stats.free_size + heap_info.total_free_bytes;
+    mon_p->free_biggest_size = heap_info.largest_free_block;
+    mon_p->free_cnt = heap_info.free_blocks;
+    mon_p->used_cnt = slab_stats.used_cnt + heap_info.allocated_blocks;
+    mon_p->max_used = slab_stats.peak_used_size + (heap_total - heap_info.minimum_free_bytes);
+    mon_p->used_pct = (mon_p->total_size > 0) ?
+                      (uint8_t)((mon_p->total_size - mon_p->free_size) * 100 / mon_p->total_size) : 0;
+    mon_p->frag_pct = (heap_info.total_free_bytes > 0) ?
+                      (uint8_t)(100 - heap_info.largest_free_block * 100 / heap_info.total_free_bytes) : 0;
 }
 
 /**
- * @brief LVGL内存测试函数（不支持）
- * 
- * 在当前实现中不提供内存完整性测试。
- * ESP32的heap_caps系统已提供基本的内存保护。
- * 
- * @return lv_result_t 总是返回LV_RESULT_OK
+ * @brief LVGL内存测试函数
+ *
+ * 检查slab的空闲链表和计数是否一致，以及SPIRAM堆的完整性。
+ *
+ * @return lv_result_t 发现损坏时返回LV_RESULT_INVALID
  */
 lv_result_t lv_mem_test_core(void)
 {
-    /* 不支持内存测试 */
-    return LV_RESULT_OK;
+    SLAB_LOCK();
+    bool is_ok = mem_slab_check(&slab);
+    SLAB_UNLOCK();
+    if (!is_ok) {
+        LV_LOG_ERROR("Slab is corrupted");
+        return LV_RESULT_INVALID;
+    }
+
+    return heap_caps_check_integrity(MEM_CAPS, true) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+/**
+ * @brief 获取slab各尺寸级别的使用情况和碎片
+ *
+ * @param stats 统计结果
+ */
+void lv_mem_slab_get_stats(mem_slab_stats_t *stats)
+{
+    mem_slab_get_stats(&slab, stats);
 }
 
 /**********************
@@ -45,6 +45,7 @@
 #include "esp_log.h"              // ESP日志系统：分级日志输出(ERROR/WARN/INFO/DEBUG)
 #include "esp_event.h"            // ESP事件循环：系统事件分发和处理机制
 #include "esp_spiffs.h"           // SPIFFS文件系统：轻量级文件系统，用于存储配置文件
+#include "esp_timer.h"            // ESP高精度定时器：获取系统运行时间(微秒)
 
 // ==================== USB 开发者模式相关头文件 ====================
 #if SOC_USB_SERIAL_JTAG_SUPPORTED
@@ -79,6 +80,11 @@
 
 #include "usb_msc.h"                // USB大容量存储类：实现USB磁盘功能
 #include "audio_sys.h"              // 音频系统：音频处理和管理模块
+#include "mem_slab.h"               // slab分配器：LVGL小块内存的统计
+#include "mem_tag.h"                // 堆内存统计：按子系统标记分配
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+#   include "cJSON.h"               // cJSON：安装内存钩子，把JSON解析的内存记到json标签下
+#endif
 #include "coze_agent_config.h"      // Coze AI代理配置：AI助手配置文件解析
 #include "coze_agent_config_default.h"  // Coze AI代理默认配置：内置的默认AI配置
 
@@ -98,7 +104,7 @@ constexpr int         LVGL_TASK_PRIORITY        = 4;         // LVGL任务优先
 constexpr int         LVGL_TASK_CORE_ID         = 1;         // LVGL任务运行的CPU核心(ESP32-S3双核)
 constexpr int         LVGL_TASK_STACK_SIZE      = 20 * 1024; // LVGL任务栈大小(20KB)
 constexpr int         LVGL_TASK_MAX_SLEEP_MS    = 500;       // LVGL任务最大休眠时间(毫秒)
-constexpr int         LVGL_TASK_TIMER_PERIOD_MS = 5;         // LVGL定时器周期(5毫秒刷新一次)
+constexpr int         LVGL_TASK_TIMER_PERIOD_MS = 0;         // LVGL时基周期，0表示无周期中断，按需读取esp_timer时间
 constexpr bool        LVGL_TASK_STACK_CAPS_EXT  = true;      // 是否使用外部PSRAM作为栈内存
 
 // ==================== 音频系统参数配置 ====================
@@ -113,27 +119,34 @@ constexpr int         PARAM_DISPLAY_BRIGHTNESS_MIN      = 10;  // 最小亮度(1
 constexpr int         PARAM_DISPLAY_BRIGHTNESS_MAX      = 100; // 最大亮度(100%)
 constexpr int         PARAM_DISPLAY_BRIGHTNESS_DEFAULT  = 100; // 系统默认亮度
 
+// ==================== 启动编排配置 ====================
+constexpr size_t      BOOT_SPEAKER_STAGE_STACK_SIZE     = 20 * 1024; // 创建音箱阶段的任务栈大小(与主任务相同)
+
+// ==================== 显示合成器配置 ====================
+// 动画帧作为底层，LVGL 只绘制系统控件(快速设置、键盘等)作为叠加层，两者每帧合成一次后刷新到屏幕，
+// 这样动画和界面可以同时显示，无需在两种绘制模式之间切换
+constexpr bool        DISPLAY_COMPOSITOR_ENABLE             = true;      // 是否启用显示合成器(否则使用虚拟绘制模式切换)
+constexpr uint32_t    DISPLAY_COMPOSITOR_KEY_COLOR24        = 0xFF00FF;  // 叠加层的透明关键色(品红，转换为RGB565无损)
+constexpr int         DISPLAY_COMPOSITOR_STATS_INTERVAL_MS  = 0;         // 输出帧率和刷新带宽统计的间隔(毫秒)，0表示不输出
+
+// ==================== 清屏配置 ====================
+// 清屏和动画停止时的清除区域都通过常驻的小行缓冲区分条刷新到屏幕，不再每次分配整块的黑色缓冲区
+constexpr int         DISPLAY_FILL_LINES            = 20;    // 行缓冲区的行数(360x20 RGB565 约14KB，分配在支持DMA的内部RAM)
+constexpr int         ANIMATION_STOP_FADE_STEPS     = 0;     // 动画停止时渐隐的步数，0或1表示直接清除
+constexpr int         ANIMATION_STOP_FADE_STEP_MS   = 30;    // 渐隐每一步的间隔(毫秒)
+
 // ==================== AI函数调用 - 应用启动功能配置 ====================
 // 当AI助手识别到"打开XX应用"指令时，这些参数控制应用启动过程
-constexpr const char *FUNCTION_OPEN_APP_THREAD_NAME               = "open_app";     // 应用启动线程名称
-constexpr int         FUNCTION_OPEN_APP_THREAD_STACK_SIZE         = 10 * 1024;     // 线程栈大小(10KB)
 constexpr int         FUNCTION_OPEN_APP_WAIT_SPEAKING_PRE_MS      = 2000;          // 等待AI语音播放前的延时(2秒)
 constexpr int         FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS = 10;            // 检查AI是否还在说话的间隔(10毫秒)
 constexpr int         FUNCTION_OPEN_APP_WAIT_SPEAKING_MAX_MS      = 2000;          // 最长等待AI说完的时间(2秒)
-constexpr bool        FUNCTION_OPEN_APP_THREAD_STACK_CAPS_EXT     = true;          // 是否使用外部PSRAM作为栈
 
 // ==================== AI函数调用 - 音量控制功能配置 ====================
 // 当AI助手识别到"调大音量"、"调小音量"等指令时，这些参数控制音量调节过程
-constexpr const char *FUNCTION_VOLUME_CHANGE_THREAD_NAME           = "volume_change";  // 音量调节线程名称
-constexpr size_t      FUNCTION_VOLUME_CHANGE_THREAD_STACK_SIZE     = 6 * 1024;         // 线程栈大小(6KB)
-constexpr bool        FUNCTION_VOLUME_CHANGE_THREAD_STACK_CAPS_EXT = true;             // 是否使用外部PSRAM作为栈
 constexpr int         FUNCTION_VOLUME_CHANGE_STEP                  = 20;               // 每次音量调节的步长值
 
 // ==================== AI函数调用 - 亮度控制功能配置 ====================
 // 当AI助手识别到"调亮屏幕"、"调暗屏幕"等指令时，这些参数控制亮度调节过程
-constexpr const char *FUNCTION_BRIGHTNESS_CHANGE_THREAD_NAME           = "brightness_change";  // 亮度调节线程名称
-constexpr size_t      FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_SIZE     = 6 * 1024;             // 线程栈大小(6KB)
-constexpr bool        FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT = true;                 // 是否使用外部PSRAM作为栈
 constexpr int         FUNCTION_BRIGHTNESS_CHANGE_STEP                  = 30;                   // 每次亮度调节的步长值
 
 // ==================== 命名空间使用声明 ====================
@@ -153,12 +166,21 @@ static bool init_media_audio();                // 初始化音频编解码器和
 static bool init_services();                   // 初始化NVS存储等系统服务
 static bool load_coze_agent_config();          // 加载AI助手(Coze)的配置参数
 static bool create_speaker_and_install_apps(); // 创建音箱主对象并安装所有应用
+static bool init_mem_tag();                    // 初始化按子系统标记的堆内存统计
+static Boot::StageFunction with_mem_tag(const char *tag_name, Boot::StageFunction function); // 标记启动阶段的分配
 
 // ==================== 全局变量定义 ====================
 // 音频设备句柄 - 用于音频播放和录音功能
 static esp_codec_dev_handle_t play_dev = nullptr;  // 音频播放设备句柄(扬声器)
 static esp_codec_dev_handle_t rec_dev = nullptr;   // 音频录音设备句柄(麦克风)
 
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+// 显示合成器 - 合成动画底层和LVGL叠加层
+static Compositor display_compositor;
+#endif
+// 屏幕填充器 - 用常驻的行缓冲区清屏，避免每次清屏分配整屏大小的缓冲区
+static PanelFiller panel_filler;
+
 /**
  * @brief 开发者模式密钥变量
  * 
@@ -183,52 +205,96 @@ extern const char private_key_pem_end[]   asm("_binary_private_key_pem_end");
  * @brief 智能音箱系统主函数
  * 
  * 这是整个ESP-Brookesia智能音箱系统的入口点和初始化控制中心。
- * 函数按照严格的顺序初始化各个子系统，确保系统的稳定启动。
+ * 各个子系统作为启动阶段交给启动编排器(Boot)，每个阶段声明它依赖的阶段，
+ * 依赖都完成后立即在独立的任务中运行，互不依赖的阶段(如SD卡和音频)同时进行。
  * 
- * 初始化顺序说明：
- * 1. 显示和绘图逻辑 - 初始化LCD屏幕和LVGL图形库，建立UI显示基础
- * 2. SD卡存储系统 - 挂载SD卡，用于存储配置文件、媒体资源等
- * 3. 开发者模式检查 - 判断是否需要进入USB调试模式进行开发调试
- * 4. 媒体音频系统 - 初始化音频编解码器，建立音频播放和录音基础
- * 5. 系统服务层 - 启动NVS存储服务，加载用户设置参数
- * 6. AI代理配置 - 加载Coze AI助手的配置参数和认证信息
- * 7. 音箱主体创建 - 创建音箱核心对象，安装所有应用程序
- * 8. 内存监控(可选) - 启动内存使用监控线程(仅调试模式)
+ * 启动阶段及其依赖：
+ * 1. display        - 初始化LCD屏幕和LVGL图形库，同时打开板级电源和I2C总线
+ * 2. sdcard         - 挂载SD卡(依赖display：未插卡时需要显示提示)
+ * 3. developer_mode - 开发者模式检查(依赖sdcard：开发者模式把SD卡作为USB磁盘)
+ * 4. audio          - 初始化音频编解码器(依赖display：共用板级电源和I2C总线)
+ * 5. services       - 启动NVS存储服务，把音量和亮度应用到硬件(依赖audio和display)
+ * 6. agent_config   - 从SD卡加载Coze AI助手配置(依赖developer_mode，允许失败)
+ * 7. speaker        - 创建音箱核心对象，安装所有应用程序(依赖以上全部)
+ * 启动完成后输出每个阶段的开始/结束时间和关键路径。
  * 
- * @note 此函数使用assert()确保关键初始化步骤必须成功，
- *       如果任何步骤失败，系统将停止运行并输出错误信息。
+ * @note 此函数使用assert()确保关键启动阶段必须成功，
+ *       如果任何阶段失败，系统将停止运行并输出错误信息。
  */
 extern "C" void app_main()
 {
     // 打印项目版本信息，用于调试和版本追踪
     printf("Project version: %s\n", CONFIG_APP_PROJECT_VER);
 
-    // ==================== 系统初始化阶段 ====================
-    // 按照依赖关系的顺序初始化各个子系统，使用assert确保每步都成功
-    
-    // 第1步：初始化显示系统 - LCD屏幕、LVGL图形库、动画引擎
-    assert(init_display_and_draw_logic()        && "Initialize display and draw logic failed");
-    
-    // 第2步：初始化SD卡存储 - 挂载文件系统，准备配置文件和资源访问
-    assert(init_sdcard()                        && "Initialize SD card failed");
-    
-    // 第3步：开发者模式检查 - 如果激活了开发者模式，系统会变成USB磁盘
-    assert(check_whether_enter_developer_mode() && "Check whether enter developer mode failed");
-    
-    // 第4步：初始化音频系统 - 音频编解码器、播放设备、录音设备
-    assert(init_media_audio()                   && "Initialize media audio failed");
-    
-    // 第5步：初始化系统服务 - NVS存储、用户设置参数加载
-    assert(init_services()                      && "Initialize services failed");
-    
-    // 第6步：加载AI助手配置 - Coze平台的认证信息和机器人配置
-    // 注意：这一步允许失败，系统会使用内置的默认配置
-    if (!load_coze_agent_config()) {
-        ESP_UTILS_LOGE("Load coze agent config failed, will use default config");
+    // 堆内存统计需要在其他任务开始分配之前初始化，失败时不影响运行
+    if (!init_mem_tag()) {
+        ESP_UTILS_LOGW("Heap telemetry is not available");
     }
-    
-    // 第7步：创建音箱主对象 - 启动完整的UI系统和所有应用程序
-    assert(create_speaker_and_install_apps()    && "Create speaker and install apps failed");
+
+    // ==================== 系统启动阶段 ====================
+    // 按照依赖关系编排各个子系统，使用assert确保所有必需的阶段都成功
+    Boot boot;
+
+    // 显示系统 - LCD屏幕、LVGL图形库、动画引擎，其余阶段都依赖它打开的板级电源
+    boot.addStage({
+        .name = "display",
+        .function = with_mem_tag("display", init_display_and_draw_logic),
+    });
+
+    // SD卡存储 - 与音频初始化同时进行，运行在LVGL所在的核心上
+    boot.addStage({
+        .name = "sdcard",
+        .depends = {"display"},
+        .function = with_mem_tag("sdcard", init_sdcard),
+        .core_id = 1,
+    });
+
+    // 开发者模式检查 - 如果激活了开发者模式，系统会变成USB磁盘，此阶段不会返回
+    boot.addStage({
+        .name = "developer_mode",
+        .depends = {"display", "sdcard"},
+        .function = with_mem_tag("developer_mode", check_whether_enter_developer_mode),
+    });
+
+    // 音频系统 - 音频编解码器、播放设备、录音设备
+    // 开发者模式下不初始化音频，因此此时需要等待开发者模式检查
+    std::vector<std::string> audio_depends = {"display"};
+    if (developer_mode_key == DEVELOPER_MODE_KEY) {
+        audio_depends.push_back("developer_mode");
+    }
+    boot.addStage({
+        .name = "audio",
+        .depends = audio_depends,
+        .function = with_mem_tag("audio", init_media_audio),
+        .core_id = 0,
+    });
+
+    // 系统服务 - NVS存储、用户设置参数加载并应用到音频和显示硬件
+    boot.addStage({
+        .name = "services",
+        .depends = {"display", "audio"},
+        .function = with_mem_tag("services", init_services),
+    });
+
+    // AI助手配置 - Coze平台的认证信息和机器人配置
+    // 注意：这一步允许失败，系统会使用内置的默认配置
+    boot.addStage({
+        .name = "agent_config",
+        .depends = {"developer_mode"},
+        .function = with_mem_tag("agent_config", load_coze_agent_config),
+        .is_optional = true,
+    });
+
+    // 音箱主对象 - 启动完整的UI系统和所有应用程序，原先在主任务中运行，沿用主任务的栈大小
+    boot.addStage({
+        .name = "speaker",
+        .depends = {"developer_mode", "services", "agent_config"},
+        .function = with_mem_tag("speaker", create_speaker_and_install_apps),
+        .stack_size = BOOT_SPEAKER_STAGE_STACK_SIZE,
+    });
+
+    assert(boot.run() && "Boot failed");
+    boot.dumpTimeline();
 
     // ==================== 可选的系统监控功能 ====================
     // 仅在调试模式下启用内存使用监控，用于性能分析和内存泄漏检测
@@ -242,6 +308,18 @@ extern "C" void app_main()
         // 创建后台监控线程，定期输出系统内存使用信息
         boost::thread([ = ]() {
             char buffer[512];    /* 确保缓冲区足够大以容纳sprintf的内容 */
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+            // 快照和输出缓冲区较大，放在堆上；启动完成时的快照作为查找泄漏的基准
+            struct MemTagInfo {
+                mem_tag_snapshot_t boot;
+                mem_tag_snapshot_t previous;
+                mem_tag_snapshot_t current;
+                char dump[1024];
+            };
+            auto mem_tag_info = std::make_unique<MemTagInfo>();
+            mem_tag_take_snapshot(&mem_tag_info->boot, esp_timer_get_time());
+            mem_tag_info->previous = mem_tag_info->boot;
+#endif
 
             while (1) {
                 // 可选：堆内存完整性检查(耗时较长，通常注释掉)
@@ -257,6 +335,38 @@ extern "C" void app_main()
                         mon.total_size - mon.free_size, mon.used_pct, mon.frag_pct,
                         mon.free_biggest_size, mon.total_size, mon.free_size);
                 ESP_UTILS_LOGI("%s", buffer);
+#if CONFIG_LV_USE_CUSTOM_MALLOC
+                // 打印LVGL小块内存各尺寸级别的使用情况和碎片
+                mem_slab_stats_t slab_stats;
+                lv_mem_slab_get_stats(&slab_stats);
+                ESP_UTILS_LOGI(
+                    "LVGL Slab - used: %zu (peak %zu) / %zu, free pages: %d / %d, frag: %3d %%, misses: %d",
+                    slab_stats.used_size, slab_stats.peak_used_size, slab_stats.total_size,
+                    (int)slab_stats.free_page_num, (int)slab_stats.page_num, slab_stats.frag_pct,
+                    (int)slab_stats.miss_cnt
+                );
+                for (auto &class_stats : slab_stats.classes) {
+                    ESP_UTILS_LOGI(
+                        "  %3d B - pages: %d, used: %d (peak %d), free: %d, frag: %3d %%, waste: %3d %%",
+                        class_stats.block_size, (int)class_stats.pages, (int)class_stats.used,
+                        (int)class_stats.peak_used, (int)class_stats.free, class_stats.frag_pct,
+                        class_stats.waste_pct
+                    );
+                }
+#endif
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+                // 打印各子系统的存活内存、峰值和上一周期的分配速率，以及启动后分配、仍然存活的内存
+                mem_tag_take_snapshot(&mem_tag_info->current, esp_timer_get_time());
+                mem_tag_dump(
+                    mem_tag_info->dump, sizeof(mem_tag_info->dump), &mem_tag_info->current, &mem_tag_info->previous
+                );
+                ESP_UTILS_LOGI(
+                    "Heap by subsystem - %d tagged allocations since boot still live\n%s",
+                    (int)mem_tag_find_leaks(&mem_tag_info->boot, &mem_tag_info->current, nullptr, nullptr),
+                    mem_tag_info->dump
+                );
+                mem_tag_info->previous = mem_tag_info->current;
+#endif
 
                 // 获取音频系统的实时统计信息
                 audio_sys_get_real_time_stats();
@@ -268,6 +378,70 @@ extern "C" void app_main()
     }
 }
 
+// ==================== 堆内存统计 ====================
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+// cJSON的分配函数，释放直接使用free()，由堆钩子删除记录
+static mem_tag_t json_mem_tag = MEM_TAG_NONE;
+
+static void *json_malloc(size_t size)
+{
+    MemTagScope scope(json_mem_tag);
+    return malloc(size);
+}
+#endif
+
+/**
+ * @brief 初始化按子系统标记的堆内存统计
+ *
+ * 映射表放在PSRAM中，之后通过ESP-IDF的堆钩子记录所有带标签的分配。
+ * 同时为cJSON安装内存钩子，JSON解析和生成的内存都记到json标签下。
+ * 未启用CONFIG_EXAMPLE_MEM_TAG_ENABLE时什么都不做。
+ *
+ * @return true 初始化成功或未启用，false 映射表内存分配失败
+ */
+static bool init_mem_tag()
+{
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+    size_t table_size = mem_tag_get_table_size(CONFIG_EXAMPLE_MEM_TAG_CAPACITY);
+    void *table = heap_caps_malloc(table_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    ESP_UTILS_CHECK_NULL_RETURN(table, false, "Allocate heap telemetry table failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(mem_tag_init(table, table_size), false, "Init heap telemetry failed");
+
+    json_mem_tag = mem_tag_register("json");
+    cJSON_Hooks hooks = {
+        .malloc_fn = json_malloc,
+        .free_fn = free,
+    };
+    cJSON_InitHooks(&hooks);
+#endif
+
+    return true;
+}
+
+/**
+ * @brief 把启动阶段中的分配记到阶段名对应的标签下
+ *
+ * 阶段中创建的任务的栈和缓冲区也记在这个标签下，这些任务之后自己的分配不被记录，
+ * 需要时可以在任务中用MemTagScope标记。未启用堆内存统计时直接返回原函数。
+ *
+ * @param tag_name 标签名，需要一直有效
+ * @param function 阶段函数
+ * @return Boot::StageFunction 带标签的阶段函数
+ */
+static Boot::StageFunction with_mem_tag(const char *tag_name, Boot::StageFunction function)
+{
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+    mem_tag_t tag = mem_tag_register(tag_name);
+    return [tag, function]() {
+        MemTagScope scope(tag);
+        return function();
+    };
+#else
+    (void)tag_name;
+    return function;
+#endif
+}
+
 // ==================== 显示系统底层绘图函数 ====================
 /**
  * @brief 线程安全的位图绘制函数
@@ -334,26 +508,103 @@ static bool draw_bitmap_with_lock(lv_disp_t *disp, int x_start, int y_start, int
  * @param disp LVGL显示对象指针
  * @return true 清屏成功，false 清屏失败
  * 
- * @note 函数会创建一个临时的像素缓冲区，大小为整个屏幕的像素数据
- *       对于360x360分辨率的RGB565格式屏幕，需要259.2KB的临时内存
+ * @note 通过屏幕填充器的行缓冲区分条刷新，不需要分配整屏大小(360x360 RGB565 约253KB)的临时内存
  */
 static bool clear_display(lv_disp_t *disp)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
-    // 创建全黑的像素缓冲区
-    // BSP_LCD_H_RES * BSP_LCD_V_RES * 2: 宽度 x 高度 x 2字节(RGB565)
-    std::vector<uint8_t> buffer(BSP_LCD_H_RES * BSP_LCD_V_RES * 2, 0);
-    
-    // 使用绘图函数将黑色缓冲区绘制到整个屏幕
     ESP_UTILS_CHECK_FALSE_RETURN(
-        draw_bitmap_with_lock(disp, 0, 0, BSP_LCD_H_RES, BSP_LCD_V_RES, buffer.data()), 
-        false, "Failed to draw black screen buffer"
+        panel_filler.fill(0, 0, BSP_LCD_H_RES, BSP_LCD_V_RES, 0), false, "Failed to fill black screen"
     );
 
     return true;
 }
 
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+/**
+ * @brief LVGL刷新钩子：把LVGL绘制的区域交给显示合成器，作为叠加层
+ *
+ * @note 在LVGL任务中调用，区域的结束坐标包含在区域内，需要转换为合成器使用的开区间
+ */
+static void compositor_flush_hook(
+    lv_display_t *disp, const lv_area_t *area, uint8_t *color_map, bool is_last, void *user_data
+)
+{
+    auto compositor = static_cast<Compositor *>(user_data);
+    ESP_UTILS_CHECK_NULL_EXIT(compositor, "Invalid compositor");
+
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        compositor->updateOverlay(area->x1, area->y1, area->x2 + 1, area->y2 + 1, color_map, is_last),
+        "Failed to update compositor overlay"
+    );
+}
+
+/**
+ * @brief 定期输出显示合成器的统计信息
+ *
+ * 每个统计周期输出帧率、带有叠加层的帧所占比例、刷新到屏幕的带宽和合成耗时，然后清零重新统计，
+ * 便于对比有无叠加层(快速设置、键盘等)时的帧率和刷新带宽。
+ */
+static void post_compositor_stats_job()
+{
+    Executor::requestInstance().postDelayed([]() {
+        auto stats = display_compositor.getStats();
+        display_compositor.resetStats();
+
+        float elapsed_s = (esp_timer_get_time() - stats.begin_time_us) / 1000000.0f;
+        if ((elapsed_s > 0) && (stats.frames > 0)) {
+            ESP_UTILS_LOGI(
+                "Compositor: %.1f fps (%d%% with overlays), flush %.1f KB/s, overlay %.1f KB/s, compose %d us "
+                "(max %d us)", stats.frames / elapsed_s, static_cast<int>(stats.composed_frames * 100 / stats.frames),
+                stats.flush_bytes / 1024.0f / elapsed_s, stats.overlay_bytes / 1024.0f / elapsed_s,
+                static_cast<int>(stats.last_compose_us), static_cast<int>(stats.max_compose_us)
+            );
+        }
+
+        post_compositor_stats_job();
+    }, DISPLAY_COMPOSITOR_STATS_INTERVAL_MS, Executor::Priority::Low, "compositor_stats");
+}
+
+/**
+ * @brief 初始化显示合成器
+ *
+ * 合成器保存一份全屏的动画底层和LVGL叠加层，叠加层中关键色的像素表示透明。
+ * 合成后的区域通过 draw_bitmap_with_lock() 刷新到屏幕。
+ *
+ * @param disp LVGL显示对象指针
+ * @return true 初始化成功，false 初始化失败
+ *
+ * @note 底层、叠加层和合成缓冲区各占一屏(360x360 RGB565 约253KB)，均分配在外部PSRAM中
+ */
+static bool init_display_compositor(lv_disp_t *disp)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    // LVGL和动画的数据都按屏幕要求交换了字节序，关键色也转换为相同的字节序
+    uint16_t key_color = lv_color_to_u16(lv_color_hex(DISPLAY_COMPOSITOR_KEY_COLOR24));
+    key_color = static_cast<uint16_t>((key_color >> 8) | (key_color << 8));
+
+    Compositor::Config config = {
+        .width = BSP_LCD_H_RES,
+        .height = BSP_LCD_V_RES,
+        .key_color = key_color,
+        .buffer_in_ext = true,
+    };
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        display_compositor.begin(config, [disp](int x_start, int y_start, int x_end, int y_end, const void *data) {
+            return draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, data);
+        }), false, "Failed to begin display compositor"
+    );
+
+    if constexpr (DISPLAY_COMPOSITOR_STATS_INTERVAL_MS > 0) {
+        post_compositor_stats_job();
+    }
+
+    return true;
+}
+#endif
+
 /**
  * @brief 初始化显示系统和绘图逻辑
  * 
@@ -365,6 +616,7 @@ static bool clear_display(lv_disp_t *disp)
  * 
  * 关键概念说明：
  * - 虚拟绘制模式：允许动画直接绘制到屏幕，暂停LVGL的UI渲染
+ * - 合成模式：启用显示合成器时，虚拟绘制模式下LVGL继续绘制系统控件，与动画合成后再刷新到屏幕
  * - 双缓冲技术：使用两个显示缓冲区，避免画面撕裂和闪烁
  * - 信号槽机制：使用观察者模式处理动画事件
  * 
@@ -376,6 +628,8 @@ static bool init_display_and_draw_logic()
 
     // 虚拟绘制模式标志：true=动画直接绘制，false=LVGL正常渲染
     static bool is_lvgl_dummy_draw = true;
+    // 合成模式标志：true=动画和LVGL的输出都交给显示合成器
+    static bool is_compositing = false;
 
     // ==================== BSP 和显示驱动初始化 ====================
     
@@ -406,6 +660,32 @@ static bool init_display_and_draw_logic()
     // 启动显示驱动，返回LVGL显示对象
     auto disp = bsp_display_start_with_config(&cfg);
     ESP_UTILS_CHECK_NULL_RETURN(disp, false, "Failed to start display with configuration");
+
+    // 启动帧率调控器：仅在有内容失效时刷新，并按场景限制帧率(手势60fps，时钟10fps)
+    // 屏幕(QSPI)没有引出TE信号，因此不调用notifyVsync()，刷新不对齐垂直同步
+    bsp_display_lock(0);
+    bool is_governor_begun = LvFrameGovernor::getInstance().begin(disp, LvFrameGovernor::Config{});
+    bsp_display_unlock();
+    ESP_UTILS_CHECK_FALSE_RETURN(is_governor_begun, false, "Failed to begin frame governor");
+
+    // 初始化屏幕填充器，合成模式下填充的区域进入合成器底层，否则直接绘制到屏幕
+    // 屏幕不支持硬件填充，因此不提供填充回调，全部通过行缓冲区刷新
+    PanelFiller::Config filler_config = {
+        .max_width = BSP_LCD_H_RES,
+        .lines = DISPLAY_FILL_LINES,
+        .buffer_in_ext = false,
+        .swap_bytes = true,     // 与动画数据相同，按屏幕要求交换了字节序
+    };
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        panel_filler.begin(filler_config, [disp](int x_start, int y_start, int x_end, int y_end, const void *data) {
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+            if (is_compositing) {
+                return display_compositor.updateBase(x_start, y_start, x_end, y_end, data);
+            }
+#endif
+            return draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, data);
+        }), false, "Failed to begin panel filler"
+    );
     
     // 在非开发者模式下清屏，避免启动时的白屏现象
     if (developer_mode_key != DEVELOPER_MODE_KEY) {
@@ -416,6 +696,13 @@ static bool init_display_and_draw_logic()
     // 打开LCD背光，显示内容变为可见
     bsp_display_backlight_on();
 
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+    // 初始化显示合成器，失败时回退到虚拟绘制模式切换
+    if (DISPLAY_COMPOSITOR_ENABLE && !init_display_compositor(disp)) {
+        ESP_UTILS_LOGE("Failed to initialize display compositor, fall back to dummy draw");
+    }
+#endif
+
     // ==================== 动画播放器事件处理 ====================
     // 这部分是实现AI机器人表情动画的核心机制
     
@@ -429,9 +716,16 @@ static bool init_display_and_draw_logic()
     ) {
         // ESP_UTILS_LOGD("Animation flush: area(%d,%d,%d,%d)", x_start, y_start, x_end, y_end);
 
-        // 只有在虚拟绘制模式下才直接绘制到屏幕
-        // 这样可以避免与LVGL的正常UI渲染产生冲突
-        if (is_lvgl_dummy_draw) {
+        // 合成模式下动画帧进入合成器底层，与LVGL叠加层合成后刷新到屏幕
+        // 否则只有在虚拟绘制模式下才直接绘制到屏幕，这样可以避免与LVGL的正常UI渲染产生冲突
+        if (is_compositing) {
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+            ESP_UTILS_CHECK_FALSE_EXIT(
+                display_compositor.updateBase(x_start, y_start, x_end, y_end, data),
+                "Failed to compose animation frame"
+            );
+#endif
+        } else if (is_lvgl_dummy_draw) {
             ESP_UTILS_CHECK_FALSE_EXIT(
                 draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, data), 
                 "Failed to draw animation frame to screen"
@@ -454,13 +748,21 @@ static bool init_display_and_draw_logic()
     ) {
         // ESP_UTILS_LOGD("Animation stop: clear area(%d,%d,%d,%d)", x_start, y_start, x_end, y_end);
 
-        // 只有在虚拟绘制模式下才需要清除动画区域
-        if (is_lvgl_dummy_draw) {
-            // 创建黑色像素缓冲区，大小为动画区域的像素数据量
-            std::vector<uint8_t> buffer((x_end - x_start) * (y_end - y_start) * 2, 0);
+        // 只有在虚拟绘制模式下才需要清除动画区域，合成模式下只清除底层，叠加层的控件保持不变
+        if (!is_compositing && !is_lvgl_dummy_draw) {
+            return;
+        }
+
+        // 动画的最后一帧已经不在，渐隐时按行逐步清除；填充器使用常驻的行缓冲区，不分配内存
+        if constexpr (ANIMATION_STOP_FADE_STEPS > 1) {
+            ESP_UTILS_CHECK_FALSE_EXIT(
+                panel_filler.fadeOut(
+                    x_start, y_start, x_end, y_end, 0, nullptr, ANIMATION_STOP_FADE_STEPS, ANIMATION_STOP_FADE_STEP_MS
+                ), "Failed to fade out animation area after stop"
+            );
+        } else {
             ESP_UTILS_CHECK_FALSE_EXIT(
-                draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, buffer.data()), 
-                "Failed to clear animation area after stop"
+                panel_filler.fill(x_start, y_start, x_end, y_end, 0), "Failed to clear animation area after stop"
             );
         }
     });
@@ -475,23 +777,54 @@ static bool init_display_and_draw_logic()
      * 
      * 这种机制确保了动画播放和UI显示不会相互干扰，
      * 同时也避免了两个渲染系统同时操作屏幕导致的显示异常。
+     *
+     * 启用显示合成器时，动画模式下LVGL不再被屏蔽，而是把输出交给合成器作为叠加层，
+     * 由合成器与动画合成后刷新到屏幕，因此不需要清屏。
      */
     Display::on_dummy_draw_signal.connect([ = ](bool enable) {
         ESP_UTILS_LOGI("Switching display mode: %s", enable ? "Animation" : "UI");
 
+        bool use_compositor = false;
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+        use_compositor = display_compositor.isBegun();
+#endif
+
         // 获取显示传输信号量，确保模式切换时没有其他绘图操作
         ESP_UTILS_CHECK_ERROR_EXIT(
             lvgl_port_disp_take_trans_sem(disp, portMAX_DELAY), 
             "Failed to acquire display semaphore for mode switch"
         );
         
-        // 切换LVGL的虚拟绘制模式
-        lvgl_port_disp_set_dummy_draw(disp, enable);
+        if (use_compositor) {
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+            // 动画模式下LVGL的输出交给合成器，UI模式下直接刷新到屏幕
+            lvgl_port_disp_set_dummy_draw(disp, false);
+            lvgl_port_disp_set_flush_hook(disp, enable ? compositor_flush_hook : nullptr, &display_compositor);
+#endif
+        } else {
+            // 切换LVGL的虚拟绘制模式
+            lvgl_port_disp_set_dummy_draw(disp, enable);
+        }
         
         // 释放显示传输信号量
         lvgl_port_disp_give_trans_sem(disp, false);
 
-        if (!enable) {
+        if (use_compositor) {
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+            // 进入动画模式时底层从黑屏开始，离开时丢弃未刷新的叠加层区域
+            if (enable) {
+                ESP_UTILS_CHECK_FALSE_EXIT(display_compositor.fillBase(0), "Failed to clear compositor base");
+            } else {
+                display_compositor.discardDirty();
+            }
+#endif
+            is_compositing = enable;
+
+            // 两种模式下LVGL都需要重绘整个屏幕：动画模式下重绘叠加层，UI模式下重绘界面
+            bsp_display_lock(0);
+            lv_obj_invalidate(lv_screen_active());
+            bsp_display_unlock();
+        } else if (!enable) {
             // 恢复UI模式：重新激活LVGL界面渲染
             bsp_display_lock(0);    // 获取显示锁
             lv_obj_invalidate(lv_screen_active());  // 标记当前屏幕需要重绘
@@ -1169,6 +1502,38 @@ static bool load_coze_agent_config()
 
 // }
 
+/**
+ * @brief 等待AI说完后打开应用
+ *
+ * 每次检查都重新投递延时任务，等待期间不占用共享的工作线程
+ *
+ * @param speaker 音箱实例
+ * @param event_data 应用启动事件
+ * @param delay_ms 本次检查前的延时(毫秒)
+ * @param remaining_ms 剩余的最长等待时间(毫秒)
+ */
+static void post_open_app_job(
+    Speaker *speaker, ESP_Brookesia_CoreAppEventData_t event_data, int delay_ms, int remaining_ms
+)
+{
+    Executor::requestInstance().postDelayed([ = ]() {
+        if ((remaining_ms > 0) && AI_Buddy::requestInstance()->isSpeaking()) {
+            post_open_app_job(
+                speaker, event_data, FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS,
+                remaining_ms - FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS
+            );
+            return;
+        }
+
+        speaker->lockLv();
+        speaker->manager.processDisplayScreenChange(
+            ESP_BROOKESIA_SPEAKER_MANAGER_SCREEN_MAIN, nullptr
+        );
+        speaker->sendAppEvent(&event_data);
+        speaker->unlockLv();
+    }, delay_ms, Executor::Priority::Normal, "open_app");
+}
+
 static bool create_speaker_and_install_apps()
 {
     ESP_UTILS_LOG_TRACE_GUARD();
@@ -1199,6 +1564,16 @@ static bool create_speaker_and_install_apps()
 
     ESP_UTILS_CHECK_FALSE_RETURN(speaker->begin(), false, "Begin failed");
 
+#if ESP_BROOKESIA_GUI_ENABLE_COMPOSITOR
+    // 合成模式下，虚拟绘制遮罩以关键色填满屏幕，系统控件绘制在遮罩之上，与动画合成显示
+    if (display_compositor.isBegun()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            speaker->display.setDummyDrawOverlay(true, DISPLAY_COMPOSITOR_KEY_COLOR24), false,
+            "Set dummy draw overlay failed"
+        );
+    }
+#endif
+
     /* 5.Install app settings */
     auto app_settings = Settings::requestInstance();
     ESP_UTILS_CHECK_NULL_RETURN(app_settings, false, "Get app settings failed");
@@ -1355,29 +1730,13 @@ static bool create_speaker_and_install_apps()
                     return;
                 }
 
-                boost::this_thread::sleep_for(boost::chrono::milliseconds(FUNCTION_OPEN_APP_WAIT_SPEAKING_PRE_MS));
-
-                int wait_count = 0;
-                int wait_interval_ms = FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS;
-                int wait_max_count = FUNCTION_OPEN_APP_WAIT_SPEAKING_MAX_MS / wait_interval_ms;
-                while ((wait_count < wait_max_count) && AI_Buddy::requestInstance()->isSpeaking()) {
-                    boost::this_thread::sleep_for(boost::chrono::milliseconds(wait_interval_ms));
-                    wait_count++;
-                }
-
-                speaker->lockLv();
-                speaker->manager.processDisplayScreenChange(
-                    ESP_BROOKESIA_SPEAKER_MANAGER_SCREEN_MAIN, nullptr
+                // 等AI把回复说完再切换界面，等待期间不占用工作线程
+                post_open_app_job(
+                    speaker, event_data, FUNCTION_OPEN_APP_WAIT_SPEAKING_PRE_MS, FUNCTION_OPEN_APP_WAIT_SPEAKING_MAX_MS
                 );
-                speaker->sendAppEvent(&event_data);
-                speaker->unlockLv();
             }
         }
-    }, std::make_optional<FunctionDefinition::CallbackThreadConfig>({
-        .name = FUNCTION_OPEN_APP_THREAD_NAME,
-        .stack_size = FUNCTION_OPEN_APP_THREAD_STACK_SIZE,
-        .stack_in_ext = FUNCTION_OPEN_APP_THREAD_STACK_CAPS_EXT,
-    }));
+    }, true);
     FunctionDefinitionList::requestInstance().addFunction(openApp);
 
     /* 注册AI函数调用 - 音量控制功能 */
@@ -1422,11 +1781,7 @@ static bool create_speaker_and_install_apps()
                 ESP_UTILS_CHECK_FALSE_EXIT(set_media_sound_volume(volume), "Failed to set volume");
             }
         }
-    }, std::make_optional<FunctionDefinition::CallbackThreadConfig>(FunctionDefinition::CallbackThreadConfig{
-        .name = FUNCTION_VOLUME_CHANGE_THREAD_NAME,
-        .stack_size = FUNCTION_VOLUME_CHANGE_THREAD_STACK_SIZE,
-        .stack_in_ext = FUNCTION_VOLUME_CHANGE_THREAD_STACK_CAPS_EXT,
-    }));
+    }, true);
     FunctionDefinitionList::requestInstance().addFunction(setVolume);
 
     /* 注册AI函数调用 - 亮度控制功能 */
@@ -1462,11 +1817,7 @@ static bool create_speaker_and_install_apps()
                 ESP_UTILS_CHECK_FALSE_EXIT(set_media_display_brightness(brightness), "Failed to set brightness");
             }
         }
-    }, std::make_optional<FunctionDefinition::CallbackThreadConfig>(FunctionDefinition::CallbackThreadConfig{
-        .name = FUNCTION_BRIGHTNESS_CHANGE_THREAD_NAME,
-        .stack_size = FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_SIZE,
-        .stack_in_ext = FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT,
-    }));
+    }, true);
     FunctionDefinitionList::requestInstance().addFunction(setBrightness);
 
     // /* Connect the quick settings event signal */
@@ -0,0 +1,303 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file mem_slab.c
+ * @brief 按尺寸分级的slab小块内存分配器实现
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "mem_slab.h"
+
+/* 各级别的块大小，都是8的倍数，保证块的对齐 */
+static const uint16_t class_block_sizes[MEM_SLAB_CLASS_NUM] = {16, 32, 48, 64, 96, 128, 192, 256};
+
+/* 以 (size + 15) / 16 为下标查找级别 */
+static const uint8_t class_lookup[MEM_SLAB_MAX_BLOCK_SIZE / 16 + 1] = {
+    0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7,
+};
+
+static inline uint8_t *page_addr(const mem_slab_t *slab, const mem_slab_page_t *page)
+{
+    return slab->base + (size_t)(page - slab->pages) * MEM_SLAB_PAGE_SIZE;
+}
+
+static inline mem_slab_page_t *page_of(const mem_slab_t *slab, const void *p)
+{
+    return &slab->pages[((uintptr_t)p - (uintptr_t)slab->base) / MEM_SLAB_PAGE_SIZE];
+}
+
+static void partial_push(mem_slab_class_t *cls, mem_slab_page_t *page)
+{
+    page->prev = NULL;
+    page->next = cls->partial;
+    if (cls->partial != NULL) {
+        cls->partial->prev = page;
+    }
+    cls->partial = page;
+}
+
+static void partial_remove(mem_slab_class_t *cls, mem_slab_page_t *page)
+{
+    if (page->prev != NULL) {
+        page->prev->next = page->next;
+    } else {
+        cls->partial = page->next;
+    }
+    if (page->next != NULL) {
+        page->next->prev = page->prev;
+    }
+    page->prev = NULL;
+    page->next = NULL;
+}
+
+bool mem_slab_init(mem_slab_t *slab, void *mem, size_t bytes)
+{
+    memset(slab, 0, sizeof(*slab));
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        slab->classes[i].block_size = class_block_sizes[i];
+        slab->classes[i].block_num = MEM_SLAB_PAGE_SIZE / class_block_sizes[i];
+    }
+    if (mem == NULL) {
+        return false;
+    }
+
+    /* 页描述符在前，页区按MEM_SLAB_ALIGN对齐放在后面 */
+    uintptr_t start = (uintptr_t)mem;
+    uintptr_t end = start + bytes;
+    size_t page_num = bytes / (MEM_SLAB_PAGE_SIZE + sizeof(mem_slab_page_t));
+    while (page_num > 0) {
+        uintptr_t base = start + page_num * sizeof(mem_slab_page_t);
+        base = (base + MEM_SLAB_ALIGN - 1) & ~(uintptr_t)(MEM_SLAB_ALIGN - 1);
+        if (base + page_num * MEM_SLAB_PAGE_SIZE <= end) {
+            slab->base = (uint8_t *)base;
+            break;
+        }
+        page_num--;
+    }
+    if (page_num == 0) {
+        return false;
+    }
+
+    slab->pages = (mem_slab_page_t *)mem;
+    slab->page_num = page_num;
+    slab->free_page_num = page_num;
+    /* 低地址的页先被使用 */
+    for (size_t i = page_num; i-- > 0;) {
+        mem_slab_page_t *page = &slab->pages[i];
+        memset(page, 0, sizeof(*page));
+        page->class_id = MEM_SLAB_CLASS_NUM;
+        page->next = slab->free_pages;
+        slab->free_pages = page;
+    }
+
+    return true;
+}
+
+void *mem_slab_alloc(mem_slab_t *slab, size_t size)
+{
+    if (size > MEM_SLAB_MAX_BLOCK_SIZE) {
+        return NULL;
+    }
+
+    uint8_t class_id = class_lookup[(size + 15) >> 4];
+    mem_slab_class_t *cls = &slab->classes[class_id];
+    mem_slab_page_t *page = cls->partial;
+    if (page == NULL) {
+        page = slab->free_pages;
+        if (page == NULL) {
+            slab->miss_cnt++;
+            return NULL;
+        }
+        slab->free_pages = page->next;
+        slab->free_page_num--;
+        page->free_list = NULL;
+        page->used = 0;
+        page->carved = 0;
+        page->class_id = class_id;
+        partial_push(cls, page);
+        cls->pages++;
+    }
+
+    /* 先复用释放过的块，保持热的缓存行，没有时再切出新块 */
+    void *block = page->free_list;
+    if (block != NULL) {
+        page->free_list = *(void **)block;
+    } else {
+        block = page_addr(slab, page) + (size_t)page->carved * cls->block_size;
+        page->carved++;
+    }
+    page->used++;
+    if (page->used == cls->block_num) {
+        partial_remove(cls, page);
+    }
+
+    cls->used++;
+    cls->alloc_cnt++;
+    cls->req_bytes += size;
+    if (cls->used > cls->peak_used) {
+        cls->peak_used = cls->used;
+    }
+    slab->used_size += cls->block_size;
+    if (slab->used_size > slab->peak_used_size) {
+        slab->peak_used_size = slab->used_size;
+    }
+
+    return block;
+}
+
+void mem_slab_free(mem_slab_t *slab, void *p)
+{
+    assert(mem_slab_owns(slab, p));
+
+    mem_slab_page_t *page = page_of(slab, p);
+    assert(page->class_id < MEM_SLAB_CLASS_NUM);
+    mem_slab_class_t *cls = &slab->classes[page->class_id];
+    assert(((uint8_t *)p - page_addr(slab, page)) % cls->block_size == 0);
+
+    /* 满页重新有了空闲块，放到最前面，下一次分配就用它 */
+    if (page->used == cls->block_num) {
+        partial_push(cls, page);
+    }
+    *(void **)p = page->free_list;
+    page->free_list = p;
+    page->used--;
+
+    cls->used--;
+    cls->free_cnt++;
+    slab->used_size -= cls->block_size;
+
+    /* 空页立即归还页池，块是按需切出的，重新取用一页只需要重置计数 */
+    if (page->used == 0) {
+        partial_remove(cls, page);
+        page->class_id = MEM_SLAB_CLASS_NUM;
+        page->next = slab->free_pages;
+        slab->free_pages = page;
+        slab->free_page_num++;
+        cls->pages--;
+    }
+}
+
+size_t mem_slab_block_size(const mem_slab_t *slab, const void *p)
+{
+    assert(mem_slab_owns(slab, p));
+
+    return slab->classes[page_of(slab, p)->class_id].block_size;
+}
+
+void mem_slab_get_stats(const mem_slab_t *slab, mem_slab_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->page_num = slab->page_num;
+    stats->free_page_num = slab->free_page_num;
+    stats->total_size = (size_t)slab->page_num * MEM_SLAB_PAGE_SIZE;
+    stats->used_size = slab->used_size;
+    stats->peak_used_size = slab->peak_used_size;
+    stats->miss_cnt = slab->miss_cnt;
+
+    size_t stranded_size = 0;
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        const mem_slab_class_t *cls = &slab->classes[i];
+        mem_slab_class_stats_t *class_stats = &stats->classes[i];
+        uint32_t capacity = cls->pages * cls->block_num;
+
+        class_stats->block_size = cls->block_size;
+        class_stats->pages = cls->pages;
+        class_stats->used = cls->used;
+        class_stats->free = (capacity > cls->used) ? (capacity - cls->used) : 0;
+        class_stats->peak_used = cls->peak_used;
+        class_stats->alloc_cnt = cls->alloc_cnt;
+        class_stats->free_cnt = cls->free_cnt;
+        class_stats->frag_pct = (capacity > 0) ? (uint8_t)(class_stats->free * 100 / capacity) : 0;
+        if (cls->alloc_cnt > 0) {
+            uint64_t block_bytes = (uint64_t)cls->alloc_cnt * cls->block_size;
+            class_stats->waste_pct = (uint8_t)((block_bytes - cls->req_bytes) * 100 / block_bytes);
+        }
+
+        stats->used_cnt += cls->used;
+        /* 包括页尾不够一块的部分；不持锁读取时used可能暂时超过容量，按容量计算 */
+        size_t block_used_size = (size_t)(capacity - class_stats->free) * cls->block_size;
+        stranded_size += (size_t)cls->pages * MEM_SLAB_PAGE_SIZE - block_used_size;
+    }
+
+    stats->free_size = (size_t)slab->free_page_num * MEM_SLAB_PAGE_SIZE + stranded_size;
+    if (stats->free_size > 0) {
+        stats->frag_pct = (uint8_t)(stranded_size * 100 / stats->free_size);
+    }
+}
+
+bool mem_slab_check(const mem_slab_t *slab)
+{
+    uint32_t class_used[MEM_SLAB_CLASS_NUM] = {0};
+    uint32_t class_pages[MEM_SLAB_CLASS_NUM] = {0};
+    uint32_t class_partial[MEM_SLAB_CLASS_NUM] = {0};
+    uint32_t free_page_num = 0;
+
+    for (uint32_t i = 0; i < slab->page_num; i++) {
+        const mem_slab_page_t *page = &slab->pages[i];
+        if (page->class_id == MEM_SLAB_CLASS_NUM) {
+            free_page_num++;
+            continue;
+        }
+        if (page->class_id > MEM_SLAB_CLASS_NUM) {
+            return false;
+        }
+
+        const mem_slab_class_t *cls = &slab->classes[page->class_id];
+        const uint8_t *start = page_addr(slab, page);
+        if ((page->carved > cls->block_num) || (page->used > page->carved)) {
+            return false;
+        }
+        /* 空闲块必须在页内已切出的部分、落在块边界上，且数量与计数一致 */
+        uint32_t free_num = 0;
+        for (const void *block = page->free_list; block != NULL; block = *(void *const *)block) {
+            const uint8_t *addr = (const uint8_t *)block;
+            if ((addr < start) || (addr >= start + (size_t)page->carved * cls->block_size) ||
+                    ((addr - start) % cls->block_size != 0) || (++free_num > page->carved)) {
+                return false;
+            }
+        }
+        if (free_num + page->used != page->carved) {
+            return false;
+        }
+        class_used[page->class_id] += page->used;
+        class_pages[page->class_id]++;
+        class_partial[page->class_id] += (page->used < cls->block_num) ? 1 : 0;
+    }
+
+    uint32_t free_list_num = 0;
+    for (const mem_slab_page_t *page = slab->free_pages; page != NULL; page = page->next) {
+        if ((page->class_id != MEM_SLAB_CLASS_NUM) || (++free_list_num > slab->page_num)) {
+            return false;
+        }
+    }
+    if ((free_list_num != free_page_num) || (free_page_num != slab->free_page_num)) {
+        return false;
+    }
+
+    for (int i = 0; i < MEM_SLAB_CLASS_NUM; i++) {
+        const mem_slab_class_t *cls = &slab->classes[i];
+        if ((class_used[i] != cls->used) || (class_pages[i] != cls->pages)) {
+            return false;
+        }
+        /* 本级别未满的页都在未满页链表里，链表里也只有它们 */
+        uint32_t partial_num = 0;
+        const mem_slab_page_t *prev = NULL;
+        for (const mem_slab_page_t *page = cls->partial; page != NULL; page = page->next) {
+            if ((page->class_id != i) || (page->used >= cls->block_num) || (page->prev != prev) ||
+                    (++partial_num > cls->pages)) {
+                return false;
+            }
+            prev = page;
+        }
+        if (partial_num != class_partial[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file mem_slab.h
+ * @brief 按尺寸分级的slab小块内存分配器
+ *
+ * LVGL频繁分配的小对象（样式、事件描述符、绘制任务、动画等）由一块内部RAM提供：
+ * - 内存被切成固定大小的页，每页按需分给一个尺寸级别，再切成等大的块
+ * - 分配和释放都是O(1)的空闲链表操作，页内的链表直接存放在空闲块里，不需要额外的块头
+ * - 完全空闲的页归还到页池，可以被其他尺寸级别复用
+ * - 超过最大级别或页用尽时返回NULL，由调用者退回到其他堆（如PSRAM）
+ *
+ * 本模块不依赖LVGL和ESP-IDF，也不加锁，调用者需要保证串行访问（如持有LVGL锁）。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEM_SLAB_PAGE_SIZE          (4096)  /*!< 页大小（字节） */
+#define MEM_SLAB_ALIGN              (16)    /*!< 页区起始地址的对齐，所有块都按8字节对齐 */
+#define MEM_SLAB_CLASS_NUM          (8)     /*!< 尺寸级别数：16, 32, 48, 64, 96, 128, 192, 256 */
+#define MEM_SLAB_MAX_BLOCK_SIZE     (256)   /*!< 最大级别的块大小，更大的分配不由slab提供 */
+
+/**
+ * @brief 页描述符，与页本身分开存放，页内全部空间都可以切成块
+ */
+typedef struct mem_slab_page_t {
+    struct mem_slab_page_t *prev;   /*!< 所在级别的未满页链表 */
+    struct mem_slab_page_t *next;   /*!< 所在级别的未满页链表，或空闲页链表 */
+    void *free_list;                /*!< 页内已释放的块 */
+    uint16_t used;                  /*!< 使用中的块数 */
+    uint16_t carved;                /*!< 已切出的块数，其余的块还没有用过 */
+    uint8_t class_id;               /*!< 所属级别，空闲页为MEM_SLAB_CLASS_NUM */
+} mem_slab_page_t;
+
+/**
+ * @brief 尺寸级别
+ */
+typedef struct {
+    mem_slab_page_t *partial;       /*!< 还有空闲块的页，分配总是从第一页开始 */
+    uint16_t block_size;            /*!< 块大小（字节） */
+    uint16_t block_num;             /*!< 每页的块数 */
+    uint32_t pages;                 /*!< 占用的页数 */
+    uint32_t used;                  /*!< 使用中的块数 */
+    uint32_t peak_used;             /*!< 使用中块数的峰值 */
+    uint32_t alloc_cnt;             /*!< 累计分配次数 */
+    uint32_t free_cnt;              /*!< 累计释放次数 */
+    uint64_t req_bytes;             /*!< 累计请求的字节数，用于计算块内浪费 */
+} mem_slab_class_t;
+
+/**
+ * @brief slab分配器，内容由mem_slab_init()初始化，不要直接修改
+ */
+typedef struct {
+    uint8_t *base;                  /*!< 第一页的地址 */
+    mem_slab_page_t *pages;         /*!< 页描述符数组 */
+    mem_slab_page_t *free_pages;    /*!< 空闲页链表 */
+    uint32_t page_num;              /*!< 总页数 */
+    uint32_t free_page_num;         /*!< 空闲页数 */
+    uint32_t used_size;             /*!< 使用中块的总大小（字节） */
+    uint32_t peak_used_size;        /*!< 使用中块总大小的峰值（字节） */
+    uint32_t miss_cnt;              /*!< 因为页用尽而没能分配的次数 */
+    mem_slab_class_t classes[MEM_SLAB_CLASS_NUM];
+} mem_slab_t;
+
+/**
+ * @brief 单个尺寸级别的统计
+ */
+typedef struct {
+    uint16_t block_size;            /*!< 块大小（字节） */
+    uint32_t pages;                 /*!< 占用的页数 */
+    uint32_t used;                  /*!< 使用中的块数 */
+    uint32_t free;                  /*!< 已占用页中的空闲块数 */
+    uint32_t peak_used;             /*!< 使用中块数的峰值 */
+    uint32_t alloc_cnt;             /*!< 累计分配次数 */
+    uint32_t free_cnt;              /*!< 累计释放次数 */
+    uint8_t frag_pct;               /*!< 外部碎片：已占用页中空闲块的比例 */
+    uint8_t waste_pct;              /*!< 内部碎片：累计分配中块大小没有被请求用到的比例 */
+} mem_slab_class_stats_t;
+
+/**
+ * @brief 整个分配器的统计
+ */
+typedef struct {
+    size_t total_size;              /*!< 所有页的大小（字节） */
+    size_t free_size;               /*!< 空闲页和已占用页中空闲块的大小（字节） */
+    size_t used_size;               /*!< 使用中块的总大小（字节） */
+    size_t peak_used_size;          /*!< 使用中块总大小的峰值（字节） */
+    uint32_t page_num;              /*!< 总页数 */
+    uint32_t free_page_num;         /*!< 空闲页数 */
+    uint32_t used_cnt;              /*!< 使用中的块数 */
+    uint32_t miss_cnt;              /*!< 因为页用尽而没能分配的次数 */
+    uint8_t frag_pct;               /*!< 空闲内存中被已占用页切碎的比例 */
+    mem_slab_class_stats_t classes[MEM_SLAB_CLASS_NUM];
+} mem_slab_stats_t;
+
+/**
+ * @brief 在给定的内存上初始化分配器，页描述符也放在这块内存的开头
+ *
+ * @param slab 分配器
+ * @param mem 内存起始地址，需要在分配器使用期间一直有效
+ * @param bytes 内存大小（字节）
+ * @return bool 内存不够一页时返回false
+ */
+bool mem_slab_init(mem_slab_t *slab, void *mem, size_t bytes);
+
+/**
+ * @brief 分配一块不小于size的内存，按8字节对齐
+ *
+ * @param slab 分配器
+ * @param size 请求的大小（字节），0按最小级别分配
+ * @return void* 超过MEM_SLAB_MAX_BLOCK_SIZE或页用尽时返回NULL
+ */
+void *mem_slab_alloc(mem_slab_t *slab, size_t size);
+
+/**
+ * @brief 释放mem_slab_alloc()分配的内存
+ *
+ * @param slab 分配器
+ * @param p 内存指针，必须满足mem_slab_owns()
+ */
+void mem_slab_free(mem_slab_t *slab, void *p);
+
+/**
+ * @brief 判断指针是否在分配器的页区内，不需要加锁
+ */
+static inline bool mem_slab_owns(const mem_slab_t *slab, const void *p)
+{
+    return ((uintptr_t)p - (uintptr_t)slab->base) < (uintptr_t)slab->page_num * MEM_SLAB_PAGE_SIZE;
+}
+
+/**
+ * @brief 获取块的实际大小，即其级别的块大小
+ *
+ * @param slab 分配器
+ * @param p 内存指针，必须满足mem_slab_owns()
+ * @return size_t 块大小（字节）
+ */
+size_t mem_slab_block_size(const mem_slab_t *slab, const void *p);
+
+/**
+ * @brief 获取统计，只读取计数，可以在不持有锁时调用（结果可能不完全一致）
+ */
+void mem_slab_get_stats(const mem_slab_t *slab, mem_slab_stats_t *stats);
+
+/**
+ * @brief 检查所有页的空闲链表和计数是否一致，耗时与页数和块数成正比
+ *
+ * @return bool 发现损坏时返回false
+ */
+bool mem_slab_check(const mem_slab_t *slab);
+
+/**
+ * @brief 获取LVGL所用slab的统计，由lv_mem_core_custom.c提供（启用LVGL自定义内存分配时）
+ */
+void lv_mem_slab_get_stats(mem_slab_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,361 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file mem_tag.c
+ * @brief 按子系统标记的堆内存统计实现
+ *
+ * 映射表是线性探测的开放寻址哈希表，条目的键就是指针：
+ * - 插入时用CAS占用第一个空或已删除的条目，写完内容后再发布指针
+ * - 删除时把键改为已删除，而不是空，这样探测链不会断开；插入优先复用已删除的条目，
+ *   表中的条目数保持在带标签的存活分配数的峰值附近
+ * - 探测长度有上限，超过时分配不被记录，查找也不会扫描整张表
+ */
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+#include "esp_private/cache_utils.h"
+#endif
+#include "mem_tag.h"
+
+#define ENTRY_EMPTY         ((uintptr_t)0)
+#define ENTRY_DELETED       ((uintptr_t)1)
+#define ENTRY_BUSY          ((uintptr_t)2)  /* 已被占用，内容还没有写完 */
+#define ENTRY_PROBE_MAX     (32)
+#define TABLE_CAPACITY_MIN  (16)
+
+typedef struct {
+    _Atomic uintptr_t key;
+    _Atomic uint32_t size;
+    _Atomic uint32_t seq;
+    _Atomic mem_tag_t tag;
+} table_entry_t;
+
+typedef struct {
+    _Atomic(const char *) name;
+    _Atomic uint32_t live_bytes;
+    _Atomic uint32_t peak_bytes;
+    _Atomic uint32_t live_cnt;
+    _Atomic uint32_t alloc_cnt;
+    _Atomic uint32_t free_cnt;
+    _Atomic uint32_t alloc_bytes;
+    _Atomic uint32_t untracked_cnt;
+} tag_slot_t;
+
+static tag_slot_t tag_slots[MEM_TAG_MAX];
+static table_entry_t *table = NULL;
+static uint32_t table_mask = 0;
+static atomic_bool is_enabled = false;
+static _Atomic uint32_t alloc_seq = 0;
+/* 所有标签的存活分配数，为0时释放不需要查表 */
+static _Atomic uint32_t live_total = 0;
+
+/* 每个任务的标签栈 */
+static __thread mem_tag_t tag_stack[MEM_TAG_STACK_DEPTH];
+static __thread uint8_t tag_depth = 0;
+
+#define RELAXED memory_order_relaxed
+
+static inline IRAM_ATTR uint32_t table_index(const void *ptr)
+{
+    return (uint32_t)(((uintptr_t)ptr >> 3) * 2654435761u) & table_mask;
+}
+
+static size_t table_capacity(size_t bytes)
+{
+    size_t capacity = TABLE_CAPACITY_MIN;
+    if (bytes < capacity * sizeof(table_entry_t)) {
+        return 0;
+    }
+    while (capacity * 2 * sizeof(table_entry_t) <= bytes) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+size_t mem_tag_get_table_size(size_t capacity)
+{
+    size_t table_size = TABLE_CAPACITY_MIN;
+    while (table_size < capacity) {
+        table_size *= 2;
+    }
+
+    return table_size * sizeof(table_entry_t);
+}
+
+bool mem_tag_init(void *mem, size_t bytes)
+{
+    atomic_store(&is_enabled, false);
+
+    size_t capacity = table_capacity(bytes);
+    if ((mem == NULL) || (capacity == 0)) {
+        return false;
+    }
+    memset(tag_slots, 0, sizeof(tag_slots));
+    memset(mem, 0, capacity * sizeof(table_entry_t));
+    table = (table_entry_t *)mem;
+    table_mask = capacity - 1;
+    atomic_store(&alloc_seq, 0);
+    atomic_store(&live_total, 0);
+    atomic_store(&is_enabled, true);
+
+    return true;
+}
+
+mem_tag_t mem_tag_register(const char *name)
+{
+    for (mem_tag_t tag = MEM_TAG_NONE + 1; tag < MEM_TAG_MAX; tag++) {
+        const char *slot_name = atomic_load(&tag_slots[tag].name);
+        if (slot_name == NULL) {
+            /* 同时注册时只有一个能占用空位，失败的一方拿到对方的名字继续比较 */
+            if (atomic_compare_exchange_strong(&tag_slots[tag].name, &slot_name, name)) {
+                return tag;
+            }
+        }
+        if (strcmp(slot_name, name) == 0) {
+            return tag;
+        }
+    }
+
+    return MEM_TAG_NONE;
+}
+
+void mem_tag_push(mem_tag_t tag)
+{
+    /* 超过深度的嵌套只计数，弹出时配对 */
+    if (tag_depth < MEM_TAG_STACK_DEPTH) {
+        tag_stack[tag_depth] = tag;
+    }
+    if (tag_depth < UINT8_MAX) {
+        tag_depth++;
+    }
+}
+
+void mem_tag_pop(void)
+{
+    if (tag_depth > 0) {
+        tag_depth--;
+    }
+}
+
+IRAM_ATTR mem_tag_t mem_tag_current(void)
+{
+    if (tag_depth == 0) {
+        return MEM_TAG_NONE;
+    }
+
+    return tag_stack[((tag_depth < MEM_TAG_STACK_DEPTH) ? tag_depth : MEM_TAG_STACK_DEPTH) - 1];
+}
+
+IRAM_ATTR void mem_tag_record_alloc(void *ptr, size_t size)
+{
+    if (tag_depth == 0) {
+        return;
+    }
+
+    mem_tag_record_alloc_as(mem_tag_current(), ptr, size);
+}
+
+IRAM_ATTR void mem_tag_record_alloc_as(mem_tag_t tag, void *ptr, size_t size)
+{
+    if ((tag == MEM_TAG_NONE) || (tag >= MEM_TAG_MAX) || (ptr == NULL) || !atomic_load_explicit(&is_enabled, RELAXED)) {
+        return;
+    }
+
+    tag_slot_t *slot = &tag_slots[tag];
+    uint32_t index = table_index(ptr);
+    for (int probe = 0; probe < ENTRY_PROBE_MAX; probe++, index = (index + 1) & table_mask) {
+        table_entry_t *entry = &table[index];
+        uintptr_t key = atomic_load_explicit(&entry->key, RELAXED);
+        if ((key > ENTRY_DELETED) ||
+                !atomic_compare_exchange_strong_explicit(
+                    &entry->key, &key, ENTRY_BUSY, memory_order_acquire, RELAXED
+                )) {
+            continue;
+        }
+
+        uint32_t seq = atomic_fetch_add_explicit(&alloc_seq, 1, RELAXED) + 1;
+        atomic_store_explicit(&entry->size, (uint32_t)size, RELAXED);
+        atomic_store_explicit(&entry->seq, seq, RELAXED);
+        atomic_store_explicit(&entry->tag, tag, RELAXED);
+        atomic_store_explicit(&entry->key, (uintptr_t)ptr, memory_order_release);
+
+        uint32_t live = atomic_fetch_add_explicit(&slot->live_bytes, (uint32_t)size, RELAXED) + (uint32_t)size;
+        uint32_t peak = atomic_load_explicit(&slot->peak_bytes, RELAXED);
+        while ((live > peak) &&
+                !atomic_compare_exchange_weak_explicit(&slot->peak_bytes, &peak, live, RELAXED, RELAXED)) {
+        }
+        atomic_fetch_add_explicit(&slot->live_cnt, 1, RELAXED);
+        atomic_fetch_add_explicit(&slot->alloc_cnt, 1, RELAXED);
+        atomic_fetch_add_explicit(&slot->alloc_bytes, (uint32_t)size, RELAXED);
+        atomic_fetch_add_explicit(&live_total, 1, RELAXED);
+        return;
+    }
+
+    atomic_fetch_add_explicit(&slot->untracked_cnt, 1, RELAXED);
+}
+
+IRAM_ATTR void mem_tag_record_free(void *ptr)
+{
+    if ((ptr == NULL) || (atomic_load_explicit(&live_total, RELAXED) == 0) ||
+            !atomic_load_explicit(&is_enabled, RELAXED)) {
+        return;
+    }
+
+    uint32_t index = table_index(ptr);
+    for (int probe = 0; probe < ENTRY_PROBE_MAX; probe++, index = (index + 1) & table_mask) {
+        table_entry_t *entry = &table[index];
+        uintptr_t key = atomic_load_explicit(&entry->key, memory_order_acquire);
+        if (key == ENTRY_EMPTY) {
+            return;
+        }
+        if (key != (uintptr_t)ptr) {
+            continue;
+        }
+
+        /* 同一个指针不会同时被释放和分配，读取内容后直接删除 */
+        uint32_t size = atomic_load_explicit(&entry->size, RELAXED);
+        tag_slot_t *slot = &tag_slots[atomic_load_explicit(&entry->tag, RELAXED)];
+        atomic_store_explicit(&entry->key, ENTRY_DELETED, memory_order_release);
+
+        atomic_fetch_sub_explicit(&slot->live_bytes, size, RELAXED);
+        atomic_fetch_sub_explicit(&slot->live_cnt, 1, RELAXED);
+        atomic_fetch_add_explicit(&slot->free_cnt, 1, RELAXED);
+        atomic_fetch_sub_explicit(&live_total, 1, RELAXED);
+        return;
+    }
+}
+
+void mem_tag_take_snapshot(mem_tag_snapshot_t *snapshot, int64_t time_us)
+{
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->time_us = time_us;
+    snapshot->seq = atomic_load(&alloc_seq);
+    for (int i = 0; i < MEM_TAG_MAX; i++) {
+        tag_slot_t *slot = &tag_slots[i];
+        mem_tag_stats_t *stats = &snapshot->tags[i];
+        stats->name = atomic_load_explicit(&slot->name, RELAXED);
+        stats->live_bytes = atomic_load_explicit(&slot->live_bytes, RELAXED);
+        stats->peak_bytes = atomic_load_explicit(&slot->peak_bytes, RELAXED);
+        stats->live_cnt = atomic_load_explicit(&slot->live_cnt, RELAXED);
+        stats->alloc_cnt = atomic_load_explicit(&slot->alloc_cnt, RELAXED);
+        stats->free_cnt = atomic_load_explicit(&slot->free_cnt, RELAXED);
+        stats->alloc_bytes = atomic_load_explicit(&slot->alloc_bytes, RELAXED);
+        stats->untracked_cnt = atomic_load_explicit(&slot->untracked_cnt, RELAXED);
+    }
+}
+
+static size_t dump_append(char *buf, size_t size, size_t len, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int ret = vsnprintf((len < size) ? (buf + len) : NULL, (len < size) ? (size - len) : 0, format, args);
+    va_end(args);
+
+    return (ret > 0) ? (size_t)ret : 0;
+}
+
+size_t mem_tag_dump(char *buf, size_t size, const mem_tag_snapshot_t *snapshot, const mem_tag_snapshot_t *previous)
+{
+    size_t len = 0;
+    if (size > 0) {
+        buf[0] = '\0';
+    }
+
+    int64_t period_us = (previous != NULL) ? (snapshot->time_us - previous->time_us) : 0;
+    for (int i = MEM_TAG_NONE + 1; i < MEM_TAG_MAX; i++) {
+        const mem_tag_stats_t *stats = &snapshot->tags[i];
+        if ((stats->name == NULL) || (stats->alloc_cnt == 0)) {
+            continue;
+        }
+
+        len += dump_append(
+                   buf, size, len, "%-10s live %7u B %5u blk, peak %7u B", stats->name, (unsigned)stats->live_bytes,
+                   (unsigned)stats->live_cnt, (unsigned)stats->peak_bytes
+               );
+        if (period_us > 0) {
+            const mem_tag_stats_t *before = &previous->tags[i];
+            uint32_t alloc_cnt = stats->alloc_cnt - before->alloc_cnt;
+            uint32_t alloc_bytes = stats->alloc_bytes - before->alloc_bytes;
+            len += dump_append(
+                       buf, size, len, ", %+7d B, %5u alloc/s %7u B/s", (int)(stats->live_bytes - before->live_bytes),
+                       (unsigned)((uint64_t)alloc_cnt * 1000000 / period_us),
+                       (unsigned)((uint64_t)alloc_bytes * 1000000 / period_us)
+                   );
+        }
+        if (stats->untracked_cnt > 0) {
+            len += dump_append(buf, size, len, ", %u untracked", (unsigned)stats->untracked_cnt);
+        }
+        len += dump_append(buf, size, len, "\n");
+    }
+
+    return len;
+}
+
+uint32_t mem_tag_find_leaks(
+    const mem_tag_snapshot_t *since, const mem_tag_snapshot_t *until, mem_tag_leak_cb_t cb, void *user_data
+)
+{
+    if ((table == NULL) || !atomic_load(&is_enabled)) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    uint32_t span = until->seq - since->seq;
+    for (uint32_t i = 0; i <= table_mask; i++) {
+        table_entry_t *entry = &table[i];
+        uintptr_t key = atomic_load_explicit(&entry->key, memory_order_acquire);
+        if (key <= ENTRY_BUSY) {
+            continue;
+        }
+        uint32_t seq = atomic_load_explicit(&entry->seq, RELAXED);
+        uint32_t size = atomic_load_explicit(&entry->size, RELAXED);
+        mem_tag_t tag = atomic_load_explicit(&entry->tag, RELAXED);
+        /* 读取期间条目被释放或复用时跳过 */
+        if (atomic_load_explicit(&entry->key, memory_order_acquire) != key) {
+            continue;
+        }
+        /* 序号回绕后差值仍然正确 */
+        if ((uint32_t)(seq - since->seq - 1) >= span) {
+            continue;
+        }
+        count++;
+        if (cb != NULL) {
+            cb((void *)key, size, tag, user_data);
+        }
+    }
+
+    return count;
+}
+
+#if CONFIG_EXAMPLE_MEM_TAG_ENABLE
+/*
+ * ESP-IDF的堆钩子，所有heap_caps_*()、malloc()和free()都会调用，包括flash cache关闭的时候，
+ * 所以钩子和它们调用的记录函数都放在IRAM中。cache关闭时PSRAM中的映射表也不能访问，这时的分配和释放不被记录
+ */
+IRAM_ATTR void esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps)
+{
+    (void)caps;
+    if (!spi_flash_cache_enabled()) {
+        return;
+    }
+    mem_tag_record_alloc(ptr, size);
+}
+
+IRAM_ATTR void esp_heap_trace_free_hook(void *ptr)
+{
+    if (!spi_flash_cache_enabled()) {
+        return;
+    }
+    mem_tag_record_free(ptr);
+}
+#endif
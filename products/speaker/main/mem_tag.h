@@ -0,0 +1,183 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file mem_tag.h
+ * @brief 按子系统标记的堆内存统计
+ *
+ * 用于定位长时间运行后内存增长的来源（如AI对话、音频缓冲、LVGL对象、cJSON解析、线程栈）：
+ * - 每个任务有自己的标签栈，用mem_tag_push()/mem_tag_pop()（C++中用MemTagScope）标记一段代码，
+ *   这段代码中的分配都记到栈顶的标签下
+ * - 分配通过ESP-IDF的堆钩子（CONFIG_HEAP_USE_HOOKS）、LVGL的内存分配函数和cJSON的钩子记录，
+ *   指针到标签的映射存放在无锁的开放寻址表中，释放时不需要知道分配时的标签
+ * - 每个标签统计存活字节数、峰值、分配次数和字节数，快照之间的差值给出分配速率
+ * - 两个快照之间分配且仍然存活的内存可以逐个列出，用于查找泄漏
+ *
+ * 没有标签的分配不记录，记录和统计都不加锁，可以在任意任务中调用，但不能在中断中调用。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEM_TAG_NONE            (0)     /*!< 无标签，分配不被记录 */
+#define MEM_TAG_MAX             (16)    /*!< 标签数上限，包括MEM_TAG_NONE */
+#define MEM_TAG_STACK_DEPTH     (8)     /*!< 每个任务的标签栈深度，更深的嵌套沿用栈顶标签 */
+
+typedef uint8_t mem_tag_t;
+
+/**
+ * @brief 单个标签的统计，计数都是32位的，累计值回绕后差值仍然正确
+ */
+typedef struct {
+    const char *name;               /*!< 标签名，未注册的标签为NULL */
+    uint32_t live_bytes;            /*!< 存活的字节数 */
+    uint32_t peak_bytes;            /*!< 存活字节数的峰值 */
+    uint32_t live_cnt;              /*!< 存活的分配数 */
+    uint32_t alloc_cnt;             /*!< 累计分配次数 */
+    uint32_t free_cnt;              /*!< 累计释放次数 */
+    uint32_t alloc_bytes;           /*!< 累计分配的字节数 */
+    uint32_t untracked_cnt;         /*!< 因为映射表太满而没有记录的分配次数 */
+} mem_tag_stats_t;
+
+/**
+ * @brief 所有标签的快照
+ */
+typedef struct {
+    int64_t time_us;                /*!< 快照时间（微秒） */
+    uint32_t seq;                   /*!< 快照时最后一次记录的分配序号 */
+    mem_tag_stats_t tags[MEM_TAG_MAX];
+} mem_tag_snapshot_t;
+
+/**
+ * @brief 泄漏查找的回调
+ *
+ * @param ptr 分配的指针
+ * @param size 分配的大小（字节）
+ * @param tag 分配时的标签
+ * @param user_data 用户数据
+ */
+typedef void (*mem_tag_leak_cb_t)(void *ptr, size_t size, mem_tag_t tag, void *user_data);
+
+/**
+ * @brief 获取映射表的内存大小
+ *
+ * @param capacity 映射表的条目数，向上取为2的幂，建议为带标签的存活分配数峰值的两倍
+ * @return size_t 内存大小（字节）
+ */
+size_t mem_tag_get_table_size(size_t capacity);
+
+/**
+ * @brief 在给定的内存上初始化映射表，清空所有标签和统计后开始记录
+ *
+ * 需要在其他任务开始记录之前调用，内存需要一直有效。
+ *
+ * @param mem 映射表的内存
+ * @param bytes 内存大小（字节），容纳不下的部分不使用
+ * @return bool 内存不够时返回false
+ */
+bool mem_tag_init(void *mem, size_t bytes);
+
+/**
+ * @brief 注册标签，同名的标签返回同一个值
+ *
+ * @param name 标签名，需要一直有效（如字符串常量）
+ * @return mem_tag_t 标签，标签数达到上限时返回MEM_TAG_NONE
+ */
+mem_tag_t mem_tag_register(const char *name);
+
+/**
+ * @brief 把标签压入当前任务的标签栈，压入MEM_TAG_NONE可以暂时不记录
+ */
+void mem_tag_push(mem_tag_t tag);
+
+/**
+ * @brief 弹出当前任务的标签栈
+ */
+void mem_tag_pop(void);
+
+/**
+ * @brief 获取当前任务的标签栈顶
+ */
+mem_tag_t mem_tag_current(void);
+
+/**
+ * @brief 按当前任务的标签记录一次分配，没有标签时不记录
+ */
+void mem_tag_record_alloc(void *ptr, size_t size);
+
+/**
+ * @brief 按指定的标签记录一次分配，用于自己知道归属的分配器（如LVGL）
+ */
+void mem_tag_record_alloc_as(mem_tag_t tag, void *ptr, size_t size);
+
+/**
+ * @brief 记录一次释放，没有被记录过的指针直接忽略
+ */
+void mem_tag_record_free(void *ptr);
+
+/**
+ * @brief 获取所有标签的快照
+ *
+ * @param snapshot 快照
+ * @param time_us 当前时间（微秒），用于计算分配速率
+ */
+void mem_tag_take_snapshot(mem_tag_snapshot_t *snapshot, int64_t time_us);
+
+/**
+ * @brief 输出紧凑的统计，每个有分配的标签一行
+ *
+ * 给出上一个快照时，同时输出存活字节数的变化和两个快照之间的分配速率。
+ *
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小，输出不下时截断
+ * @param snapshot 快照
+ * @param previous 上一个快照，可以为NULL
+ * @return size_t 完整输出需要的长度，不包括结尾的'\0'
+ */
+size_t mem_tag_dump(char *buf, size_t size, const mem_tag_snapshot_t *snapshot, const mem_tag_snapshot_t *previous);
+
+/**
+ * @brief 列出在两个快照之间分配、现在仍然存活的内存
+ *
+ * 在稳定状态下前后各取一个快照（如一次对话前后），列出的分配就是可能的泄漏。
+ *
+ * @param since 较早的快照
+ * @param until 较晚的快照
+ * @param cb 每个分配的回调，可以为NULL
+ * @param user_data 回调的用户数据
+ * @return uint32_t 分配的个数
+ */
+uint32_t mem_tag_find_leaks(
+    const mem_tag_snapshot_t *since, const mem_tag_snapshot_t *until, mem_tag_leak_cb_t cb, void *user_data
+);
+
+#ifdef __cplusplus
+}
+
+/**
+ * @brief 在作用域内把标签压入当前任务的标签栈
+ */
+class MemTagScope {
+public:
+    explicit MemTagScope(mem_tag_t tag)
+    {
+        mem_tag_push(tag);
+    }
+    ~MemTagScope()
+    {
+        mem_tag_pop();
+    }
+    MemTagScope(const MemTagScope &) = delete;
+    MemTagScope &operator=(const MemTagScope &) = delete;
+};
+#endif
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port transform
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Rotation of the buffer, the values are the same as the ones of `lv_display_rotation_t`
+ */
+typedef enum {
+    LVGL_PORT_ROTATE_0 = 0,
+    LVGL_PORT_ROTATE_90,
+    LVGL_PORT_ROTATE_180,
+    LVGL_PORT_ROTATE_270,
+} lvgl_port_rotate_t;
+
+/**
+ * @brief Sampling used when scaling a buffer
+ */
+typedef enum {
+    LVGL_PORT_SCALE_NEAREST = 0,    /*!< Take the closest source pixel, fastest */
+    LVGL_PORT_SCALE_BILINEAR,       /*!< Blend the 4 closest source pixels, smoother */
+} lvgl_port_scale_mode_t;
+
+/**
+ * @brief Rotate an RGB565 buffer
+ *
+ * The source pixel (x, y) lands at:
+ *  - 90:  row `src_w - 1 - x`, column `y`
+ *  - 180: row `src_h - 1 - y`, column `src_w - 1 - x`
+ *  - 270: row `x`, column `src_h - 1 - y`
+ * which matches the area moved by `lvgl_port_rotate_area()`.
+ *
+ * The buffer is processed in small tiles, so the rows of the source and of the destination being written stay in the
+ * cache. On ESP32-S3, the tiles are transposed 8x8 pixels at a time with the PIE instructions when the buffers are
+ * aligned to 16 bytes, and their strides are multiples of 16 bytes.
+ *
+ * @note The source and destination buffers must not overlap
+ *
+ * @param src        Source buffer
+ * @param dst        Destination buffer
+ * @param src_w      Source width in pixels
+ * @param src_h      Source height in pixels
+ * @param src_stride Source stride in bytes
+ * @param dst_stride Destination stride in bytes
+ * @param rotation   Rotation to apply, the buffer is copied as it is for `LVGL_PORT_ROTATE_0`
+ */
+void lvgl_port_rotate_rgb565(const uint16_t *src, uint16_t *dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                             int32_t dst_stride, lvgl_port_rotate_t rotation);
+
+/**
+ * @brief Rotate an RGB888 buffer, see `lvgl_port_rotate_rgb565()`
+ *
+ * @note There is no PIE version, the tiles are always rotated by the CPU
+ */
+void lvgl_port_rotate_rgb888(const uint8_t *src, uint8_t *dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                             int32_t dst_stride, lvgl_port_rotate_t rotation);
+
+/**
+ * @brief Downscale an RGB565 buffer, e.g. to make a thumbnail of a snapshot
+ *
+ * The destination pixel (x, y) samples the source at (`x * src_w / dst_w`, `y * src_h / dst_h`). The nearest mode takes
+ * that pixel, the bilinear mode blends it with its right and bottom neighbours, using 8-bit weights.
+ *
+ * @note The colors must be in the native byte order, i.e. before `lv_draw_sw_rgb565_swap()`
+ *
+ * @param src        Source buffer
+ * @param src_w      Source width in pixels
+ * @param src_h      Source height in pixels
+ * @param src_stride Source stride in bytes
+ * @param dst        Destination buffer
+ * @param dst_w      Destination width in pixels, not larger than `src_w`
+ * @param dst_h      Destination height in pixels, not larger than `src_h`
+ * @param dst_stride Destination stride in bytes
+ * @param mode       Sampling mode
+ */
+void lvgl_port_scale_rgb565(const uint16_t *src, int32_t src_w, int32_t src_h, int32_t src_stride, uint16_t *dst,
+                            int32_t dst_w, int32_t dst_h, int32_t dst_stride, lvgl_port_scale_mode_t mode);
+
+/**
+ * @brief Downscale an RGB888 buffer, see `lvgl_port_scale_rgb565()`
+ */
+void lvgl_port_scale_rgb888(const uint8_t *src, int32_t src_w, int32_t src_h, int32_t src_stride, uint8_t *dst,
+                            int32_t dst_w, int32_t dst_h, int32_t dst_stride, lvgl_port_scale_mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
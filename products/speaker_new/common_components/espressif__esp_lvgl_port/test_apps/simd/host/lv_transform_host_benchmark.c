@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host check of the portable rotation kernels: bit-exactness against the plain per-pixel rotation on a display sized
+ * buffer, then the time of both. See the README for the build command.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../main/lv_transform_common.h"
+
+#define WIDTH 800
+#define HEIGHT 480
+#define BENCHMARK_CYCLES 50
+
+static const char *rotation_names[] = {"0", "90", "180", "270"};
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void rotate_dut(int px_size, const uint8_t *src, uint8_t *dst, int32_t src_stride, int32_t dst_stride,
+                       lvgl_port_rotate_t rotation)
+{
+    if (px_size == 2) {
+        lvgl_port_rotate_rgb565((const uint16_t *)src, (uint16_t *)dst, WIDTH, HEIGHT, src_stride, dst_stride,
+                                rotation);
+    } else {
+        lvgl_port_rotate_rgb888(src, dst, WIDTH, HEIGHT, src_stride, dst_stride, rotation);
+    }
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    for (int px_size = 2; px_size <= 3; px_size++) {
+        size_t len = (size_t)WIDTH * HEIGHT * px_size;
+        uint8_t *src = malloc(len);
+        uint8_t *dst = malloc(len);
+        uint8_t *ref = malloc(len);
+        if (!src || !dst || !ref) {
+            printf("Lack of memory\n");
+            return 1;
+        }
+        for (size_t i = 0; i < len; i++) {
+            src[i] = (uint8_t)((i * 7) ^ (i >> 8));
+        }
+
+        for (int r = LVGL_PORT_ROTATE_90; r <= LVGL_PORT_ROTATE_270; r++) {
+            lvgl_port_rotate_t rotation = (lvgl_port_rotate_t)r;
+            int32_t src_stride = WIDTH * px_size;
+            int32_t dst_stride = (rotation == LVGL_PORT_ROTATE_180) ? WIDTH * px_size : HEIGHT * px_size;
+
+            memset(dst, 0, len);
+            memset(ref, 0, len);
+            rotate_dut(px_size, src, dst, src_stride, dst_stride, rotation);
+            lv_transform_rotate_ref(src, ref, WIDTH, HEIGHT, src_stride, dst_stride, rotation, px_size);
+            bool is_exact = (memcmp(dst, ref, len) == 0);
+            failures += is_exact ? 0 : 1;
+
+            double start = now_us();
+            for (int i = 0; i < BENCHMARK_CYCLES; i++) {
+                rotate_dut(px_size, src, dst, src_stride, dst_stride, rotation);
+            }
+            double tiled_us = (now_us() - start) / BENCHMARK_CYCLES;
+            start = now_us();
+            for (int i = 0; i < BENCHMARK_CYCLES; i++) {
+                lv_transform_rotate_ref(src, ref, WIDTH, HEIGHT, src_stride, dst_stride, rotation, px_size);
+            }
+            double plain_us = (now_us() - start) / BENCHMARK_CYCLES;
+
+            printf("RGB%s %dx%d rotate %-3s: %s, tiled %8.1f us, plain %8.1f us, x%.2f\n",
+                   (px_size == 2) ? "565" : "888", WIDTH, HEIGHT, rotation_names[r], is_exact ? "exact" : "MISMATCH",
+                   tiled_us, plain_us, plain_us / tiled_us);
+        }
+
+        free(src);
+        free(dst);
+        free(ref);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_lvgl_port_transform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Reference functions -----------------------------------------------
+
+/**
+ * @brief Plain per-pixel rotation, the reference for `lvgl_port_rotate_rgb565()` and `lvgl_port_rotate_rgb888()`
+ *
+ * @param[in] src Source buffer
+ * @param[out] dst Destination buffer
+ * @param[in] px_size Pixel size in bytes (2 for RGB565, 3 for RGB888)
+ */
+static inline void lv_transform_rotate_ref(const uint8_t *src, uint8_t *dst, int32_t src_w, int32_t src_h,
+        int32_t src_stride, int32_t dst_stride, lvgl_port_rotate_t rotation, int px_size)
+{
+    for (int32_t y = 0; y < src_h; y++) {
+        for (int32_t x = 0; x < src_w; x++) {
+            int32_t row = y;
+            int32_t col = x;
+            switch (rotation) {
+            case LVGL_PORT_ROTATE_90:
+                row = src_w - 1 - x;
+                col = y;
+                break;
+            case LVGL_PORT_ROTATE_180:
+                row = src_h - 1 - y;
+                col = src_w - 1 - x;
+                break;
+            case LVGL_PORT_ROTATE_270:
+                row = x;
+                col = src_h - 1 - y;
+                break;
+            default:
+                break;
+            }
+            const uint8_t *s = src + y * src_stride + x * px_size;
+            uint8_t *d = dst + row * dst_stride + col * px_size;
+            for (int i = 0; i < px_size; i++) {
+                d[i] = s[i];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Bilinear blend of one channel, with the weights out of 256 of the right and bottom pixels
+ */
+static inline uint32_t lv_transform_blend_ref(uint32_t c00, uint32_t c01, uint32_t c10, uint32_t c11, uint32_t fx,
+        uint32_t fy)
+{
+    return ((c00 * (256 - fx) + c01 * fx) * (256 - fy) + (c10 * (256 - fx) + c11 * fx) * fy + 32768) >> 16;
+}
+
+/**
+ * @brief Per-pixel downscale with a division for every sample, the reference for `lvgl_port_scale_rgb565()`
+ */
+static inline void lv_transform_scale_rgb565_ref(const uint16_t *src, int32_t src_w, int32_t src_h,
+        int32_t src_stride, uint16_t *dst, int32_t dst_w, int32_t dst_h, int32_t dst_stride,
+        lvgl_port_scale_mode_t mode)
+{
+    for (int32_t y = 0; y < dst_h; y++) {
+        uint16_t *d = (uint16_t *)((uint8_t *)dst + y * dst_stride);
+        for (int32_t x = 0; x < dst_w; x++) {
+            if (mode == LVGL_PORT_SCALE_NEAREST) {
+                d[x] = *(const uint16_t *)((const uint8_t *)src + (y * src_h / dst_h) * src_stride +
+                                           (x * src_w / dst_w) * 2);
+                continue;
+            }
+            int32_t py = y * src_h * 256 / dst_h;
+            int32_t px = x * src_w * 256 / dst_w;
+            int32_t y0 = py >> 8;
+            int32_t x0 = px >> 8;
+            int32_t y1 = (y0 + 1 < src_h) ? y0 + 1 : src_h - 1;
+            int32_t x1 = (x0 + 1 < src_w) ? x0 + 1 : src_w - 1;
+            const uint16_t *s0 = (const uint16_t *)((const uint8_t *)src + y0 * src_stride);
+            const uint16_t *s1 = (const uint16_t *)((const uint8_t *)src + y1 * src_stride);
+            uint32_t r = lv_transform_blend_ref(s0[x0] >> 11, s0[x1] >> 11, s1[x0] >> 11, s1[x1] >> 11, px & 0xff,
+                                                py & 0xff);
+            uint32_t g = lv_transform_blend_ref((s0[x0] >> 5) & 0x3f, (s0[x1] >> 5) & 0x3f, (s1[x0] >> 5) & 0x3f,
+                                                (s1[x1] >> 5) & 0x3f, px & 0xff, py & 0xff);
+            uint32_t b = lv_transform_blend_ref(s0[x0] & 0x1f, s0[x1] & 0x1f, s1[x0] & 0x1f, s1[x1] & 0x1f,
+                                                px & 0xff, py & 0xff);
+            d[x] = (uint16_t)((r << 11) | (g << 5) | b);
+        }
+    }
+}
+
+/**
+ * @brief Per-pixel downscale with a division for every sample, the reference for `lvgl_port_scale_rgb888()`
+ */
+static inline void lv_transform_scale_rgb888_ref(const uint8_t *src, int32_t src_w, int32_t src_h,
+        int32_t src_stride, uint8_t *dst, int32_t dst_w, int32_t dst_h, int32_t dst_stride,
+        lvgl_port_scale_mode_t mode)
+{
+    for (int32_t y = 0; y < dst_h; y++) {
+        uint8_t *d = dst + y * dst_stride;
+        for (int32_t x = 0; x < dst_w; x++, d += 3) {
+            if (mode == LVGL_PORT_SCALE_NEAREST) {
+                const uint8_t *s = src + (y * src_h / dst_h) * src_stride + (x * src_w / dst_w) * 3;
+                d[0] = s[0];
+                d[1] = s[1];
+                d[2] = s[2];
+                continue;
+            }
+            int32_t py = y * src_h * 256 / dst_h;
+            int32_t px = x * src_w * 256 / dst_w;
+            int32_t y0 = py >> 8;
+            int32_t x0 = px >> 8;
+            int32_t y1 = (y0 + 1 < src_h) ? y0 + 1 : src_h - 1;
+            int32_t x1 = (x0 + 1 < src_w) ? x0 + 1 : src_w - 1;
+            const uint8_t *s0 = src + y0 * src_stride;
+            const uint8_t *s1 = src + y1 * src_stride;
+            for (int i = 0; i < 3; i++) {
+                d[i] = (uint8_t)lv_transform_blend_ref(s0[x0 * 3 + i], s0[x1 * 3 + i], s1[x0 * 3 + i],
+                                                       s1[x1 * 3 + i], px & 0xff, py & 0xff);
+            }
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
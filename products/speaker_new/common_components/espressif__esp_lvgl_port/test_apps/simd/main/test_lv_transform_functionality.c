@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_transform_common.h"
+
+// ------------------------------------------------- Defines -----------------------------------------------------------
+
+#define CANARY_BYTES 16        // Bytes around the destination, that the DUT must not touch
+#define CANARY_VALUE 0xA5
+#define STRIDE_ALIGN 16        // Alignment of the strides, so the PIE version is used on esp32s3
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_TRANSFORM_FUNC = "LV Transform Functionality";
+static char test_msg_buf[200];
+
+// Widths and heights around the 8x8 PIE blocks and the 16x16 tiles
+static const int32_t test_sizes[] = {1, 7, 8, 9, 16, 17, 31, 40};
+static const char *rotation_names[] = {"0", "90", "180", "270"};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Rotate a test matrix by the DUT and by the reference, and compare both destinations
+ *
+ * @param[in] px_size Pixel size in bytes (2 for RGB565, 3 for RGB888)
+ * @param[in] src_unalign_byte Offset of the source buffer from the 16-byte boundary
+ * @param[in] pad_px Padding of the rows in pixels, on top of the 16-byte stride alignment
+ */
+static void lv_transform_rotate_test(int px_size, int32_t w, int32_t h, lvgl_port_rotate_t rotation,
+                                     int src_unalign_byte, int pad_px);
+
+/**
+ * @brief Scale a test matrix by the DUT and by the reference, and compare both destinations
+ */
+static void lv_transform_scale_test(int px_size, int32_t src_w, int32_t src_h, int32_t dst_w, int32_t dst_h,
+                                    lvgl_port_scale_mode_t mode);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Functionality tests
+
+Purpose:
+    - Test that the tiled (and PIE on esp32s3) rotation gives exactly the same result as a plain per-pixel rotation
+    - Test that the stepped downscale gives exactly the same result as a downscale dividing for every sample
+
+Procedure:
+    - Fill the source matrix with a pattern, different for every pixel
+    - Fill both destination matrices, including the canary bytes around them, with the canary value
+    - Run the reference and the DUT
+    - Compare the whole destination buffers, so the canary bytes and the padding are checked as well
+    - Repeat for the sizes around the PIE blocks and the tiles, aligned and unaligned buffers, padded strides
+*/
+
+TEST_CASE("LV Transform functionality RGB565 rotate", "[transform][functionality][RGB565]")
+{
+    for (int r = LVGL_PORT_ROTATE_0; r <= LVGL_PORT_ROTATE_270; r++) {
+        for (int i = 0; i < sizeof(test_sizes) / sizeof(test_sizes[0]); i++) {
+            for (int j = 0; j < sizeof(test_sizes) / sizeof(test_sizes[0]); j++) {
+                lv_transform_rotate_test(2, test_sizes[i], test_sizes[j], (lvgl_port_rotate_t)r, 0, 0);
+                lv_transform_rotate_test(2, test_sizes[i], test_sizes[j], (lvgl_port_rotate_t)r, 2, 3);
+            }
+        }
+    }
+}
+
+TEST_CASE("LV Transform functionality RGB888 rotate", "[transform][functionality][RGB888]")
+{
+    for (int r = LVGL_PORT_ROTATE_0; r <= LVGL_PORT_ROTATE_270; r++) {
+        for (int i = 0; i < sizeof(test_sizes) / sizeof(test_sizes[0]); i++) {
+            for (int j = 0; j < sizeof(test_sizes) / sizeof(test_sizes[0]); j++) {
+                lv_transform_rotate_test(3, test_sizes[i], test_sizes[j], (lvgl_port_rotate_t)r, 0, 0);
+                lv_transform_rotate_test(3, test_sizes[i], test_sizes[j], (lvgl_port_rotate_t)r, 1, 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("LV Transform functionality scale", "[transform][functionality]")
+{
+    for (int px_size = 2; px_size <= 3; px_size++) {
+        for (int mode = LVGL_PORT_SCALE_NEAREST; mode <= LVGL_PORT_SCALE_BILINEAR; mode++) {
+            lv_transform_scale_test(px_size, 64, 48, 64, 48, (lvgl_port_scale_mode_t)mode);
+            lv_transform_scale_test(px_size, 64, 48, 32, 24, (lvgl_port_scale_mode_t)mode);
+            lv_transform_scale_test(px_size, 64, 48, 21, 13, (lvgl_port_scale_mode_t)mode);
+            lv_transform_scale_test(px_size, 97, 61, 40, 30, (lvgl_port_scale_mode_t)mode);
+            lv_transform_scale_test(px_size, 97, 61, 1, 1, (lvgl_port_scale_mode_t)mode);
+        }
+    }
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void fill_pattern(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)((i * 7) ^ (i >> 8));
+    }
+}
+
+static void lv_transform_rotate_test(int px_size, int32_t w, int32_t h, lvgl_port_rotate_t rotation,
+                                     int src_unalign_byte, int pad_px)
+{
+    bool is_swapped = (rotation == LVGL_PORT_ROTATE_90) || (rotation == LVGL_PORT_ROTATE_270);
+    int32_t dst_w = is_swapped ? h : w;
+    int32_t dst_h = is_swapped ? w : h;
+    int32_t src_stride = ((w * px_size + STRIDE_ALIGN - 1) / STRIDE_ALIGN) * STRIDE_ALIGN + pad_px * px_size;
+    int32_t dst_stride = ((dst_w * px_size + STRIDE_ALIGN - 1) / STRIDE_ALIGN) * STRIDE_ALIGN + pad_px * px_size;
+    size_t src_len = h * src_stride;
+    size_t dst_len = dst_h * dst_stride + CANARY_BYTES * 2;
+
+    uint8_t *src_align16 = (uint8_t *)memalign(16, src_len + STRIDE_ALIGN);
+    uint8_t *dst_align16 = (uint8_t *)memalign(16, dst_len);
+    uint8_t *ref_buf = (uint8_t *)malloc(dst_len);
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, src_align16, "Lack of memory");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, dst_align16, "Lack of memory");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, ref_buf, "Lack of memory");
+
+    uint8_t *src = src_align16 + src_unalign_byte;
+    fill_pattern(src, src_len);
+    memset(dst_align16, CANARY_VALUE, dst_len);
+    memset(ref_buf, CANARY_VALUE, dst_len);
+
+    // The destination starts after the leading canary bytes, keeping its 16-byte alignment
+    lv_transform_rotate_ref(src, ref_buf + CANARY_BYTES, w, h, src_stride, dst_stride, rotation, px_size);
+    if (px_size == 2) {
+        lvgl_port_rotate_rgb565((const uint16_t *)src, (uint16_t *)(dst_align16 + CANARY_BYTES), w, h, src_stride,
+                                dst_stride, rotation);
+    } else {
+        lvgl_port_rotate_rgb888(src, dst_align16 + CANARY_BYTES, w, h, src_stride, dst_stride, rotation);
+    }
+
+    snprintf(test_msg_buf, sizeof(test_msg_buf), "RGB%s %"PRIi32"x%"PRIi32" rotate %s, unalign %d, pad %d",
+             (px_size == 2) ? "565" : "888", w, h, rotation_names[rotation], src_unalign_byte, pad_px);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(ref_buf, dst_align16, dst_len, test_msg_buf);
+
+    free(src_align16);
+    free(dst_align16);
+    free(ref_buf);
+}
+
+static void lv_transform_scale_test(int px_size, int32_t src_w, int32_t src_h, int32_t dst_w, int32_t dst_h,
+                                    lvgl_port_scale_mode_t mode)
+{
+    int32_t src_stride = src_w * px_size;
+    int32_t dst_stride = dst_w * px_size + px_size;     // Padded, the padding must be left untouched
+    size_t src_len = src_h * src_stride;
+    size_t dst_len = dst_h * dst_stride + CANARY_BYTES * 2;
+
+    uint8_t *src = (uint8_t *)memalign(16, src_len);
+    uint8_t *dst = (uint8_t *)memalign(16, dst_len);
+    uint8_t *ref_buf = (uint8_t *)malloc(dst_len);
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, src, "Lack of memory");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, dst, "Lack of memory");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, ref_buf, "Lack of memory");
+
+    fill_pattern(src, src_len);
+    memset(dst, CANARY_VALUE, dst_len);
+    memset(ref_buf, CANARY_VALUE, dst_len);
+
+    if (px_size == 2) {
+        lv_transform_scale_rgb565_ref((const uint16_t *)src, src_w, src_h, src_stride,
+                                      (uint16_t *)(ref_buf + CANARY_BYTES), dst_w, dst_h, dst_stride, mode);
+        lvgl_port_scale_rgb565((const uint16_t *)src, src_w, src_h, src_stride, (uint16_t *)(dst + CANARY_BYTES),
+                               dst_w, dst_h, dst_stride, mode);
+    } else {
+        lv_transform_scale_rgb888_ref(src, src_w, src_h, src_stride, ref_buf + CANARY_BYTES, dst_w, dst_h,
+                                      dst_stride, mode);
+        lvgl_port_scale_rgb888(src, src_w, src_h, src_stride, dst + CANARY_BYTES, dst_w, dst_h, dst_stride, mode);
+    }
+
+    snprintf(test_msg_buf, sizeof(test_msg_buf), "RGB%s %"PRIi32"x%"PRIi32" to %"PRIi32"x%"PRIi32" %s",
+             (px_size == 2) ? "565" : "888", src_w, src_h, dst_w, dst_h,
+             (mode == LVGL_PORT_SCALE_NEAREST) ? "nearest" : "bilinear");
+    ESP_LOGD(TAG_LV_TRANSFORM_FUNC, "%s", test_msg_buf);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(ref_buf, dst, dst_len, test_msg_buf);
+
+    free(src);
+    free(dst);
+    free(ref_buf);
+}
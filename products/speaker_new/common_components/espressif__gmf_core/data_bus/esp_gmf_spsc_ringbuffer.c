@@ -0,0 +1,435 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_gmf_spsc_ringbuffer.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+
+#define SPSC_RB_CACHE_LINE_SIZE (64)
+#define SPSC_RB_CACHE_ALIGNED   __attribute__((aligned(SPSC_RB_CACHE_LINE_SIZE)))
+
+static const char *TAG = "ESP_GMF_SPSC_RB";
+
+/**
+ * @brief  Structure representing a SPSC ring buffer
+ *
+ *         The indices run over [0, 2 * size), so a full buffer and an empty one are told apart without a counter
+ *         shared by both sides. Each side owns a cache line holding its index, the last index seen of the other
+ *         side and its pending region, the other side only loads the index from it.
+ */
+struct esp_gmf_spsc_ringbuffer {
+    _Atomic uint32_t         head SPSC_RB_CACHE_ALIGNED;  /*!< Write index, stored by the writer only */
+    uint32_t                 cached_tail;                 /*!< Last read index seen by the writer */
+    uint32_t                 write_len;                   /*!< Size of the region acquired for write */
+    _Atomic uint32_t         write_want;                  /*!< Free size the waiting writer needs to be woken up */
+    _Atomic(TaskHandle_t)    writer;                      /*!< Writer task waiting for space, NULL if none */
+    _Atomic uint32_t         tail SPSC_RB_CACHE_ALIGNED;  /*!< Read index, stored by the reader only */
+    uint32_t                 cached_head;                 /*!< Last write index seen by the reader */
+    uint32_t                 read_len;                    /*!< Size of the region acquired for read */
+    _Atomic uint32_t         read_want;                   /*!< Filled size the waiting reader needs to be woken up */
+    _Atomic(TaskHandle_t)    reader;                      /*!< Reader task waiting for data, NULL if none */
+    uint8_t                 *p_o SPSC_RB_CACHE_ALIGNED;   /*!< Original pointer */
+    uint32_t                 size;                        /*!< Buffer size */
+    _Atomic bool             abort;                       /*!< Flag to indicate abort of both sides */
+    _Atomic bool             is_done_write;               /*!< Flag to signal completion of writing */
+};
+
+static inline uint32_t spsc_rb_fill(const struct esp_gmf_spsc_ringbuffer *rb, uint32_t head, uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + 2 * rb->size - tail);
+}
+
+static inline uint32_t spsc_rb_advance(const struct esp_gmf_spsc_ringbuffer *rb, uint32_t index, uint32_t len)
+{
+    index += len;
+    return (index >= 2 * rb->size) ? (index - 2 * rb->size) : index;
+}
+
+static inline uint32_t spsc_rb_offset(const struct esp_gmf_spsc_ringbuffer *rb, uint32_t index)
+{
+    return (index >= rb->size) ? (index - rb->size) : index;
+}
+
+static inline bool spsc_rb_is_ready(struct esp_gmf_spsc_ringbuffer *rb, bool is_reader)
+{
+    uint32_t filled = spsc_rb_fill(rb, atomic_load(&rb->head), atomic_load(&rb->tail));
+    return is_reader ? (filled >= atomic_load(&rb->read_want)) : (rb->size - filled >= atomic_load(&rb->write_want));
+}
+
+static inline void spsc_rb_wake(_Atomic(TaskHandle_t) *waiter)
+{
+    TaskHandle_t task = atomic_exchange(waiter, NULL);
+    if (task) {
+        xTaskNotifyGiveIndexed(task, ESP_GMF_SPSC_RB_NOTIFY_INDEX);
+    }
+}
+
+/**
+ * @brief  Wake the other side up if it waits and what it wants is there, called after a release
+ *
+ *         Pairs with the check in `spsc_rb_wait`: either the waiter sees the new index, or this sees the waiter
+ */
+static inline void spsc_rb_wake_other(struct esp_gmf_spsc_ringbuffer *rb, bool is_reader)
+{
+    _Atomic(TaskHandle_t) *waiter = is_reader ? &rb->writer : &rb->reader;
+    if ((atomic_load(waiter) != NULL) && spsc_rb_is_ready(rb, !is_reader)) {
+        spsc_rb_wake(waiter);
+    }
+}
+
+/**
+ * @brief  Sleep until the other side releases enough for `want` bytes, or until abort, done write or timeout
+ *
+ *         Waking up only once a whole chunk is there, instead of at each release, saves context switches when
+ *         the two sides work with different sizes. Both sides only sleep on an empty or a full buffer, where the
+ *         other side can always go on until the wanted size is reached.
+ */
+static esp_gmf_err_io_t spsc_rb_wait(struct esp_gmf_spsc_ringbuffer *rb, bool is_reader, uint32_t want,
+                                     TimeOut_t *timeout, TickType_t *ticks_left)
+{
+    _Atomic(TaskHandle_t) *waiter = is_reader ? &rb->reader : &rb->writer;
+    atomic_store(is_reader ? &rb->read_want : &rb->write_want, want);
+    atomic_store(waiter, xTaskGetCurrentTaskHandle());
+    if (spsc_rb_is_ready(rb, is_reader) || atomic_load(&rb->abort) || atomic_load(&rb->is_done_write)) {
+        atomic_store(waiter, NULL);
+        return ESP_GMF_IO_OK;
+    }
+    if (xTaskCheckForTimeOut(timeout, ticks_left) == pdTRUE) {
+        atomic_store(waiter, NULL);
+        return ESP_GMF_IO_TIMEOUT;
+    }
+    ulTaskNotifyTakeIndexed(ESP_GMF_SPSC_RB_NOTIFY_INDEX, pdTRUE, *ticks_left);
+    atomic_store(waiter, NULL);
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t spsc_rb_acquire_read(struct esp_gmf_spsc_ringbuffer *rb, esp_gmf_data_bus_block_t *blk,
+                                             uint32_t wanted_size, uint32_t wake_size, int ticks_to_wait)
+{
+    uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+    uint32_t filled = spsc_rb_fill(rb, rb->cached_head, tail);
+    TimeOut_t timeout;
+    TickType_t ticks_left = ticks_to_wait;
+    if (filled == 0) {
+        vTaskSetTimeOutState(&timeout);
+    }
+    blk->is_last = false;
+    while (filled == 0) {
+        rb->cached_head = atomic_load_explicit(&rb->head, memory_order_acquire);
+        filled = spsc_rb_fill(rb, rb->cached_head, tail);
+        if (filled) {
+            break;
+        }
+        if (atomic_load_explicit(&rb->is_done_write, memory_order_acquire)) {
+            // The writer sets the flag after its last release, so the index read again is final
+            rb->cached_head = atomic_load_explicit(&rb->head, memory_order_acquire);
+            if (spsc_rb_fill(rb, rb->cached_head, tail) == 0) {
+                blk->valid_size = 0;
+                blk->is_last = true;
+                rb->read_len = 0;
+                return ESP_GMF_IO_OK;
+            }
+            continue;
+        }
+        if (atomic_load_explicit(&rb->abort, memory_order_acquire)) {
+            ESP_LOGD(TAG, "RD:%p, abort", rb);
+            return ESP_GMF_IO_ABORT;
+        }
+        esp_gmf_err_io_t ret = spsc_rb_wait(rb, true, wake_size, &timeout, &ticks_left);
+        if (ret != ESP_GMF_IO_OK) {
+            ESP_LOGD(TAG, "RD:%p, timeout:%d", rb, ticks_to_wait);
+            return ret;
+        }
+    }
+    uint32_t offset = spsc_rb_offset(rb, tail);
+    uint32_t len = rb->size - offset;
+    len = (len < filled) ? len : filled;
+    len = (len < wanted_size) ? len : wanted_size;
+    blk->buf = rb->p_o + offset;
+    blk->buf_length = len;
+    blk->valid_size = len;
+    rb->read_len = len;
+    ESP_LOGV(TAG, "ACQ_RD:%p, off:%ld, len:%ld, fill:%ld", rb, offset, len, filled);
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t spsc_rb_acquire_write(struct esp_gmf_spsc_ringbuffer *rb, esp_gmf_data_bus_block_t *blk,
+                                              uint32_t wanted_size, uint32_t wake_size, int ticks_to_wait)
+{
+    if (atomic_load_explicit(&rb->is_done_write, memory_order_relaxed)) {
+        ESP_LOGE(TAG, "WR:%p, acquire after done", rb);
+        return ESP_GMF_IO_FAIL;
+    }
+    uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+    uint32_t space = rb->size - spsc_rb_fill(rb, head, rb->cached_tail);
+    TimeOut_t timeout;
+    TickType_t ticks_left = ticks_to_wait;
+    if (space == 0) {
+        vTaskSetTimeOutState(&timeout);
+    }
+    while (space == 0) {
+        rb->cached_tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+        space = rb->size - spsc_rb_fill(rb, head, rb->cached_tail);
+        if (space) {
+            break;
+        }
+        if (atomic_load_explicit(&rb->abort, memory_order_acquire)) {
+            ESP_LOGD(TAG, "WR:%p, abort", rb);
+            return ESP_GMF_IO_ABORT;
+        }
+        esp_gmf_err_io_t ret = spsc_rb_wait(rb, false, wake_size, &timeout, &ticks_left);
+        if (ret != ESP_GMF_IO_OK) {
+            ESP_LOGD(TAG, "WR:%p, timeout:%d", rb, ticks_to_wait);
+            return ret;
+        }
+    }
+    uint32_t offset = spsc_rb_offset(rb, head);
+    uint32_t len = rb->size - offset;
+    len = (len < space) ? len : space;
+    len = (len < wanted_size) ? len : wanted_size;
+    blk->buf = rb->p_o + offset;
+    blk->buf_length = len;
+    blk->valid_size = 0;
+    blk->is_last = false;
+    rb->write_len = len;
+    ESP_LOGV(TAG, "ACQ_WR:%p, off:%ld, len:%ld, space:%ld", rb, offset, len, space);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_create(int block_size, int n_blocks, esp_gmf_spsc_rb_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    *handle = NULL;
+    if ((block_size <= 0) || (n_blocks <= 0) || ((uint64_t)block_size * n_blocks > (UINT32_MAX >> 1))) {
+        ESP_LOGE(TAG, "Invalid size, block_size:%d, n_blocks:%d", block_size, n_blocks);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    struct esp_gmf_spsc_ringbuffer *rb = esp_gmf_oal_malloc_align(SPSC_RB_CACHE_LINE_SIZE, sizeof(struct esp_gmf_spsc_ringbuffer));
+    ESP_GMF_MEM_CHECK(TAG, rb, return ESP_GMF_ERR_MEMORY_LACK);
+    memset(rb, 0, sizeof(struct esp_gmf_spsc_ringbuffer));
+    rb->p_o = esp_gmf_oal_calloc(n_blocks, block_size);
+    ESP_GMF_MEM_CHECK(TAG, rb->p_o, goto _esp_gmf_spsc_rb_init_failed);
+    rb->size = block_size * n_blocks;
+    atomic_init(&rb->head, 0);
+    atomic_init(&rb->tail, 0);
+    atomic_init(&rb->read_want, 1);
+    atomic_init(&rb->write_want, 1);
+    atomic_init(&rb->writer, NULL);
+    atomic_init(&rb->reader, NULL);
+    atomic_init(&rb->abort, false);
+    atomic_init(&rb->is_done_write, false);
+    *handle = rb;
+    return ESP_GMF_ERR_OK;
+_esp_gmf_spsc_rb_init_failed:
+    esp_gmf_spsc_rb_destroy(rb);
+    return ESP_GMF_ERR_MEMORY_LACK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_destroy(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    if (rb->p_o) {
+        esp_gmf_oal_free(rb->p_o);
+        rb->p_o = NULL;
+    }
+    esp_gmf_oal_free(rb);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_reset(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    atomic_store(&rb->head, 0);
+    atomic_store(&rb->tail, 0);
+    atomic_store(&rb->read_want, 1);
+    atomic_store(&rb->write_want, 1);
+    rb->cached_head = rb->cached_tail = 0;
+    rb->read_len = rb->write_len = 0;
+    atomic_store(&rb->abort, false);
+    atomic_store(&rb->is_done_write, false);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on acquire read, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    return spsc_rb_acquire_read(rb, blk, wanted_size, 1, ticks_to_wait);
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL || blk->valid_size > rb->read_len) {
+        ESP_LOGE(TAG, "Invalid parameters on release read, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    rb->read_len = 0;
+    if (blk->valid_size == 0) {
+        return ESP_GMF_IO_OK;
+    }
+    uint32_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+    atomic_store(&rb->tail, spsc_rb_advance(rb, tail, blk->valid_size));
+    spsc_rb_wake_other(rb, true);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on acquire write, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    return spsc_rb_acquire_write(rb, blk, wanted_size, 1, ticks_to_wait);
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL || blk->valid_size > rb->write_len) {
+        ESP_LOGE(TAG, "Invalid parameters on release write, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    rb->write_len = 0;
+    if (blk->valid_size) {
+        uint32_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+        atomic_store(&rb->head, spsc_rb_advance(rb, head, blk->valid_size));
+        spsc_rb_wake_other(rb, false);
+    }
+    if (blk->is_last) {
+        esp_gmf_spsc_rb_done_write(rb);
+    }
+    return ESP_GMF_IO_OK;
+}
+
+int esp_gmf_spsc_rb_write(esp_gmf_spsc_rb_handle_t handle, const uint8_t *data, uint32_t len, int ticks_to_wait)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL || (data == NULL && len)) {
+        ESP_LOGE(TAG, "Invalid parameters on write, rb:%p, data:%p", rb, data);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_err_io_t ret = ESP_GMF_IO_OK;
+    uint32_t written = 0;
+    while (written < len) {
+        uint32_t left = len - written;
+        ret = spsc_rb_acquire_write(rb, &blk, left, (left < rb->size) ? left : rb->size, ticks_to_wait);
+        if (ret != ESP_GMF_IO_OK) {
+            break;
+        }
+        memcpy(blk.buf, data + written, blk.buf_length);
+        blk.valid_size = blk.buf_length;
+        esp_gmf_spsc_rb_release_write(rb, &blk, ticks_to_wait);
+        written += blk.valid_size;
+    }
+    return ((written > 0) || (ret == ESP_GMF_IO_OK)) ? (int)written : ret;
+}
+
+int esp_gmf_spsc_rb_read(esp_gmf_spsc_rb_handle_t handle, uint8_t *data, uint32_t len, int ticks_to_wait)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL || (data == NULL && len)) {
+        ESP_LOGE(TAG, "Invalid parameters on read, rb:%p, data:%p", rb, data);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_err_io_t ret = ESP_GMF_IO_OK;
+    uint32_t read = 0;
+    while (read < len) {
+        uint32_t left = len - read;
+        ret = spsc_rb_acquire_read(rb, &blk, left, (left < rb->size) ? left : rb->size, ticks_to_wait);
+        if ((ret != ESP_GMF_IO_OK) || blk.is_last) {
+            break;
+        }
+        memcpy(data + read, blk.buf, blk.valid_size);
+        esp_gmf_spsc_rb_release_read(rb, &blk, ticks_to_wait);
+        read += blk.valid_size;
+    }
+    return ((read > 0) || (ret == ESP_GMF_IO_OK)) ? (int)read : ret;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_abort(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    ESP_LOGD(TAG, "Abort, rb:%p", rb);
+    atomic_store(&rb->abort, true);
+    spsc_rb_wake(&rb->reader);
+    spsc_rb_wake(&rb->writer);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_done_write(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    atomic_store(&rb->is_done_write, true);
+    ESP_LOGD(TAG, "Set done write, rb:%p", rb);
+    spsc_rb_wake(&rb->reader);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_reset_done_write(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    atomic_store(&rb->is_done_write, false);
+    ESP_LOGD(TAG, "Reset done write, rb:%p", rb);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_available(esp_gmf_spsc_rb_handle_t handle, uint32_t *available_size)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb && available_size) {
+        *available_size = rb->size - spsc_rb_fill(rb, atomic_load(&rb->head), atomic_load(&rb->tail));
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_filled(esp_gmf_spsc_rb_handle_t handle, uint32_t *filled_size)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb && filled_size) {
+        *filled_size = spsc_rb_fill(rb, atomic_load(&rb->head), atomic_load(&rb->tail));
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_get_size(esp_gmf_spsc_rb_handle_t handle, uint32_t *max_size)
+{
+    struct esp_gmf_spsc_ringbuffer *rb = (struct esp_gmf_spsc_ringbuffer *)handle;
+    if (rb && max_size) {
+        *max_size = rb->size;
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
@@ -110,19 +110,20 @@ typedef struct {
  *          +---------+     +---------------+    +----------+
  */
 typedef struct esp_gmf_port_ {
-    struct esp_gmf_port_  *next;           /*!< Pointer to the next port */
-    void                  *writer;         /*!< Acquire out functions caller with the port */
-    void                  *reader;         /*!< Acquire in functions caller with the port */
-    esp_gmf_port_io_ops_t  ops;            /*!< I/O operations of the port */
-    esp_gmf_port_attr_t    attr;           /*!< Port attributes */
-    int                    data_length;    /*!< Data length of the payload */
-    void                  *ctx;            /*!< User context for the port */
-    int                    wait_ticks;     /*!< Timeout for port operations */
-    esp_gmf_payload_t     *payload;        /*!< Payload pointer to be set */
-    uint8_t                is_shared : 1;  /*!< Payload is shared to the next element port or not, 1 for shared (default), 0 for dedicated */
-    esp_gmf_payload_t     *self_payload;   /*!< Self payload of the port */
-    struct esp_gmf_port_  *ref_port;       /*!< Pointer to the reference port */
-    int8_t                 ref_count;      /*!< Reference count indicating the number of active references */
+    struct esp_gmf_port_          *next;           /*!< Pointer to the next port */
+    void                          *writer;         /*!< Acquire out functions caller with the port */
+    void                          *reader;         /*!< Acquire in functions caller with the port */
+    esp_gmf_port_io_ops_t          ops;            /*!< I/O operations of the port */
+    esp_gmf_port_attr_t            attr;           /*!< Port attributes */
+    int                            data_length;    /*!< Data length of the payload */
+    void                          *ctx;            /*!< User context for the port */
+    int                            wait_ticks;     /*!< Timeout for port operations */
+    esp_gmf_payload_t             *payload;        /*!< Payload pointer to be set */
+    uint8_t                        is_shared : 1;  /*!< Payload is shared to the next element port or not, 1 for shared (default), 0 for dedicated */
+    esp_gmf_payload_t             *self_payload;   /*!< Self payload of the port */
+    struct esp_gmf_port_          *ref_port;       /*!< Pointer to the reference port */
+    int8_t                         ref_count;      /*!< Reference count indicating the number of active references */
+    esp_gmf_payload_pool_handle_t  payload_pool;   /*!< Pool to take the self payload from, NULL to allocate it on the heap */
 } esp_gmf_port_t;
 
 /**
@@ -196,6 +197,21 @@ esp_gmf_err_t esp_gmf_port_clean_payload_done(esp_gmf_port_handle_t handle);
  */
 esp_gmf_err_t esp_gmf_port_enable_payload_share(esp_gmf_port_handle_t handle, bool enable);
 
+/**
+ * @brief  Set the payload pool the specified port takes its self payload from
+ *
+ * @note  The self payload already created is kept, the pool is used for the next one.
+ *        When the pool is empty, or NULL is set, the self payload is allocated on the heap.
+ *
+ * @param[in]  handle  The port handle
+ * @param[in]  pool    The payload pool handle, or NULL
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_port_set_payload_pool(esp_gmf_port_handle_t handle, esp_gmf_payload_pool_handle_t pool);
+
 /**
  * @brief  Reset the port payload and variable of self payload
  *
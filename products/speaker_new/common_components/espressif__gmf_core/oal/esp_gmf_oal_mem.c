@@ -6,6 +6,7 @@
  */
 
 #include <stdlib.h>
+#include <stdatomic.h>
 #include "string.h"
 #include "sdkconfig.h"
 #include "esp_log.h"
@@ -16,6 +17,15 @@
 // #define ENABLE_AUDIO_MEM_TRACE
 #define MALLOC_RAM_FLAG 1
 
+static atomic_uint_least32_t mem_alloc_cnt;
+static atomic_uint_least32_t mem_realloc_cnt;
+static atomic_uint_least32_t mem_free_cnt;
+
+#define MEM_STATS_COUNT(cnt, ptr) do {                              \
+    if (ptr) {                                                      \
+        atomic_fetch_add_explicit(&(cnt), 1, memory_order_relaxed); \
+    }                                                               \
+} while (0)
 
 #ifdef ENABLE_AUDIO_MEM_TRACE
 int __attribute__((weak)) media_lib_add_trace_mem(const char *module, void *addr, int size, uint8_t flag)
@@ -40,6 +50,7 @@ void *esp_gmf_oal_malloc(size_t size)
 #ifdef ENABLE_AUDIO_MEM_TRACE
     media_lib_add_trace_mem(NULL, data, size, 0);
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
+    MEM_STATS_COUNT(mem_alloc_cnt, data);
     return data;
 }
 
@@ -55,6 +66,7 @@ void *esp_gmf_oal_malloc_align(uint8_t align, size_t size)
 #ifdef ENABLE_AUDIO_MEM_TRACE
     media_lib_add_trace_mem(NULL, data, size, 0);
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
+    MEM_STATS_COUNT(mem_alloc_cnt, data);
     return data;
 }
 
@@ -65,6 +77,7 @@ void esp_gmf_oal_free(void *ptr)
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
     // ESP_LOGI("ESP_GMF_MEM", "free:%p, called:0x%08x", ptr, (intptr_t)__builtin_return_address(0) - 2);
 
+    MEM_STATS_COUNT(mem_free_cnt, ptr);
     free(ptr);
 }
 
@@ -84,6 +97,7 @@ void *esp_gmf_oal_calloc(size_t nmemb, size_t size)
 #ifdef ENABLE_AUDIO_MEM_TRACE
     media_lib_add_trace_mem(NULL, data, nmemb * size, 0);
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
+    MEM_STATS_COUNT(mem_alloc_cnt, data);
     return data;
 }
 
@@ -104,6 +118,7 @@ void *esp_gmf_oal_realloc(void *ptr, size_t size)
 #ifdef ENABLE_AUDIO_MEM_TRACE
     media_lib_add_trace_mem(NULL, p, size, 0);
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
+    MEM_STATS_COUNT(mem_realloc_cnt, p);
     return p;
 }
 
@@ -123,6 +138,7 @@ char *esp_gmf_oal_strdup(const char *str)
     }
     // ESP_LOGI("ESP_GMF_MEM", "strdup:%p, size:%d, called:0x%08x", copy, size, (intptr_t)__builtin_return_address(0) - 2);
 
+    MEM_STATS_COUNT(mem_alloc_cnt, copy);
     return copy;
 }
 
@@ -139,6 +155,7 @@ void *esp_gmf_oal_calloc_inner(size_t n, size_t size)
 #endif  /* ENABLE_AUDIO_MEM_TRACE */
     // ESP_LOGI("ESP_GMF_MEM", "inner:%p, size:%d, called:0x%08x", data, size, (intptr_t)__builtin_return_address(0) - 2);
 
+    MEM_STATS_COUNT(mem_alloc_cnt, data);
     return data;
 }
 
@@ -152,6 +169,16 @@ void esp_gmf_oal_mem_print(const char *tag, int line, const char *func)
 #endif  /* CONFIG_SPIRAM_BOOT_INIT */
 }
 
+void esp_gmf_oal_mem_get_stats(esp_gmf_oal_mem_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    stats->alloc_cnt = atomic_load_explicit(&mem_alloc_cnt, memory_order_relaxed);
+    stats->realloc_cnt = atomic_load_explicit(&mem_realloc_cnt, memory_order_relaxed);
+    stats->free_cnt = atomic_load_explicit(&mem_free_cnt, memory_order_relaxed);
+}
+
 bool esp_gmf_oal_mem_spiram_stack_is_enabled(void)
 {
 #if defined(CONFIG_SPIRAM_BOOT_INIT) && (CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY)
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "sdkconfig.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -16,6 +17,7 @@
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_oal_thread.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_node.h"
 #include "esp_gmf_task.h"
 #include "esp_log.h"
@@ -142,6 +144,46 @@ static inline void __esp_gmf_task_delete_jobs(esp_gmf_task_handle_t handle)
     esp_gmf_node_clear((esp_gmf_node_t **)&tsk->working, esp_gmf_job_item_free);
 }
 
+#if CONFIG_GMF_CORE_ENABLE_PROFILE
+static void esp_gmf_task_log_prof(esp_gmf_task_t *tsk)
+{
+    uint32_t avg_us = tsk->prof.loop_cnt ? (uint32_t)(tsk->prof.loop_us / tsk->prof.loop_cnt) : 0;
+    ESP_LOGI(TAG, "PROF [%s] loops:%ld, avg:%ldus, max:%ldus, overruns:%ld", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk),
+             tsk->prof.loop_cnt, avg_us, tsk->prof.loop_max_us, tsk->prof.overrun_cnt);
+}
+
+static inline void esp_gmf_task_loop_done(esp_gmf_task_t *tsk)
+{
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    uint32_t loop_us = (uint32_t)(now - tsk->loop_start_us);
+    tsk->prof.loop_cnt++;
+    tsk->prof.loop_us += loop_us;
+    if (loop_us > tsk->prof.loop_max_us) {
+        tsk->prof.loop_max_us = loop_us;
+    }
+    if (tsk->loop_budget_us && (loop_us > tsk->loop_budget_us)) {
+        tsk->prof.overrun_cnt++;
+        ESP_LOGD(TAG, "Loop overrun, [%s-%p], %ldus > %ldus", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, loop_us, tsk->loop_budget_us);
+    }
+    if (tsk->log_period_ms && ((now - tsk->log_last_us) >= (int64_t)tsk->log_period_ms * 1000)) {
+        tsk->log_last_us = now;
+        if (tsk->log_func) {
+            tsk->log_func(tsk, tsk->log_ctx);
+        } else {
+            esp_gmf_task_log_prof(tsk);
+        }
+        // Keep the logging out of the next loop
+        now = esp_gmf_oal_sys_get_time_us();
+    }
+    tsk->loop_start_us = now;
+}
+#else
+static inline void esp_gmf_task_loop_done(esp_gmf_task_t *tsk)
+{
+    tsk->prof.loop_cnt++;
+}
+#endif  /* CONFIG_GMF_CORE_ENABLE_PROFILE */
+
 static inline int process_func(esp_gmf_task_handle_t handle, void *para)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
@@ -152,6 +194,9 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
     }
     int result = ESP_GMF_ERR_OK;
     uint8_t is_stop = 0;
+#if CONFIG_GMF_CORE_ENABLE_PROFILE
+    tsk->loop_start_us = esp_gmf_oal_sys_get_time_us();
+#endif  /* CONFIG_GMF_CORE_ENABLE_PROFILE */
     while (worker && worker->func) {
         ESP_LOGD(TAG, "Running, job:%p, ctx:%p", worker->func, worker->ctx);
         worker->ret = worker->func(worker->ctx, NULL);
@@ -206,7 +251,13 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
             if (tsk->state != ESP_GMF_EVENT_STATE_ERROR) {
                 esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_PAUSED);
                 GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_PAUSE_BIT);
+#if CONFIG_GMF_CORE_ENABLE_PROFILE
+                int64_t pause_us = esp_gmf_oal_sys_get_time_us();
+                esp_gmf_task_acquire_signal(tsk, portMAX_DELAY);
+                tsk->loop_start_us += esp_gmf_oal_sys_get_time_us() - pause_us;
+#else
                 esp_gmf_task_acquire_signal(tsk, portMAX_DELAY);
+#endif  /* CONFIG_GMF_CORE_ENABLE_PROFILE */
                 ESP_LOGI(TAG, "Resume job, [%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
                 esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_RUNNING);
                 GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_RESUME_BIT);
@@ -239,6 +290,9 @@ static inline int process_func(esp_gmf_task_handle_t handle, void *para)
             worker = NULL;
         }
         worker = tmp;
+        if (tmp == NULL) {
+            esp_gmf_task_loop_done(tsk);
+        }
         bool is_empty = false;
         esp_gmf_job_stack_is_empty(tsk->start_stack, &is_empty);
         if ((tmp == NULL) && (is_empty == false)) {
@@ -574,3 +628,54 @@ esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event
     }
     return ESP_GMF_ERR_INVALID_ARG;
 }
+
+esp_gmf_err_t esp_gmf_task_set_loop_budget(esp_gmf_task_handle_t handle, uint32_t budget_us)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    tsk->loop_budget_us = budget_us;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_set_prof_log(esp_gmf_task_handle_t handle, int period_ms, esp_gmf_task_prof_log_cb func, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+#if !CONFIG_GMF_CORE_ENABLE_PROFILE
+    if (period_ms > 0) {
+        ESP_LOGW(TAG, "Profiling is disabled, enable CONFIG_GMF_CORE_ENABLE_PROFILE to log it, [%s-%p]",
+                 OBJ_GET_TAG((esp_gmf_obj_handle_t)handle), handle);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+#endif  /* !CONFIG_GMF_CORE_ENABLE_PROFILE */
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_oal_mutex_lock(tsk->lock);
+    // The task reads the period first, so it is cleared before and set after the function
+    tsk->log_period_ms = 0;
+    tsk->log_func = func;
+    tsk->log_ctx = ctx;
+    tsk->log_last_us = esp_gmf_oal_sys_get_time_us();
+    tsk->log_period_ms = period_ms > 0 ? period_ms : 0;
+    esp_gmf_oal_mutex_unlock(tsk->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_get_prof(esp_gmf_task_handle_t handle, esp_gmf_task_prof_t *prof)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, prof, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_oal_mutex_lock(tsk->lock);
+    *prof = tsk->prof;
+    esp_gmf_oal_mutex_unlock(tsk->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_reset_prof(esp_gmf_task_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_oal_mutex_lock(tsk->lock);
+    memset(&tsk->prof, 0, sizeof(tsk->prof));
+    esp_gmf_oal_mutex_unlock(tsk->lock);
+    return ESP_GMF_ERR_OK;
+}
@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host check of the element profiling counters, built from the component sources against the stubs of `stubs/`.
+ * Two synthetic elements are linked as a pipeline does: `src` reads from an edge port whose acquire callback
+ * waits, `sink` writes to an edge port whose acquire callback waits too. The time is a fake clock that only the
+ * synthetic elements and port callbacks advance, so the counters are checked exactly.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_port.h"
+
+#define FRAME_SIZE    (640)
+#define FRAME_NUM     (50)
+#define SRC_WAIT_US   (300)
+#define SRC_COST_US   (100)
+#define SINK_WAIT_US  (40)
+#define SINK_COST_US  (250)
+#define SLOW_FRAME    (17)
+#define SLOW_COST_US  (5000)
+
+#define CHECK(x) do {                                                         \
+    if (!(x)) {                                                               \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); \
+        exit(1);                                                              \
+    }                                                                         \
+} while (0)
+
+typedef struct {
+    esp_gmf_element_t  base;
+    uint32_t           cost_us;
+    uint32_t           frame;
+} synth_el_t;
+
+static int64_t  fake_now_us;
+static uint64_t sink_bytes;
+
+int64_t esp_gmf_oal_sys_get_time_us(void)
+{
+    return fake_now_us;
+}
+
+static esp_gmf_err_io_t src_acquire(void *ctx, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    fake_now_us += SRC_WAIT_US;
+    memset(load->buf, 0x5A, wanted_size);
+    load->valid_size = wanted_size;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t src_release(void *ctx, esp_gmf_payload_t *load, int wait_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t sink_acquire(void *ctx, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    fake_now_us += SINK_WAIT_US;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t sink_release(void *ctx, esp_gmf_payload_t *load, int wait_ticks)
+{
+    sink_bytes += load->valid_size;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_job_err_t synth_process(esp_gmf_element_handle_t self, void *para)
+{
+    synth_el_t *synth = (synth_el_t *)self;
+    esp_gmf_payload_t *in_load = NULL;
+    esp_gmf_payload_t *out_load = NULL;
+    CHECK(esp_gmf_port_acquire_in(synth->base.in, &in_load, FRAME_SIZE, ESP_GMF_MAX_DELAY) == ESP_GMF_IO_OK);
+    CHECK(esp_gmf_port_acquire_out(synth->base.out, &out_load, in_load->valid_size, ESP_GMF_MAX_DELAY) == ESP_GMF_IO_OK);
+    memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+    out_load->valid_size = in_load->valid_size;
+    synth->frame++;
+    fake_now_us += ((synth->cost_us == SRC_COST_US) && (synth->frame == SLOW_FRAME)) ? SLOW_COST_US : synth->cost_us;
+    CHECK(esp_gmf_port_release_out(synth->base.out, out_load, ESP_GMF_MAX_DELAY) == ESP_GMF_IO_OK);
+    CHECK(esp_gmf_port_release_in(synth->base.in, in_load, ESP_GMF_MAX_DELAY) == ESP_GMF_IO_OK);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static synth_el_t *synth_new(const char *tag, uint32_t cost_us)
+{
+    synth_el_t *synth = calloc(1, sizeof(synth_el_t));
+    CHECK(synth);
+    esp_gmf_element_cfg_t cfg = {0};
+    CHECK(esp_gmf_element_init(synth, &cfg) == ESP_GMF_ERR_OK);
+    CHECK(esp_gmf_obj_set_tag((esp_gmf_obj_handle_t)synth, tag) == ESP_GMF_ERR_OK);
+    synth->base.in_attr.port.type |= ESP_GMF_PORT_TYPE_BLOCK;
+    synth->base.out_attr.port.type |= ESP_GMF_PORT_TYPE_BLOCK;
+    synth->base.ops.process = synth_process;
+    synth->cost_us = cost_us;
+    return synth;
+}
+
+static void synth_delete(synth_el_t *synth)
+{
+    // Unregistering the ports frees them
+    esp_gmf_element_unregister_in_port(synth, NULL);
+    esp_gmf_element_unregister_out_port(synth, NULL);
+    esp_gmf_element_deinit(synth);
+    esp_gmf_obj_set_tag((esp_gmf_obj_handle_t)synth, NULL);
+    free(synth);
+}
+
+int main(void)
+{
+    synth_el_t *src = synth_new("src", SRC_COST_US);
+    synth_el_t *sink = synth_new("sink", SINK_COST_US);
+    // Edge ports with callbacks, and the block ports linking the elements as the pool creates them
+    CHECK(esp_gmf_element_register_in_port(src, NEW_ESP_GMF_PORT_IN_BYTE(src_acquire, src_release, NULL, NULL, FRAME_SIZE, 0)) == ESP_GMF_ERR_OK);
+    CHECK(esp_gmf_element_register_out_port(src, NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, FRAME_SIZE, 0)) == ESP_GMF_ERR_OK);
+    CHECK(esp_gmf_element_register_in_port(sink, NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, FRAME_SIZE, 0)) == ESP_GMF_ERR_OK);
+    CHECK(esp_gmf_element_register_out_port(sink, NEW_ESP_GMF_PORT_OUT_BYTE(sink_acquire, sink_release, NULL, NULL, FRAME_SIZE, 0)) == ESP_GMF_ERR_OK);
+    CHECK(esp_gmf_element_link_el(src, sink) == ESP_GMF_ERR_OK);
+
+    for (int i = 0; i < FRAME_NUM; i++) {
+        CHECK(esp_gmf_element_process_running(src, NULL) == ESP_GMF_JOB_ERR_OK);
+        CHECK(esp_gmf_element_process_running(sink, NULL) == ESP_GMF_JOB_ERR_OK);
+    }
+    CHECK(fake_now_us == (int64_t)FRAME_NUM * (SRC_WAIT_US + SRC_COST_US + SINK_WAIT_US + SINK_COST_US) + SLOW_COST_US - SRC_COST_US);
+    CHECK(sink_bytes == (uint64_t)FRAME_NUM * FRAME_SIZE);
+
+    esp_gmf_element_prof_t prof = {0};
+    CHECK(esp_gmf_element_get_prof(src, &prof) == ESP_GMF_ERR_OK);
+    printf("src:  n:%u, process:%llu us, max:%u us, wait:%llu us, in:%llu, out:%llu\n", prof.process_cnt,
+           (unsigned long long)prof.process_us, prof.process_max_us, (unsigned long long)prof.wait_us,
+           (unsigned long long)prof.bytes_in, (unsigned long long)prof.bytes_out);
+    CHECK(prof.process_cnt == FRAME_NUM);
+    // The waits of the edge port are taken out of the process time
+    CHECK(prof.process_us == (uint64_t)(FRAME_NUM - 1) * SRC_COST_US + SLOW_COST_US);
+    CHECK(prof.process_max_us == SLOW_COST_US);
+    CHECK(prof.wait_us == (uint64_t)FRAME_NUM * SRC_WAIT_US);
+    CHECK(prof.bytes_in == (uint64_t)FRAME_NUM * FRAME_SIZE);
+    CHECK(prof.bytes_out == (uint64_t)FRAME_NUM * FRAME_SIZE);
+
+    CHECK(esp_gmf_element_get_prof(sink, &prof) == ESP_GMF_ERR_OK);
+    printf("sink: n:%u, process:%llu us, max:%u us, wait:%llu us, in:%llu, out:%llu\n", prof.process_cnt,
+           (unsigned long long)prof.process_us, prof.process_max_us, (unsigned long long)prof.wait_us,
+           (unsigned long long)prof.bytes_in, (unsigned long long)prof.bytes_out);
+    CHECK(prof.process_cnt == FRAME_NUM);
+    CHECK(prof.process_us == (uint64_t)FRAME_NUM * SINK_COST_US);
+    CHECK(prof.process_max_us == SINK_COST_US);
+    CHECK(prof.wait_us == (uint64_t)FRAME_NUM * SINK_WAIT_US);
+    CHECK(prof.bytes_in == (uint64_t)FRAME_NUM * FRAME_SIZE);
+    CHECK(prof.bytes_out == (uint64_t)FRAME_NUM * FRAME_SIZE);
+
+    CHECK(esp_gmf_element_reset_prof(src) == ESP_GMF_ERR_OK);
+    CHECK(esp_gmf_element_get_prof(src, &prof) == ESP_GMF_ERR_OK);
+    CHECK((prof.process_cnt == 0) && (prof.process_us == 0) && (prof.wait_us == 0) && (prof.bytes_in == 0));
+
+    synth_delete(sink);
+    synth_delete(src);
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Just enough FreeRTOS and GMF OAL for the data bus and element sources to run on a host: tasks are pthreads, a tick is a
+ * millisecond, semaphores and task notifications are a counter guarded by a mutex and a condition variable.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_gmf_oal_mem.h"
+
+/* Notification values of a task, as many as the default `CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES` of the IDF */
+#define FREERTOS_HOST_NOTIFY_NUM (1)
+
+struct freertos_host_task {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    uint32_t        notify[FREERTOS_HOST_NOTIFY_NUM];
+};
+
+struct freertos_host_sem {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    uint32_t        count;
+};
+
+volatile uint64_t freertos_host_block_count;
+volatile uint64_t freertos_host_sync_count;
+
+static __thread struct freertos_host_task *current_task;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void init_sync(pthread_mutex_t *lock, pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(lock, NULL);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* Wait until `*count` is not 0, returns false on timeout, the lock is held */
+static bool wait_count(pthread_mutex_t *lock, pthread_cond_t *cond, volatile uint32_t *count, TickType_t ticks)
+{
+    if (*count) {
+        return true;
+    }
+    if (ticks == 0) {
+        return false;
+    }
+    __atomic_fetch_add(&freertos_host_block_count, 1, __ATOMIC_RELAXED);
+    if (ticks == portMAX_DELAY) {
+        while (*count == 0) {
+            pthread_cond_wait(cond, lock);
+        }
+        return true;
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += ticks / 1000;
+    deadline.tv_nsec += (long)(ticks % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    while (*count == 0) {
+        if (pthread_cond_timedwait(cond, lock, &deadline) != 0) {
+            return *count != 0;
+        }
+    }
+    return true;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (current_task == NULL) {
+        current_task = calloc(1, sizeof(struct freertos_host_task));
+        init_sync(&current_task->lock, &current_task->cond);
+    }
+    return current_task;
+}
+
+void vTaskSetTimeOutState(TimeOut_t *timeout)
+{
+    timeout->start_us = now_us();
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t *timeout, TickType_t *ticks_to_wait)
+{
+    if (*ticks_to_wait == portMAX_DELAY) {
+        return pdFALSE;
+    }
+    uint64_t now = now_us();
+    TickType_t elapsed = (TickType_t)((now - timeout->start_us) / 1000);
+    if (elapsed >= *ticks_to_wait) {
+        *ticks_to_wait = 0;
+        return pdTRUE;
+    }
+    *ticks_to_wait -= elapsed;
+    timeout->start_us = now;
+    return pdFALSE;
+}
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    struct freertos_host_task *task = xTaskGetCurrentTaskHandle();
+    /* FreeRTOS asserts on an index out of the array too */
+    if (index >= FREERTOS_HOST_NOTIFY_NUM) {
+        abort();
+    }
+    __atomic_fetch_add(&freertos_host_sync_count, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&task->lock);
+    wait_count(&task->lock, &task->cond, &task->notify[index], ticks_to_wait);
+    uint32_t value = task->notify[index];
+    if (value) {
+        task->notify[index] = clear_on_exit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index)
+{
+    if (index >= FREERTOS_HOST_NOTIFY_NUM) {
+        abort();
+    }
+    __atomic_fetch_add(&freertos_host_sync_count, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&task->lock);
+    task->notify[index]++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec ts = {.tv_sec = ticks / 1000, .tv_nsec = (long)(ticks % 1000) * 1000000};
+    nanosleep(&ts, NULL);
+}
+
+static SemaphoreHandle_t create_sem(uint32_t count)
+{
+    struct freertos_host_sem *sem = calloc(1, sizeof(struct freertos_host_sem));
+    if (sem) {
+        init_sync(&sem->lock, &sem->cond);
+        sem->count = count;
+    }
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return create_sem(0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return create_sem(1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait)
+{
+    __atomic_fetch_add(&freertos_host_sync_count, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&sem->lock);
+    bool taken = wait_count(&sem->lock, &sem->cond, &sem->count, ticks_to_wait);
+    if (taken) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return taken ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    __atomic_fetch_add(&freertos_host_sync_count, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&sem->lock);
+    // Both the binary semaphores and the mutexes saturate at 1
+    bool given = (sem->count == 0);
+    if (given) {
+        sem->count = 1;
+        pthread_cond_signal(&sem->cond);
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return given ? pdTRUE : pdFALSE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->lock);
+    free(sem);
+}
+
+void *esp_gmf_oal_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void *esp_gmf_oal_malloc_align(uint8_t align, size_t size)
+{
+    void *data = NULL;
+    return (posix_memalign(&data, align, size) == 0) ? data : NULL;
+}
+
+void *esp_gmf_oal_calloc(size_t nmemb, size_t size)
+{
+    return calloc(nmemb, size);
+}
+
+void esp_gmf_oal_free(void *ptr)
+{
+    free(ptr);
+}
+
+void *esp_gmf_oal_realloc(void *ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+char *esp_gmf_oal_strdup(const char *str)
+{
+    return strdup(str);
+}
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_payload.h"
+#include "esp_gmf_fifo.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_pool.h"
+#include "gmf_fake_dec.h"
+
+static const char *TAG = "TEST_ESP_GMF_PAYLOAD_POOL";
+
+#define TEST_POOL_BUF_SIZE   (512)
+#define TEST_STEADY_LOOP_CNT (1000)
+
+static esp_gmf_oal_mem_stats_t mem_start;
+
+static void mem_stats_begin(void)
+{
+    esp_gmf_oal_mem_get_stats(&mem_start);
+}
+
+static void mem_stats_check_no_heap_call(void)
+{
+    esp_gmf_oal_mem_stats_t mem_end = {0};
+    esp_gmf_oal_mem_get_stats(&mem_end);
+    ESP_LOGI(TAG, "Heap calls, alloc:%ld, realloc:%ld, free:%ld", mem_end.alloc_cnt - mem_start.alloc_cnt,
+             mem_end.realloc_cnt - mem_start.realloc_cnt, mem_end.free_cnt - mem_start.free_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mem_start.alloc_cnt, mem_end.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mem_start.realloc_cnt, mem_end.realloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mem_start.free_cnt, mem_end.free_cnt);
+}
+
+static esp_gmf_err_io_t _acquire_read(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks)
+{
+    memset(load->buf, 0x5A, wanted_size);
+    load->valid_size = wanted_size;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t _release_read(void *handle, esp_gmf_payload_t *load, int block_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t _acquire_write(void *handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks)
+{
+    load->valid_size = wanted_size;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t _release_write(void *handle, esp_gmf_payload_t *load, int block_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+TEST_CASE("Payload pool get, delete and grow", "ESP_GMF_PAYLOAD_POOL")
+{
+    esp_gmf_payload_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_payload_pool_create(0, TEST_POOL_BUF_SIZE, 16, &pool));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(2, TEST_POOL_BUF_SIZE, 16, &pool));
+    TEST_ASSERT_NOT_NULL(pool);
+
+    esp_gmf_payload_t *load[3] = {NULL};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, &load[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, &load[1]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_ENOUGH, esp_gmf_payload_pool_get(pool, &load[2]));
+    TEST_ASSERT_NULL(load[2]);
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(load[i]->is_pooled);
+        TEST_ASSERT_EQUAL(TEST_POOL_BUF_SIZE, load[i]->buf_length);
+        TEST_ASSERT_EQUAL(0, (uintptr_t)load[i]->buf % 16);
+    }
+
+    // Growing beyond the slot size falls back to the heap, and the slab buffer comes back on delete
+    uint8_t *slab_buf = load[0]->buf;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_aligned_buf(load[0], 16, TEST_POOL_BUF_SIZE * 2));
+    TEST_ASSERT_NOT_EQUAL(slab_buf, load[0]->buf);
+    TEST_ASSERT_EQUAL(TEST_POOL_BUF_SIZE * 2, load[0]->buf_length);
+    esp_gmf_payload_delete(load[0]);
+    esp_gmf_payload_delete(load[1]);
+
+    esp_gmf_payload_pool_stats_t stats = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_stats(pool, &stats));
+    TEST_ASSERT_EQUAL(2, stats.slot_cnt);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(2, stats.peak_in_use);
+    TEST_ASSERT_EQUAL(1, stats.empty_cnt);
+    TEST_ASSERT_EQUAL(1, stats.oversize_cnt);
+
+    // Steady state: taking and deleting pooled payloads never calls the heap
+    mem_stats_begin();
+    for (int i = 0; i < TEST_STEADY_LOOP_CNT; i++) {
+        esp_gmf_payload_t *tmp = NULL;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, &tmp));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_buf(tmp, TEST_POOL_BUF_SIZE));
+        tmp->valid_size = TEST_POOL_BUF_SIZE;
+        esp_gmf_payload_delete(tmp);
+    }
+    mem_stats_check_no_heap_call();
+
+    // The pool outlives its destroy until the last payload is deleted
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get(pool, &load[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool));
+    memset(load[0]->buf, 0, load[0]->buf_length);
+    esp_gmf_payload_delete(load[0]);
+}
+
+TEST_CASE("FIFO steady state without heap calls", "ESP_GMF_PAYLOAD_POOL")
+{
+    esp_gmf_fifo_handle_t fifo = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_create(3, TEST_POOL_BUF_SIZE, &fifo));
+    esp_gmf_data_bus_block_t blk = {0};
+
+    // The first write preallocates all the nodes
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, TEST_POOL_BUF_SIZE, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)blk.buf % 16);
+    blk.valid_size = TEST_POOL_BUF_SIZE;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, TEST_POOL_BUF_SIZE, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, portMAX_DELAY));
+    uint32_t total_size = 0;
+    esp_gmf_fifo_get_total_size(fifo, &total_size);
+    TEST_ASSERT_EQUAL(3 * TEST_POOL_BUF_SIZE, total_size);
+
+    mem_stats_begin();
+    for (int i = 0; i < TEST_STEADY_LOOP_CNT; i++) {
+        // Keep two blocks in flight so that all the nodes are cycled
+        for (int j = 0; j < 2; j++) {
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, TEST_POOL_BUF_SIZE - i % 64, portMAX_DELAY));
+            blk.valid_size = TEST_POOL_BUF_SIZE - i % 64;
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, portMAX_DELAY));
+        }
+        for (int j = 0; j < 2; j++) {
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, TEST_POOL_BUF_SIZE, portMAX_DELAY));
+            TEST_ASSERT_EQUAL(TEST_POOL_BUF_SIZE - i % 64, blk.valid_size);
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, portMAX_DELAY));
+        }
+    }
+    mem_stats_check_no_heap_call();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_destroy(fifo));
+}
+
+TEST_CASE("Pipeline ports take payloads from the pool, [port callback -> dec -> dec -> port callback]", "ESP_GMF_PAYLOAD_POOL")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    fake_dec_cfg_t fake_dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    const char *name[] = {"dec1", "dec2"};
+    for (int i = 0; i < sizeof(name) / sizeof(name[0]); i++) {
+        esp_gmf_element_handle_t fake_dec = NULL;
+        fake_dec_cfg.name = name[i];
+        fake_dec_init(&fake_dec_cfg, &fake_dec);
+        TEST_ASSERT_NOT_NULL(fake_dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+    }
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    esp_gmf_pool_new_pipeline(pool, NULL, name, sizeof(name) / sizeof(char *), NULL, &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BYTE(_acquire_read, _release_read, NULL, NULL, FAKE_DEC_BUFFER_SIZE, 100);
+    esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BYTE(_acquire_write, _release_write, NULL, NULL, FAKE_DEC_BUFFER_SIZE, 100);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reg_el_port(pipe, "dec1", ESP_GMF_IO_DIR_READER, in_port));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reg_el_port(pipe, "dec2", ESP_GMF_IO_DIR_WRITER, out_port));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_setup_payload_pool(pipe, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_pipeline_setup_payload_pool(pipe, 0));
+    esp_gmf_payload_pool_stats_t stats = {0};
+    esp_gmf_payload_pool_get_stats(pipe->payload_pool, &stats);
+    // IN and OUT of each element
+    TEST_ASSERT_EQUAL(4, stats.slot_cnt);
+    TEST_ASSERT_EQUAL(FAKE_DEC_BUFFER_SIZE, stats.buf_size);
+
+    esp_gmf_element_handle_t els[2] = {NULL};
+    esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &els[0]);
+    esp_gmf_pipeline_get_el_by_name(pipe, "dec2", &els[1]);
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_process_open(els[i], NULL));
+    }
+    // Warm up: the ports take their self payloads on the first run
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_running(els[0], NULL));
+        TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_running(els[1], NULL));
+    }
+    mem_stats_begin();
+    for (int i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_running(els[0], NULL));
+        TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_running(els[1], NULL));
+    }
+    mem_stats_check_no_heap_call();
+
+    esp_gmf_payload_pool_get_stats(pipe->payload_pool, &stats);
+    ESP_LOGI(TAG, "Payload pool, in use:%d, peak:%d, hit:%ld, empty:%ld, oversize:%ld", stats.in_use, stats.peak_in_use,
+             stats.hit_cnt, stats.empty_cnt, stats.oversize_cnt);
+    TEST_ASSERT_TRUE(stats.hit_cnt > 0);
+    TEST_ASSERT_EQUAL(0, stats.empty_cnt);
+    TEST_ASSERT_EQUAL(0, stats.oversize_cnt);
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_process_close(els[i], NULL));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
@@ -18,6 +18,7 @@
 #include "esp_lcd_panel_ops.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_transform.h"
 
 #define LVGL_PORT_PPA   (CONFIG_LVGL_PORT_ENABLE_PPA)
 
@@ -658,7 +659,14 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
             lv_color_format_t cf = lv_display_get_color_format(drv);
             uint32_t w_stride = lv_draw_buf_width_to_stride(ww, cf);
             uint32_t h_stride = lv_draw_buf_width_to_stride(hh, cf);
-            if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
+            /* The destination stride follows the rotated width */
+            uint32_t dst_stride = (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) ? w_stride : h_stride;
+            if (cf == LV_COLOR_FORMAT_RGB565) {
+                /* Tiled kernels, with PIE on esp32s3 */
+                lvgl_port_rotate_rgb565((const uint16_t *)color_map, (uint16_t *)disp_ctx->draw_buffs[2], ww, hh, w_stride, dst_stride, (lvgl_port_rotate_t)disp_ctx->current_rotation);
+            } else if (cf == LV_COLOR_FORMAT_RGB888) {
+                lvgl_port_rotate_rgb888(color_map, (uint8_t *)disp_ctx->draw_buffs[2], ww, hh, w_stride, dst_stride, (lvgl_port_rotate_t)disp_ctx->current_rotation);
+            } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], hh, ww, h_stride, h_stride, LV_DISPLAY_ROTATION_180, cf);
             } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_90) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, LV_DISPLAY_ROTATION_90, cf);
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include <sdkconfig.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "lv_transform_common.h"
+
+#define WIDTH 128
+#define HEIGHT 128
+#define BENCHMARK_CYCLES 100
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_TRANSFORM_BENCH = "LV Transform Benchmark";
+static const char *rotation_names[] = {"0", "90", "180", "270"};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run the rotation benchmark of the DUT and of the plain per-pixel reference
+ */
+static void lv_transform_rotate_benchmark(int px_size, lvgl_port_rotate_t rotation);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Benchmark tests
+
+Requires:
+    - To pass functionality tests first
+
+Purpose:
+    - Test that the tiled rotation (PIE on esp32s3 for RGB565) is faster than the plain per-pixel rotation
+
+Procedure:
+    - Allocate 16-byte aligned 128x128 source and destination matrices
+    - Rotate them multiple times by the DUT, then by the reference, counting CPU cycles
+    - Compare the cycles per sample
+*/
+
+TEST_CASE("LV Transform benchmark RGB565 rotate", "[transform][benchmark][RGB565]")
+{
+    for (int r = LVGL_PORT_ROTATE_90; r <= LVGL_PORT_ROTATE_270; r++) {
+        lv_transform_rotate_benchmark(2, (lvgl_port_rotate_t)r);
+    }
+}
+
+TEST_CASE("LV Transform benchmark RGB888 rotate", "[transform][benchmark][RGB888]")
+{
+    for (int r = LVGL_PORT_ROTATE_90; r <= LVGL_PORT_ROTATE_270; r++) {
+        lv_transform_rotate_benchmark(3, (lvgl_port_rotate_t)r);
+    }
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_transform_rotate_benchmark(int px_size, lvgl_port_rotate_t rotation)
+{
+    int32_t stride = WIDTH * px_size;
+    uint8_t *src = (uint8_t *)memalign(16, stride * HEIGHT);
+    uint8_t *dst = (uint8_t *)memalign(16, stride * HEIGHT);
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, src, "Lack of memory");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, dst, "Lack of memory");
+    memset(src, 0x5A, stride * HEIGHT);
+
+    // Warm up the cache, then run the DUT
+    if (px_size == 2) {
+        lvgl_port_rotate_rgb565((const uint16_t *)src, (uint16_t *)dst, WIDTH, HEIGHT, stride, stride, rotation);
+    } else {
+        lvgl_port_rotate_rgb888(src, dst, WIDTH, HEIGHT, stride, stride, rotation);
+    }
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0; i < BENCHMARK_CYCLES; i++) {
+        if (px_size == 2) {
+            lvgl_port_rotate_rgb565((const uint16_t *)src, (uint16_t *)dst, WIDTH, HEIGHT, stride, stride, rotation);
+        } else {
+            lvgl_port_rotate_rgb888(src, dst, WIDTH, HEIGHT, stride, stride, rotation);
+        }
+    }
+    const float dut_cycles = (float)(xthal_get_ccount() - start_b) / BENCHMARK_CYCLES;
+
+    // Run the reference
+    lv_transform_rotate_ref(src, dst, WIDTH, HEIGHT, stride, stride, rotation, px_size);
+    start_b = xthal_get_ccount();
+    for (int i = 0; i < BENCHMARK_CYCLES; i++) {
+        lv_transform_rotate_ref(src, dst, WIDTH, HEIGHT, stride, stride, rotation, px_size);
+    }
+    const float ref_cycles = (float)(xthal_get_ccount() - start_b) / BENCHMARK_CYCLES;
+
+    ESP_LOGI(TAG_LV_TRANSFORM_BENCH, " RGB%s rotate %s: tiled %.3f, plain %.3f cycles per sample",
+             (px_size == 2) ? "565" : "888", rotation_names[rotation], dut_cycles / (WIDTH * HEIGHT),
+             ref_cycles / (WIDTH * HEIGHT));
+    TEST_ASSERT_LESS_THAN_FLOAT(ref_cycles, dut_cycles);
+
+    free(src);
+    free(dst);
+}
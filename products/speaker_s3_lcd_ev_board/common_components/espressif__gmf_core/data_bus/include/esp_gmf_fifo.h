@@ -31,6 +31,9 @@ typedef void *esp_gmf_fifo_handle_t;
 /**
  * @brief  Create a FIFO buffer for data blocks
  *
+ * @note  All the blocks are allocated at once on the first write, with the larger one of `block_size` and the size
+ *        wanted by that write, so a FIFO whose writes fit in that size never allocates afterwards
+ *
  * @param[in]   block_cnt   Number of blocks in the FIFO
  * @param[in]   block_size  Size of each block in bytes
  * @param[out]  handle      Pointer to the FIFO handle to be created
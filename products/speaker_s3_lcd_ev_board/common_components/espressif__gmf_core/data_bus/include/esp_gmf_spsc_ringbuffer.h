@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_gmf_data_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  GMF SPSC ringbuffer is a lock-free ring buffer for exactly one writer task and one reader task.
+ *         The write and read positions are atomic indices kept on separate cache lines, so the two sides
+ *         never take a lock nor touch the same line on the fast path. A side only blocks when the buffer
+ *         is full (writer) or empty (reader), and it is woken up by a task notification from the other side.
+ *
+ *         Unlike `esp_gmf_rb`, the acquire functions give direct access to the internal buffer:
+ *         `esp_gmf_spsc_rb_acquire_write` returns the contiguous free region and `esp_gmf_spsc_rb_acquire_read`
+ *         the contiguous filled region, both at most `wanted_size` bytes. The region is handed over to the other
+ *         side by the matching release, with the number of bytes set in `blk->valid_size`. A region may be
+ *         shorter than wanted at the end of the buffer, `esp_gmf_spsc_rb_write` and `esp_gmf_spsc_rb_read`
+ *         loop over it for the callers which just want to copy.
+ *
+ * @note  The blocking functions wait on the notification value of index `ESP_GMF_SPSC_RB_NOTIFY_INDEX` of the
+ *        calling task, that task must not use it for anything else
+ */
+
+#ifndef ESP_GMF_SPSC_RB_NOTIFY_INDEX
+#define ESP_GMF_SPSC_RB_NOTIFY_INDEX (0)
+#endif  /* ESP_GMF_SPSC_RB_NOTIFY_INDEX */
+
+/**
+ * @brief  Handle to the SPSC ring buffer
+ */
+typedef void *esp_gmf_spsc_rb_handle_t;
+
+/**
+ * @brief  Create a SPSC ring buffer with total size = block_size * n_blocks
+ *
+ * @param[in]   block_size  Size of each block
+ * @param[in]   n_blocks    Number of blocks
+ * @param[out]  handle      Pointer to store the handle to the created ring buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_create(int block_size, int n_blocks, esp_gmf_spsc_rb_handle_t *handle);
+
+/**
+ * @brief  Cleanup and free all memory allocated for the SPSC ring buffer
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_destroy(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Reset the SPSC ring buffer, clearing all values to the initial state
+ *
+ * @note  Neither side may be using the buffer while it is reset
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_reset(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Acquire the contiguous filled region for read, waiting until at least one byte is available
+ *
+ *         On success, `blk->buf` points into the ring buffer and `blk->valid_size` holds the region size.
+ *         When writing is done and the buffer is empty, it returns with `blk->valid_size` 0 and `blk->is_last` set.
+ *
+ * @param[in]   handle         The SPSC ring buffer handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Maximum size of the region
+ * @param[in]   ticks_to_wait  Maximum number of ticks to wait for data
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       On success
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  No data within the given ticks
+ *       - ESP_GMF_IO_ABORT    The buffer is aborted
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Release `blk->valid_size` bytes of the region got by `esp_gmf_spsc_rb_acquire_read` back to the writer
+ *
+ * @param[in]  handle       The SPSC ring buffer handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Unused, releasing never blocks
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    On success
+ *       - ESP_GMF_IO_FAIL  Invalid arguments or more bytes released than acquired
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Acquire the contiguous free region for write, waiting until at least one byte is free
+ *
+ *         On success, `blk->buf` points into the ring buffer and `blk->buf_length` holds the region size.
+ *
+ * @param[in]   handle         The SPSC ring buffer handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Maximum size of the region
+ * @param[in]   ticks_to_wait  Maximum number of ticks to wait for space
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       On success
+ *       - ESP_GMF_IO_FAIL     Invalid arguments, or writing is already done
+ *       - ESP_GMF_IO_TIMEOUT  No space within the given ticks
+ *       - ESP_GMF_IO_ABORT    The buffer is aborted
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Hand `blk->valid_size` bytes of the region got by `esp_gmf_spsc_rb_acquire_write` over to the reader
+ *
+ * @note  If `blk->is_last` is set, writing is marked as done
+ *
+ * @param[in]  handle       The SPSC ring buffer handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Unused, releasing never blocks
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    On success
+ *       - ESP_GMF_IO_FAIL  Invalid arguments or more bytes released than acquired
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Copy `len` bytes into the SPSC ring buffer, waiting for space as needed
+ *
+ *         When the buffer is full, the writer is only woken up once the space for the rest of the data is free
+ *
+ * @param[in]  handle         The SPSC ring buffer handle
+ * @param[in]  data           Data to write
+ * @param[in]  len            Size of the data
+ * @param[in]  ticks_to_wait  Maximum number of ticks to wait for each free region
+ *
+ * @return
+ *       - >= 0  Number of bytes written, less than `len` only on a timeout or abort after a partial write
+ *       - < 0   Error code of `esp_gmf_err_io_t` if nothing was written
+ */
+int esp_gmf_spsc_rb_write(esp_gmf_spsc_rb_handle_t handle, const uint8_t *data, uint32_t len, int ticks_to_wait);
+
+/**
+ * @brief  Copy `len` bytes out of the SPSC ring buffer, waiting for data as needed
+ *
+ *         When the buffer is empty, the reader is only woken up once the rest of the data is there
+ *
+ * @param[in]  handle         The SPSC ring buffer handle
+ * @param[out] data           Buffer to read to
+ * @param[in]  len            Size of the buffer
+ * @param[in]  ticks_to_wait  Maximum number of ticks to wait for each filled region
+ *
+ * @return
+ *       - >= 0  Number of bytes read, less than `len` only after done write, or on a timeout or abort after a
+ *               partial read
+ *       - < 0   Error code of `esp_gmf_err_io_t` if nothing was read
+ */
+int esp_gmf_spsc_rb_read(esp_gmf_spsc_rb_handle_t handle, uint8_t *data, uint32_t len, int ticks_to_wait);
+
+/**
+ * @brief  Abort any pending operations on the SPSC ring buffer, both sides are woken up
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_abort(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Mark writing as done, the reader gets `is_last` once it has read all the remaining data
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_done_write(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Clear the done write flag
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_reset_done_write(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Get the number of free bytes in the SPSC ring buffer
+ *
+ * @param[in]   handle          The SPSC ring buffer handle
+ * @param[out]  available_size  Pointer to store the number of free bytes
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_available(esp_gmf_spsc_rb_handle_t handle, uint32_t *available_size);
+
+/**
+ * @brief  Get the number of filled bytes in the SPSC ring buffer
+ *
+ * @param[in]   handle       The SPSC ring buffer handle
+ * @param[out]  filled_size  Pointer to store the number of filled bytes
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_filled(esp_gmf_spsc_rb_handle_t handle, uint32_t *filled_size);
+
+/**
+ * @brief  Get the total size of the SPSC ring buffer
+ *
+ * @param[in]   handle    The SPSC ring buffer handle
+ * @param[out]  max_size  Pointer to store the total size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_get_size(esp_gmf_spsc_rb_handle_t handle, uint32_t *max_size);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -37,37 +37,71 @@ typedef struct esp_gmf_task_config {
     uint32_t    stack_in_ext : 4;  /*!< Flag indicating if the stack is in external memory */
 } esp_gmf_task_config_t;
 
+/**
+ * @brief  Profiling counters of a GMF task, accumulated since the task was created or last reset
+ *
+ *         A loop is one pass of the task over its job list, an overrun is a loop longer than the budget set by
+ *         `esp_gmf_task_set_loop_budget`. A loop includes the time the jobs wait on their ports, the time spent
+ *         paused is left out.
+ *
+ *         Only `loop_cnt` is counted unless `CONFIG_GMF_CORE_ENABLE_PROFILE` is set, the task does not read the
+ *         time otherwise.
+ */
+typedef struct {
+    uint32_t  loop_cnt;     /*!< Number of completed loops */
+    uint32_t  loop_max_us;  /*!< Longest loop */
+    uint64_t  loop_us;      /*!< Total time of the completed loops */
+    uint32_t  overrun_cnt;  /*!< Number of loops longer than the budget */
+} esp_gmf_task_prof_t;
+
+/**
+ * @brief  Function called by a GMF task to log its profile periodically, from the task itself between two loops
+ *
+ * @note  The task is the only one updating its counters, so the function reads `prof` of the task directly.
+ *        `esp_gmf_task_get_prof` takes the task lock, which the task APIs hold while they wait for the task.
+ */
+typedef void (*esp_gmf_task_prof_log_cb)(esp_gmf_task_handle_t handle, void *ctx);
+
 /**
  * @brief  GMF task structure
  *
  *         Represents a GMF task, including its properties, configuration, and internal state.
  */
 typedef struct _esp_gmf_task {
-    struct esp_gmf_obj_     base;           /*!< Base object for GMF tasks */
-    esp_gmf_job_t          *working;        /*!< Currently executing job in the task */
-    esp_gmf_job_stack_t    *start_stack;    /*!< Stack for the start job */
+    struct esp_gmf_obj_       base;            /*!< Base object for GMF tasks */
+    esp_gmf_job_t            *working;         /*!< Currently executing job in the task */
+    esp_gmf_job_stack_t      *start_stack;     /*!< Stack for the start job */
 
     /* Properties */
-    esp_gmf_event_cb        event_func;     /*!< Callback function for task events */
-    esp_gmf_event_state_t   state;          /*!< Current state of the task */
+    esp_gmf_event_cb          event_func;      /*!< Callback function for task events */
+    esp_gmf_event_state_t     state;           /*!< Current state of the task */
 
     /* Protect */
-    esp_gmf_task_config_t   thread;         /*!< Configuration settings for the task */
-    void                   *ctx;            /*!< Context associated with the task */
+    esp_gmf_task_config_t     thread;          /*!< Configuration settings for the task */
+    void                     *ctx;             /*!< Context associated with the task */
 
     /* Private */
-    void                   *oal_thread;     /*!< Handle to the thread */
-    void                   *lock;           /*!< Mutex lock for task synchronization */
-    void                   *event_group;    /*!< Event group for wait events */
-    void                   *block_sem;      /*!< Semaphore for blocking tasks */
-    void                   *wait_sem;       /*!< Semaphore for task waiting */
-    int                     api_sync_time;  /*!< Timeout for synchronization */
-
-    uint8_t                 _running  : 1;  /*!< Internal flag for task running state */
-    uint8_t                 _task_run : 1;  /*!< Internal flag for task execution */
-    uint8_t                 _pause    : 1;  /*!< Internal flag for task pause state */
-    uint8_t                 _stop     : 1;  /*!< Internal flag for task stop state */
-    uint8_t                 _destroy  : 1;  /*!< Internal flag for task destruction */
+    void                     *oal_thread;      /*!< Handle to the thread */
+    void                     *lock;            /*!< Mutex lock for task synchronization */
+    void                     *event_group;     /*!< Event group for wait events */
+    void                     *block_sem;       /*!< Semaphore for blocking tasks */
+    void                     *wait_sem;        /*!< Semaphore for task waiting */
+    int                       api_sync_time;   /*!< Timeout for synchronization */
+
+    /* Profiling */
+    esp_gmf_task_prof_t       prof;            /*!< Profiling counters */
+    uint32_t                  loop_budget_us;  /*!< Loop duration over which a loop is an overrun, 0 to count none */
+    int64_t                   loop_start_us;   /*!< Start time of the current loop */
+    int                       log_period_ms;   /*!< Period of the profile log, 0 for no log */
+    int64_t                   log_last_us;     /*!< Time of the last profile log */
+    esp_gmf_task_prof_log_cb  log_func;        /*!< Function to log the profile, NULL to log the task counters only */
+    void                     *log_ctx;         /*!< Context passed to `log_func` */
+
+    uint8_t                   _running  : 1;   /*!< Internal flag for task running state */
+    uint8_t                   _task_run : 1;   /*!< Internal flag for task execution */
+    uint8_t                   _pause    : 1;   /*!< Internal flag for task pause state */
+    uint8_t                   _stop     : 1;   /*!< Internal flag for task stop state */
+    uint8_t                   _destroy  : 1;   /*!< Internal flag for task destruction */
 } esp_gmf_task_t;
 
 /**
@@ -246,6 +280,63 @@ esp_gmf_err_t esp_gmf_task_set_timeout(esp_gmf_task_handle_t handle, int wait_ms
  */
 esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event_state_t *state);
 
+/**
+ * @brief  Set the loop budget of the specific task, a loop over the jobs lasting longer is counted as an overrun
+ *
+ *         For a pipeline processing audio frames, the budget is usually the duration of one frame
+ *
+ * @param[in]  handle     GMF task handle
+ * @param[in]  budget_us  Loop budget in microseconds, 0 to count no overrun
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_task_set_loop_budget(esp_gmf_task_handle_t handle, uint32_t budget_us);
+
+/**
+ * @brief  Log the profile of the specific task periodically
+ *
+ *         The task calls `func` between two loops once `period_ms` has elapsed since the last call. Without `func`,
+ *         the task logs its own counters in one line.
+ *
+ * @param[in]  handle     GMF task handle
+ * @param[in]  period_ms  Log period in milliseconds, 0 to stop logging
+ * @param[in]  func       Function to log the profile, NULL to log the task counters
+ * @param[in]  ctx        Context passed to `func`
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `period_ms` is not 0 and `CONFIG_GMF_CORE_ENABLE_PROFILE` is not set
+ */
+esp_gmf_err_t esp_gmf_task_set_prof_log(esp_gmf_task_handle_t handle, int period_ms, esp_gmf_task_prof_log_cb func, void *ctx);
+
+/**
+ * @brief  Get a snapshot of the profiling counters of the specific task
+ *
+ * @note  The snapshot is copied under the task lock, not to be called from the profile log function
+ *
+ * @param[in]   handle  GMF task handle
+ * @param[out]  prof    Pointer to store the profiling counters
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle or prof is invalid
+ */
+esp_gmf_err_t esp_gmf_task_get_prof(esp_gmf_task_handle_t handle, esp_gmf_task_prof_t *prof);
+
+/**
+ * @brief  Clear the profiling counters of the specific task
+ *
+ * @param[in]  handle  GMF task handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_task_reset_prof(esp_gmf_task_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
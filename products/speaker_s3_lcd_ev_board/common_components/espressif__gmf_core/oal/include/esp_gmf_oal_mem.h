@@ -13,6 +13,18 @@
 extern "C" {
 #endif  /* __cplusplus */
 
+/**
+ * @brief  Counters of the heap calls made through the GMF OAL memory functions
+ *
+ *         They make the allocations on the data path visible, e.g. to check that a running pipeline no longer
+ *         allocates once it is warmed up. The counters only grow, take the difference of two snapshots.
+ */
+typedef struct {
+    uint32_t  alloc_cnt;    /*!< Number of successful allocations, including the aligned, zeroed and duplicated ones */
+    uint32_t  realloc_cnt;  /*!< Number of successful reallocations */
+    uint32_t  free_cnt;     /*!< Number of frees of a non-NULL pointer */
+} esp_gmf_oal_mem_stats_t;
+
 /**
  * @brief  Allocate memory of a specified size
  *
@@ -119,6 +131,13 @@ bool esp_gmf_oal_mem_spiram_is_enabled(void);
  */
 bool esp_gmf_oal_mem_spiram_stack_is_enabled(void);
 
+/**
+ * @brief  Get a snapshot of the heap call counters
+ *
+ * @param[out]  stats  Pointer to store the counters
+ */
+void esp_gmf_oal_mem_get_stats(esp_gmf_oal_mem_stats_t *stats);
+
 #define ESP_GMF_MEM_SHOW(x) esp_gmf_oal_mem_print(x, __LINE__, __func__)
 
 #ifdef __cplusplus
@@ -7,14 +7,32 @@
 
 #include <stdio.h>
 #include <string.h>
+#include "sdkconfig.h"
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_port.h"
 #include "esp_gmf_element.h"
 #include "esp_gmf_node.h"
 
 static const char *TAG = "ESP_GMF_PORT";
 
+static inline esp_gmf_err_io_t esp_gmf_port_timed_acquire(esp_gmf_port_handle_t port, esp_gmf_element_handle_t el, esp_gmf_payload_t *load,
+                                                           uint32_t wanted_size, int wait_ticks)
+{
+#if CONFIG_GMF_CORE_ENABLE_PROFILE
+    if (el == NULL) {
+        return port->ops.acquire(port->ctx, load, wanted_size, wait_ticks);
+    }
+    int64_t start_us = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_err_io_t ret = port->ops.acquire(port->ctx, load, wanted_size, wait_ticks);
+    ESP_GMF_ELEMENT_GET(el)->prof.wait_us += (uint64_t)(esp_gmf_oal_sys_get_time_us() - start_us);
+    return ret;
+#else
+    return port->ops.acquire(port->ctx, load, wanted_size, wait_ticks);
+#endif  /* CONFIG_GMF_CORE_ENABLE_PROFILE */
+}
+
 static inline esp_gmf_err_io_t esp_gmf_port_dec_ref(esp_gmf_port_handle_t port, esp_gmf_payload_t *load, int wait_ticks)
 {
     if (load == NULL) {
@@ -29,6 +47,19 @@ static inline esp_gmf_err_io_t esp_gmf_port_dec_ref(esp_gmf_port_handle_t port,
     return ESP_GMF_ERR_OK;
 }
 
+static inline esp_gmf_payload_t *esp_gmf_port_new_self_payload(esp_gmf_port_handle_t port)
+{
+    esp_gmf_payload_t *load = NULL;
+    // A block port with callbacks gets the buffer from them, so its payload has nothing to take from the pool
+    if (port->payload_pool && ((port->attr.type == ESP_GMF_PORT_TYPE_BYTE) || (port->ops.acquire == NULL))) {
+        esp_gmf_payload_pool_get(port->payload_pool, &load);
+    }
+    if (load == NULL) {
+        esp_gmf_payload_new(&load);
+    }
+    return load;
+}
+
 esp_gmf_err_t esp_gmf_port_init(esp_gmf_port_config_t *cfg, esp_gmf_port_handle_t *out_result)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
@@ -96,6 +127,14 @@ esp_gmf_err_t esp_gmf_port_enable_payload_share(esp_gmf_port_handle_t handle, bo
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_port_set_payload_pool(esp_gmf_port_handle_t handle, esp_gmf_payload_pool_handle_t pool)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->payload_pool = pool;
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_port_reset(esp_gmf_port_handle_t handle)
 {
     esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
@@ -197,9 +236,10 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
     } else {
         if (*load == NULL) {
             if (port->self_payload == NULL) {
-                esp_gmf_payload_new(&port->self_payload);
+                port->self_payload = esp_gmf_port_new_self_payload(port);
                 ESP_GMF_MEM_CHECK(TAG, port->self_payload, return ESP_GMF_IO_FAIL);
-                ESP_LOGI(TAG, "ACQ IN, new self payload:%p, port:%p, el:%p-%s", port->self_payload, port, el, OBJ_GET_TAG(el));
+                ESP_LOGI(TAG, "ACQ IN, new self payload:%p, pooled:%d, port:%p, el:%p-%s", port->self_payload,
+                         port->self_payload->is_pooled, port, el, OBJ_GET_TAG(el));
             }
             port->payload = port->self_payload;
             *load = port->self_payload;
@@ -220,7 +260,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
             nxt_el->out->payload = port->payload;
         }
         if (port->ops.acquire) {
-            ret = port->ops.acquire(port->ctx, *load, wanted_size, wait_ticks);
+            ret = esp_gmf_port_timed_acquire(port, el, *load, wanted_size, wait_ticks);
             if (ret >= ESP_GMF_IO_OK) {
                 port->ref_count = 1;
             }
@@ -243,6 +283,9 @@ esp_gmf_err_io_t esp_gmf_port_release_in(esp_gmf_port_handle_t handle, esp_gmf_p
     int ret = ESP_GMF_ERR_OK;
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->reader;
     ESP_LOGD(TAG, "%s, p:%p, el:%s, PLD[p:%p, h:%p, b:%p, l:%d]", __func__, port, OBJ_GET_TAG(el), port->payload, load, load->buf, load->buf_length);
+    if (el) {
+        ESP_GMF_ELEMENT_GET(el)->prof.bytes_in += load->valid_size;
+    }
     if (el && port->writer) {
         if (port->ref_port) {
             ret = esp_gmf_port_dec_ref(port->ref_port, load, wait_ticks);
@@ -285,9 +328,10 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
             *load = port->payload;
         } else {
             if (port->self_payload == NULL) {
-                esp_gmf_payload_new(&port->self_payload);
+                port->self_payload = esp_gmf_port_new_self_payload(port);
                 ESP_GMF_MEM_CHECK(TAG, port->self_payload, return ESP_GMF_IO_FAIL);
-                ESP_LOGI(TAG, "ACQ OUT, new self payload:%p, port:%p, el:%p-%s", port->self_payload, port, el, OBJ_GET_TAG(el));
+                ESP_LOGI(TAG, "ACQ OUT, new self payload:%p, pooled:%d, port:%p, el:%p-%s", port->self_payload,
+                         port->self_payload->is_pooled, port, el, OBJ_GET_TAG(el));
             }
             port->payload = port->self_payload;
             *load = port->self_payload;
@@ -335,7 +379,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
             }
         }
         if (port->ops.acquire) {
-            ret = port->ops.acquire(port->ctx, *load, wanted_size, wait_ticks);
+            ret = esp_gmf_port_timed_acquire(port, el, *load, wanted_size, wait_ticks);
         }
     }
     return ret;
@@ -354,6 +398,9 @@ esp_gmf_err_io_t esp_gmf_port_release_out(esp_gmf_port_handle_t handle, esp_gmf_
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->writer;
     esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
     ESP_LOGD(TAG, "%s, p:%p, el:%s,reader:%p, PLD[h:%p, b:%p, l:%d]", __func__, port, OBJ_GET_TAG(el), port->reader, load, load->buf, load->buf_length);
+    if (el) {
+        ESP_GMF_ELEMENT_GET(el)->prof.bytes_out += load->valid_size;
+    }
     if (el && port->reader) {
         port->payload = NULL;
     } else {
@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host stand-in of FreeRTOS on top of pthreads, see `freertos_host.c` */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint32_t TickType_t;
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+
+#define pdTRUE  ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS  pdTRUE
+
+#define portMAX_DELAY      ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS (1)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+
+/**
+ * @brief  Number of blocking waits done by the tasks, i.e. the points where a real scheduler would switch context
+ */
+extern volatile uint64_t freertos_host_block_count;
+
+/**
+ * @brief  Number of semaphore takes and gives, and task notification takes and gives
+ */
+extern volatile uint64_t freertos_host_sync_count;
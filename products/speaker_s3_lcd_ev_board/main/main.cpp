@@ -50,6 +50,7 @@ using namespace esp_brookesia::speaker;        // ESP-Brookesia音箱核心命
 using namespace esp_brookesia::gui;            // ESP-Brookesia GUI组件命名空间  
 using namespace esp_brookesia::speaker_apps;   // ESP-Brookesia音箱应用命名空间
 using StorageNVS = esp_brookesia::services::StorageNVS;   // StorageNVS服务类型别名
+using Executor = esp_brookesia::services::Executor;       // Executor服务类型别名
 using namespace esp_brookesia::ai_framework;   // ESP-Brookesia AI框架命名空间
 
 //内存信息显示宏定义
@@ -69,25 +70,16 @@ constexpr int         PARAM_DISPLAY_BRIGHTNESS_DEFAULT  = 100; // 系统默认
 
 // ==================== AI函数调用 - 应用启动功能配置 ====================
 // 当AI助手识别到"打开XX应用"指令时，这些参数控制应用启动过程
-constexpr const char *FUNCTION_OPEN_APP_THREAD_NAME               = "open_app";     // 应用启动线程名称
-constexpr int         FUNCTION_OPEN_APP_THREAD_STACK_SIZE         = 10 * 1024;     // 线程栈大小(10KB)
 constexpr int         FUNCTION_OPEN_APP_WAIT_SPEAKING_PRE_MS      = 2000;          // 等待AI语音播放前的延时(2秒)
 constexpr int         FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS = 10;            // 检查AI是否还在说话的间隔(10毫秒)
 constexpr int         FUNCTION_OPEN_APP_WAIT_SPEAKING_MAX_MS      = 2000;          // 最长等待AI说完的时间(2秒)
-constexpr bool        FUNCTION_OPEN_APP_THREAD_STACK_CAPS_EXT     = true;          // 是否使用外部PSRAM作为栈
 
 // ==================== AI函数调用 - 音量控制功能配置 ====================
 // 当AI助手识别到"调大音量"、"调小音量"等指令时，这些参数控制音量调节过程
-constexpr const char *FUNCTION_VOLUME_CHANGE_THREAD_NAME           = "volume_change";  // 音量调节线程名称
-constexpr size_t      FUNCTION_VOLUME_CHANGE_THREAD_STACK_SIZE     = 6 * 1024;         // 线程栈大小(6KB)
-constexpr bool        FUNCTION_VOLUME_CHANGE_THREAD_STACK_CAPS_EXT = true;             // 是否使用外部PSRAM作为栈
 constexpr int         FUNCTION_VOLUME_CHANGE_STEP                  = 20;               // 每次音量调节的步长值
 
 // ==================== AI函数调用 - 亮度控制功能配置 ====================
 // 当AI助手识别到"调亮屏幕"、"调暗屏幕"等指令时，这些参数控制亮度调节过程
-constexpr const char *FUNCTION_BRIGHTNESS_CHANGE_THREAD_NAME           = "brightness_change";  // 亮度调节线程名称
-constexpr size_t      FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_SIZE     = 6 * 1024;             // 线程栈大小(6KB)
-constexpr bool        FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT = true;                 // 是否使用外部PSRAM作为栈
 constexpr int         FUNCTION_BRIGHTNESS_CHANGE_STEP                  = 30;                   // 每次亮度调节的步长值
 
 #define LVGL_PORT_INIT_CONFIG() \
@@ -769,6 +761,35 @@ extern "C" void app_main(void)
 #endif
 }
 
+/**
+ * @brief 等待AI说完后打开应用
+ *
+ * 每次检查都重新投递延时任务，等待期间不占用共享的工作线程
+ *
+ * @param event_data 应用启动事件
+ * @param delay_ms 本次检查前的延时(毫秒)
+ * @param remaining_ms 剩余的最长等待时间(毫秒)
+ */
+static void post_open_app_job(ESP_Brookesia_CoreAppEventData_t event_data, int delay_ms, int remaining_ms)
+{
+    Executor::requestInstance().postDelayed([ = ]() {
+        if ((remaining_ms > 0) && AI_Buddy::requestInstance()->isSpeaking()) {
+            post_open_app_job(
+                event_data, FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS,
+                remaining_ms - FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS
+            );
+            return;
+        }
+
+        speaker->lockLv();
+        speaker->manager.processDisplayScreenChange(
+            ESP_BROOKESIA_SPEAKER_MANAGER_SCREEN_MAIN, nullptr
+        );
+        speaker->sendAppEvent(&event_data);
+        speaker->unlockLv();
+    }, delay_ms, Executor::Priority::Normal, "open_app");
+}
+
 static bool create_speaker_and_install_apps()
 {
     ESP_UTILS_LOG_TRACE_GUARD();
@@ -955,29 +976,13 @@ static bool create_speaker_and_install_apps()
                     return;
                 }
 
-                boost::this_thread::sleep_for(boost::chrono::milliseconds(FUNCTION_OPEN_APP_WAIT_SPEAKING_PRE_MS));
-
-                int wait_count = 0;
-                int wait_interval_ms = FUNCTION_OPEN_APP_WAIT_SPEAKING_INTERVAL_MS;
-                int wait_max_count = FUNCTION_OPEN_APP_WAIT_SPEAKING_MAX_MS / wait_interval_ms;
-                while ((wait_count < wait_max_count) && AI_Buddy::requestInstance()->isSpeaking()) {
-                    boost::this_thread::sleep_for(boost::chrono::milliseconds(wait_interval_ms));
-                    wait_count++;
-                }
-
-                speaker->lockLv();
-                speaker->manager.processDisplayScreenChange(
-                    ESP_BROOKESIA_SPEAKER_MANAGER_SCREEN_MAIN, nullptr
+                // 等AI把回复说完再切换界面，等待期间不占用工作线程
+                post_open_app_job(
+                    event_data, FUNCTION_OPEN_APP_WAIT_SPEAKING_PRE_MS, FUNCTION_OPEN_APP_WAIT_SPEAKING_MAX_MS
                 );
-                speaker->sendAppEvent(&event_data);
-                speaker->unlockLv();
             }
         }
-    }, std::make_optional<FunctionDefinition::CallbackThreadConfig>({
-        .name = FUNCTION_OPEN_APP_THREAD_NAME,
-        .stack_size = FUNCTION_OPEN_APP_THREAD_STACK_SIZE,
-        .stack_in_ext = FUNCTION_OPEN_APP_THREAD_STACK_CAPS_EXT,
-    }));
+    }, true);
     FunctionDefinitionList::requestInstance().addFunction(openApp);
 
     /* 注册AI函数调用 - 音量控制功能 */
@@ -1022,11 +1027,7 @@ static bool create_speaker_and_install_apps()
                 ESP_UTILS_CHECK_FALSE_EXIT(set_media_sound_volume(volume), "Failed to set volume");
             }
         }
-    }, std::make_optional<FunctionDefinition::CallbackThreadConfig>(FunctionDefinition::CallbackThreadConfig{
-        .name = FUNCTION_VOLUME_CHANGE_THREAD_NAME,
-        .stack_size = FUNCTION_VOLUME_CHANGE_THREAD_STACK_SIZE,
-        .stack_in_ext = FUNCTION_VOLUME_CHANGE_THREAD_STACK_CAPS_EXT,
-    }));
+    }, true);
     FunctionDefinitionList::requestInstance().addFunction(setVolume);
 
     /* 注册AI函数调用 - 亮度控制功能 */
@@ -1062,11 +1063,7 @@ static bool create_speaker_and_install_apps()
                 ESP_UTILS_CHECK_FALSE_EXIT(set_media_display_brightness(brightness), "Failed to set brightness");
             }
         }
-    }, std::make_optional<FunctionDefinition::CallbackThreadConfig>(FunctionDefinition::CallbackThreadConfig{
-        .name = FUNCTION_BRIGHTNESS_CHANGE_THREAD_NAME,
-        .stack_size = FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_SIZE,
-        .stack_in_ext = FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT,
-    }));
+    }, true);
     FunctionDefinitionList::requestInstance().addFunction(setBrightness);
 
     // /* Connect the quick settings event signal */